@@ -0,0 +1,400 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <getopt.h>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/graph/concurrent_cover_graph.hh"
+#include "tchecker/graph/cover_graph.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/ta/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/zg/zg.hh"
+
+/*!
+ \file cover-graph.cc
+ \brief Contention benchmark for cover graphs
+ \note The sequence of insertions in the passed/cover store of a covering reachability
+ analysis of a model is recorded, then it is replayed by several threads on a
+ tchecker::graph::cover::concurrent_graph_t, and by a single thread on a
+ tchecker::graph::cover::graph_t as a reference
+ */
+
+static struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                       {"max-nodes", required_argument, 0, 'n'},
+                                       {"rounds", required_argument, 0, 'r'},
+                                       {"shards", required_argument, 0, 's'},
+                                       {"threads", required_argument, 0, 't'},
+                                       {"table-size", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"hn:r:s:t:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -n max        maximal number of recorded insertions (default: unbounded)" << std::endl;
+  std::cerr << "   -r rounds     number of replays for each configuration, best time is reported (default: 3)"
+            << std::endl;
+  std::cerr << "   -s shards     number of shards of the concurrent cover graph (default: 64)" << std::endl;
+  std::cerr << "   -t t1,t2,...  comma-separated list of numbers of threads (default: 1,2,4,8)" << std::endl;
+  std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "outputs one line per configuration: store threads shards insertions stored seconds insertions/s"
+            << std::endl;
+}
+
+static bool help = false;                                           /*!< Help flag */
+static std::size_t max_nodes = std::numeric_limits<std::size_t>::max(); /*!< Maximal number of recorded insertions */
+static std::size_t rounds = 3;                                      /*!< Number of rounds */
+static std::size_t shards = 64;                                     /*!< Number of shards */
+static std::vector<std::size_t> threads{1, 2, 4, 8};                /*!< Numbers of threads */
+static std::size_t table_size = 65536;                              /*!< Size of hash tables */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'h':
+        help = true;
+        break;
+      case 'n':
+        max_nodes = std::strtoull(optarg, nullptr, 10);
+        break;
+      case 'r':
+        rounds = std::max<std::size_t>(1, std::strtoull(optarg, nullptr, 10));
+        break;
+      case 's':
+        shards = std::max<std::size_t>(1, std::strtoull(optarg, nullptr, 10));
+        break;
+      case 't': {
+        threads.clear();
+        std::istringstream is{optarg};
+        std::string t;
+        while (std::getline(is, t, ','))
+          threads.push_back(std::max<std::size_t>(1, std::strtoull(t.c_str(), nullptr, 10)));
+        break;
+      }
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "table-size") == 0)
+        table_size = std::strtoull(optarg, nullptr, 10);
+      else
+        throw std::runtime_error("This also should never be executed");
+    }
+  }
+  return optind;
+}
+
+/*!
+ \class record_node_t
+ \brief Recorded node: copy of the discrete part and zone of a zone graph state
+ */
+class record_node_t : public tchecker::graph::cover::node_t {
+public:
+  /*!
+   \brief Constructor
+   \param s : a state
+   \post this node keeps a copy of the tuple of locations, the valuation of bounded
+   integer variables and the zone in s
+   */
+  explicit record_node_t(tchecker::zg::state_t const & s) : _hash(tchecker::ta::hash_value(s)), _dim(s.zone().dim())
+  {
+    for (tchecker::process_id_t pid = 0; pid < s.vloc().capacity(); ++pid)
+      _discrete.push_back(static_cast<long>(s.vloc()[pid]));
+    for (tchecker::intvar_id_t id = 0; id < s.intval().capacity(); ++id)
+      _discrete.push_back(static_cast<long>(s.intval()[id]));
+    _dbm.assign(s.zone().dbm(), s.zone().dbm() + _dim * _dim);
+  }
+
+  /*!
+   \brief Accessor
+   \return hash value of the discrete part
+   */
+  inline std::size_t hash() const { return _hash; }
+
+  /*!
+   \brief Covering predicate
+   \param n : a node
+   \return true if this node and n have same discrete part and the zone in this node is
+   included in the zone in n, false otherwise
+   */
+  inline bool le(record_node_t const & n) const
+  {
+    return (_discrete == n._discrete) && tchecker::dbm::is_le(_dbm.data(), n._dbm.data(), _dim);
+  }
+
+private:
+  std::size_t _hash;                   /*!< Hash value of discrete part */
+  std::vector<long> _discrete;         /*!< Discrete part */
+  std::vector<tchecker::dbm::db_t> _dbm; /*!< DBM */
+  tchecker::clock_id_t _dim;           /*!< Dimension of DBM */
+};
+
+using record_node_sptr_t = std::shared_ptr<record_node_t>;
+
+/*!
+ \class record_node_hash_t
+ \brief Hash functor for recorded nodes
+ */
+class record_node_hash_t {
+public:
+  std::size_t operator()(record_node_sptr_t const & n) const { return n->hash(); }
+};
+
+/*!
+ \class record_node_le_t
+ \brief Covering predicate for recorded nodes
+ */
+class record_node_le_t {
+public:
+  bool operator()(record_node_sptr_t const & n1, record_node_sptr_t const & n2) const { return n1->le(*n2); }
+};
+
+/*!
+ \brief Record the insertions in the passed/cover store of a covering reachability analysis
+ \param sysdecl : system declaration
+ \return the sequence of nodes inserted in the store by a breadth-first covering reachability
+ analysis of the zone graph of sysdecl (with local LU extrapolation and zone inclusion)
+ */
+std::vector<record_node_sptr_t> record(tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
+  if (tchecker::ta::has_diagonal_constraint(*system))
+    throw std::invalid_argument("Systems with diagonal constraints are not supported");
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, 10000, table_size)};
+
+  tchecker::graph::cover::graph_t<record_node_sptr_t, record_node_hash_t, record_node_le_t> store{
+      table_size, record_node_hash_t{}, record_node_le_t{}};
+  std::vector<record_node_sptr_t> trace, covered;
+  std::deque<tchecker::zg::state_sptr_t> waiting;
+  std::vector<tchecker::zg::zg_t::sst_t> sst;
+  record_node_sptr_t covering{nullptr};
+
+  auto insert = [&](tchecker::zg::state_sptr_t const & s) {
+    record_node_sptr_t n = std::make_shared<record_node_t>(*s);
+    trace.push_back(n);
+    if (store.is_covered(n, covering))
+      return;
+    auto covered_inserter = std::back_inserter(covered);
+    store.covered_nodes(n, covered_inserter);
+    for (record_node_sptr_t const & c : covered)
+      store.remove_node(c);
+    covered.clear();
+    store.add_node(n);
+    waiting.push_back(s);
+  };
+
+  zg->initial(sst);
+  for (auto && [status, s, t] : sst)
+    insert(s);
+  sst.clear();
+
+  while (!waiting.empty() && trace.size() < max_nodes) {
+    tchecker::zg::state_sptr_t s = waiting.front();
+    waiting.pop_front();
+    zg->next(tchecker::zg::const_state_sptr_t{s}, sst);
+    for (auto && [status, nexts, nextt] : sst)
+      insert(nexts);
+    sst.clear();
+  }
+
+  store.clear();
+  if (trace.size() > max_nodes)
+    trace.resize(max_nodes);
+  return trace;
+}
+
+/*!
+ \brief Copy recorded nodes
+ \param trace : recorded nodes
+ \return fresh copies of the nodes in trace (not stored in any graph)
+ */
+std::vector<record_node_sptr_t> copy(std::vector<record_node_sptr_t> const & trace)
+{
+  std::vector<record_node_sptr_t> nodes;
+  nodes.reserve(trace.size());
+  for (record_node_sptr_t const & n : trace)
+    nodes.push_back(std::make_shared<record_node_t>(*n));
+  return nodes;
+}
+
+/*!
+ \brief Replay insertions on a sequential cover graph
+ \param trace : recorded nodes
+ \return pair (running time in seconds, number of stored nodes)
+ */
+std::tuple<double, std::size_t> replay_sequential(std::vector<record_node_sptr_t> const & trace)
+{
+  std::vector<record_node_sptr_t> nodes = copy(trace), covered;
+  tchecker::graph::cover::graph_t<record_node_sptr_t, record_node_hash_t, record_node_le_t> g{
+      table_size, record_node_hash_t{}, record_node_le_t{}};
+  record_node_sptr_t covering{nullptr};
+
+  auto start = std::chrono::steady_clock::now();
+  for (record_node_sptr_t const & n : nodes) {
+    if (g.is_covered(n, covering))
+      continue;
+    auto covered_inserter = std::back_inserter(covered);
+    g.covered_nodes(n, covered_inserter);
+    for (record_node_sptr_t const & c : covered)
+      g.remove_node(c);
+    covered.clear();
+    g.add_node(n);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::size_t stored = g.size();
+  g.clear();
+  return std::make_tuple(std::chrono::duration<double>(end - start).count(), stored);
+}
+
+/*!
+ \brief Replay insertions on a concurrent cover graph
+ \param trace : recorded nodes
+ \param nthreads : number of threads
+ \return pair (running time in seconds, number of stored nodes)
+ \note insertion i is performed by thread i modulo nthreads
+ */
+std::tuple<double, std::size_t> replay_concurrent(std::vector<record_node_sptr_t> const & trace, std::size_t nthreads)
+{
+  std::vector<record_node_sptr_t> nodes = copy(trace);
+  tchecker::graph::cover::concurrent_graph_t<record_node_sptr_t, record_node_hash_t, record_node_le_t> g{
+      table_size, shards, record_node_hash_t{}, record_node_le_t{}};
+
+  std::vector<std::thread> pool;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t t = 0; t < nthreads; ++t)
+    pool.emplace_back([&nodes, &g, t, nthreads]() {
+      record_node_sptr_t covering{nullptr};
+      std::vector<record_node_sptr_t> covered;
+      auto covered_inserter = std::back_inserter(covered);
+      for (std::size_t i = t; i < nodes.size(); i += nthreads) {
+        g.add_if_not_covered(nodes[i], covering, covered_inserter);
+        covered.clear();
+      }
+    });
+  for (std::thread & t : pool)
+    t.join();
+  auto end = std::chrono::steady_clock::now();
+
+  std::size_t stored = g.size();
+  g.clear();
+  return std::make_tuple(std::chrono::duration<double>(end - start).count(), stored);
+}
+
+/*!
+ \brief Output a result line
+ \param store : name of store
+ \param nthreads : number of threads
+ \param nshards : number of shards
+ \param insertions : number of insertions
+ \param stored : number of stored nodes
+ \param seconds : running time
+ */
+void output(std::string const & store, std::size_t nthreads, std::size_t nshards, std::size_t insertions, std::size_t stored,
+            double seconds)
+{
+  std::cout << store << " " << nthreads << " " << nshards << " " << insertions << " " << stored << " " << seconds << " "
+            << (seconds > 0 ? static_cast<double>(insertions) / seconds : 0.0) << std::endl;
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 1) {
+      std::cerr << "Too many input files" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    std::string input_file = (optindex == argc ? "" : argv[optindex]);
+    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{tchecker::parsing::parse_system_declaration(input_file)};
+    if (sysdecl == nullptr || tchecker::log_error_count() > 0)
+      return EXIT_FAILURE;
+
+    std::vector<record_node_sptr_t> trace = record(*sysdecl);
+
+    double best = std::numeric_limits<double>::max();
+    std::size_t stored = 0;
+    for (std::size_t r = 0; r < rounds; ++r) {
+      auto && [seconds, nstored] = replay_sequential(trace);
+      best = std::min(best, seconds);
+      stored = nstored;
+    }
+    output("sequential", 1, 1, trace.size(), stored, best);
+
+    for (std::size_t nthreads : threads) {
+      best = std::numeric_limits<double>::max();
+      for (std::size_t r = 0; r < rounds; ++r) {
+        auto && [seconds, nstored] = replay_concurrent(trace, nthreads);
+        best = std::min(best, seconds);
+        stored = nstored;
+      }
+      output("concurrent", nthreads, shards, trace.size(), stored, best);
+    }
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/simd.hh"
+
+/*!
+ \file dbm-kernels.cc
+ \brief Microbenchmark for vectorized DBM kernels
+ \note Each DBM operation with a vectorized kernel is timed on random zones for
+ each dimension and each instruction set supported by the CPU
+ */
+
+static struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                       {"isa", required_argument, 0, 'i'},
+                                       {"iterations", required_argument, 0, 'n'},
+                                       {"max-dim", required_argument, 0, 'd'},
+                                       {"zones", required_argument, 0, 'z'},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"d:hi:n:z:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options]" << std::endl;
+  std::cerr << "   -d dim        maximal dimension (default: 64)" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -i isa        instruction set: scalar, sse4.2, avx2 (default: all supported)" << std::endl;
+  std::cerr << "   -n iter       number of passes over the zones (default: 20)" << std::endl;
+  std::cerr << "   -z zones      number of random zones for each dimension (default: 256)" << std::endl;
+  std::cerr << "outputs one line per configuration: isa dim operation ns/op" << std::endl;
+}
+
+static bool help = false;                                   /*!< Help flag */
+static tchecker::clock_id_t max_dim = 64;                   /*!< Maximal dimension */
+static std::size_t iterations = 20;                         /*!< Number of passes */
+static std::size_t zones = 256;                             /*!< Number of zones */
+static std::vector<enum tchecker::dbm::simd::isa_t> isas;   /*!< Instruction sets */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+
+    switch (c) {
+    case 'd':
+      max_dim = std::max<tchecker::clock_id_t>(2, std::strtoul(optarg, nullptr, 10));
+      break;
+    case 'h':
+      help = true;
+      break;
+    case 'i':
+      isas.push_back(tchecker::dbm::simd::parse_isa(optarg));
+      break;
+    case 'n':
+      iterations = std::max<std::size_t>(1, std::strtoull(optarg, nullptr, 10));
+      break;
+    case 'z':
+      zones = std::max<std::size_t>(1, std::strtoull(optarg, nullptr, 10));
+      break;
+    default:
+      throw std::runtime_error("This should never be executed");
+      break;
+    }
+  }
+  return optind;
+}
+
+/*!
+ \brief Random zone
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param gen : random generator
+ \post dbm is a non-empty tight zone obtained by random guards, resets and delays
+ */
+static void random_zone(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(1, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(0, 20);
+  std::uniform_int_distribution<int> op(0, 9);
+  std::vector<tchecker::dbm::db_t> copy(dim * dim);
+
+  tchecker::dbm::zero(dbm, dim);
+  for (tchecker::clock_id_t step = 0; step < 2 * dim; ++step) {
+    tchecker::dbm::copy(copy.data(), dbm, dim);
+    int o = op(gen);
+    if (o < 5) {
+      tchecker::dbm::open_up(dbm, dim);
+      if (tchecker::dbm::constrain(dbm, dim, clock(gen), 0, tchecker::LE, value(gen)) == tchecker::dbm::EMPTY)
+        tchecker::dbm::copy(dbm, copy.data(), dim);
+    }
+    else if (o < 8)
+      tchecker::dbm::reset_to_value(dbm, dim, clock(gen), 0);
+    else if (tchecker::dbm::constrain(dbm, dim, 0, clock(gen), tchecker::LE, -value(gen)) == tchecker::dbm::EMPTY)
+      tchecker::dbm::copy(dbm, copy.data(), dim);
+  }
+}
+
+/*!
+ \brief Time an operation
+ \param f : operation, called with the index of a zone
+ \return average time of f in nanoseconds over iterations * zones calls
+ */
+template <class F> static double time(F && f)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t n = 0; n < iterations; ++n)
+    for (std::size_t z = 0; z < zones; ++z)
+      f(z);
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(iterations * zones);
+}
+
+/*!
+ \brief Run benchmark for a dimension and the selected instruction set
+ \param dim : dimension
+ \param isa : instruction set
+ \post timing of each operation has been output to std::cout
+ */
+static void run(tchecker::clock_id_t dim, enum tchecker::dbm::simd::isa_t isa)
+{
+  std::mt19937 gen(dim);
+  std::size_t const size = dim * dim;
+  std::vector<tchecker::dbm::db_t> dbms(zones * size), work(zones * size);
+  std::vector<tchecker::integer_t> l(zones * (dim - 1)), u(zones * (dim - 1));
+
+  std::uniform_int_distribution<tchecker::integer_t> bound(-1, 15);
+  for (std::size_t z = 0; z < zones; ++z) {
+    random_zone(&dbms[z * size], dim, gen);
+    for (tchecker::clock_id_t x = 0; x + 1 < dim; ++x) {
+      tchecker::integer_t lx = bound(gen), ux = bound(gen);
+      l[z * (dim - 1) + x] = (lx < 0 ? -tchecker::dbm::INF_VALUE : lx);
+      u[z * (dim - 1) + x] = (ux < 0 ? -tchecker::dbm::INF_VALUE : ux);
+    }
+  }
+
+  tchecker::dbm::simd::select(isa);
+
+  volatile std::size_t sink = 0; // prevents the compiler from discarding results
+  auto report = [&](char const * op, double ns) {
+    std::cout << tchecker::dbm::simd::isa_name(isa) << " " << dim << " " << op << " " << std::fixed
+              << std::setprecision(1) << ns << std::endl;
+  };
+
+  // tighten after a reset breaks tightness
+  report("tighten", time([&](std::size_t z) {
+           tchecker::dbm::db_t * w = &work[z * size];
+           tchecker::dbm::copy(w, &dbms[z * size], dim);
+           w[(dim - 1) * dim] = tchecker::dbm::LE_ZERO;
+           w[dim - 1] = tchecker::dbm::LE_ZERO;
+           sink += tchecker::dbm::tighten(w, dim);
+         }));
+  report("copy", time([&](std::size_t z) {
+           tchecker::dbm::copy(&work[z * size], &dbms[z * size], dim);
+           sink += (work[z * size + 1] == tchecker::dbm::LT_INFINITY);
+         }));
+
+  report("is_le", time([&](std::size_t z) {
+           sink += tchecker::dbm::is_le(&dbms[z * size], &dbms[((z + 1) % zones) * size], dim);
+         }));
+  for (std::size_t z = 0; z < zones; ++z)
+    tchecker::dbm::copy(&work[z * size], &dbms[z * size], dim);
+  report("is_le_true", time([&](std::size_t z) {
+           sink += tchecker::dbm::is_le(&dbms[z * size], &work[z * size], dim);
+         }));
+  report("is_equal", time([&](std::size_t z) {
+           sink += tchecker::dbm::is_equal(&dbms[z * size], &work[z * size], dim);
+         }));
+
+  report("extra_lu", time([&](std::size_t z) {
+           tchecker::dbm::db_t * w = &work[z * size];
+           tchecker::dbm::copy(w, &dbms[z * size], dim);
+           tchecker::dbm::extra_lu(w, dim, &l[z * (dim - 1)], &u[z * (dim - 1)]);
+           sink += (w[1] == tchecker::dbm::LT_INFINITY);
+         }));
+  report("extra_m", time([&](std::size_t z) {
+           tchecker::dbm::db_t * w = &work[z * size];
+           tchecker::dbm::copy(w, &dbms[z * size], dim);
+           tchecker::dbm::extra_m(w, dim, &u[z * (dim - 1)]);
+           sink += (w[1] == tchecker::dbm::LT_INFINITY);
+         }));
+  report("is_alu_le", time([&](std::size_t z) {
+           sink += tchecker::dbm::is_alu_le(&dbms[z * size], &dbms[((z + 1) % zones) * size], dim, &l[z * (dim - 1)],
+                                            &u[z * (dim - 1)]);
+         }));
+}
+
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (optindex != argc) {
+      std::cerr << "Unexpected argument: " << argv[optindex] << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (isas.empty())
+      for (enum tchecker::dbm::simd::isa_t isa :
+           {tchecker::dbm::simd::ISA_SCALAR, tchecker::dbm::simd::ISA_SSE42, tchecker::dbm::simd::ISA_AVX2})
+        if (tchecker::dbm::simd::is_supported(isa))
+          isas.push_back(isa);
+
+    for (tchecker::clock_id_t dim = 2; dim <= max_dim; ++dim)
+      for (enum tchecker::dbm::simd::isa_t isa : isas)
+        run(dim, isa);
+  }
+  catch (std::exception & e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,435 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <getopt.h>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ts/sharing.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/zg/zg.hh"
+
+/*!
+ \file intval-packing.cc
+ \brief Size of bit-packed valuations of integer variables
+ \note The zone graph of a model is explored (breadth-first, with sharing of state
+ components). The reachable valuations of integer variables are packed following
+ packed_intval_layout_t, checked to unpack to the same valuation, and the
+ number of bytes used by a valuation, as well as the time taken to hash and compare
+ valuations, are reported for tchecker::intval_t and for packed valuations
+ */
+
+static struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                       {"rounds", required_argument, 0, 'r'},
+                                       {"block-size", required_argument, 0, 0},
+                                       {"table-size", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"hr:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -r rounds     number of times reachable valuations are hashed and compared (default: 100)" << std::endl;
+  std::cerr << "   --block-size  size of allocation blocks" << std::endl;
+  std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "outputs one line per encoding: encoding variables bits states valuations bytes/state ns/hash ns/compare"
+            << std::endl;
+  std::cerr << "(bytes/state is the size of one valuation, as stored by each state without sharing)" << std::endl;
+}
+
+static bool help = false;              /*!< Help flag */
+static std::size_t rounds = 100;       /*!< Number of rounds */
+static std::size_t block_size = 10000; /*!< Size of allocated blocks */
+static std::size_t table_size = 65536; /*!< Size of hash tables */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'h':
+        help = true;
+        break;
+      case 'r':
+        rounds = std::max<std::size_t>(1, std::strtoull(optarg, nullptr, 10));
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "block-size") == 0)
+        block_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
+        table_size = std::strtoull(optarg, nullptr, 10);
+      else
+        throw std::runtime_error("This also should never be executed");
+    }
+  }
+  return optind;
+}
+
+/*!
+ \brief Type of words in packed valuations
+ */
+using packed_word_t = std::uint64_t;
+
+/*!
+ \class packed_intval_layout_t
+ \brief Layout of bit-packed valuations of flat bounded integer variables
+ \note Each flat variable with domain min..max is stored as value - min on the smallest number of bits that can
+ represent max - min (variables with a single value take no bit at all). Variables are packed in declaration order in
+ an array of packed_word_t, and a variable never spans two words. Unused bits are always 0, hence packed valuations
+ can be hashed and compared word by word. Packed valuations have at least one word as soon as there is a variable
+ */
+class packed_intval_layout_t {
+public:
+  /*!
+   \brief Constructor
+   \param intvars : flat bounded integer variables
+   \post this is the layout of valuations of intvars
+   */
+  explicit packed_intval_layout_t(tchecker::flat_integer_variables_t const & intvars) : _words(0)
+  {
+    unsigned int constexpr word_bits = std::numeric_limits<packed_word_t>::digits;
+    unsigned int used_bits = word_bits; // no current word
+
+    _fields.reserve(intvars.size());
+    for (tchecker::intvar_id_t id = 0; id < intvars.size(); ++id) {
+      tchecker::intvar_info_t const & info = intvars.info(id);
+      std::int64_t const min = info.min(), max = info.max();
+      unsigned int width = 0;
+      for (std::uint64_t range = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min); range != 0;
+           range >>= 1)
+        ++width;
+
+      if (width > word_bits - used_bits) {
+        ++_words;
+        used_bits = 0;
+      }
+
+      packed_word_t const mask = (width == word_bits ? ~packed_word_t{0} : (packed_word_t{1} << width) - 1);
+      // variables of width 0 are read from the current word (or word 0) with an empty mask
+      unsigned int const word = (_words == 0 ? 0 : static_cast<unsigned int>(_words - 1));
+      _fields.push_back(field_t{min, mask, word, (width == 0 ? 0 : used_bits), width});
+      used_bits += width;
+    }
+
+    // reading variables of width 0 accesses word 0
+    if (!_fields.empty() && _words == 0)
+      _words = 1;
+  }
+
+  /*!
+   \brief Accessor
+   \return number of flat variables
+   */
+  inline tchecker::intvar_id_t size() const { return static_cast<tchecker::intvar_id_t>(_fields.size()); }
+
+  /*!
+   \brief Accessor
+   \return number of words in a packed valuation
+   */
+  inline std::size_t words() const { return _words; }
+
+  /*!
+   \brief Accessor
+   \return number of bytes in a packed valuation
+   */
+  inline std::size_t bytes() const { return _words * sizeof(packed_word_t); }
+
+  /*!
+   \brief Accessor
+   \param id : flat variable identifier
+   \pre id < size() (checked by assertion)
+   \return number of bits used to store variable id
+   */
+  inline unsigned int width(tchecker::intvar_id_t id) const
+  {
+    assert(id < _fields.size());
+    return _fields[id].width;
+  }
+
+  /*!
+   \brief Pack a valuation
+   \param intval : a valuation
+   \param p : packed valuation
+   \pre intval.size() == size(), intval is within the domains of the variables (checked by assertion), and p points
+   to words() words
+   \post p is the packed valuation of intval
+   */
+  void pack(tchecker::intval_t const & intval, packed_word_t * p) const
+  {
+    assert(intval.size() == _fields.size());
+    for (std::size_t i = 0; i < _words; ++i)
+      p[i] = 0;
+    for (tchecker::intvar_id_t id = 0; id < _fields.size(); ++id) {
+      field_t const & f = _fields[id];
+      packed_word_t const v = static_cast<packed_word_t>(static_cast<std::int64_t>(intval[id]) - f.min);
+      assert(v <= f.mask);
+      p[f.word] |= v << f.shift;
+    }
+  }
+
+  /*!
+   \brief Unpack a valuation
+   \param p : packed valuation
+   \param intval : a valuation
+   \pre p points to words() words and intval.size() == size() (checked by assertion)
+   \post intval is the valuation packed in p
+   */
+  void unpack(packed_word_t const * p, tchecker::intval_t & intval) const
+  {
+    assert(intval.size() == _fields.size());
+    for (tchecker::intvar_id_t id = 0; id < _fields.size(); ++id) {
+      field_t const & f = _fields[id];
+      intval[id] = static_cast<tchecker::integer_t>(f.min + static_cast<std::int64_t>((p[f.word] >> f.shift) & f.mask));
+    }
+  }
+
+  /*!
+   \brief Hash
+   \param p : packed valuation
+   \pre p points to words() words
+   \return hash value of p, computed word by word
+   */
+  inline std::size_t hash(packed_word_t const * p) const { return boost::hash_range(p, p + _words); }
+
+  /*!
+   \brief Equality check
+   \param p1 : packed valuation
+   \param p2 : packed valuation
+   \pre p1 and p2 point to words() words
+   \return true if p1 and p2 are the same valuation, false otherwise
+   */
+  inline bool equal(packed_word_t const * p1, packed_word_t const * p2) const
+  {
+    for (std::size_t i = 0; i < _words; ++i)
+      if (p1[i] != p2[i])
+        return false;
+    return true;
+  }
+
+private:
+  /*!
+   \brief Position of a variable in packed valuations
+   */
+  struct field_t {
+    std::int64_t min;   /*!< Minimal value of the variable */
+    packed_word_t mask; /*!< Mask of width bits */
+    unsigned int word;  /*!< Index of the word storing the variable */
+    unsigned int shift; /*!< Position of the lowest bit of the variable in its word */
+    unsigned int width; /*!< Number of bits */
+  };
+
+  std::vector<field_t> _fields; /*!< Position of variables, indexed by flat variable identifiers */
+  std::size_t _words;           /*!< Number of words in packed valuations */
+};
+
+/*!
+ \brief Hash of states on values
+ */
+struct state_hash_t {
+  std::size_t operator()(tchecker::zg::const_state_sptr_t const & s) const { return tchecker::zg::hash_value(*s); }
+};
+
+/*!
+ \brief Equality of states on values
+ */
+struct state_equal_to_t {
+  bool operator()(tchecker::zg::const_state_sptr_t const & s1, tchecker::zg::const_state_sptr_t const & s2) const
+  {
+    return *s1 == *s2;
+  }
+};
+
+/*!
+ \brief Breadth-first exploration of a zone graph
+ \param zg : a zone graph
+ \param valuations : reachable valuations of integer variables
+ \return number of visited states
+ \pre zg shares state components
+ \post valuations contains every reachable valuation of integer variables, once
+ \note valuations shall be released before zg
+ */
+std::size_t explore(tchecker::zg::zg_t & zg,
+                    std::vector<tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const>> & valuations)
+{
+  std::unordered_set<tchecker::zg::const_state_sptr_t, state_hash_t, state_equal_to_t> visited;
+  std::unordered_set<tchecker::shared_intval_t const *> shared_valuations; // valuations are shared, hence unique
+  std::deque<tchecker::zg::const_state_sptr_t> waiting;
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+
+  zg.initial(v);
+  while (true) {
+    for (auto && [status, s, t] : v) {
+      tchecker::zg::const_state_sptr_t const cs{s};
+      if (!visited.insert(cs).second)
+        continue;
+      waiting.push_back(cs);
+      if (shared_valuations.insert(cs->intval_ptr().ptr()).second)
+        valuations.push_back(cs->intval_ptr());
+    }
+    v.clear();
+    if (waiting.empty())
+      break;
+    zg.next(waiting.front(), v);
+    waiting.pop_front();
+  }
+  return visited.size();
+}
+
+/*!
+ \brief Time hashing and comparison of valuations
+ \param n : number of valuations
+ \param hash : function that hashes the i-th valuation
+ \param equal : function that compares the i-th and j-th valuations
+ \return nanoseconds per hash, nanoseconds per comparison
+ */
+template <class HASH, class EQUAL> std::tuple<double, double> measure(std::size_t n, HASH && hash, EQUAL && equal)
+{
+  std::size_t sink = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t r = 0; r < rounds; ++r)
+    for (std::size_t i = 0; i < n; ++i)
+      sink += hash(i);
+  auto end = std::chrono::steady_clock::now();
+  double const hash_ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * n);
+
+  start = std::chrono::steady_clock::now();
+  for (std::size_t r = 0; r < rounds; ++r)
+    for (std::size_t i = 0; i < n; ++i)
+      sink += equal(i, (i + r) % n);
+  end = std::chrono::steady_clock::now();
+  double const equal_ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * n);
+
+  if (sink == 1) // keeps the loops from being optimized away
+    std::cerr << "";
+  return std::make_tuple(hash_ns, equal_ns);
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 1) {
+      std::cerr << "Too many input files" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    std::string input_file = (optindex == argc ? "" : argv[optindex]);
+    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{tchecker::parsing::parse_system_declaration(input_file)};
+    if (sysdecl == nullptr || tchecker::log_error_count() > 0)
+      return EXIT_FAILURE;
+
+    std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+    packed_intval_layout_t const layout{system->integer_variables().flattened()};
+    std::size_t const size = layout.size();
+    if (size == 0) {
+      std::cerr << "No integer variable" << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    // valuations shall be released before the zone graph
+    std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING,
+                                                                 tchecker::zg::ELAPSED_SEMANTICS,
+                                                                 tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+    if (zg.get() == nullptr)
+      throw std::runtime_error("Clock bounds cannot be computed for the system");
+
+    std::vector<tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const>> valuations;
+    std::size_t const states = explore(*zg, valuations);
+    std::size_t const n = valuations.size();
+
+    std::size_t const words = layout.words();
+    std::vector<packed_word_t> packed(n * words);
+    tchecker::intval_t * unpacked = tchecker::intval_allocate_and_construct(static_cast<unsigned short>(size),
+                                                                                  static_cast<unsigned short>(size));
+    for (std::size_t i = 0; i < n; ++i) {
+      layout.pack(*valuations[i], packed.data() + i * words);
+      layout.unpack(packed.data() + i * words, *unpacked);
+      if (!(*unpacked == *valuations[i]))
+        throw std::runtime_error("Unpacked valuation differs from packed valuation");
+    }
+    tchecker::intval_destruct_and_deallocate(unpacked);
+
+    unsigned int bits = 0;
+    for (tchecker::intvar_id_t id = 0; id < size; ++id)
+      bits += layout.width(id);
+
+    auto && [intval_hash_ns, intval_equal_ns] = measure(
+        n, [&](std::size_t i) { return boost::hash<tchecker::intval_t>{}(*valuations[i]); },
+        [&](std::size_t i, std::size_t j) { return *valuations[i] == *valuations[j]; });
+    auto && [packed_hash_ns, packed_equal_ns] = measure(
+        n, [&](std::size_t i) { return layout.hash(packed.data() + i * words); },
+        [&](std::size_t i, std::size_t j) { return layout.equal(packed.data() + i * words, packed.data() + j * words); });
+
+    std::cout << "intval " << size << " " << size * sizeof(tchecker::integer_t) * 8 << " " << states << " " << n << " "
+              << tchecker::allocation_size_t<tchecker::shared_intval_t>::alloc_size(static_cast<unsigned short>(size)) << " "
+              << intval_hash_ns << " " << intval_equal_ns << std::endl;
+    std::cout << "packed " << size << " " << bits << " " << states << " " << n << " " << layout.bytes() << " "
+              << packed_hash_ns << " " << packed_equal_ns << std::endl;
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,325 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <getopt.h>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ts/sharing.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/zg/zg.hh"
+
+/*!
+ \file state-layout.cc
+ \brief Benchmark of state layouts in zone graphs
+ \note The zone graph of a model is explored (breadth-first, states are compared by
+ value) for each type of sharing: tchecker::ts::NO_SHARING and tchecker::ts::SHARING.
+ Running time and hardware cache misses (when available) are reported for each of them
+ */
+
+static struct option long_options[] = {{"help", no_argument, 0, 'h'},
+                                       {"rounds", required_argument, 0, 'r'},
+                                       {"block-size", required_argument, 0, 0},
+                                       {"table-size", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"hr:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -r rounds     number of explorations for each layout, best time is reported (default: 3)" << std::endl;
+  std::cerr << "   --block-size  size of allocation blocks" << std::endl;
+  std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "outputs one line per layout: layout states transitions seconds states/s cache-misses" << std::endl;
+  std::cerr << "(cache-misses is - if hardware counters are not available)" << std::endl;
+}
+
+static bool help = false;              /*!< Help flag */
+static std::size_t rounds = 3;         /*!< Number of rounds */
+static std::size_t block_size = 10000; /*!< Size of allocated blocks */
+static std::size_t table_size = 65536; /*!< Size of hash tables */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'h':
+        help = true;
+        break;
+      case 'r':
+        rounds = std::max<std::size_t>(1, std::strtoull(optarg, nullptr, 10));
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "block-size") == 0)
+        block_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
+        table_size = std::strtoull(optarg, nullptr, 10);
+      else
+        throw std::runtime_error("This also should never be executed");
+    }
+  }
+  return optind;
+}
+
+/*!
+ \class cache_misses_counter_t
+ \brief Counter of hardware cache misses of the calling thread
+ \note counting is not available on systems other than Linux, or when access to
+ performance counters is not permitted (see perf_event_paranoid)
+ */
+class cache_misses_counter_t {
+public:
+  /*!
+   \brief Constructor
+   \post the counter is open if hardware cache misses can be counted
+   */
+  cache_misses_counter_t() : _fd(-1)
+  {
+#if defined(__linux__)
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    _fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  cache_misses_counter_t(cache_misses_counter_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~cache_misses_counter_t()
+  {
+#if defined(__linux__)
+    if (_fd >= 0)
+      ::close(_fd);
+#endif
+  }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  cache_misses_counter_t & operator=(cache_misses_counter_t const &) = delete;
+
+  /*!
+   \brief Accessor
+   \return true if cache misses are counted, false otherwise
+   */
+  inline bool available() const { return _fd >= 0; }
+
+  /*!
+   \brief Start counting
+   \post the counter has been reset and enabled
+   */
+  void start()
+  {
+#if defined(__linux__)
+    if (_fd >= 0) {
+      ::ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  /*!
+   \brief Stop counting
+   \return number of cache misses since last call to start (0 if not available)
+   */
+  std::uint64_t stop()
+  {
+    std::uint64_t count = 0;
+#if defined(__linux__)
+    if (_fd >= 0) {
+      ::ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0);
+      if (::read(_fd, &count, sizeof(count)) != sizeof(count))
+        count = 0;
+    }
+#endif
+    return count;
+  }
+
+private:
+  int _fd; /*!< File descriptor of the counter (-1 if not available) */
+};
+
+/*!
+ \brief Hash of states on values, for every type of sharing
+ */
+struct state_hash_t {
+  std::size_t operator()(tchecker::zg::const_state_sptr_t const & s) const { return tchecker::zg::hash_value(*s); }
+};
+
+/*!
+ \brief Equality of states on values, for every type of sharing
+ */
+struct state_equal_to_t {
+  bool operator()(tchecker::zg::const_state_sptr_t const & s1, tchecker::zg::const_state_sptr_t const & s2) const
+  {
+    return *s1 == *s2;
+  }
+};
+
+/*!
+ \brief Breadth-first exploration of a zone graph
+ \param system : a system of timed processes
+ \param sharing_type : type of sharing
+ \param counter : counter of cache misses
+ \return running time (seconds), number of visited states, number of explored transitions, number of cache misses
+ */
+std::tuple<double, std::size_t, std::size_t, std::uint64_t>
+explore(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
+        cache_misses_counter_t & counter)
+{
+  counter.start();
+  auto start = std::chrono::steady_clock::now();
+
+  // states shall be released before the zone graph
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, sharing_type, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+  if (zg.get() == nullptr)
+    throw std::runtime_error("Clock bounds cannot be computed for the system");
+
+  std::size_t transitions = 0;
+  std::unordered_set<tchecker::zg::const_state_sptr_t, state_hash_t, state_equal_to_t> visited;
+  std::deque<tchecker::zg::const_state_sptr_t> waiting;
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+
+  zg->initial(v);
+  while (true) {
+    for (auto && [status, s, t] : v) {
+      ++transitions;
+      tchecker::zg::const_state_sptr_t const cs{s};
+      if (visited.insert(cs).second)
+        waiting.push_back(cs);
+    }
+    v.clear();
+    if (waiting.empty())
+      break;
+    zg->next(waiting.front(), v);
+    waiting.pop_front();
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  std::uint64_t const cache_misses = counter.stop();
+  return std::make_tuple(std::chrono::duration<double>(end - start).count(), visited.size(), transitions, cache_misses);
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 1) {
+      std::cerr << "Too many input files" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    std::string input_file = (optindex == argc ? "" : argv[optindex]);
+    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{tchecker::parsing::parse_system_declaration(input_file)};
+    if (sysdecl == nullptr || tchecker::log_error_count() > 0)
+      return EXIT_FAILURE;
+
+    std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+    cache_misses_counter_t counter;
+
+    std::tuple<char const *, enum tchecker::ts::sharing_type_t> const layouts[] = {
+        {"no-sharing", tchecker::ts::NO_SHARING}, {"sharing", tchecker::ts::SHARING}};
+
+    for (auto && [name, sharing_type] : layouts) {
+      double best = std::numeric_limits<double>::max();
+      std::uint64_t best_cache_misses = 0;
+      std::size_t states = 0, transitions = 0;
+      for (std::size_t r = 0; r < rounds; ++r) {
+        auto && [seconds, nstates, ntransitions, cache_misses] = explore(system, sharing_type, counter);
+        if (seconds < best) {
+          best = seconds;
+          best_cache_misses = cache_misses;
+        }
+        states = nstates;
+        transitions = ntransitions;
+      }
+      std::cout << name << " " << states << " " << transitions << " " << best << " "
+                << (best > 0 ? static_cast<double>(states) / best : 0.0) << " ";
+      if (counter.available())
+        std::cout << best_cache_misses << std::endl;
+      else
+        std::cout << "-" << std::endl;
+    }
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+#!/usr/bin/env bash
+
+# This file is a part of the TChecker project.
+#
+# See files AUTHORS and LICENSE for copyright details.
+
+# Benchmark harness for tck-reach and tck-liveness. Command run sweeps the model
+# generators in examples/ over the parameters listed in a models file, runs each
+# algorithm in each search order on every model, and outputs one CSV line per
+# run. Command compare reports the runs of a CSV file that are slower, use more
+# memory, or give another verdict than in a baseline CSV file.
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+
+REACH_ALGORITHMS="reach covreach aLU-covreach concur19"
+LIVENESS_ALGORITHMS="ndfs couvscc"
+
+BIN_DIR="."
+EXAMPLES_DIR="${SCRIPT_DIR}/../examples"
+MODELS_FILE="${SCRIPT_DIR}/tck-bench.models"
+ALGORITHMS="${REACH_ALGORITHMS} ${LIVENESS_ALGORITHMS}"
+SEARCH_ORDERS="bfs dfs"
+TIMEOUT=300
+OUTPUT=""
+THRESHOLD=10
+MIN_TIME=0.1
+
+CSV_HEADER="model,algorithm,search_order,status,wall_time_s,running_time_s,max_rss_kb,visited_states,stored_states,visited_transitions,transitions_per_s,verdict"
+
+function usage() {
+    echo "Usage: $0 run [options]"
+    echo "       $0 compare [options] baseline.csv current.csv"
+    echo ""
+    echo "run options:"
+    echo "   -a a1,a2,...  algorithms (default: all of ${REACH_ALGORITHMS} ${LIVENESS_ALGORITHMS})"
+    echo "   -b dir        directory of tck-reach and tck-liveness (default: .)"
+    echo "   -e dir        directory of model generators (default: ${EXAMPLES_DIR})"
+    echo "   -m file       models file (default: ${MODELS_FILE})"
+    echo "   -o file       output CSV file (default: standard output)"
+    echo "   -s s1,s2,...  search orders of tck-reach algorithms (default: bfs,dfs)"
+    echo "                 liveness algorithms are only run in dfs order"
+    echo "   -t seconds    time limit of each run (default: ${TIMEOUT})"
+    echo ""
+    echo "compare options:"
+    echo "   -t percent    regression threshold (default: ${THRESHOLD})"
+    echo "   -m seconds    runs faster than this in both files are not compared on time (default: ${MIN_TIME})"
+    echo ""
+    echo "compare exits with status 1 if a regression has been found"
+}
+
+# Expand ranges a..b in a models line
+# $1 : arguments expanded so far
+# $2... : remaining arguments
+function expand() {
+    local prefix="$1"
+    shift
+    if [ $# -eq 0 ]; then
+        echo "${prefix}"
+        return
+    fi
+    local arg="$1"
+    shift
+    if [[ "${arg}" =~ ^([0-9]+)\.\.([0-9]+)$ ]]; then
+        for v in $(seq "${BASH_REMATCH[1]}" "${BASH_REMATCH[2]}"); do
+            expand "${prefix} ${v}" "$@"
+        done
+    else
+        expand "${prefix} ${arg}" "$@"
+    fi
+}
+
+# Run one algorithm on one model, and output a CSV line
+# $1 : model name
+# $2 : model file
+# $3 : algorithm
+# $4 : search order
+function run_one() {
+    local name="$1" model="$2" algorithm="$3" order="$4"
+    local labels
+    labels=$(grep -e "^# *labels *= *" "${model}" | head -1 | sed -e 's/^# *labels *= *//' -e 's/ *$//' | tr : ,)
+
+    local command
+    if [[ " ${LIVENESS_ALGORITHMS} " == *" ${algorithm} "* ]]; then
+        command=("${BIN_DIR}/tck-liveness" -a "${algorithm}")
+    else
+        command=("${BIN_DIR}/tck-reach" -a "${algorithm}" -s "${order}")
+    fi
+    if [ -n "${labels}" ]; then
+        command+=(-l "${labels}")
+    fi
+    command+=("${model}")
+
+    local start end status output
+    start=$(date +%s.%N)
+    output=$(timeout "${TIMEOUT}" "${command[@]}" 2>/dev/null < /dev/null)
+    status=$?
+    end=$(date +%s.%N)
+
+    if [ ${status} -eq 124 ]; then
+        status="timeout"
+    elif [ ${status} -ne 0 ]; then
+        status="error"
+    else
+        status="ok"
+    fi
+
+    echo "${output}" | awk -v name="${name}" -v algorithm="${algorithm}" -v order="${order}" -v status="${status}" \
+                           -v start="${start}" -v end="${end}" '
+        { value[$1] = $2 }
+        END {
+            if (status != "ok") {
+                printf "%s,%s,%s,%s,%.3f,,,,,,,\n", name, algorithm, order, status, end - start
+                exit
+            }
+            states = ("VISITED_STATES" in value ? value["VISITED_STATES"] : value["VISITED_STATES_TOTAL"])
+            transitions = ("VISITED_TRANSITIONS" in value ? value["VISITED_TRANSITIONS"] : value["VISITED_TRANSITIONS_TOTAL"])
+            verdict = ("REACHABLE" in value ? value["REACHABLE"] : value["CYCLE"])
+            time = value["RUNNING_TIME_SECONDS"]
+            rate = (time > 0 ? transitions / time : 0)
+            printf "%s,%s,%s,%s,%.3f,%.6f,%s,%s,%s,%s,%.0f,%s\n", name, algorithm, order, status, end - start, time,
+                   value["MEMORY_MAX_RSS"], states, value["STORED_STATES"], transitions, rate, verdict
+        }'
+}
+
+# Run the benchmarks
+function run() {
+    while getopts "a:b:e:m:o:s:t:" opt; do
+        case ${opt} in
+            a) ALGORITHMS=$(echo "${OPTARG}" | tr , ' ') ;;
+            b) BIN_DIR="${OPTARG}" ;;
+            e) EXAMPLES_DIR="${OPTARG}" ;;
+            m) MODELS_FILE="${OPTARG}" ;;
+            o) OUTPUT="${OPTARG}" ;;
+            s) SEARCH_ORDERS=$(echo "${OPTARG}" | tr , ' ') ;;
+            t) TIMEOUT="${OPTARG}" ;;
+            *) usage; exit 1 ;;
+        esac
+    done
+
+    for tool in tck-reach tck-liveness; do
+        if [ ! -x "${BIN_DIR}/${tool}" ]; then
+            echo 1>&2 "missing executable ${BIN_DIR}/${tool}"
+            exit 1
+        fi
+    done
+    if [ ! -f "${MODELS_FILE}" ]; then
+        echo 1>&2 "missing models file ${MODELS_FILE}"
+        exit 1
+    fi
+
+    WORK_DIR=$(mktemp -d "${TMPDIR:-/tmp}/tck-bench.XXXXXX")
+    trap 'rm -rf "${WORK_DIR}"' EXIT
+
+    if [ -n "${OUTPUT}" ]; then
+        exec > "${OUTPUT}"
+    fi
+    echo "${CSV_HEADER}"
+
+    grep -v -e '^ *#' -e '^ *$' "${MODELS_FILE}" | while read -r generator args; do
+        expand "" ${args} | while read -r params; do
+            local name
+            name=$(basename "${generator}" .sh)
+            if [ -n "${params}" ]; then
+                name="${name}_$(echo "${params}" | tr ' ' _)"
+            fi
+            local model="${WORK_DIR}/${name}.tck"
+            if ! bash "${EXAMPLES_DIR}/${generator}" ${params} > "${model}" 2>/dev/null < /dev/null; then
+                echo 1>&2 "cannot generate ${name}"
+                continue
+            fi
+            for algorithm in ${ALGORITHMS}; do
+                if [[ " ${LIVENESS_ALGORITHMS} " == *" ${algorithm} "* ]]; then
+                    run_one "${name}" "${model}" "${algorithm}" dfs
+                else
+                    for order in ${SEARCH_ORDERS}; do
+                        run_one "${name}" "${model}" "${algorithm}" "${order}"
+                    done
+                fi
+            done
+            rm -f "${model}"
+        done
+    done
+}
+
+# Compare two benchmark results
+function compare() {
+    while getopts "m:t:" opt; do
+        case ${opt} in
+            m) MIN_TIME="${OPTARG}" ;;
+            t) THRESHOLD="${OPTARG}" ;;
+            *) usage; exit 1 ;;
+        esac
+    done
+    shift $((OPTIND - 1))
+
+    if [ $# -ne 2 ]; then
+        usage
+        exit 1
+    fi
+
+    awk -F, -v threshold="${THRESHOLD}" -v min_time="${MIN_TIME}" '
+        function report(key, metric, base, current) {
+            if (base > 0)
+                printf "REGRESSION %s %s %s -> %s (%+.1f%%)\n", key, metric, base, current, 100 * (current - base) / base
+            else
+                printf "REGRESSION %s %s %s -> %s\n", key, metric, base, current
+            ++regressions
+        }
+        FNR == 1 { next }
+        NR == FNR {
+            key = $1 "," $2 "," $3
+            status[key] = $4; time[key] = $6; rss[key] = $7; states[key] = $8; verdict[key] = $12
+            next
+        }
+        {
+            key = $1 "," $2 "," $3
+            if (!(key in status))
+                next
+            ++compared
+            factor = 1 + threshold / 100
+            if (status[key] == "ok" && $4 != "ok")
+                report(key, "status", status[key], $4)
+            if (status[key] != "ok" || $4 != "ok")
+                next
+            if (verdict[key] != $12)
+                report(key, "verdict", verdict[key], $12)
+            if (($6 >= min_time || time[key] >= min_time) && $6 > time[key] * factor)
+                report(key, "running_time_s", time[key], $6)
+            if ($7 > rss[key] * factor)
+                report(key, "max_rss_kb", rss[key], $7)
+            if ($8 != states[key])
+                printf "CHANGED %s visited_states %s -> %s\n", key, states[key], $8
+        }
+        END {
+            printf "%d run(s) compared, %d regression(s) above %s%%\n", compared, regressions, threshold
+            exit (regressions > 0 ? 1 : 0)
+        }' "$1" "$2"
+}
+
+if [ $# -lt 1 ]; then
+    usage
+    exit 1
+fi
+
+COMMAND="$1"
+shift
+case "${COMMAND}" in
+    run) run "$@" ;;
+    compare) compare "$@" ;;
+    -h|--help|help) usage ;;
+    *) usage; exit 1 ;;
+esac
@@ -19,6 +19,11 @@ endif()
 
 message(STATUS "Setting sizeof(integer_t) to ${INTEGER_T_SIZE}")
 
+# Traces with a level above TCHECKER_TRACE_LEVEL are compiled out
+# (0: no trace, 1: phases, 2: steps of the algorithms)
+set(TCHECKER_TRACE_LEVEL 1 CACHE STRING "Maximal trace level compiled in TChecker (0, 1 or 2)")
+message(STATUS "Setting trace level to ${TCHECKER_TRACE_LEVEL}")
+
 #
 # Check if "flag" is accepted by the current CXX compiler. If the flag is
 # supported its value is assigned to the variable "var"; else "var" is asigned
@@ -13,13 +13,18 @@
  \brief Reachability algorithm with covering
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iterator>
+#include <random>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/covreach/stats.hh"
 #include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/utils/trace.hh"
 #include "tchecker/waiting/factory.hh"
 
 namespace tchecker {
@@ -44,7 +49,8 @@ enum covering_t {
  \tparam GRAPH : type of graph, should derive from
  tchecker::graph::subsumption::graph_t, and nodes of type GRAPH::shared_node_t
  should have a method state_ptr() that yields a pointer to the corresponding
- state in TS.
+ state in TS. The state of a node is not accessed after GRAPH::passed_node()
+ has been called on this node.
  \note For correctness of the algorithm, the covering relation over nodes in GRAPH
  should be a trace inclusion, and it should be irreflexive: a node should not
  cover itself
@@ -53,6 +59,42 @@ template <class TS, class GRAPH> class algorithm_t {
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
+  /*!
+   \brief Constructor
+   \post the algorithm is deterministic and cannot be cancelled
+   */
+  algorithm_t() : _randomized(false), _seed(0), _cancel(nullptr), _cancelled(false) {}
+
+  /*!
+   \brief Randomize the search
+   \param seed : seed of the random generator
+   \post initial and successor states are expanded in random order, and random
+   waiting containers are seeded from seed. Runs with the same seed visit nodes
+   in the same order
+   */
+  void randomize(std::uint64_t seed)
+  {
+    _randomized = true;
+    _seed = seed;
+    _rng.seed(seed);
+  }
+
+  /*!
+   \brief Cancel runs on a flag
+   \param cancel : a flag
+   \post runs stop visiting nodes as soon as cancel is set
+   \note cancel is read concurrently: it can be set by another thread, and it
+   should outlive the runs of this algorithm
+   */
+  void cancel_on(std::atomic<bool> const & cancel) { _cancel = &cancel; }
+
+  /*!
+   \brief Accessor
+   \return true if the last run has been stopped by the cancel flag (see cancel_on),
+   false otherwise
+   */
+  inline bool cancelled() const { return _cancelled; }
+
   /*!
    \brief Build a covering reachability graph of a transition system from its
    initial states
@@ -77,15 +119,16 @@ public:
   tchecker::algorithms::covreach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                                               enum tchecker::waiting::policy_t policy)
   {
-    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{
+        _randomized ? tchecker::waiting::factory<node_sptr_t>(policy, _seed) : tchecker::waiting::factory<node_sptr_t>(policy)};
     tchecker::algorithms::covreach::stats_t stats;
     std::vector<node_sptr_t> nodes, covered_nodes;
 
+    _cancelled = false;
     stats.set_start_time();
 
-    std::cout << "[covreach] expand_initial_nodes" << std::endl;
     expand_initial_nodes(ts, graph, nodes, stats);
-    std::cout << "[covreach] initial nodes count=" << nodes.size() << std::endl;
+    TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_COVREACH, nodes.size() << " initial node(s)");
     for (node_sptr_t const & n : nodes)
       waiting->insert(n);
     nodes.clear();
@@ -93,11 +136,15 @@ public:
     while (!waiting->empty()) {
       if (waiting->empty())
         break;
+      if (_cancel != nullptr && _cancel->load(std::memory_order_relaxed)) {
+        _cancelled = true;
+        break;
+      }
       node_sptr_t node = waiting->first();
       waiting->remove_first();
 
-      std::cout << "[covreach] visiting node" << std::endl;
       ++stats.visited_states();
+      TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_STEP, tchecker::trace::CATEGORY_COVREACH, "visiting node " << stats.visited_states());
 
       if (accepting(node, ts, labels)) {
         node->final(true);
@@ -105,8 +152,8 @@ public:
         break;
       }
 
-      std::cout << "[covreach] expanding successors" << std::endl;
       expand_next_nodes(node, ts, graph, nodes, stats);
+      graph.passed_node(node);
 
       for (node_sptr_t const & next_node : nodes) {
         waiting->insert(next_node);
@@ -123,6 +170,8 @@ public:
     waiting->clear();
 
     stats.stored_states() = graph.nodes_count();
+    TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_COVREACH,
+                   stats.visited_states() << " visited node(s), " << stats.stored_states() << " stored node(s)");
 
     stats.set_end_time();
 
@@ -146,9 +195,9 @@ public:
     std::vector<typename TS::sst_t> sst;
     typename GRAPH::node_sptr_t covering_node;
 
-    std::cout << "[covreach] ts.initial()" << std::endl;
     ts.initial(sst);
-    std::cout << "[covreach] ts.initial() produced " << sst.size() << " entries" << std::endl;
+    if (_randomized)
+      std::shuffle(sst.begin(), sst.end(), _rng);
     for (auto && [status, s, t] : sst) {
       typename GRAPH::node_sptr_t n = graph.add_node(s);
       n->initial(true);
@@ -156,10 +205,8 @@ public:
         graph.remove_node(n);
         ++stats.covered_states();
       }
-      else {
-        graph.seed_state(n->state());
+      else
         initial_nodes.push_back(n);
-      }
     }
   }
 
@@ -188,7 +235,9 @@ public:
     typename GRAPH::node_sptr_t covering_node;
 
     ts.next(node->state_ptr(), sst);
-    std::cout << "[covreach] ts.next produced " << sst.size() << " successors" << std::endl;
+    if (_randomized)
+      std::shuffle(sst.begin(), sst.end(), _rng);
+    TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_STEP, tchecker::trace::CATEGORY_COVREACH, sst.size() << " successor(s)");
     for (auto && [status, s, t] : sst) {
       if (status != tchecker::STATE_OK)
         continue;
@@ -196,13 +245,11 @@ public:
       typename GRAPH::node_sptr_t next_node = graph.add_node(s);
       if (graph.is_covered(next_node, covering_node)) {
         // 已存在覆盖该后继的节点：记录一条 subsumption 边并丢弃被支配的后继
-        graph.record_transition(node->state(), next_node->state(), *t);
         graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
         graph.remove_node(next_node);
         ++stats.covered_states();
       }
       else {
-        graph.seed_state(next_node->state());
         graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
         next_nodes.push_back(next_node);
       }
@@ -249,6 +296,13 @@ public:
   {
     return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
   }
+
+private:
+  bool _randomized;                  /*!< Whether the search is randomized */
+  std::uint64_t _seed;               /*!< Seed of the random generator */
+  std::mt19937_64 _rng;              /*!< Random generator */
+  std::atomic<bool> const * _cancel; /*!< Cancel flag (nullptr if none) */
+  bool _cancelled;                   /*!< Whether the last run has been cancelled */
 };
 
 } // end of namespace covreach
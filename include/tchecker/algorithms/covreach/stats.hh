@@ -83,6 +83,78 @@ public:
   */
   unsigned long stored_states() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the number of full DBM tightenings that have been avoided
+   */
+  unsigned long & saved_tightens();
+
+  /*!
+   \brief Accessor
+   \return The number of full DBM tightenings that have been avoided
+   */
+  unsigned long saved_tightens() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of bytes used to store states
+   */
+  unsigned long & storage_bytes();
+
+  /*!
+   \brief Accessor
+   \return The number of bytes used to store states
+   */
+  unsigned long storage_bytes() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of bytes of zones spilled to disk
+   */
+  unsigned long & spilled_bytes();
+
+  /*!
+   \brief Accessor
+   \return The number of bytes of zones spilled to disk
+   */
+  unsigned long spilled_bytes() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of covering checks of comparable states
+   */
+  unsigned long & signature_checks();
+
+  /*!
+   \brief Accessor
+   \return The number of covering checks of comparable states
+   */
+  unsigned long signature_checks() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of covering checks rejected on zone signatures
+   */
+  unsigned long & signature_rejections();
+
+  /*!
+   \brief Accessor
+   \return The number of covering checks rejected on zone signatures
+   */
+  unsigned long signature_rejections() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of failed covering checks that have not been rejected on zone signatures
+   */
+  unsigned long & signature_misses();
+
+  /*!
+   \brief Accessor
+   \return The number of failed covering checks that have not been rejected on zone signatures
+   */
+  unsigned long signature_misses() const;
+
   /*!
    \brief Accessor
    \return A reference to the reachable state flag
@@ -98,16 +170,35 @@ public:
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post every statistics has been added to m
+   \post every statistics has been added to m, except detailed statistics (see
+   detailed_attributes). The number of spilled bytes is only added when zones have
+   been spilled
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
+  /*!
+   \brief Extract detailed statistics as attributes (key, value)
+   \param m : attributes map
+   \post statistics on the internals of the algorithm (number of saved tightenings,
+   number of bytes per stored state, filtering of covering checks on zone signatures)
+   have been added to m. The number of bytes per stored state is only added when it
+   has been measured, and statistics on zone signatures are only added when covering
+   checks have been filtered on signatures
+  */
+  void detailed_attributes(std::map<std::string, std::string> & m) const;
+
 private:
-  unsigned long _visited_states;      /*!< Number of visited states */
-  unsigned long _visited_transitions; /*!< Number of visited transitions */
-  unsigned long _covered_states;      /*!< Number of covered states */
-  unsigned long _stored_states;       /*!< Number of stored states */
-  bool _reachable;                    /*!< Reachability of satisfying state */
+  unsigned long _visited_states;       /*!< Number of visited states */
+  unsigned long _visited_transitions;  /*!< Number of visited transitions */
+  unsigned long _covered_states;       /*!< Number of covered states */
+  unsigned long _stored_states;        /*!< Number of stored states */
+  unsigned long _saved_tightens;       /*!< Number of avoided full DBM tightenings */
+  unsigned long _storage_bytes;        /*!< Number of bytes used to store states (0 if not measured) */
+  unsigned long _spilled_bytes;        /*!< Number of bytes of zones spilled to disk */
+  unsigned long _signature_checks;     /*!< Number of covering checks of comparable states */
+  unsigned long _signature_rejections; /*!< Number of covering checks rejected on zone signatures */
+  unsigned long _signature_misses;     /*!< Number of failed covering checks not rejected on zone signatures */
+  bool _reachable;                     /*!< Reachability of satisfying state */
 };
 
 } // end of namespace covreach
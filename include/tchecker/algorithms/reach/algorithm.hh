@@ -35,7 +35,8 @@ namespace reach {
  \tparam GRAPH : type of graph, should derive from
  tchecker::graph::reachability_graph_t, and nodes of type GRAPH::shared_node_t
  should have a method state_ptr() that yields a pointer to the corresponding
- state in TS
+ state in TS. The state of a node is not accessed after GRAPH::passed_node()
+ has been called on this node.
  */
 template <class TS, class GRAPH> class algorithm_t {
 public:
@@ -154,6 +155,7 @@ private:
         ++stats.visited_transitions();
       }
       sst.clear();
+      graph.passed_node(node);
     }
 
     waiting.clear();
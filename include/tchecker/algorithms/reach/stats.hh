@@ -59,6 +59,18 @@ public:
   */
   unsigned long visited_transitions() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the number of bytes of zones spilled to disk
+   */
+  unsigned long & spilled_bytes();
+
+  /*!
+   \brief Accessor
+   \return The number of bytes of zones spilled to disk
+   */
+  unsigned long spilled_bytes() const;
+
   /*!
   \brief Accessor
   \return Reference to the reachable state flag
@@ -74,13 +86,15 @@ public:
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post every statistics has been added to m
+   \post every statistics has been added to m. The number of spilled bytes is only
+   added when zones have been spilled
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
 private:
   unsigned long _visited_states;      /*!< Number of visited states */
   unsigned long _visited_transitions; /*!< Number of visited transitions */
+  unsigned long _spilled_bytes;       /*!< Number of bytes of zones spilled to disk */
   bool _reachable;                    /*!< Reachability of satisfying state */
 };
 
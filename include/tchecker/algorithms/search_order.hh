@@ -24,9 +24,10 @@ namespace algorithms {
 /*!
  \brief Conversion from search order to waiting policy
  \param search_order : search order
- \pre search_order is either "dfs" or "bfs"
+ \pre search_order is either "dfs", "bfs" or "random"
  \return tchecker::waiting::STACK if search_order is "dfs",
- tchecker::waiting::QUEUE if search_order is "bfs"
+ tchecker::waiting::QUEUE if search_order is "bfs",
+ tchecker::waiting::RANDOM if search_order is "random"
  \throw std::invalid_argument if the precondition is not satisfied
 */
 enum tchecker::waiting::policy_t waiting_policy(std::string const & search_order);
@@ -34,9 +35,10 @@ enum tchecker::waiting::policy_t waiting_policy(std::string const & search_order
 /*!
  \brief Conversion from search order to waiting policy for fast remove waiting containers
  \param search_order : search order
- \pre search_order is either "dfs" or "bfs"
+ \pre search_order is either "dfs", "bfs" or "random"
  \return tchecker::waiting::FAST_REMOVE_STACK if search_order is "dfs",
- tchecker::waiting::FAST_REMOVE_QUEUE if search_order is "bfs"
+ tchecker::waiting::FAST_REMOVE_QUEUE if search_order is "bfs",
+ tchecker::waiting::FAST_REMOVE_RANDOM if search_order is "random"
  \throw std::invalid_argument if the precondition is not satisfied
 */
 enum tchecker::waiting::policy_t fast_remove_waiting_policy(std::string const & search_order);
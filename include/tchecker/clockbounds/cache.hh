@@ -351,6 +351,209 @@ private:
   std::vector<entry_t> _table;                                      /*!< Table of (vloc, LU bounds) */
 };
 
+/*!
+ \class shared_cache_local_lu_map_t
+ \brief Access to local LU bounds of shared tuple of locations with cache indexed
+ by identifiers of tuples of locations
+ \note the cache should only be used with tuples of locations shared by a
+ single allocator (see tchecker::vloc_table_t). Bounds of tuples of locations
+ that have not been shared are computed at each access
+ */
+class shared_cache_local_lu_map_t {
+  /*!< Type of LU clock bounds maps for storing */
+  struct lu_maps_t {
+    tchecker::clockbounds::map_t * L; /*!< L bounds map */
+    tchecker::clockbounds::map_t * U; /*!< U bounds map */
+  };
+
+public:
+  /*!
+   \brief Constructor
+   \param local_lu : local LU clock bounds map
+   \param capacity : initial capacity of the cache
+   \throw std::invalid_argument : if local_lu points to nullptr
+   \note this keeps a shared pointer to local_lu
+   */
+  shared_cache_local_lu_map_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t> local_lu, std::size_t capacity)
+      : _local_lu(local_lu)
+  {
+    if (_local_lu.get() == nullptr)
+      throw std::invalid_argument("shared_cache_local_lu_map_t: invalid nullptr pointer");
+    _table.reserve(capacity);
+    _unshared.L = tchecker::clockbounds::allocate_map(_local_lu->clock_number());
+    _unshared.U = tchecker::clockbounds::allocate_map(_local_lu->clock_number());
+  }
+
+  /*!
+   \brief Copy constructor
+   */
+  shared_cache_local_lu_map_t(tchecker::clockbounds::shared_cache_local_lu_map_t const & m) : _local_lu(m._local_lu)
+  {
+    _unshared.L = tchecker::clockbounds::clone_map(*m._unshared.L);
+    _unshared.U = tchecker::clockbounds::clone_map(*m._unshared.U);
+    _table.reserve(m._table.capacity());
+    for (tchecker::vloc_id_t id = 0; id < m._table.capacity(); ++id) {
+      lu_maps_t const * lu = m._table.find(id);
+      if (lu != nullptr)
+        _table.insert(id, lu_maps_t{.L = tchecker::clockbounds::clone_map(*lu->L),
+                                    .U = tchecker::clockbounds::clone_map(*lu->U)});
+    }
+  }
+
+  /*!
+   \brief Destructor
+   */
+  ~shared_cache_local_lu_map_t()
+  {
+    clear();
+    tchecker::clockbounds::deallocate_map(_unshared.L);
+    tchecker::clockbounds::deallocate_map(_unshared.U);
+  }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::clockbounds::shared_cache_local_lu_map_t &
+  operator=(tchecker::clockbounds::shared_cache_local_lu_map_t const &) = delete;
+
+  /*!
+   \brief Clear the cache
+   */
+  void clear()
+  {
+    for (tchecker::vloc_id_t id = 0; id < _table.capacity(); ++id) {
+      lu_maps_t * lu = _table.find(id);
+      if (lu == nullptr)
+        continue;
+      tchecker::clockbounds::deallocate_map(lu->L);
+      tchecker::clockbounds::deallocate_map(lu->U);
+    }
+    _table.clear();
+  }
+
+  /*!
+   \brief Type of reference to LU clock bounds maps
+   */
+  struct lu_maps_reference_t {
+    tchecker::clockbounds::map_t const & L; /*!< L bounds */
+    tchecker::clockbounds::map_t const & U; /*!< U bounds */
+  };
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return LU clock bounds maps for vloc
+   \note the returned maps are references to the cache that will be invalidated if the
+   cache is cleared, or by the next access if vloc has not been shared
+   */
+  lu_maps_reference_t bounds(tchecker::vloc_t const & vloc)
+  {
+    lu_maps_t const * lu = _table.find(vloc);
+
+    // vloc LU bounds are already in the cache
+    if (lu != nullptr)
+      return lu_maps_reference_t{.L = *lu->L, .U = *lu->U};
+
+    // vloc has not been shared: no cache
+    if (vloc.id() == tchecker::NO_VLOC_ID) {
+      _local_lu->bounds(vloc, *_unshared.L, *_unshared.U);
+      return lu_maps_reference_t{.L = *_unshared.L, .U = *_unshared.U};
+    }
+
+    // vloc LU bounds are not yet in the cache
+    lu_maps_t lu_maps{.L = tchecker::clockbounds::allocate_map(_local_lu->clock_number()),
+                      .U = tchecker::clockbounds::allocate_map(_local_lu->clock_number())};
+    _local_lu->bounds(vloc, *lu_maps.L, *lu_maps.U);
+    _table.insert(vloc, lu_maps);
+
+    return lu_maps_reference_t{.L = *lu_maps.L, .U = *lu_maps.U};
+  }
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t> _local_lu; /*!< Local LU map */
+  tchecker::vloc_table_t<lu_maps_t> _table;                        /*!< LU maps indexed by tuples of locations identifiers */
+  lu_maps_t _unshared;                                              /*!< LU maps of tuples of locations that are not shared */
+};
+
+/*!
+ \class shared_cache_local_d_map_t
+ \brief Access to local diagonal constraints of shared tuple of locations with
+ cache indexed by identifiers of tuples of locations
+ \note the cache should only be used with tuples of locations shared by a
+ single allocator (see tchecker::vloc_table_t). Diagonal constraints of tuples of
+ locations that have not been shared are computed at each access
+ */
+class shared_cache_local_d_map_t {
+public:
+  /*!
+   \brief Constructor
+   \param local_d : local diagonal constraints map
+   \param capacity : initial capacity of the cache
+   \throw std::invalid_argument : if local_d points to nullptr
+   \note this keeps a shared pointer to local_d
+   */
+  shared_cache_local_d_map_t(std::shared_ptr<tchecker::clockbounds::local_d_map_t> local_d, std::size_t capacity)
+      : _local_d(local_d)
+  {
+    if (_local_d.get() == nullptr)
+      throw std::invalid_argument("shared_cache_local_d_map_t: invalid nullptr pointer");
+    _table.reserve(capacity);
+  }
+
+  /*!
+   \brief Copy constructor
+   */
+  shared_cache_local_d_map_t(tchecker::clockbounds::shared_cache_local_d_map_t const &) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~shared_cache_local_d_map_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::clockbounds::shared_cache_local_d_map_t &
+  operator=(tchecker::clockbounds::shared_cache_local_d_map_t const &) = delete;
+
+  /*!
+   \brief Clear the cache
+   */
+  void clear() { _table.clear(); }
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return diagonal constraints for vloc
+   \note the returned container is a reference to the cache that will be invalidated
+   by the next access
+   */
+  tchecker::clock_constraint_container_t const & diagonals(tchecker::vloc_t const & vloc)
+  {
+    tchecker::clock_constraint_container_t const * D = _table.find(vloc);
+
+    // vloc diagonal constraints are already in the cache
+    if (D != nullptr)
+      return *D;
+
+    // vloc has not been shared: no cache
+    if (vloc.id() == tchecker::NO_VLOC_ID) {
+      _local_d->bounds(vloc, _unshared);
+      return _unshared;
+    }
+
+    // vloc diagonal constraints are not yet in the cache
+    tchecker::clock_constraint_container_t & inserted = _table.insert(vloc, tchecker::clock_constraint_container_t{});
+    _local_d->bounds(vloc, inserted);
+    return inserted;
+  }
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t> _local_d;      /*!< Local diagonal constraints map */
+  tchecker::vloc_table_t<tchecker::clock_constraint_container_t> _table; /*!< Diagonals indexed by tuples of locations identifiers */
+  tchecker::clock_constraint_container_t _unshared; /*!< Diagonals of tuples of locations that are not shared */
+};
+
 } // namespace clockbounds
 
 } // namespace tchecker
@@ -17,6 +17,7 @@
 #include "tchecker/dbm/db.hh"
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/utils/array.hh"
+#include "tchecker/variables/clocks.hh"
 
 /*!
  \file clockbounds.hh
@@ -267,6 +268,122 @@ private:
  */
 std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_lu_map_t const & map);
 
+/*!
+ \class local_d_map_t
+ \brief Map from system locations to diagonal clock constraints
+ \note the diagonal clock constraints of a location are the constraints x - y # c that should be preserved by
+ LU-d simulation in this location (see tchecker::clockbounds::df_solver_t)
+ */
+class local_d_map_t {
+public:
+  /*!
+   \brief Constructor
+   \param loc_nb : number of locations
+   \param clock_nb : number of clocks
+   \note all location ID in [0..loc_nb) are assumed to be valid
+   and all clock ID in [0..clock_nb) are assumed to be valid
+   \post all locations have no diagonal clock constraint
+   */
+  local_d_map_t(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock_nb);
+
+  /*!
+   \brief Copy constructor
+   */
+  local_d_map_t(tchecker::clockbounds::local_d_map_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  local_d_map_t(tchecker::clockbounds::local_d_map_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~local_d_map_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::clockbounds::local_d_map_t & operator=(tchecker::clockbounds::local_d_map_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::clockbounds::local_d_map_t & operator=(tchecker::clockbounds::local_d_map_t &&) = default;
+
+  /*!
+   \brief Clear the map
+   \post This map is empty: locations number and clocks number are 0
+  */
+  void clear();
+
+  /*!
+   \brief Resize the map
+   \param loc_nb : number of locations
+   \param clock_nb : number of clocks
+   \post this map has been cleared and resized to loc_nb locations and clock_nb clocks, all locations have no diagonal
+   clock constraint
+   */
+  void resize(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock_nb);
+
+  /*!
+   \brief Accessor
+   \return Number of locations
+   */
+  tchecker::loc_id_t loc_number() const;
+
+  /*!
+   \brief Accessor
+   \return Number of clocks
+   */
+  tchecker::clock_id_t clock_number() const;
+
+  /*!
+   \brief Accessor
+   \return true if no location has a diagonal clock constraint, false otherwise
+   */
+  bool empty() const;
+
+  /*!
+   \brief Accessor
+   \param id : location ID
+   \return diagonal clock constraints of location id
+   \pre 0 <= id < _loc_nb (checked by assertion)
+   */
+  tchecker::clock_constraint_container_t & D(tchecker::loc_id_t id);
+
+  /*!
+   \brief Accessor
+   \param id : location ID
+   \return diagonal clock constraints of location id
+   \pre 0 <= id < _loc_nb (checked by assertion)
+   */
+  tchecker::clock_constraint_container_t const & D(tchecker::loc_id_t id) const;
+
+  /*!
+  \brief Accessor
+  \param vloc : tuple of location identifiers
+  \param D : diagonal clock constraints
+  \pre all locations identifiers in vloc are in [0.._loc_nb) (checked by assertion)
+  \post D contains the diagonal clock constraints of all the locations in vloc, without duplicates
+  */
+  void bounds(tchecker::vloc_t const & vloc, tchecker::clock_constraint_container_t & D) const;
+
+private:
+  tchecker::loc_id_t _loc_nb;                             /*!< Number of system locations */
+  tchecker::clock_id_t _clock_nb;                         /*!< Number of clocks */
+  std::vector<tchecker::clock_constraint_container_t> _D; /*!< Diagonal clock constraints */
+};
+
+/*!
+ \brief Output operator
+ \param os : output stream
+ \param map : local diagonal map
+ \post map has been output to os
+ \return os after map has been output
+ */
+std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_d_map_t const & map);
+
 /*!
  \class global_lu_map_t
  \brief Map from system to LU clock bound maps
@@ -782,6 +899,18 @@ public:
   */
   std::shared_ptr<tchecker::clockbounds::local_lu_map_t> local_lu_map();
 
+  /*!
+  \brief Accessor
+  \return local diagonal map (const)
+  */
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t const> local_d_map() const;
+
+  /*!
+  \brief Accessor
+  \return local diagonal map (non const)
+  */
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t> local_d_map();
+
   /*!
   \brief Accessor
   \return local M map (const)
@@ -925,6 +1054,7 @@ private:
   std::shared_ptr<tchecker::clockbounds::global_m_map_t> _global_m;   /*!< Global M map */
   std::shared_ptr<tchecker::clockbounds::local_lu_map_t> _local_lu;   /*!< Local LU map */
   std::shared_ptr<tchecker::clockbounds::local_m_map_t> _local_m;     /*!< Local M map */
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t> _local_d;     /*!< Local diagonal map */
 };
 
 } // namespace clockbounds
@@ -10,6 +10,10 @@
 
 #include <algorithm>
 #include <functional>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/dbm.hh"
@@ -53,6 +57,16 @@ namespace clockbounds {
  Diophantine inequations is solved by computing the minimal path from L_{x,l} and U_{x,l} to 0 for every clock x
  and every location l, in the graph of the system of inequations.
 
+ Diagonal constraints x - y # c are handled as in "Reachability in timed automata with diagonal constraints", Gastin,
+ Mukherjee and Srivathsan, CONCUR 2018. Every location l is associated a set D_l of diagonal constraints:
+ . x - y # c is in D_{l1}    if x - y # c appears in g, or in the invariant of l1
+ . z - w # c-k+m is in D_{l1} if x - y # c is in D_{l2}, and x := z + k, y := w + m appear in s (z != w clocks)
+ . U_{z,l1} >= c-k+m         if x - y # c is in D_{l2}, and x := z + k, y := m appear in s
+ . L_{w,l1} >= k-m-c         if x - y # c is in D_{l2}, and x := k, y := w + m appear in s
+ and diagonal constraints of locations in other processes are propagated over updates of shared clocks as for L and U
+ bounds. The sets D_l are computed as a least fixpoint before L and U bounds. The fixpoint may not exist when clocks
+ are updated as x := y + k with k != 0 in a cycle, this is detected by bounding the constants in D_l.
+
  This class provides methods to specify the constraints from the transitions of an automaton, and a method to
  solve the system of inequations, and compute the resulting bounds.
 */
@@ -159,6 +173,33 @@ public:
   void add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, tchecker::clock_id_t x, tchecker::clock_id_t y,
                       tchecker::integer_t c);
 
+  /*!
+  \brief Add a constraint for diagonal guard x - y < c or x - y <= c
+  \param l : location ID
+  \param x : clock ID
+  \param y : clock ID
+  \param cmp : comparator
+  \param c : bound
+  \pre 0 <= l < _loc_number (checked by assertion), 0 <= x,y < _clock_number and x != y (checked by assertion)
+  \post The constraint x - y cmp c has been added to D_l
+  */
+  void add_diagonal_guard(tchecker::loc_id_t l, tchecker::clock_id_t x, tchecker::clock_id_t y, tchecker::ineq_cmp_t cmp,
+                          tchecker::integer_t c);
+
+  /*!
+  \brief Add the clock updates of an edge
+  \param l1 : source location ID
+  \param l2 : target location ID
+  \param updates : for each clock x, the possible updates x := y + c as pairs (y, c) where y is a clock ID or
+  tchecker::REFCLOCK_ID
+  \pre 0 <= l1, l2 < _loc_number (checked by assertion)
+  \pre updates has size _clock_number (checked by assertion)
+  \post Diagonal constraints in D_{l2} are propagated to l1 w.r.t. updates when solving. Constant assignments are not
+  constraints on L and U bounds: they still should be added with add_assignment
+  */
+  void add_edge_updates(tchecker::loc_id_t l1, tchecker::loc_id_t l2,
+                        std::vector<std::vector<std::pair<tchecker::clock_id_t, tchecker::integer_t>>> const & updates);
+
   /*!
    \brief Solve amd fill local LU bounds map
    \param map : local LU clock bounds map
@@ -171,6 +212,19 @@ public:
    */
   bool solve(tchecker::clockbounds::local_lu_map_t & map);
 
+  /*!
+   \brief Solve and fill local LU bounds and diagonal maps
+   \param lu_map : local LU clock bounds map
+   \param d_map : local diagonal map
+   \pre the number of clocks and locations in this solver coincide with those in lu_map and d_map
+   \post lu_map and d_map have been filled with the smallest solution to the constraints in this solver, if any
+   \return true if the constraints in this solver have a solution, false otherwise
+   \throw std::invalid_argument : if the number of clocks or the number of locations in this solver
+   differs from those in maps
+   \throw std::runtime_error : if the diagonal constraints have no finite solution
+   */
+  bool solve(tchecker::clockbounds::local_lu_map_t & lu_map, tchecker::clockbounds::local_d_map_t & d_map);
+
 protected:
   /*!
   \brief Accessor
@@ -240,6 +294,41 @@ protected:
    */
   bool ensure_tight();
 
+  /*!
+   \brief Type of diagonal constraint x - y # c as (x, y, c, #)
+   */
+  using diagonal_t = std::tuple<tchecker::clock_id_t, tchecker::clock_id_t, tchecker::integer_t, tchecker::ineq_cmp_t>;
+
+  /*!
+   \brief Type of clock updates of an edge
+   */
+  struct edge_updates_t {
+    tchecker::loc_id_t src;                                                              /*!< Source location */
+    tchecker::loc_id_t tgt;                                                              /*!< Target location */
+    std::vector<std::vector<std::pair<tchecker::clock_id_t, tchecker::integer_t>>> updates; /*!< Updates of each clock */
+  };
+
+  /*!
+   \brief Propagate a diagonal constraint backward over clock updates
+   \param e : clock updates
+   \param d : diagonal constraint in the target location of e
+   \param only_updated : whether d should only be propagated when one of its clocks is updated by e
+   \param limit : bound on the absolute value of constants in diagonal constraints
+   \post the constraints obtained from d and the updates in e have been added to the source location of e: diagonal
+   constraints to D, and bounds to L and U
+   \return true if a diagonal constraint has been added, false otherwise
+   \throw std::runtime_error : if a diagonal constraint has a constant beyond limit
+   */
+  bool propagate_diagonal(edge_updates_t const & e, diagonal_t const & d, bool only_updated, tchecker::integer_t limit);
+
+  /*!
+   \brief Compute diagonal constraints
+   \post the sets D_l are the least fixpoint of the constraints in this solver, and the L and U bounds
+   from diagonal constraints have been added
+   \throw std::runtime_error : if the diagonal constraints have no finite solution
+   */
+  void solve_diagonals();
+
   tchecker::loc_id_t _loc_number;               /*!< Number of locations */
   tchecker::clock_id_t _clock_number;           /*!< Number of clocks */
   std::vector<tchecker::process_id_t> _loc_pid; /*!< Map: location ID -> process ID */
@@ -248,6 +337,9 @@ protected:
   tchecker::dbm::db_t * _U;                     /*!< Inequations on upper bounds U_{x,l} */
   bool _updated_L;                              /*!< Flags whether the L matrix needs tightening */
   bool _updated_U;                              /*!< Flags whether the U matrix needs tightening */
+  std::vector<std::set<diagonal_t>> _D;         /*!< Diagonal constraints D_l */
+  std::vector<edge_updates_t> _edges;           /*!< Clock updates of edges */
+  bool _updated_D;                              /*!< Flags whether the sets D_l need propagation */
 };
 
 /*!
@@ -256,7 +348,7 @@ protected:
  \param loc : location identifier
  \param solver : clock bounds solver
  \post All clock bound constraints from invariant inv in location loc have been added to solver
- \throw std:runtime_error : if inv contains a diagonal clock constraint
+ \throw std:runtime_error : if inv contains a diagonal clock constraint with a non-constant bound
  */
 void add_location_constraints(tchecker::typed_expression_t const & inv, tchecker::loc_id_t loc,
                               std::shared_ptr<tchecker::clockbounds::df_solver_t> const & solver);
@@ -269,8 +361,8 @@ void add_location_constraints(tchecker::typed_expression_t const & inv, tchecker
  \param tgt : target location
  \param solver : clock bounds solver
  \post All clock bound constraints from guard and stmt on edge src -> tgt have been added to solver
- \throw std::runtime_error : if guard contains a diagonal clock constraint, or if clock updates cannot
- be computed from stmt (e.g. non-constant clock reset in a while statement, etc)
+ \throw std::runtime_error : if guard contains a diagonal clock constraint with a non-constant bound, or if clock
+ updates cannot be computed from stmt (e.g. non-constant clock reset in a while statement, etc)
 */
 void add_edge_constraints(tchecker::typed_expression_t const & guard, tchecker::typed_statement_t const & stmt,
                           tchecker::loc_id_t src, tchecker::loc_id_t tgt,
@@ -282,9 +374,9 @@ void add_edge_constraints(tchecker::typed_expression_t const & guard, tchecker::
  \param clockbounds : clock bound maps
  \pre clockbounds maps have the same numbers of clocks and locations as system
  \post if clock bounds can be computed for system, then clockbounds has been filled with the computed clock
- bounds. When system carries diagonal clock constraints, LU/M maps are resized but left unconstrained so that
- diagonal-aware analyses can fall back to DBM-based simulation.
- \throw std::runtime_error : if clock bounds cannot be computed for system (except for the diagonal case above)
+ bounds, including diagonal clock constraints for LU-d simulation. Extrapolations w.r.t. LU/M bounds are not
+ correct on systems with diagonal clock constraints
+ \throw std::runtime_error : if clock bounds cannot be computed for system
  */
 void compute_clockbounds(tchecker::ta::system_t const & system, tchecker::clockbounds::clockbounds_t & clockbounds);
 
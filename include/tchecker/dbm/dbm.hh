@@ -8,9 +8,12 @@
 #ifndef TCHECKER_DBM_DBM_HH
 #define TCHECKER_DBM_DBM_HH
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
 
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/variables/clocks.hh"
@@ -233,6 +236,29 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
 enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x,
                                      tchecker::clock_id_t y);
 
+/*!
+ \brief Tighten a DBM w.r.t. a set of clocks
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param clocks : array of clocks
+ \param count : number of clocks in array clocks
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dim >= 1 (checked by assertion)
+ 0 <= clocks[k] < dim for all 0 <= k < count (checked by assertion)
+ dbm has been obtained from a tight DBM by strengthening difference bounds x-y
+ with both x and y in clocks
+ \post dbm is tight if it is not empty.
+ if dbm is empty, then the difference bound in (0,0) is less-than <=0 (tchecker::dbm::is_empty_0() returns true)
+ \return EMPTY if dbm is empty, NON_EMPTY otherwise
+ \note Applies Floyd-Warshall algorithm restricted to intermediate clocks in
+ clocks: O(count * dim^2) instead of O(dim^3) for tchecker::dbm::tighten. This is
+ sufficient since every shortest path in dbm goes through strengthened bounds
+ only, and paths between them can be replaced by bounds in the tight DBM
+ */
+enum tchecker::dbm::status_t tighten_clocks(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                            tchecker::clock_id_t const * clocks, tchecker::clock_id_t count);
+
 /*!
  \brief Constrain a DBM
  \param dbm : a dbm
@@ -551,6 +577,12 @@ void open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
 */
 void open_down(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
 
+/*!
+ \brief Maximal dimension of DBMs intersected by tightening w.r.t. a subset of clocks
+ (see tchecker::dbm::intersection)
+ */
+tchecker::clock_id_t const INTERSECTION_PIVOTS_MAX_DIM = 256;
+
 /*!
  \brief Intersection
  \param dbm : a dbm
@@ -567,10 +599,29 @@ void open_down(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
  dbm is tight
  \return EMPTY if the intersection of dbm1 and dbm2 is empty, NON_EMPTY otherwise
  \note dbm can be one of dbm1 or dbm2
+ \note only clocks involved in difference bounds that differ between dbm1 and dbm2
+ are used to tighten dbm (see tchecker::dbm::tighten_clocks), up to dimension
+ tchecker::dbm::INTERSECTION_PIVOTS_MAX_DIM. Does not allocate memory
  */
 enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
                                           tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim);
 
+/*!
+ \brief Intersection of DBMs, with number of tightening clocks
+ \param dbm : a DBM
+ \param dbm1 : a DBM
+ \param dbm2 : a DBM
+ \param dim : dimension of dbm1, dbm1 and dbm2
+ \param pivots : number of clocks
+ \pre same as tchecker::dbm::intersection above
+ \post same as tchecker::dbm::intersection above, and pivots is the number of clocks
+ dbm has been tightened w.r.t. (dim if dbm has been fully tightened)
+ \return same as tchecker::dbm::intersection above
+ */
+enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
+                                          tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                                          tchecker::clock_id_t & pivots);
+
 /*!
  \brief ExtraM extrapolation
  \param dbm : a dbm
@@ -655,6 +706,32 @@ void extra_lu(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::int
 void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
                    tchecker::integer_t const * u);
 
+/*!
+ \brief ExtraLU+ extrapolation restricted to a set of clocks
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param l : clock lower bounds for clocks 1 to dim-1 (l[0] is the bound for clock 1 and so on)
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \param exact : clocks that are not extrapolated (exact[0] is the flag for clock 1 and so on)
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent (checked by assertion)
+ dbm is positive (checked by assertion)
+ dbm is tight (checked by assertion)
+ dim >= 1 (checked by assertion)
+ l and u are arrays of size dim-1
+ l[i], u[i] < tchecker::dbm::INF_VALUE for all i>=0 (checked by assertion)
+ exact has size dim-1 (checked by assertion)
+ \post extrapolation ExtraLU+ has been applied to dbm w.r.t. l and u, where the bounds of the clocks in exact are
+ infinite, then dbm has been tightened. Hence the result is included in the abstraction of dbm w.r.t. LU-simulation
+ on the clocks that are not in exact and equality on the clocks in exact, which is sound with diagonal constraints
+ over clocks in exact
+ \note set l[i]/u[i] to -tchecker::dbm::INF_VALUE if clock i has no lower/upper bound
+ \note this is tchecker::dbm::extra_lu_plus if exact is empty, and the identity if exact contains all the clocks
+ */
+void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                   tchecker::integer_t const * u, boost::dynamic_bitset<> const & exact);
+
 /*!
  \brief Checks inclusion w.r.t. abstraction aLU
  \param dbm1 : a first dbm
@@ -677,6 +754,35 @@ void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker
 bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
                tchecker::integer_t const * l, tchecker::integer_t const * u);
 
+/*!
+ \brief Checks inclusion w.r.t. LU-d simulation
+ \param dbm1 : a first dbm
+ \param dbm2 : a second dbm
+ \param dim : dimension of dbm1 and dbm2
+ \param l : clock lower bounds for clocks 1 to dim-1 (l[0] is the bound for clock 1 and so on)
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \param diagonals : diagonal clock constraints
+ \pre dbm1 and dbm2 are not nullptr (checked by assertion)
+ dbm1 and dbm2 are dim*dim arrays of difference bounds
+ dbm1 and dbm2 are consistent (checked by assertion)
+ dbm1 and dbm2 are positive (checked by assertion)
+ dbm1 and dbm2 are tight (checked by assertion)
+ dim >= 1 (checked by assertion)
+ l and u are arrays of size dim-1
+ l[i], u[i] < tchecker::dbm::INF_VALUE for all i>=0 (checked by assertion)
+ diagonals are expressed over system clocks, and none of them involves tchecker::REFCLOCK_ID (checked by assertion)
+ \return true if every valuation in dbm1 is simulated by a valuation in dbm2 w.r.t. the simulation that preserves l,
+ u and the constraints in diagonals, false otherwise (see "Reachability in timed automata with diagonal constraints",
+ Gastin, Mukherjee and Srivathsan. CONCUR, 2018)
+ \note dbm1 and dbm2 are split w.r.t. every diagonal constraint that cuts dbm1 and not dbm2, then inclusion of each
+ part is checked w.r.t. aLU. Each split costs O(dim^2). The number of parts is exponential in the number of diagonal
+ constraints that cut the zones, and linear when they do not cut each other
+ \note set l[i]/u[i] to -tchecker::dbm::INF_VALUE if clock i has no lower/upper bound
+ */
+bool is_alu_d_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                 tchecker::integer_t const * l, tchecker::integer_t const * u,
+                 tchecker::clock_constraint_container_t const & diagonals);
+
 /*!
  \brief Checks inclusion w.r.t. abstraction aM
  \param dbm1 : a first dbm
@@ -698,6 +804,125 @@ bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm
 bool is_am_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
               tchecker::integer_t const * m);
 
+/*!
+ \brief Inclusion of a DBM in a batch of DBMs
+ \param dbm : a dbm
+ \param batch : a batch of count DBMs in structure-of-arrays layout: bound (i,j) of the k-th DBM is
+ batch[(i*dim+j)*stride+k]
+ \param stride : distance between two consecutive bounds of a DBM in batch
+ \param count : number of DBMs in batch
+ \param dim : dimension of dbm and of the DBMs in batch
+ \param le : bit set of (count+63)/64 words
+ \pre dbm and batch are not nullptr (checked by assertion)
+ dbm and the DBMs in batch are tight
+ count <= stride (checked by assertion)
+ dim >= 1 (checked by assertion)
+ \post for every k < count, bit k of le (i.e. bit k%64 of le[k/64]) is set if dbm is included in the k-th DBM in
+ batch, and cleared otherwise
+ \note the DBMs in batch are compared to dbm simultaneously using vectorized kernels (see tchecker/dbm/simd.hh)
+ */
+void is_le_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                 std::size_t count, tchecker::clock_id_t dim, std::uint64_t * le);
+
+/*!
+ \brief Inclusion of a batch of DBMs in a DBM
+ \param dbm : a dbm
+ \param batch : a batch of count DBMs in structure-of-arrays layout (see tchecker::dbm::is_le_batch)
+ \param stride : distance between two consecutive bounds of a DBM in batch
+ \param count : number of DBMs in batch
+ \param dim : dimension of dbm and of the DBMs in batch
+ \param ge : bit set of (count+63)/64 words
+ \pre see tchecker::dbm::is_le_batch
+ \post for every k < count, bit k of ge is set if the k-th DBM in batch is included in dbm, and cleared otherwise
+ */
+void is_ge_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                 std::size_t count, tchecker::clock_id_t dim, std::uint64_t * ge);
+
+/*!
+ \brief Inclusion of a DBM in a batch of DBMs w.r.t. abstraction aLU
+ \param dbm : a dbm
+ \param batch : a batch of count DBMs in structure-of-arrays layout (see tchecker::dbm::is_le_batch)
+ \param stride : distance between two consecutive bounds of a DBM in batch
+ \param count : number of DBMs in batch
+ \param dim : dimension of dbm and of the DBMs in batch
+ \param l : clock lower bounds for clocks 1 to dim-1 (l[0] is the bound for clock 1 and so on)
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \param le : bit set of (count+63)/64 words
+ \pre see tchecker::dbm::is_le_batch and tchecker::dbm::is_alu_le
+ \post for every k < count, bit k of le is set if dbm <= aLU(k-th DBM in batch), and cleared otherwise
+ */
+void is_alu_le_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                     std::size_t count, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                     tchecker::integer_t const * u, std::uint64_t * le);
+
+/*!
+ \brief Inclusion of a batch of DBMs in a DBM w.r.t. abstraction aLU
+ \param dbm : a dbm
+ \param batch : a batch of count DBMs in structure-of-arrays layout (see tchecker::dbm::is_le_batch)
+ \param stride : distance between two consecutive bounds of a DBM in batch
+ \param count : number of DBMs in batch
+ \param dim : dimension of dbm and of the DBMs in batch
+ \param l : clock lower bounds for clocks 1 to dim-1 (l[0] is the bound for clock 1 and so on)
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \param ge : bit set of (count+63)/64 words
+ \pre see tchecker::dbm::is_le_batch and tchecker::dbm::is_alu_le
+ \post for every k < count, bit k of ge is set if k-th DBM in batch <= aLU(dbm), and cleared otherwise
+ */
+void is_alu_ge_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                     std::size_t count, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                     tchecker::integer_t const * u, std::uint64_t * ge);
+
+/*!
+ \brief Number of clocks summarized in a DBM signature (clocks 1 to SIGNATURE_CLOCKS)
+ */
+tchecker::clock_id_t const SIGNATURE_CLOCKS = 4;
+
+/*!
+ \brief Signature of a DBM
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent (checked by assertion)
+ dbm is tight (checked by assertion)
+ dim >= 1 (checked by assertion)
+ \return a word of 8 fields of 8 bits that stores a rank of the upper bound dbm[x,0] and of the lower bound
+ dbm[0,x] of each clock 1 <= x <= SIGNATURE_CLOCKS. Ranks are exact for small constants, and keep the 5 most
+ significant bits of larger constants
+ \note if dbm1 <= dbm2 (see tchecker::dbm::is_le) then signature_le(signature(dbm1), signature(dbm2)). The
+ signature of an empty DBM is 0 by convention
+ */
+std::uint64_t signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
+/*!
+ \brief Signature of a DBM w.r.t. abstraction aLU
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param l : clock lower bounds for clocks 1 to dim-1 (l[0] is the bound for clock 1 and so on)
+ \param u : clock upper bounds for clocks 1 to dim-1 (u[0] is the bound for clock 1 and so on)
+ \pre see tchecker::dbm::signature and tchecker::dbm::is_alu_le
+ \return same as tchecker::dbm::signature, except that upper bounds of clocks x above l[x] are ranked
+ as infinity, and lower bounds of clocks x above u[x] are ranked as the largest lower bound
+ \note if dbm1 <= aLU(dbm2) (see tchecker::dbm::is_alu_le) then signature_le(alu_signature(dbm1, dim, l, u),
+ alu_signature(dbm2, dim, l, u))
+ */
+std::uint64_t alu_signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                            tchecker::integer_t const * u);
+
+/*!
+ \brief Comparison of DBM signatures
+ \param s1 : a signature
+ \param s2 : a signature
+ \return true if every field of s1 is less-than-or-equal-to the corresponding field of s2, false otherwise
+ \note fields have 7 bits of rank. Every field of s2 with its 8th bit set, minus the corresponding field
+ of s1, keeps its 8th bit iff it does not underflow
+ */
+inline bool signature_le(std::uint64_t s1, std::uint64_t s2)
+{
+  std::uint64_t const guards = 0x8080808080808080ULL;
+  return (((s2 | guards) - s1) & guards) == guards;
+}
+
 /*!
  \brief Hash function
  \param dbm : a dbm
@@ -0,0 +1,158 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_DETAILS_SIMD_KERNELS_HH
+#define TCHECKER_DBM_DETAILS_SIMD_KERNELS_HH
+
+#include <cstddef>
+#include <cstdint>
+
+/*!
+ \file simd_kernels.hh
+ \brief Vectorized DBM kernels on packed difference bounds
+ \note This header is included by translation units compiled with instruction
+ set specific flags. Hence it shall not define any inline function, as the linker
+ may pick their definition from any translation unit
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+namespace details {
+
+/*!
+ \brief Type of packed difference bounds
+ \note A difference bound #c is packed as 2*c+# where # is 0 for < and 1 for <=.
+ This is the encoding of unsafe DBMs, and the memory layout of safe DBMs when
+ integers are 32 bits (checked at runtime). Comparing packed difference bounds
+ as signed integers is the same as comparing difference bounds
+ */
+typedef std::int32_t __attribute__((__may_alias__)) packed_db_t;
+
+std::int32_t const PACKED_LT_ZERO = 0;                   /*!< <0 */
+std::int32_t const PACKED_LE_ZERO = 1;                   /*!< <=0 */
+std::int32_t const PACKED_INF_VALUE = INT32_MAX >> 1;    /*!< Infinity value */
+std::int32_t const PACKED_LT_INFINITY = INT32_MAX - 1;   /*!< <inf */
+std::int32_t const PACKED_MAX = PACKED_LT_INFINITY - 1;  /*!< Largest bound that is not <inf */
+
+/*!
+ \brief Check packed encoding
+ \return true if the memory representation of tchecker::dbm::db_t is the packed
+ encoding of difference bounds on 32 bits integers, false otherwise
+ */
+bool has_packed_encoding();
+
+/*!
+ \brief Vectorized DBM kernels for an instruction set
+ \note Each kernel has the same semantics as the corresponding function in
+ tchecker/dbm/dbm.hh on packed DBMs. Kernels that return an int return -1 when
+ the operation cannot be completed (a sum of difference bounds cannot be
+ represented), in which case the caller shall fall back to the scalar
+ implementation. The DBM may have been partially tightened in this case
+ */
+struct kernels_t {
+  unsigned int lanes;   /*!< Number of 32 bits lanes */
+  std::uint32_t min_dim; /*!< Smallest dimension for which kernels are faster than scalar code */
+
+  /*!
+   \brief Tighten (see tchecker::dbm::tighten)
+   \return 0 if dbm is empty, 1 if dbm is not empty, -1 on failure
+   */
+  int (*tighten)(packed_db_t * dbm, std::uint32_t dim);
+
+  /*!
+   \brief Inclusion (see tchecker::dbm::is_le)
+   */
+  bool (*is_le)(packed_db_t const * dbm1, packed_db_t const * dbm2, std::uint32_t dim);
+
+  /*!
+   \brief Equality (see tchecker::dbm::is_equal)
+   */
+  bool (*is_equal)(packed_db_t const * dbm1, packed_db_t const * dbm2, std::uint32_t dim);
+
+  /*!
+   \brief ExtraLU extrapolation, without tightening (see tchecker::dbm::extra_lu)
+   \return 1 if dbm has been modified (hence needs tightening), 0 if dbm is unchanged,
+   -1 on failure (dbm is unchanged)
+   */
+  int (*extra_lu)(packed_db_t * dbm, std::uint32_t dim, std::int32_t const * l, std::int32_t const * u);
+
+  /*!
+   \brief aLU inclusion (see tchecker::dbm::is_alu_le)
+   \return 1 if dbm1 is included in aLU(dbm2), 0 if not, -1 on failure
+   */
+  int (*is_alu_le)(packed_db_t const * dbm1, packed_db_t const * dbm2, std::uint32_t dim, std::int32_t const * l,
+                   std::int32_t const * u);
+
+  /*!
+   \brief Inclusion of a DBM in a batch of DBMs (see tchecker::dbm::is_le_batch)
+   */
+  void (*is_le_batch)(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                      std::uint32_t dim, std::uint64_t * le);
+
+  /*!
+   \brief Inclusion of a batch of DBMs in a DBM (see tchecker::dbm::is_ge_batch)
+   */
+  void (*is_ge_batch)(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                      std::uint32_t dim, std::uint64_t * ge);
+
+  /*!
+   \brief aLU inclusion of a DBM in a batch of DBMs (see tchecker::dbm::is_alu_le_batch)
+   \return 1 on success, -1 on failure
+   */
+  int (*is_alu_le_batch)(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                         std::uint32_t dim, std::int32_t const * l, std::int32_t const * u, std::uint64_t * le);
+
+  /*!
+   \brief aLU inclusion of a batch of DBMs in a DBM (see tchecker::dbm::is_alu_ge_batch)
+   \return 1 on success, -1 on failure
+   */
+  int (*is_alu_ge_batch)(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                         std::uint32_t dim, std::int32_t const * l, std::int32_t const * u, std::uint64_t * ge);
+};
+
+/*!
+ \brief Accessor
+ \return SSE4.2 kernels, nullptr if they have not been compiled
+ */
+tchecker::dbm::simd::details::kernels_t const * sse42_kernels();
+
+/*!
+ \brief Accessor
+ \return AVX2 kernels, nullptr if they have not been compiled
+ */
+tchecker::dbm::simd::details::kernels_t const * avx2_kernels();
+
+/*!
+ \brief Accessor
+ \param dim : dimension of DBMs
+ \return kernels for the selected instruction set (or a narrower one) that should be
+ used for DBMs of dimension dim, nullptr if the scalar implementation should be used
+ */
+tchecker::dbm::simd::details::kernels_t const * kernels(std::uint32_t dim);
+
+/*!
+ \brief Accessor
+ \return kernels for the selected instruction set that should be used for batches of
+ DBMs (of any dimension), nullptr if the scalar implementation should be used
+ \note batch kernels vectorize over the DBMs in a batch rather than over the bounds
+ in a DBM, hence they do not depend on the dimension
+ */
+tchecker::dbm::simd::details::kernels_t const * batch_kernels();
+
+} // end of namespace details
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_DETAILS_SIMD_KERNELS_HH
@@ -0,0 +1,530 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_FIXED_DIM_HH
+#define TCHECKER_DBM_FIXED_DIM_HH
+
+#include <cassert>
+#include <cstdint>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/details/simd_kernels.hh"
+#include "tchecker/variables/clocks.hh"
+
+/*!
+ \file fixed_dim.hh
+ \brief Operations on DBMs of dimension known at compile time
+ \note Each function has the same semantics as the corresponding function in tchecker/dbm/dbm.hh on DBMs of
+ dimension D, and yields the same DBM. The dimension being a constant, loops are unrolled and indices are computed
+ at compile time. Difference bounds are handled in their packed encoding (see tchecker/dbm/details/simd_kernels.hh),
+ hence as plain integers. When a sum of difference bounds cannot be represented, the functions fall back to the
+ generic functions in tchecker/dbm/dbm.hh, which report the error
+ \note These functions are instantiated for D in 1..tchecker::dbm::fixed_dim::MAX_DIM by tchecker::dbm::kernels
+ (see tchecker/dbm/kernels.hh)
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace fixed_dim {
+
+/*!
+ \brief Largest dimension of DBMs with specialized operations
+ */
+constexpr tchecker::clock_id_t const MAX_DIM = 16;
+
+namespace details {
+
+using packed_db_t = tchecker::dbm::simd::details::packed_db_t;
+
+/*!
+ \brief Accessor
+ \param dbm : a DBM
+ \return packed representation of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+inline packed_db_t * packed(tchecker::dbm::db_t * dbm) { return reinterpret_cast<packed_db_t *>(dbm); }
+
+/*!
+ \brief Accessor
+ \param dbm : a DBM
+ \return packed representation of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+inline packed_db_t const * packed(tchecker::dbm::db_t const * dbm) { return reinterpret_cast<packed_db_t const *>(dbm); }
+
+/*!
+ \brief Sum of packed difference bounds
+ \param db1 : a packed difference bound
+ \param db2 : a packed difference bound
+ \return PACKED_LT_INFINITY if db1 or db2 is PACKED_LT_INFINITY, db1 + db2 on 64 bits otherwise
+ \note the sum of finite bounds is never PACKED_LT_INFINITY, hence it is representable as a packed difference
+ bound if and only if tchecker::dbm::fixed_dim::details::representable holds
+ */
+inline std::int64_t sum(std::int32_t db1, std::int32_t db2)
+{
+  if (db1 == tchecker::dbm::simd::details::PACKED_LT_INFINITY || db2 == tchecker::dbm::simd::details::PACKED_LT_INFINITY)
+    return tchecker::dbm::simd::details::PACKED_LT_INFINITY;
+  // (2*c1+cmp1) + (2*c2+cmp2) - (cmp1|cmp2) = 2*(c1+c2) + (cmp1&cmp2)
+  std::int64_t const s = static_cast<std::int64_t>(db1) + static_cast<std::int64_t>(db2) - ((db1 | db2) & 1);
+  return (s == tchecker::dbm::simd::details::PACKED_LT_INFINITY ? s + 1 : s);
+}
+
+/*!
+ \brief Check representability of a sum of packed difference bounds
+ \param sum : a sum of packed difference bounds (see tchecker::dbm::fixed_dim::details::sum)
+ \return true if sum can be represented as a packed difference bound, false otherwise
+ */
+inline bool representable(std::int64_t sum)
+{
+  return ((sum >= INT32_MIN) && (sum <= tchecker::dbm::simd::details::PACKED_MAX)) ||
+         (sum == tchecker::dbm::simd::details::PACKED_LT_INFINITY);
+}
+
+/*!
+ \brief Tighten a line of a DBM w.r.t. a clock
+ \param line_i : line i of a DBM
+ \param line_k : line k of the same DBM
+ \param db_ik : bound i->k in the DBM
+ \return true if line_i has been tightened w.r.t. line_k, false if some sum cannot be represented (then line_i is
+ unchanged)
+ */
+template <tchecker::clock_id_t D>
+inline bool tighten_line(packed_db_t * line_i, packed_db_t const * line_k, std::int32_t db_ik)
+{
+  std::int32_t tightened[D];
+  bool ok = true;
+  for (tchecker::clock_id_t j = 0; j < D; ++j) {
+    std::int64_t const s = tchecker::dbm::fixed_dim::details::sum(db_ik, line_k[j]);
+    ok &= tchecker::dbm::fixed_dim::details::representable(s);
+    tightened[j] = (s < line_i[j] ? static_cast<std::int32_t>(s) : line_i[j]);
+  }
+  if (!ok)
+    return false;
+  for (tchecker::clock_id_t j = 0; j < D; ++j)
+    line_i[j] = tightened[j];
+  return true;
+}
+
+} // end of namespace details
+
+/*!
+ \brief Tighten a DBM (see tchecker::dbm::tighten)
+ \tparam D : dimension of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+template <tchecker::clock_id_t D> enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm)
+{
+  static_assert(D >= 1, "DBMs have dimension at least 1");
+  assert(dbm != nullptr);
+  tchecker::dbm::fixed_dim::details::packed_db_t * p = tchecker::dbm::fixed_dim::details::packed(dbm);
+
+  for (tchecker::clock_id_t k = 0; k < D; ++k) {
+    for (tchecker::clock_id_t i = 0; i < D; ++i) {
+      std::int32_t const db_ik = p[i * D + k];
+      if ((i == k) || (db_ik == tchecker::dbm::simd::details::PACKED_LT_INFINITY)) // optimization
+        continue;
+      if (!tchecker::dbm::fixed_dim::details::tighten_line<D>(p + i * D, p + k * D, db_ik))
+        return tchecker::dbm::tighten(dbm, D); // dbm has only been partially tightened
+      if (p[i * D + i] < tchecker::dbm::simd::details::PACKED_LE_ZERO) {
+        p[0] = tchecker::dbm::simd::details::PACKED_LT_ZERO;
+        return tchecker::dbm::EMPTY;
+      }
+    }
+  }
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Constrain a DBM (see tchecker::dbm::constrain(dbm, dim, x, y, cmp, value))
+ \tparam D : dimension of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+template <tchecker::clock_id_t D>
+enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t x, tchecker::clock_id_t y,
+                                       tchecker::ineq_cmp_t cmp, tchecker::integer_t value)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+  assert(x < D);
+  assert(y < D);
+  static_assert(tchecker::LT == 0 && tchecker::LE == 1, "comparators should be the last bit of packed bounds");
+
+  if (value < tchecker::dbm::MIN_VALUE || value > tchecker::dbm::MAX_VALUE)
+    return tchecker::dbm::constrain(dbm, D, x, y, cmp, value); // reports the error
+
+  tchecker::dbm::fixed_dim::details::packed_db_t * p = tchecker::dbm::fixed_dim::details::packed(dbm);
+  std::int32_t const db = static_cast<std::int32_t>(2 * static_cast<std::int64_t>(value) + cmp);
+  if (db >= p[x * D + y])
+    return tchecker::dbm::NON_EMPTY;
+
+  p[x * D + y] = db;
+
+  // Tighten w.r.t. x->y (see tchecker::dbm::tighten(dbm, dim, x, y)): i->y w.r.t. i->x->y, then i->j w.r.t. i->y->j
+  for (tchecker::clock_id_t i = 0; i < D; ++i) {
+    if (i != x) {
+      std::int64_t const db_ixy = tchecker::dbm::fixed_dim::details::sum(p[i * D + x], db);
+      if (!tchecker::dbm::fixed_dim::details::representable(db_ixy))
+        return tchecker::dbm::tighten(dbm, D); // dbm has only been partially tightened
+      if (db_ixy < p[i * D + y])
+        p[i * D + y] = static_cast<std::int32_t>(db_ixy);
+    }
+
+    std::int32_t const db_iy = p[i * D + y];
+    if (db_iy != tchecker::dbm::simd::details::PACKED_LT_INFINITY &&
+        !tchecker::dbm::fixed_dim::details::tighten_line<D>(p + i * D, p + y * D, db_iy))
+      return tchecker::dbm::tighten(dbm, D); // dbm has only been partially tightened
+
+    if (p[i * D + i] < tchecker::dbm::simd::details::PACKED_LE_ZERO) {
+      p[0] = tchecker::dbm::simd::details::PACKED_LT_ZERO;
+      return tchecker::dbm::EMPTY;
+    }
+  }
+
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+  return tchecker::dbm::NON_EMPTY; // since dbm was tight before
+}
+
+/*!
+ \brief Constrain a DBM (see tchecker::dbm::constrain(dbm, dim, constraints))
+ \tparam D : dimension of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+template <tchecker::clock_id_t D>
+enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_constraint_container_t const & constraints)
+{
+  for (tchecker::clock_constraint_t const & c : constraints) {
+    tchecker::clock_id_t id1 = (c.id1() == tchecker::REFCLOCK_ID ? 0 : c.id1() + 1);
+    tchecker::clock_id_t id2 = (c.id2() == tchecker::REFCLOCK_ID ? 0 : c.id2() + 1);
+    if (tchecker::dbm::fixed_dim::constrain<D>(dbm, id1, id2, c.comparator(), c.value()) == tchecker::dbm::EMPTY)
+      return tchecker::dbm::EMPTY;
+  }
+  return tchecker::dbm::NON_EMPTY;
+}
+
+/*!
+ \brief Equality check (see tchecker::dbm::is_equal)
+ \tparam D : dimension of dbm1 and dbm2
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+template <tchecker::clock_id_t D> bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_tight(dbm1, D));
+  assert(tchecker::dbm::is_tight(dbm2, D));
+  tchecker::dbm::fixed_dim::details::packed_db_t const * p1 = tchecker::dbm::fixed_dim::details::packed(dbm1);
+  tchecker::dbm::fixed_dim::details::packed_db_t const * p2 = tchecker::dbm::fixed_dim::details::packed(dbm2);
+
+  for (tchecker::clock_id_t i = 0; i < D; ++i) {
+    bool equal = true;
+    for (tchecker::clock_id_t j = 0; j < D; ++j)
+      equal &= (p1[i * D + j] == p2[i * D + j]);
+    if (!equal)
+      return false;
+  }
+  return true;
+}
+
+/*!
+ \brief Inclusion check (see tchecker::dbm::is_le)
+ \tparam D : dimension of dbm1 and dbm2
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+template <tchecker::clock_id_t D> bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_tight(dbm1, D));
+  assert(tchecker::dbm::is_tight(dbm2, D));
+  tchecker::dbm::fixed_dim::details::packed_db_t const * p1 = tchecker::dbm::fixed_dim::details::packed(dbm1);
+  tchecker::dbm::fixed_dim::details::packed_db_t const * p2 = tchecker::dbm::fixed_dim::details::packed(dbm2);
+
+  for (tchecker::clock_id_t i = 0; i < D; ++i) {
+    bool le = true;
+    for (tchecker::clock_id_t j = 0; j < D; ++j)
+      le &= (p1[i * D + j] <= p2[i * D + j]);
+    if (!le)
+      return false;
+  }
+  return true;
+}
+
+/*!
+ \brief Check inclusion w.r.t. abstraction aLU (see tchecker::dbm::is_alu_le)
+ \tparam D : dimension of dbm1 and dbm2
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ */
+template <tchecker::clock_id_t D>
+bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::integer_t const * l,
+               tchecker::integer_t const * u)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm1, D));
+  assert(tchecker::dbm::is_consistent(dbm2, D));
+  assert(tchecker::dbm::is_positive(dbm1, D));
+  assert(tchecker::dbm::is_positive(dbm2, D));
+  assert(tchecker::dbm::is_tight(dbm1, D));
+  assert(tchecker::dbm::is_tight(dbm2, D));
+  tchecker::dbm::fixed_dim::details::packed_db_t const * p1 = tchecker::dbm::fixed_dim::details::packed(dbm1);
+  tchecker::dbm::fixed_dim::details::packed_db_t const * p2 = tchecker::dbm::fixed_dim::details::packed(dbm2);
+
+  // dbm1 not included in aLU(dbm2) if there is x and y s.t.
+  //     dbm1[0x] >= (<= -U(x))
+  // &&  dbm2[yx] < dbm1[yx]
+  // &&  dbm2[yx] + (< -L(y)) < dbm1[0x]
+  for (tchecker::clock_id_t x = 0; x < D; ++x) {
+    tchecker::integer_t const Ux = (x == 0 ? 0 : u[x - 1]);
+    assert(Ux < tchecker::dbm::INF_VALUE);
+    if (Ux == -tchecker::dbm::INF_VALUE)
+      continue;
+    if (p1[x] < -2 * static_cast<std::int64_t>(Ux) + tchecker::LE)
+      continue;
+
+    for (tchecker::clock_id_t y = 0; y < D; ++y) {
+      tchecker::integer_t const Ly = (y == 0 ? 0 : l[y - 1]);
+      assert(Ly < tchecker::dbm::INF_VALUE);
+      if (x == y || Ly == -tchecker::dbm::INF_VALUE)
+        continue;
+      if (p2[y * D + x] >= p1[y * D + x])
+        continue;
+      std::int64_t const s =
+          tchecker::dbm::fixed_dim::details::sum(p2[y * D + x], static_cast<std::int32_t>(-2 * static_cast<std::int64_t>(Ly)));
+      if (!tchecker::dbm::fixed_dim::details::representable(s))
+        return tchecker::dbm::is_alu_le(dbm1, dbm2, D, l, u); // reports the error
+      if (s < p1[x])
+        return false;
+    }
+  }
+
+  return true;
+}
+
+/*!
+ \brief Reset clocks (see tchecker::dbm::reset(dbm, dim, resets))
+ \tparam D : dimension of dbm
+ */
+template <tchecker::clock_id_t D>
+void reset(tchecker::dbm::db_t * dbm, tchecker::clock_reset_container_t const & resets)
+{
+  assert(dbm != nullptr);
+  for (tchecker::clock_reset_t const & r : resets) {
+    tchecker::clock_id_t const x = (r.left_id() == tchecker::REFCLOCK_ID ? 0 : r.left_id() + 1);
+    tchecker::clock_id_t const y = (r.right_id() == tchecker::REFCLOCK_ID ? 0 : r.right_id() + 1);
+    tchecker::integer_t const value = r.value();
+    assert(x < D);
+    assert(y < D);
+    assert(0 <= value);
+
+    if (y == 0) { // see tchecker::dbm::reset_to_value
+      dbm[x * D] = tchecker::dbm::db(tchecker::LE, value);
+      dbm[x] = tchecker::dbm::db(tchecker::LE, -value);
+      for (tchecker::clock_id_t z = 1; z < D; ++z) {
+        dbm[x * D + z] = tchecker::dbm::sum(dbm[x * D], dbm[z]);
+        dbm[z * D + x] = tchecker::dbm::sum(dbm[z * D], dbm[x]);
+      }
+    }
+    else if (value == 0) { // see tchecker::dbm::reset_to_clock
+      for (tchecker::clock_id_t z = 0; z < D; ++z) {
+        dbm[x * D + z] = dbm[y * D + z];
+        dbm[z * D + x] = dbm[z * D + y];
+      }
+      dbm[x * D + x] = tchecker::dbm::LE_ZERO;
+    }
+    else { // see tchecker::dbm::reset_to_sum
+      for (tchecker::clock_id_t z = 0; z < D; ++z) {
+        dbm[x * D + z] = tchecker::dbm::add(dbm[y * D + z], value);
+        dbm[z * D + x] = tchecker::dbm::add(dbm[z * D + y], -value);
+      }
+      dbm[x * D + x] = tchecker::dbm::LE_ZERO;
+    }
+  }
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+}
+
+/*!
+ \brief Free clocks (see tchecker::dbm::free_clock(dbm, dim, resets))
+ \tparam D : dimension of dbm
+ */
+template <tchecker::clock_id_t D>
+void free_clock(tchecker::dbm::db_t * dbm, tchecker::clock_reset_container_t const & resets)
+{
+  assert(dbm != nullptr);
+  for (tchecker::clock_reset_t const & r : resets) {
+    assert(r.left_id() != tchecker::REFCLOCK_ID);
+    tchecker::clock_id_t const x = r.left_id() + 1;
+    assert(x < D);
+    for (tchecker::clock_id_t y = 0; y < D; ++y) {
+      dbm[x * D + y] = tchecker::dbm::LT_INFINITY;
+      dbm[y * D + x] = dbm[y * D];
+    }
+    dbm[x * D + x] = tchecker::dbm::LE_ZERO;
+  }
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+}
+
+/*!
+ \brief Open up (see tchecker::dbm::open_up)
+ \tparam D : dimension of dbm
+ */
+template <tchecker::clock_id_t D> void open_up(tchecker::dbm::db_t * dbm)
+{
+  assert(dbm != nullptr);
+  for (tchecker::clock_id_t i = 1; i < D; ++i)
+    dbm[i * D] = tchecker::dbm::LT_INFINITY;
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+}
+
+/*!
+ \brief Open down (see tchecker::dbm::open_down)
+ \tparam D : dimension of dbm
+ */
+template <tchecker::clock_id_t D> void open_down(tchecker::dbm::db_t * dbm)
+{
+  assert(dbm != nullptr);
+  for (tchecker::clock_id_t i = 1; i < D; ++i) {
+    tchecker::dbm::db_t min = tchecker::dbm::LT_INFINITY;
+    for (tchecker::clock_id_t j = 1; j < D; ++j)
+      min = tchecker::dbm::min(min, dbm[j * D + i]);
+    dbm[i] = min;
+  }
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+}
+
+/*!
+ \brief ExtraLU extrapolation (see tchecker::dbm::extra_lu)
+ \tparam D : dimension of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ \note this is ExtraM extrapolation when l and u are the same map (see tchecker::dbm::extra_m)
+ */
+template <tchecker::clock_id_t D>
+void extra_lu(tchecker::dbm::db_t * dbm, tchecker::integer_t const * l, tchecker::integer_t const * u)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_positive(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+  tchecker::dbm::fixed_dim::details::packed_db_t * p = tchecker::dbm::fixed_dim::details::packed(dbm);
+
+  // Bound <-U(j) (<=0 or <inf if U(j) is -inf, see tchecker::dbm::extra_lu)
+  auto lt_minus = [](tchecker::integer_t Uj, std::int32_t if_inf) {
+    return (Uj == -tchecker::dbm::INF_VALUE ? if_inf : static_cast<std::int32_t>(-2 * static_cast<std::int64_t>(Uj)));
+  };
+
+  bool modified = false;
+
+  // i=0 (first row): <-U(j) if -c0j > U(j)
+  for (tchecker::clock_id_t j = 1; j < D; ++j) {
+    tchecker::integer_t const Uj = u[j - 1];
+    assert(Uj < tchecker::dbm::INF_VALUE);
+    if (p[j] != tchecker::dbm::simd::details::PACKED_LE_ZERO && -(p[j] >> 1) > Uj) {
+      p[j] = lt_minus(Uj, tchecker::dbm::simd::details::PACKED_LE_ZERO);
+      modified = true;
+    }
+  }
+
+  // i>0: <inf if cij > L(i), <-U(j) if -cij > U(j)
+  for (tchecker::clock_id_t i = 1; i < D; ++i) {
+    tchecker::integer_t const Li = l[i - 1];
+    assert(Li < tchecker::dbm::INF_VALUE);
+    for (tchecker::clock_id_t j = 0; j < D; ++j) {
+      tchecker::integer_t const Uj = (j == 0 ? 0 : u[j - 1]);
+      std::int32_t const db_ij = p[i * D + j];
+      if (i == j || db_ij == tchecker::dbm::simd::details::PACKED_LT_INFINITY)
+        continue;
+      if ((db_ij >> 1) > Li) {
+        p[i * D + j] = tchecker::dbm::simd::details::PACKED_LT_INFINITY;
+        modified = true;
+      }
+      else if (-(db_ij >> 1) > Uj) {
+        p[i * D + j] = lt_minus(Uj, tchecker::dbm::simd::details::PACKED_LT_INFINITY);
+        modified = true;
+      }
+    }
+  }
+
+  if (modified)
+    tchecker::dbm::fixed_dim::tighten<D>(dbm);
+
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_positive(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+}
+
+/*!
+ \brief ExtraLU+ extrapolation (see tchecker::dbm::extra_lu_plus)
+ \tparam D : dimension of dbm
+ \pre tchecker::dbm::simd::details::has_packed_encoding()
+ \note this is ExtraM+ extrapolation when l and u are the same map (see tchecker::dbm::extra_m_plus)
+ */
+template <tchecker::clock_id_t D>
+void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::integer_t const * l, tchecker::integer_t const * u)
+{
+  assert(dbm != nullptr);
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_positive(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+  tchecker::dbm::fixed_dim::details::packed_db_t * p = tchecker::dbm::fixed_dim::details::packed(dbm);
+
+  bool modified = false;
+
+  // i>0: <inf if cij > L(i), -c0i > L(i) or -c0j > U(j). The first line is modified last to keep c0i and c0j intact
+  for (tchecker::clock_id_t i = 1; i < D; ++i) {
+    tchecker::integer_t const Li = l[i - 1];
+    assert(Li < tchecker::dbm::INF_VALUE);
+    bool const line_unbounded = (-(p[i] >> 1) > Li);
+
+    for (tchecker::clock_id_t j = 0; j < D; ++j) {
+      tchecker::integer_t const Uj = (j == 0 ? 0 : u[j - 1]);
+      assert(Uj < tchecker::dbm::INF_VALUE);
+      std::int32_t const db_ij = p[i * D + j];
+      if (i == j || db_ij == tchecker::dbm::simd::details::PACKED_LT_INFINITY)
+        continue;
+      if (line_unbounded || (db_ij >> 1) > Li || -(p[j] >> 1) > Uj) {
+        p[i * D + j] = tchecker::dbm::simd::details::PACKED_LT_INFINITY;
+        modified = true;
+      }
+    }
+  }
+
+  // i=0: <-U(j) if -c0j > U(j)
+  for (tchecker::clock_id_t j = 1; j < D; ++j) {
+    tchecker::integer_t const Uj = u[j - 1];
+    if (-(p[j] >> 1) > Uj) {
+      p[j] = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::simd::details::PACKED_LE_ZERO
+                                               : static_cast<std::int32_t>(-2 * static_cast<std::int64_t>(Uj)));
+      modified = true;
+    }
+  }
+
+  if (modified)
+    tchecker::dbm::fixed_dim::tighten<D>(dbm);
+
+  assert(tchecker::dbm::is_consistent(dbm, D));
+  assert(tchecker::dbm::is_positive(dbm, D));
+  assert(tchecker::dbm::is_tight(dbm, D));
+}
+
+} // end of namespace fixed_dim
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_FIXED_DIM_HH
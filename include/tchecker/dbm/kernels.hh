@@ -0,0 +1,102 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_KERNELS_HH
+#define TCHECKER_DBM_KERNELS_HH
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/variables/clocks.hh"
+
+/*!
+ \file kernels.hh
+ \brief Tables of DBM operations selected from the dimension of DBMs
+ \note A zone graph selects a table once, from the dimension of its zones (see tchecker::zg::zg_t), and
+ then calls DBM operations through it: operations on DBMs of small dimension are specialized for that
+ dimension (see tchecker/dbm/fixed_dim.hh), and the other ones are the generic operations in
+ tchecker/dbm/dbm.hh
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+/*!
+ \brief Table of DBM operations
+ \note Each operation has the same semantics as the function with the same name in tchecker/dbm/dbm.hh.
+ The dimension parameter of the operations is only used by the generic table
+ */
+struct kernels_t {
+  tchecker::clock_id_t dim; /*!< Dimension of DBMs (0 for the generic table that applies to all dimensions) */
+
+  enum tchecker::dbm::status_t (*tighten)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim); /*!< Tighten */
+
+  /*!
+   \brief Constrain (see tchecker::dbm::constrain(dbm, dim, constraints))
+   */
+  enum tchecker::dbm::status_t (*constrain)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                            tchecker::clock_constraint_container_t const & constraints);
+
+  bool (*is_equal)(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                   tchecker::clock_id_t dim); /*!< Equality */
+
+  bool (*is_le)(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                tchecker::clock_id_t dim); /*!< Inclusion */
+
+  bool (*is_alu_le)(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                    tchecker::integer_t const * l, tchecker::integer_t const * u); /*!< aLU inclusion */
+
+  /*!
+   \brief Reset (see tchecker::dbm::reset(dbm, dim, resets))
+   */
+  void (*reset)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_reset_container_t const & resets);
+
+  /*!
+   \brief Free clocks (see tchecker::dbm::free_clock(dbm, dim, resets))
+   */
+  void (*free_clock)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                     tchecker::clock_reset_container_t const & resets);
+
+  void (*open_up)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);   /*!< Open up */
+  void (*open_down)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim); /*!< Open down */
+
+  void (*extra_lu)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                   tchecker::integer_t const * u); /*!< ExtraLU extrapolation */
+
+  void (*extra_lu_plus)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                        tchecker::integer_t const * u); /*!< ExtraLU+ extrapolation */
+
+  void (*extra_m)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                  tchecker::integer_t const * m); /*!< ExtraM extrapolation */
+
+  void (*extra_m_plus)(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                       tchecker::integer_t const * m); /*!< ExtraM+ extrapolation */
+};
+
+/*!
+ \brief Accessor
+ \return table of the generic DBM operations in tchecker/dbm/dbm.hh
+ */
+tchecker::dbm::kernels_t const & generic_kernels();
+
+/*!
+ \brief Accessor
+ \param dim : dimension of DBMs
+ \return table of DBM operations specialized for dimension dim if 1 <= dim <= tchecker::dbm::fixed_dim::MAX_DIM
+ and difference bounds have the packed encoding (see tchecker/dbm/details/simd_kernels.hh), generic table otherwise
+ \note the operations in the returned table shall only be applied to DBMs of dimension dim (checked by assertion)
+ \note operations that have vectorized kernels (see tchecker/dbm/simd.hh) are left generic when vectorized kernels
+ are selected for DBMs of dimension dim at the time of the call
+ */
+tchecker::dbm::kernels_t const & kernels(tchecker::clock_id_t dim);
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_KERNELS_HH
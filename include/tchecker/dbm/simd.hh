@@ -0,0 +1,94 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_SIMD_HH
+#define TCHECKER_DBM_SIMD_HH
+
+#include <string>
+
+/*!
+ \file simd.hh
+ \brief Selection of vectorized DBM kernels
+ \note Operations tchecker::dbm::tighten, tchecker::dbm::is_le, tchecker::dbm::is_equal,
+ tchecker::dbm::extra_lu, tchecker::dbm::extra_m and tchecker::dbm::is_alu_le (and
+ operations that call them) use vectorized kernels when the CPU supports them. The
+ kernels work on the packed encoding of difference bounds (see db_unsafe.hh), which
+ is checked at startup. They are only available when tchecker::integer_t is a 32 bits
+ integer. The best instruction set supported by the CPU is selected by default.
+ Vectorized kernels fall back to the scalar implementation when a sum of difference
+ bounds cannot be represented, so that errors are reported as in the scalar
+ implementation
+ */
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+/*!
+ \brief Instruction sets
+ */
+enum isa_t {
+  ISA_SCALAR = 0, /*!< No vectorization */
+  ISA_SSE42,      /*!< SSE4.2 (4 lanes of 32 bits) */
+  ISA_AVX2,       /*!< AVX2 (8 lanes of 32 bits) */
+};
+
+/*!
+ \brief Accessor
+ \param isa : an instruction set
+ \return true if kernels for isa have been compiled and are supported by the CPU,
+ false otherwise
+ \note always true for tchecker::dbm::simd::ISA_SCALAR
+ */
+bool is_supported(enum tchecker::dbm::simd::isa_t isa);
+
+/*!
+ \brief Accessor
+ \return the best instruction set supported by the CPU
+ */
+enum tchecker::dbm::simd::isa_t best_isa();
+
+/*!
+ \brief Accessor
+ \return the instruction set currently used by DBM operations
+ */
+enum tchecker::dbm::simd::isa_t selected_isa();
+
+/*!
+ \brief Select the instruction set used by DBM operations
+ \param isa : an instruction set
+ \post DBM operations use kernels for isa
+ \throw std::invalid_argument : if isa is not supported
+ \note not thread-safe w.r.t. concurrent DBM operations: should be called before
+ any DBM operation takes place (or in single-threaded context)
+ */
+void select(enum tchecker::dbm::simd::isa_t isa);
+
+/*!
+ \brief Accessor
+ \param isa : an instruction set
+ \return name of isa
+ */
+std::string isa_name(enum tchecker::dbm::simd::isa_t isa);
+
+/*!
+ \brief Parse an instruction set
+ \param name : name of an instruction set (scalar, sse4.2, avx2 or best)
+ \return instruction set with name
+ \throw std::invalid_argument : if name is not a known instruction set
+ */
+enum tchecker::dbm::simd::isa_t parse_isa(std::string const & name);
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_DBM_SIMD_HH
@@ -120,6 +120,15 @@ struct has_clock_constraints_t {
  */
 tchecker::has_clock_constraints_t has_clock_constraints(tchecker::typed_expression_t const & expr);
 
+/*!
+ \brief Extract clock IDs from diagonal clock constraints in an expression
+ \param expr : expression
+ \param clocks : a set of clock IDs
+ \post for every diagonal clock constraint x - y # c in expr, x and y have been added to clocks. Arrays of clocks
+ are handled as in tchecker::extract_variables
+ */
+void extract_diagonal_clocks(tchecker::typed_expression_t const & expr, std::unordered_set<tchecker::clock_id_t> & clocks);
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_EXPRESSION_STATIC_ANALYSIS_HH
@@ -0,0 +1,193 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_BITSTATE_GRAPH_HH
+#define TCHECKER_BITSTATE_GRAPH_HH
+
+/*!
+ \file bitstate_graph.hh
+ \brief Graph that only stores hash values of its nodes in a bit-state table
+ */
+
+#include <tuple>
+
+#include "tchecker/graph/allocators.hh"
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/bitstate.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+namespace tchecker {
+
+namespace graph {
+
+namespace bitstate {
+
+/*!
+ \brief Type of bit-state graph node that inherits from NODE
+ \tparam NODE : type of user node
+ */
+template <class NODE> class node_t : public NODE {
+public:
+  using NODE::NODE;
+};
+
+/*!
+ \brief Type of shared node
+ \tparam NODE : type of user node
+ */
+template <class NODE> using shared_node_t = tchecker::make_shared_t<tchecker::graph::bitstate::node_t<NODE>>;
+
+/*!
+ \brief Type of pointer to shared node
+ \tparam NODE : type of user node
+ */
+template <class NODE> using node_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::graph::bitstate::shared_node_t<NODE>>;
+
+} // end of namespace bitstate
+
+} // end of namespace graph
+
+/*!
+ \class allocation_size_t
+ \brief Specialisation of class allocation_size_t for type tchecker::graph::bitstate::node_t
+ */
+template <class NODE> class allocation_size_t<tchecker::graph::bitstate::node_t<NODE>> {
+public:
+  /*!
+   \brief Allocation size for objects of type tchecker::graph::bitstate::node_t
+   \note unsused parameters
+   */
+  template <class... ARGS> static std::size_t alloc_size(ARGS &&...)
+  {
+    return sizeof(tchecker::graph::bitstate::node_t<NODE>);
+  }
+};
+
+namespace graph {
+
+namespace bitstate {
+
+/*!
+ \class graph_t
+ \brief Graph that stores the hash values of its nodes in a bit-state table, and
+ that does not store nodes nor edges
+ \tparam NODE : type of nodes
+ \tparam NODE_HASH : hash function on nodes
+ \note nodes are allocated of type tchecker::graph::bitstate::node_t<NODE>. They are
+ released when they are not referenced anymore (e.g. by a waiting container)
+ \note nodes are identified by their hash values w.r.t. NODE_HASH. Hence, distinct
+ nodes are considered equal when their hash values collide in the bit-state table
+ (see tchecker::bitstate_t). This graph can be used in place of a reachability
+ graph (see tchecker::graph::reachability::graph_t) for an under-approximate
+ exploration that only uses a few bits of memory per node
+*/
+template <class NODE, class NODE_HASH> class graph_t {
+public:
+  /*!
+   \brief Type of nodes
+   */
+  using node_t = NODE;
+
+  /*!
+   \brief Type of shared nodes
+  */
+  using shared_node_t = tchecker::graph::bitstate::shared_node_t<NODE>;
+
+  /*!
+  \brief Type of pointer to shared nodes
+  */
+  using node_sptr_t = tchecker::graph::bitstate::node_sptr_t<NODE>;
+
+  /*!
+  \brief Constructor
+  \param block_size : number of nodes allocated in a block
+  \param bits : number of bits in the bit-state table
+  \param hashes : number of bits per node in the bit-state table
+  \param node_hash : hash function on nodes
+  \throw std::invalid_argument : if hashes is not in 1..32
+  */
+  graph_t(std::size_t block_size, std::size_t bits, unsigned int hashes, NODE_HASH const & node_hash)
+      : _node_hash(node_hash), _bitstate(bits, hashes), _node_pool(block_size)
+  {
+  }
+
+  /*!
+  \brief Copy constructor (deleted)
+  */
+  graph_t(tchecker::graph::bitstate::graph_t<NODE, NODE_HASH> const &) = delete;
+
+  /*!
+  \brief Move constructor (deleted)
+  */
+  graph_t(tchecker::graph::bitstate::graph_t<NODE, NODE_HASH> &&) = delete;
+
+  /*!
+  \brief Destructor
+  */
+  virtual ~graph_t() = default;
+
+  /*!
+  \brief Assignment operator (deleted)
+  */
+  tchecker::graph::bitstate::graph_t<NODE, NODE_HASH> &
+  operator=(tchecker::graph::bitstate::graph_t<NODE, NODE_HASH> const &) = delete;
+
+  /*!
+  \brief Move-assignment operator (deleted)
+  */
+  tchecker::graph::bitstate::graph_t<NODE, NODE_HASH> &
+  operator=(tchecker::graph::bitstate::graph_t<NODE, NODE_HASH> &&) = delete;
+
+  /*!
+  \brief Clear the graph
+  \post the bit-state table is empty
+  */
+  void clear() { _bitstate.clear(); }
+
+  /*!
+  \brief Add a node
+  \param args : arguments to a constructor of type NODE
+  \post the hash value of NODE(args) has been added to the bit-state table
+  \return a pair (status, n) where n is an instance of NODE(args), and status is
+  true if the hash value of n was not in the bit-state table, false otherwise
+  \note n is not stored in the graph
+   */
+  template <class... ARGS> std::tuple<bool, node_sptr_t> add_node(ARGS &&... args)
+  {
+    node_sptr_t node = _node_pool.construct(args...);
+    return std::make_tuple(_bitstate.insert(_node_hash(*node)), node);
+  }
+
+  /*!
+   \brief Add an edge (no-op: edges are not stored)
+   */
+  template <class... ARGS> void add_edge(node_sptr_t const &, node_sptr_t const &, ARGS &&...) {}
+
+  /*!
+   \brief Hook for nodes that have been expanded (no-op)
+   */
+  void passed_node(node_sptr_t const &) {}
+
+  /*!
+   \brief Accessor
+   \return bit-state table
+   */
+  inline tchecker::bitstate_t const & bitstate() const { return _bitstate; }
+
+private:
+  NODE_HASH _node_hash;                                             /*!< Hash function on nodes */
+  tchecker::bitstate_t _bitstate;                                   /*!< Bit-state table */
+  tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool; /*!< Pool of nodes */
+};
+
+} // end of namespace bitstate
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_BITSTATE_GRAPH_HH
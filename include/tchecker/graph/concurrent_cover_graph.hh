@@ -0,0 +1,317 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_CONCURRENT_COVER_GRAPH_HH
+#define TCHECKER_CONCURRENT_COVER_GRAPH_HH
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/graph/cover_graph.hh"
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/spinlock.hh"
+
+/*!
+ \file concurrent_cover_graph.hh
+ \brief Thread-safe graph with node covering
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+namespace cover {
+
+/*!
+ \class concurrent_graph_t
+ \brief Thread-safe graph with node covering
+ \tparam NODE_SPTR : type of shared pointer to node
+ \tparam NODE_SPTR_HASH : type of hash function on node pointers (see tchecker::graph::cover::graph_t)
+ \tparam NODE_SPTR_LE : less-than-or-equal predicate on nodes (see tchecker::graph::cover::graph_t)
+ \note Nodes are sharded w.r.t. NODE_SPTR_HASH: since only nodes with same hash value are compared
+ w.r.t. NODE_SPTR_LE, each operation only needs to lock the shard that contains the nodes with same
+ hash value as its argument. Each shard is protected by a tchecker::spinlock_t
+ \note NODE_SPTR_HASH and NODE_SPTR_LE are called with the lock of the shard held, and must be safe
+ to call concurrently on nodes from distinct shards
+ \note This graph keeps copies of node pointers, hence copying and destroying NODE_SPTR should be
+ thread-safe (e.g. std::shared_ptr), or every node should be referenced from a single thread
+ */
+template <class NODE_SPTR, class NODE_SPTR_HASH, class NODE_SPTR_LE> class concurrent_graph_t {
+public:
+  /*!
+   \brief Type of node shared pointer
+  */
+  using node_sptr_t = NODE_SPTR;
+
+  /*!
+   \brief Constructor
+   \param table_size : size of the collision table of nodes (over all shards)
+   \param shards : number of shards
+   \param node_hash : hash function
+   \param node_le : covering predicate on nodes
+   \pre table_size != tchecker::COLLISION_TABLE_NOT_STORED and shards > 0
+   \post the number of shards is the smallest power of 2 greater than or equal to shards
+   \throw std::invalid_argument : if the precondition is violated
+   */
+  concurrent_graph_t(std::size_t table_size, std::size_t shards, NODE_SPTR_HASH const & node_hash,
+                     NODE_SPTR_LE const & node_le)
+      : _shard_bits(0), _node_hash(node_hash), _node_le(node_le), _size(0)
+  {
+    if (shards == 0)
+      throw std::invalid_argument("Concurrent cover graph needs at least one shard");
+    while ((static_cast<std::size_t>(1) << _shard_bits) < shards)
+      ++_shard_bits;
+
+    std::size_t const shards_count = static_cast<std::size_t>(1) << _shard_bits;
+    std::size_t const shard_table_size = (table_size + shards_count - 1) / shards_count;
+    for (std::size_t i = 0; i < shards_count; ++i)
+      _shards.push_back(std::make_unique<shard_t>(shard_table_size, node_hash));
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  concurrent_graph_t(tchecker::graph::cover::concurrent_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  concurrent_graph_t(tchecker::graph::cover::concurrent_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~concurrent_graph_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::cover::concurrent_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &
+  operator=(tchecker::graph::cover::concurrent_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::cover::concurrent_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &
+  operator=(tchecker::graph::cover::concurrent_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &&) = delete;
+
+  /*!
+   \brief Clear
+   \post The graph is empty
+   \note Not thread-safe: shall not be called concurrently with other methods
+   */
+  void clear()
+  {
+    for (auto & shard : _shards)
+      shard->table.clear();
+    _size = 0;
+  }
+
+  /*!
+   \brief Add node to the graph
+   \param n : a node
+   \pre n is not stored in a graph
+   \post n has been added to the graph
+   \throw std::invalid_argument : if n is already stored in a graph
+   */
+  void add_node(NODE_SPTR const & n)
+  {
+    shard_t & shard = this->shard(n);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    shard.table.add(n);
+    _size.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Remove node from the graph
+   \param n : a node
+   \pre n is stored in this graph
+   \post n has been removed from this graph
+   \throw std::invalid_argument : if n is not stored in this graph
+   */
+  void remove_node(NODE_SPTR const & n)
+  {
+    shard_t & shard = this->shard(n);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    shard.table.remove(n);
+    _size.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Check if a node is covered in the graph
+   \param n : a node
+   \param covering_node : a node
+   \post covering_node is such that NODE_SPTR_LE(n, covering_node) is true if such node exists
+   in the graph, nullptr otherwise
+   \return true if a covering node has been found for n, false otherwise
+   \note n is never covered by itself
+   */
+  bool is_covered(NODE_SPTR const & n, NODE_SPTR & covering_node) const
+  {
+    shard_t & shard = this->shard(n);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    return find_covering(shard, n, covering_node);
+  }
+
+  /*!
+   \brief Accessor to the nodes in the graph that are covered by a given node
+   \param n : a node
+   \param ins : an inserter iterator that accepts NODE_SPTR
+   \post All the nodes in this graph with the same hash value as n, and that are
+   smaller-than-or-equal-to n w.r.t. NODE_SPTR_LE have been inserted using ins
+   \note n is never added to ins
+   */
+  template <class INSERTER> void covered_nodes(NODE_SPTR const & n, INSERTER & ins) const
+  {
+    shard_t & shard = this->shard(n);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+    for (NODE_SPTR const & node : shard.table.collision_range(n))
+      if ((node != n) && _node_le(node, n))
+        ins = node;
+  }
+
+  /*!
+   \brief Atomically add a node if it is not covered, and remove the nodes it covers
+   \param n : a node
+   \param covering_node : a node
+   \param ins : an inserter iterator that accepts NODE_SPTR
+   \pre n is not stored in a graph
+   \post if there is a node in the graph that covers n, then covering_node points to
+   such a node and the graph is unchanged. Otherwise, covering_node is nullptr, all the
+   nodes covered by n have been removed from the graph and inserted using ins, and n
+   has been added to the graph
+   \return true if n has been added to the graph, false otherwise
+   \throw std::invalid_argument : if n is already stored in a graph
+   \note no other thread can observe the graph between the covering check and the
+   addition of n
+   */
+  template <class INSERTER> bool add_if_not_covered(NODE_SPTR const & n, NODE_SPTR & covering_node, INSERTER & ins)
+  {
+    shard_t & shard = this->shard(n);
+    std::lock_guard<tchecker::spinlock_t> lock(shard.lock);
+
+    if (find_covering(shard, n, covering_node))
+      return false;
+
+    shard.covered.clear();
+    for (NODE_SPTR const & node : shard.table.collision_range(n))
+      if (_node_le(node, n))
+        shard.covered.push_back(node);
+    for (NODE_SPTR const & node : shard.covered) {
+      shard.table.remove(node);
+      ins = node;
+    }
+    _size.fetch_sub(shard.covered.size(), std::memory_order_relaxed);
+    shard.covered.clear();
+
+    shard.table.add(n);
+    _size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /*!
+   \brief Accessor
+   \return Number of nodes in this graph
+   \note the returned value may be outdated if other threads modify the graph
+   */
+  inline std::size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+  /*!
+   \brief Accessor
+   \return Number of shards
+   */
+  inline std::size_t shards() const { return _shards.size(); }
+
+  /*!
+   \brief Accessor to nodes
+   \param ins : an inserter iterator that accepts NODE_SPTR
+   \post all the nodes in this graph have been inserted using ins
+   \note each shard is locked while its nodes are inserted, but the result is not a
+   snapshot of the graph if other threads modify it concurrently
+   */
+  template <class INSERTER> void nodes(INSERTER & ins) const
+  {
+    for (auto const & shard : _shards) {
+      std::lock_guard<tchecker::spinlock_t> lock(shard->lock);
+      for (NODE_SPTR const & node : shard->table)
+        ins = node;
+    }
+  }
+
+private:
+  /*!
+   \class shard_t
+   \brief Shard of the graph
+   */
+  class shard_t {
+  public:
+    /*!
+     \brief Constructor
+     \param table_size : size of the collision table
+     \param node_hash : hash function
+     */
+    shard_t(std::size_t table_size, NODE_SPTR_HASH const & node_hash) : table(table_size, node_hash) {}
+
+    mutable tchecker::spinlock_t lock;                            /*!< Lock */
+    tchecker::collision_table_t<NODE_SPTR, NODE_SPTR_HASH> table; /*!< Nodes */
+    std::vector<NODE_SPTR> covered;                               /*!< Buffer for covered nodes */
+  };
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return the shard that should contain n
+   \note the shard is selected from the high bits of a multiplicative hash of the hash value
+   of n, as the low bits select the collision list in the shard
+   */
+  inline shard_t & shard(NODE_SPTR const & n) const
+  {
+    if (_shard_bits == 0)
+      return *_shards[0];
+    std::uint64_t const h = static_cast<std::uint64_t>(_node_hash(n)) * UINT64_C(0x9E3779B97F4A7C15);
+    return *_shards[static_cast<std::size_t>(h >> (64 - _shard_bits))];
+  }
+
+  /*!
+   \brief Search a covering node in a shard
+   \param shard : a shard
+   \param n : a node
+   \param covering_node : a node
+   \pre the lock of shard is held
+   \post covering_node points to a node in shard that covers n if any, nullptr otherwise
+   \return true if a covering node has been found, false otherwise
+   */
+  bool find_covering(shard_t const & shard, NODE_SPTR const & n, NODE_SPTR & covering_node) const
+  {
+    for (NODE_SPTR const & node : shard.table.collision_range(n)) {
+      if ((n != node) && _node_le(n, node)) {
+        covering_node = node;
+        return true;
+      }
+    }
+    covering_node = nullptr;
+    return false;
+  }
+
+  unsigned int _shard_bits;                    /*!< Number of shards is 2^_shard_bits */
+  std::vector<std::unique_ptr<shard_t>> _shards; /*!< Shards */
+  NODE_SPTR_HASH _node_hash;                   /*!< Hash function on node pointers */
+  NODE_SPTR_LE _node_le;                       /*!< Covering predicate on node pointers */
+  std::atomic<std::size_t> _size;              /*!< Number of nodes */
+};
+
+} // end of namespace cover
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_CONCURRENT_COVER_GRAPH_HH
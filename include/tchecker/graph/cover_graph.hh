@@ -183,6 +183,12 @@ public:
    */
   inline std::size_t size() const { return _nodes.size(); }
 
+  /*!
+   \brief Accessor
+   \return Covering predicate on node pointers
+   */
+  inline NODE_SPTR_LE const & node_le() const { return _node_le; }
+
   /*!
    \brief Type of iterator over the nodes in the graph
    */
@@ -8,14 +8,25 @@
 #ifndef TCHECKER_GRAPH_NODE_HH
 #define TCHECKER_GRAPH_NODE_HH
 
+#include <cassert>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "tchecker/refzg/state.hh"
+#include "tchecker/zg/minimal_zone.hh"
 #include "tchecker/zg/state.hh"
 
 namespace tchecker {
 
+namespace zg {
+
+class zg_t;
+
+} // end of namespace zg
+
 namespace graph {
 
 /*!
@@ -119,10 +130,329 @@ struct node_zg_state_t {
   */
   inline tchecker::zg::state_t const & state() const { return *_state; }
 
+protected:
+  /*!
+   \brief Set state
+   \param s : a zone graph state (may be nullptr)
+   \post this node keeps a shared pointer to s, and releases its previous state
+   \note for nodes that store their state in another form (see
+   tchecker::graph::node_compact_zg_state_t)
+   */
+  inline void set_state(tchecker::zg::const_state_sptr_t const & s) { _state = s; }
+
 private:
   tchecker::zg::const_state_sptr_t _state; /*!< State of the zone graph */
 };
 
+/*!
+ \class compact_state_pool_t
+ \brief Allocator of compact states (see tchecker::graph::node_compact_zg_state_t)
+ \note Compact states have a variable size, that depends on the number of edges of
+ their minimal zone. Compact states of the same size are allocated in blocks, and
+ deallocated compact states are recycled for compact states of the same size.
+ Blocks are only released when the pool is destroyed, hence compact nodes shall
+ be destroyed before their pool
+ \note The pool is *NOT* thread-safe
+ */
+class compact_state_pool_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  compact_state_pool_t() = default;
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  compact_state_pool_t(tchecker::graph::compact_state_pool_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  compact_state_pool_t(tchecker::graph::compact_state_pool_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post all blocks have been released
+   */
+  ~compact_state_pool_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::compact_state_pool_t & operator=(tchecker::graph::compact_state_pool_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::compact_state_pool_t & operator=(tchecker::graph::compact_state_pool_t &&) = delete;
+
+  /*!
+   \brief Allocation
+   \param size : number of bytes
+   \return pointer to size bytes aligned as std::max_align_t
+   */
+  void * allocate(std::size_t size);
+
+  /*!
+   \brief Deallocation
+   \param ptr : pointer to memory
+   \param size : number of bytes
+   \pre ptr has been returned by allocate(size) on this pool, and it has not been deallocated
+   \post ptr can be returned by allocate(size) again
+   */
+  void deallocate(void * ptr, std::size_t size);
+
+  /*!
+   \brief Accessor
+   \return scratch container of edges, used to compute minimal zones
+   */
+  inline std::vector<tchecker::zg::minimal_edge_t> & edges() { return _edges; }
+
+private:
+  /*!
+   \brief Accessor
+   \param size : number of bytes
+   \return size class of size
+   */
+  static std::size_t size_class(std::size_t size);
+
+  std::vector<void *> _free;                        /*!< Free lists, by size class */
+  std::vector<std::unique_ptr<char[]>> _blocks;     /*!< Allocated blocks */
+  std::vector<tchecker::zg::minimal_edge_t> _edges; /*!< Scratch edges */
+};
+
+/*!
+ \class node_compact_zg_state_t
+ \brief Graph node that points to a state of a zone graph, and that can store
+ this state in compact form
+ \note A compact node keeps its tuple of locations and its integer variables
+ valuation, and stores its zone as a minimal constraint graph (see
+ tchecker::zg::minimal_zone_t). The compact state is allocated from a
+ tchecker::graph::compact_state_pool_t, and its minimal zone can be spilled to
+ some memory region (typically a tchecker::spill_file_t) that shall outlive the
+ node. The state is rebuilt by restore()
+ \note The state and the compact state share the same pointer: nodes that are
+ never compacted have the same size as tchecker::graph::node_zg_state_t
+ */
+class node_compact_zg_state_t {
+public:
+  /*!
+   \brief Constructor
+   \param s : a zone graph state
+   \post this node keeps a shared pointer to s
+  */
+  node_compact_zg_state_t(tchecker::zg::state_sptr_t const & s);
+
+  /*!
+   \brief Constructor
+   \param s : a zone graph state
+   \post this node keeps a shared pointer to s
+   */
+  node_compact_zg_state_t(tchecker::zg::const_state_sptr_t const & s);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  node_compact_zg_state_t(tchecker::graph::node_compact_zg_state_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  node_compact_zg_state_t(tchecker::graph::node_compact_zg_state_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post the state of this node has been released
+   \note the memory of a compact state is not deallocated: it is released with its pool
+   */
+  ~node_compact_zg_state_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::node_compact_zg_state_t & operator=(tchecker::graph::node_compact_zg_state_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::node_compact_zg_state_t & operator=(tchecker::graph::node_compact_zg_state_t &&) = delete;
+
+  /*!
+  \brief Accessor
+  \return shared pointer to zone graph state in this node
+  \pre this node is not compact (checked by assertion)
+  */
+  inline tchecker::zg::const_state_sptr_t state_ptr() const { return tchecker::zg::const_state_sptr_t{shared_state()}; }
+
+  /*!
+  \brief Accessor
+  \return zone graph state in this node
+  \pre this node is not compact (checked by assertion)
+  */
+  inline tchecker::zg::state_t const & state() const { return *shared_state(); }
+
+  /*!
+   \brief Compaction
+   \param pool : pool of compact states
+   \pre this node is not compact
+   \post this node stores its zone as a minimal constraint graph in a compact state
+   allocated from pool, and it has released its state: state() and state_ptr() shall
+   not be used until restore() is called
+   \note only nodes that will not be expanded anymore should be compacted
+   */
+  void compact(tchecker::graph::compact_state_pool_t & pool);
+
+  /*!
+   \brief Spill the minimal zone of a compact node
+   \param ptr : pointer to a memory region
+   \param pool : pool of compact states
+   \pre this node is compact (checked by assertion), its compact state has been
+   allocated from pool, and ptr points to spill_size() bytes aligned as
+   tchecker::zg::minimal_zone_t
+   \post the minimal zone of this node has been copied to ptr, and the compact state
+   of this node has been replaced by a compact state without minimal zone. The memory
+   pointed by ptr shall outlive this node
+   \note if this node is already spilled, its minimal zone is moved to ptr, and the
+   region it has been spilled to before is not accessed anymore
+   */
+  void spill(void * ptr, tchecker::graph::compact_state_pool_t & pool);
+
+  /*!
+   \brief Restore the state of a compact node
+   \param zg : zone graph
+   \param pool : pool of compact states
+   \pre the compact state of this node, if any, has been allocated from pool
+   \post this node is not compact, and it points to a state of zg built from its
+   tuple of locations, integer variables valuation and zone. Its compact state has
+   been deallocated
+   */
+  void restore(tchecker::zg::zg_t & zg, tchecker::graph::compact_state_pool_t & pool);
+
+  /*!
+   \brief Accessor
+   \return true if this node is compact, false otherwise
+   */
+  inline bool is_compact() const { return (_ptr & COMPACT_TAG) != 0; }
+
+  /*!
+   \brief Accessor
+   \return true if this node is compact and its minimal zone has been spilled, false otherwise
+   */
+  bool is_spilled() const;
+
+  /*!
+   \brief Accessor
+   \return minimal zone in this node
+   \pre this node is compact (checked by assertion)
+   */
+  tchecker::zg::minimal_zone_t const & minimal_zone() const;
+
+  /*!
+   \brief Accessor
+   \return shared pointer to the tuple of locations in this node
+   */
+  tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc_ptr() const;
+
+  /*!
+   \brief Accessor
+   \return shared pointer to the integer variables valuation in this node
+   */
+  tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> intval_ptr() const;
+
+  /*!
+   \brief Accessor
+   \return number of bytes needed to spill the minimal zone of this node, rounded up
+   to preserve alignment of consecutive minimal zones
+   \pre this node is compact (checked by assertion)
+   */
+  std::size_t spill_size() const;
+
+  /*!
+   \brief Accessor
+   \return number of bytes used in main memory to store the state in this node: the
+   state and its zone for full nodes, the compact state (including the minimal zone
+   unless it has been spilled) for compact nodes
+   \note the discrete part is shared among nodes, hence not counted
+   */
+  std::size_t storage_bytes() const;
+
+private:
+  /*!
+   \brief Compact representation of a state
+   \note A compact state that has not been spilled is followed by its minimal zone,
+   at offset ZONE_OFFSET
+   */
+  struct compact_t {
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> vloc;     /*!< Tuple of locations */
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> intval; /*!< Integer variables valuation */
+    tchecker::zg::minimal_zone_t const * zone; /*!< Minimal zone (in this compact state, or spilled) */
+  };
+
+  /*!
+   \brief Offset of the minimal zone in a compact state
+   */
+  static constexpr std::size_t ZONE_OFFSET =
+      (sizeof(compact_t) + alignof(tchecker::zg::minimal_zone_t) - 1) / alignof(tchecker::zg::minimal_zone_t) *
+      alignof(tchecker::zg::minimal_zone_t);
+
+  /*!
+   \brief Tag of compact states in _ptr
+   */
+  static constexpr std::uintptr_t COMPACT_TAG = 1;
+
+  static_assert(alignof(tchecker::zg::shared_state_t) > COMPACT_TAG, "States must leave the tag bit unused");
+  static_assert(alignof(compact_t) > COMPACT_TAG, "Compact states must leave the tag bit unused");
+
+  /*!
+   \brief Accessor
+   \return state in this node
+   \pre this node is not compact (checked by assertion)
+   */
+  inline tchecker::zg::shared_state_t const * shared_state() const
+  {
+    assert(!is_compact());
+    return reinterpret_cast<tchecker::zg::shared_state_t const *>(_ptr);
+  }
+
+  /*!
+   \brief Accessor
+   \return compact state in this node
+   \pre this node is compact (checked by assertion)
+   */
+  inline compact_t * compact_state() const
+  {
+    assert(is_compact());
+    return reinterpret_cast<compact_t *>(_ptr & ~COMPACT_TAG);
+  }
+
+  /*!
+   \brief Set state
+   \param s : a zone graph state (may be nullptr)
+   \pre this node has no state and no compact state
+   \post this node holds a reference to s
+   */
+  void set_state(tchecker::zg::shared_state_t const * s);
+
+  /*!
+   \brief Release state
+   \post the reference held on the state of this node, if any, has been released
+   */
+  void release_state();
+
+  /*!
+   \brief Allocation size
+   \param edges : number of edges of a minimal zone
+   \return number of bytes of a compact state with a minimal zone of edges edges
+   */
+  static constexpr std::size_t compact_size(std::size_t edges)
+  {
+    return ZONE_OFFSET + tchecker::allocation_size_t<tchecker::zg::minimal_zone_t>::alloc_size(edges);
+  }
+
+  std::uintptr_t _ptr; /*!< Pointer to state (with a reference), or tagged pointer to compact state */
+};
+
 /*!
  \struct node_refzg_state_t
  \brief Graph node that points to a state of a zone-graph with reference clocks
@@ -306,6 +306,11 @@ public:
     _directed_graph.add_edge(n1, n2, edge);
   }
 
+  /*!
+   \brief Hook for nodes that have been expanded (no-op by default)
+   */
+  void passed_node(node_sptr_t const &) {}
+
   /*!
    \brief Remove node
    \param n : a node
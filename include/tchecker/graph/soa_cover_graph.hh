@@ -0,0 +1,599 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_SOA_COVER_GRAPH_HH
+#define TCHECKER_SOA_COVER_GRAPH_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/graph/cover_graph.hh"
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/iterator.hh"
+
+/*!
+ \file soa_cover_graph.hh
+ \brief Graph with node covering, and batched covering checks over buckets of zones
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+namespace cover {
+
+template <class NODE_SPTR, class NODE_SPTR_HASH, class NODE_SPTR_LE> class soa_graph_t;
+
+/*!
+ \class soa_node_t
+ \brief Node that can be stored in a tchecker::graph::cover::soa_graph_t
+ \note Stores the position of the node in its bucket for fast lookup and removal
+ */
+class soa_node_t : public tchecker::graph::cover::node_t {
+public:
+  /*!
+   \brief Constructor
+   \post this node is not stored in a bucket
+   */
+  soa_node_t() = default;
+
+  /*!
+   \brief Copy constructor
+   \post this node is not stored in a bucket (i.e. the position is not copied)
+   */
+  soa_node_t(tchecker::graph::cover::soa_node_t const & n) : tchecker::graph::cover::node_t(n) {}
+
+  /*!
+   \brief Move constructor
+   \post this node is not stored in a bucket (i.e. the position is not moved)
+   */
+  soa_node_t(tchecker::graph::cover::soa_node_t && n) : tchecker::graph::cover::node_t(std::move(n)) {}
+
+  /*!
+   \brief Destructor
+   */
+  ~soa_node_t() = default;
+
+  /*!
+   \brief Assignment operator
+   \post this node has kept its position
+   */
+  tchecker::graph::cover::soa_node_t & operator=(tchecker::graph::cover::soa_node_t const & n)
+  {
+    tchecker::graph::cover::node_t::operator=(n);
+    return *this;
+  }
+
+  /*!
+   \brief Move-assignment operator
+   \post this node has kept its position
+   */
+  tchecker::graph::cover::soa_node_t & operator=(tchecker::graph::cover::soa_node_t && n)
+  {
+    tchecker::graph::cover::node_t::operator=(std::move(n));
+    return *this;
+  }
+
+private:
+  template <class NODE_SPTR, class NODE_SPTR_HASH, class NODE_SPTR_LE> friend class tchecker::graph::cover::soa_graph_t;
+
+  /*!
+   \brief Placeholder position for nodes which are not stored in a bucket
+   */
+  static constexpr std::size_t NOT_STORED = std::numeric_limits<std::size_t>::max();
+
+  std::size_t _position_in_bucket{NOT_STORED}; /*!< Position in the nodes, or in the empty nodes, of its bucket */
+};
+
+/*!
+ \class soa_graph_t
+ \brief Graph with node covering that can check covering of a node against all the nodes
+ with the same discrete part at once
+ \tparam NODE_SPTR : type of shared pointer to node, that points to a type derived from
+ tchecker::graph::cover::soa_node_t
+ \tparam NODE_SPTR_HASH : type of hash function on node pointers (see tchecker::graph::cover::graph_t)
+ \tparam NODE_SPTR_LE : covering predicate on node pointers (see tchecker::graph::cover::graph_t). When
+ batched covering checks are enabled, NODE_SPTR_LE should also provide:
+ - bool comparable(NODE_SPTR const & n1, NODE_SPTR const & n2) : true if n1 and n2 can be compared
+ (i.e. they have the same discrete part), false otherwise
+ - tchecker::clock_id_t dim(NODE_SPTR const & n) : dimension of the zone of n
+ - bool normalize(NODE_SPTR const & n, tchecker::dbm::db_t * dbm) : writes the zone of n that is
+ compared to other zones in dbm, and returns false if it is empty
+ - void is_le_batch(NODE_SPTR const & n, tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch,
+ std::size_t stride, std::size_t count, tchecker::clock_id_t dim, std::uint64_t * le) : with dbm the normalized
+ zone of n, and batch the normalized zones of count nodes comparable to n (see tchecker::dbm::is_le_batch), sets
+ bit k of le iff n is covered by the k-th node
+ - void is_ge_batch(...) : same as is_le_batch, sets bit k of ge iff the k-th node is covered by n
+ such that NODE_SPTR_LE(n1, n2) holds iff n1 and n2 are comparable, and either the normalized zone of
+ n1 is empty, or the normalized zone of n2 is not empty and is_le_batch(n1, ...) sets the bit of n2.
+ \note This graph has the same interface as tchecker::graph::cover::graph_t. With batched covering checks
+ disabled (default), it behaves as tchecker::graph::cover::graph_t. Otherwise, the normalized zones of the
+ nodes that have the same discrete part are stored in a bucket, in structure-of-arrays layout, and a node
+ is compared to a whole bucket using vectorized DBM kernels. The covering node returned by is_covered, and
+ the order of the nodes returned by covered_nodes, may differ from tchecker::graph::cover::graph_t, but the
+ covering decisions are the same
+ \note batched covering checks store a copy of the normalized zone of each node in the graph. The zones
+ of nodes can be compacted once they have been added to the graph, since covering checks only read
+ the zones in buckets
+ */
+template <class NODE_SPTR, class NODE_SPTR_HASH, class NODE_SPTR_LE> class soa_graph_t {
+public:
+  /*!
+   \brief Type of node shared pointer
+  */
+  using node_sptr_t = NODE_SPTR;
+
+  /*!
+   \brief Constructor
+   \param table_size : size of the collision table of nodes
+   \param node_hash : hash function
+   \param node_le : covering predicate on nodes
+   \pre table_size != tchecker::COLLISION_TABLE_NOT_STORED
+   \throw std::invalid_argument : if the precondition is violated
+   \post batched covering checks are disabled
+   */
+  soa_graph_t(std::size_t table_size, NODE_SPTR_HASH const & node_hash, NODE_SPTR_LE const & node_le)
+      : _nodes(table_size, node_hash), _node_hash(node_hash), _node_le(node_le), _batched(false)
+  {
+  }
+
+  /*!
+   \brief Constructor
+   \param table_size : size of the collision table of nodes
+   \param node_hash : hash function
+   \param node_le : covering predicate on nodes
+   \pre table_size != tchecker::COLLISION_TABLE_NOT_STORED
+   \throw std::invalid_argument : if the precondition is violated
+   \post batched covering checks are disabled
+   */
+  soa_graph_t(std::size_t table_size, NODE_SPTR_HASH && node_hash, NODE_SPTR_LE && node_le)
+      : _nodes(table_size, node_hash), _node_hash(std::move(node_hash)), _node_le(std::move(node_le)), _batched(false)
+  {
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  soa_graph_t(tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> const &) = delete;
+
+  /*!
+   \brief Move constructor
+   */
+  soa_graph_t(tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~soa_graph_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &
+  operator=(tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &
+  operator=(tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE> &&) = default;
+
+  /*!
+   \brief Enable/disable batched covering checks
+   \param batched : batched covering checks flag
+   \pre this graph is empty
+   \post covering checks are batched over the nodes with the same discrete part if batched is true,
+   and nodes are compared one by one otherwise
+   \throw std::invalid_argument : if this graph is not empty
+   */
+  void set_batched(bool batched)
+  {
+    if (_nodes.size() != 0)
+      throw std::invalid_argument("Covering checks can only be changed on an empty graph");
+    _batched = batched;
+  }
+
+  /*!
+   \brief Accessor
+   \return true if covering checks are batched, false otherwise
+   */
+  inline bool batched() const { return _batched; }
+
+  /*!
+   \brief Clear
+   \post The graph is empty
+   \note No destructor call on nodes
+   \note Invalidates iterators
+   */
+  void clear()
+  {
+    _nodes.clear();
+    for (auto && [hash, buckets] : _buckets)
+      for (bucket_t & b : buckets) {
+        for (NODE_SPTR const & n : b.nodes)
+          n->_position_in_bucket = tchecker::graph::cover::soa_node_t::NOT_STORED;
+        for (NODE_SPTR const & n : b.empty_nodes)
+          n->_position_in_bucket = tchecker::graph::cover::soa_node_t::NOT_STORED;
+      }
+    _buckets.clear();
+  }
+
+  /*!
+   \brief Add node to the graph
+   \param n : a node
+   \pre n is not stored in a graph
+   \post n has been added to the graph. If covering checks are batched, the normalized zone
+   of n has been added to the bucket of nodes with the same discrete part as n
+   \throw std::invalid_argument : if n is already stored in a graph
+   \note Invalidates iterators
+   */
+  void add_node(NODE_SPTR const & n)
+  {
+    _nodes.add(n);
+    if (!_batched)
+      return;
+
+    std::vector<bucket_t> & buckets = _buckets[_node_hash(n)];
+    bucket_t * b = find_bucket(buckets, n);
+    if (b == nullptr) {
+      buckets.emplace_back();
+      b = &buckets.back();
+      b->dim = _node_le.dim(n);
+    }
+
+    std::size_t const size = static_cast<std::size_t>(b->dim) * b->dim;
+    _dbm.resize(size);
+    if (!_node_le.normalize(n, _dbm.data())) {
+      n->_position_in_bucket = b->empty_nodes.size();
+      b->empty_nodes.push_back(n);
+      return;
+    }
+    if (b->nodes.size() == b->capacity)
+      grow(*b);
+    std::size_t const k = b->nodes.size();
+    for (std::size_t i = 0; i < size; ++i)
+      b->zones[i * b->capacity + k] = _dbm[i];
+    n->_position_in_bucket = k;
+    b->nodes.push_back(n);
+  }
+
+  /*!
+   \brief Remove node from the graph
+   \param n : a node
+   \pre n is stored in this graph
+   \post n has been removed from this graph
+   \throw std::invalid_argument : if n is not stored in this graph
+   \note Invalidates iterators
+   \note If covering checks are batched, the zone of the last node of the bucket of n is moved in
+   place of the zone of n
+   */
+  void remove_node(NODE_SPTR const & n)
+  {
+    _nodes.remove(n);
+    if (!_batched)
+      return;
+
+    auto it = _buckets.find(_node_hash(n));
+    assert(it != _buckets.end());
+    std::vector<bucket_t> & buckets = it->second;
+    bucket_t * b = find_bucket(buckets, n);
+    assert(b != nullptr);
+
+    std::size_t const k = n->_position_in_bucket;
+    n->_position_in_bucket = tchecker::graph::cover::soa_node_t::NOT_STORED;
+    if (in_nodes(*b, n, k)) {
+      std::size_t const last = b->nodes.size() - 1;
+      std::size_t const size = static_cast<std::size_t>(b->dim) * b->dim;
+      for (std::size_t i = 0; i < size; ++i)
+        b->zones[i * b->capacity + k] = b->zones[i * b->capacity + last];
+      b->nodes[k] = b->nodes[last];
+      b->nodes[k]->_position_in_bucket = k;
+      b->nodes.pop_back();
+    }
+    else {
+      assert(k < b->empty_nodes.size() && b->empty_nodes[k] == n);
+      b->empty_nodes[k] = b->empty_nodes.back();
+      b->empty_nodes[k]->_position_in_bucket = k;
+      b->empty_nodes.pop_back();
+    }
+
+    if (b->nodes.empty() && b->empty_nodes.empty()) {
+      *b = std::move(buckets.back());
+      buckets.pop_back();
+      if (buckets.empty())
+        _buckets.erase(it);
+    }
+  }
+
+  /*!
+   \brief Check if a node is covered in the graph
+   \param n : a node
+   \param covering_node : a node
+   \post covering_node is such that NODE_SPTR_LE(n, covering_node) is true if such
+   node exists in the graph, nullptr otherwise
+   \return true if if a covering node has been found for n, false otherwise
+   \note Only the nodes which have the same hash value than n w.r.t. NODE_SPTR_HASH will
+   be considered as potential covering nodes
+   \note this function ensures that n is never covered by itself (i.e. it
+   returns false if n is the only node in this graph for which NODE_SPTR_LE is true)
+   */
+  bool is_covered(NODE_SPTR const & n, NODE_SPTR & covering_node) const
+  {
+    covering_node = nullptr;
+
+    if (!_batched) {
+      auto && range = _nodes.collision_range(n);
+      for (NODE_SPTR const & node : range)
+        if ((n != node) && _node_le(n, node)) {
+          covering_node = node;
+          return true;
+        }
+      return false;
+    }
+
+    bucket_t const * b = find_bucket(n);
+    if (b == nullptr)
+      return false;
+
+    std::size_t self = b->nodes.size();
+    if (!normalized_zone(*b, n, self)) {
+      // Empty zones are covered by any node
+      for (NODE_SPTR const & node : b->nodes)
+        if (node != n) {
+          covering_node = node;
+          return true;
+        }
+      for (NODE_SPTR const & node : b->empty_nodes)
+        if (node != n) {
+          covering_node = node;
+          return true;
+        }
+      return false;
+    }
+
+    // Check chunks of nodes to stop as soon as a covering node has been found
+    std::size_t const count = b->nodes.size();
+    _bits.resize(CHUNK_SIZE / 64);
+    for (std::size_t base = 0; base < count; base += CHUNK_SIZE) {
+      std::size_t const chunk = std::min(CHUNK_SIZE, count - base);
+      _node_le.is_le_batch(n, _dbm.data(), b->zones.data() + base, b->capacity, chunk, b->dim,
+                            _bits.data());
+      for (std::size_t k = 0; k < chunk; ++k)
+        if (((_bits[k / 64] >> (k % 64)) & 1) && (base + k != self)) {
+          covering_node = b->nodes[base + k];
+          return true;
+        }
+    }
+    return false;
+  }
+
+  /*!
+   \brief Accessor to the nodes in the graph that are covered by a given node
+   \param n : a node
+   \param ins : an inserter iterator that accepts NODE_SPTR
+   \post All the nodes in this graph with the same hash value as n, and that are
+   smaller-than-or-equal-to n w.r.t. NODE_SPTR_LE have been inserted using ins
+   \note this function ensures that n is never covered by itself (i.e. n is not
+   added to ins if it belongs to this graph)
+   */
+  template <class INSERTER> void covered_nodes(NODE_SPTR const & n, INSERTER & ins) const
+  {
+    if (!_batched) {
+      auto && range = _nodes.collision_range(n);
+      for (NODE_SPTR const & node : range)
+        if ((node != n) && _node_le(node, n))
+          ins = node;
+      return;
+    }
+
+    bucket_t const * b = find_bucket(n);
+    if (b == nullptr)
+      return;
+
+    // Empty zones are covered by any node
+    for (NODE_SPTR const & node : b->empty_nodes)
+      if (node != n)
+        ins = node;
+
+    std::size_t self = b->nodes.size();
+    if (!normalized_zone(*b, n, self))
+      return;
+
+    std::size_t const count = b->nodes.size();
+    if (count == 0)
+      return;
+    _bits.resize((count + 63) / 64);
+    _node_le.is_ge_batch(n, _dbm.data(), b->zones.data(), b->capacity, count, b->dim, _bits.data());
+    for (std::size_t k = 0; k < count; ++k)
+      if (((_bits[k / 64] >> (k % 64)) & 1) && (k != self))
+        ins = b->nodes[k];
+  }
+
+  /*!
+   \brief Accessor
+   \return Number of nodes in this graph
+   */
+  inline std::size_t size() const { return _nodes.size(); }
+
+  /*!
+   \brief Accessor
+   \return Covering predicate on node pointers
+   */
+  inline NODE_SPTR_LE const & node_le() const { return _node_le; }
+
+  /*!
+   \brief Type of iterator over the nodes in the graph
+   */
+  using const_iterator_t = typename tchecker::collision_table_t<NODE_SPTR, NODE_SPTR_HASH>::const_iterator_t;
+
+  /*!
+   \brief Accessor
+   \return Iterator pointing to the first node in the graph, or past-the-end if the graph is empty
+   */
+  tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE>::const_iterator_t begin() const
+  {
+    return _nodes.begin();
+  }
+
+  /*!
+   \brief Accessor
+   \return Past-the-end iterator
+   */
+  tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE>::const_iterator_t end() const
+  {
+    return _nodes.end();
+  }
+
+  /*!
+   \brief Accessor
+   \return Range of nodes
+  */
+  tchecker::range_t<tchecker::graph::cover::soa_graph_t<NODE_SPTR, NODE_SPTR_HASH, NODE_SPTR_LE>::const_iterator_t>
+  nodes() const
+  {
+    return tchecker::make_range(begin(), end());
+  }
+
+private:
+  /*!
+   \brief Number of nodes compared at once by is_covered (multiple of 64)
+   */
+  static constexpr std::size_t CHUNK_SIZE = 256;
+
+  /*!
+   \brief Bucket of nodes with the same discrete part
+   */
+  struct bucket_t {
+    tchecker::clock_id_t dim{0};            /*!< Dimension of zones */
+    std::size_t capacity{0};                /*!< Number of zones that fit in zones */
+    std::vector<NODE_SPTR> nodes;           /*!< Nodes with a non-empty normalized zone */
+    std::vector<NODE_SPTR> empty_nodes;     /*!< Nodes with an empty normalized zone */
+    std::vector<tchecker::dbm::db_t> zones; /*!< Normalized zones of nodes, bound (i,j) of nodes[k] is
+                                               zones[(i*dim+j)*capacity+k] */
+  };
+
+  /*!
+   \brief Find bucket of a node
+   \param buckets : buckets with the same hash value as n
+   \param n : a node
+   \return pointer to the bucket in buckets of the nodes comparable to n, nullptr if none
+   */
+  bucket_t * find_bucket(std::vector<bucket_t> & buckets, NODE_SPTR const & n) const
+  {
+    for (bucket_t & b : buckets)
+      if (in_bucket(b, n))
+        return &b;
+    return nullptr;
+  }
+
+  /*!
+   \brief Find bucket of a node
+   \param n : a node
+   \return pointer to the bucket of the nodes comparable to n, nullptr if none
+   */
+  bucket_t const * find_bucket(NODE_SPTR const & n) const
+  {
+    auto it = _buckets.find(_node_hash(n));
+    if (it == _buckets.end())
+      return nullptr;
+    for (bucket_t const & b : it->second)
+      if (in_bucket(b, n))
+        return &b;
+    return nullptr;
+  }
+
+  /*!
+   \brief Bucket membership
+   \param b : a non-empty bucket
+   \param n : a node
+   \return true if n is comparable to the nodes in b, false otherwise
+   */
+  bool in_bucket(bucket_t const & b, NODE_SPTR const & n) const
+  {
+    return _node_le.comparable((b.nodes.empty() ? b.empty_nodes.front() : b.nodes.front()), n);
+  }
+
+  /*!
+   \brief Membership to the nodes of a bucket
+   \param b : a bucket
+   \param n : a node
+   \param k : position of n in its bucket
+   \return true if n is the k-th node with a non-empty normalized zone in b, false otherwise
+   */
+  static bool in_nodes(bucket_t const & b, NODE_SPTR const & n, std::size_t k)
+  {
+    return (k < b.nodes.size()) && (b.nodes[k] == n);
+  }
+
+  /*!
+   \brief Compute the normalized zone of a node
+   \param b : bucket of the nodes comparable to n
+   \param n : a node
+   \param self : position of n in b
+   \post _dbm contains the normalized zone of n if it is not empty. self is the position of n in b.nodes
+   if n is stored in b.nodes, and it is left unchanged otherwise
+   \return false if the normalized zone of n is empty, true otherwise
+   \note the normalized zone of n is copied from b if n is stored in b, hence the zone of n is only
+   read if n is not stored in b
+   */
+  bool normalized_zone(bucket_t const & b, NODE_SPTR const & n, std::size_t & self) const
+  {
+    std::size_t const size = static_cast<std::size_t>(b.dim) * b.dim;
+    _dbm.resize(size);
+    std::size_t const k = n->_position_in_bucket;
+    if (!in_nodes(b, n, k)) {
+      if ((k < b.empty_nodes.size()) && (b.empty_nodes[k] == n))
+        return false;
+      return _node_le.normalize(n, _dbm.data());
+    }
+    self = k;
+    for (std::size_t i = 0; i < size; ++i)
+      _dbm[i] = b.zones[i * b.capacity + k];
+    return true;
+  }
+
+  /*!
+   \brief Double the capacity of a bucket
+   \param b : a bucket
+   \post the capacity of b has been doubled (or set to 8 if b was empty), and the zones in b
+   have been moved accordingly
+   */
+  static void grow(bucket_t & b)
+  {
+    std::size_t const size = static_cast<std::size_t>(b.dim) * b.dim;
+    std::size_t const capacity = (b.capacity == 0 ? 8 : 2 * b.capacity);
+    std::vector<tchecker::dbm::db_t> zones(size * capacity);
+    for (std::size_t i = 0; i < size; ++i)
+      std::copy(b.zones.begin() + i * b.capacity, b.zones.begin() + i * b.capacity + b.nodes.size(),
+                zones.begin() + i * capacity);
+    b.zones = std::move(zones);
+    b.capacity = capacity;
+  }
+
+  tchecker::collision_table_t<NODE_SPTR, NODE_SPTR_HASH> _nodes;           /*!< Set of nodes */
+  NODE_SPTR_HASH _node_hash;                                               /*!< Hash function on node pointers */
+  NODE_SPTR_LE _node_le;                                                   /*!< Covering predicate on node pointers */
+  bool _batched;                                                           /*!< Batched covering checks flag */
+  std::unordered_map<std::size_t, std::vector<bucket_t>> _buckets;         /*!< Buckets of nodes w.r.t. hash value */
+  mutable std::vector<tchecker::dbm::db_t> _dbm;                           /*!< Normalized zone of checked node */
+  mutable std::vector<std::uint64_t> _bits;                                /*!< Result of batched covering checks */
+};
+
+} // end of namespace cover
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SOA_COVER_GRAPH_HH
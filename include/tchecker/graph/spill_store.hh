@@ -0,0 +1,301 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_GRAPH_SPILL_STORE_HH
+#define TCHECKER_GRAPH_SPILL_STORE_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tchecker/graph/node.hh"
+#include "tchecker/utils/spill_file.hh"
+
+/*!
+ \file spill_store.hh
+ \brief Memory budget for passed nodes, with spilling of hash partitions to disk
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+/*!
+ \class spill_store_t
+ \brief Memory budget for the zones of passed nodes
+ \tparam NODE_SPTR : type of shared pointer to nodes of type derived from
+ tchecker::graph::node_compact_zg_state_t, that have a method hash(), and
+ that have been compacted in the pool of the spill store
+ \note Passed nodes are grouped in partitions w.r.t. their hash value, i.e. the
+ hash value used by the graph to find or cover nodes. Hence, all the nodes that
+ are compared with some node n belong to the partition of n. When the zones of
+ passed nodes in main memory exceed the memory limit, the least recently
+ accessed partitions are spilled to a memory-mapped file: the minimal zones
+ (see tchecker::graph::node_compact_zg_state_t) of the nodes in a partition are
+ copied to a region of the file, which is then paged out. The spilled regions of
+ a partition are paged back in when the partition is accessed.
+ Nodes keep pointers to their spilled zones, hence the file is also read back
+ on demand by the operating system if a spilled zone is accessed without
+ calling touch() first. As a consequence, nodes shall not access their zone
+ once the spill store has been destroyed.
+ Partitions keep their nodes until they are only referenced by the partition,
+ i.e. they have been removed from the graph. When a partition is spilled and at
+ least half of its spilled bytes belong to removed nodes, the zones of the
+ remaining nodes are moved to the new region of the partition, and the previous
+ regions are reclaimed by the file
+ */
+template <class NODE_SPTR> class spill_store_t {
+public:
+  /*!
+   \brief Constructor
+   \param pool : pool of the compact states of passed nodes
+   \param memory_limit : maximal number of bytes of zones of passed nodes in main memory
+   \param partitions : number of partitions
+   \param directory : directory of the spill file (see tchecker::spill_file_t)
+   \throw std::invalid_argument : if partitions is 0
+   \throw std::runtime_error : if the spill file cannot be created
+   \note this keeps a reference to pool, which shall outlive this spill store
+   */
+  spill_store_t(tchecker::graph::compact_state_pool_t & pool, std::size_t memory_limit, std::size_t partitions = 1024,
+                std::string const & directory = "")
+      : _pool(pool), _memory_limit(memory_limit), _resident_bytes(0), _tick(0), _file(directory)
+  {
+    if (partitions == 0)
+      throw std::invalid_argument("Spill store needs at least one partition");
+    _partitions.resize(partitions);
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  spill_store_t(tchecker::graph::spill_store_t<NODE_SPTR> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  spill_store_t(tchecker::graph::spill_store_t<NODE_SPTR> &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~spill_store_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::spill_store_t<NODE_SPTR> & operator=(tchecker::graph::spill_store_t<NODE_SPTR> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::spill_store_t<NODE_SPTR> & operator=(tchecker::graph::spill_store_t<NODE_SPTR> &&) = delete;
+
+  /*!
+   \brief Access to a partition
+   \param hash : hash value of a node
+   \post the partition of hash is the most recently accessed partition, and its
+   spilled regions are being paged in
+   */
+  void touch(std::size_t hash)
+  {
+    partition_t & p = _partitions[partition(hash)];
+    p.last_access = ++_tick;
+    if (p.in_core || p.regions.empty())
+      return;
+    for (auto && [region, size] : p.regions)
+      _file.page_in(region, size);
+    p.in_core = true;
+    _resident_bytes += p.region_bytes;
+  }
+
+  /*!
+   \brief Add a passed node
+   \param n : a node
+   \pre n is compact and not spilled (checked by assertion)
+   \post n has been added to its partition
+   */
+  void add(NODE_SPTR const & n)
+  {
+    assert(n->is_compact() && !n->is_spilled());
+    partition_t & p = _partitions[partition(n->hash())];
+    p.nodes.push_back(n);
+    p.heap_bytes += n->spill_size();
+    p.last_access = ++_tick;
+    _resident_bytes += n->spill_size();
+  }
+
+  /*!
+   \brief Remove a passed node
+   \param n : a node
+   \post the zone of n is not counted in main memory anymore, and n will not be spilled
+   \note n is dropped from its partition when it is only referenced by the partition
+   */
+  void remove(NODE_SPTR const & n)
+  {
+    if (!n->is_compact() || n->is_spilled())
+      return;
+    partition_t & p = _partitions[partition(n->hash())];
+    assert(p.heap_bytes >= n->spill_size());
+    p.heap_bytes -= n->spill_size();
+    _resident_bytes -= n->spill_size();
+  }
+
+  /*!
+   \brief Accessor
+   \return true if the zones of passed nodes in main memory exceed the memory limit, false otherwise
+   */
+  inline bool over_limit() const { return _resident_bytes > _memory_limit; }
+
+  /*!
+   \brief Spill the least recently accessed partitions
+   \post the least recently accessed partitions have been spilled until the zones in
+   main memory fit in half the memory limit: their nodes that were not spilled yet
+   have been spilled to the file, and their regions have been paged out. Nodes that
+   have been removed from the graph have been dropped from these partitions, and their
+   regions have been rewritten if at least half of their bytes belonged to such nodes
+   \throw std::runtime_error : if the spill file cannot be extended or written
+   */
+  void spill()
+  {
+    std::vector<std::size_t> victims = select_victims();
+    std::vector<bool> rewrite(victims.size(), false);
+
+    // Nodes that are only referenced by their partition have been removed from the graph
+    auto removed = [](NODE_SPTR const & n) { return n.refcount() == 1; };
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < victims.size(); ++i) {
+      partition_t & p = _partitions[victims[i]];
+      p.nodes.erase(std::remove_if(p.nodes.begin(), p.nodes.end(), removed), p.nodes.end());
+      for (NODE_SPTR const & n : p.nodes)
+        size += n->spill_size();
+
+      p.spilled.erase(std::remove_if(p.spilled.begin(), p.spilled.end(), removed), p.spilled.end());
+      std::size_t live_bytes = 0;
+      for (NODE_SPTR const & n : p.spilled)
+        live_bytes += n->spill_size();
+      if (p.region_bytes > 0 && 2 * live_bytes <= p.region_bytes) {
+        rewrite[i] = true;
+        size += live_bytes;
+      }
+    }
+
+    // Nodes are written partition by partition in a single region of the file
+    char * const region = (size > 0 ? static_cast<char *>(_file.allocate(size)) : nullptr);
+    char * ptr = region;
+    for (std::size_t i = 0; i < victims.size(); ++i) {
+      partition_t & p = _partitions[victims[i]];
+      char * const partition_region = ptr;
+      if (rewrite[i]) {
+        for (NODE_SPTR const & n : p.spilled) {
+          std::size_t const spill_size = n->spill_size();
+          n->spill(ptr, _pool); // moves the zone out of the previous regions
+          ptr += spill_size;
+        }
+        for (auto && [r, r_size] : p.regions)
+          _file.deallocate(r, r_size);
+        p.regions.clear();
+        p.region_bytes = 0;
+      }
+      for (NODE_SPTR const & n : p.nodes) {
+        std::size_t const spill_size = n->spill_size();
+        n->spill(ptr, _pool);
+        ptr += spill_size;
+        p.spilled.push_back(n);
+      }
+      p.nodes.clear();
+      std::size_t const partition_size = static_cast<std::size_t>(ptr - partition_region);
+      if (partition_size > 0) {
+        p.regions.emplace_back(partition_region, partition_size);
+        p.region_bytes += partition_size;
+      }
+      _resident_bytes -= p.heap_bytes;
+      p.heap_bytes = 0;
+    }
+    if (size > 0)
+      _file.page_out(region, size);
+  }
+
+  /*!
+   \brief Accessor
+   \return number of bytes of zones in the spill file
+   */
+  inline std::size_t spilled_bytes() const { return _file.size(); }
+
+private:
+  /*!
+   \brief Partition of passed nodes
+   */
+  struct partition_t {
+    std::vector<NODE_SPTR> nodes;                              /*!< Nodes with a zone on the heap */
+    std::vector<NODE_SPTR> spilled;                            /*!< Nodes with a spilled zone */
+    std::size_t heap_bytes = 0;                                /*!< Bytes of zones on the heap */
+    std::size_t region_bytes = 0;                              /*!< Bytes of spilled zones */
+    bool in_core = false;                                      /*!< Spilled regions have been paged in */
+    unsigned long last_access = 0;                             /*!< Time of last access */
+    std::vector<std::pair<void const *, std::size_t>> regions; /*!< Spilled regions */
+  };
+
+  /*!
+   \brief Accessor
+   \param hash : hash value of a node
+   \return partition of hash
+   */
+  inline std::size_t partition(std::size_t hash) const { return hash % _partitions.size(); }
+
+  /*!
+   \brief Select partitions to spill
+   \return the least recently accessed partitions, selected until the zones in main
+   memory fit in half the memory limit
+   \post the selected partitions that had been paged in have been paged out. The
+   zones on the heap of the selected partitions are still counted as resident
+   */
+  std::vector<std::size_t> select_victims()
+  {
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < _partitions.size(); ++i)
+      if (!_partitions[i].nodes.empty() || _partitions[i].in_core)
+        candidates.push_back(i);
+    std::sort(candidates.begin(), candidates.end(),
+              [&](std::size_t i, std::size_t j) { return _partitions[i].last_access < _partitions[j].last_access; });
+
+    std::vector<std::size_t> victims;
+    std::size_t resident = _resident_bytes;
+    for (std::size_t i : candidates) {
+      if (resident <= _memory_limit / 2)
+        break;
+      partition_t & p = _partitions[i];
+      victims.push_back(i);
+      resident -= p.heap_bytes;
+      if (p.in_core) {
+        // regions are already in the file: no need to write them again
+        for (auto && [region, size] : p.regions)
+          _file.page_out(region, size);
+        p.in_core = false;
+        resident -= p.region_bytes;
+        _resident_bytes -= p.region_bytes;
+      }
+    }
+    return victims;
+  }
+
+  tchecker::graph::compact_state_pool_t & _pool; /*!< Pool of compact states */
+  std::size_t _memory_limit;                     /*!< Memory limit */
+  std::size_t _resident_bytes;                   /*!< Bytes of zones in main memory */
+  unsigned long _tick;                           /*!< Access clock */
+  std::vector<partition_t> _partitions;          /*!< Partitions */
+  tchecker::spill_file_t _file;                  /*!< Spill file */
+};
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_GRAPH_SPILL_STORE_HH
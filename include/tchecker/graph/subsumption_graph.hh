@@ -13,13 +13,16 @@
  \brief Subsumption graph with node covering, and actual/subsumption edges
 */
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/graph/allocators.hh"
 #include "tchecker/graph/cover_graph.hh"
+#include "tchecker/graph/soa_cover_graph.hh"
 #include "tchecker/graph/directed_graph.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -35,7 +38,9 @@ namespace subsumption {
 // Forward declarations
 template <class NODE, class EDGE> class node_t;
 template <class NODE, class EDGE> class edge_t;
-template <class NODE, class EDGE, class NODE_HASH, class NODE_LE> class graph_t;
+template <class NODE, class EDGE, class NODE_HASH, class NODE_LE,
+          template <class, class, class> class COVER_GRAPH = tchecker::graph::cover::graph_t>
+class graph_t;
 
 /*!
  \brief Type of shared node
@@ -92,10 +97,23 @@ using const_edge_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::graph::subs
  */
 template <class NODE, class EDGE>
 class node_t : public NODE,
-               public tchecker::graph::cover::node_t,
+               public tchecker::graph::cover::soa_node_t,
                public tchecker::graph::directed::node_t<tchecker::graph::subsumption::edge_sptr_t<NODE, EDGE>> {
 public:
   using NODE::NODE;
+
+  /*!
+   \brief Accessor
+   \return signature of this node w.r.t. the covering predicate of its graph (see
+   tchecker::graph::subsumption::graph_t)
+   */
+  inline std::uint64_t signature() const { return _signature; }
+
+private:
+  template <class N, class E, class NODE_HASH, class NODE_LE, template <class, class, class> class COVER_GRAPH>
+  friend class tchecker::graph::subsumption::graph_t;
+
+  std::uint64_t _signature{0}; /*!< Signature */
 };
 
 /*!
@@ -127,7 +145,8 @@ public:
   }
 
 private:
-  template <class N, class E, class NODE_HASH, class NODE_LE> friend class tchecker::graph::subsumption::graph_t;
+  template <class N, class E, class NODE_HASH, class NODE_LE, template <class, class, class> class COVER_GRAPH>
+  friend class tchecker::graph::subsumption::graph_t;
 
   /*!
    \brief Accessor
@@ -198,12 +217,23 @@ namespace subsumption {
  of type NODE const &, and return the hash value of the node
  \tparam NODE_LE : covering predicate on nodes, should be callable with two
  parameters of type NODE const &, and return true is the first node is covered
- by the second one, false otherwise
+ by the second one, false otherwise. NODE_LE should also provide:
+ - bool comparable(NODE const & n1, NODE const & n2) : returns false if n1 cannot
+ be covered by n2 (e.g. distinct discrete parts), true otherwise
+ - std::uint64_t signature(NODE const & n) : returns a signature of n such that
+ tchecker::dbm::signature_le(signature(n1), signature(n2)) is true whenever n1 is
+ covered by n2. Covering checks of comparable nodes are rejected on signatures before
+ NODE_LE is called. Signatures are computed once, when nodes are added to the graph
+ \tparam COVER_GRAPH : type of graph with node covering that stores the nodes (see
+ tchecker::graph::cover::graph_t and tchecker::graph::cover::soa_graph_t). If
+ COVER_GRAPH checks covering over batches of nodes, NODE_LE should provide the
+ corresponding batch predicates on nodes (see tchecker::graph::cover::soa_graph_t)
  \note this graph allocates nodes of type
  tchecker::graph::subsumption::node_t<NODE, EDGE> and edges of type
  tchecker::graph::subsumption::edge_t<NODE, EDGE>
 */
-template <class NODE, class EDGE, class NODE_HASH, class NODE_LE> class graph_t {
+template <class NODE, class EDGE, class NODE_HASH, class NODE_LE, template <class, class, class> class COVER_GRAPH>
+class graph_t {
 private:
   // Forward declarations
   class node_sptr_hash_t;
@@ -280,12 +310,12 @@ public:
   /*!
   \brief Copy constructor (deleted)
   */
-  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> const &) = delete;
+  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, COVER_GRAPH> const &) = delete;
 
   /*!
   \brief Move constructor (deleted)
   */
-  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &&) = delete;
+  graph_t(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, COVER_GRAPH> &&) = delete;
 
   /*!
   \brief Destructor
@@ -295,14 +325,14 @@ public:
   /*!
   \brief Assignment operator (deleted)
   */
-  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> const &) = delete;
+  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, COVER_GRAPH> &
+  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, COVER_GRAPH> const &) = delete;
 
   /*!
   \brief Move-assignment operator (deleted)
   */
-  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &
-  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE> &&) = delete;
+  tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, COVER_GRAPH> &
+  operator=(tchecker::graph::subsumption::graph_t<NODE, EDGE, NODE_HASH, NODE_LE, COVER_GRAPH> &&) = delete;
 
   /*!
   \brief Clear the graph
@@ -324,6 +354,7 @@ public:
   template <class... ARGS> node_sptr_t add_node(ARGS &&... args)
   {
     node_sptr_t node = _node_pool.construct(args...);
+    node->_signature = _cover_graph.node_le().signature(node);
     _cover_graph.add_node(node);
     return node;
   }
@@ -347,17 +378,9 @@ public:
   }
 
   /*!
-   \brief Hook for seeding state information (no-op by default)
+   \brief Hook for nodes that have been expanded (no-op by default)
    */
-  template <class STATE> void seed_state(STATE const &) {}
-
-  /*!
-   \brief Hook for recording transitions (no-op by default)
-   */
-  template <class STATE, class TRANSITION>
-  void record_transition(STATE const &, STATE const &, TRANSITION const &)
-  {
-  }
+  void passed_node(node_sptr_t const &) {}
 
   /*!
    \brief Remove node
@@ -500,11 +523,29 @@ public:
    */
   inline std::size_t nodes_count() const { return _cover_graph.size(); }
 
+  /*!
+   \brief Accessor
+   \return Number of covering checks of comparable nodes
+   */
+  inline unsigned long signature_checks() const { return _cover_graph.node_le().signature_checks(); }
+
+  /*!
+   \brief Accessor
+   \return Number of covering checks of comparable nodes that have been rejected on signatures
+   */
+  inline unsigned long signature_rejections() const { return _cover_graph.node_le().signature_rejections(); }
+
+  /*!
+   \brief Accessor
+   \return Number of covering checks of comparable nodes that have passed signatures, and failed
+   */
+  inline unsigned long signature_misses() const { return _cover_graph.node_le().signature_misses(); }
+
   /*!
    \brief Type of iterator on nodes
   */
   using nodes_const_iterator_t =
-      typename tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t>::const_iterator_t;
+      typename COVER_GRAPH<node_sptr_t, node_sptr_hash_t, node_sptr_le_t>::const_iterator_t;
 
   /*!
    \brief Accessor
@@ -543,6 +584,12 @@ public:
   }
 
 protected:
+  /*!
+   \brief Accessor
+   \return graph with node covering that stores the nodes of this graph
+   */
+  inline COVER_GRAPH<node_sptr_t, node_sptr_hash_t, node_sptr_le_t> & cover_graph() { return _cover_graph; }
+
   /*!
    \brief Accessor to node attributes
    \param n : a node
@@ -612,17 +659,112 @@ private:
      \param n1 : a node
      \param n2 : a node
      \return true if *n1 is less-than-or-equal-to *n2 w.r.t. NODE_LE, false otherwise
+     \note NODE_LE is not called if *n1 and *n2 are not comparable, or if the signature of n1 is not
+     less-than-or-equal-to the signature of n2
+     */
+    inline bool operator()(node_sptr_t const & n1, node_sptr_t const & n2) const
+    {
+      if (!_node_le.comparable(*n1, *n2))
+        return false;
+      ++_signature_checks;
+      if (!tchecker::dbm::signature_le(n1->signature(), n2->signature())) {
+        ++_signature_rejections;
+        return false;
+      }
+      if (_node_le(*n1, *n2))
+        return true;
+      ++_signature_misses;
+      return false;
+    }
+
+    /*!
+     \brief Accessor
+     \param n : a node
+     \return signature of *n w.r.t. NODE_LE
+     */
+    inline std::uint64_t signature(node_sptr_t const & n) const { return _node_le.signature(*n); }
+
+    /*!
+     \brief Accessor
+     \return Number of covering checks of comparable nodes
+     */
+    inline unsigned long signature_checks() const { return _signature_checks; }
+
+    /*!
+     \brief Accessor
+     \return Number of covering checks of comparable nodes that have been rejected on signatures
+     */
+    inline unsigned long signature_rejections() const { return _signature_rejections; }
+
+    /*!
+     \brief Accessor
+     \return Number of covering checks of comparable nodes that have passed signatures, and failed
+     */
+    inline unsigned long signature_misses() const { return _signature_misses; }
+
+    /*!
+     \brief Comparability of shared pointers to nodes
+     \param n1 : a node
+     \param n2 : a node
+     \return true if *n1 and *n2 are comparable w.r.t. NODE_LE (see tchecker::graph::cover::soa_graph_t)
+     */
+    inline bool comparable(node_sptr_t const & n1, node_sptr_t const & n2) const
+    {
+      return _node_le.comparable(*n1, *n2);
+    }
+
+    /*!
+     \brief Accessor
+     \param n : a node
+     \return dimension of the zone of *n w.r.t. NODE_LE
+     */
+    inline tchecker::clock_id_t dim(node_sptr_t const & n) const { return _node_le.dim(*n); }
+
+    /*!
+     \brief Normalized zone of shared pointers to nodes
+     \param n : a node
+     \param dbm : a DBM
+     \post dbm is the normalized zone of *n w.r.t. NODE_LE
+     \return false if the normalized zone of *n is empty, true otherwise
+     */
+    inline bool normalize(node_sptr_t const & n, tchecker::dbm::db_t * dbm) const
+    {
+      return _node_le.normalize(*n, dbm);
+    }
+
+    /*!
+     \brief Covering predicate of a shared pointer to node w.r.t. a batch of nodes
+     \note see tchecker::graph::cover::soa_graph_t
+     */
+    inline void is_le_batch(node_sptr_t const & n, tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch,
+                            std::size_t stride, std::size_t count, tchecker::clock_id_t dim,
+                            std::uint64_t * le) const
+    {
+      _node_le.is_le_batch(*n, dbm, batch, stride, count, dim, le);
+    }
+
+    /*!
+     \brief Covering predicate of a batch of nodes w.r.t. a shared pointer to node
+     \note see tchecker::graph::cover::soa_graph_t
      */
-    inline bool operator()(node_sptr_t const & n1, node_sptr_t const & n2) const { return _node_le(*n1, *n2); }
+    inline void is_ge_batch(node_sptr_t const & n, tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch,
+                            std::size_t stride, std::size_t count, tchecker::clock_id_t dim,
+                            std::uint64_t * ge) const
+    {
+      _node_le.is_ge_batch(*n, dbm, batch, stride, count, dim, ge);
+    }
 
   private:
-    NODE_LE _node_le; /*!< Covering predicate on nodes */
+    NODE_LE _node_le;                               /*!< Covering predicate on nodes */
+    mutable unsigned long _signature_checks{0};     /*!< Number of covering checks of comparable nodes */
+    mutable unsigned long _signature_rejections{0}; /*!< Number of covering checks rejected on signatures */
+    mutable unsigned long _signature_misses{0};     /*!< Number of failed covering checks not rejected on signatures */
   };
 
-  tchecker::graph::cover::graph_t<node_sptr_t, node_sptr_hash_t, node_sptr_le_t> _cover_graph; /*!< Node store with covering */
-  tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph;                /*!< Edge store */
-  tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;                            /*!< Node pool allocator */
-  tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;                            /*!< Edge pool allocator */
+  COVER_GRAPH<node_sptr_t, node_sptr_hash_t, node_sptr_le_t> _cover_graph;      /*!< Node store with covering */
+  tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph; /*!< Edge store */
+  tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;             /*!< Node pool allocator */
+  tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;             /*!< Edge pool allocator */
 };
 
 /* output */
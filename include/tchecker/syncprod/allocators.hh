@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include "tchecker/syncprod/state.hh"
 #include "tchecker/syncprod/transition.hh"
@@ -156,14 +157,27 @@ public:
    \pre p has been constructed by this allocator
    \pre p is not nullptr
    \post the tuple of locations in the state pointed by p has been shared with
-   other states
+   other states. It has been given the next identifier if it is a new tuple of
+   locations (identifiers are dense and never reused, shared tuples of locations
+   are kept until all states are destructed)
   */
   void share(tchecker::intrusive_shared_ptr_t<STATE> const & p)
   {
     tchecker::ts::state_pool_allocator_t<STATE>::share(p);
     p->vloc_ptr() = _vloc_cache->find_else_add(p->vloc_ptr());
+    if (p->vloc_ptr()->id() == tchecker::NO_VLOC_ID) {
+      p->vloc_ptr()->id(static_cast<tchecker::vloc_id_t>(_vlocs.size()));
+      _vlocs.push_back(p->vloc_ptr());
+    }
   }
 
+  /*!
+   \brief Accessor
+   \return Number of shared tuples of locations, identifiers of shared tuples of locations range from 0 to this
+   number (excluded)
+   */
+  inline std::size_t vlocs_count() const { return _vlocs.size(); }
+
   /*!
    \brief Collect unused states
    \post Unused states and unused tuples of locations have been collected
@@ -183,6 +197,7 @@ public:
   void destruct_all()
   {
     tchecker::ts::state_pool_allocator_t<STATE>::destruct_all();
+    _vlocs.clear();
     _vloc_cache->clear();
     _vloc_pool.destruct_all();
   }
@@ -208,6 +223,7 @@ protected:
   std::size_t _vloc_capacity;                           /*!< Capacity of tuples of locations */
   tchecker::pool_t<tchecker::shared_vloc_t> _vloc_pool; /*!< Pool of tuples of locations */
   std::shared_ptr<vloc_cache_t> _vloc_cache;            /*!< Cache of tuples of locations */
+  std::vector<tchecker::vloc_sptr_t> _vlocs;            /*!< Shared tuples of locations indexed by identifier */
 };
 
 /*!
@@ -9,6 +9,7 @@
 #define TCHECKER_SYNCPROD_EDGES_ITERATORS_HH
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include <boost/iterator/transform_iterator.hpp>
@@ -72,6 +73,30 @@ tchecker::range_t<tchecker::syncprod::vloc_asynchronous_edges_iterator_t, tcheck
 incoming_asynchronous_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
 
+/* Synchronizations from a tuple of locations */
+
+/*!
+ \brief Accessor to synchronizations enabled from a tuple of locations
+ \param system : a system
+ \param vloc : a tuple of locations
+ \return identifiers of the synchronizations that are enabled from vloc in system, by increasing identifiers
+ \note a synchronization is enabled if every process strongly involved in the synchronization has an outgoing
+ edge labelled by its event, and at least one involved process has such an edge. Candidate synchronizations are
+ obtained from tchecker::syncprod::system_t::outgoing_synchronizations
+ */
+std::vector<tchecker::sync_id_t> outgoing_synchronizations(tchecker::syncprod::system_t const & system,
+                                                           tchecker::vloc_t const & vloc);
+
+/*!
+ \brief Accessor to synchronizations enabled to a tuple of locations
+ \param system : a system
+ \param vloc : a tuple of locations
+ \return identifiers of the synchronizations that are enabled to vloc in system (i.e. w.r.t. incoming edges),
+ by increasing identifiers
+ */
+std::vector<tchecker::sync_id_t> incoming_synchronizations(tchecker::syncprod::system_t const & system,
+                                                           tchecker::vloc_t const & vloc);
+
 /* Iterator over collection of synchronized edges from a tuple of locations */
 
 /*!
@@ -84,13 +109,31 @@ public:
    \brief Constructor
    \param vloc : tuple of locations
    \param loc_edges_maps : maps loc id -> edges/events
-   \param sync_begin : iterator on first synchronization
-   \param sync_end : past-the-end iterator on synchronizations
+   \param syncs : range of synchronizations, starting from synchronization with identifier 0
+   \post this iterates over the synchronized edges that are instances of the synchronizations in syncs that are
+   enabled from vloc w.r.t. loc_edges_maps, by increasing identifiers
+   \note synchronizations are checked on the fly, nothing is allocated
    */
   vloc_synchronized_edges_iterator_t(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
                                      std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
-                                     tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
-                                     tchecker::system::synchronizations_t::const_iterator_t const & sync_end);
+                                     tchecker::range_t<tchecker::system::synchronizations_t::const_iterator_t> const & syncs);
+
+  /*!
+   \brief Constructor
+   \param vloc : tuple of locations
+   \param loc_edges_maps : maps loc id -> edges/events
+   \param syncs : iterator on synchronization with identifier 0
+   \param sync_ids : identifiers of synchronizations
+   \pre all synchronizations in sync_ids are enabled from vloc w.r.t. loc_edges_maps (see
+   tchecker::syncprod::outgoing_synchronizations), and sync_ids outlives this iterator and its copies (e.g.
+   sync_ids is memoized in vloc)
+   \post this iterates over the synchronized edges that are instances of the synchronizations in sync_ids,
+   in the order of sync_ids
+   */
+  vloc_synchronized_edges_iterator_t(tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
+                                     std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
+                                     tchecker::system::synchronizations_t::const_iterator_t const & syncs,
+                                     std::vector<tchecker::sync_id_t> const & sync_ids);
 
   /*!
    \brief Copy constructor
@@ -123,7 +166,8 @@ public:
    \brief Equality check
    \param it : synchronized edges iterator
    \return true if this and it are equal, false otherwise
-   \note equality relies on the fact that this and it reference the same loc_edges_maps
+   \note equality relies on the fact that this and it reference the same loc_edges_maps and the same
+   collection of synchronization identifiers
    */
   bool operator==(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const;
 
@@ -174,7 +218,7 @@ public:
   inline sync_edges_t operator*()
   {
     assert(!at_end());
-    return sync_edges_t{.sync_id = _sync_it->id(), .edges = _cartesian_it.operator*()};
+    return sync_edges_t{.sync_id = sync_id(), .edges = _cartesian_it.operator*()};
   }
 
   /*!
@@ -191,20 +235,34 @@ protected:
   \brief Fast end-of-range check
   \return true if this is past-the-end, false otherwise
   */
-  inline bool at_end() const { return (_sync_it == _sync_end); }
+  inline bool at_end() const { return (_sync_pos == _sync_end); }
+
+  /*!
+   \brief Accessor
+   \pre not at_end() (checked by assertion)
+   \return identifier of current synchronization
+   */
+  inline tchecker::sync_id_t sync_id() const
+  {
+    assert(!at_end());
+    return static_cast<tchecker::sync_id_t>(_sync_ids == nullptr ? _sync_pos : (*_sync_ids)[_sync_pos]);
+  }
 
   /*!
    \brief Fills cartesian product
    \post either this range is at_end(), or _cartesian_it has been filled with ranges of edges corresponding to
-   synchronzation pointed by _sync_it
+   current synchronization. Synchronizations that are not enabled are skipped if _sync_ids is nullptr
    */
-  void advance_while_empty_cartesian_product();
+  void fill_cartesian_product();
 
   tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> _vloc; /*!< Vector of locations */
   /*!< Maps loc id -> edges/events */
   std::shared_ptr<tchecker::system::loc_edges_maps_t const> _loc_edges_maps;
-  tchecker::system::synchronizations_t::const_iterator_t _sync_it;  /*!< Iterator on synchronizations */
-  tchecker::system::synchronizations_t::const_iterator_t _sync_end; /*!< Past-the-end iterator on synchronizations */
+  tchecker::system::synchronizations_t::const_iterator_t _syncs; /*!< Iterator on synchronization 0 */
+  /*!< Identifiers of synchronizations, nullptr if all synchronizations are checked on the fly */
+  std::vector<tchecker::sync_id_t> const * _sync_ids;
+  std::size_t _sync_pos; /*!< Position in _sync_ids, or synchronization identifier if _sync_ids is nullptr */
+  std::size_t _sync_end; /*!< Past-the-end position */
   /*!< Cartesian iterator */
   tchecker::cartesian_iterator_t<tchecker::range_t<tchecker::system::edges_collection_const_iterator_t>> _cartesian_it;
 };
@@ -214,16 +272,33 @@ protected:
  \param system : a system
  \param vloc : a tuple of locations
  \return range of outgoing synchronized edges from vloc in system
+ \note synchronizations are checked on the fly
  */
 tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t>
 outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
 
+/*!
+ \brief Accessor to outgoing synchronized edges from a tuple of locations
+ \param system : a system
+ \param vloc : a tuple of locations
+ \param sync_ids : identifiers of synchronizations
+ \pre all synchronizations in sync_ids are enabled from vloc (see tchecker::syncprod::outgoing_synchronizations),
+ and sync_ids outlives the returned range and its iterators
+ \return range of outgoing synchronized edges from vloc in system that are instances of synchronizations in
+ sync_ids
+ */
+tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t>
+outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
+                            tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
+                            std::vector<tchecker::sync_id_t> const & sync_ids);
+
 /*!
  \brief Accessor to incoming synchronized edges to a tuple of locations
  \param system : a system
  \param vloc : a tuple of locations
  \return range of incoming synchronized edges to vloc in system
+ \note synchronizations are checked on the fly
  */
 tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t>
 incoming_synchronized_edges(tchecker::syncprod::system_t const & system,
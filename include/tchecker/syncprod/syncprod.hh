@@ -9,6 +9,8 @@
 #define TCHECKER_SYNCPROD_SYNCPROD_HH
 
 #include <cstdlib>
+#include <memory>
+#include <vector>
 
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 #include <boost/iterator/filter_iterator.hpp>
@@ -254,6 +256,40 @@ inline tchecker::state_status_t final(tchecker::syncprod::system_t const & syste
   return tchecker::syncprod::final(system, s.vloc_ptr(), t.vedge_ptr(), t.sync_id(), v);
 }
 
+/* Enabled synchronizations */
+
+/*!
+ \struct enabled_synchronizations_t
+ \brief Synchronizations that can be taken from a tuple of locations
+ */
+struct enabled_synchronizations_t {
+  std::vector<tchecker::sync_id_t> synchronizations; /*!< Identifiers of enabled synchronizations, by increasing identifiers */
+  boost::dynamic_bitset<> committed_processes;       /*!< Map : PID -> committed flag */
+};
+
+/*!
+ \brief Compute synchronizations that can be taken from a tuple of locations
+ \param system : a system
+ \param vloc : tuple of locations
+ \return the set of committed processes in vloc, and the synchronizations enabled from vloc in system (see
+ tchecker::syncprod::outgoing_synchronizations) that involve a committed process if some process is committed
+ */
+tchecker::syncprod::enabled_synchronizations_t compute_enabled_synchronizations(tchecker::syncprod::system_t const & system,
+                                                                                tchecker::const_vloc_sptr_t const & vloc);
+
+/*!
+ \brief Accessor to synchronizations that can be taken from a shared tuple of locations
+ \param system : a system
+ \param vloc : tuple of locations
+ \pre vloc has been shared (see tchecker::vloc_base_t)
+ \return see tchecker::syncprod::compute_enabled_synchronizations
+ \throw std::invalid_argument : if vloc has not been shared
+ \note the result is computed by the first call and memoized in vloc, it lives as long as vloc. Hence, a shared
+ tuple of locations should only be used with one system. Concurrent calls from several threads are safe
+ */
+tchecker::syncprod::enabled_synchronizations_t const & enabled_synchronizations(tchecker::syncprod::system_t const & system,
+                                                                              tchecker::const_vloc_sptr_t const & vloc);
+
 /* Outgoing edges */
 
 /*!
@@ -261,6 +297,9 @@ inline tchecker::state_status_t final(tchecker::syncprod::system_t const & syste
 \brief Outgoing edges iterator taking committed processes into account. Iterates
 over the outgoing edges that involve a committed process (if any), or over all
 outgoing edges if no process is committed
+\note synchronized edges can be filtered upstream (see
+tchecker::syncprod::enabled_synchronizations), then only asynchronous edges are
+filtered by this iterator
 */
 class outgoing_edges_iterator_t {
 public:
@@ -269,17 +308,24 @@ public:
   \param sync_it : iterator over synchronized edges
   \param async_it : iterator over asynchronous edges
   \param committed_procs : set of committed processes
+  \param sync_filtered : whether synchronized edges have been filtered upstream
+  \pre if sync_filtered, all synchronized edges from sync_it involve a process in committed_procs if committed_procs
+  is not empty
   */
   outgoing_edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & sync_it,
                             tchecker::syncprod::vloc_asynchronous_edges_iterator_t const & async_it,
-                            boost::dynamic_bitset<> committed_processes);
+                            boost::dynamic_bitset<> committed_processes, bool sync_filtered = false);
 
   /*!
   \brief Constructor
   \param it : vloc edges iterator
   \param committed_procs : set of committed processes
+  \param sync_filtered : whether synchronized edges have been filtered upstream
+  \pre if sync_filtered, all synchronized edges from it involve a process in committed_procs if committed_procs is
+  not empty
   */
-  outgoing_edges_iterator_t(tchecker::syncprod::vloc_edges_iterator_t const & it, boost::dynamic_bitset<> committed_processes);
+  outgoing_edges_iterator_t(tchecker::syncprod::vloc_edges_iterator_t const & it, boost::dynamic_bitset<> committed_processes,
+                            bool sync_filtered = false);
 
   /*!
   \brief Copy constructor
@@ -381,6 +427,7 @@ private:
   tchecker::syncprod::vloc_edges_iterator_t _it; /*!< Underlying vloc edges iterator */
   boost::dynamic_bitset<> _committed_processes;  /*!< Map : PID -> committed flag */
   bool _committed;                               /*!< Flag : whether _committed_procs has a committed process or not */
+  bool _sync_filtered;                           /*!< Flag : whether synchronized edges have been filtered upstream */
 };
 
 /*!
@@ -230,6 +230,29 @@ public:
   using tchecker::system::system_t::synchronizations_count;
   using tchecker::system::system_t::synchronizations_identifiers;
 
+  /*!
+   \brief Type of collection of synchronization identifiers
+   */
+  using synchronizations_ids_t = std::vector<tchecker::sync_id_t>;
+
+  /*!
+   \brief Accessor
+   \param loc : location identifier
+   \return identifiers of synchronizations with a constraint (P,e) where P is the process of loc, and loc has an
+   outgoing edge labelled by e, by increasing identifiers
+   \note a synchronization is enabled from a tuple of locations only if it appears in the collection of one of
+   its locations
+   */
+  synchronizations_ids_t const & outgoing_synchronizations(tchecker::loc_id_t loc) const;
+
+  /*!
+   \brief Accessor
+   \param loc : location identifier
+   \return identifiers of synchronizations with a constraint (P,e) where P is the process of loc, and loc has an
+   incoming edge labelled by e, by increasing identifiers
+   */
+  synchronizations_ids_t const & incoming_synchronizations(tchecker::loc_id_t loc) const;
+
   // Cast
 
   /*!
@@ -266,6 +289,12 @@ private:
    */
   void compute_labels();
 
+  /*!
+   \brief Compute index of synchronizations w.r.t. locations
+   \post _outgoing_syncs and _incoming_syncs map each location to the synchronizations it can take part in
+   */
+  void compute_synchronizations_index();
+
   /*!
    \brief Add asynchronous edge
    \param edge : an edge
@@ -288,6 +317,9 @@ private:
   static asynchronous_edges_collection_t const _empty_async_edges;    /*!< Empty collection of asynchronous edges */
   boost::dynamic_bitset<> _committed;                                 /*!< Committed locations */
   std::vector<boost::dynamic_bitset<>> _labels;                       /*!< Map: location identifier -> labels */
+  std::vector<synchronizations_ids_t> _outgoing_syncs;                /*!< Map: loc id -> outgoing synchronizations */
+  std::vector<synchronizations_ids_t> _incoming_syncs;                /*!< Map: loc id -> incoming synchronizations */
+  static synchronizations_ids_t const _empty_syncs;                   /*!< Empty collection of synchronizations */
 };
 
 /*!
@@ -8,7 +8,10 @@
 #ifndef TCHECKER_VLOC_HH
 #define TCHECKER_VLOC_HH
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/system/system.hh"
@@ -24,14 +27,111 @@
 
 namespace tchecker {
 
+namespace syncprod {
+
+struct enabled_synchronizations_t; // see tchecker/syncprod/syncprod.hh
+
+} // end of namespace syncprod
+
+/*!
+ \brief Type of identifiers of shared tuples of locations
+ */
+using vloc_id_t = uint32_t;
+
+/*!
+ \brief Identifier of tuples of locations that have not been shared
+ */
+extern tchecker::vloc_id_t const NO_VLOC_ID;
+
 /*!
  \class vloc_base_t
  \brief Base class for tuple of locations that extends array capacity with
- cache object
+ cache object, and identifier of shared tuples of locations
+ \note the identifier does not take part in equality and hash value: it is
+ set once the tuple of locations has been shared (see
+ tchecker::syncprod::details::state_pool_allocator_t::share), and copies of a
+ tuple of locations have no identifier
+ \note shared tuples of locations memoize the synchronizations that are enabled
+ from them (see tchecker::syncprod::enabled_synchronizations). Copies of a tuple of
+ locations have no memoized synchronizations
 */
 class vloc_base_t : public tchecker::array_capacity_t<unsigned int>, public tchecker::cached_object_t {
 public:
-  using tchecker::array_capacity_t<unsigned int>::array_capacity_t;
+  /*!
+   \brief Constructor
+   \param capacity : array capacity
+   */
+  vloc_base_t(unsigned int capacity)
+      : tchecker::array_capacity_t<unsigned int>(capacity), _id(tchecker::NO_VLOC_ID), _enabled_syncs(nullptr)
+  {
+  }
+
+  /*!
+   \brief Copy constructor
+   \param b : base
+   \post this has the capacity of b, no identifier and no memoized synchronizations
+   */
+  vloc_base_t(tchecker::vloc_base_t const & b)
+      : tchecker::array_capacity_t<unsigned int>(b), tchecker::cached_object_t(b), _id(tchecker::NO_VLOC_ID),
+        _enabled_syncs(nullptr)
+  {
+  }
+
+  /*!
+   \brief Destructor
+   \post memoized synchronizations have been deleted
+   */
+  ~vloc_base_t();
+
+  /*!
+   \brief Assignment operator
+   \param b : base
+   \post this has the capacity of b, no identifier and no memoized synchronizations
+   \return this after assignment
+   */
+  tchecker::vloc_base_t & operator=(tchecker::vloc_base_t const & b);
+
+  /*!
+   \brief Accessor
+   \return identifier of this tuple of locations, tchecker::NO_VLOC_ID if it
+   has not been shared
+   */
+  inline constexpr tchecker::vloc_id_t id() const { return _id; }
+
+  /*!
+   \brief Set identifier
+   \param id : identifier
+   \post this tuple of locations has identifier id
+   \note should only be called when this tuple of locations is shared
+   */
+  inline void id(tchecker::vloc_id_t id) { _id = id; }
+
+  /*!
+   \brief Accessor
+   \return memoized synchronizations enabled from this tuple of locations, nullptr if none
+   */
+  inline tchecker::syncprod::enabled_synchronizations_t const * enabled_synchronizations() const
+  {
+    return _enabled_syncs.load(std::memory_order_acquire);
+  }
+
+  /*!
+   \brief Memoize enabled synchronizations
+   \param syncs : synchronizations enabled from this tuple of locations
+   \pre syncs has been allocated by new, and is not nullptr
+   \post this tuple of locations owns syncs if it had no memoized synchronizations, and syncs has been deleted
+   otherwise
+   \return the synchronizations memoized in this tuple of locations
+   \note should only be called when this tuple of locations is shared, as shared tuples of locations are never
+   modified. Several threads can memoize concurrently: the first memoized synchronizations are kept
+   */
+  tchecker::syncprod::enabled_synchronizations_t const *
+  enabled_synchronizations(tchecker::syncprod::enabled_synchronizations_t const * syncs) const;
+
+private:
+  tchecker::vloc_id_t _id; /*!< Identifier */
+  /*!< Memoized enabled synchronizations (owned) */
+  mutable std::atomic<tchecker::syncprod::enabled_synchronizations_t const *> _enabled_syncs;
 };
 
 /*!
@@ -203,6 +303,114 @@ using vloc_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t>;
 */
 using const_vloc_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const>;
 
+/*!
+ \class vloc_table_t
+ \brief Side table of values attached to shared tuples of locations, indexed by
+ their identifiers
+ \tparam T : type of values, should be default constructible
+ \note lookups are array accesses. Tuples of locations that have not been shared
+ have no identifier, hence no value in the table. Identifiers are only unique
+ w.r.t. the allocator that has shared the tuples of locations: a table should
+ only be used with tuples of locations from the same allocator
+ */
+template <class T> class vloc_table_t {
+public:
+  /*!
+   \brief Accessor
+   \param id : identifier of tuple of locations
+   \return pointer to the value of identifier id in this table, nullptr if none
+   */
+  inline T * find(tchecker::vloc_id_t id) { return (id < _defined.size() && _defined[id] ? &_values[id] : nullptr); }
+
+  /*!
+   \brief Accessor
+   \param id : identifier of tuple of locations
+   \return pointer to the value of identifier id in this table, nullptr if none
+   */
+  inline T const * find(tchecker::vloc_id_t id) const
+  {
+    return (id < _defined.size() && _defined[id] ? &_values[id] : nullptr);
+  }
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return pointer to the value of vloc in this table, nullptr if none
+   */
+  inline T * find(tchecker::vloc_t const & vloc) { return find(vloc.id()); }
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return pointer to the value of vloc in this table, nullptr if none
+   */
+  inline T const * find(tchecker::vloc_t const & vloc) const { return find(vloc.id()); }
+
+  /*!
+   \brief Insertion
+   \param id : identifier of tuple of locations
+   \param value : a value
+   \pre id is not tchecker::NO_VLOC_ID (checked by assertion)
+   \post value is the value of identifier id in this table
+   \return reference to the value of identifier id in this table
+   \note the table grows up to id, references to values are invalidated when
+   the table grows
+   */
+  T & insert(tchecker::vloc_id_t id, T const & value)
+  {
+    assert(id != tchecker::NO_VLOC_ID);
+    if (id >= _defined.size())
+      reserve(std::max(static_cast<std::size_t>(id) + 1, 2 * _defined.size()));
+    _values[id] = value;
+    _defined[id] = true;
+    return _values[id];
+  }
+
+  /*!
+   \brief Insertion
+   \param vloc : tuple of locations
+   \param value : a value
+   \pre vloc has been shared (checked by assertion)
+   \post value is the value of vloc in this table
+   \return reference to the value of vloc in this table
+   \note references to values are invalidated when the table grows
+   */
+  inline T & insert(tchecker::vloc_t const & vloc, T const & value) { return insert(vloc.id(), value); }
+
+  /*!
+   \brief Reserve
+   \param n : number of identifiers
+   \post this table can hold values for identifiers 0 to n-1 without growing
+   */
+  void reserve(std::size_t n)
+  {
+    if (n > _defined.size()) {
+      _values.resize(n);
+      _defined.resize(n, false);
+    }
+  }
+
+  /*!
+   \brief Clear
+   \post this table is empty
+   */
+  void clear()
+  {
+    _values.clear();
+    _defined.clear();
+  }
+
+  /*!
+   \brief Accessor
+   \return number of identifiers that can be stored in this table without growing
+   */
+  inline std::size_t capacity() const { return _defined.size(); }
+
+private:
+  std::vector<T> _values;     /*!< Values indexed by identifiers */
+  std::vector<bool> _defined; /*!< Identifiers with a value */
+};
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_VLOC_HH
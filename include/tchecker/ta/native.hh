@@ -0,0 +1,126 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_NATIVE_HH
+#define TCHECKER_TA_NATIVE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "tchecker/vm/native.hh"
+
+/*!
+ \file native.hh
+ \brief Native compilation of the bytecode of timed automata
+ \note a system is compiled ahead of time to a C++ source file (see tchecker::ta::compile_native and tool
+ tck-compile) that is built as a shared object. Once loaded, its native model is registered (see
+ tchecker::ta::set_native_model), and installed in the systems that are built afterwards: their guards, statements
+ and invariants are then evaluated by native code instead of the bytecode interpreter
+ \note only bytecode is compiled: successors are computed by the transition systems of TChecker (e.g.
+ tchecker::zg::zg_t), which are not specialized to the system
+ */
+
+/*!
+ \brief Name of the function returning the native model in a shared object
+ */
+#define TCHECKER_NATIVE_MODEL_SYMBOL "tchecker_native_model"
+
+namespace tchecker {
+
+namespace ta {
+
+class system_t;
+
+/*!
+ \brief Version of native models. Should be incremented when the layout of tchecker::ta::native_model_t, or the
+ signature of tchecker::native_bytecode_t, changes
+ */
+constexpr unsigned int const NATIVE_MODEL_VERSION = 1;
+
+/*!
+ \brief Native model: natively compiled guards, statements and invariants of a system
+ \note arrays invariants, guards and statements have locations_count, edges_count and edges_count entries,
+ indexed by location and edge identifiers in the system. A nullptr entry denotes bytecode that has not been compiled
+ */
+struct native_model_t {
+  unsigned int version;                           /*!< Version (see tchecker::ta::NATIVE_MODEL_VERSION) */
+  char const * name;                              /*!< Name of the system */
+  std::uint64_t fingerprint;                      /*!< Fingerprint of the system (see tchecker::ta::fingerprint) */
+  std::size_t processes_count;                    /*!< Number of processes */
+  std::size_t clocks_count;                       /*!< Number of flattened clocks */
+  std::size_t intvars_count;                      /*!< Number of flattened integer variables */
+  std::size_t locations_count;                    /*!< Number of locations */
+  std::size_t edges_count;                        /*!< Number of edges */
+  tchecker::native_bytecode_t const * invariants; /*!< Native invariants */
+  tchecker::native_bytecode_t const * guards;     /*!< Native guards */
+  tchecker::native_bytecode_t const * statements; /*!< Native statements */
+};
+
+/*!
+ \brief Type of the function returning the native model in a shared object (see TCHECKER_NATIVE_MODEL_SYMBOL)
+ */
+using native_model_function_t = tchecker::ta::native_model_t const * (*)();
+
+/*!
+ \brief System fingerprint
+ \param system : a system
+ \return a hash of the sizes of system, and of the bytecode of its guards, statements and invariants
+ */
+std::uint64_t fingerprint(tchecker::ta::system_t const & system);
+
+/*!
+ \brief Compatibility check
+ \param system : a system
+ \param model : a native model
+ \return true if model has been compiled from a system with the same variables, locations, edges and bytecode as
+ system, false otherwise
+ */
+bool native_compatible(tchecker::ta::system_t const & system, tchecker::ta::native_model_t const & model);
+
+/*!
+ \brief Native compilation
+ \param os : output stream
+ \param system : a system
+ \post a C++ source file has been output to os. It defines a native model of system, returned by function
+ TCHECKER_NATIVE_MODEL_SYMBOL with C linkage (see tchecker::ta::native_model_function_t)
+ \note guards, statements and invariants with local variables are not compiled (see tchecker::compile_native).
+ Identical bytecode is compiled once
+ */
+void compile_native(std::ostream & os, tchecker::ta::system_t const & system);
+
+/*!
+ \brief Register a native model
+ \param model : a native model (nullptr to unregister)
+ \pre model is not deleted before it is unregistered
+ \post model is installed in all systems built from now on that are compatible with it (see
+ tchecker::ta::native_compatible)
+ \note not thread-safe: the native model should be registered before systems are built
+ */
+void set_native_model(tchecker::ta::native_model_t const * model);
+
+/*!
+ \brief Accessor
+ \return registered native model, nullptr if none
+ */
+tchecker::ta::native_model_t const * native_model();
+
+/*!
+ \brief Install a native model
+ \param system : a system
+ \param model : a native model
+ \pre native_compatible(system, model) (checked by assertion)
+ \post the memoized guards, statements and invariants of system are interpreted by the native code in model
+ (see tchecker::memoized_bytecode_t::set_native)
+ */
+void install_native_model(tchecker::ta::system_t const & system, tchecker::ta::native_model_t const & model);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_NATIVE_HH
@@ -8,7 +8,12 @@
 #ifndef TCHECKER_TA_STATIC_ANALYSIS_HH
 #define TCHECKER_TA_STATIC_ANALYSIS_HH
 
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
+#include "tchecker/expression/typed_expression.hh"
+#include "tchecker/statement/typed_statement.hh"
 #include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
 
 /*!
  \file static_analysis.hh
@@ -33,6 +38,17 @@ bool has_guarded_weakly_synchronized_event(tchecker::ta::system_t const & system
  */
 bool has_diagonal_constraint(tchecker::ta::system_t const & system);
 
+/*!
+ \brief Computes the clocks involved in diagonal clock constraints
+ \param system : a system of timed processes
+ \return the set of flattened clock IDs of system (as a bitset) that contains the clocks x and y of every diagonal
+ constraint x - y # c in a guard or a location invariant, and that contains clock y for every update x := y + c of a
+ clock x in the set
+ \note the other clocks are diagonal-free: their values are never compared to the values of the clocks in the set.
+ If the clock updates of a statement cannot be computed, all the clocks in the system are returned
+ */
+boost::dynamic_bitset<> diagonal_clocks(tchecker::ta::system_t const & system);
+
 /*!
  \brief Checks if a system has a non-constant clock reset
  \param system : a system of timed processes
@@ -53,6 +69,33 @@ bool has_non_constant_reset(tchecker::ta::system_t const & system);
  */
 bool has_shared_clocks(tchecker::ta::system_t const & system);
 
+/*!
+ \brief Computes the clock constraints of an expression that do not depend on integer variables
+ \param expr : a guard or a location invariant
+ \param c : a container of clock constraints
+ \post the clock constraints of the conjuncts of expr that read clocks and no integer variable have been pushed
+ to c
+ \note every clock valuation that satisfies expr, for some valuation of the integer variables, satisfies the clock
+ constraints pushed to c. The clock constraints in conjuncts that read integer variables are ignored
+ */
+void intval_independent_clock_constraints(tchecker::typed_expression_t const & expr,
+                                          tchecker::clock_constraint_container_t & c);
+
+/*!
+ \brief Computes the clock resets of a statement that do not depend on integer variables
+ \param clock_nb : number of clocks
+ \param stmt : a statement
+ \param r : a container of clock resets
+ \pre every clock identifier in stmt is less than clock_nb
+ \return true if stmt updates every clock x it modifies to y + c, where y is either the reference clock or a clock
+ that is not modified by stmt, and c is a constant, whatever the values of the integer variables, false otherwise
+ \post if true is returned, a reset x := y + c has been pushed to r for every clock x modified by stmt, by
+ increasing clock identifiers. Otherwise, r is unchanged
+ \throw std::invalid_argument : if some clock identifier in stmt is bigger than or equal to clock_nb
+ */
+bool intval_independent_clock_resets(std::size_t clock_nb, tchecker::typed_statement_t const & stmt,
+                                     tchecker::clock_reset_container_t & r);
+
 } // end of namespace ta
 
 } // end of namespace tchecker
@@ -22,6 +22,7 @@
 #include "tchecker/system/attribute.hh"
 #include "tchecker/system/system.hh"
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/vm/memoized_bytecode.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -137,6 +138,16 @@ public:
    */
   tchecker::bytecode_t const * guard_bytecode(tchecker::edge_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return memoized guard bytecode for edge id
+   \note running the returned bytecode updates its cache, hence it is not const. Caches are not synchronized:
+   this system shall be used by a single thread at a time. Copies of this system have their own caches
+   */
+  tchecker::memoized_bytecode_t & memoized_guard(tchecker::edge_id_t id) const;
+
   /*!
    \brief Accessor
    \param id : edge identifier
@@ -153,6 +164,16 @@ public:
    */
   tchecker::bytecode_t const * statement_bytecode(tchecker::edge_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : edge identifier
+   \pre id is an edge identifier (checked by assertion)
+   \return memoized statement bytecode for edge id
+   \note running the returned bytecode updates its cache, hence it is not const. Caches are not synchronized:
+   this system shall be used by a single thread at a time. Copies of this system have their own caches
+   */
+  tchecker::memoized_bytecode_t & memoized_statement(tchecker::edge_id_t id) const;
+
   // Events
   using tchecker::syncprod::system_t::event_attributes;
   using tchecker::syncprod::system_t::event_id;
@@ -213,6 +234,16 @@ public:
    */
   tchecker::bytecode_t const * invariant_bytecode(tchecker::loc_id_t id) const;
 
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return memoized invariant bytecode for location id
+   \note running the returned bytecode updates its cache, hence it is not const. Caches are not synchronized:
+   this system shall be used by a single thread at a time. Copies of this system have their own caches
+   */
+  tchecker::memoized_bytecode_t & memoized_invariant(tchecker::loc_id_t id) const;
+
   // Processes
   using tchecker::syncprod::system_t::is_process;
   using tchecker::syncprod::system_t::process_attributes;
@@ -244,16 +275,18 @@ private:
    \brief Typed and compiled expression
    */
   struct compiled_expression_t {
-    std::shared_ptr<tchecker::typed_expression_t> _typed_expr; /*!< Typed expression */
-    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;      /*!< Compiled expression */
+    std::shared_ptr<tchecker::typed_expression_t> _typed_expr;      /*!< Typed expression */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_expr;           /*!< Compiled expression */
+    std::unique_ptr<tchecker::memoized_bytecode_t> _memoized_expr; /*!< Memoized compiled expression (owned) */
   };
 
   /*!
    \brief Typed and compiled statement
    */
   struct compiled_statement_t {
-    std::shared_ptr<tchecker::typed_statement_t> _typed_stmt; /*!< Typed statement */
-    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;     /*!< Compiled statement */
+    std::shared_ptr<tchecker::typed_statement_t> _typed_stmt;      /*!< Typed statement */
+    std::shared_ptr<tchecker::bytecode_t> _compiled_stmt;          /*!< Compiled statement */
+    std::unique_ptr<tchecker::memoized_bytecode_t> _memoized_stmt; /*!< Memoized compiled statement (owned) */
   };
 
   /*!
@@ -0,0 +1,144 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_BITSTATE_HH
+#define TCHECKER_BITSTATE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ \file bitstate.hh
+ \brief Bit-state hashing (supertrace) table
+ \note See G. J. Holzmann: "An Analysis of Bitstate Hashing". Formal Methods in
+ System Design 13(3): 289-307 (1998)
+ */
+
+namespace tchecker {
+
+/*!
+ \class bitstate_t
+ \brief Table of bits that stores a set of hash values, with k bits per value
+ \note Membership is under-approximate: a value that has not been inserted may
+ be reported as stored if its k bits have been set by other values (hash
+ collision). A search that uses a bit-state table as its set of visited states
+ thus misses the states that collide. The probability of such omissions is
+ estimated from the fill ratio of the table along the search
+ */
+class bitstate_t {
+public:
+  /*!
+   \brief Constructor
+   \param bits : number of bits in the table (rounded down to a power of 2, at least 64)
+   \param hashes : number of bits set per value
+   \throw std::invalid_argument : if hashes is 0 or greater than 32
+   */
+  bitstate_t(std::size_t bits, unsigned int hashes = 3);
+
+  /*!
+   \brief Insertion
+   \param hash : a hash value
+   \return true if hash was not stored in this table, false otherwise (i.e. all
+   the bits of hash were set)
+   \post the bits of hash have been set
+   */
+  bool insert(std::size_t hash);
+
+  /*!
+   \brief Membership
+   \param hash : a hash value
+   \return true if all the bits of hash are set, false otherwise
+   */
+  bool contains(std::size_t hash) const;
+
+  /*!
+   \brief Clear
+   \post all bits are unset and statistics have been reset
+   */
+  void clear();
+
+  /*!
+   \brief Accessor
+   \return number of bits in this table
+   */
+  inline std::size_t bits() const { return _mask + 1; }
+
+  /*!
+   \brief Accessor
+   \return number of bits set per value
+   */
+  inline unsigned int hashes() const { return _hashes; }
+
+  /*!
+   \brief Accessor
+   \return number of bits set in this table
+   */
+  inline std::size_t set_bits() const { return _set_bits; }
+
+  /*!
+   \brief Accessor
+   \return number of values that have been inserted and were not stored
+   */
+  inline std::size_t stored() const { return _stored; }
+
+  /*!
+   \brief Accessor
+   \return number of bits per stored value (best if over 100)
+   */
+  double hash_factor() const;
+
+  /*!
+   \brief Accessor
+   \return expected number of values that have been reported as stored while
+   they had not been inserted
+   \note every new value collides with probability r^k where r is the ratio of
+   set bits when the value is inserted, and k is the number of bits per value
+   */
+  double expected_omissions() const;
+
+  /*!
+   \brief Accessor
+   \return estimated probability that at least one value has been reported as
+   stored while it had not been inserted
+   */
+  double omission_probability() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post the size of the table, the number of bits per value, the hash factor
+   and the estimated omissions have been added to m
+   */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  /*!
+   \brief Bit position of a hash value
+   \param h1 : first mix of a hash value
+   \param h2 : second mix of the hash value (odd)
+   \param i : index of the bit, 0 <= i < hashes()
+   \return position of the i-th bit of the hash value (double hashing)
+   */
+  inline std::size_t position(std::uint64_t h1, std::uint64_t h2, unsigned int i) const
+  {
+    return static_cast<std::size_t>((h1 + i * h2) & _mask);
+  }
+
+  std::vector<std::uint64_t> _table; /*!< Bits */
+  std::size_t _mask;                 /*!< Number of bits - 1 */
+  unsigned int _hashes;              /*!< Number of bits per value */
+  std::size_t _set_bits;             /*!< Number of set bits */
+  std::size_t _stored;               /*!< Number of stored values */
+  double _expected_omissions;        /*!< Sum of collision probabilities of stored values */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_BITSTATE_HH
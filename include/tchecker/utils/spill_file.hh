@@ -0,0 +1,175 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_SPILL_FILE_HH
+#define TCHECKER_SPILL_FILE_HH
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*!
+ \file spill_file.hh
+ \brief Memory-mapped file to spill data out of main memory
+ */
+
+namespace tchecker {
+
+/*!
+ \class spill_file_t
+ \brief Memory-mapped temporary file
+ \note Data written to a spill file is accessed through plain pointers into the
+ mapping. Regions that have been paged out are transparently read back from the
+ file when they are accessed. Deallocated regions are reused by later allocations,
+ and the pages they cover are released from the file system. The file is removed
+ from the file system as soon as it is created, hence it vanishes when the spill
+ file is destroyed (or the process terminates)
+ */
+class spill_file_t {
+public:
+  /*!
+   \brief Constructor
+   \param directory : directory of the spill file (empty for $TMPDIR, or /tmp if
+   TMPDIR is not set)
+   \param segment_size : size of mapped segments (rounded up to page size)
+   \throw std::runtime_error : if the spill file cannot be created
+   */
+  explicit spill_file_t(std::string const & directory = "", std::size_t segment_size = 64 * 1024 * 1024);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  spill_file_t(tchecker::spill_file_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  spill_file_t(tchecker::spill_file_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post all segments have been unmapped, and the file has been closed
+   */
+  ~spill_file_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::spill_file_t & operator=(tchecker::spill_file_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::spill_file_t & operator=(tchecker::spill_file_t &&) = delete;
+
+  /*!
+   \brief Allocation of a region
+   \param size : size of the region
+   \return pointer to a region of size bytes in the file, suitably aligned for any
+   type (see std::max_align_t)
+   \post the returned region is mapped, and stays at the same address until it is
+   deallocated or this spill file is destroyed
+   \throw std::runtime_error : if the file cannot be extended or mapped
+   */
+  void * allocate(std::size_t size);
+
+  /*!
+   \brief Deallocation of a region
+   \param ptr : pointer to a region returned by allocate()
+   \param size : size of the region
+   \pre the region has not been deallocated yet
+   \post the region can be reused by allocate(), and the pages that only contain
+   deallocated regions have been released from the file and from main memory
+   */
+  void deallocate(void const * ptr, std::size_t size);
+
+  /*!
+   \brief Page out a region
+   \param ptr : pointer to a region returned by allocate()
+   \param size : size of the region
+   \post the region has been written to the file and released from main memory
+   \note memory is released by pages, hence neighbour regions that share a page with
+   the region are released as well (they are read back from the file when accessed)
+   \throw std::runtime_error : if the region cannot be written to the file
+   */
+  void page_out(void const * ptr, std::size_t size);
+
+  /*!
+   \brief Page in a region
+   \param ptr : pointer to a region returned by allocate()
+   \param size : size of the region
+   \post the region is being read back from the file (asynchronously)
+   */
+  void page_in(void const * ptr, std::size_t size);
+
+  /*!
+   \brief Accessor
+   \return number of bytes allocated in the file, and not deallocated since then
+   */
+  inline std::size_t size() const { return _size; }
+
+private:
+  /*!
+   \brief Mapped segment of the file
+   */
+  struct segment_t {
+    char * ptr;          /*!< Mapped address */
+    std::size_t offset;  /*!< Offset in the file */
+    std::size_t size;    /*!< Size of the segment */
+    std::size_t used;    /*!< Number of allocated bytes */
+  };
+
+  /*!
+   \brief Accessor
+   \param ptr : pointer in a segment
+   \return the segment that contains ptr
+   \pre ptr is in a segment of this file (checked by assertion)
+   */
+  segment_t const & segment(void const * ptr) const;
+
+  /*!
+   \brief Enclosing pages
+   \param ptr : pointer to a region returned by allocate()
+   \param size : size of the region
+   \return address, offset in the file and size of the smallest sequence of pages
+   that contains the region
+   */
+  std::tuple<char *, std::size_t, std::size_t> pages(void const * ptr, std::size_t size) const;
+
+  /*!
+   \brief Allocation of a deallocated region
+   \param size : size of the region, a multiple of alignof(std::max_align_t)
+   \return pointer to a deallocated region of size bytes (nullptr if there is none)
+   \post the returned region is not free anymore, and its pages are backed by the file
+   \throw std::runtime_error : if the pages of the region cannot be allocated in the file
+   */
+  char * reuse(std::size_t size);
+
+  /*!
+   \brief Release of a region
+   \param ptr : pointer to a region in a segment
+   \param size : size of the region
+   \pre the region is in a segment of this file, and it is neither allocated nor free
+   \post the region is free, and the pages that only contain free regions have
+   been released from the file and from main memory
+   */
+  void release(char * ptr, std::size_t size);
+
+  int _fd;                             /*!< File descriptor */
+  std::size_t _page_size;              /*!< Size of memory pages */
+  std::size_t _segment_size;           /*!< Default size of segments */
+  std::size_t _file_size;              /*!< Size of the file */
+  std::size_t _size;                   /*!< Number of allocated bytes */
+  std::vector<segment_t> _segments;    /*!< Mapped segments */
+  std::map<char *, std::size_t> _free; /*!< Free regions (address -> size), coalesced within segments */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SPILL_FILE_HH
@@ -63,9 +63,16 @@ public:
   inline void lock()
   {
     while (_flag.test_and_set(std::memory_order_acquire))
-      ;
+      std::this_thread::yield();
   }
 
+  /*!
+   \brief Try to acquire the lock
+   \return true if the lock has been acquired, false otherwise
+   \note call to this method is non-blocking
+   */
+  inline bool try_lock() { return !_flag.test_and_set(std::memory_order_acquire); }
+
   /*!
    \brief Release the lock
    \post unlocked
@@ -0,0 +1,156 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TRACE_HH
+#define TCHECKER_TRACE_HH
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "tchecker/config.hh"
+
+/*!
+ \file trace.hh
+ \brief Tracing of algorithms
+ \note Traces are filtered twice. At compile time, traces with a level greater
+ than TCHECKER_TRACE_LEVEL are removed from the code. At runtime, traces whose
+ category is not in the mask (see tchecker::trace::enable) are discarded before
+ any formatting takes place. The mask is empty by default, so no trace is output
+ unless requested
+ */
+
+/*!
+ \brief Trace levels
+ */
+#define TCHECKER_TRACE_LEVEL_NONE 0  /*!< No trace */
+#define TCHECKER_TRACE_LEVEL_PHASE 1 /*!< Phases of the tools and algorithms */
+#define TCHECKER_TRACE_LEVEL_STEP 2  /*!< Steps of the algorithms (visited nodes, updates, etc) */
+
+#ifndef TCHECKER_TRACE_LEVEL
+#define TCHECKER_TRACE_LEVEL TCHECKER_TRACE_LEVEL_PHASE
+#endif
+
+namespace tchecker {
+
+namespace trace {
+
+/*!
+ \brief Type of trace categories
+ */
+using mask_t = std::uint32_t;
+
+/*!
+ \brief Trace categories
+ */
+enum category_t : tchecker::trace::mask_t {
+  CATEGORY_NONE = 0,             /*!< No category */
+  CATEGORY_TOOL = 1 << 0,        /*!< Command-line tools */
+  CATEGORY_COVREACH = 1 << 1,    /*!< Covering reachability algorithm */
+  CATEGORY_GSIM = 1 << 2,        /*!< G-simulation computation */
+  CATEGORY_ALL = (1 << 3) - 1,   /*!< All categories */
+};
+
+namespace details {
+
+/*!
+ \brief Mask of enabled categories
+ */
+extern std::atomic<tchecker::trace::mask_t> mask;
+
+} // end of namespace details
+
+/*!
+ \brief Enable trace categories
+ \param mask : mask of categories
+ \post exactly the categories in mask are enabled
+ */
+void enable(tchecker::trace::mask_t mask);
+
+/*!
+ \brief Accessor
+ \return mask of enabled categories
+ */
+inline tchecker::trace::mask_t enabled_categories()
+{
+  return tchecker::trace::details::mask.load(std::memory_order_relaxed);
+}
+
+/*!
+ \brief Check if a category is enabled
+ \param category : a trace category
+ \return true if category is enabled, false otherwise
+ */
+inline bool enabled(enum tchecker::trace::category_t category)
+{
+  return (tchecker::trace::details::mask.load(std::memory_order_relaxed) & category) != 0;
+}
+
+/*!
+ \brief Parse trace categories
+ \param categories : comma-separated list of categories names
+ \return mask of categories in categories
+ \throw std::invalid_argument : if categories contains an unknown category name
+ \note accepted names are: tool, covreach, gsim, all and none
+ */
+tchecker::trace::mask_t parse_categories(std::string const & categories);
+
+/*!
+ \brief Set trace sink
+ \param os : output stream
+ \pre os is alive until the sink is changed
+ \post traces are output to os
+ \note the default sink is std::cerr, which keeps traces separate from results
+ output by the tools on std::cout
+ */
+void set_sink(std::ostream & os);
+
+/*!
+ \brief Output a trace
+ \param category : trace category
+ \param msg : trace message
+ \post msg has been output as a single line on the sink, prefixed by category
+ \note thread-safe
+ */
+void output(enum tchecker::trace::category_t category, std::string const & msg);
+
+/*!
+ \brief Accessor
+ \param category : trace category
+ \return name of category
+ */
+char const * name(enum tchecker::trace::category_t category);
+
+} // end of namespace trace
+
+} // end of namespace tchecker
+
+/*!
+ \brief Trace macro
+ \param LEVEL : trace level
+ \param CATEGORY : trace category
+ \param MSG : sequence of values separated by << (output to an std::ostream)
+ \post MSG has been output to the trace sink if LEVEL <= TCHECKER_TRACE_LEVEL and
+ CATEGORY is enabled. Nothing is evaluated if LEVEL > TCHECKER_TRACE_LEVEL or if
+ CATEGORY is disabled
+ \note Should be used as:
+ TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_STEP, tchecker::trace::CATEGORY_COVREACH, "visiting node " << id);
+ */
+#define TCHECKER_TRACE(LEVEL, CATEGORY, MSG)                                                                                     \
+  do {                                                                                                                           \
+    if constexpr ((LEVEL) <= TCHECKER_TRACE_LEVEL) {                                                                             \
+      if (tchecker::trace::enabled(CATEGORY)) {                                                                                  \
+        std::ostringstream _tchecker_trace_oss;                                                                                  \
+        _tchecker_trace_oss << MSG;                                                                                              \
+        tchecker::trace::output(CATEGORY, _tchecker_trace_oss.str());                                                            \
+      }                                                                                                                          \
+    }                                                                                                                            \
+  } while (0)
+
+#endif // TCHECKER_TRACE_HH
@@ -0,0 +1,212 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_VM_MEMOIZED_BYTECODE_HH
+#define TCHECKER_VM_MEMOIZED_BYTECODE_HH
+
+#include <cstddef>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/native.hh"
+#include "tchecker/vm/threaded_bytecode.hh"
+#include "tchecker/vm/vm.hh"
+
+/*!
+ \file memoized_bytecode.hh
+ \brief Bytecode with memoized interpretation
+ */
+
+namespace tchecker {
+
+/*!
+ \class memoized_bytecode_t
+ \brief Bytecode with memoized interpretation results
+ \note bytecode that neither reads nor writes integer variables is interpreted once, when this is built,
+ and its value, clock constraints and clock resets are replayed by run(). Bytecode that does not write
+ integer variables, and reads at most MAX_CACHED_INTVARS integer variables at static addresses (see
+ tchecker::read_intvars), has a small direct-mapped cache keyed by the values of the variables it reads.
+ Any other bytecode is interpreted by each call to run()
+ \note bytecode is interpreted from its translation to tchecker::threaded_bytecode_t, or by its native
+ compilation if one has been set (see set_native())
+ */
+class memoized_bytecode_t {
+public:
+  /*!
+   \brief Number of entries in the cache
+   */
+  static constexpr std::size_t const CACHE_SIZE = 4;
+
+  /*!
+   \brief Maximum number of read integer variables for bytecode with cache
+   */
+  static constexpr std::size_t const MAX_CACHED_INTVARS = 8;
+
+  /*!
+   \brief Constructor
+   \param bytecode : bytecode
+   \param vm : virtual machine
+   \pre bytecode is null-terminated (i.e. VM_RET) and well-formed, and it is not deleted before this
+   \post this memoizes the interpretation of bytecode. If bytecode is independent from integer variables,
+   it has been interpreted by vm, unless its interpretation failed (then it is interpreted by each call
+   to run(), and fails at the same point)
+   */
+  memoized_bytecode_t(tchecker::bytecode_t const * bytecode, tchecker::vm_t & vm);
+
+  /*!
+   \brief Copy constructor
+   */
+  memoized_bytecode_t(tchecker::memoized_bytecode_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  memoized_bytecode_t(tchecker::memoized_bytecode_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~memoized_bytecode_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::memoized_bytecode_t & operator=(tchecker::memoized_bytecode_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::memoized_bytecode_t & operator=(tchecker::memoized_bytecode_t &&) = default;
+
+  /*!
+   \brief Bytecode interpreter
+   \param vm : virtual machine
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \return value computed by the bytecode (see tchecker::vm_t::run)
+   \post same as vm.run(bytecode, intval, clkconstr, clkreset)
+   \throw std::runtime_error, std::out_of_range : see tchecker::vm_t::run
+   */
+  tchecker::integer_t run(tchecker::vm_t & vm, tchecker::intval_t & intval, tchecker::clock_constraint_container_t & clkconstr,
+                          tchecker::clock_reset_container_t & clkreset);
+
+  /*!
+   \brief Accessor
+   \return bytecode
+   */
+  inline tchecker::bytecode_t const * bytecode() const { return _bytecode; }
+
+  /*!
+   \brief Accessor
+   \return true if the bytecode is independent from integer variables, and its interpretation has been
+   precomputed, false otherwise
+   */
+  inline bool intval_independent() const { return _kind == INTVAL_INDEPENDENT; }
+
+  /*!
+   \brief Accessor
+   \return true if the interpretation of the bytecode is cached w.r.t. the values of integer variables,
+   false otherwise
+   */
+  inline bool cached() const { return _kind == CACHED; }
+
+  /*!
+   \brief Accessor
+   \return true if the bytecode is interpreted by native code, false otherwise
+   */
+  inline bool native() const { return _native != nullptr; }
+
+  /*!
+   \brief Set native code
+   \param native : native compilation of the bytecode (nullptr to interpret the bytecode)
+   \pre native has the semantics of tchecker::vm_t::run on the bytecode (see tchecker::compile_native)
+   \post the bytecode is interpreted by native from now on. Memoized results are kept
+   */
+  inline void set_native(tchecker::native_bytecode_t native) { _native = native; }
+
+private:
+  /*!
+   \brief Interpretation result
+   */
+  struct result_t {
+    tchecker::integer_t value;                        /*!< Computed value */
+    tchecker::clock_constraint_container_t clkconstr; /*!< Output clock constraints */
+    tchecker::clock_reset_container_t clkreset;       /*!< Output clock resets */
+  };
+
+  /*!
+   \brief Interpret the bytecode and record the result
+   \param vm : virtual machine
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \param result : interpretation result
+   \post the bytecode has been interpreted by vm (see tchecker::vm_t::run), and the computed value, as well as
+   the clock constraints and clock resets pushed by the bytecode, have been stored in result
+   \return the computed value
+   \throw std::runtime_error, std::out_of_range : see tchecker::vm_t::run
+   */
+  tchecker::integer_t record(tchecker::vm_t & vm, tchecker::intval_t & intval,
+                             tchecker::clock_constraint_container_t & clkconstr, tchecker::clock_reset_container_t & clkreset,
+                             result_t & result);
+
+  /*!
+   \brief Interpret the bytecode
+   \param vm : virtual machine
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \return see run()
+   \post the bytecode has been interpreted by native code if any, and from its translation otherwise
+   \throw std::runtime_error, std::out_of_range : see tchecker::vm_t::run
+   */
+  inline tchecker::integer_t interpret(tchecker::vm_t & vm, tchecker::intval_t & intval,
+                                       tchecker::clock_constraint_container_t & clkconstr,
+                                       tchecker::clock_reset_container_t & clkreset)
+  {
+    if (_native != nullptr)
+      return _native(intval, clkconstr, clkreset);
+    return _threaded.run(vm, intval, clkconstr, clkreset);
+  }
+
+  /*!
+   \brief Replay an interpretation result
+   \param result : interpretation result
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \post the clock constraints and clock resets in result have been pushed to clkconstr and clkreset
+   \return the value in result
+   */
+  static tchecker::integer_t replay(result_t const & result, tchecker::clock_constraint_container_t & clkconstr,
+                                    tchecker::clock_reset_container_t & clkreset);
+
+  /*!
+   \brief Kind of memoization
+   */
+  enum kind_t {
+    INTVAL_INDEPENDENT, /*!< Interpretation is precomputed */
+    CACHED,             /*!< Interpretation is cached w.r.t. values of read integer variables */
+    INTERPRETED,        /*!< No memoization */
+  };
+
+  tchecker::bytecode_t const * _bytecode;       /*!< Bytecode */
+  tchecker::threaded_bytecode_t _threaded;      /*!< Translated bytecode */
+  tchecker::native_bytecode_t _native;          /*!< Native code (nullptr if none) */
+  enum kind_t _kind;                            /*!< Kind of memoization */
+  result_t _result;                             /*!< Precomputed result (intval-independent bytecode) */
+  std::vector<tchecker::intvar_id_t> _intvars;  /*!< Read integer variables (cached bytecode) */
+  std::vector<tchecker::integer_t> _keys;       /*!< Values of _intvars for each cache entry */
+  std::vector<result_t> _entries;               /*!< Cache entries */
+  std::vector<bool> _valid;                     /*!< Valid flag of each cache entry */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_MEMOIZED_BYTECODE_HH
@@ -0,0 +1,116 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_VM_NATIVE_HH
+#define TCHECKER_VM_NATIVE_HH
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/vm.hh"
+
+/*!
+ \file native.hh
+ \brief Compilation of bytecode to native code
+ \note this file is included by generated code: everything generated code needs at runtime is defined inline
+ */
+
+namespace tchecker {
+
+/*!
+ \brief Type of native bytecode: bytecode compiled to a C++ function
+ \note a native bytecode has the semantics of tchecker::vm_t::run on the bytecode it has been compiled from
+ */
+using native_bytecode_t = tchecker::integer_t (*)(tchecker::intval_t &, tchecker::clock_constraint_container_t &,
+                                                  tchecker::clock_reset_container_t &);
+
+namespace native {
+
+/*!
+ \brief Raise an exception for a value that cannot be represented by its expected type
+ \throw std::runtime_error
+ */
+[[noreturn]] inline void value_out_of_bounds() { throw std::runtime_error("native bytecode, value out-of-bounds"); }
+
+/*!
+ \brief Check that a value is in an interval
+ \param value : value
+ \param l : lower bound
+ \param h : upper bound
+ \throw std::out_of_range : same exception as tchecker::vm_t for instruction VM_FAILNOTIN if value is not in [l, h]
+ */
+inline void failnotin(tchecker::integer_t value, tchecker::integer_t l, tchecker::integer_t h)
+{
+  if (value >= l && value <= h)
+    return;
+  std::stringstream ss;
+  ss << value << " out of [" << l << ", " << h << "]";
+  throw std::out_of_range("out-of-bounds value: " + ss.str());
+}
+
+/*!
+ \brief Conversion of a value to an integer variable identifier
+ \param value : value
+ \return value as an identifier in valuations of integer variables
+ \throw std::runtime_error : if value is not a valid identifier
+ */
+inline tchecker::intval_t::capacity_t address(tchecker::integer_t value)
+{
+  if (value < 0 || static_cast<std::uintmax_t>(value) > std::numeric_limits<tchecker::intval_t::capacity_t>::max())
+    tchecker::native::value_out_of_bounds();
+  return static_cast<tchecker::intval_t::capacity_t>(value);
+}
+
+/*!
+ \brief Conversion of a value to a clock identifier
+ \param value : value
+ \return value as a clock identifier
+ \throw std::runtime_error : if value is not a valid clock identifier
+ */
+inline tchecker::clock_id_t clock(tchecker::integer_t value)
+{
+  if (value < 0 || static_cast<std::uintmax_t>(value) > std::numeric_limits<tchecker::clock_id_t>::max())
+    tchecker::native::value_out_of_bounds();
+  return static_cast<tchecker::clock_id_t>(value);
+}
+
+} // end of namespace native
+
+/*!
+ \brief Bytecode fingerprint
+ \param bytecode : bytecode
+ \param seed : initial value
+ \pre bytecode is null-terminated (i.e. VM_RET) and well-formed
+ \return FNV-1a hash of the instructions in bytecode (up to the last VM_RET), starting from seed
+ */
+std::uint64_t fingerprint(tchecker::bytecode_t const * bytecode, std::uint64_t seed);
+
+/*!
+ \brief Compile bytecode to C++
+ \param os : output stream
+ \param name : name of the generated function
+ \param bytecode : bytecode
+ \pre bytecode is null-terminated (i.e. VM_RET) and well-formed
+ \post if bytecode can be compiled, the definition of a static function called name of type
+ tchecker::native_bytecode_t has been output to os. Nothing has been output otherwise
+ \return true if bytecode has been compiled, false otherwise
+ \note bytecode with local variables (frames), or with constants that do not fit in tchecker::integer_t, is not
+ compiled. Each slot of the operand stack is a local variable of the generated function, jumps are gotos: the
+ C++ compiler is left in charge of constant propagation, register allocation and control-flow simplification
+ */
+bool compile_native(std::ostream & os, std::string const & name, tchecker::bytecode_t const * bytecode);
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_NATIVE_HH
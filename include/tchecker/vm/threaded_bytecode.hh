@@ -0,0 +1,204 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_VM_THREADED_BYTECODE_HH
+#define TCHECKER_VM_THREADED_BYTECODE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/vm.hh"
+
+/*!
+ \file threaded_bytecode.hh
+ \brief Pre-decoded bytecode with threaded dispatch
+ */
+
+namespace tchecker {
+
+/*!
+ \class threaded_bytecode_t
+ \brief Bytecode translated to a pre-decoded instruction stream
+ \note the translation resolves jump targets, sizes the operand stack once for all, folds constants (negated
+ constants, conditional jumps on constants), and fuses common instruction sequences into superinstructions:
+ reading an integer variable (PUSH id; VALUEAT), comparing it with a constant, assigning a constant to an
+ integer variable, and emitting clock constraints and clock resets with constant operands. Instructions are
+ dispatched with computed gotos when the compiler supports them (GCC, Clang), and with a switch otherwise.
+ \note bytecode with local variables (frames), or with constants that do not fit in tchecker::integer_t,
+ is not translated: it is interpreted by tchecker::vm_t, which remains the reference semantics
+ */
+class threaded_bytecode_t {
+public:
+  /*!
+   \brief Constructor
+   \param bytecode : bytecode
+   \pre bytecode is null-terminated (i.e. VM_RET) and well-formed, and it is not deleted before this
+   \post this is the translation of bytecode if it can be translated, and it refers to bytecode otherwise
+   (see threaded())
+   */
+  threaded_bytecode_t(tchecker::bytecode_t const * bytecode);
+
+  /*!
+   \brief Copy constructor
+   */
+  threaded_bytecode_t(tchecker::threaded_bytecode_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  threaded_bytecode_t(tchecker::threaded_bytecode_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~threaded_bytecode_t() = default;
+
+  /*!
+   \brief Assignment operator
+   */
+  tchecker::threaded_bytecode_t & operator=(tchecker::threaded_bytecode_t const &) = default;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::threaded_bytecode_t & operator=(tchecker::threaded_bytecode_t &&) = default;
+
+  /*!
+   \brief Bytecode interpreter
+   \param vm : virtual machine
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \return value computed by the bytecode (see tchecker::vm_t::run)
+   \post same as vm.run(bytecode, intval, clkconstr, clkreset). vm is only used if the bytecode has not been
+   translated
+   \throw std::runtime_error, std::out_of_range : see tchecker::vm_t::run
+   */
+  tchecker::integer_t run(tchecker::vm_t & vm, tchecker::intval_t & intval, tchecker::clock_constraint_container_t & clkconstr,
+                          tchecker::clock_reset_container_t & clkreset)
+  {
+    if (_instructions.empty())
+      return vm.run(_bytecode, intval, clkconstr, clkreset);
+    return execute(intval, clkconstr, clkreset);
+  }
+
+  /*!
+   \brief Accessor
+   \return bytecode
+   */
+  inline tchecker::bytecode_t const * bytecode() const { return _bytecode; }
+
+  /*!
+   \brief Accessor
+   \return true if the bytecode has been translated, false if it is interpreted by tchecker::vm_t
+   */
+  inline bool threaded() const { return !_instructions.empty(); }
+
+  /*!
+   \brief Accessor
+   \return number of instructions after translation (0 if the bytecode has not been translated)
+   */
+  inline std::size_t size() const { return _instructions.size(); }
+
+  /*!
+   \brief Output
+   \param os : output stream
+   \post the translated instructions have been output to os, one per line
+   \return os after output
+   */
+  std::ostream & output(std::ostream & os) const;
+
+private:
+  /*!
+   \brief Opcodes of translated instructions
+   \note opcodes from OP_RET to OP_CLKRESET have the value of the corresponding instruction in
+   tchecker::instruction_t, opcodes from OP_LOAD are superinstructions. The order of opcodes is the order
+   of the dispatch table in execute()
+   */
+  enum opcode_t : std::uint32_t {
+    OP_RET = 0,   // return top value
+    OP_RETZ,      // return 0 if top value is 0
+    OP_FAILNOTIN, // raise exception if top value is not in [a, b]
+    OP_JMP,       // jump to instruction a
+    OP_JMPZ,      // pop top value, jump to instruction a if it is 0
+    OP_PUSH,      // push a
+    OP_VALUEAT,   // replace top value by the value of the integer variable it identifies
+    OP_ASSIGN,    // pop value and variable identifier, assign value to variable
+    OP_LAND,
+    OP_MINUS,
+    OP_DIV,
+    OP_EQ,
+    OP_GE,
+    OP_GT,
+    OP_LT,
+    OP_LE,
+    OP_MUL,
+    OP_MOD,
+    OP_NE,
+    OP_SUM,
+    OP_NEG,
+    OP_LNOT,
+    OP_CLKCONSTR,       // pop id1, id2, bound, output clock constraint with strictness flag
+    OP_CLKRESET,        // pop id1, id2, value, output clock reset
+    OP_NOP,             // no-operation
+    OP_LOAD,            // push the value of integer variable a              (PUSH a; VALUEAT)
+    OP_LOAD_EQ_CONST,   // push (value of integer variable a) == b           (PUSH a; VALUEAT; PUSH b; EQ)
+    OP_LOAD_NE_CONST,   // push (value of integer variable a) != b           (PUSH a; VALUEAT; PUSH b; NE)
+    OP_LOAD_LT_CONST,   // push (value of integer variable a) < b            (PUSH a; VALUEAT; PUSH b; LT)
+    OP_LOAD_LE_CONST,   // push (value of integer variable a) <= b           (PUSH a; VALUEAT; PUSH b; LE)
+    OP_LOAD_GT_CONST,   // push (value of integer variable a) > b            (PUSH a; VALUEAT; PUSH b; GT)
+    OP_LOAD_GE_CONST,   // push (value of integer variable a) >= b           (PUSH a; VALUEAT; PUSH b; GE)
+    OP_ASSIGN_CONST,    // assign b to integer variable a                    (PUSH a; PUSH b; FAILNOTIN l h; ASSIGN)
+    OP_CLKCONSTR_CONST, // output clock constraint a - b # c                 (PUSH a; PUSH b; PUSH c; CLKCONSTR #)
+    OP_CLKRESET_CONST,  // output clock reset a := b + c                     (PUSH a; PUSH b; PUSH c; CLKRESET)
+    OP_COUNT,           // NOT AN OPCODE, SHOULD BE LAST
+  };
+
+  /*!
+   \brief Translated instruction
+   */
+  struct instruction_t {
+    enum opcode_t op;        /*!< Opcode */
+    std::uint32_t flag;      /*!< Strictness of clock constraints (0 for <, 1 for <=) */
+    tchecker::integer_t a;   /*!< First operand */
+    tchecker::integer_t b;   /*!< Second operand */
+    tchecker::integer_t c;   /*!< Third operand */
+  };
+
+  /*!
+   \brief Translate the bytecode
+   \post _instructions is the translation of _bytecode, and _stack is large enough to execute it.
+   _instructions is empty if _bytecode cannot be translated
+   */
+  void translate();
+
+  /*!
+   \brief Interpreter of translated instructions
+   \param intval : valuation of bounded integer variables
+   \param clkconstr : container of clock constraints
+   \param clkreset : container of clock resets
+   \pre the bytecode has been translated
+   \return see run()
+   \post see run()
+   \throw see run()
+   */
+  tchecker::integer_t execute(tchecker::intval_t & intval, tchecker::clock_constraint_container_t & clkconstr,
+                              tchecker::clock_reset_container_t & clkreset);
+
+  tchecker::bytecode_t const * _bytecode;       /*!< Bytecode */
+  std::vector<instruction_t> _instructions;     /*!< Translated instructions */
+  std::vector<tchecker::integer_t> _stack;      /*!< Operand stack */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_VM_THREADED_BYTECODE_HH
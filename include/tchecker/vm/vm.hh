@@ -123,6 +123,44 @@ std::ostream & output(std::ostream & os, tchecker::bytecode_t const * bytecode);
  */
 std::size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * bytecode);
 
+/*!
+ \brief Instruction size
+ \param bytecode : sequence of bytecode instructions
+ \pre bytecode is well-formed (i.e. instructions have the expected parameters)
+ \return the number of bytes of the instruction pointed by bytecode (including its parameters)
+ \throw std::runtime_error : if bytecode does not point to an instruction
+ */
+std::size_t instruction_size(tchecker::bytecode_t const * bytecode);
+
+/*!
+ \brief Static analysis of integer variables accesses
+ \param bytecode : sequence of bytecode instructions
+ \param intvars : identifiers of integer variables
+ \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+ (i.e. instructions have the expected parameters)
+ \post if bytecode does not write any integer variable, and all integer variables
+ read by bytecode have a static address (i.e. instruction VM_VALUEAT is preceded by
+ instruction VM_PUSH), intvars contains the identifiers of the variables read by
+ bytecode, sorted and without duplicates
+ \return true if the post-condition holds, false otherwise (intvars is then
+ unspecified)
+ \note local variables (frames) are not integer variables
+ \note evaluating bytecode from two valuations that agree on intvars gives the same
+ result, the same clock constraints and the same clock resets. In particular, if
+ intvars is empty, then bytecode is independent of the valuation of integer
+ variables
+ */
+bool read_intvars(tchecker::bytecode_t const * bytecode, std::vector<tchecker::intvar_id_t> & intvars);
+
+/*!
+ \brief Checks independence w.r.t. integer variables
+ \param bytecode : sequence of bytecode instructions
+ \pre bytecode is null-terminated (i.e. RET terminated), and well-formed
+ (i.e. instructions have the expected parameters)
+ \return true if bytecode neither reads nor writes integer variables, false otherwise
+ */
+bool intval_independent(tchecker::bytecode_t const * bytecode);
+
 // Virtual machine (VM)
 
 /*!
@@ -8,11 +8,13 @@
 #ifndef TCHECKER_WAITING_FACTORY_HH
 #define TCHECKER_WAITING_FACTORY_HH
 
+#include <cstdint>
 #include <stdexcept>
 #include <functional>
 
 #include "tchecker/waiting/pqueue.hh"
 #include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/random.hh"
 #include "tchecker/waiting/stack.hh"
 #include "tchecker/waiting/waiting.hh"
 
@@ -30,6 +32,8 @@ enum policy_t {
   FAST_REMOVE_STACK,  /*!< Stack: lifo policy, with fast removal of elements */
   PQUEUE,             /*!< Priority Queue: heap policy */
   FAST_REMOVE_PQUEUE, /*!< Priority Queue: heap policy, with fast removal of elements */
+  RANDOM,             /*!< Random: uniform random policy */
+  FAST_REMOVE_RANDOM, /*!< Random: uniform random policy, with fast removal of elements */
 };
 
 /*!
@@ -42,6 +46,10 @@ enum policy_t {
 template <class T> tchecker::waiting::waiting_t<T> * factory(enum policy_t policy)
 {
   switch (policy) {
+  case tchecker::waiting::RANDOM:
+    return new tchecker::waiting::random_t<T>{};
+  case tchecker::waiting::FAST_REMOVE_RANDOM:
+    return new tchecker::waiting::fast_remove_random_t<T>{};
   case tchecker::waiting::QUEUE:
     return new tchecker::waiting::queue_t<T>{};
   case tchecker::waiting::FAST_REMOVE_QUEUE:
@@ -58,6 +66,26 @@ template <class T> tchecker::waiting::waiting_t<T> * factory(enum policy_t polic
   }
 }
 
+/*!
+ \brief Factory of waiting containers
+ \tparam T : type of waiting elements
+ \param policy : waiting policy
+ \param seed : seed of random waiting containers
+ \return a newly allocated empty waiting container of elements of type T
+ that implements policy. Random containers are seeded with seed
+ */
+template <class T> tchecker::waiting::waiting_t<T> * factory(enum policy_t policy, std::uint64_t seed)
+{
+  switch (policy) {
+  case tchecker::waiting::RANDOM:
+    return new tchecker::waiting::random_t<T>{seed};
+  case tchecker::waiting::FAST_REMOVE_RANDOM:
+    return new tchecker::waiting::fast_remove_random_t<T>{seed};
+  default:
+    return factory<T>(policy);
+  }
+}
+
 template <class T, class Compare> tchecker::waiting::waiting_t<T> * factory(enum policy_t policy)
 {
   switch (policy) {
@@ -0,0 +1,147 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_WAITING_RANDOM_HH
+#define TCHECKER_WAITING_RANDOM_HH
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file random.hh
+ \brief Waiting container with random selection of elements
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \class random_t
+ \brief Waiting container that selects its first element uniformly at random
+ \tparam T : type of waiting elements
+ \note the selection is deterministic for a given seed
+ */
+template <class T> class random_t final : public tchecker::waiting::waiting_t<T> {
+public:
+  /*!
+   \brief Constructor
+   \param seed : seed of the random generator
+   */
+  random_t(std::uint64_t seed = 0) : _rng(seed), _picked(false) {}
+
+  /*!
+   \brief Destructor
+  */
+  virtual ~random_t() = default;
+
+  /*!
+   \brief Accessor
+   \return true if the container is empty, false otherwise
+   */
+  virtual inline bool empty() { return _v.empty(); }
+
+  /*!
+   \brief Clear the container
+   \post this container is empty
+   */
+  virtual inline void clear()
+  {
+    _v.clear();
+    _picked = false;
+  }
+
+  /*!
+   \brief Insert
+   \param t : element
+   \post t has been inserted in the container
+   */
+  virtual inline void insert(T const & t)
+  {
+    _v.push_back(t);
+    // keep the element returned by first() at the back
+    if (_picked)
+      std::swap(_v[_v.size() - 2], _v.back());
+  }
+
+  /*!
+   \brief Remove first element
+   \pre not empty()
+   \post the element returned by first() has been removed from the container
+   */
+  virtual inline void remove_first()
+  {
+    pick();
+    _v.pop_back();
+    _picked = false;
+  }
+
+  /*!
+   \brief Accessor
+   \pre not empty()
+   \return an element of the container chosen uniformly at random
+   \note successive calls return the same element until it is removed
+   */
+  virtual inline T const & first()
+  {
+    pick();
+    return _v.back();
+  }
+
+  /*!
+    \brief Remove an element
+    \param t : element
+    \post all occurrences of t have been removed from the container
+    \note complexity is linear in the size of the container
+  */
+  virtual void remove(T const & t)
+  {
+    if (!_v.empty() && _v.back() == t)
+      _picked = false;
+    for (auto it = _v.begin(); it != _v.end();) {
+      if (*it == t)
+        it = _v.erase(it);
+      else
+        ++it;
+    }
+  }
+
+private:
+  /*!
+   \brief Choose the first element
+   \pre not empty()
+   \post if no element was chosen, an element chosen uniformly at random has been moved to the back of the container
+   */
+  inline void pick()
+  {
+    if (_picked)
+      return;
+    std::uniform_int_distribution<std::size_t> d(0, _v.size() - 1);
+    std::swap(_v[d(_rng)], _v.back());
+    _picked = true;
+  }
+
+  std::vector<T> _v;    /*!< Container */
+  std::mt19937_64 _rng; /*!< Random generator */
+  bool _picked;         /*!< Whether the back of _v is the first element */
+};
+
+/*!
+ \brief Random waiting container with fast remove
+ \tparam T : type of elements, should be a pointer to a type deriving from tchecker::waiting::element_t
+*/
+template <class T> using fast_remove_random_t = tchecker::waiting::fast_remove_waiting_t<tchecker::waiting::random_t<T>>;
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_RANDOM_HH
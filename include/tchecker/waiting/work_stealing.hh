@@ -0,0 +1,195 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_WAITING_WORK_STEALING_HH
+#define TCHECKER_WAITING_WORK_STEALING_HH
+
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/waiting/factory.hh"
+
+/*!
+ \file work_stealing.hh
+ \brief Work-stealing waiting containers for parallel algorithms
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \class work_stealing_t
+ \brief Set of waiting containers, one per worker, where idle workers steal
+ elements from the containers of other workers
+ \tparam T : type of waiting elements
+ \note Each worker inserts and removes elements in its own container, following
+ the policy given at construction (queue or stack). A worker with an empty container
+ steals the oldest element in the container of another worker
+ \note All methods are thread-safe
+ */
+template <class T> class work_stealing_t {
+public:
+  /*!
+   \brief Constructor
+   \param workers : number of workers
+   \param policy : waiting policy of each worker
+   \pre workers > 0 and policy is one of tchecker::waiting::QUEUE,
+   tchecker::waiting::FAST_REMOVE_QUEUE, tchecker::waiting::STACK or
+   tchecker::waiting::FAST_REMOVE_STACK
+   \throw std::invalid_argument : if the precondition is violated
+   */
+  work_stealing_t(std::size_t workers, enum tchecker::waiting::policy_t policy)
+  {
+    if (workers == 0)
+      throw std::invalid_argument("work_stealing_t: at least one worker is required");
+
+    switch (policy) {
+    case tchecker::waiting::QUEUE:
+    case tchecker::waiting::FAST_REMOVE_QUEUE:
+      _lifo = false;
+      break;
+    case tchecker::waiting::STACK:
+    case tchecker::waiting::FAST_REMOVE_STACK:
+      _lifo = true;
+      break;
+    default:
+      throw std::invalid_argument("work_stealing_t: unsupported waiting policy");
+    }
+
+    for (std::size_t i = 0; i < workers; ++i)
+      _containers.push_back(std::make_unique<container_t>());
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  work_stealing_t(tchecker::waiting::work_stealing_t<T> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  work_stealing_t(tchecker::waiting::work_stealing_t<T> &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~work_stealing_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::waiting::work_stealing_t<T> & operator=(tchecker::waiting::work_stealing_t<T> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::waiting::work_stealing_t<T> & operator=(tchecker::waiting::work_stealing_t<T> &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return number of workers
+   */
+  inline std::size_t workers() const { return _containers.size(); }
+
+  /*!
+   \brief Insert
+   \param worker : worker identifier
+   \param t : element
+   \pre worker < workers() (checked by assertion)
+   \post t has been inserted in the container of worker
+   */
+  void insert(std::size_t worker, T && t)
+  {
+    assert(worker < _containers.size());
+    container_t & c = *_containers[worker];
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.dq.push_back(std::move(t));
+  }
+
+  /*!
+   \brief Take an element
+   \param worker : worker identifier
+   \param t : element
+   \pre worker < workers() (checked by assertion)
+   \post if the container of worker is not empty, its first element w.r.t. the waiting
+   policy has been removed and moved to t. Otherwise, the oldest element in the container
+   of some other worker has been removed and moved to t, if any
+   \return true if an element has been moved to t, false if all containers were empty
+   */
+  bool take(std::size_t worker, T & t)
+  {
+    assert(worker < _containers.size());
+    if (take_own(*_containers[worker], t))
+      return true;
+    std::size_t const n = _containers.size();
+    for (std::size_t i = 1; i < n; ++i)
+      if (steal(*_containers[(worker + i) % n], t))
+        return true;
+    return false;
+  }
+
+private:
+  /*!
+   \brief Container of a worker
+   */
+  struct container_t {
+    std::mutex mutex;  /*!< Lock */
+    std::deque<T> dq;  /*!< Elements */
+  };
+
+  /*!
+   \brief Remove the first element w.r.t. waiting policy from a container
+   \param c : container
+   \param t : element
+   \return true if an element has been moved to t, false if c is empty
+   */
+  bool take_own(container_t & c, T & t)
+  {
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if (c.dq.empty())
+      return false;
+    if (_lifo) {
+      t = std::move(c.dq.back());
+      c.dq.pop_back();
+    }
+    else {
+      t = std::move(c.dq.front());
+      c.dq.pop_front();
+    }
+    return true;
+  }
+
+  /*!
+   \brief Remove the oldest element from a container
+   \param c : container
+   \param t : element
+   \return true if an element has been moved to t, false if c is empty
+   */
+  bool steal(container_t & c, T & t)
+  {
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if (c.dq.empty())
+      return false;
+    t = std::move(c.dq.front());
+    c.dq.pop_front();
+    return true;
+  }
+
+  std::vector<std::unique_ptr<container_t>> _containers; /*!< Containers, one per worker */
+  bool _lifo;                                            /*!< Stack (true) or queue (false) policy */
+};
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_WORK_STEALING_HH
@@ -10,10 +10,13 @@
 
 #include <memory>
 
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/kernels.hh"
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/ta/system.hh"
 
@@ -32,11 +35,26 @@ namespace zg {
  */
 class extrapolation_t {
 public:
+  /*!
+   \brief Constructor
+   \post DBM operations are generic (see tchecker::dbm::generic_kernels)
+   */
+  extrapolation_t() : _kernels(&tchecker::dbm::generic_kernels()) {}
+
   /*!
     \brief Destructor
    */
   virtual ~extrapolation_t() = default;
 
+  /*!
+   \brief Set DBM operations
+   \param kernels : table of DBM operations
+   \post DBM operations are taken from kernels
+   \note if kernels is specialized for a dimension (see tchecker::dbm::kernels), all the DBMs subsequently passed to
+   this extrapolation must have that dimension
+   */
+  inline void set_kernels(tchecker::dbm::kernels_t const & kernels) { _kernels = &kernels; }
+
   /*!
    \brief Zone extrapolation
    \param dbm : a dbm
@@ -45,6 +63,9 @@ public:
    \post dbm has been extrapolated using clocks bounds in vloc
    */
   virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc) = 0;
+
+protected:
+  tchecker::dbm::kernels_t const * _kernels; /*!< DBM operations */
 };
 
 /*!
@@ -257,6 +278,44 @@ public:
   virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
 };
 
+/*!
+ \class local_extra_lu_plus_df_t
+ \brief ExtraLU+ zone extrapolation with local LU clock bounds restricted to diagonal-free clocks
+ \note bounds on clocks involved in diagonal constraints are kept exact, which is sound for systems with
+ diagonal constraints (see tchecker::ta::diagonal_clocks and tchecker::dbm::extra_lu_plus)
+ */
+class local_extra_lu_plus_df_t final : public tchecker::zg::details::local_lu_extrapolation_t {
+public:
+  /*!
+   \brief Constructor
+   \param clock_bounds : local LU clock bounds map
+   \param diagonal_clocks : clocks involved in diagonal constraints
+   \pre diagonal_clocks has the same size as the number of clocks in clock_bounds
+   \throw std::invalid_argument : if diagonal_clocks does not have the expected size
+   */
+  local_extra_lu_plus_df_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds,
+                           boost::dynamic_bitset<> const & diagonal_clocks);
+
+  /*!
+  \brief Destructor
+  */
+  virtual ~local_extra_lu_plus_df_t() = default;
+
+  /*!
+  \brief Zone extrapolation
+  \param dbm : a dbm
+  \param dim : dimension of dbm
+  \param vloc : a tuple of locations
+  \pre dim is 1 plus the number of clocks in the global LU clock bounds map (checked by assertion)
+  \post ExtraLU+ has been applied to dbm with local LU clock bounds in vloc, on the bounds that do not involve
+  clocks in diagonal constraints
+ */
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+
+private:
+  boost::dynamic_bitset<> _diagonal_clocks; /*!< Clocks involved in diagonal constraints */
+};
+
 namespace details {
 
 /*!
@@ -449,15 +508,16 @@ public:
  \brief Type of extrapolation
 */
 enum extrapolation_type_t {
-  NO_EXTRAPOLATION,     /*!< see tchecker::zg::no_extrapolation_t */
-  EXTRA_LU_GLOBAL,      /*!< see tchecker::zg::global_extra_lu_t */
-  EXTRA_LU_LOCAL,       /*!< see tchecker::zg::local_extra_lu_t */
-  EXTRA_LU_PLUS_GLOBAL, /*!< see tchecker::zg::global_extra_lu_plus_t */
-  EXTRA_LU_PLUS_LOCAL,  /*!< see tchecker::zg::local_extra_lu_plus_t */
-  EXTRA_M_GLOBAL,       /*!< see tchecker::zg::global_extra_m_t */
-  EXTRA_M_LOCAL,        /*!< see tchecker::zg::local_extra_m_t */
-  EXTRA_M_PLUS_GLOBAL,  /*!< see tchecker::zg::global_extra_m_plus_t */
-  EXTRA_M_PLUS_LOCAL,   /*!< see tchecker::zg::local_extra_m_plus_t */
+  NO_EXTRAPOLATION,       /*!< see tchecker::zg::no_extrapolation_t */
+  EXTRA_LU_GLOBAL,        /*!< see tchecker::zg::global_extra_lu_t */
+  EXTRA_LU_LOCAL,         /*!< see tchecker::zg::local_extra_lu_t */
+  EXTRA_LU_PLUS_GLOBAL,   /*!< see tchecker::zg::global_extra_lu_plus_t */
+  EXTRA_LU_PLUS_LOCAL,    /*!< see tchecker::zg::local_extra_lu_plus_t */
+  EXTRA_M_GLOBAL,         /*!< see tchecker::zg::global_extra_m_t */
+  EXTRA_M_LOCAL,          /*!< see tchecker::zg::local_extra_m_t */
+  EXTRA_M_PLUS_GLOBAL,    /*!< see tchecker::zg::global_extra_m_plus_t */
+  EXTRA_M_PLUS_LOCAL,     /*!< see tchecker::zg::local_extra_m_plus_t */
+  EXTRA_LU_PLUS_LOCAL_DF, /*!< see tchecker::zg::local_extra_lu_plus_df_t */
 };
 
 /*!
@@ -466,8 +526,11 @@ enum extrapolation_type_t {
  \param system : system of timed processes
  \return a zone extrapolation of type extrapolation_type using clock bounds
  inferred from system, nullptr if clock bounds cannot be inferred from system (see
- tchecker::clockbounds::compute_clockbounds). If system contains diagonal clock constraints, the factory
- silently downgrades to tchecker::zg::NO_EXTRAPOLATION to keep simulation sound.
+ tchecker::clockbounds::compute_clockbounds). If system contains diagonal clock constraints, ExtraLU+ with local
+ bounds is restricted to diagonal-free clocks (see tchecker::zg::local_extra_lu_plus_df_t), and the other
+ extrapolations are downgraded to tchecker::zg::NO_EXTRAPOLATION, to keep simulation sound (with a warning).
+ tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF is tchecker::zg::EXTRA_LU_PLUS_LOCAL for systems without diagonal clock
+ constraints
  \note the returned extrapolation must be deallocated by the caller
  \throw std::invalid_argument : if extrapolation_type is unknown
  \throw std::runtime_error : if clock bounds cannot be computed for system
@@ -482,7 +545,8 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
  \return a zone extrapolation of type extrapolation_type using clock bounds from
  clock_bounds
  \note the returned extrapolation must be deallocated by the caller
- \throw std::invalid_argument : if extrapolation_type is unknown
+ \throw std::invalid_argument : if extrapolation_type is unknown, or if extrapolation_type is
+ tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF (which requires the system)
  */
 tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t extrapolation_type,
                                                       tchecker::clockbounds::clockbounds_t const & clock_bounds);
@@ -0,0 +1,274 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ZG_MINIMAL_ZONE_HH
+#define TCHECKER_ZG_MINIMAL_ZONE_HH
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file minimal_zone.hh
+ \brief Compact representation of zones by minimal constraint graphs
+ \note See K. G. Larsen, F. Larsson, P. Pettersson, W. Yi: "Efficient
+ Verification of Real-Time Systems: Compact Data Structure and State-Space
+ Reduction". RTSS 1997: 14-24
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \struct minimal_edge_t
+ \brief Edge of a minimal constraint graph: constraint x - y # c
+ */
+struct minimal_edge_t {
+  std::uint16_t x;        /*!< First clock */
+  std::uint16_t y;        /*!< Second clock */
+  tchecker::dbm::db_t db; /*!< Difference bound on x - y */
+};
+
+/*!
+ \class minimal_zone_t
+ \brief Zone represented by the minimal set of constraints that defines it
+ \note The minimal constraint graph of a tight DBM keeps, for each class of
+ clocks linked by a zero-weight cycle, a single cycle through the class, and
+ between classes, the constraints that are not implied by a path through another
+ class. The tight DBM is obtained back by tightening the minimal graph.
+ Minimal zones are variable-size objects that store their edges right after
+ their header (see tchecker::zg::minimal_zone_allocate_and_construct)
+ */
+class minimal_zone_t {
+public:
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  minimal_zone_t(tchecker::zg::minimal_zone_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  minimal_zone_t(tchecker::zg::minimal_zone_t &&) = delete;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::zg::minimal_zone_t & operator=(tchecker::zg::minimal_zone_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::zg::minimal_zone_t & operator=(tchecker::zg::minimal_zone_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return dimension of the zone
+   */
+  inline std::size_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return number of edges in the minimal constraint graph
+   */
+  inline std::size_t size() const { return _size; }
+
+  /*!
+   \brief Emptiness check
+   \return true if this zone is empty, false otherwise
+   */
+  inline bool is_empty() const { return _empty; }
+
+  /*!
+   \brief Accessor
+   \return pointer to the first edge of the minimal constraint graph
+   */
+  inline tchecker::zg::minimal_edge_t const * begin() const
+  {
+    return static_cast<tchecker::zg::minimal_edge_t const *>(static_cast<void const *>(this + 1));
+  }
+
+  /*!
+   \brief Accessor
+   \return pointer past the last edge of the minimal constraint graph
+   */
+  inline tchecker::zg::minimal_edge_t const * end() const { return begin() + _size; }
+
+  /*!
+   \brief Inclusion check without decompression
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \pre dbm is tight or empty, and dim is the dimension of this zone
+   \return true if the zone represented by dbm is included in this zone, false otherwise
+   \note linear in the number of edges of this zone
+   */
+  bool contains(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim) const;
+
+  /*!
+   \brief Inclusion check without decompression
+   \param zone : a zone
+   \pre zone has dimension dim(), and zone is tight or empty
+   \return true if zone is included in this zone, false otherwise
+   */
+  bool contains(tchecker::zg::zone_t const & zone) const;
+
+  /*!
+   \brief Conversion to DBM
+   \param dbm : a DBM
+   \pre dbm is a dim() * dim() allocated DBM
+   \post dbm is the tight DBM represented by this zone (an empty DBM if this zone is empty)
+   */
+  void to_dbm(tchecker::dbm::db_t * dbm) const;
+
+  /*!
+   \brief Conversion to zone
+   \param zone : a zone
+   \pre zone has dimension dim()
+   \post zone is the tight zone represented by this minimal zone
+   \throw std::invalid_argument : if zone does not have dimension dim()
+   */
+  void to_zone(tchecker::zg::zone_t & zone) const;
+
+  /*!
+   \brief Construction
+   \param ptr : pointer to an allocated minimal zone
+   \param dim : dimension
+   \param empty : emptiness flag
+   \param edges : edges of the minimal constraint graph
+   \param size : number of edges
+   \pre ptr points to an allocated minimal zone of sufficient capacity, i.e. at least
+   allocation_size_t<tchecker::zg::minimal_zone_t>::alloc_size(size)
+   \post an instance of tchecker::zg::minimal_zone_t has been built in ptr
+   */
+  static void construct(void * ptr, tchecker::clock_id_t dim, bool empty, tchecker::zg::minimal_edge_t const * edges,
+                        std::size_t size);
+
+  /*!
+   \brief Destruction
+   \param ptr : a minimal zone
+   \post the destructor of tchecker::zg::minimal_zone_t has been called on ptr
+   */
+  static inline void destruct(tchecker::zg::minimal_zone_t * ptr) { ptr->~minimal_zone_t(); }
+
+protected:
+  /*!
+   \brief Constructor
+   \param dim : dimension
+   \param empty : emptiness flag
+   \param size : number of edges
+   \note edges are copied by construct()
+   */
+  minimal_zone_t(tchecker::clock_id_t dim, bool empty, std::size_t size);
+
+  /*!
+   \brief Destructor
+   */
+  ~minimal_zone_t() = default;
+
+  std::uint32_t _dim;  /*!< Dimension of the zone */
+  std::uint32_t _size; /*!< Number of edges */
+  bool _empty;         /*!< Emptiness flag */
+};
+
+/*!
+ \brief Inclusion check
+ \param zone : a zone
+ \param minimal : a minimal zone
+ \return true if zone is included in minimal, false otherwise
+ */
+inline bool operator<=(tchecker::zg::zone_t const & zone, tchecker::zg::minimal_zone_t const & minimal)
+{
+  return minimal.contains(zone);
+}
+
+} // end of namespace zg
+
+/*!
+ \class allocation_size_t
+ \brief Specialization of class tchecker::allocation_size_t for type
+ tchecker::zg::minimal_zone_t
+ */
+template <> class allocation_size_t<tchecker::zg::minimal_zone_t> {
+public:
+  /*!
+   \brief Accessor
+   \param size : number of edges
+   \return Allocation size for objects of type tchecker::zg::minimal_zone_t
+   with size edges
+   */
+  static constexpr std::size_t alloc_size(std::size_t size)
+  {
+    return (sizeof(tchecker::zg::minimal_zone_t) + size * sizeof(tchecker::zg::minimal_edge_t));
+  }
+};
+
+namespace zg {
+
+/*!
+ \brief Allocation and construction of minimal zones
+ \param zone : a zone
+ \pre zone is tight or empty
+ \return the minimal zone that represents zone
+ \throw std::invalid_argument : if the dimension of zone is too large to be
+ represented by a minimal constraint graph (more than 65536)
+ */
+tchecker::zg::minimal_zone_t * minimal_zone_allocate_and_construct(tchecker::zg::zone_t const & zone);
+
+/*!
+ \brief Destruction and deallocation of minimal zones
+ \param zone : a minimal zone
+ \pre zone has been allocated by tchecker::zg::minimal_zone_allocate_and_construct
+ \post the destructor of zone has been called, and zone has been deleted
+ */
+void minimal_zone_destruct_and_deallocate(tchecker::zg::minimal_zone_t * zone);
+
+/*!
+ \class minimal_zone_deleter_t
+ \brief Deleter of minimal zones, for std::unique_ptr
+ */
+class minimal_zone_deleter_t {
+public:
+  /*!
+   \brief Deleter
+   \param zone : a minimal zone
+   \post zone has been destructed and deallocated
+   */
+  inline void operator()(tchecker::zg::minimal_zone_t * zone) const
+  {
+    tchecker::zg::minimal_zone_destruct_and_deallocate(zone);
+  }
+};
+
+/*!
+ \brief Type of unique pointer to minimal zone
+ */
+using minimal_zone_uptr_t = std::unique_ptr<tchecker::zg::minimal_zone_t, tchecker::zg::minimal_zone_deleter_t>;
+
+/*!
+ \brief Minimal constraint graph
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param edges : container of edges
+ \pre dbm is tight and not empty (checked by assertion), dim <= 65536
+ \post edges contains the edges of the minimal constraint graph of dbm. Tightening
+ the DBM that only contains these edges (and <=0 on the diagonal) yields dbm
+ \note cubic in dim
+ */
+void minimal_graph(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+                   std::vector<tchecker::zg::minimal_edge_t> & edges);
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_MINIMAL_ZONE_HH
@@ -10,6 +10,7 @@
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/kernels.hh"
 #include "tchecker/variables/clocks.hh"
 
 /*!
@@ -27,11 +28,26 @@ namespace zg {
  */
 class semantics_t {
 public:
+  /*!
+  \brief Constructor
+  \post DBM operations are generic (see tchecker::dbm::generic_kernels)
+   */
+  semantics_t() : _kernels(&tchecker::dbm::generic_kernels()) {}
+
   /*!
   \brief Destructor
    */
   virtual ~semantics_t() = default;
 
+  /*!
+  \brief Set DBM operations
+  \param kernels : table of DBM operations
+  \post DBM operations are taken from kernels
+  \note if kernels is specialized for a dimension (see tchecker::dbm::kernels), all the DBMs subsequently passed to
+  this semantics must have that dimension
+   */
+  inline void set_kernels(tchecker::dbm::kernels_t const & kernels) { _kernels = &kernels; }
+
   /*!
   \brief Compute initial zone
   \param dbm : a DBM
@@ -99,6 +115,9 @@ public:
                                         tchecker::clock_constraint_container_t const & guard,
                                         tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                         tchecker::clock_constraint_container_t const & tgt_invariant) = 0;
+
+protected:
+  tchecker::dbm::kernels_t const * _kernels; /*!< DBM operations */
 };
 
 /*!
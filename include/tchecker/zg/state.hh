@@ -201,6 +201,37 @@ bool is_alu_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s
 bool shared_is_alu_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
                       tchecker::clockbounds::map_t const & l, tchecker::clockbounds::map_t const & u);
 
+/*!
+ \brief LU-d subsumption check
+ \param s1 : state
+ \param s2 : state
+ \param l : clock lower bounds
+ \param u : clock upper bounds
+ \param diagonals : diagonal constraints
+ \return true if s1 and s2 have the same tuple of locations and integer
+ variables valuation, and every valuation in the zone in s1 is LU-d simulated by a
+ valuation in the zone in s2, false otherwise
+*/
+bool is_alu_d_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2, tchecker::clockbounds::map_t const & l,
+                 tchecker::clockbounds::map_t const & u, tchecker::clock_constraint_container_t const & diagonals);
+
+/*!
+ \brief LU-d subsumption check for shared states
+ \param s1 : state
+ \param s2 : state
+ \param l : clock lower bounds
+ \param u : clock upper bounds
+ \param diagonals : diagonal constraints
+ \return true if s1 and s2 have the same tuple of locations and integer
+ variables valuation, and every valuation in the zone in s1 is LU-d simulated by a
+ valuation in the zone in s2, false otherwise
+ \note this should only be used on states that have shared internal components: this
+ function checks pointers instead of values when relevant
+*/
+bool shared_is_alu_d_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
+                        tchecker::clockbounds::map_t const & l, tchecker::clockbounds::map_t const & u,
+                        tchecker::clock_constraint_container_t const & diagonals);
+
 /*!
  \brief Hash
  \param s : state
@@ -0,0 +1,242 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ZG_STATIC_DISPATCH_HH
+#define TCHECKER_ZG_STATIC_DISPATCH_HH
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ts/bwd.hh"
+#include "tchecker/ts/fwd.hh"
+#include "tchecker/ts/sharing.hh"
+#include "tchecker/zg/extrapolation.hh"
+#include "tchecker/zg/semantics.hh"
+#include "tchecker/zg/zg.hh"
+
+/*!
+ \file static_dispatch.hh
+ \brief Zone graphs with statically dispatched semantics and extrapolation
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+namespace static_dispatch {
+
+/*!
+ \class zg_t
+ \brief Zone graph with semantics and extrapolation of static types
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
+ \note initial, next, final and previous states are computed by calling SEMANTICS and EXTRAPOLATION directly, hence
+ without virtual calls when they are final classes. Since this class is final, algorithms instantiated on it
+ (instead of tchecker::zg::zg_t) call its methods directly as well, and the compiler can inline semantics and
+ extrapolation in the algorithm loop (with link-time optimization)
+ \note all returned states and transitions are deallocated automatically
+ */
+template <class SEMANTICS, class EXTRAPOLATION> class zg_t final : public tchecker::zg::zg_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param sharing_type : type of state/transition sharing
+   \param semantics : a zone semantics
+   \param extrapolation : a zone extrapolation
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash tables
+   \note see tchecker::zg::zg_t::zg_t
+   */
+  zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
+       std::shared_ptr<SEMANTICS> const & semantics, std::shared_ptr<EXTRAPOLATION> const & extrapolation,
+       std::size_t block_size, std::size_t table_size)
+      : tchecker::zg::zg_t(system, sharing_type, semantics, extrapolation, block_size, table_size), _semantics(semantics),
+        _extrapolation(extrapolation)
+  {
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  zg_t(tchecker::zg::static_dispatch::zg_t<SEMANTICS, EXTRAPOLATION> const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  zg_t(tchecker::zg::static_dispatch::zg_t<SEMANTICS, EXTRAPOLATION> &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~zg_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::zg::static_dispatch::zg_t<SEMANTICS, EXTRAPOLATION> &
+  operator=(tchecker::zg::static_dispatch::zg_t<SEMANTICS, EXTRAPOLATION> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::zg::static_dispatch::zg_t<SEMANTICS, EXTRAPOLATION> &
+  operator=(tchecker::zg::static_dispatch::zg_t<SEMANTICS, EXTRAPOLATION> &&) = delete;
+
+  // Forward
+
+  /*!
+   \brief Initial state and transition from an initial edge
+   \note see tchecker::zg::zg_t::initial
+   */
+  virtual void initial(initial_value_t const & init_edge, std::vector<sst_t> & v,
+                       tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::zg::zg_t::initial(init_edge, v, mask, *_semantics, *_extrapolation);
+  }
+
+  /*!
+   \brief Initial states and transitions with selected status
+   \note see tchecker::zg::zg_t::initial
+   */
+  virtual void initial(std::vector<sst_t> & v, tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::ts::initial(*this, v, mask);
+  }
+
+  /*!
+   \brief Next state and transition
+   \note see tchecker::zg::zg_t::next
+   */
+  virtual void next(tchecker::zg::const_state_sptr_t const & s, outgoing_edges_value_t const & out_edge, std::vector<sst_t> & v,
+                    tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::zg::zg_t::next(s, out_edge, v, mask, *_semantics, *_extrapolation);
+  }
+
+  /*!
+   \brief Next states and transitions with selected status
+   \note see tchecker::zg::zg_t::next
+   */
+  virtual void next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
+                    tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::ts::next(*this, s, v, mask);
+  }
+
+  // Backward
+
+  /*!
+   \brief Final state and transition from a final edge
+   \note see tchecker::zg::zg_t::final
+   */
+  virtual void final(final_value_t const & final_edge, std::vector<sst_t> & v,
+                     tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::zg::zg_t::final(final_edge, v, mask, *_semantics, *_extrapolation);
+  }
+
+  /*!
+   \brief Final states and transitions with selected status
+   \note see tchecker::zg::zg_t::final
+   */
+  virtual void final(boost::dynamic_bitset<> const & labels, std::vector<sst_t> & v,
+                     tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::ts::final(*this, labels, v, mask);
+  }
+
+  /*!
+   \brief Previous state and transition from an incoming edge
+   \note see tchecker::zg::zg_t::prev
+   */
+  virtual void prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value_t const & in_edge, std::vector<sst_t> & v,
+                    tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::zg::zg_t::prev(s, in_edge, v, mask, *_semantics, *_extrapolation);
+  }
+
+  /*!
+   \brief Previous states and transitions with selected status
+   \note see tchecker::zg::zg_t::prev
+   */
+  virtual void prev(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v,
+                    tchecker::state_status_t mask = tchecker::STATE_OK) override
+  {
+    tchecker::ts::prev(*this, s, v, mask);
+  }
+
+private:
+  std::shared_ptr<SEMANTICS> _semantics;         /*!< Zone semantics */
+  std::shared_ptr<EXTRAPOLATION> _extrapolation; /*!< Zone extrapolation */
+};
+
+/*!
+ \brief Build a zone graph with statically dispatched semantics and extrapolation, and apply a function to it
+ \tparam FUNCTION : type of function, should be callable on std::shared_ptr to tchecker::zg::zg_t as well as to every
+ instance of tchecker::zg::static_dispatch::zg_t listed below (typically a generic lambda)
+ \param system : system of timed processes
+ \param sharing_type : type of sharing
+ \param semantics_type : type of zone semantics
+ \param extrapolation_type : type of zone extrapolation
+ \param block_size : number of objects allocated in a block
+ \param table_size : size of hash tables
+ \param f : function
+ \return f(zg) where zg is a zone graph over system with semantics and extrapolation built from semantics_type and
+ extrapolation_type (see tchecker::zg::factory). zg is an instance of tchecker::zg::static_dispatch::zg_t for elapsed
+ semantics with local ExtraLU+ extrapolation (possibly restricted to diagonal-free clocks) or without extrapolation,
+ and a tchecker::zg::zg_t otherwise
+ \throw std::runtime_error : if clock bounds cannot be computed for system (only if extrapolation_type requires
+ clock bounds computation from system)
+ \note the instance of tchecker::zg::static_dispatch::zg_t is selected once, from the dynamic types of the semantics
+ and extrapolation. f is instantiated for each of them
+ */
+template <class FUNCTION>
+auto visit(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
+           enum tchecker::zg::semantics_type_t semantics_type, enum tchecker::zg::extrapolation_type_t extrapolation_type,
+           std::size_t block_size, std::size_t table_size, FUNCTION && f)
+{
+  std::shared_ptr<tchecker::zg::extrapolation_t> extrapolation{
+      tchecker::zg::extrapolation_factory(extrapolation_type, *system)};
+  if (extrapolation.get() == nullptr)
+    throw std::runtime_error("Clock bounds cannot be computed for the system");
+  std::shared_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(semantics_type)};
+
+  auto elapsed = std::dynamic_pointer_cast<tchecker::zg::elapsed_semantics_t>(semantics);
+  if (elapsed.get() != nullptr) {
+    auto lu_plus = std::dynamic_pointer_cast<tchecker::zg::local_extra_lu_plus_t>(extrapolation);
+    if (lu_plus.get() != nullptr)
+      return f(std::make_shared<
+               tchecker::zg::static_dispatch::zg_t<tchecker::zg::elapsed_semantics_t, tchecker::zg::local_extra_lu_plus_t>>(
+          system, sharing_type, elapsed, lu_plus, block_size, table_size));
+
+    auto lu_plus_df = std::dynamic_pointer_cast<tchecker::zg::local_extra_lu_plus_df_t>(extrapolation);
+    if (lu_plus_df.get() != nullptr)
+      return f(std::make_shared<
+               tchecker::zg::static_dispatch::zg_t<tchecker::zg::elapsed_semantics_t, tchecker::zg::local_extra_lu_plus_df_t>>(
+          system, sharing_type, elapsed, lu_plus_df, block_size, table_size));
+
+    auto no_extrapolation = std::dynamic_pointer_cast<tchecker::zg::no_extrapolation_t>(extrapolation);
+    if (no_extrapolation.get() != nullptr)
+      return f(std::make_shared<
+               tchecker::zg::static_dispatch::zg_t<tchecker::zg::elapsed_semantics_t, tchecker::zg::no_extrapolation_t>>(
+          system, sharing_type, elapsed, no_extrapolation, block_size, table_size));
+  }
+
+  return f(std::make_shared<tchecker::zg::zg_t>(system, sharing_type, semantics, extrapolation, block_size, table_size));
+}
+
+} // end of namespace static_dispatch
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_STATIC_DISPATCH_HH
@@ -71,6 +71,8 @@ using initial_value_t = tchecker::ta::initial_value_t;
 
 /*!
  \brief Compute initial state
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param vloc : tuple of locations
  \param intval : valuation of bounded integer variables
@@ -96,16 +98,37 @@ using initial_value_t = tchecker::ta::initial_value_t;
  variables does not satisfy invariant
  tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED if the initial zone is empty
  \throw std::runtime_error : if evaluation of invariant throws an exception
+ \note semantics and extrapolation are called without virtual dispatch if SEMANTICS and EXTRAPOLATION are final
+ classes
  */
+template <class SEMANTICS, class EXTRAPOLATION>
 tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
                                  tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
                                  tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
-                                 tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
-                                 tchecker::zg::extrapolation_t & extrapolation,
-                                 tchecker::zg::initial_value_t const & initial_range);
+                                 tchecker::clock_constraint_container_t & invariant, SEMANTICS & semantics,
+                                 EXTRAPOLATION & extrapolation, tchecker::zg::initial_value_t const & initial_range)
+{
+  tchecker::state_status_t status = tchecker::ta::initial(system, vloc, intval, vedge, sync_id, invariant, initial_range);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  tchecker::dbm::db_t * dbm = zone->dbm();
+  tchecker::clock_id_t dim = static_cast<tchecker::clock_id_t>(zone->dim());
+  bool delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  status = semantics.initial(dbm, dim, delay_allowed, invariant);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  extrapolation.extrapolate(dbm, dim, *vloc);
+
+  return tchecker::STATE_OK;
+}
 
 /*!
  \brief Compute initial state and transition
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param s : state
  \param t : transition
@@ -118,9 +141,10 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker
  tchecker::zg::initial for returned values when initialization fails
  \throw std::invalid_argument : if s and v have incompatible sizes
 */
+template <class SEMANTICS, class EXTRAPOLATION>
 inline tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
-                                        tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
-                                        tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::initial_value_t const & v)
+                                        tchecker::zg::transition_t & t, SEMANTICS & semantics, EXTRAPOLATION & extrapolation,
+                                        tchecker::zg::initial_value_t const & v)
 {
   return tchecker::zg::initial(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.sync_id(),
                                t.tgt_invariant_container(), semantics, extrapolation, v);
@@ -161,6 +185,8 @@ using final_value_t = tchecker::ta::final_value_t;
 
 /*!
  \brief Compute final state
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param vloc : tuple of locations
  \param intval : valuation of bounded integer variables
@@ -186,15 +212,37 @@ using final_value_t = tchecker::ta::final_value_t;
  does not satisfy invariant
  tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED if the final zone is empty
  \throw std::runtime_error : if evaluation of invariant throws an exception
+ \note semantics and extrapolation are called without virtual dispatch if SEMANTICS and EXTRAPOLATION are final
+ classes
  */
+template <class SEMANTICS, class EXTRAPOLATION>
 tchecker::state_status_t final(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
                                tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
                                tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
-                               tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
-                               tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::final_value_t const & final_range);
+                               tchecker::clock_constraint_container_t & invariant, SEMANTICS & semantics,
+                               EXTRAPOLATION & extrapolation, tchecker::zg::final_value_t const & final_range)
+{
+  tchecker::state_status_t status = tchecker::ta::final(system, vloc, intval, vedge, sync_id, invariant, final_range);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  tchecker::dbm::db_t * dbm = zone->dbm();
+  tchecker::clock_id_t dim = static_cast<tchecker::clock_id_t>(zone->dim());
+  bool delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  status = semantics.final(dbm, dim, delay_allowed, invariant);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  extrapolation.extrapolate(dbm, dim, *vloc);
+
+  return tchecker::STATE_OK;
+}
 
 /*!
  \brief Compute final state and transition
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param s : state
  \param t : transition
@@ -207,9 +255,10 @@ tchecker::state_status_t final(tchecker::ta::system_t const & system, tchecker::
  tchecker::zg::final for returned values when computation fails
  \throw std::invalid_argument : if s and v have incompatible sizes
 */
+template <class SEMANTICS, class EXTRAPOLATION>
 inline tchecker::state_status_t final(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
-                                      tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
-                                      tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::final_value_t const & v)
+                                      tchecker::zg::transition_t & t, SEMANTICS & semantics, EXTRAPOLATION & extrapolation,
+                                      tchecker::zg::final_value_t const & v)
 {
   return tchecker::zg::final(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.sync_id(),
                              t.tgt_invariant_container(), semantics, extrapolation, v);
@@ -248,6 +297,8 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
 
 /*!
  \brief Compute next state
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param vloc : tuple of locations
  \param intval : valuation of bounded integer variables
@@ -306,18 +357,42 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
  updated vloc generates clock resets
  \throw std::runtime_error : if evaluation of invariants, guards or statements
  throws an exception
+ \note semantics and extrapolation are called without virtual dispatch if SEMANTICS and EXTRAPOLATION are final
+ classes
  */
+template <class SEMANTICS, class EXTRAPOLATION>
 tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
                               tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
                               tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
-                              tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
-                              tchecker::zg::extrapolation_t & extrapolation,
-                              tchecker::zg::outgoing_edges_value_t const & sync_edges);
+                              tchecker::clock_constraint_container_t & tgt_invariant, SEMANTICS & semantics,
+                              EXTRAPOLATION & extrapolation, tchecker::zg::outgoing_edges_value_t const & sync_edges)
+{
+  bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  tchecker::state_status_t status =
+      tchecker::ta::next(system, vloc, intval, vedge, sync_id, src_invariant, guard, reset, tgt_invariant, sync_edges);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  tchecker::dbm::db_t * dbm = zone->dbm();
+  tchecker::clock_id_t dim = static_cast<tchecker::clock_id_t>(zone->dim());
+  bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  status = semantics.next(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  extrapolation.extrapolate(dbm, dim, *vloc);
+
+  return tchecker::STATE_OK;
+}
 
 /*!
  \brief Compute next state and transition
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param s : state
  \param t : transition
@@ -329,9 +404,9 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::v
  \return status of state s after update (see tchecker::zg::next)
  \throw std::invalid_argument : if s and v have incompatible size
 */
+template <class SEMANTICS, class EXTRAPOLATION>
 inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
-                                     tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
-                                     tchecker::zg::extrapolation_t & extrapolation,
+                                     tchecker::zg::transition_t & t, SEMANTICS & semantics, EXTRAPOLATION & extrapolation,
                                      tchecker::zg::outgoing_edges_value_t const & sync_edges)
 {
   return tchecker::zg::next(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.sync_id(),
@@ -375,6 +450,8 @@ using incoming_edges_value_t = tchecker::ta::incoming_edges_value_t;
 
 /*!
  \brief Compute previous state
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param vloc : tuple of locations
  \param intval : valuation of bounded integer variables
@@ -430,17 +507,42 @@ using incoming_edges_value_t = tchecker::ta::incoming_edges_value_t;
  updated vloc generates clock resets
  \throw std::runtime_error : if evaluation of invariants, guards or statements
  throws an exception
+ \note semantics and extrapolation are called without virtual dispatch if SEMANTICS and EXTRAPOLATION are final
+ classes
  */
+template <class SEMANTICS, class EXTRAPOLATION>
 tchecker::state_status_t prev(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
                               tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
                               tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
-                              tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
-                              tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::incoming_edges_value_t const & v);
+                              tchecker::clock_constraint_container_t & tgt_invariant, SEMANTICS & semantics,
+                              EXTRAPOLATION & extrapolation, tchecker::zg::incoming_edges_value_t const & v)
+{
+  bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  tchecker::state_status_t status =
+      tchecker::ta::prev(system, vloc, intval, vedge, sync_id, src_invariant, guard, reset, tgt_invariant, v);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  tchecker::dbm::db_t * dbm = zone->dbm();
+  tchecker::clock_id_t dim = static_cast<tchecker::clock_id_t>(zone->dim());
+  bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
+
+  status = semantics.prev(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant);
+  if (status != tchecker::STATE_OK)
+    return status;
+
+  extrapolation.extrapolate(dbm, dim, *vloc);
+
+  return tchecker::STATE_OK;
+}
 
 /*!
  \brief Compute previous state and transition
+ \tparam SEMANTICS : type of zone semantics, should derive from tchecker::zg::semantics_t
+ \tparam EXTRAPOLATION : type of zone extrapolation, should derive from tchecker::zg::extrapolation_t
  \param system : a system
  \param s : state
  \param t : transition
@@ -452,9 +554,9 @@ tchecker::state_status_t prev(tchecker::ta::system_t const & system, tchecker::v
  \return status of state s after update (see tchecker::zg::prev)
  \throw std::invalid_argument : if s and v have incompatible size
 */
+template <class SEMANTICS, class EXTRAPOLATION>
 inline tchecker::state_status_t prev(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
-                                     tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
-                                     tchecker::zg::extrapolation_t & extrapolation,
+                                     tchecker::zg::transition_t & t, SEMANTICS & semantics, EXTRAPOLATION & extrapolation,
                                      tchecker::zg::incoming_edges_value_t const & v)
 {
   return tchecker::zg::prev(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.sync_id(),
@@ -590,8 +692,10 @@ inline tchecker::state_status_t initialize(tchecker::ta::system_t const & system
  \brief Transition system of the zone graph over system of timed processes with
  state and transition allocation
  \note all returned states and transitions are deallocated automatically
+ \note semantics and extrapolation are called through virtual methods. See tchecker::zg::static_dispatch::zg_t for
+ a zone graph that calls them directly
  */
-class zg_t final : public tchecker::ts::fwd_t<tchecker::zg::state_sptr_t, tchecker::zg::const_state_sptr_t,
+class zg_t : public tchecker::ts::fwd_t<tchecker::zg::state_sptr_t, tchecker::zg::const_state_sptr_t,
                                               tchecker::zg::transition_sptr_t, tchecker::zg::const_transition_sptr_t>,
                    public tchecker::ts::bwd_t<tchecker::zg::state_sptr_t, tchecker::zg::const_state_sptr_t,
                                               tchecker::zg::transition_sptr_t, tchecker::zg::const_transition_sptr_t>,
@@ -647,6 +751,8 @@ public:
    \param extrapolation : a zone extrapolation
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash tables
+   \post semantics and extrapolation use DBM operations selected for the dimension of zones in system (see
+   tchecker::dbm::kernels)
    \note all states and transitions are pool allocated and deallocated automatically
    */
   zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tchecker::ts::sharing_type_t sharing_type,
@@ -848,6 +954,22 @@ public:
   virtual void build(std::map<std::string, std::string> const & attributes, std::vector<sst_t> & v,
                      tchecker::state_status_t mask = tchecker::STATE_OK);
 
+  /*!
+   \brief State building from raw components
+   \param vloc : locations identifiers, one per process
+   \param intval : values of bounded integer variables (flattened)
+   \param dbm : a DBM
+   \param dim : dimension of dbm
+   \pre vloc has size system().processes_count(), intval has size
+   system().intvars_count(tchecker::VK_FLATTENED), and dim is the dimension of zones in
+   this zone graph (checked by assertion)
+   \return a state with a copy of vloc, intval and dbm
+   \note the returned state is not shared, see share()
+   \note this allows to transfer states between zone graphs over the same system
+  */
+  tchecker::zg::state_sptr_t build(tchecker::loc_id_t const * vloc, tchecker::integer_t const * intval,
+                                   tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim);
+
   // split
 
   /*!
@@ -950,6 +1072,121 @@ public:
   */
   inline enum tchecker::ts::sharing_type_t sharing_type() const { return _sharing_type; }
 
+protected:
+  /*!
+   \brief Initial state and transition from an initial edge w.r.t. given semantics and extrapolation
+   \tparam SEMANTICS : type of zone semantics
+   \tparam EXTRAPOLATION : type of zone extrapolation
+   \param init_edge : initial state valuation
+   \param v : container
+   \param mask : mask on next states
+   \param semantics : zone semantics
+   \param extrapolation : zone extrapolation
+   \pre semantics and extrapolation are the semantics and extrapolation of this zone graph
+   \post see initial(init_edge, v, mask)
+   */
+  template <class SEMANTICS, class EXTRAPOLATION>
+  void initial(initial_value_t const & init_edge, std::vector<sst_t> & v, tchecker::state_status_t mask,
+               SEMANTICS & semantics, EXTRAPOLATION & extrapolation)
+  {
+    tchecker::zg::state_sptr_t s = _state_allocator.construct();
+    tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
+    tchecker::state_status_t status = tchecker::zg::initial(*_system, *s, *t, semantics, extrapolation, init_edge);
+    if (status & mask) {
+      if (_sharing_type == tchecker::ts::SHARING) {
+        tchecker::zg::zg_t::share(s);
+        tchecker::zg::zg_t::share(t);
+      }
+      v.push_back(std::make_tuple(status, s, t));
+    }
+  }
+
+  /*!
+   \brief Next state and transition w.r.t. given semantics and extrapolation
+   \tparam SEMANTICS : type of zone semantics
+   \tparam EXTRAPOLATION : type of zone extrapolation
+   \param s : state
+   \param out_edge : outgoing edge value
+   \param v : container
+   \param mask : mask on next states
+   \param semantics : zone semantics
+   \param extrapolation : zone extrapolation
+   \pre semantics and extrapolation are the semantics and extrapolation of this zone graph
+   \post see next(s, out_edge, v, mask)
+   */
+  template <class SEMANTICS, class EXTRAPOLATION>
+  void next(tchecker::zg::const_state_sptr_t const & s, outgoing_edges_value_t const & out_edge, std::vector<sst_t> & v,
+            tchecker::state_status_t mask, SEMANTICS & semantics, EXTRAPOLATION & extrapolation)
+  {
+    tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
+    tchecker::zg::transition_sptr_t nextt = _transition_allocator.construct();
+    tchecker::state_status_t status = tchecker::zg::next(*_system, *nexts, *nextt, semantics, extrapolation, out_edge);
+    if (status & mask) {
+      if (_sharing_type == tchecker::ts::SHARING) {
+        tchecker::zg::zg_t::share(nexts);
+        tchecker::zg::zg_t::share(nextt);
+      }
+      v.push_back(std::make_tuple(status, nexts, nextt));
+    }
+  }
+
+  /*!
+   \brief Final state and transition from a final edge w.r.t. given semantics and extrapolation
+   \tparam SEMANTICS : type of zone semantics
+   \tparam EXTRAPOLATION : type of zone extrapolation
+   \param final_edge : final edge valuation
+   \param v : container
+   \param mask : mask on final states
+   \param semantics : zone semantics
+   \param extrapolation : zone extrapolation
+   \pre semantics and extrapolation are the semantics and extrapolation of this zone graph
+   \post see final(final_edge, v, mask)
+   */
+  template <class SEMANTICS, class EXTRAPOLATION>
+  void final(final_value_t const & final_edge, std::vector<sst_t> & v, tchecker::state_status_t mask, SEMANTICS & semantics,
+             EXTRAPOLATION & extrapolation)
+  {
+    tchecker::zg::state_sptr_t s = _state_allocator.construct();
+    tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
+    tchecker::state_status_t status = tchecker::zg::final(*_system, *s, *t, semantics, extrapolation, final_edge);
+    if (status & mask) {
+      if (_sharing_type == tchecker::ts::SHARING) {
+        tchecker::zg::zg_t::share(s);
+        tchecker::zg::zg_t::share(t);
+      }
+      v.push_back(std::make_tuple(status, s, t));
+    }
+  }
+
+  /*!
+   \brief Previous state and transition from an incoming edge w.r.t. given semantics and extrapolation
+   \tparam SEMANTICS : type of zone semantics
+   \tparam EXTRAPOLATION : type of zone extrapolation
+   \param s : state
+   \param in_edge : incoming edge value
+   \param v : container
+   \param mask : mask on previous states
+   \param semantics : zone semantics
+   \param extrapolation : zone extrapolation
+   \pre semantics and extrapolation are the semantics and extrapolation of this zone graph
+   \post see prev(s, in_edge, v, mask)
+   */
+  template <class SEMANTICS, class EXTRAPOLATION>
+  void prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value_t const & in_edge, std::vector<sst_t> & v,
+            tchecker::state_status_t mask, SEMANTICS & semantics, EXTRAPOLATION & extrapolation)
+  {
+    tchecker::zg::state_sptr_t prevs = _state_allocator.clone(*s);
+    tchecker::zg::transition_sptr_t prevt = _transition_allocator.construct();
+    tchecker::state_status_t status = tchecker::zg::prev(*_system, *prevs, *prevt, semantics, extrapolation, in_edge);
+    if (status & mask) {
+      if (_sharing_type == tchecker::ts::SHARING) {
+        tchecker::zg::zg_t::share(prevs);
+        tchecker::zg::zg_t::share(prevt);
+      }
+      v.push_back(std::make_tuple(status, prevs, prevt));
+    }
+  }
+
 private:
   /*!
    \brief Clone and constrain a state
@@ -101,6 +101,18 @@ public:
   bool is_alu_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & l,
                  tchecker::clockbounds::map_t const & u) const;
 
+  /*!
+   \brief Checks inclusion wrt LU-d simulation
+   \param zone : a DBM zone
+   \param l : clock lower bounds
+   \param u : clock upper bounds
+   \param diagonals : diagonal constraints
+   \return true if every valuation in this zone is LU-d simulated by a valuation in zone, false otherwise
+   \pre l and u are clock bound maps over the clocks in zone, and diagonals are over the clocks in zone
+   */
+  bool is_alu_d_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & l,
+                   tchecker::clockbounds::map_t const & u, tchecker::clock_constraint_container_t const & diagonals) const;
+
   /*!
    \brief Lexical ordering
    \param zone : a DBM zone
@@ -14,7 +14,12 @@ namespace tchecker {
 namespace algorithms {
 namespace covreach {
 
-stats_t::stats_t() : _visited_states(0), _visited_transitions(0), _covered_states(0), _stored_states(0), _reachable(false) {}
+stats_t::stats_t()
+    : _visited_states(0), _visited_transitions(0), _covered_states(0), _stored_states(0), _saved_tightens(0),
+      _storage_bytes(0), _spilled_bytes(0), _signature_checks(0), _signature_rejections(0),
+      _signature_misses(0), _reachable(false)
+{
+}
 
 unsigned long & stats_t::visited_states() { return _visited_states; }
 
@@ -32,6 +37,30 @@ unsigned long & stats_t::stored_states() { return _stored_states; }
 
 unsigned long stats_t::stored_states() const { return _stored_states; }
 
+unsigned long & stats_t::saved_tightens() { return _saved_tightens; }
+
+unsigned long stats_t::saved_tightens() const { return _saved_tightens; }
+
+unsigned long & stats_t::storage_bytes() { return _storage_bytes; }
+
+unsigned long stats_t::storage_bytes() const { return _storage_bytes; }
+
+unsigned long & stats_t::spilled_bytes() { return _spilled_bytes; }
+
+unsigned long stats_t::spilled_bytes() const { return _spilled_bytes; }
+
+unsigned long & stats_t::signature_checks() { return _signature_checks; }
+
+unsigned long stats_t::signature_checks() const { return _signature_checks; }
+
+unsigned long & stats_t::signature_rejections() { return _signature_rejections; }
+
+unsigned long stats_t::signature_rejections() const { return _signature_rejections; }
+
+unsigned long & stats_t::signature_misses() { return _signature_misses; }
+
+unsigned long stats_t::signature_misses() const { return _signature_misses; }
+
 bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
@@ -57,11 +86,49 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream << _stored_states;
   m["STORED_STATES"] = sstream.str();
 
+  if (_spilled_bytes > 0) {
+    sstream.str("");
+    sstream << _spilled_bytes;
+    m["SPILLED_BYTES"] = sstream.str();
+  }
+
   sstream.str("");
   sstream << std::boolalpha << _reachable;
   m["REACHABLE"] = sstream.str();
 }
 
+void stats_t::detailed_attributes(std::map<std::string, std::string> & m) const
+{
+  std::stringstream sstream;
+
+  sstream << _saved_tightens;
+  m["SAVED_TIGHTENS"] = sstream.str();
+
+  if (_storage_bytes > 0 && _stored_states > 0) {
+    sstream.str("");
+    sstream << _storage_bytes / _stored_states;
+    m["BYTES_PER_STORED_STATE"] = sstream.str();
+  }
+
+  if (_signature_checks > 0) {
+    sstream.str("");
+    sstream << _signature_checks;
+    m["SIGNATURE_CHECKS"] = sstream.str();
+
+    sstream.str("");
+    sstream << _signature_rejections;
+    m["SIGNATURE_REJECTIONS"] = sstream.str();
+
+    // Ratio of the failed covering checks that have been rejected on signatures
+    if (_signature_rejections + _signature_misses > 0) {
+      sstream.str("");
+      sstream << static_cast<double>(_signature_rejections) /
+                     static_cast<double>(_signature_rejections + _signature_misses);
+      m["SIGNATURE_HIT_RATE"] = sstream.str();
+    }
+  }
+}
+
 } // end of namespace covreach
 
 } // namespace algorithms
@@ -15,7 +15,7 @@ namespace algorithms {
 
 namespace reach {
 
-stats_t::stats_t() : _visited_states(0), _visited_transitions(0), _reachable(false) {}
+stats_t::stats_t() : _visited_states(0), _visited_transitions(0), _spilled_bytes(0), _reachable(false) {}
 
 unsigned long & stats_t::visited_states() { return _visited_states; }
 
@@ -25,6 +25,10 @@ unsigned long & stats_t::visited_transitions() { return _visited_transitions; }
 
 unsigned long stats_t::visited_transitions() const { return _visited_transitions; }
 
+unsigned long & stats_t::spilled_bytes() { return _spilled_bytes; }
+
+unsigned long stats_t::spilled_bytes() const { return _spilled_bytes; }
+
 bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
@@ -42,6 +46,12 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream << _visited_transitions;
   m["VISITED_TRANSITIONS"] = sstream.str();
 
+  if (_spilled_bytes > 0) {
+    sstream.str("");
+    sstream << _spilled_bytes;
+    m["SPILLED_BYTES"] = sstream.str();
+  }
+
   sstream.str("");
   sstream << std::boolalpha << _reachable;
   m["REACHABLE"] = sstream.str();
@@ -17,6 +17,8 @@ enum tchecker::waiting::policy_t waiting_policy(std::string const & search_order
     return tchecker::waiting::STACK;
   else if (search_order == "bfs")
     return tchecker::waiting::QUEUE;
+  else if (search_order == "random")
+    return tchecker::waiting::RANDOM;
   throw std::invalid_argument("Unknown search order: " + search_order);
 }
 
@@ -26,6 +28,8 @@ enum tchecker::waiting::policy_t fast_remove_waiting_policy(std::string const &
     return tchecker::waiting::FAST_REMOVE_STACK;
   else if (search_order == "bfs")
     return tchecker::waiting::FAST_REMOVE_QUEUE;
+  else if (search_order == "random")
+    return tchecker::waiting::FAST_REMOVE_RANDOM;
   throw std::invalid_argument("Unknown search order: " + search_order);
 }
 
@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
 #include <tuple>
 
@@ -239,6 +240,76 @@ std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_lu_map
   return os;
 }
 
+/* local_d_map_t */
+
+local_d_map_t::local_d_map_t(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock_nb) : _loc_nb(0), _clock_nb(0)
+{
+  resize(loc_nb, clock_nb);
+}
+
+void local_d_map_t::clear()
+{
+  _D.clear();
+  _loc_nb = 0;
+  _clock_nb = 0;
+}
+
+void local_d_map_t::resize(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock_nb)
+{
+  clear();
+  _loc_nb = loc_nb;
+  _clock_nb = clock_nb;
+  _D.resize(_loc_nb);
+}
+
+tchecker::loc_id_t local_d_map_t::loc_number() const { return _loc_nb; }
+
+tchecker::clock_id_t local_d_map_t::clock_number() const { return _clock_nb; }
+
+bool local_d_map_t::empty() const
+{
+  for (tchecker::clock_constraint_container_t const & d : _D)
+    if (!d.empty())
+      return false;
+  return true;
+}
+
+tchecker::clock_constraint_container_t & local_d_map_t::D(tchecker::loc_id_t id)
+{
+  assert(id < _loc_nb);
+  return _D[id];
+}
+
+tchecker::clock_constraint_container_t const & local_d_map_t::D(tchecker::loc_id_t id) const
+{
+  assert(id < _loc_nb);
+  return _D[id];
+}
+
+void local_d_map_t::bounds(tchecker::vloc_t const & vloc, tchecker::clock_constraint_container_t & D) const
+{
+  D.clear();
+  for (tchecker::loc_id_t id : vloc) {
+    assert(id < _loc_nb);
+    for (tchecker::clock_constraint_t const & c : _D[id])
+      if (std::find(D.begin(), D.end(), c) == D.end())
+        D.push_back(c);
+  }
+}
+
+std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::local_d_map_t const & map)
+{
+  tchecker::loc_id_t loc_nb = map.loc_number();
+  for (tchecker::loc_id_t l = 0; l < loc_nb; ++l) {
+    os << l << ": D=";
+    for (tchecker::clock_constraint_t const & c : map.D(l))
+      os << c << " ";
+    os << std::endl;
+  }
+
+  return os;
+}
+
 /* global_lu_map_t */
 
 global_lu_map_t::global_lu_map_t(tchecker::clock_id_t clock_nb) : _clock_nb(0), _L(nullptr), _U(nullptr) { resize(clock_nb); }
@@ -326,12 +397,13 @@ void global_lu_map_t::bounds(tchecker::clockbounds::map_t & L, tchecker::clockbo
   tchecker::clockbounds::update(U, *_U);
 }
 
-void global_lu_map_t::bounds(tchecker::loc_id_t id, tchecker::clockbounds::map_t & L, tchecker::clockbounds::map_t & U) const
+void global_lu_map_t::bounds(tchecker::loc_id_t /*id*/, tchecker::clockbounds::map_t & L,
+                             tchecker::clockbounds::map_t & U) const
 {
   bounds(L, U);
 }
 
-void global_lu_map_t::bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t & L,
+void global_lu_map_t::bounds(tchecker::vloc_t const & /*vloc*/, tchecker::clockbounds::map_t & L,
                              tchecker::clockbounds::map_t & U) const
 {
   bounds(L, U);
@@ -564,9 +636,12 @@ void global_m_map_t::bounds(tchecker::clockbounds::map_t & M) const
   tchecker::clockbounds::update(M, *_M);
 }
 
-void global_m_map_t::bounds(tchecker::loc_id_t id, tchecker::clockbounds::map_t & M) const { bounds(M); }
+void global_m_map_t::bounds(tchecker::loc_id_t /*id*/, tchecker::clockbounds::map_t & M) const { bounds(M); }
 
-void global_m_map_t::bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t & M) const { bounds(M); }
+void global_m_map_t::bounds(tchecker::vloc_t const & /*vloc*/, tchecker::clockbounds::map_t & M) const
+{
+  bounds(M);
+}
 
 std::ostream & operator<<(std::ostream & os, tchecker::clockbounds::global_m_map_t const & map)
 {
@@ -594,7 +669,8 @@ clockbounds_t::clockbounds_t(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clo
     : _global_lu(new tchecker::clockbounds::global_lu_map_t(clock_nb)),
       _global_m(new tchecker::clockbounds::global_m_map_t(clock_nb)),
       _local_lu(new tchecker::clockbounds::local_lu_map_t(loc_nb, clock_nb)),
-      _local_m(new tchecker::clockbounds::local_m_map_t(loc_nb, clock_nb))
+      _local_m(new tchecker::clockbounds::local_m_map_t(loc_nb, clock_nb)),
+      _local_d(new tchecker::clockbounds::local_d_map_t(loc_nb, clock_nb))
 {
 }
 
@@ -604,6 +680,7 @@ void clockbounds_t::clear()
   _global_m->clear();
   _local_lu->clear();
   _local_m->clear();
+  _local_d->clear();
 }
 
 void clockbounds_t::resize(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock_nb)
@@ -612,6 +689,7 @@ void clockbounds_t::resize(tchecker::loc_id_t loc_nb, tchecker::clock_id_t clock
   _local_lu->resize(loc_nb, clock_nb);
   _global_m->resize(clock_nb);
   _local_m->resize(loc_nb, clock_nb);
+  _local_d->resize(loc_nb, clock_nb);
 }
 
 std::shared_ptr<tchecker::clockbounds::global_lu_map_t const> clockbounds_t::global_lu_map() const { return _global_lu; }
@@ -630,6 +708,10 @@ std::shared_ptr<tchecker::clockbounds::local_m_map_t const> clockbounds_t::local
 
 std::shared_ptr<tchecker::clockbounds::local_m_map_t> clockbounds_t::local_m_map() { return _local_m; }
 
+std::shared_ptr<tchecker::clockbounds::local_d_map_t const> clockbounds_t::local_d_map() const { return _local_d; }
+
+std::shared_ptr<tchecker::clockbounds::local_d_map_t> clockbounds_t::local_d_map() { return _local_d; }
+
 } // namespace clockbounds
 
 } // namespace tchecker
@@ -24,7 +24,7 @@ df_solver_t::df_solver_t(tchecker::ta::system_t const & system)
     : _loc_number(system.locations_count()), _clock_number(system.clock_variables().size(tchecker::VK_FLATTENED)),
       _loc_pid(_loc_number, 0),
       _dim(1 + _loc_number * _clock_number), // 1 variable for each clock in each location, plus 1 for dummy clock 0
-      _L(nullptr), _U(nullptr), _updated_L(false), _updated_U(false)
+      _L(nullptr), _U(nullptr), _updated_L(false), _updated_U(false), _D(_loc_number), _updated_D(false)
 {
   if ((_loc_number > 0) && (_clock_number > 0) && ((_dim < _loc_number) || (_dim < _clock_number)))
     throw std::invalid_argument("invalid number of clocks or locations (overflow)");
@@ -39,7 +39,8 @@ df_solver_t::df_solver_t(tchecker::ta::system_t const & system)
 
 df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t const & solver)
     : _loc_number(solver._loc_number), _clock_number(solver._clock_number), _loc_pid(solver._loc_pid), _dim(solver._dim),
-      _L(nullptr), _U(nullptr), _updated_L(solver._updated_L), _updated_U(solver._updated_U)
+      _L(nullptr), _U(nullptr), _updated_L(solver._updated_L), _updated_U(solver._updated_U), _D(solver._D),
+      _edges(solver._edges), _updated_D(solver._updated_D)
 {
   _L = new tchecker::dbm::db_t[_dim * _dim];
   _U = new tchecker::dbm::db_t[_dim * _dim];
@@ -50,7 +51,8 @@ df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t const & solver)
 df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t && solver)
     : _loc_number(std::move(solver._loc_number)), _clock_number(std::move(solver._clock_number)),
       _loc_pid(std::move(solver._loc_pid)), _dim(std::move(solver._dim)), _L(std::move(solver._L)), _U(std::move(solver._U)),
-      _updated_L(std::move(solver._updated_L)), _updated_U(std::move(solver._updated_U))
+      _updated_L(std::move(solver._updated_L)), _updated_U(std::move(solver._updated_U)), _D(std::move(solver._D)),
+      _edges(std::move(solver._edges)), _updated_D(std::move(solver._updated_D))
 {
   solver._loc_number = 0;
   solver._clock_number = 0;
@@ -59,6 +61,7 @@ df_solver_t::df_solver_t(tchecker::clockbounds::df_solver_t && solver)
   solver._U = nullptr;
   solver._updated_L = false;
   solver._updated_U = false;
+  solver._updated_D = false;
 }
 
 df_solver_t::~df_solver_t()
@@ -85,6 +88,9 @@ tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbound
 
     _updated_L = solver._updated_L;
     _updated_U = solver._updated_U;
+    _D = solver._D;
+    _edges = solver._edges;
+    _updated_D = solver._updated_D;
   }
 
   return *this;
@@ -101,6 +107,9 @@ tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbound
     _U = std::move(solver._U);
     _updated_L = std::move(solver._updated_L);
     _updated_U = std::move(solver._updated_U);
+    _D = std::move(solver._D);
+    _edges = std::move(solver._edges);
+    _updated_D = std::move(solver._updated_D);
 
     solver._loc_number = 0;
     solver._clock_number = 0;
@@ -109,6 +118,7 @@ tchecker::clockbounds::df_solver_t & df_solver_t::operator=(tchecker::clockbound
     solver._U = nullptr;
     solver._updated_L = false;
     solver._updated_U = false;
+    solver._updated_D = false;
   }
 
   return *this;
@@ -132,6 +142,11 @@ void df_solver_t::clear()
 
   _updated_L = false;
   _updated_U = false;
+
+  for (std::set<diagonal_t> & d : _D)
+    d.clear();
+  _edges.clear();
+  _updated_D = false;
 }
 
 void df_solver_t::add_lower_bound_guard(tchecker::loc_id_t l, tchecker::clock_id_t x, tchecker::integer_t c)
@@ -179,6 +194,27 @@ void df_solver_t::add_assignment(tchecker::loc_id_t l1, tchecker::loc_id_t l2, t
     }
 }
 
+void df_solver_t::add_diagonal_guard(tchecker::loc_id_t l, tchecker::clock_id_t x, tchecker::clock_id_t y,
+                                     tchecker::ineq_cmp_t cmp, tchecker::integer_t c)
+{
+  assert(l < _loc_number);
+  assert(x < _clock_number);
+  assert(y < _clock_number);
+  assert(x != y);
+  if (_D[l].insert(std::make_tuple(x, y, c, cmp)).second)
+    _updated_D = true;
+}
+
+void df_solver_t::add_edge_updates(tchecker::loc_id_t l1, tchecker::loc_id_t l2,
+                                   std::vector<std::vector<std::pair<tchecker::clock_id_t, tchecker::integer_t>>> const & updates)
+{
+  assert(l1 < _loc_number);
+  assert(l2 < _loc_number);
+  assert(updates.size() == _clock_number);
+  _edges.push_back(edge_updates_t{l1, l2, updates});
+  _updated_D = true;
+}
+
 bool df_solver_t::solve(tchecker::clockbounds::local_lu_map_t & map)
 {
   if (_clock_number != map.clock_number())
@@ -186,6 +222,8 @@ bool df_solver_t::solve(tchecker::clockbounds::local_lu_map_t & map)
   if (_loc_number != map.loc_number())
     throw std::invalid_argument("*** solve: invalid number of locations");
 
+  solve_diagonals();
+
   bool consistent = ensure_tight();
   if (!consistent)
     return false;
@@ -199,6 +237,26 @@ bool df_solver_t::solve(tchecker::clockbounds::local_lu_map_t & map)
   return true;
 }
 
+bool df_solver_t::solve(tchecker::clockbounds::local_lu_map_t & lu_map, tchecker::clockbounds::local_d_map_t & d_map)
+{
+  if (_clock_number != d_map.clock_number())
+    throw std::invalid_argument("*** solve: invalid number of clocks");
+  if (_loc_number != d_map.loc_number())
+    throw std::invalid_argument("*** solve: invalid number of locations");
+
+  if (!solve(lu_map))
+    return false;
+
+  for (tchecker::loc_id_t loc = 0; loc < _loc_number; ++loc) {
+    tchecker::clock_constraint_container_t & D = d_map.D(loc);
+    D.clear();
+    for (auto && [x, y, c, cmp] : _D[loc])
+      D.emplace_back(x, y, cmp, c);
+  }
+
+  return true;
+}
+
 std::size_t df_solver_t::index(tchecker::loc_id_t l, tchecker::clock_id_t x) const
 {
   assert(l < _loc_number);
@@ -263,6 +321,118 @@ bool df_solver_t::ensure_tight()
   return consistent;
 }
 
+bool df_solver_t::propagate_diagonal(edge_updates_t const & e, diagonal_t const & d, bool only_updated,
+                                     tchecker::integer_t limit)
+{
+  auto && [x, y, c, cmp] = d;
+  bool added = false;
+
+  // x - y # c with x := z + k and y := w + m yields (z + k) - (w + m) # c
+  for (auto && [z, k] : e.updates[x])
+    for (auto && [w, m] : e.updates[y]) {
+      if (only_updated && z == x && k == 0 && w == y && m == 0)
+        continue;
+
+      if (z != tchecker::REFCLOCK_ID && w != tchecker::REFCLOCK_ID) {
+        if (z == w)
+          continue; // constant
+        tchecker::integer_t const value = c - k + m; // z - w # c - k + m
+        if (value > limit || value < -limit)
+          throw std::runtime_error("compute_clockbounds: diagonal clock bounds cannot be computed (updates diverge)");
+        added |= _D[e.src].insert(std::make_tuple(z, w, value, cmp)).second;
+      }
+      else if (z == tchecker::REFCLOCK_ID && w != tchecker::REFCLOCK_ID) {
+        tchecker::integer_t const value = k - m - c; // w > k - m - c (or >=)
+        if (value >= 0)
+          add_lower_bound_guard(e.src, w, value);
+      }
+      else if (z != tchecker::REFCLOCK_ID && w == tchecker::REFCLOCK_ID) {
+        tchecker::integer_t const value = c - k + m; // z < c - k + m (or <=)
+        if (value >= 0)
+          add_upper_bound_guard(e.src, z, value);
+      }
+    }
+
+  return added;
+}
+
+void df_solver_t::solve_diagonals()
+{
+  if (!_updated_D)
+    return;
+  _updated_D = false;
+
+  // Constants in diagonal constraints only change along updates x := y + k with k != 0. Without a cycle of such
+  // updates, they are obtained along paths of at most _loc_number * _clock_number^2 edges
+  tchecker::integer_t max_constant = 0, max_shift = 0;
+  for (std::set<diagonal_t> const & D : _D)
+    for (auto && [x, y, c, cmp] : D)
+      max_constant = std::max(max_constant, (c < 0 ? -c : c));
+  for (edge_updates_t const & e : _edges)
+    for (auto const & updates : e.updates)
+      for (auto && [y, k] : updates)
+        if (y != tchecker::REFCLOCK_ID)
+          max_shift = std::max(max_shift, (k < 0 ? -k : k));
+  tchecker::integer_t limit = tchecker::clockbounds::MAX_BOUND;
+  if (max_shift == 0)
+    limit = max_constant;
+  else if (static_cast<double>(max_constant) +
+               2.0 * static_cast<double>(max_shift) *
+                   (static_cast<double>(_loc_number) * _clock_number * _clock_number + 1.0) <
+           static_cast<double>(limit))
+    limit = max_constant + 2 * max_shift * (static_cast<tchecker::integer_t>(_loc_number) * _clock_number * _clock_number + 1);
+
+  // Edges with target l, and edges that update some clock
+  std::vector<std::vector<std::size_t>> incoming(_loc_number);
+  std::vector<std::size_t> updating;
+  for (std::size_t i = 0; i < _edges.size(); ++i) {
+    incoming[_edges[i].tgt].push_back(i);
+    for (tchecker::clock_id_t x = 0; x < _clock_number; ++x)
+      if (std::any_of(_edges[i].updates[x].begin(), _edges[i].updates[x].end(),
+                      [&](auto const & u) { return u.first != x || u.second != 0; })) {
+        updating.push_back(i);
+        break;
+      }
+  }
+
+  std::vector<tchecker::loc_id_t> waiting;
+  std::vector<bool> in_waiting(_loc_number, false);
+  for (tchecker::loc_id_t l = 0; l < _loc_number; ++l)
+    if (!_D[l].empty()) {
+      waiting.push_back(l);
+      in_waiting[l] = true;
+    }
+
+  while (!waiting.empty()) {
+    tchecker::loc_id_t const l = waiting.back();
+    waiting.pop_back();
+    in_waiting[l] = false;
+
+    std::vector<diagonal_t> const D(_D[l].begin(), _D[l].end());
+    auto push = [&](tchecker::loc_id_t src) {
+      if (!in_waiting[src]) {
+        waiting.push_back(src);
+        in_waiting[src] = true;
+      }
+    };
+
+    // Backward propagation over edges to l
+    for (std::size_t i : incoming[l])
+      for (diagonal_t const & d : D)
+        if (propagate_diagonal(_edges[i], d, false, limit))
+          push(_edges[i].src);
+
+    // Propagation over updates of shared clocks in other processes
+    for (std::size_t i : updating) {
+      if (_loc_pid[_edges[i].src] == _loc_pid[l])
+        continue;
+      for (diagonal_t const & d : D)
+        if (propagate_diagonal(_edges[i], d, true, limit))
+          push(_edges[i].src);
+    }
+  }
+}
+
 /*!
 \class df_solver_expr_updater_t
 \brief Update solver constraints from expressions
@@ -383,14 +553,46 @@ public:
     }
   }
 
-  // diagonal constraints are not supported 
   /*!
   \brief Visitor
-  \throw std::runtime_error : as diagonal constraints are not supported by diagonal-free solver
+  \post If expr is a diagonal constraint x - y # c, then the constraint has been added to _solver for every clocks x
+  and y (x and y could be arrays) as x - y < c or x - y <= c (using method add_diagonal_guard). Constraints x - y > c
+  and x - y >= c are added as y - x < -c and y - x <= -c, and x - y == c as both x - y <= c and y - x <= -c.
+  \throw std::runtime_error : if the bound c is not a constant
   */
   virtual void visit(tchecker::typed_diagonal_clkconstr_expression_t const & expr) override
   {
-    throw std::runtime_error("unsupported diagonal constraints");
+    tchecker::range_t<tchecker::clock_id_t> first_clocks = tchecker::extract_lvalue_variable_ids(expr.first_clock());
+    tchecker::range_t<tchecker::clock_id_t> second_clocks = tchecker::extract_lvalue_variable_ids(expr.second_clock());
+    if (!tchecker::has_const_value(expr.bound()))
+      throw std::runtime_error("diagonal clock constraint with non-constant bound");
+    tchecker::integer_t bound = tchecker::const_evaluate(expr.bound());
+
+    for (tchecker::clock_id_t x = first_clocks.begin(); x != first_clocks.end(); ++x)
+      for (tchecker::clock_id_t y = second_clocks.begin(); y != second_clocks.end(); ++y) {
+        if (x == y)
+          continue;
+        switch (expr.binary_operator()) {
+        case tchecker::EXPR_OP_LT:
+          _solver->add_diagonal_guard(_src, x, y, tchecker::LT, bound);
+          break;
+        case tchecker::EXPR_OP_LE:
+          _solver->add_diagonal_guard(_src, x, y, tchecker::LE, bound);
+          break;
+        case tchecker::EXPR_OP_EQ:
+          _solver->add_diagonal_guard(_src, x, y, tchecker::LE, bound);
+          _solver->add_diagonal_guard(_src, y, x, tchecker::LE, -bound);
+          break;
+        case tchecker::EXPR_OP_GE:
+          _solver->add_diagonal_guard(_src, y, x, tchecker::LE, -bound);
+          break;
+        case tchecker::EXPR_OP_GT:
+          _solver->add_diagonal_guard(_src, y, x, tchecker::LT, -bound);
+          break;
+        default:
+          break;
+        }
+      }
   }
 
   // Other visitors
@@ -428,30 +630,26 @@ void add_edge_constraints(tchecker::typed_expression_t const & guard, tchecker::
   tchecker::clock_id_t const clock_nb = solver->clock_number();
   tchecker::clock_updates_map_t clock_updates = tchecker::compute_clock_updates(clock_nb, stmt);
 
+  std::vector<std::vector<std::pair<tchecker::clock_id_t, tchecker::integer_t>>> updates(clock_nb);
   for (tchecker::clock_id_t x = 0; x < clock_nb; ++x) {
     if (clock_updates[x].empty())
       throw std::runtime_error("Cannot compute clock updates from statement");
     for (auto && up : clock_updates[x]) {
       tchecker::integer_t v = tchecker::const_evaluate(up.value(), 0); // 0 yields the strongest constraint on clock bounds
       solver->add_assignment(src, tgt, x, up.clock_id(), v);
+      updates[x].emplace_back(up.clock_id(), v);
     }
   }
+  solver->add_edge_updates(src, tgt, updates);
 }
 
 /* compute_clockbounds */
 
 void compute_clockbounds(tchecker::ta::system_t const & system, tchecker::clockbounds::clockbounds_t & clockbounds)
 {
-  // 实现对角约束检测；当存在 diagonal guard/invariant 时只调整尺寸并发出 warning，而不是继续求解 LU。
   clockbounds.resize(static_cast<tchecker::loc_id_t>(system.locations_count()),
                      static_cast<tchecker::clock_id_t>(system.clocks_count(tchecker::VK_FLATTENED)));
 
-  if (tchecker::ta::has_diagonal_constraint(system)) {
-    std::cerr << tchecker::log_warning << "diagonal clock constraints detected: LU/M bounds left unconstrained"
-              << std::endl;
-    return;
-  }
-
   std::shared_ptr<tchecker::clockbounds::df_solver_t> solver{new tchecker::clockbounds::df_solver_t{system}};
 
   for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
@@ -461,7 +659,7 @@ void compute_clockbounds(tchecker::ta::system_t const & system, tchecker::clockb
     tchecker::clockbounds::add_edge_constraints(system.guard(edge->id()), system.statement(edge->id()), edge->src(),
                                                 edge->tgt(), solver);
 
-  bool const has_solution = solver->solve(*clockbounds.local_lu_map());
+  bool const has_solution = solver->solve(*clockbounds.local_lu_map(), *clockbounds.local_d_map());
   if (!has_solution)
     throw std::runtime_error("compute_clockbounds: clock bounds cannot be computed");
 
@@ -5,8 +5,11 @@
  *
  */
 
+#include <algorithm>
+#include <bitset>
 #include <cassert>
 #include <numeric>
+#include <vector>
 
 #if BOOST_VERSION <= 106600
 #include <boost/functional/hash.hpp>
@@ -15,6 +18,7 @@
 #endif
 
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/details/simd_kernels.hh"
 #include "tchecker/utils/ordering.hh"
 
 namespace tchecker {
@@ -28,6 +32,39 @@ namespace dbm {
 #define L(i)       (i == 0 ? 0 : l[i - 1])
 #define U(i)       (i == 0 ? 0 : u[i - 1])
 
+/*!
+ \brief Accessor
+ \param dbm : a DBM
+ \return packed representation of dbm
+ \note only valid when vectorized kernels are selected (see tchecker/dbm/simd.hh)
+ */
+static inline tchecker::dbm::simd::details::packed_db_t * packed(tchecker::dbm::db_t * dbm)
+{
+  return reinterpret_cast<tchecker::dbm::simd::details::packed_db_t *>(dbm);
+}
+
+/*!
+ \brief Accessor
+ \param dbm : a DBM
+ \return packed representation of dbm
+ \note only valid when vectorized kernels are selected (see tchecker/dbm/simd.hh)
+ */
+static inline tchecker::dbm::simd::details::packed_db_t const * packed(tchecker::dbm::db_t const * dbm)
+{
+  return reinterpret_cast<tchecker::dbm::simd::details::packed_db_t const *>(dbm);
+}
+
+/*!
+ \brief Accessor
+ \param bounds : clock bounds
+ \return bounds as 32 bits integers
+ \note only valid when vectorized kernels are selected (see tchecker/dbm/simd.hh)
+ */
+static inline std::int32_t const * packed_bounds(tchecker::integer_t const * bounds)
+{
+  return reinterpret_cast<std::int32_t const *>(bounds);
+}
+
 void copy(tchecker::dbm::db_t * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
 {
   std::memcpy(dbm1, dbm2, dim * dim * sizeof(*dbm2));
@@ -169,6 +206,19 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
   assert(dbm != nullptr);
   assert(dim >= 1);
 
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::kernels(dim);
+  if (kernels != nullptr) {
+    int const status = kernels->tighten(tchecker::dbm::packed(dbm), dim);
+    if (status == 0)
+      return tchecker::dbm::EMPTY;
+    if (status == 1) {
+      assert(tchecker::dbm::is_consistent(dbm, dim));
+      assert(tchecker::dbm::is_tight(dbm, dim));
+      return tchecker::dbm::NON_EMPTY;
+    }
+    // otherwise, some sum cannot be represented: let scalar code report the error
+  }
+
   for (tchecker::clock_id_t k = 0; k < dim; ++k) {
     for (tchecker::clock_id_t i = 0; i < dim; ++i) {
       if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
@@ -216,6 +266,46 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
   return tchecker::dbm::MAY_BE_EMPTY;
 }
 
+/*!
+ \brief Tighten a DBM w.r.t. one intermediate clock
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param k : a clock
+ \pre 0 <= k < dim
+ \post every bound i->j in dbm is at most i->k->j
+ \return false if dbm has been found empty (and then the bound in (0,0) is <0), true otherwise
+ */
+static bool tighten_pivot(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t k)
+{
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
+      continue;
+    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+      DBM(i, j) = tchecker::dbm::min(tchecker::dbm::sum(DBM(i, k), DBM(k, j)), DBM(i, j));
+    if (DBM(i, i) < tchecker::dbm::LE_ZERO) {
+      DBM(0, 0) = tchecker::dbm::LT_ZERO;
+      return false;
+    }
+  }
+  return true;
+}
+
+enum tchecker::dbm::status_t tighten_clocks(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                            tchecker::clock_id_t const * clocks, tchecker::clock_id_t count)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+
+  for (tchecker::clock_id_t c = 0; c < count; ++c) {
+    assert(clocks[c] < dim);
+    if (!tighten_pivot(dbm, dim, clocks[c]))
+      return tchecker::dbm::EMPTY;
+  }
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  return tchecker::dbm::NON_EMPTY;
+}
+
 enum tchecker::dbm::status_t constrain(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x,
                                        tchecker::clock_id_t y, tchecker::ineq_cmp_t cmp, tchecker::integer_t value)
 {
@@ -280,6 +370,10 @@ bool is_equal(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::kernels(dim);
+  if (kernels != nullptr)
+    return kernels->is_equal(tchecker::dbm::packed(dbm1), tchecker::dbm::packed(dbm2), dim);
+
   for (tchecker::clock_id_t i = 0; i < dim; ++i)
     for (tchecker::clock_id_t j = 0; j < dim; ++j)
       if (DBM1(i, j) != DBM2(i, j))
@@ -324,6 +418,10 @@ bool is_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, t
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::kernels(dim);
+  if (kernels != nullptr)
+    return kernels->is_le(tchecker::dbm::packed(dbm1), tchecker::dbm::packed(dbm2), dim);
+
   // 逐项比较 DBM 约束：只有当 dbm1 中每个 xi-xj 上界都不大于 dbm2 的对应值时才算包含
   for (tchecker::clock_id_t i = 0; i < dim; ++i)
     for (tchecker::clock_id_t j = 0; j < dim; ++j)
@@ -500,6 +598,14 @@ void open_down(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
 
 enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
                                           tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
+{
+  tchecker::clock_id_t pivots;
+  return tchecker::dbm::intersection(dbm, dbm1, dbm2, dim, pivots);
+}
+
+enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
+                                          tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                                          tchecker::clock_id_t & pivots)
 {
   assert(dim >= 1);
   assert(dbm != nullptr);
@@ -510,11 +616,39 @@ enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::d
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+  if (dim > tchecker::dbm::INTERSECTION_PIVOTS_MAX_DIM) {
+    for (tchecker::clock_id_t i = 0; i < dim; ++i)
+      for (tchecker::clock_id_t j = 0; j < dim; ++j)
+        DBM(i, j) = tchecker::dbm::min(DBM1(i, j), DBM2(i, j));
+    pivots = dim;
+    return tchecker::dbm::tighten(dbm, dim);
+  }
+
+  // The intersection is obtained from dbm1 (resp. dbm2) by strengthening the bounds that
+  // are smaller in dbm2 (resp. dbm1). Tighten w.r.t. the clocks in the smallest set
+  std::bitset<tchecker::dbm::INTERSECTION_PIVOTS_MAX_DIM> clocks1, clocks2;
   for (tchecker::clock_id_t i = 0; i < dim; ++i)
-    for (tchecker::clock_id_t j = 0; j < dim; ++j)
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if (DBM2(i, j) < DBM1(i, j)) {
+        clocks1.set(i);
+        clocks1.set(j);
+      }
+      else if (DBM1(i, j) < DBM2(i, j)) {
+        clocks2.set(i);
+        clocks2.set(j);
+      }
       DBM(i, j) = tchecker::dbm::min(DBM1(i, j), DBM2(i, j));
+    }
 
-  return tchecker::dbm::tighten(dbm, dim);
+  std::bitset<tchecker::dbm::INTERSECTION_PIVOTS_MAX_DIM> const & clocks =
+      (clocks1.count() <= clocks2.count() ? clocks1 : clocks2);
+  pivots = static_cast<tchecker::clock_id_t>(clocks.count());
+  for (tchecker::clock_id_t k = 0; k < dim; ++k)
+    if (clocks.test(k) && !tighten_pivot(dbm, dim, k))
+      return tchecker::dbm::EMPTY;
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  return tchecker::dbm::NON_EMPTY;
 }
 
 void extra_m(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * m)
@@ -525,6 +659,20 @@ void extra_m(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::inte
   assert(tchecker::dbm::is_positive(dbm, dim));
   assert(tchecker::dbm::is_tight(dbm, dim));
 
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::kernels(dim);
+  if (kernels != nullptr) {
+    int const modified = kernels->extra_lu(tchecker::dbm::packed(dbm), dim, tchecker::dbm::packed_bounds(m),
+                                           tchecker::dbm::packed_bounds(m));
+    if (modified >= 0) {
+      if (modified == 1)
+        tchecker::dbm::tighten(dbm, dim);
+      assert(tchecker::dbm::is_consistent(dbm, dim));
+      assert(tchecker::dbm::is_positive(dbm, dim));
+      assert(tchecker::dbm::is_tight(dbm, dim));
+      return;
+    }
+  }
+
   bool modified = false;
 
   // let DBM(i,j) be (#,cij)
@@ -667,6 +815,20 @@ void extra_lu(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::int
   assert(tchecker::dbm::is_positive(dbm, dim));
   assert(tchecker::dbm::is_tight(dbm, dim));
 
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::kernels(dim);
+  if (kernels != nullptr) {
+    int const modified = kernels->extra_lu(tchecker::dbm::packed(dbm), dim, tchecker::dbm::packed_bounds(l),
+                                           tchecker::dbm::packed_bounds(u));
+    if (modified >= 0) {
+      if (modified == 1)
+        tchecker::dbm::tighten(dbm, dim);
+      assert(tchecker::dbm::is_consistent(dbm, dim));
+      assert(tchecker::dbm::is_positive(dbm, dim));
+      assert(tchecker::dbm::is_tight(dbm, dim));
+      return;
+    }
+  }
+
   bool modified = false;
 
   // let DBM(i,j) be (#,cij)
@@ -809,6 +971,73 @@ void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker
   assert(tchecker::dbm::is_tight(dbm, dim));
 }
 
+void extra_lu_plus(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                   tchecker::integer_t const * u, boost::dynamic_bitset<> const & exact)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(exact.size() == static_cast<std::size_t>(dim - 1));
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_positive(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+
+  bool modified = false;
+
+  // Same as extra_lu_plus where L(i) and U(i) are infinite for the clocks i in exact (see above): the 1st and 2nd
+  // cases never apply to their lines, and the 3rd and 4th cases never apply to their columns
+#define EXACT(i) (i != 0 && exact[i - 1])
+
+  for (tchecker::clock_id_t i = 1; i < dim; ++i) {
+    bool const exact_i = EXACT(i);
+    tchecker::integer_t Li = L(i);
+    assert(Li < tchecker::dbm::INF_VALUE);
+    assert(U(i) < tchecker::dbm::INF_VALUE);
+
+    tchecker::integer_t c0i = tchecker::dbm::value(DBM(0, i));
+    bool const line_unbounded = (!exact_i && -c0i > Li); // 2nd case
+
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if (i == j)
+        continue;
+      if (DBM(i, j) == tchecker::dbm::LT_INFINITY)
+        continue;
+
+      if (!line_unbounded) { // 1st and 3rd cases
+        tchecker::integer_t c0j = tchecker::dbm::value(DBM(0, j));
+        tchecker::integer_t cij = tchecker::dbm::value(DBM(i, j));
+        if ((exact_i || cij <= Li) && (EXACT(j) || -c0j <= U(j)))
+          continue;
+      }
+
+      DBM(i, j) = tchecker::dbm::LT_INFINITY;
+      modified = true;
+    }
+  }
+
+  // i = 0, only the 4th case apply
+  for (tchecker::clock_id_t j = 1; j < dim; ++j) {
+    if (EXACT(j))
+      continue;
+    tchecker::integer_t Uj = U(j);
+    assert(Uj < tchecker::dbm::INF_VALUE);
+
+    tchecker::integer_t c0j = tchecker::dbm::value(DBM(0, j));
+    if (-c0j > Uj) {
+      DBM(0, j) = (Uj == -tchecker::dbm::INF_VALUE ? tchecker::dbm::LE_ZERO : tchecker::dbm::db(tchecker::LT, -Uj));
+      modified = true;
+    }
+  }
+
+#undef EXACT
+
+  if (modified)
+    tchecker::dbm::tighten(dbm, dim);
+
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_positive(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+}
+
 bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
                tchecker::integer_t const * l, tchecker::integer_t const * u)
 {
@@ -822,6 +1051,14 @@ bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm
   assert(tchecker::dbm::is_tight(dbm1, dim));
   assert(tchecker::dbm::is_tight(dbm2, dim));
 
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::kernels(dim);
+  if (kernels != nullptr) {
+    int const le = kernels->is_alu_le(tchecker::dbm::packed(dbm1), tchecker::dbm::packed(dbm2), dim,
+                                      tchecker::dbm::packed_bounds(l), tchecker::dbm::packed_bounds(u));
+    if (le >= 0)
+      return (le == 1);
+  }
+
   // dbm1 not included in aLU(dbm2) if there is x and y s.t.
   //     dbm1[0x] >= (<= -U(x))
   // &&  dbm2[yx] < dbm1[yx]
@@ -859,12 +1096,291 @@ bool is_alu_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm
   return true;
 }
 
+/*!
+ \brief Checks inclusion w.r.t. LU-d simulation from a given diagonal constraint
+ \param dbm1 : a first dbm
+ \param dbm2 : a second dbm
+ \param dim : dimension of dbm1 and dbm2
+ \param l : clock lower bounds for clocks 1 to dim-1
+ \param u : clock upper bounds for clocks 1 to dim-1
+ \param diagonals : diagonal clock constraints
+ \param k : index of the first diagonal constraint to consider
+ \param buffer : scratch DBMs, 2 * dim * dim for each diagonal constraint from k on
+ \pre see tchecker::dbm::is_alu_d_le
+ \return true if dbm1 is included in dbm2 w.r.t. LU-d simulation for l, u and the diagonal constraints from k on,
+ false otherwise
+ */
+static bool is_alu_d_le_split(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+                              tchecker::clock_id_t dim, tchecker::integer_t const * l, tchecker::integer_t const * u,
+                              tchecker::clock_constraint_container_t const & diagonals, std::size_t k,
+                              tchecker::dbm::db_t * buffer)
+{
+  // Skip diagonal constraints phi that hold on dbm2, or that do not hold on any valuation in dbm1: the
+  // simulation of valuations in dbm1 by valuations in dbm2 preserves phi
+  std::size_t const n = diagonals.size();
+  tchecker::clock_id_t x = 0, y = 0;
+  tchecker::dbm::db_t phi = tchecker::dbm::LE_ZERO;
+  for (; k < n; ++k) {
+    assert(diagonals[k].id1() != tchecker::REFCLOCK_ID);
+    assert(diagonals[k].id2() != tchecker::REFCLOCK_ID);
+    x = diagonals[k].id1() + 1;
+    y = diagonals[k].id2() + 1;
+    phi = tchecker::dbm::db(diagonals[k].comparator(), diagonals[k].value());
+    if (DBM2(x, y) <= phi)
+      continue;
+    if (tchecker::dbm::sum(DBM1(y, x), phi) < tchecker::dbm::LE_ZERO)
+      continue;
+    break;
+  }
+
+  if (k == n)
+    return tchecker::dbm::is_alu_le(dbm1, dbm2, dim, l, u);
+
+  std::size_t const size = static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim);
+  tchecker::dbm::db_t * part1 = buffer;
+  tchecker::dbm::db_t * part2 = buffer + size;
+  tchecker::dbm::db_t * next = buffer + 2 * size;
+
+  // Valuations in dbm1 that satisfy phi should be simulated by valuations in dbm2 that satisfy phi
+  tchecker::dbm::copy(part2, dbm2, dim);
+  if (tchecker::dbm::constrain(part2, dim, x, y, diagonals[k].comparator(), diagonals[k].value()) == tchecker::dbm::EMPTY)
+    return false;
+
+  if (DBM1(x, y) <= phi)
+    return is_alu_d_le_split(dbm1, part2, dim, l, u, diagonals, k + 1, next);
+
+  tchecker::dbm::copy(part1, dbm1, dim);
+  tchecker::dbm::constrain(part1, dim, x, y, diagonals[k].comparator(), diagonals[k].value());
+  if (!is_alu_d_le_split(part1, part2, dim, l, u, diagonals, k + 1, next))
+    return false;
+
+  // Valuations in dbm1 that do not satisfy phi can be simulated by any valuation in dbm2
+  tchecker::ineq_cmp_t const neg_cmp = (diagonals[k].comparator() == tchecker::LE ? tchecker::LT : tchecker::LE);
+  tchecker::dbm::copy(part1, dbm1, dim);
+  tchecker::dbm::constrain(part1, dim, y, x, neg_cmp, -diagonals[k].value());
+  return is_alu_d_le_split(part1, dbm2, dim, l, u, diagonals, k + 1, next);
+}
+
+bool is_alu_d_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
+                 tchecker::integer_t const * l, tchecker::integer_t const * u,
+                 tchecker::clock_constraint_container_t const & diagonals)
+{
+  assert(dbm1 != nullptr);
+  assert(dbm2 != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::is_consistent(dbm1, dim));
+  assert(tchecker::dbm::is_consistent(dbm2, dim));
+  assert(tchecker::dbm::is_positive(dbm1, dim));
+  assert(tchecker::dbm::is_positive(dbm2, dim));
+  assert(tchecker::dbm::is_tight(dbm1, dim));
+  assert(tchecker::dbm::is_tight(dbm2, dim));
+
+  if (diagonals.empty())
+    return tchecker::dbm::is_alu_le(dbm1, dbm2, dim, l, u);
+
+  // Scratch DBMs are kept from one call to the next
+  static thread_local std::vector<tchecker::dbm::db_t> buffer;
+  std::size_t const size = 2 * static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim) * diagonals.size();
+  if (buffer.size() < size)
+    buffer.resize(size);
+  return tchecker::dbm::is_alu_d_le_split(dbm1, dbm2, dim, l, u, diagonals, 0, buffer.data());
+}
+
 bool is_am_le(tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim,
               tchecker::integer_t const * m)
 {
   return tchecker::dbm::is_alu_le(dbm1, dbm2, dim, m, m);
 }
 
+/*!
+ \brief Copy a DBM from a batch
+ \param dbm : a dbm
+ \param batch : a batch of DBMs (see tchecker::dbm::is_le_batch)
+ \param stride : distance between two consecutive bounds of a DBM in batch
+ \param k : index of a DBM in batch
+ \param dim : dimension of dbm and of the DBMs in batch
+ \post dbm is a copy of the k-th DBM in batch
+ */
+static void copy_from_batch(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                            std::size_t k, tchecker::clock_id_t dim)
+{
+  std::size_t const size = static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim);
+  for (std::size_t i = 0; i < size; ++i)
+    dbm[i] = batch[i * stride + k];
+}
+
+/*!
+ \brief Set a bit in a batch result
+ \param result : bit set of words of 64 bits
+ \param k : index of a bit
+ \param value : value of the bit
+ */
+static inline void set_batch_bit(std::uint64_t * result, std::size_t k, bool value)
+{
+  std::uint64_t const mask = static_cast<std::uint64_t>(1) << (k % 64);
+  result[k / 64] = (value ? result[k / 64] | mask : result[k / 64] & ~mask);
+}
+
+void is_le_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                 std::size_t count, tchecker::clock_id_t dim, std::uint64_t * le)
+{
+  assert(dbm != nullptr);
+  assert(batch != nullptr);
+  assert(count <= stride);
+  assert(dim >= 1);
+
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::batch_kernels();
+  if (kernels != nullptr) {
+    kernels->is_le_batch(tchecker::dbm::packed(dbm), tchecker::dbm::packed(batch), stride, count, dim, le);
+    return;
+  }
+
+  std::size_t const size = static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim);
+  for (std::size_t k = 0; k < count; ++k) {
+    std::size_t i = 0;
+    while (i < size && dbm[i] <= batch[i * stride + k])
+      ++i;
+    tchecker::dbm::set_batch_bit(le, k, i == size);
+  }
+}
+
+void is_ge_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                 std::size_t count, tchecker::clock_id_t dim, std::uint64_t * ge)
+{
+  assert(dbm != nullptr);
+  assert(batch != nullptr);
+  assert(count <= stride);
+  assert(dim >= 1);
+
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::batch_kernels();
+  if (kernels != nullptr) {
+    kernels->is_ge_batch(tchecker::dbm::packed(dbm), tchecker::dbm::packed(batch), stride, count, dim, ge);
+    return;
+  }
+
+  std::size_t const size = static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim);
+  for (std::size_t k = 0; k < count; ++k) {
+    std::size_t i = 0;
+    while (i < size && batch[i * stride + k] <= dbm[i])
+      ++i;
+    tchecker::dbm::set_batch_bit(ge, k, i == size);
+  }
+}
+
+void is_alu_le_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                     std::size_t count, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                     tchecker::integer_t const * u, std::uint64_t * le)
+{
+  assert(dbm != nullptr);
+  assert(batch != nullptr);
+  assert(count <= stride);
+  assert(dim >= 1);
+
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::batch_kernels();
+  if (kernels != nullptr && kernels->is_alu_le_batch(tchecker::dbm::packed(dbm), tchecker::dbm::packed(batch), stride,
+                                                     count, dim, tchecker::dbm::packed_bounds(l),
+                                                     tchecker::dbm::packed_bounds(u), le) == 1)
+    return;
+
+  static thread_local std::vector<tchecker::dbm::db_t> buffer;
+  buffer.resize(static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim));
+  for (std::size_t k = 0; k < count; ++k) {
+    tchecker::dbm::copy_from_batch(buffer.data(), batch, stride, k, dim);
+    tchecker::dbm::set_batch_bit(le, k, tchecker::dbm::is_alu_le(dbm, buffer.data(), dim, l, u));
+  }
+}
+
+void is_alu_ge_batch(tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch, std::size_t stride,
+                     std::size_t count, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                     tchecker::integer_t const * u, std::uint64_t * ge)
+{
+  assert(dbm != nullptr);
+  assert(batch != nullptr);
+  assert(count <= stride);
+  assert(dim >= 1);
+
+  tchecker::dbm::simd::details::kernels_t const * kernels = tchecker::dbm::simd::details::batch_kernels();
+  if (kernels != nullptr && kernels->is_alu_ge_batch(tchecker::dbm::packed(dbm), tchecker::dbm::packed(batch), stride,
+                                                     count, dim, tchecker::dbm::packed_bounds(l),
+                                                     tchecker::dbm::packed_bounds(u), ge) == 1)
+    return;
+
+  static thread_local std::vector<tchecker::dbm::db_t> buffer;
+  buffer.resize(static_cast<std::size_t>(dim) * static_cast<std::size_t>(dim));
+  for (std::size_t k = 0; k < count; ++k) {
+    tchecker::dbm::copy_from_batch(buffer.data(), batch, stride, k, dim);
+    tchecker::dbm::set_batch_bit(ge, k, tchecker::dbm::is_alu_le(buffer.data(), dbm, dim, l, u));
+  }
+}
+
+/*!
+ \brief Rank of a bound value in a DBM signature
+ \param c : a value
+ \return c if 0 <= c < 16 (0 if c < 0), then 16 ranks for each power of 2 (c is rounded down to its 5 most
+ significant bits), up to 126
+ \note non-decreasing w.r.t. c
+ */
+static inline std::uint64_t signature_rank(tchecker::integer_t c)
+{
+  if (c < 16)
+    return (c < 0 ? 0 : static_cast<std::uint64_t>(c));
+  std::uint64_t exponent = 0;
+  for (; c >= 32; c >>= 1)
+    ++exponent;
+  return std::min<std::uint64_t>(16 * (exponent + 1) + static_cast<std::uint64_t>(c - 16), 126);
+}
+
+/*!
+ \brief Signature of a DBM
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param l : clock lower bounds, or nullptr
+ \param u : clock upper bounds, or nullptr
+ \pre l and u are both nullptr or both not nullptr
+ \return signature of dbm (see tchecker::dbm::signature), w.r.t. abstraction aLU if l and u are not nullptr
+ (see tchecker::dbm::alu_signature)
+ \note the field of each bound is non-decreasing w.r.t. the bound. Infinite upper bounds, and upper bounds
+ above L(x) w.r.t. aLU, have maximal field 127. Lower bounds above U(x) w.r.t. aLU have minimal field 0
+ */
+static std::uint64_t signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                               tchecker::integer_t const * u)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  assert((l == nullptr) == (u == nullptr));
+
+  std::uint64_t s = 0;
+  tchecker::clock_id_t const last = std::min<tchecker::clock_id_t>(dim - 1, tchecker::dbm::SIGNATURE_CLOCKS);
+  for (tchecker::clock_id_t x = 1; x <= last; ++x) {
+    std::uint64_t upper = 127;
+    if (DBM(x, 0) != tchecker::dbm::LT_INFINITY &&
+        (l == nullptr || (L(x) != -tchecker::dbm::INF_VALUE && DBM(x, 0) <= tchecker::dbm::db(tchecker::LE, L(x)))))
+      upper = tchecker::dbm::signature_rank(tchecker::dbm::value(DBM(x, 0)));
+
+    std::uint64_t lower = 0;
+    if (u == nullptr || (U(x) != -tchecker::dbm::INF_VALUE && DBM(0, x) >= tchecker::dbm::db(tchecker::LE, -U(x))))
+      lower = 127 - tchecker::dbm::signature_rank(-tchecker::dbm::value(DBM(0, x)));
+
+    s |= (upper | (lower << 8)) << (16 * (x - 1));
+  }
+  return s;
+}
+
+std::uint64_t signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  return tchecker::dbm::signature(dbm, dim, nullptr, nullptr);
+}
+
+std::uint64_t alu_signature(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim, tchecker::integer_t const * l,
+                            tchecker::integer_t const * u)
+{
+  assert(l != nullptr);
+  assert(u != nullptr);
+  return tchecker::dbm::signature(dbm, dim, l, u);
+}
+
 std::size_t hash(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
 {
   std::size_t seed = 0;
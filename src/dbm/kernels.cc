@@ -0,0 +1,166 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+#include "tchecker/dbm/details/simd_kernels.hh"
+#include "tchecker/dbm/fixed_dim.hh"
+#include "tchecker/dbm/kernels.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace details {
+
+/*!
+ \brief Table of operations specialized for dimension D
+ \tparam D : dimension of DBMs
+ \param vectorized : true if vectorized kernels are selected for dimension D
+ \return table of DBM operations specialized for DBMs of dimension D. Operations with vectorized kernels are
+ generic if vectorized is true
+ */
+template <tchecker::clock_id_t D> tchecker::dbm::kernels_t fixed_dim_kernels(bool vectorized)
+{
+  tchecker::dbm::kernels_t k{
+      D,
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim) {
+        assert(dim == D);
+        return tchecker::dbm::fixed_dim::tighten<D>(dbm);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim,
+         tchecker::clock_constraint_container_t const & c) {
+        assert(dim == D);
+        return tchecker::dbm::fixed_dim::constrain<D>(dbm, c);
+      },
+      [](tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+         [[maybe_unused]] tchecker::clock_id_t dim) {
+        assert(dim == D);
+        return tchecker::dbm::fixed_dim::is_equal<D>(dbm1, dbm2);
+      },
+      [](tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2,
+         [[maybe_unused]] tchecker::clock_id_t dim) {
+        assert(dim == D);
+        return tchecker::dbm::fixed_dim::is_le<D>(dbm1, dbm2);
+      },
+      [](tchecker::dbm::db_t const * dbm1, tchecker::dbm::db_t const * dbm2, [[maybe_unused]] tchecker::clock_id_t dim,
+         tchecker::integer_t const * l, tchecker::integer_t const * u) {
+        assert(dim == D);
+        return tchecker::dbm::fixed_dim::is_alu_le<D>(dbm1, dbm2, l, u);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim,
+         tchecker::clock_reset_container_t const & r) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::reset<D>(dbm, r);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim,
+         tchecker::clock_reset_container_t const & r) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::free_clock<D>(dbm, r);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::open_up<D>(dbm);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::open_down<D>(dbm);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim, tchecker::integer_t const * l,
+         tchecker::integer_t const * u) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::extra_lu<D>(dbm, l, u);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim, tchecker::integer_t const * l,
+         tchecker::integer_t const * u) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::extra_lu_plus<D>(dbm, l, u);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim, tchecker::integer_t const * m) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::extra_lu<D>(dbm, m, m);
+      },
+      [](tchecker::dbm::db_t * dbm, [[maybe_unused]] tchecker::clock_id_t dim, tchecker::integer_t const * m) {
+        assert(dim == D);
+        tchecker::dbm::fixed_dim::extra_lu_plus<D>(dbm, m, m);
+      }};
+
+  if (vectorized) {
+    tchecker::dbm::kernels_t const & generic = tchecker::dbm::generic_kernels();
+    k.tighten = generic.tighten;
+    k.is_equal = generic.is_equal;
+    k.is_le = generic.is_le;
+    k.is_alu_le = generic.is_alu_le;
+    k.extra_lu = generic.extra_lu;
+    k.extra_m = generic.extra_m;
+  }
+
+  return k;
+}
+
+/*!
+ \brief Type of tables of specialized operations, indexed by dimension
+ */
+using fixed_dim_tables_t = std::array<tchecker::dbm::kernels_t, tchecker::dbm::fixed_dim::MAX_DIM>;
+
+/*!
+ \brief Tables of specialized operations
+ \param vectorized : see tchecker::dbm::details::fixed_dim_kernels
+ \return tables of operations specialized for dimensions 1 to MAX_DIM
+ */
+template <std::size_t... I> static fixed_dim_tables_t make_fixed_dim_tables(bool vectorized, std::index_sequence<I...>)
+{
+  return fixed_dim_tables_t{
+      tchecker::dbm::details::fixed_dim_kernels<static_cast<tchecker::clock_id_t>(I + 1)>(vectorized)...};
+}
+
+} // end of namespace details
+
+tchecker::dbm::kernels_t const & generic_kernels()
+{
+  static tchecker::dbm::kernels_t const generic{
+      0,
+      static_cast<enum tchecker::dbm::status_t (*)(tchecker::dbm::db_t *, tchecker::clock_id_t)>(&tchecker::dbm::tighten),
+      static_cast<enum tchecker::dbm::status_t (*)(tchecker::dbm::db_t *, tchecker::clock_id_t,
+                                                   tchecker::clock_constraint_container_t const &)>(
+          &tchecker::dbm::constrain),
+      &tchecker::dbm::is_equal,
+      &tchecker::dbm::is_le,
+      &tchecker::dbm::is_alu_le,
+      static_cast<void (*)(tchecker::dbm::db_t *, tchecker::clock_id_t, tchecker::clock_reset_container_t const &)>(
+          &tchecker::dbm::reset),
+      static_cast<void (*)(tchecker::dbm::db_t *, tchecker::clock_id_t, tchecker::clock_reset_container_t const &)>(
+          &tchecker::dbm::free_clock),
+      &tchecker::dbm::open_up,
+      &tchecker::dbm::open_down,
+      &tchecker::dbm::extra_lu,
+      static_cast<void (*)(tchecker::dbm::db_t *, tchecker::clock_id_t, tchecker::integer_t const *,
+                           tchecker::integer_t const *)>(&tchecker::dbm::extra_lu_plus),
+      &tchecker::dbm::extra_m,
+      &tchecker::dbm::extra_m_plus};
+  return generic;
+}
+
+tchecker::dbm::kernels_t const & kernels(tchecker::clock_id_t dim)
+{
+  static tchecker::dbm::details::fixed_dim_tables_t const scalar_tables = tchecker::dbm::details::make_fixed_dim_tables(
+      false, std::make_index_sequence<tchecker::dbm::fixed_dim::MAX_DIM>{});
+  static tchecker::dbm::details::fixed_dim_tables_t const vectorized_tables =
+      tchecker::dbm::details::make_fixed_dim_tables(true, std::make_index_sequence<tchecker::dbm::fixed_dim::MAX_DIM>{});
+
+  if (dim < 1 || dim > tchecker::dbm::fixed_dim::MAX_DIM || !tchecker::dbm::simd::details::has_packed_encoding())
+    return tchecker::dbm::generic_kernels();
+  if (tchecker::dbm::simd::details::kernels(dim) != nullptr)
+    return vectorized_tables[dim - 1];
+  return scalar_tables[dim - 1];
+}
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
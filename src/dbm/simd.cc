@@ -0,0 +1,181 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/details/simd_kernels.hh"
+#include "tchecker/dbm/simd.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+/*!
+ \brief Accessor
+ \param isa : an instruction set
+ \return kernels for isa if they are supported, nullptr otherwise
+ */
+static tchecker::dbm::simd::details::kernels_t const * supported_kernels(enum tchecker::dbm::simd::isa_t isa)
+{
+  static bool const packed = tchecker::dbm::simd::details::has_packed_encoding();
+  if (!packed)
+    return nullptr;
+
+#if defined(__x86_64__) || defined(__i386__)
+  switch (isa) {
+  case tchecker::dbm::simd::ISA_SSE42:
+    return (__builtin_cpu_supports("sse4.2") ? tchecker::dbm::simd::details::sse42_kernels() : nullptr);
+  case tchecker::dbm::simd::ISA_AVX2:
+    return (__builtin_cpu_supports("avx2") ? tchecker::dbm::simd::details::avx2_kernels() : nullptr);
+  default:
+    return nullptr;
+  }
+#else
+  return nullptr;
+#endif
+}
+
+/*!
+ \brief Accessor
+ \param isa : an instruction set
+ \return kernels for DBMs that are too small for the kernels of isa, nullptr if none
+ \note AVX2 kernels need twice larger DBMs than SSE4.2 kernels, which are used in
+ between
+ */
+static tchecker::dbm::simd::details::kernels_t const * small_kernels(enum tchecker::dbm::simd::isa_t isa)
+{
+  if (isa == tchecker::dbm::simd::ISA_AVX2)
+    return supported_kernels(tchecker::dbm::simd::ISA_SSE42);
+  return nullptr;
+}
+
+/*!
+ \brief Selected instruction set and kernels
+ */
+struct selection_t {
+  std::atomic<enum tchecker::dbm::simd::isa_t> isa;                           /*!< Instruction set */
+  std::atomic<tchecker::dbm::simd::details::kernels_t const *> kernels;       /*!< Kernels (nullptr for scalar) */
+  std::atomic<tchecker::dbm::simd::details::kernels_t const *> small_kernels; /*!< Kernels for small DBMs */
+};
+
+/*!
+ \brief Accessor
+ \return current selection, initialized to the best supported instruction set
+ */
+static tchecker::dbm::simd::selection_t & selection()
+{
+  static tchecker::dbm::simd::selection_t s{{tchecker::dbm::simd::best_isa()},
+                                            {supported_kernels(tchecker::dbm::simd::best_isa())},
+                                            {small_kernels(tchecker::dbm::simd::best_isa())}};
+  return s;
+}
+
+bool is_supported(enum tchecker::dbm::simd::isa_t isa)
+{
+  return (isa == tchecker::dbm::simd::ISA_SCALAR) || (supported_kernels(isa) != nullptr);
+}
+
+enum tchecker::dbm::simd::isa_t best_isa()
+{
+  if (tchecker::dbm::simd::is_supported(tchecker::dbm::simd::ISA_AVX2))
+    return tchecker::dbm::simd::ISA_AVX2;
+  if (tchecker::dbm::simd::is_supported(tchecker::dbm::simd::ISA_SSE42))
+    return tchecker::dbm::simd::ISA_SSE42;
+  return tchecker::dbm::simd::ISA_SCALAR;
+}
+
+enum tchecker::dbm::simd::isa_t selected_isa()
+{
+  return tchecker::dbm::simd::selection().isa.load(std::memory_order_relaxed);
+}
+
+void select(enum tchecker::dbm::simd::isa_t isa)
+{
+  if (!tchecker::dbm::simd::is_supported(isa))
+    throw std::invalid_argument("Unsupported instruction set: " + tchecker::dbm::simd::isa_name(isa));
+  tchecker::dbm::simd::selection_t & s = tchecker::dbm::simd::selection();
+  s.kernels.store(supported_kernels(isa), std::memory_order_relaxed);
+  s.small_kernels.store(small_kernels(isa), std::memory_order_relaxed);
+  s.isa.store(isa, std::memory_order_relaxed);
+}
+
+std::string isa_name(enum tchecker::dbm::simd::isa_t isa)
+{
+  switch (isa) {
+  case tchecker::dbm::simd::ISA_SCALAR:
+    return "scalar";
+  case tchecker::dbm::simd::ISA_SSE42:
+    return "sse4.2";
+  case tchecker::dbm::simd::ISA_AVX2:
+    return "avx2";
+  default:
+    throw std::invalid_argument("Unknown instruction set");
+  }
+}
+
+enum tchecker::dbm::simd::isa_t parse_isa(std::string const & name)
+{
+  if (name == "scalar")
+    return tchecker::dbm::simd::ISA_SCALAR;
+  if (name == "sse4.2")
+    return tchecker::dbm::simd::ISA_SSE42;
+  if (name == "avx2")
+    return tchecker::dbm::simd::ISA_AVX2;
+  if (name == "best")
+    return tchecker::dbm::simd::best_isa();
+  throw std::invalid_argument("Unknown instruction set: " + name);
+}
+
+namespace details {
+
+bool has_packed_encoding()
+{
+  if (sizeof(tchecker::dbm::db_t) != sizeof(std::int32_t) || sizeof(tchecker::integer_t) != sizeof(std::int32_t))
+    return false;
+
+  auto packed = [](tchecker::dbm::db_t db) {
+    std::int32_t x;
+    std::memcpy(&x, &db, sizeof(x));
+    return x;
+  };
+
+  return (packed(tchecker::dbm::LE_ZERO) == tchecker::dbm::simd::details::PACKED_LE_ZERO) &&
+         (packed(tchecker::dbm::LT_ZERO) == tchecker::dbm::simd::details::PACKED_LT_ZERO) &&
+         (packed(tchecker::dbm::LT_INFINITY) == tchecker::dbm::simd::details::PACKED_LT_INFINITY) &&
+         (packed(tchecker::dbm::db(tchecker::LE, -3)) == -5) && (packed(tchecker::dbm::db(tchecker::LT, 7)) == 14) &&
+         (tchecker::dbm::INF_VALUE == tchecker::dbm::simd::details::PACKED_INF_VALUE);
+}
+
+tchecker::dbm::simd::details::kernels_t const * kernels(std::uint32_t dim)
+{
+  tchecker::dbm::simd::selection_t & s = tchecker::dbm::simd::selection();
+  tchecker::dbm::simd::details::kernels_t const * k = s.kernels.load(std::memory_order_relaxed);
+  if (k == nullptr || dim >= k->min_dim)
+    return k;
+  k = s.small_kernels.load(std::memory_order_relaxed);
+  if (k == nullptr || dim < k->min_dim)
+    return nullptr;
+  return k;
+}
+
+tchecker::dbm::simd::details::kernels_t const * batch_kernels()
+{
+  return tchecker::dbm::simd::selection().kernels.load(std::memory_order_relaxed);
+}
+
+} // end of namespace details
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
@@ -0,0 +1,98 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+/*!
+ \file simd_avx2.cc
+ \brief AVX2 DBM kernels
+ \note This file is compiled with -mavx2 when the compiler supports it. Kernels are
+ only selected at runtime if the CPU supports AVX2
+ */
+
+#include "tchecker/dbm/details/simd_kernels.hh"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace {
+
+/*!
+ \class avx2_t
+ \brief AVX2 vector operations on 32 bits lanes
+ */
+struct avx2_t {
+  using vec_t = __m256i;
+  static constexpr unsigned int lanes = 8;
+
+  static inline vec_t load(std::int32_t const * p) { return _mm256_loadu_si256(reinterpret_cast<vec_t const *>(p)); }
+  static inline void store(std::int32_t * p, vec_t v) { _mm256_storeu_si256(reinterpret_cast<vec_t *>(p), v); }
+  static inline vec_t set1(std::int32_t x) { return _mm256_set1_epi32(x); }
+  static inline vec_t iota() { return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); }
+  static inline vec_t add(vec_t a, vec_t b) { return _mm256_add_epi32(a, b); }
+  static inline vec_t sub(vec_t a, vec_t b) { return _mm256_sub_epi32(a, b); }
+  static inline vec_t and_(vec_t a, vec_t b) { return _mm256_and_si256(a, b); }
+  static inline vec_t or_(vec_t a, vec_t b) { return _mm256_or_si256(a, b); }
+  static inline vec_t xor_(vec_t a, vec_t b) { return _mm256_xor_si256(a, b); }
+  static inline vec_t andnot(vec_t a, vec_t b) { return _mm256_andnot_si256(a, b); }
+  static inline vec_t min(vec_t a, vec_t b) { return _mm256_min_epi32(a, b); }
+  static inline vec_t cmpgt(vec_t a, vec_t b) { return _mm256_cmpgt_epi32(a, b); }
+  static inline vec_t cmpeq(vec_t a, vec_t b) { return _mm256_cmpeq_epi32(a, b); }
+  static inline vec_t blend(vec_t a, vec_t b, vec_t mask) { return _mm256_blendv_epi8(a, b, mask); }
+  static inline vec_t srai1(vec_t a) { return _mm256_srai_epi32(a, 1); }
+  static inline bool any(vec_t mask) { return !_mm256_testz_si256(mask, mask); }
+  static inline bool all(vec_t mask) { return _mm256_movemask_epi8(mask) == -1; }
+  static inline unsigned int bits(vec_t mask)
+  {
+    return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+  }
+};
+
+} // end of anonymous namespace
+
+#include "simd_kernels_impl.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+namespace details {
+
+static tchecker::dbm::simd::details::kernels_t const avx2_kernels_table = make_kernels<avx2_t>(8);
+
+tchecker::dbm::simd::details::kernels_t const * avx2_kernels() { return &avx2_kernels_table; }
+
+} // end of namespace details
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#else
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+namespace details {
+
+tchecker::dbm::simd::details::kernels_t const * avx2_kernels() { return nullptr; }
+
+} // end of namespace details
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // __AVX2__
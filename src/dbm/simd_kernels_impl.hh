@@ -0,0 +1,577 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_DBM_SIMD_KERNELS_IMPL_HH
+#define TCHECKER_DBM_SIMD_KERNELS_IMPL_HH
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tchecker/dbm/details/simd_kernels.hh"
+
+/*!
+ \file simd_kernels_impl.hh
+ \brief Implementation of vectorized DBM kernels, generic w.r.t. instruction set
+ \note This file is included by translation units compiled for a specific
+ instruction set, after the definition of a type V that provides:
+ - V::lanes : number of 32 bits lanes
+ - V::vec_t : type of vectors
+ - load, store, set1, add, sub, and_, or_, andnot (~a & b), min, cmpgt, cmpeq,
+ blend (mask ? b : a), srai1 (arithmetic shift right by 1), any (some lane set
+ in a mask), all (all lanes set in a mask), bits (one bit per lane set in a mask,
+ lane 0 is the least significant bit)
+ Everything is in an anonymous namespace to avoid sharing code compiled for
+ distinct instruction sets
+ */
+
+namespace {
+
+using packed_db_t = tchecker::dbm::simd::details::packed_db_t;
+
+using tchecker::dbm::simd::details::PACKED_INF_VALUE;
+using tchecker::dbm::simd::details::PACKED_LE_ZERO;
+using tchecker::dbm::simd::details::PACKED_LT_INFINITY;
+using tchecker::dbm::simd::details::PACKED_LT_ZERO;
+using tchecker::dbm::simd::details::PACKED_MAX;
+
+/*!
+ \brief Sum of packed difference bounds
+ \param db1 : packed difference bound
+ \param db2 : packed difference bound
+ \param sum : result
+ \return true if db1+db2 can be represented (then sum is db1+db2), false otherwise
+ */
+static bool packed_sum(std::int32_t db1, std::int32_t db2, std::int32_t & sum)
+{
+  if (db1 == PACKED_LT_INFINITY || db2 == PACKED_LT_INFINITY) {
+    sum = PACKED_LT_INFINITY;
+    return true;
+  }
+  std::int64_t const s = static_cast<std::int64_t>(db1) + static_cast<std::int64_t>(db2) - ((db1 | db2) & 1);
+  if (s < INT32_MIN || s > PACKED_MAX)
+    return false;
+  sum = static_cast<std::int32_t>(s);
+  return true;
+}
+
+template <class V> int tighten(packed_db_t * dbm, std::uint32_t dim)
+{
+  using vec_t = typename V::vec_t;
+  vec_t const one = V::set1(1);
+  vec_t const inf = V::set1(PACKED_LT_INFINITY);
+  vec_t const max = V::set1(PACKED_MAX);
+  std::uint32_t const vend = dim - dim % V::lanes;
+
+  for (std::uint32_t k = 0; k < dim; ++k) {
+    packed_db_t const * row_k = dbm + k * dim;
+    for (std::uint32_t i = 0; i < dim; ++i) {
+      packed_db_t * row_i = dbm + i * dim;
+      std::int32_t const dik = row_i[k];
+      if ((i == k) || (dik == PACKED_LT_INFINITY))
+        continue;
+
+      vec_t const vdik = V::set1(dik);
+      std::uint32_t j = 0;
+      for (; j < vend; j += V::lanes) {
+        vec_t const dkj = V::load(row_k + j);
+        vec_t const dij = V::load(row_i + j);
+        vec_t s = V::add(vdik, dkj);
+        // signed overflow iff s has a sign distinct from both operands
+        vec_t const overflow = V::cmpgt(V::set1(0), V::and_(V::xor_(vdik, s), V::xor_(dkj, s)));
+        s = V::sub(s, V::and_(V::or_(vdik, dkj), one));
+        vec_t const dkj_inf = V::cmpeq(dkj, inf);
+        vec_t const bad = V::andnot(dkj_inf, V::or_(overflow, V::cmpgt(s, max)));
+        if (V::any(bad))
+          return -1;
+        s = V::blend(s, inf, dkj_inf);
+        V::store(row_i + j, V::min(dij, s));
+      }
+      for (; j < dim; ++j) {
+        std::int32_t s;
+        if (!packed_sum(dik, row_k[j], s))
+          return -1;
+        if (s < row_i[j])
+          row_i[j] = s;
+      }
+
+      if (row_i[i] < PACKED_LE_ZERO) {
+        dbm[0] = PACKED_LT_ZERO;
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
+
+template <class V> bool is_le(packed_db_t const * dbm1, packed_db_t const * dbm2, std::uint32_t dim)
+{
+  std::uint32_t const size = dim * dim;
+  std::uint32_t const vend = size - size % V::lanes;
+  std::uint32_t i = 0;
+  for (; i < vend; i += V::lanes)
+    if (V::any(V::cmpgt(V::load(dbm1 + i), V::load(dbm2 + i))))
+      return false;
+  for (; i < size; ++i)
+    if (dbm1[i] > dbm2[i])
+      return false;
+  return true;
+}
+
+template <class V> bool is_equal(packed_db_t const * dbm1, packed_db_t const * dbm2, std::uint32_t dim)
+{
+  std::uint32_t const size = dim * dim;
+  std::uint32_t const vend = size - size % V::lanes;
+  std::uint32_t i = 0;
+  for (; i < vend; i += V::lanes)
+    if (!V::all(V::cmpeq(V::load(dbm1 + i), V::load(dbm2 + i))))
+      return false;
+  for (; i < size; ++i)
+    if (dbm1[i] != dbm2[i])
+      return false;
+  return true;
+}
+
+/*!
+ \brief ExtraLU on a segment [begin,end) of row i>0 with 0 < begin
+ \note bounds are updated as in tchecker::dbm::extra_lu: <inf if cij > Li, <-Uj if -cij > Uj
+ */
+template <class V>
+bool extra_lu_segment(packed_db_t * row, std::uint32_t begin, std::uint32_t end, std::int32_t li,
+                      std::int32_t const * u)
+{
+  using vec_t = typename V::vec_t;
+  vec_t const zero = V::set1(0);
+  vec_t const inf = V::set1(PACKED_LT_INFINITY);
+  vec_t const neg_inf_value = V::set1(-PACKED_INF_VALUE);
+  vec_t const vli = V::set1(li);
+  vec_t modified = zero;
+
+  std::uint32_t j = begin;
+  for (; j + V::lanes <= end; j += V::lanes) {
+    vec_t const d = V::load(row + j);
+    vec_t const uj = V::load(u + j - 1);
+    vec_t const c = V::srai1(d);
+    vec_t const not_inf = V::andnot(V::cmpeq(d, inf), V::set1(-1));
+    vec_t const above_l = V::and_(V::cmpgt(c, vli), not_inf);
+    vec_t const below_u = V::andnot(above_l, V::and_(V::cmpgt(V::sub(zero, c), uj), not_inf));
+    // <-Uj is 2*(-Uj)+0, and <inf if Uj is -inf
+    vec_t const lt_minus_u = V::blend(V::sub(zero, V::add(uj, uj)), inf, V::cmpeq(uj, neg_inf_value));
+    vec_t nd = V::blend(d, inf, above_l);
+    nd = V::blend(nd, lt_minus_u, below_u);
+    V::store(row + j, nd);
+    modified = V::or_(modified, V::or_(above_l, below_u));
+  }
+
+  bool m = V::any(modified);
+  for (; j < end; ++j) {
+    std::int32_t const d = row[j];
+    if (d == PACKED_LT_INFINITY)
+      continue;
+    std::int32_t const c = d >> 1;
+    std::int32_t const uj = u[j - 1];
+    if (c > li) {
+      row[j] = PACKED_LT_INFINITY;
+      m = true;
+    }
+    else if (-c > uj) {
+      row[j] = (uj == -PACKED_INF_VALUE ? PACKED_LT_INFINITY : -2 * uj);
+      m = true;
+    }
+  }
+  return m;
+}
+
+template <class V>
+int extra_lu(packed_db_t * dbm, std::uint32_t dim, std::int32_t const * l, std::int32_t const * u)
+{
+  for (std::uint32_t x = 0; x + 1 < dim; ++x)
+    if (u[x] < -PACKED_INF_VALUE || l[x] < -PACKED_INF_VALUE)
+      return -1;
+
+  bool modified = false;
+
+  // i=0 (first row), only second case applies
+  for (std::uint32_t j = 1; j < dim; ++j) {
+    std::int32_t const uj = u[j - 1];
+    if (dbm[j] == PACKED_LE_ZERO)
+      continue;
+    if (-(dbm[j] >> 1) > uj) {
+      dbm[j] = (uj == -PACKED_INF_VALUE ? PACKED_LE_ZERO : -2 * uj);
+      modified = true;
+    }
+  }
+
+  // i>0, both cases apply, j=0 has U(0)=0
+  for (std::uint32_t i = 1; i < dim; ++i) {
+    packed_db_t * row = dbm + i * dim;
+    std::int32_t const li = l[i - 1];
+
+    if (row[0] != PACKED_LT_INFINITY) {
+      std::int32_t const c = row[0] >> 1;
+      if (c > li) {
+        row[0] = PACKED_LT_INFINITY;
+        modified = true;
+      }
+      else if (-c > 0) {
+        row[0] = PACKED_LT_ZERO;
+        modified = true;
+      }
+    }
+
+    if (extra_lu_segment<V>(row, 1, i, li, u))
+      modified = true;
+    if (extra_lu_segment<V>(row, i + 1, dim, li, u))
+      modified = true;
+  }
+
+  return (modified ? 1 : 0);
+}
+
+template <class V>
+int is_alu_le(packed_db_t const * dbm1, packed_db_t const * dbm2, std::uint32_t dim, std::int32_t const * l,
+              std::int32_t const * u)
+{
+  using vec_t = typename V::vec_t;
+
+  // dbm1 not included in aLU(dbm2) if there is x and y s.t.
+  //     dbm1[0x] >= (<= -U(x))
+  // &&  dbm2[yx] < dbm1[yx]
+  // &&  dbm2[yx] + (< -L(y)) < dbm1[0x]
+  // Iterations are over y (rows), then x (vectorized)
+
+  for (std::uint32_t x = 0; x + 1 < dim; ++x)
+    if (u[x] < -PACKED_INF_VALUE || l[x] < -PACKED_INF_VALUE)
+      return -1;
+
+  vec_t const zero = V::set1(0);
+  vec_t const one = V::set1(1);
+  vec_t const max = V::set1(PACKED_MAX);
+  vec_t const neg_inf_value = V::set1(-PACKED_INF_VALUE);
+
+  for (std::uint32_t y = 0; y < dim; ++y) {
+    std::int32_t const ly = (y == 0 ? 0 : l[y - 1]);
+    if (ly == -PACKED_INF_VALUE)
+      continue;
+    std::int32_t const lt_minus_ly = -2 * ly;
+    vec_t const vlt_minus_ly = V::set1(lt_minus_ly);
+    packed_db_t const * row1 = dbm1 + y * dim;
+    packed_db_t const * row2 = dbm2 + y * dim;
+
+    // x = 0, U(0) = 0 and dbm1[00] = <=0 so 1st condition holds
+    if (y != 0 && row2[0] < row1[0]) {
+      std::int32_t s;
+      if (!packed_sum(row2[0], lt_minus_ly, s))
+        return -1;
+      if (s < dbm1[0])
+        return 0;
+    }
+
+    std::uint32_t x = 1;
+    for (; x + V::lanes <= dim; x += V::lanes) {
+      vec_t const ux = V::load(u + x - 1);
+      vec_t const d1_0x = V::load(dbm1 + x);
+      vec_t const d1_yx = V::load(row1 + x);
+      vec_t const d2_yx = V::load(row2 + x);
+      // 1st condition: Ux != -inf && dbm1[0x] >= 2*(-Ux)+1
+      vec_t const c1 = V::andnot(V::or_(V::cmpeq(ux, neg_inf_value), V::cmpgt(V::sub(one, V::add(ux, ux)), d1_0x)),
+                                 V::set1(-1));
+      // 2nd condition (implies dbm2[yx] is not <inf)
+      vec_t c = V::and_(c1, V::cmpgt(d1_yx, d2_yx));
+      if (y >= x && y < x + V::lanes) // x != y
+        c = V::andnot(V::cmpeq(V::iota(), V::set1(static_cast<std::int32_t>(y - x))), c);
+      if (!V::any(c))
+        continue;
+      // 3rd condition: dbm2[yx] + (< -Ly) is (#c) + (<-Ly) = 2*(c-Ly)+0
+      vec_t const s = V::add(V::andnot(one, d2_yx), vlt_minus_ly);
+      vec_t const overflow =
+          V::cmpgt(zero, V::and_(V::xor_(V::andnot(one, d2_yx), s), V::xor_(vlt_minus_ly, s)));
+      if (V::any(V::and_(c, V::or_(overflow, V::cmpgt(s, max)))))
+        return -1;
+      if (V::any(V::and_(c, V::cmpgt(d1_0x, s))))
+        return 0;
+    }
+    for (; x < dim; ++x) {
+      if (x == y)
+        continue;
+      std::int32_t const ux = u[x - 1];
+      if (ux == -PACKED_INF_VALUE || dbm1[x] < -2 * ux + 1)
+        continue;
+      if (row2[x] < row1[x]) {
+        std::int32_t s;
+        if (!packed_sum(row2[x], lt_minus_ly, s))
+          return -1;
+        if (s < dbm1[x])
+          return 0;
+      }
+    }
+  }
+
+  return 1;
+}
+
+/*!
+ \brief Set the bits of a batch result
+ \param result : bit set of words of 64 bits
+ \param k : index of the first DBM in a group of lanes
+ \param bits : one bit per lane
+ \note k is a multiple of the number of lanes, which divides 64
+ */
+static inline void set_bits(std::uint64_t * result, std::size_t k, unsigned int bits)
+{
+  result[k / 64] |= static_cast<std::uint64_t>(bits) << (k % 64);
+}
+
+/*!
+ \brief Clear a batch result
+ \param result : bit set of words of 64 bits
+ \param count : number of bits
+ */
+static inline void clear_bits(std::uint64_t * result, std::size_t count)
+{
+  for (std::size_t w = 0; w < (count + 63) / 64; ++w)
+    result[w] = 0;
+}
+
+template <class V>
+void is_le_batch(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                 std::uint32_t dim, std::uint64_t * le)
+{
+  using vec_t = typename V::vec_t;
+  std::uint32_t const size = dim * dim;
+  clear_bits(le, count);
+
+  std::size_t k = 0;
+  for (; k + V::lanes <= count; k += V::lanes) {
+    vec_t in = V::set1(-1);
+    for (std::uint32_t i = 0; i < size; ++i) {
+      in = V::andnot(V::cmpgt(V::set1(dbm[i]), V::load(batch + i * stride + k)), in);
+      if (!V::any(in))
+        break;
+    }
+    set_bits(le, k, V::bits(in));
+  }
+  for (; k < count; ++k) {
+    std::uint32_t i = 0;
+    while (i < size && dbm[i] <= batch[i * stride + k])
+      ++i;
+    if (i == size)
+      le[k / 64] |= static_cast<std::uint64_t>(1) << (k % 64);
+  }
+}
+
+template <class V>
+void is_ge_batch(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                 std::uint32_t dim, std::uint64_t * ge)
+{
+  using vec_t = typename V::vec_t;
+  std::uint32_t const size = dim * dim;
+  clear_bits(ge, count);
+
+  std::size_t k = 0;
+  for (; k + V::lanes <= count; k += V::lanes) {
+    vec_t in = V::set1(-1);
+    for (std::uint32_t i = 0; i < size; ++i) {
+      in = V::andnot(V::cmpgt(V::load(batch + i * stride + k), V::set1(dbm[i])), in);
+      if (!V::any(in))
+        break;
+    }
+    set_bits(ge, k, V::bits(in));
+  }
+  for (; k < count; ++k) {
+    std::uint32_t i = 0;
+    while (i < size && batch[i * stride + k] <= dbm[i])
+      ++i;
+    if (i == size)
+      ge[k / 64] |= static_cast<std::uint64_t>(1) << (k % 64);
+  }
+}
+
+template <class V>
+int is_alu_le_batch(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                    std::uint32_t dim, std::int32_t const * l, std::int32_t const * u, std::uint64_t * le)
+{
+  using vec_t = typename V::vec_t;
+
+  // dbm not included in aLU(batch[k]) if there is x != y s.t.
+  //     dbm[0x] >= (<= -U(x))
+  // &&  batch[k][yx] < dbm[yx]
+  // &&  batch[k][yx] + (< -L(y)) < dbm[0x]
+  // The 1st condition only depends on dbm. Iterations are over the DBMs in the batch
+  // (vectorized), then y and x
+
+  for (std::uint32_t x = 0; x + 1 < dim; ++x)
+    if (u[x] < -PACKED_INF_VALUE || l[x] < -PACKED_INF_VALUE)
+      return -1;
+
+  clear_bits(le, count);
+
+  vec_t const zero = V::set1(0);
+  vec_t const one = V::set1(1);
+  vec_t const max = V::set1(PACKED_MAX);
+
+  std::size_t k = 0;
+  for (; k + V::lanes <= count; k += V::lanes) {
+    vec_t out = zero;
+    for (std::uint32_t y = 0; y < dim; ++y) {
+      std::int32_t const ly = (y == 0 ? 0 : l[y - 1]);
+      if (ly == -PACKED_INF_VALUE)
+        continue;
+      vec_t const vlt_minus_ly = V::set1(-2 * ly);
+      for (std::uint32_t x = 0; x < dim; ++x) {
+        if (x == y)
+          continue;
+        if (x != 0 && (u[x - 1] == -PACKED_INF_VALUE || dbm[x] < -2 * u[x - 1] + 1))
+          continue;
+        vec_t const d2 = V::load(batch + (y * dim + x) * stride + k);
+        vec_t const c = V::cmpgt(V::set1(dbm[y * dim + x]), d2);
+        if (!V::any(c))
+          continue;
+        // batch[k][yx] + (< -Ly) is (#c) + (<-Ly) = 2*(c-Ly)+0
+        vec_t const s = V::add(V::andnot(one, d2), vlt_minus_ly);
+        vec_t const overflow = V::cmpgt(zero, V::and_(V::xor_(V::andnot(one, d2), s), V::xor_(vlt_minus_ly, s)));
+        if (V::any(V::and_(c, V::or_(overflow, V::cmpgt(s, max)))))
+          return -1;
+        out = V::or_(out, V::and_(c, V::cmpgt(V::set1(dbm[x]), s)));
+      }
+      if (V::all(out))
+        break;
+    }
+    set_bits(le, k, V::bits(V::andnot(out, V::set1(-1))));
+  }
+
+  for (; k < count; ++k) {
+    bool included = true;
+    for (std::uint32_t y = 0; y < dim && included; ++y) {
+      std::int32_t const ly = (y == 0 ? 0 : l[y - 1]);
+      if (ly == -PACKED_INF_VALUE)
+        continue;
+      for (std::uint32_t x = 0; x < dim; ++x) {
+        if (x == y)
+          continue;
+        if (x != 0 && (u[x - 1] == -PACKED_INF_VALUE || dbm[x] < -2 * u[x - 1] + 1))
+          continue;
+        std::int32_t const d2 = batch[(y * dim + x) * stride + k];
+        if (d2 < dbm[y * dim + x]) {
+          std::int32_t s;
+          if (!packed_sum(d2, -2 * ly, s))
+            return -1;
+          if (s < dbm[x]) {
+            included = false;
+            break;
+          }
+        }
+      }
+    }
+    if (included)
+      le[k / 64] |= static_cast<std::uint64_t>(1) << (k % 64);
+  }
+
+  return 1;
+}
+
+template <class V>
+int is_alu_ge_batch(packed_db_t const * dbm, packed_db_t const * batch, std::size_t stride, std::size_t count,
+                    std::uint32_t dim, std::int32_t const * l, std::int32_t const * u, std::uint64_t * ge)
+{
+  using vec_t = typename V::vec_t;
+
+  // batch[k] not included in aLU(dbm) if there is x != y s.t.
+  //     batch[k][0x] >= (<= -U(x))
+  // &&  dbm[yx] < batch[k][yx]
+  // &&  dbm[yx] + (< -L(y)) < batch[k][0x]
+  // Sums only involve dbm, they are computed once and for all
+
+  for (std::uint32_t x = 0; x + 1 < dim; ++x)
+    if (u[x] < -PACKED_INF_VALUE || l[x] < -PACKED_INF_VALUE)
+      return -1;
+
+  // Check that all the sums can be represented
+  for (std::uint32_t y = 0; y < dim; ++y) {
+    std::int32_t const ly = (y == 0 ? 0 : l[y - 1]);
+    if (ly == -PACKED_INF_VALUE)
+      continue;
+    for (std::uint32_t x = 0; x < dim; ++x) {
+      std::int32_t s;
+      if (x != y && !packed_sum(dbm[y * dim + x], -2 * ly, s))
+        return -1;
+    }
+  }
+
+  clear_bits(ge, count);
+
+  std::size_t k = 0;
+  for (; k + V::lanes <= count; k += V::lanes) {
+    vec_t out = V::set1(0);
+    for (std::uint32_t y = 0; y < dim; ++y) {
+      std::int32_t const ly = (y == 0 ? 0 : l[y - 1]);
+      if (ly == -PACKED_INF_VALUE)
+        continue;
+      for (std::uint32_t x = 0; x < dim; ++x) {
+        std::int32_t const d2 = dbm[y * dim + x];
+        if (x == y || d2 == PACKED_LT_INFINITY)
+          continue;
+        if (x != 0 && u[x - 1] == -PACKED_INF_VALUE)
+          continue;
+        vec_t const d1_0x = V::load(batch + x * stride + k);
+        vec_t c = V::cmpgt(V::load(batch + (y * dim + x) * stride + k), V::set1(d2));
+        if (x != 0)
+          c = V::and_(c, V::cmpgt(d1_0x, V::set1(-2 * u[x - 1])));
+        std::int32_t s;
+        packed_sum(d2, -2 * ly, s);
+        out = V::or_(out, V::and_(c, V::cmpgt(d1_0x, V::set1(s))));
+      }
+      if (V::all(out))
+        break;
+    }
+    set_bits(ge, k, V::bits(V::andnot(out, V::set1(-1))));
+  }
+
+  for (; k < count; ++k) {
+    bool included = true;
+    for (std::uint32_t y = 0; y < dim && included; ++y) {
+      std::int32_t const ly = (y == 0 ? 0 : l[y - 1]);
+      if (ly == -PACKED_INF_VALUE)
+        continue;
+      for (std::uint32_t x = 0; x < dim; ++x) {
+        std::int32_t const d2 = dbm[y * dim + x];
+        if (x == y || d2 == PACKED_LT_INFINITY)
+          continue;
+        std::int32_t const d1_0x = batch[x * stride + k];
+        if (x != 0 && (u[x - 1] == -PACKED_INF_VALUE || d1_0x < -2 * u[x - 1] + 1))
+          continue;
+        std::int32_t s;
+        packed_sum(d2, -2 * ly, s);
+        if (d2 < batch[(y * dim + x) * stride + k] && s < d1_0x) {
+          included = false;
+          break;
+        }
+      }
+    }
+    if (included)
+      ge[k / 64] |= static_cast<std::uint64_t>(1) << (k % 64);
+  }
+
+  return 1;
+}
+
+/*!
+ \brief Build a table of kernels
+ \tparam V : instruction set (see above)
+ \param min_dim : smallest dimension where kernels should be used
+ \return table of kernels for V
+ */
+template <class V> tchecker::dbm::simd::details::kernels_t make_kernels(std::uint32_t min_dim)
+{
+  return tchecker::dbm::simd::details::kernels_t{V::lanes,          min_dim,           &tighten<V>,
+                                                 &is_le<V>,         &is_equal<V>,      &extra_lu<V>,
+                                                 &is_alu_le<V>,     &is_le_batch<V>,   &is_ge_batch<V>,
+                                                 &is_alu_le_batch<V>, &is_alu_ge_batch<V>};
+}
+
+} // end of anonymous namespace
+
+#endif // TCHECKER_DBM_SIMD_KERNELS_IMPL_HH
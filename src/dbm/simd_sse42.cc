@@ -0,0 +1,98 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+/*!
+ \file simd_sse42.cc
+ \brief SSE4.2 DBM kernels
+ \note This file is compiled with -msse4.2 when the compiler supports it. Kernels are
+ only selected at runtime if the CPU supports SSE4.2
+ */
+
+#include "tchecker/dbm/details/simd_kernels.hh"
+
+#if defined(__SSE4_2__)
+
+#include <immintrin.h>
+
+namespace {
+
+/*!
+ \class sse42_t
+ \brief SSE4.2 vector operations on 32 bits lanes
+ */
+struct sse42_t {
+  using vec_t = __m128i;
+  static constexpr unsigned int lanes = 4;
+
+  static inline vec_t load(std::int32_t const * p) { return _mm_loadu_si128(reinterpret_cast<vec_t const *>(p)); }
+  static inline void store(std::int32_t * p, vec_t v) { _mm_storeu_si128(reinterpret_cast<vec_t *>(p), v); }
+  static inline vec_t set1(std::int32_t x) { return _mm_set1_epi32(x); }
+  static inline vec_t iota() { return _mm_setr_epi32(0, 1, 2, 3); }
+  static inline vec_t add(vec_t a, vec_t b) { return _mm_add_epi32(a, b); }
+  static inline vec_t sub(vec_t a, vec_t b) { return _mm_sub_epi32(a, b); }
+  static inline vec_t and_(vec_t a, vec_t b) { return _mm_and_si128(a, b); }
+  static inline vec_t or_(vec_t a, vec_t b) { return _mm_or_si128(a, b); }
+  static inline vec_t xor_(vec_t a, vec_t b) { return _mm_xor_si128(a, b); }
+  static inline vec_t andnot(vec_t a, vec_t b) { return _mm_andnot_si128(a, b); }
+  static inline vec_t min(vec_t a, vec_t b) { return _mm_min_epi32(a, b); }
+  static inline vec_t cmpgt(vec_t a, vec_t b) { return _mm_cmpgt_epi32(a, b); }
+  static inline vec_t cmpeq(vec_t a, vec_t b) { return _mm_cmpeq_epi32(a, b); }
+  static inline vec_t blend(vec_t a, vec_t b, vec_t mask) { return _mm_blendv_epi8(a, b, mask); }
+  static inline vec_t srai1(vec_t a) { return _mm_srai_epi32(a, 1); }
+  static inline bool any(vec_t mask) { return !_mm_testz_si128(mask, mask); }
+  static inline bool all(vec_t mask) { return _mm_movemask_epi8(mask) == 0xFFFF; }
+  static inline unsigned int bits(vec_t mask)
+  {
+    return static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+  }
+};
+
+} // end of anonymous namespace
+
+#include "simd_kernels_impl.hh"
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+namespace details {
+
+static tchecker::dbm::simd::details::kernels_t const sse42_kernels_table = make_kernels<sse42_t>(4);
+
+tchecker::dbm::simd::details::kernels_t const * sse42_kernels() { return &sse42_kernels_table; }
+
+} // end of namespace details
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#else
+
+namespace tchecker {
+
+namespace dbm {
+
+namespace simd {
+
+namespace details {
+
+tchecker::dbm::simd::details::kernels_t const * sse42_kernels() { return nullptr; }
+
+} // end of namespace details
+
+} // end of namespace simd
+
+} // end of namespace dbm
+
+} // end of namespace tchecker
+
+#endif // __SSE4_2__
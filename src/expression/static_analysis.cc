@@ -768,4 +768,87 @@ tchecker::has_clock_constraints_t has_clock_constraints(tchecker::typed_expressi
   return v.has_clock_constraints();
 }
 
+/* extract_diagonal_clocks */
+
+namespace details {
+
+/*!
+ \class diagonal_clocks_visitor_t
+ \brief Visitor of typed expressions for extraction of clocks in diagonal clock constraints
+ */
+class diagonal_clocks_visitor_t : public tchecker::typed_expression_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   \param clocks : set of clock IDs
+   */
+  diagonal_clocks_visitor_t(std::unordered_set<tchecker::clock_id_t> & clocks) : _clocks(clocks) {}
+
+  /*!
+   \brief Copy constructor
+   */
+  diagonal_clocks_visitor_t(tchecker::details::diagonal_clocks_visitor_t const &) = default;
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~diagonal_clocks_visitor_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::details::diagonal_clocks_visitor_t & operator=(tchecker::details::diagonal_clocks_visitor_t const &) = delete;
+
+  /*!
+   \brief Move assignment operator (deleted)
+   */
+  tchecker::details::diagonal_clocks_visitor_t & operator=(tchecker::details::diagonal_clocks_visitor_t &&) = delete;
+
+  /*!
+   \brief Treat diagonal clock constraint
+   \post the clocks in expr have been added to _clocks
+   */
+  virtual void visit(tchecker::typed_diagonal_clkconstr_expression_t const & expr)
+  {
+    std::unordered_set<tchecker::intvar_id_t> intvars;
+    tchecker::extract_variables(expr.first_clock(), _clocks, intvars);
+    tchecker::extract_variables(expr.second_clock(), _clocks, intvars);
+  }
+
+  /* Other visitors: recursion or do nothing */
+
+  virtual void visit(tchecker::typed_simple_clkconstr_expression_t const & expr) {}
+
+  virtual void visit(tchecker::typed_var_expression_t const & expr) {}
+
+  virtual void visit(tchecker::typed_bounded_var_expression_t const & expr) {}
+
+  virtual void visit(tchecker::typed_array_expression_t const & expr) {}
+
+  virtual void visit(tchecker::typed_int_expression_t const &) {}
+
+  virtual void visit(tchecker::typed_par_expression_t const & expr) { expr.expr().visit(*this); }
+
+  virtual void visit(tchecker::typed_binary_expression_t const & expr)
+  {
+    expr.left_operand().visit(*this);
+    expr.right_operand().visit(*this);
+  }
+
+  virtual void visit(tchecker::typed_unary_expression_t const & expr) { expr.operand().visit(*this); }
+
+  virtual void visit(tchecker::typed_ite_expression_t const & expr) {}
+
+private:
+  std::unordered_set<tchecker::clock_id_t> & _clocks; /*!< Set of clock IDs */
+};
+
+} // end of namespace details
+
+void extract_diagonal_clocks(tchecker::typed_expression_t const & expr, std::unordered_set<tchecker::clock_id_t> & clocks)
+{
+  tchecker::details::diagonal_clocks_visitor_t v(clocks);
+  expr.visit(v);
+}
+
 } // end of namespace tchecker
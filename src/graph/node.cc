@@ -11,7 +11,16 @@
 #include <boost/container_hash/hash.hpp>
 #endif
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
 #include "tchecker/graph/node.hh"
+#include "tchecker/zg/zg.hh"
 
 namespace tchecker {
 
@@ -78,6 +87,186 @@ node_zg_state_t::node_zg_state_t(tchecker::zg::state_sptr_t const & s) : _state(
 
 node_zg_state_t::node_zg_state_t(tchecker::zg::const_state_sptr_t const & s) : _state(s) {}
 
+/* compact_state_pool_t */
+
+/*!
+ \brief Size of blocks of compact states
+ */
+static constexpr std::size_t COMPACT_STATE_BLOCK_BYTES = 1 << 16;
+
+std::size_t compact_state_pool_t::size_class(std::size_t size)
+{
+  return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t);
+}
+
+void * compact_state_pool_t::allocate(std::size_t size)
+{
+  std::size_t const c = size_class(size);
+  if (c >= _free.size())
+    _free.resize(c + 1, nullptr);
+
+  if (_free[c] == nullptr) {
+    // New block: chunks of the size class are linked in the free list
+    std::size_t const chunk_size = c * alignof(std::max_align_t);
+    std::size_t const chunks = std::max<std::size_t>(1, COMPACT_STATE_BLOCK_BYTES / chunk_size);
+    _blocks.emplace_back(new char[chunks * chunk_size]);
+    char * block = _blocks.back().get();
+    for (std::size_t i = chunks; i > 0; --i) {
+      void * chunk = block + (i - 1) * chunk_size;
+      *static_cast<void **>(chunk) = _free[c];
+      _free[c] = chunk;
+    }
+  }
+
+  void * ptr = _free[c];
+  _free[c] = *static_cast<void **>(ptr);
+  return ptr;
+}
+
+void compact_state_pool_t::deallocate(void * ptr, std::size_t size)
+{
+  std::size_t const c = size_class(size);
+  assert(c < _free.size());
+  *static_cast<void **>(ptr) = _free[c];
+  _free[c] = ptr;
+}
+
+/* node_compact_zg_state_t */
+
+node_compact_zg_state_t::node_compact_zg_state_t(tchecker::zg::state_sptr_t const & s) : _ptr(0) { set_state(s.ptr()); }
+
+node_compact_zg_state_t::node_compact_zg_state_t(tchecker::zg::const_state_sptr_t const & s) : _ptr(0)
+{
+  set_state(s.ptr());
+}
+
+node_compact_zg_state_t::~node_compact_zg_state_t()
+{
+  if (is_compact())
+    compact_state()->~compact_t();
+  else
+    release_state();
+}
+
+void node_compact_zg_state_t::compact(tchecker::graph::compact_state_pool_t & pool)
+{
+  assert(!is_compact());
+  tchecker::zg::state_t const & s = state();
+  tchecker::zg::zone_t const & zone = s.zone();
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone.dim());
+  if (dim - 1 > std::numeric_limits<std::uint16_t>::max())
+    throw std::invalid_argument("Zone dimension is too large for a minimal constraint graph");
+
+  std::vector<tchecker::zg::minimal_edge_t> & edges = pool.edges();
+  edges.clear();
+  bool const empty = zone.is_empty();
+  if (!empty)
+    tchecker::zg::minimal_graph(zone.dbm(), dim, edges);
+
+  char * ptr = static_cast<char *>(pool.allocate(compact_size(edges.size())));
+  tchecker::zg::minimal_zone_t::construct(ptr + ZONE_OFFSET, dim, empty, edges.data(), edges.size());
+  new (ptr) compact_t{s.vloc_ptr(), s.intval_ptr(), reinterpret_cast<tchecker::zg::minimal_zone_t const *>(ptr + ZONE_OFFSET)};
+
+  release_state();
+  _ptr = reinterpret_cast<std::uintptr_t>(ptr) | COMPACT_TAG;
+}
+
+void node_compact_zg_state_t::spill(void * ptr, tchecker::graph::compact_state_pool_t & pool)
+{
+  assert(is_compact());
+  compact_t * c = compact_state();
+  tchecker::zg::minimal_zone_t const & zone = *c->zone;
+  tchecker::zg::minimal_zone_t::construct(ptr, static_cast<tchecker::clock_id_t>(zone.dim()), zone.is_empty(),
+                                          zone.begin(), zone.size());
+  if (is_spilled()) {
+    c->zone = static_cast<tchecker::zg::minimal_zone_t const *>(ptr);
+    return;
+  }
+
+  // The compact state is replaced by a compact state without minimal zone
+  void * spilled = pool.allocate(ZONE_OFFSET);
+  new (spilled) compact_t{std::move(c->vloc), std::move(c->intval), static_cast<tchecker::zg::minimal_zone_t const *>(ptr)};
+  std::size_t const size = compact_size(zone.size());
+  c->~compact_t();
+  pool.deallocate(c, size);
+  _ptr = reinterpret_cast<std::uintptr_t>(spilled) | COMPACT_TAG;
+}
+
+void node_compact_zg_state_t::restore(tchecker::zg::zg_t & zg, tchecker::graph::compact_state_pool_t & pool)
+{
+  if (!is_compact())
+    return;
+  compact_t * c = compact_state();
+  tchecker::zg::minimal_zone_t const & zone = *c->zone;
+  std::vector<tchecker::dbm::db_t> dbm(zone.dim() * zone.dim());
+  zone.to_dbm(dbm.data());
+  tchecker::zg::state_sptr_t s =
+      zg.build(c->vloc->ptr(), c->intval->ptr(), dbm.data(), static_cast<tchecker::clock_id_t>(zone.dim()));
+  zg.share(s); // shares the tuple of locations and the valuation with other states, as c keeps them alive
+
+  std::size_t const size = (is_spilled() ? ZONE_OFFSET : compact_size(zone.size()));
+  c->~compact_t();
+  pool.deallocate(c, size);
+  _ptr = 0;
+  set_state(s.ptr());
+}
+
+bool node_compact_zg_state_t::is_spilled() const
+{
+  if (!is_compact())
+    return false;
+  compact_t const * c = compact_state();
+  return c->zone != reinterpret_cast<tchecker::zg::minimal_zone_t const *>(reinterpret_cast<char const *>(c) + ZONE_OFFSET);
+}
+
+tchecker::zg::minimal_zone_t const & node_compact_zg_state_t::minimal_zone() const { return *compact_state()->zone; }
+
+tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> node_compact_zg_state_t::vloc_ptr() const
+{
+  return (is_compact() ? compact_state()->vloc : state().vloc_ptr());
+}
+
+tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t const> node_compact_zg_state_t::intval_ptr() const
+{
+  return (is_compact() ? compact_state()->intval : state().intval_ptr());
+}
+
+std::size_t node_compact_zg_state_t::spill_size() const
+{
+  std::size_t const align = alignof(tchecker::zg::minimal_zone_t) > alignof(tchecker::zg::minimal_edge_t)
+                                ? alignof(tchecker::zg::minimal_zone_t)
+                                : alignof(tchecker::zg::minimal_edge_t);
+  std::size_t size = tchecker::allocation_size_t<tchecker::zg::minimal_zone_t>::alloc_size(minimal_zone().size());
+  return ((size + align - 1) / align) * align;
+}
+
+std::size_t node_compact_zg_state_t::storage_bytes() const
+{
+  if (is_spilled())
+    return ZONE_OFFSET;
+  if (is_compact())
+    return compact_size(minimal_zone().size());
+  return sizeof(tchecker::zg::shared_state_t) +
+         tchecker::allocation_size_t<tchecker::zg::shared_zone_t>::alloc_size(
+             static_cast<tchecker::clock_id_t>(state().zone().dim()));
+}
+
+void node_compact_zg_state_t::set_state(tchecker::zg::shared_state_t const * s)
+{
+  assert(_ptr == 0);
+  if (s != nullptr)
+    s->take_reference();
+  _ptr = reinterpret_cast<std::uintptr_t>(s);
+}
+
+void node_compact_zg_state_t::release_state()
+{
+  tchecker::zg::shared_state_t const * s = shared_state();
+  if (s != nullptr)
+    s->release_reference();
+  _ptr = 0;
+}
+
 /* node_refzg_state_t */
 
 node_refzg_state_t::node_refzg_state_t(tchecker::refzg::state_sptr_t const & s) : _state(s) {}
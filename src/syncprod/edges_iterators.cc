@@ -5,6 +5,8 @@
  *
  */
 
+#include <algorithm>
+
 #include <boost/iterator/transform_iterator.hpp>
 
 #include "tchecker/syncprod/edges_iterators.hh"
@@ -53,7 +55,7 @@ incoming_asynchronous_edges(tchecker::syncprod::system_t const & system,
   return tchecker::make_range(join_begin, tchecker::past_the_end_iterator);
 }
 
-/* vloc_synchronized_edges_iterator_t */
+/* Synchronizations from a tuple of locations */
 
 /*!
 \brief Checks if a synchronization is enabled from a tuple of locations
@@ -73,20 +75,99 @@ static inline bool enabled(tchecker::system::synchronization_t const & sync, tch
   return true;
 }
 
+/*!
+\brief Checks if a synchronization has an instance from a tuple of locations
+\param sync : a synchronization
+\param vloc : tuple of locations
+\param loc_edges_map : maps location ID -> edges/events
+\return true if sync is enabled from vloc w.r.t. loc_edges_maps, and some process involved in sync has a
+corresponding transition from vloc, false otherwise
+\note these are the synchronizations obtained from tchecker::syncprod::system_t::outgoing_synchronizations (or
+incoming_synchronizations) of the locations in vloc that are enabled
+*/
+static inline bool instantiable(tchecker::system::synchronization_t const & sync, tchecker::vloc_t const & vloc,
+                                tchecker::system::loc_edges_maps_t const & loc_edges_maps)
+{
+  if (!tchecker::syncprod::enabled(sync, vloc, loc_edges_maps))
+    return false;
+  for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints())
+    if (loc_edges_maps.event(vloc[constr.pid()], constr.event_id()))
+      return true;
+  return false;
+}
+
+/*!
+ \brief Compute enabled synchronizations from a tuple of locations
+ \param system : a system
+ \param vloc : tuple of locations
+ \param loc_edges_maps : maps location ID -> edges/events
+ \param loc_syncs : maps location ID -> synchronizations (either outgoing or incoming w.r.t. loc_edges_maps)
+ \return identifiers of synchronizations from loc_syncs of locations in vloc that are enabled from vloc w.r.t.
+ loc_edges_maps, by increasing identifiers
+ */
+template <class LOC_SYNCS>
+static std::vector<tchecker::sync_id_t>
+indexed_synchronizations(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc,
+                                 tchecker::system::loc_edges_maps_t const & loc_edges_maps, LOC_SYNCS && loc_syncs)
+{
+  std::vector<tchecker::sync_id_t> sync_ids;
+  for (tchecker::loc_id_t const loc : vloc) {
+    tchecker::syncprod::system_t::synchronizations_ids_t const & ids = loc_syncs(loc);
+    sync_ids.insert(sync_ids.end(), ids.begin(), ids.end());
+  }
+  std::sort(sync_ids.begin(), sync_ids.end());
+  sync_ids.erase(std::unique(sync_ids.begin(), sync_ids.end()), sync_ids.end());
+
+  auto disabled = [&](tchecker::sync_id_t id) {
+    return !tchecker::syncprod::enabled(system.synchronization(id), vloc, loc_edges_maps);
+  };
+  sync_ids.erase(std::remove_if(sync_ids.begin(), sync_ids.end(), disabled), sync_ids.end());
+  return sync_ids;
+}
+
+std::vector<tchecker::sync_id_t> outgoing_synchronizations(tchecker::syncprod::system_t const & system,
+                                                           tchecker::vloc_t const & vloc)
+{
+  return tchecker::syncprod::indexed_synchronizations(
+      system, vloc, *system.outgoing_edges_maps(),
+      [&system](tchecker::loc_id_t loc) -> auto const & { return system.outgoing_synchronizations(loc); });
+}
+
+std::vector<tchecker::sync_id_t> incoming_synchronizations(tchecker::syncprod::system_t const & system,
+                                                           tchecker::vloc_t const & vloc)
+{
+  return tchecker::syncprod::indexed_synchronizations(
+      system, vloc, *system.incoming_edges_maps(),
+      [&system](tchecker::loc_id_t loc) -> auto const & { return system.incoming_synchronizations(loc); });
+}
+
+/* vloc_synchronized_edges_iterator_t */
+
+vloc_synchronized_edges_iterator_t::vloc_synchronized_edges_iterator_t(
+    tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
+    std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
+    tchecker::range_t<tchecker::system::synchronizations_t::const_iterator_t> const & syncs)
+    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _syncs(syncs.begin()), _sync_ids(nullptr), _sync_pos(0),
+      _sync_end(static_cast<std::size_t>(syncs.end() - syncs.begin()))
+{
+  fill_cartesian_product();
+}
+
 vloc_synchronized_edges_iterator_t::vloc_synchronized_edges_iterator_t(
     tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
     std::shared_ptr<tchecker::system::loc_edges_maps_t const> const & loc_edges_maps,
-    tchecker::system::synchronizations_t::const_iterator_t const & sync_begin,
-    tchecker::system::synchronizations_t::const_iterator_t const & sync_end)
-    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _sync_it(sync_begin), _sync_end(sync_end)
+    tchecker::system::synchronizations_t::const_iterator_t const & syncs, std::vector<tchecker::sync_id_t> const & sync_ids)
+    : _vloc(vloc), _loc_edges_maps(loc_edges_maps), _syncs(syncs), _sync_ids(&sync_ids), _sync_pos(0),
+      _sync_end(sync_ids.size())
 {
-  advance_while_empty_cartesian_product();
+  fill_cartesian_product();
 }
 
 bool vloc_synchronized_edges_iterator_t::operator==(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const
 {
-  return ((*_vloc == *it._vloc) && (_loc_edges_maps.get() == it._loc_edges_maps.get()) && (_sync_it == it._sync_it) &&
-          (_sync_end == it._sync_end) && (_cartesian_it == it._cartesian_it));
+  return ((*_vloc == *it._vloc) && (_loc_edges_maps.get() == it._loc_edges_maps.get()) &&
+          (_sync_ids == it._sync_ids) && (_sync_pos == it._sync_pos) && (_sync_end == it._sync_end) &&
+          (_cartesian_it == it._cartesian_it));
 }
 
 bool vloc_synchronized_edges_iterator_t::operator!=(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & it) const
@@ -103,32 +184,32 @@ tchecker::syncprod::vloc_synchronized_edges_iterator_t & tchecker::syncprod::vlo
   assert(!at_end());
   ++_cartesian_it;
   if (_cartesian_it == tchecker::past_the_end_iterator) {
-    ++_sync_it;
-    advance_while_empty_cartesian_product();
+    ++_sync_pos;
+    fill_cartesian_product();
   }
   return *this;
 }
 
-void tchecker::syncprod::vloc_synchronized_edges_iterator_t::advance_while_empty_cartesian_product()
+void tchecker::syncprod::vloc_synchronized_edges_iterator_t::fill_cartesian_product()
 {
   _cartesian_it.clear();
 
-  while (!at_end()) {
-    if (tchecker::syncprod::enabled(*_sync_it, *_vloc, *_loc_edges_maps))
-      break;
-    ++_sync_it;
-  }
+  if (_sync_ids == nullptr)
+    while (!at_end() && !tchecker::syncprod::instantiable(_syncs[sync_id()], *_vloc, *_loc_edges_maps))
+      ++_sync_pos;
 
   if (at_end())
     return;
 
-  auto constraints = _sync_it->synchronization_constraints();
+  // the synchronization is enabled, and some process in the synchronization has an edge: the product is not empty
+  auto constraints = _syncs[sync_id()].synchronization_constraints();
   for (auto const & constr : constraints) {
     auto edges = _loc_edges_maps->edges((*_vloc)[constr.pid()], constr.event_id());
     if ((constr.strength() == tchecker::SYNC_WEAK) && (edges.begin() == edges.end()))
       continue;
     _cartesian_it.push_back(edges);
   }
+  assert(_cartesian_it != tchecker::past_the_end_iterator);
 }
 
 /* Range of outgoing synchronized edges */
@@ -137,8 +218,18 @@ tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tcheck
 outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
 {
-  auto syncs = system.synchronizations();
-  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(), syncs.begin(), syncs.end());
+  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(), system.synchronizations());
+
+  return tchecker::make_range(begin, tchecker::past_the_end_iterator);
+}
+
+tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t>
+outgoing_synchronized_edges(tchecker::syncprod::system_t const & system,
+                            tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc,
+                            std::vector<tchecker::sync_id_t> const & sync_ids)
+{
+  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.outgoing_edges_maps(),
+                                                               system.synchronizations().begin(), sync_ids);
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -149,8 +240,7 @@ tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tcheck
 incoming_synchronized_edges(tchecker::syncprod::system_t const & system,
                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
 {
-  auto syncs = system.synchronizations();
-  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.incoming_edges_maps(), syncs.begin(), syncs.end());
+  tchecker::syncprod::vloc_synchronized_edges_iterator_t begin(vloc, system.incoming_edges_maps(), system.synchronizations());
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include "tchecker/syncprod/syncprod.hh"
@@ -137,22 +138,25 @@ tchecker::state_status_t final(tchecker::syncprod::system_t const & system, tche
 
 outgoing_edges_iterator_t::outgoing_edges_iterator_t(tchecker::syncprod::vloc_synchronized_edges_iterator_t const & sync_it,
                                                      tchecker::syncprod::vloc_asynchronous_edges_iterator_t const & async_it,
-                                                     boost::dynamic_bitset<> committed_processes)
-    : _it(sync_it, async_it), _committed_processes(committed_processes), _committed(_committed_processes.any())
+                                                     boost::dynamic_bitset<> committed_processes, bool sync_filtered)
+    : _it(sync_it, async_it), _committed_processes(committed_processes), _committed(_committed_processes.any()),
+      _sync_filtered(sync_filtered)
 {
   advance_while_not_enabled();
 }
 
 outgoing_edges_iterator_t::outgoing_edges_iterator_t(tchecker::syncprod::vloc_edges_iterator_t const & it,
-                                                     boost::dynamic_bitset<> committed_processes)
-    : _it(it), _committed_processes(committed_processes), _committed(_committed_processes.any())
+                                                     boost::dynamic_bitset<> committed_processes, bool sync_filtered)
+    : _it(it), _committed_processes(committed_processes), _committed(_committed_processes.any()),
+      _sync_filtered(sync_filtered)
 {
   advance_while_not_enabled();
 }
 
 bool outgoing_edges_iterator_t::operator==(tchecker::syncprod::outgoing_edges_iterator_t const & it) const
 {
-  return (_it == it._it && _committed_processes == it._committed_processes && _committed == it._committed);
+  return (_it == it._it && _committed_processes == it._committed_processes && _committed == it._committed &&
+          _sync_filtered == it._sync_filtered);
 }
 
 bool outgoing_edges_iterator_t::operator==(tchecker::end_iterator_t const & it) const { return at_end(); }
@@ -176,7 +180,8 @@ void outgoing_edges_iterator_t::advance_while_not_enabled()
   if (!_committed)
     return;
   while (!at_end()) {
-    if (involves_committed_process((*_it).edges))
+    tchecker::syncprod::outgoing_edges_iterator_t::sync_edges_t sync_edges = *_it;
+    if ((_sync_filtered && sync_edges.sync_id != tchecker::NO_SYNC) || involves_committed_process(sync_edges.edges))
       return;
     ++_it;
   }
@@ -193,19 +198,86 @@ bool outgoing_edges_iterator_t::involves_committed_process(
 
 bool outgoing_edges_iterator_t::at_end() const { return _it == tchecker::past_the_end_iterator; }
 
+/* enabled synchronizations */
+
+/*!
+ \brief Checks if a synchronization involves a committed process
+ \param sync : a synchronization
+ \param vloc : tuple of locations
+ \param loc_edges_maps : maps location ID -> edges/events
+ \param committed_processes : set of committed processes
+ \return true if some process in committed_processes has an edge from vloc in an instance of sync, false otherwise
+ */
+static bool involves_committed_process(tchecker::system::synchronization_t const & sync, tchecker::vloc_t const & vloc,
+                                       tchecker::system::loc_edges_maps_t const & loc_edges_maps,
+                                       boost::dynamic_bitset<> const & committed_processes)
+{
+  for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints())
+    if (committed_processes[constr.pid()] && loc_edges_maps.event(vloc[constr.pid()], constr.event_id()))
+      return true;
+  return false;
+}
+
+tchecker::syncprod::enabled_synchronizations_t compute_enabled_synchronizations(tchecker::syncprod::system_t const & system,
+                                                                                tchecker::const_vloc_sptr_t const & vloc)
+{
+  tchecker::syncprod::enabled_synchronizations_t enabled;
+  enabled.synchronizations = tchecker::syncprod::outgoing_synchronizations(system, *vloc);
+  enabled.committed_processes = tchecker::syncprod::committed_processes(system, vloc);
+
+  if (enabled.committed_processes.any()) {
+    tchecker::system::loc_edges_maps_t const & loc_edges_maps = *system.outgoing_edges_maps();
+    auto not_committed = [&](tchecker::sync_id_t id) {
+      return !tchecker::syncprod::involves_committed_process(system.synchronization(id), *vloc, loc_edges_maps,
+                                                             enabled.committed_processes);
+    };
+    enabled.synchronizations.erase(std::remove_if(enabled.synchronizations.begin(), enabled.synchronizations.end(), not_committed),
+                                   enabled.synchronizations.end());
+  }
+
+  return enabled;
+}
+
+tchecker::syncprod::enabled_synchronizations_t const & enabled_synchronizations(tchecker::syncprod::system_t const & system,
+                                                                              tchecker::const_vloc_sptr_t const & vloc)
+{
+  if (vloc->id() == tchecker::NO_VLOC_ID)
+    throw std::invalid_argument("tchecker::syncprod::enabled_synchronizations: vloc has not been shared");
+
+  tchecker::syncprod::enabled_synchronizations_t const * enabled = vloc->enabled_synchronizations();
+  if (enabled == nullptr)
+    enabled = vloc->enabled_synchronizations(
+        new tchecker::syncprod::enabled_synchronizations_t{tchecker::syncprod::compute_enabled_synchronizations(system, vloc)});
+  return *enabled;
+}
+
 /* outgoing edges */
 
 tchecker::syncprod::outgoing_edges_range_t outgoing_edges(tchecker::syncprod::system_t const & system,
                                                           tchecker::const_vloc_sptr_t const & vloc)
 {
-  tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t> sync_edges(
-      tchecker::syncprod::outgoing_synchronized_edges(system, vloc));
-
   tchecker::range_t<tchecker::syncprod::vloc_asynchronous_edges_iterator_t, tchecker::end_iterator_t> async_edges(
       tchecker::syncprod::outgoing_asynchronous_edges(system, vloc));
 
+  // shared tuples of locations memoize their enabled synchronizations, which live as long as vloc
+  if (vloc->id() != tchecker::NO_VLOC_ID) {
+    tchecker::syncprod::enabled_synchronizations_t const & enabled = tchecker::syncprod::enabled_synchronizations(system, vloc);
+
+    tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t> sync_edges(
+        tchecker::syncprod::outgoing_synchronized_edges(system, vloc, enabled.synchronizations));
+
+    tchecker::syncprod::outgoing_edges_iterator_t begin(sync_edges.begin(), async_edges.begin(), enabled.committed_processes,
+                                                        true);
+
+    return tchecker::make_range(begin, tchecker::past_the_end_iterator);
+  }
+
+  // other tuples of locations check synchronizations on the fly, without allocation
+  tchecker::range_t<tchecker::syncprod::vloc_synchronized_edges_iterator_t, tchecker::end_iterator_t> sync_edges(
+      tchecker::syncprod::outgoing_synchronized_edges(system, vloc));
+
   tchecker::syncprod::outgoing_edges_iterator_t begin(sync_edges.begin(), async_edges.begin(),
-                                                      committed_processes(system, vloc));
+                                                      tchecker::syncprod::committed_processes(system, vloc));
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -24,11 +24,14 @@ namespace syncprod {
 
 tchecker::syncprod::system_t::asynchronous_edges_collection_t const tchecker::syncprod::system_t::_empty_async_edges;
 
+tchecker::syncprod::system_t::synchronizations_ids_t const tchecker::syncprod::system_t::_empty_syncs;
+
 system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tchecker::system::system_t(sysdecl)
 {
   extract_asynchronous_edges();
   compute_committed_locations();
   compute_labels();
+  compute_synchronizations_index();
 }
 
 system_t::system_t(tchecker::system::system_t const & system) : tchecker::system::system_t(system)
@@ -36,6 +39,7 @@ system_t::system_t(tchecker::system::system_t const & system) : tchecker::system
   extract_asynchronous_edges();
   compute_committed_locations();
   compute_labels();
+  compute_synchronizations_index();
 }
 
 tchecker::system::attribute_keys_map_t const & system_t::known_attributes()
@@ -113,6 +117,22 @@ boost::dynamic_bitset<> system_t::labels(std::string const & labels) const
   return s;
 }
 
+tchecker::syncprod::system_t::synchronizations_ids_t const &
+system_t::outgoing_synchronizations(tchecker::loc_id_t loc) const
+{
+  if (loc >= _outgoing_syncs.size())
+    return _empty_syncs;
+  return _outgoing_syncs[loc];
+}
+
+tchecker::syncprod::system_t::synchronizations_ids_t const &
+system_t::incoming_synchronizations(tchecker::loc_id_t loc) const
+{
+  if (loc >= _incoming_syncs.size())
+    return _empty_syncs;
+  return _incoming_syncs[loc];
+}
+
 bool system_t::is_committed(tchecker::loc_id_t id) const
 {
   assert(is_location(id));
@@ -181,6 +201,31 @@ void system_t::compute_labels()
   }
 }
 
+void system_t::compute_synchronizations_index()
+{
+  tchecker::system::loc_edges_maps_t const & outgoing_maps = *outgoing_edges_maps();
+  tchecker::system::loc_edges_maps_t const & incoming_maps = *incoming_edges_maps();
+
+  _outgoing_syncs.clear();
+  _outgoing_syncs.resize(this->locations_count());
+  _incoming_syncs.clear();
+  _incoming_syncs.resize(this->locations_count());
+
+  // Synchronizations are visited by increasing identifiers, and added at most once to each location
+  for (tchecker::system::synchronization_t const & sync : synchronizations()) {
+    for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints()) {
+      for (tchecker::system::loc_const_shared_ptr_t const & loc : tchecker::syncprod::system_t::locations(constr.pid())) {
+        if (outgoing_maps.event(loc->id(), constr.event_id()) &&
+            (_outgoing_syncs[loc->id()].empty() || _outgoing_syncs[loc->id()].back() != sync.id()))
+          _outgoing_syncs[loc->id()].push_back(sync.id());
+        if (incoming_maps.event(loc->id(), constr.event_id()) &&
+            (_incoming_syncs[loc->id()].empty() || _incoming_syncs[loc->id()].back() != sync.id()))
+          _incoming_syncs[loc->id()].push_back(sync.id());
+      }
+    }
+  }
+}
+
 void system_t::add_asynchronous_edge(tchecker::system::edge_const_shared_ptr_t const & edge)
 {
   assert(is_asynchronous(*edge));
@@ -5,16 +5,43 @@
  *
  */
 
+#include <limits>
 #include <ostream>
 #include <regex>
 #include <sstream>
 
+#include "tchecker/syncprod/syncprod.hh"
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/utils/ordering.hh"
 #include "tchecker/utils/string.hh"
 
 namespace tchecker {
 
+tchecker::vloc_id_t const NO_VLOC_ID = std::numeric_limits<tchecker::vloc_id_t>::max();
+
+/* vloc_base_t */
+
+vloc_base_t::~vloc_base_t() { delete _enabled_syncs.load(std::memory_order_acquire); }
+
+tchecker::vloc_base_t & vloc_base_t::operator=(tchecker::vloc_base_t const & b)
+{
+  tchecker::array_capacity_t<unsigned int>::operator=(b);
+  _id = tchecker::NO_VLOC_ID;
+  delete _enabled_syncs.exchange(nullptr, std::memory_order_acq_rel);
+  return *this;
+}
+
+tchecker::syncprod::enabled_synchronizations_t const *
+vloc_base_t::enabled_synchronizations(tchecker::syncprod::enabled_synchronizations_t const * syncs) const
+{
+  assert(syncs != nullptr);
+  tchecker::syncprod::enabled_synchronizations_t const * memoized = nullptr;
+  if (_enabled_syncs.compare_exchange_strong(memoized, syncs, std::memory_order_acq_rel, std::memory_order_acquire))
+    return syncs;
+  delete syncs; // another thread has memoized first
+  return memoized;
+}
+
 vloc_t::vloc_t(unsigned int size) : tchecker::loc_array_t(std::make_tuple(size), std::make_tuple(tchecker::NO_LOC)) {}
 
 void vloc_destruct_and_deallocate(tchecker::vloc_t * vloc)
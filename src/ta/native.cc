@@ -0,0 +1,140 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tchecker/ta/native.hh"
+#include "tchecker/ta/system.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Registered native model
+ */
+static tchecker::ta::native_model_t const * registered_native_model = nullptr;
+
+std::uint64_t fingerprint(tchecker::ta::system_t const & system)
+{
+  std::vector<tchecker::bytecode_t> sizes{static_cast<tchecker::bytecode_t>(sizeof(tchecker::integer_t)),
+                                          static_cast<tchecker::bytecode_t>(sizeof(tchecker::clock_id_t)),
+                                          static_cast<tchecker::bytecode_t>(system.processes_count()),
+                                          static_cast<tchecker::bytecode_t>(system.clocks_count(tchecker::VK_FLATTENED)),
+                                          static_cast<tchecker::bytecode_t>(system.intvars_count(tchecker::VK_FLATTENED)),
+                                          static_cast<tchecker::bytecode_t>(system.locations_count()),
+                                          static_cast<tchecker::bytecode_t>(system.edges_count())};
+  std::uint64_t hash = 14695981039346656037ULL; // FNV-1a 64-bit offset basis
+  for (tchecker::bytecode_t size : sizes) {
+    tchecker::bytecode_t const bytecode[] = {tchecker::VM_PUSH, size, tchecker::VM_RET};
+    hash = tchecker::fingerprint(bytecode, hash);
+  }
+  for (tchecker::loc_id_t id : system.locations_identifiers())
+    hash = tchecker::fingerprint(system.invariant_bytecode(id), hash);
+  for (tchecker::edge_id_t id : system.edges_identifiers()) {
+    hash = tchecker::fingerprint(system.guard_bytecode(id), hash);
+    hash = tchecker::fingerprint(system.statement_bytecode(id), hash);
+  }
+  return hash;
+}
+
+bool native_compatible(tchecker::ta::system_t const & system, tchecker::ta::native_model_t const & model)
+{
+  return model.version == tchecker::ta::NATIVE_MODEL_VERSION && model.processes_count == system.processes_count() &&
+         model.clocks_count == system.clocks_count(tchecker::VK_FLATTENED) &&
+         model.intvars_count == system.intvars_count(tchecker::VK_FLATTENED) &&
+         model.locations_count == system.locations_count() && model.edges_count == system.edges_count() &&
+         model.fingerprint == tchecker::ta::fingerprint(system);
+}
+
+void compile_native(std::ostream & os, tchecker::ta::system_t const & system)
+{
+  std::map<std::string, std::string> compiled; // generated code -> function name
+  std::vector<std::string> invariants, guards, statements;
+
+  os << "/*\n";
+  os << " * Native model of system " << system.name() << ", generated by tck-compile. Do not edit.\n";
+  os << " */\n\n";
+  os << "#include \"tchecker/ta/native.hh\"\n\n";
+  os << "static_assert(sizeof(tchecker::integer_t) == " << sizeof(tchecker::integer_t)
+     << ", \"integers should have the same size as in tck-compile\");\n";
+  os << "static_assert(sizeof(tchecker::clock_id_t) == " << sizeof(tchecker::clock_id_t)
+     << ", \"clock identifiers should have the same size as in tck-compile\");\n\n";
+
+  auto compile = [&](tchecker::bytecode_t const * bytecode) -> std::string {
+    std::stringstream code;
+    if (!tchecker::compile_native(code, "bytecode", bytecode))
+      return "nullptr";
+    auto it = compiled.find(code.str());
+    if (it != compiled.end())
+      return it->second;
+    std::string const name = "bytecode_" + std::to_string(compiled.size());
+    tchecker::compile_native(os, name, bytecode);
+    os << "\n";
+    compiled.emplace(code.str(), name);
+    return name;
+  };
+
+  for (tchecker::loc_id_t id : system.locations_identifiers())
+    invariants.push_back(compile(system.invariant_bytecode(id)));
+  for (tchecker::edge_id_t id : system.edges_identifiers()) {
+    guards.push_back(compile(system.guard_bytecode(id)));
+    statements.push_back(compile(system.statement_bytecode(id)));
+  }
+
+  auto output_array = [&](std::string const & name, std::vector<std::string> const & functions) {
+    os << "static tchecker::native_bytecode_t const " << name << "[] = {";
+    if (functions.empty())
+      os << "nullptr"; // zero-size arrays are not allowed
+    for (std::size_t i = 0; i < functions.size(); ++i)
+      os << (i % 4 == 0 ? "\n    " : " ") << functions[i] << (i + 1 < functions.size() ? "," : "");
+    os << "};\n\n";
+  };
+
+  output_array("invariants", invariants);
+  output_array("guards", guards);
+  output_array("statements", statements);
+
+  os << "static tchecker::ta::native_model_t const model = {\n";
+  os << "    " << tchecker::ta::NATIVE_MODEL_VERSION << ", // version\n";
+  os << "    \"" << system.name() << "\", // name\n";
+  os << "    " << tchecker::ta::fingerprint(system) << "ULL, // fingerprint\n";
+  os << "    " << system.processes_count() << ", // processes\n";
+  os << "    " << system.clocks_count(tchecker::VK_FLATTENED) << ", // clocks\n";
+  os << "    " << system.intvars_count(tchecker::VK_FLATTENED) << ", // integer variables\n";
+  os << "    " << system.locations_count() << ", // locations\n";
+  os << "    " << system.edges_count() << ", // edges\n";
+  os << "    invariants,\n";
+  os << "    guards,\n";
+  os << "    statements,\n";
+  os << "};\n\n";
+
+  os << "extern \"C\" tchecker::ta::native_model_t const * tchecker_native_model() { return &model; }\n";
+}
+
+void set_native_model(tchecker::ta::native_model_t const * model) { registered_native_model = model; }
+
+tchecker::ta::native_model_t const * native_model() { return registered_native_model; }
+
+void install_native_model(tchecker::ta::system_t const & system, tchecker::ta::native_model_t const & model)
+{
+  assert(tchecker::ta::native_compatible(system, model));
+  for (tchecker::loc_id_t id : system.locations_identifiers())
+    system.memoized_invariant(id).set_native(model.invariants[id]);
+  for (tchecker::edge_id_t id : system.edges_identifiers()) {
+    system.memoized_guard(id).set_native(model.guards[id]);
+    system.memoized_statement(id).set_native(model.statements[id]);
+  }
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
@@ -5,12 +5,20 @@
  *
  */
 
+#include <iterator>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
 #include "tchecker/expression/static_analysis.hh"
 #include "tchecker/statement/static_analysis.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/static_analysis.hh"
 #include "tchecker/ta/system.hh"
+#include "tchecker/variables/intvars.hh"
 #include "tchecker/variables/static_analysis.hh"
+#include "tchecker/vm/compilers.hh"
+#include "tchecker/vm/vm.hh"
 
 namespace tchecker {
 
@@ -54,6 +62,55 @@ bool has_diagonal_constraint(tchecker::ta::system_t const & system)
   return false;
 }
 
+boost::dynamic_bitset<> diagonal_clocks(tchecker::ta::system_t const & system)
+{
+  tchecker::clock_id_t const clock_nb = static_cast<tchecker::clock_id_t>(system.clocks_count(tchecker::VK_FLATTENED));
+  boost::dynamic_bitset<> diagonal_clocks(clock_nb);
+
+  // Clocks in diagonal constraints
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    tchecker::extract_diagonal_clocks(system.invariant(loc->id()), clocks);
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+    tchecker::extract_diagonal_clocks(system.guard(edge->id()), clocks);
+  if (clocks.empty())
+    return diagonal_clocks;
+  for (tchecker::clock_id_t x : clocks)
+    diagonal_clocks[x] = true;
+
+  // Closure w.r.t. updates x := y + c
+  std::vector<tchecker::clock_updates_map_t> updates;
+  try {
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges())
+      updates.push_back(tchecker::compute_clock_updates(clock_nb, system.statement(edge->id())));
+  }
+  catch (...) {
+    diagonal_clocks.set();
+    return diagonal_clocks;
+  }
+
+  bool modified = true;
+  while (modified) {
+    modified = false;
+    for (tchecker::clock_updates_map_t const & map : updates)
+      for (tchecker::clock_id_t x = 0; x < clock_nb; ++x) {
+        if (!diagonal_clocks[x])
+          continue;
+        if (map[x].empty()) {
+          diagonal_clocks.set();
+          return diagonal_clocks;
+        }
+        for (tchecker::clock_update_t const & up : map[x])
+          if (up.clock_id() != tchecker::REFCLOCK_ID && !diagonal_clocks[up.clock_id()]) {
+            diagonal_clocks[up.clock_id()] = true;
+            modified = true;
+          }
+      }
+  }
+
+  return diagonal_clocks;
+}
+
 bool has_non_constant_reset(tchecker::ta::system_t const & system)
 {
   // Check edge statements
@@ -71,6 +128,91 @@ bool has_shared_clocks(tchecker::ta::system_t const & system)
   return access_map.has_shared_variable(tchecker::VTYPE_CLOCK);
 }
 
+/*!
+ \brief Computes the clock constraints of an expression that do not depend on integer variables
+ \param expr : an expression
+ \param vm : a virtual machine
+ \param intval : an empty valuation of integer variables
+ \param c : a container of clock constraints
+ \post see tchecker::ta::intval_independent_clock_constraints
+ */
+static void intval_independent_clock_constraints(tchecker::typed_expression_t const & expr, tchecker::vm_t & vm,
+                                                 tchecker::intval_t & intval, tchecker::clock_constraint_container_t & c)
+{
+  auto const * par = dynamic_cast<tchecker::typed_par_expression_t const *>(&expr);
+  if (par != nullptr) {
+    intval_independent_clock_constraints(par->expr(), vm, intval, c);
+    return;
+  }
+
+  auto const * binary = dynamic_cast<tchecker::typed_binary_expression_t const *>(&expr);
+  if (binary != nullptr && binary->binary_operator() == tchecker::EXPR_OP_LAND) {
+    intval_independent_clock_constraints(binary->left_operand(), vm, intval, c);
+    intval_independent_clock_constraints(binary->right_operand(), vm, intval, c);
+    return;
+  }
+
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  tchecker::extract_variables(expr, clocks, intvars);
+  if (clocks.empty() || !intvars.empty())
+    return;
+
+  // expr does not read integer variables: any valuation can be used
+  std::unique_ptr<tchecker::bytecode_t[]> bytecode{tchecker::compile(expr)};
+  tchecker::clock_constraint_container_t constraints;
+  tchecker::clock_reset_container_t resets;
+  try {
+    if (vm.run(bytecode.get(), intval, constraints, resets) == 0)
+      return;
+  }
+  catch (...) {
+    return; // expr fails whatever the valuation
+  }
+  c.insert(c.end(), constraints.begin(), constraints.end());
+}
+
+void intval_independent_clock_constraints(tchecker::typed_expression_t const & expr,
+                                          tchecker::clock_constraint_container_t & c)
+{
+  tchecker::vm_t vm;
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(0, 0);
+  tchecker::ta::intval_independent_clock_constraints(expr, vm, *intval, c);
+  tchecker::intval_destruct_and_deallocate(intval);
+}
+
+bool intval_independent_clock_resets(std::size_t clock_nb, tchecker::typed_statement_t const & stmt,
+                                     tchecker::clock_reset_container_t & r)
+{
+  tchecker::clock_updates_map_t const updates = tchecker::compute_clock_updates(clock_nb, stmt);
+  tchecker::clock_reset_container_t resets;
+  for (tchecker::clock_id_t x = 0; x < clock_nb; ++x) {
+    tchecker::clock_updates_list_t const & list = updates[x];
+    if (list.empty() || std::next(list.begin()) != list.end())
+      return false; // unknown update, or one update per branch of a conditional statement
+    tchecker::clock_update_t const & up = *list.begin();
+    tchecker::integer_t value = 0;
+    try {
+      value = tchecker::const_evaluate(up.value());
+    }
+    catch (...) {
+      return false;
+    }
+    if (up.clock_id() == x && value == 0)
+      continue; // x is not modified
+    if (value < 0)
+      return false;
+    resets.emplace_back(x, up.clock_id(), value);
+  }
+  // resets are simultaneous in stmt: they are only independent of their order if no reset reads a modified clock
+  for (tchecker::clock_reset_t const & reset : resets)
+    for (tchecker::clock_reset_t const & other : resets)
+      if (!reset.reset_to_constant() && reset.right_id() == other.left_id())
+        return false;
+  r.insert(r.end(), resets.begin(), resets.end());
+  return true;
+}
+
 } // end of namespace ta
 
 } // end of namespace tchecker
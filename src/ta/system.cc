@@ -9,6 +9,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/expression/expression.hh"
@@ -17,6 +18,7 @@
 #include "tchecker/parsing/parsing.hh"
 #include "tchecker/statement/statement.hh"
 #include "tchecker/statement/typechecking.hh"
+#include "tchecker/ta/native.hh"
 #include "tchecker/ta/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
@@ -82,6 +84,12 @@ tchecker::bytecode_t const * system_t::guard_bytecode(tchecker::edge_id_t id) co
   return _guards[id]._compiled_expr.get();
 }
 
+tchecker::memoized_bytecode_t & system_t::memoized_guard(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return *_guards[id]._memoized_expr;
+}
+
 tchecker::typed_statement_t const & system_t::statement(tchecker::edge_id_t id) const
 {
   assert(is_edge(id));
@@ -94,6 +102,12 @@ tchecker::bytecode_t const * system_t::statement_bytecode(tchecker::edge_id_t id
   return _statements[id]._compiled_stmt.get();
 }
 
+tchecker::memoized_bytecode_t & system_t::memoized_statement(tchecker::edge_id_t id) const
+{
+  assert(is_edge(id));
+  return *_statements[id]._memoized_stmt;
+}
+
 bool system_t::is_urgent(tchecker::loc_id_t id) const
 {
   assert(is_location(id));
@@ -112,6 +126,12 @@ tchecker::bytecode_t const * system_t::invariant_bytecode(tchecker::loc_id_t id)
   return _invariants[id]._compiled_expr.get();
 }
 
+tchecker::memoized_bytecode_t & system_t::memoized_invariant(tchecker::loc_id_t id) const
+{
+  assert(is_location(id));
+  return *_invariants[id]._memoized_expr;
+}
+
 void system_t::compute_from_syncprod_system()
 {
   _invariants.clear();
@@ -141,6 +161,10 @@ void system_t::compute_from_syncprod_system()
 
   if (tchecker::ta::has_guarded_weakly_synchronized_event(*this))
     throw std::invalid_argument("Transitions over weakly synchronized events should not have guards");
+
+  tchecker::ta::native_model_t const * model = tchecker::ta::native_model();
+  if (model != nullptr && tchecker::ta::native_compatible(*this, *model))
+    tchecker::ta::install_native_model(*this, *model);
 }
 
 static std::shared_ptr<tchecker::expression_t>
@@ -199,7 +223,8 @@ void system_t::set_invariant(tchecker::loc_id_t id,
   try {
     std::shared_ptr<tchecker::bytecode_t> invariant_bytecode{tchecker::compile(*invariant_typed_expr),
                                                              std::default_delete<tchecker::bytecode_t[]>()};
-    _invariants[id] = {invariant_typed_expr, invariant_bytecode};
+    auto memoized_bytecode = std::make_unique<tchecker::memoized_bytecode_t>(invariant_bytecode.get(), _vm);
+    _invariants[id] = {invariant_typed_expr, invariant_bytecode, std::move(memoized_bytecode)};
   }
   catch (std::exception const & e) {
     std::stringstream oss;
@@ -232,7 +257,8 @@ void system_t::set_guards(tchecker::edge_id_t id,
   try {
     std::shared_ptr<tchecker::bytecode_t> guard_bytecode{tchecker::compile(*guard_typed_expr),
                                                          std::default_delete<tchecker::bytecode_t[]>()};
-    _guards[id] = {guard_typed_expr, guard_bytecode};
+    auto memoized_bytecode = std::make_unique<tchecker::memoized_bytecode_t>(guard_bytecode.get(), _vm);
+    _guards[id] = {guard_typed_expr, guard_bytecode, std::move(memoized_bytecode)};
   }
   catch (std::exception const & e) {
     std::stringstream oss;
@@ -293,7 +319,8 @@ void system_t::set_statements(tchecker::edge_id_t id,
   try {
     std::shared_ptr<tchecker::bytecode_t> bytecode{tchecker::compile(*typed_stmt),
                                                    std::default_delete<tchecker::bytecode_t[]>()};
-    _statements[id] = {typed_stmt, bytecode};
+    auto memoized_bytecode = std::make_unique<tchecker::memoized_bytecode_t>(bytecode.get(), _vm);
+    _statements[id] = {typed_stmt, bytecode, std::move(memoized_bytecode)};
   }
   catch (std::exception const & e) {
     std::stringstream oss;
@@ -40,7 +40,7 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker
   // check invariant
   tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, place_holder_clkreset) == 0)
+    if (system.memoized_invariant(loc_id).run(vm, *intval, invariant, place_holder_clkreset) == 0)
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -81,7 +81,7 @@ tchecker::state_status_t final(tchecker::ta::system_t const & system, tchecker::
   // check invariant
   tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, place_holder_clkreset) == 0)
+    if (system.memoized_invariant(loc_id).run(vm, *intval, invariant, place_holder_clkreset) == 0)
       return tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -100,7 +100,7 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::v
 
   // check source invariant
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, src_invariant, place_holder_clkreset) == 0)
+    if (system.memoized_invariant(loc_id).run(vm, *intval, src_invariant, place_holder_clkreset) == 0)
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -112,21 +112,21 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::v
 
   // check guards
   for (tchecker::system::edge_const_shared_ptr_t const & edge : sync_edges.edges) {
-    if (vm.run(system.guard_bytecode(edge->id()), *intval, guard, place_holder_clkreset) == 0)
+    if (system.memoized_guard(edge->id()).run(vm, *intval, guard, place_holder_clkreset) == 0)
       return tchecker::STATE_INTVARS_GUARD_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
 
   // apply statements
   for (tchecker::system::edge_const_shared_ptr_t const & edge : sync_edges.edges) {
-    if (vm.run(system.statement_bytecode(edge->id()), *intval, place_holder_clkconstr, reset) == 0)
+    if (system.memoized_statement(edge->id()).run(vm, *intval, place_holder_clkconstr, reset) == 0)
       return tchecker::STATE_INTVARS_STATEMENT_FAILED;
     assert(place_holder_clkconstr.empty());
   }
 
   // check target invariant
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, tgt_invariant, place_holder_clkreset) == 0)
+    if (system.memoized_invariant(loc_id).run(vm, *intval, tgt_invariant, place_holder_clkreset) == 0)
       return tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -343,7 +343,7 @@ tchecker::state_status_t initialize(tchecker::ta::system_t const & system, tchec
   // check invariant
   tchecker::vm_t & vm = system.vm();
   for (tchecker::loc_id_t loc_id : *vloc) {
-    if (vm.run(system.invariant_bytecode(loc_id), *intval, invariant, place_holder_clkreset) == 0)
+    if (system.memoized_invariant(loc_id).run(vm, *intval, invariant, place_holder_clkreset) == 0)
       return tchecker::STATE_INTVARS_SRC_INVARIANT_VIOLATED;
     assert(place_holder_clkreset.empty());
   }
@@ -0,0 +1,183 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/native.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-compile.cc
+ \brief Ahead-of-time compilation of the bytecode of timed automata to native code (see tck-reach --native)
+ */
+
+extern char ** environ;
+
+#ifndef TCK_COMPILE_CXX
+#define TCK_COMPILE_CXX "c++"
+#endif
+
+#ifndef TCK_COMPILE_FLAGS
+#define TCK_COMPILE_FLAGS "-std=c++17 -O2"
+#endif
+
+static struct option const long_options[] = {{"help", no_argument, 0, 'h'},
+                                             {"output", required_argument, 0, 'o'},
+                                             {"shared", required_argument, 0, 's'},
+                                             {0, 0, 0, 0}};
+
+static char const * const options = "ho:s:";
+
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] [file]" << std::endl;
+  std::cerr << "   -h              help" << std::endl;
+  std::cerr << "   -o out_file     output file for C++ source (default is standard output, or lib_file.cc with -s)"
+            << std::endl;
+  std::cerr << "   -s lib_file     build C++ source into shared object lib_file, to be loaded by tck-reach --native"
+            << std::endl;
+  std::cerr << "reads from standard input if file is not provided" << std::endl;
+  std::cerr << "shared objects are built with: " << TCK_COMPILE_CXX << " " << TCK_COMPILE_FLAGS << " -fPIC -shared"
+            << std::endl;
+}
+
+/*!
+ \brief Build command of a shared object
+ \param shared_file : shared object file name
+ \param source_file : C++ source file name
+ \return the arguments of the command that builds source_file into shared_file: the configured compiler and
+ flags (split on white spaces), followed by shared object options and the file names
+ */
+std::vector<std::string> shared_object_command(std::string const & shared_file, std::string const & source_file)
+{
+  std::vector<std::string> args;
+  std::istringstream iss{std::string{TCK_COMPILE_CXX} + " " + TCK_COMPILE_FLAGS};
+  for (std::string arg; iss >> arg;)
+    args.push_back(arg);
+  args.insert(args.end(), {"-fPIC", "-shared", "-o", shared_file, source_file});
+  return args;
+}
+
+/*!
+ \brief Run a command
+ \param args : command arguments
+ \pre args is not empty
+ \return true if the command args[0] (searched in PATH) has been run with arguments args, and has exited with
+ status 0, false otherwise
+ \note args are passed to the command as they are, without interpretation by a shell
+ */
+bool run_command(std::vector<std::string> const & args)
+{
+  std::vector<char *> argv;
+  for (std::string const & arg : args)
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  argv.push_back(nullptr);
+
+  pid_t pid;
+  int const err = posix_spawnp(&pid, argv[0], nullptr, nullptr, argv.data(), environ);
+  if (err != 0) {
+    std::cerr << tchecker::log_error << "cannot run " << args[0] << ": " << std::strerror(err) << std::endl;
+    return false;
+  }
+
+  int status;
+  while (waitpid(pid, &status, 0) == -1)
+    if (errno != EINTR)
+      return false;
+  return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+int main(int argc, char * argv[])
+{
+  int c;
+  std::string output_file = "";
+  std::string shared_file = "";
+
+  while ((c = getopt_long(argc, argv, options, long_options, nullptr)) != -1) {
+    switch (c) {
+    case 'h':
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    case 'o':
+      output_file = optarg;
+      break;
+    case 's':
+      shared_file = optarg;
+      break;
+    default:
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (argc - optind > 1) {
+    std::cerr << "Too many input files" << std::endl;
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::string input_file = (optind == argc ? "" : argv[optind]);
+
+  try {
+    std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{
+        tchecker::parsing::parse_system_declaration(input_file)};
+    if (sysdecl == nullptr || tchecker::log_error_count() > 0)
+      return EXIT_FAILURE;
+
+    tchecker::ta::system_t system{*sysdecl};
+
+    if (output_file == "" && shared_file != "")
+      output_file = shared_file + ".cc";
+
+    if (output_file == "")
+      tchecker::ta::compile_native(std::cout, system);
+    else {
+      std::ofstream ofs{output_file};
+      if (!ofs.is_open()) {
+        std::cerr << tchecker::log_error << "cannot open " << output_file << " for writing" << std::endl;
+        return EXIT_FAILURE;
+      }
+      tchecker::ta::compile_native(ofs, system);
+      ofs.close();
+      if (!ofs) {
+        std::cerr << tchecker::log_error << "cannot write " << output_file << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    if (shared_file != "") {
+      std::vector<std::string> const command = shared_object_command(shared_file, output_file);
+      if (!run_command(command)) {
+        std::cerr << tchecker::log_error << "command failed:";
+        for (std::string const & arg : command)
+          std::cerr << " " << arg;
+        std::cerr << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  catch (std::exception const & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
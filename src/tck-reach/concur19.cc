@@ -44,17 +44,25 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::concur19::node_t const
 /* node_le_t */
 
 node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t table_size)
-    : _cached_local_lu(local_lu, table_size, std::move(const_vloc_sptr_hash_t{}), std::move(const_vloc_sptr_equal_t{}))
+    : _cached_local_lu(local_lu, table_size)
 {
 }
 
 bool node_le_t::operator()(tchecker::tck_reach::concur19::node_t const & n1,
                            tchecker::tck_reach::concur19::node_t const & n2) const
 {
-  auto lu_maps_references = _cached_local_lu.bounds(n2.state().vloc_ptr());
+  auto lu_maps_references = _cached_local_lu.bounds(n2.state().vloc());
   return tchecker::refzg::shared_is_sync_alu_le(n1.state(), n2.state(), lu_maps_references.L, lu_maps_references.U);
 }
 
+bool node_le_t::comparable(tchecker::tck_reach::concur19::node_t const & n1,
+                           tchecker::tck_reach::concur19::node_t const & n2) const
+{
+  return tchecker::ta::shared_equal_to(n1.state(), n2.state());
+}
+
+std::uint64_t node_le_t::signature(tchecker::tck_reach::concur19::node_t const & n) const { return 0; }
+
 /* edge_t */
 
 edge_t::edge_t(tchecker::refzg::transition_t const & t) : tchecker::graph::edge_vedge_t(t.vedge_ptr()) {}
@@ -8,6 +8,7 @@
 #ifndef TCHECKER_CONCUR19_ALGORITHM_HH
 #define TCHECKER_CONCUR19_ALGORITHM_HH
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -95,7 +96,7 @@ public:
   /*!
   \brief Constructor
   \param local_lu : local LU clock bounds
-  \param table_size : size of clock bounds cache
+  \param table_size : initial capacity of clock bounds cache
   \post this keeps a shared pointer to local_lu
   \throw std::invalid_argument : if local_lu points to nullptr
   */
@@ -110,12 +111,24 @@ public:
   */
   bool operator()(tchecker::tck_reach::concur19::node_t const & n1, tchecker::tck_reach::concur19::node_t const & n2) const;
 
-private:
-  using const_vloc_sptr_hash_t = tchecker::intrusive_shared_ptr_hash_t;
-  using const_vloc_sptr_equal_t = std::equal_to<tchecker::const_vloc_sptr_t>;
+  /*!
+   \brief Comparability of nodes
+   \param n1 : a node
+   \param n2 : a node
+   \return true if n1 and n2 have same discrete part, false otherwise
+   */
+  bool comparable(tchecker::tck_reach::concur19::node_t const & n1,
+                  tchecker::tck_reach::concur19::node_t const & n2) const;
 
-  mutable tchecker::clockbounds::bounded_cache_local_lu_map_t<const_vloc_sptr_hash_t, const_vloc_sptr_equal_t>
-      _cached_local_lu; /*!< Cached local LU clock bounds*/
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return 0: sync-aLU subsumption is not filtered on signatures
+   */
+  std::uint64_t signature(tchecker::tck_reach::concur19::node_t const & n) const;
+
+private:
+  mutable tchecker::clockbounds::shared_cache_local_lu_map_t _cached_local_lu; /*!< Cached local LU clock bounds*/
 };
 
 /*!
@@ -5,9 +5,13 @@
  *
  */
 
+#include <cctype>
+#include <cerrno>
+#include <dlfcn.h>
 #include <fstream>
 #include <getopt.h>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -15,10 +19,16 @@
 #include "concur19.hh"
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/native.hh"
+#include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/trace.hh"
 #include "zg-aLU-covreach.hh"
+#include "zg-bitstate-reach.hh"
 #include "zg-covreach.hh"
+#include "zg-parallel-covreach.hh"
 #include "zg-reach.hh"
+#include "zg-swarm-covreach.hh"
 
 /*!
  \file tck-reach.cc
@@ -29,13 +39,26 @@ static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"certificate", required_argument, 0, 'C'},
                                        {"output", required_argument, 0, 'o'},
                                        {"help", no_argument, 0, 'h'},
+                                       {"threads", required_argument, 0, 'j'},
                                        {"labels", required_argument, 0, 'l'},
                                        {"search-order", no_argument, 0, 's'},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
+                                       {"trace", required_argument, 0, 0},
+                                       {"trace-file", required_argument, 0, 0},
+                                       {"zone-storage", required_argument, 0, 0},
+                                       {"memory-limit", required_argument, 0, 0},
+                                       {"spill-dir", required_argument, 0, 0},
+                                       {"bitstate", required_argument, 0, 0},
+                                       {"bitstate-hashes", required_argument, 0, 0},
+                                       {"swarm", required_argument, 0, 0},
+                                       {"seed", required_argument, 0, 0},
+                                       {"cover-graph", required_argument, 0, 0},
+                                       {"native", required_argument, 0, 0},
+                                       {"detailed-stats", no_argument, 0, 0},
                                        {0, 0, 0, 0}};
 
-static char const * const options = (char *)"a:C:hl:o:s:";
+static char const * const options = (char *)"a:C:hj:l:o:s:";
 
 /*!
   \brief Display usage
@@ -50,6 +73,8 @@ void usage(char * progname)
             << std::endl;
   std::cerr << "          covreach       reachability algorithm over the zone graph with inclusion subsumption" << std::endl;
   std::cerr << "          aLU-covreach   reachability algorithm over the zone graph with aLU subsumption" << std::endl;
+  std::cerr << "          aLU-d-covreach reachability algorithm over the zone graph with LU-d subsumption (diagonal constraints)"
+            << std::endl;
   std::cerr << "   -C type       type of certificate" << std::endl;
   std::cerr << "          none       no certificate (default)" << std::endl;
   std::cerr << "          graph      graph of explored state-space" << std::endl;
@@ -57,20 +82,52 @@ void usage(char * progname)
   std::cerr << "          concrete   concrete run to a state with searched labels if any (only for reach and covreach)"
             << std::endl;
   std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -j n          number of threads (default: 1, at most 1024, only for covreach without certificate)" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of searched labels" << std::endl;
   std::cerr << "   -o out_file   output file for certificate (default is standard output)" << std::endl;
-  std::cerr << "   -s bfs|dfs    search order" << std::endl;
+  std::cerr << "   -s bfs|dfs|random  search order" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "   --trace c1,c2,...  comma-separated list of traced categories (tool, covreach, gsim, all)" << std::endl;
+  std::cerr << "   --trace-file f     output file for traces (default is standard error)" << std::endl;
+  std::cerr << "   --zone-storage full|minimal  storage of zones in passed nodes (default: full)" << std::endl;
+  std::cerr << "          full       full DBMs" << std::endl;
+  std::cerr << "          minimal    minimal constraint graphs (only for covreach with a single thread)" << std::endl;
+  std::cerr << "   --memory-limit size  spill zones of passed nodes to disk beyond size bytes (suffix K, M or G)"
+            << std::endl;
+  std::cerr << "                        (only for reach and covreach with a single thread)" << std::endl;
+  std::cerr << "   --spill-dir dir      directory of the spill file (default: $TMPDIR, or /tmp)" << std::endl;
+  std::cerr << "   --bitstate size      store visited states as hash bits in a table of size bytes (suffix K, M or G)"
+            << std::endl;
+  std::cerr << "                        under-approximate search (only for reach without certificate)" << std::endl;
+  std::cerr << "   --bitstate-hashes k  number of bits per state in the bit-state table (default: 3)" << std::endl;
+  std::cerr << "   --swarm n            run n diversified explorations in parallel, the first one to terminate wins"
+            << std::endl;
+  std::cerr << "                        (at most 1024 runs," << std::endl;
+  std::cerr << "                        only for covreach with a single thread and full zone storage)" << std::endl;
+  std::cerr << "   --seed s             seed of randomized swarm explorations (default: 0)" << std::endl;
+  std::cerr << "   --cover-graph list|soa  storage of nodes for covering checks (default: list)" << std::endl;
+  std::cerr << "          list       nodes are compared one by one" << std::endl;
+  std::cerr << "          soa        zones with same discrete part are compared at once using SIMD instructions"
+            << std::endl;
+  std::cerr << "                     (only for covreach and aLU-covreach with a single thread, no memory limit and"
+            << std::endl;
+  std::cerr << "                     no swarm)" << std::endl;
+  std::cerr << "   --native lib_file    evaluate guards, statements and invariants with the native model in lib_file"
+            << std::endl;
+  std::cerr << "                        (shared object built by tck-compile from the same system)" << std::endl;
+  std::cerr << "   --detailed-stats     output statistics on the internals of the algorithm" << std::endl;
+  std::cerr << "                        (only for concur19, covreach and aLU-covreach)" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
 
 enum algorithm_t {
-  ALGO_REACH,        /*!< Reachability algorithm */
-  ALGO_CONCUR19,     /*!< Covering reachability algorithm over the local-time zone graph */
-  ALGO_COVREACH,     /*!< Covering reachability algorithm */
-  ALGO_ALU_COVREACH, /*!< Covering reachability algorithm with aLU subsumption*/
-  ALGO_NONE,         /*!< No algorithm */
+  ALGO_REACH,          /*!< Reachability algorithm */
+  ALGO_CONCUR19,       /*!< Covering reachability algorithm over the local-time zone graph */
+  ALGO_COVREACH,       /*!< Covering reachability algorithm */
+  ALGO_ALU_COVREACH,   /*!< Covering reachability algorithm with aLU subsumption*/
+  ALGO_ALU_D_COVREACH, /*!< Covering reachability algorithm with LU-d subsumption */
+  ALGO_NONE,           /*!< No algorithm */
 };
 
 enum certificate_t {
@@ -89,6 +146,87 @@ static std::string output_file = "";                      /*!< Output file name
 static std::ostream * os = &std::cout;                    /*!< Default output stream */
 static std::size_t block_size = 10000;                    /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;                    /*!< Size of hash tables */
+static std::size_t threads = 1;                           /*!< Number of threads */
+static constexpr std::size_t MAX_THREADS = 1024;          /*!< Maximal number of threads and swarm runs */
+static std::string trace_file = "";                       /*!< Trace file name (empty means standard error) */
+static enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage =
+    tchecker::tck_reach::zg_covreach::ZONE_STORAGE_FULL; /*!< Storage of zones in passed nodes */
+static std::size_t memory_limit = 0;                     /*!< Memory limit for zones of passed nodes (0: no limit) */
+static std::string spill_dir = "";                       /*!< Directory of the spill file (empty: $TMPDIR or /tmp) */
+static std::size_t bitstate_size = 0;                    /*!< Size of bit-state table in bytes (0: no bit-state hashing) */
+static unsigned int bitstate_hashes = 3;                 /*!< Number of bits per state in bit-state table */
+static std::size_t swarm = 0;                            /*!< Number of swarm runs (0: no swarm) */
+static std::uint64_t seed = 0;                           /*!< Seed of randomized swarm runs */
+static bool soa_cover_graph = false;                     /*!< Batched covering checks over buckets of zones */
+static std::string native_file = "";                     /*!< Native model file name (empty means no native model) */
+static bool detailed_stats = false;                      /*!< Output of detailed statistics */
+
+/*!
+ \brief Parse a memory size
+ \param s : a memory size, a positive integer with an optional suffix K, M or G
+ \return the number of bytes in s
+ \throw std::runtime_error : if s is not a valid memory size
+ */
+static std::size_t parse_memory_size(char const * s)
+{
+  // strtoull accepts a sign, and negates the value if it is '-'
+  if (!std::isdigit(static_cast<unsigned char>(*s)))
+    throw std::runtime_error("Invalid memory size: " + std::string(s));
+  char * end = nullptr;
+  errno = 0;
+  unsigned long long size = std::strtoull(s, &end, 10);
+  if (errno == ERANGE)
+    throw std::runtime_error("Memory size out of range: " + std::string(s));
+  unsigned int shift = 0;
+  switch (*end) {
+  case 'G':
+  case 'g':
+    shift = 30;
+    ++end;
+    break;
+  case 'M':
+  case 'm':
+    shift = 20;
+    ++end;
+    break;
+  case 'K':
+  case 'k':
+    shift = 10;
+    ++end;
+    break;
+  default:
+    break;
+  }
+  if (*end != '\0' || size == 0)
+    throw std::runtime_error("Invalid memory size: " + std::string(s));
+  if (size > (std::numeric_limits<std::size_t>::max() >> shift))
+    throw std::runtime_error("Memory size out of range: " + std::string(s));
+  return static_cast<std::size_t>(size) << shift;
+}
+
+/*!
+ \brief Parse a count of threads or runs
+ \param s : a positive integer
+ \param max : maximal value
+ \param what : description of the count, for error messages
+ \return the value of s
+ \throw std::runtime_error : if s is not a positive integer, or if it is greater than max
+ */
+static std::size_t parse_count(char const * s, std::size_t max, std::string const & what)
+{
+  // strtoull accepts a sign, and negates the value if it is '-'
+  if (!std::isdigit(static_cast<unsigned char>(*s)))
+    throw std::runtime_error("Invalid number of " + what + ": " + std::string(s));
+  char * end = nullptr;
+  errno = 0;
+  unsigned long long count = std::strtoull(s, &end, 10);
+  if (*end != '\0' || count == 0)
+    throw std::runtime_error("Invalid number of " + what + ": " + std::string(s));
+  if (errno == ERANGE || count > max)
+    throw std::runtime_error("Number of " + what + " out of range (at most " + std::to_string(max) +
+                             "): " + std::string(s));
+  return static_cast<std::size_t>(count);
+}
 
 /*!
  \brief Check if expected certificate is a path
@@ -110,7 +248,6 @@ static bool is_certificate_path(enum certificate_t ctype)
 */
 int parse_command_line(int argc, char * argv[])
 {
-  std::cout << "[tck-reach] parsing command line (" << argc << " args)" << std::endl;
   while (true) {
     int long_option_index = -1;
     int c = getopt_long(argc, argv, options, long_options, &long_option_index);
@@ -133,6 +270,8 @@ int parse_command_line(int argc, char * argv[])
           algorithm = ALGO_COVREACH;
         else if (strcmp(optarg, "aLU-covreach") == 0)
           algorithm = ALGO_ALU_COVREACH;
+        else if (strcmp(optarg, "aLU-d-covreach") == 0)
+          algorithm = ALGO_ALU_D_COVREACH;
         else
           throw std::runtime_error("Unknown algorithm: " + std::string(optarg));
         break;
@@ -154,6 +293,9 @@ int parse_command_line(int argc, char * argv[])
       case 'h':
         help = true;
         break;
+      case 'j':
+        threads = parse_count(optarg, MAX_THREADS, "threads");
+        break;
       case 'l':
         labels = optarg;
         break;
@@ -170,13 +312,45 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "trace") == 0)
+        tchecker::trace::enable(tchecker::trace::parse_categories(optarg));
+      else if (strcmp(long_options[long_option_index].name, "trace-file") == 0)
+        trace_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "zone-storage") == 0)
+        zone_storage = tchecker::tck_reach::zg_covreach::parse_zone_storage(optarg);
+      else if (strcmp(long_options[long_option_index].name, "memory-limit") == 0)
+        memory_limit = parse_memory_size(optarg);
+      else if (strcmp(long_options[long_option_index].name, "spill-dir") == 0)
+        spill_dir = optarg;
+      else if (strcmp(long_options[long_option_index].name, "bitstate") == 0)
+        bitstate_size = parse_memory_size(optarg);
+      else if (strcmp(long_options[long_option_index].name, "bitstate-hashes") == 0) {
+        bitstate_hashes = static_cast<unsigned int>(std::strtoul(optarg, nullptr, 10));
+        if (bitstate_hashes == 0 || bitstate_hashes > 32)
+          throw std::runtime_error("Invalid number of bit-state hashes: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "swarm") == 0) {
+        swarm = parse_count(optarg, MAX_THREADS, "swarm runs");
+      }
+      else if (strcmp(long_options[long_option_index].name, "seed") == 0)
+        seed = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "cover-graph") == 0) {
+        if (strcmp(optarg, "list") == 0)
+          soa_cover_graph = false;
+        else if (strcmp(optarg, "soa") == 0)
+          soa_cover_graph = true;
+        else
+          throw std::runtime_error("Unknown cover graph: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "native") == 0)
+        native_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "detailed-stats") == 0)
+        detailed_stats = true;
       else
         throw std::runtime_error("This also should never be executed");
     }
   }
 
-  std::cout << "[tck-reach] command-line parsed: algorithm=" << algorithm << " certificate=" << certificate
-            << " search_order=" << search_order << " labels=" << labels << std::endl;
   return optind;
 }
 
@@ -189,22 +363,71 @@ int parse_command_line(int argc, char * argv[])
 */
 std::shared_ptr<tchecker::parsing::system_declaration_t> load_system_declaration(std::string const & filename)
 {
-  std::cout << "[tck-reach] loading system declaration from '" << (filename.empty() ? "<stdin>" : filename) << "'"
-            << std::endl;
+  TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_TOOL,
+                 "loading system declaration from " << (filename.empty() ? "standard input" : filename));
   std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{nullptr};
   try {
     sysdecl = tchecker::parsing::parse_system_declaration(filename);
     if (sysdecl == nullptr)
       throw std::runtime_error("nullptr system declaration");
-    std::cout << "[tck-reach] system declaration loaded: " << sysdecl->name() << std::endl;
+    TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_TOOL, "loaded system " << sysdecl->name());
   }
   catch (std::exception const & e) {
     std::cerr << tchecker::log_error << e.what() << std::endl;
-    std::cout << "[tck-reach] system declaration loading failed" << std::endl;
   }
   return sysdecl;
 }
 
+/*!
+ \brief Load a native model
+ \param filename : shared object built by tck-compile
+ \param sysdecl : system declaration
+ \post the native model in filename has been registered (see tchecker::ta::set_native_model): it is used by all
+ systems built from sysdecl
+ \throw std::runtime_error : if filename cannot be loaded, or if its native model has not been compiled from sysdecl
+ \note filename is never unloaded
+*/
+void load_native_model(std::string const & filename, tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_TOOL, "loading native model from " << filename);
+  void * handle = ::dlopen(filename.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (handle == nullptr)
+    throw std::runtime_error("Cannot load native model: " + std::string(::dlerror()));
+
+  auto native_model =
+      reinterpret_cast<tchecker::ta::native_model_function_t>(::dlsym(handle, TCHECKER_NATIVE_MODEL_SYMBOL));
+  if (native_model == nullptr)
+    throw std::runtime_error("No native model in " + filename);
+
+  tchecker::ta::native_model_t const * model = native_model();
+  tchecker::ta::system_t const system{sysdecl};
+  if (model == nullptr || !tchecker::ta::native_compatible(system, *model))
+    throw std::runtime_error("Native model in " + filename + " has not been compiled from system " + sysdecl.name());
+
+  tchecker::ta::set_native_model(model);
+  TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_TOOL, "loaded native model " << model->name);
+}
+
+/*!
+ \brief Perform reachability analysis with bit-state hashing
+ \param sysdecl : system declaration
+ \post statistics on reachability analysis of command-line specified labels in
+ the system declared by sysdecl, and on the bit-state table, have been output to
+ standard output
+*/
+void bitstate_reach(tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  auto && [stats, state_space] = tchecker::tck_reach::zg_bitstate_reach::run(
+      sysdecl, labels, search_order, block_size, table_size, 8 * bitstate_size, bitstate_hashes);
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  state_space->graph().bitstate().attributes(m);
+  for (auto && [key, value] : m)
+    std::cout << key << " " << value << std::endl;
+}
+
 /*!
  \brief Perform reachability analysis
  \param sysdecl : system declaration
@@ -214,7 +437,13 @@ std::shared_ptr<tchecker::parsing::system_declaration_t> load_system_declaration
 */
 void reach(tchecker::parsing::system_declaration_t const & sysdecl)
 {
-  auto && [stats, state_space] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size);
+  if (bitstate_size > 0) {
+    bitstate_reach(sysdecl);
+    return;
+  }
+
+  auto && [stats, state_space] =
+      tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size, memory_limit, spill_dir);
 
   // stats
   std::map<std::string, std::string> m;
@@ -223,6 +452,9 @@ void reach(tchecker::parsing::system_declaration_t const & sysdecl)
     std::cout << key << " " << value << std::endl;
 
   // certificate
+  if (certificate != CERTIFICATE_NONE)
+    state_space->graph().restore_states();
+
   if (certificate == CERTIFICATE_GRAPH)
     tchecker::tck_reach::zg_reach::dot_output(*os, state_space->graph(), sysdecl.name());
   else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
@@ -266,6 +498,8 @@ void concur19(tchecker::parsing::system_declaration_t const & sysdecl)
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
+  if (detailed_stats)
+    stats.detailed_attributes(m);
   for (auto && [key, value] : m)
     std::cout << key << " " << value << std::endl;
 
@@ -281,6 +515,49 @@ void concur19(tchecker::parsing::system_declaration_t const & sysdecl)
   }
 }
 
+/*!
+ \brief Perform covering reachability analysis with a swarm of diversified runs
+ \param sysdecl : system declaration
+ \post statistics on the first run of the swarm that has terminated the covering
+ reachability analysis of command-line specified labels in the system declared
+ by sysdecl have been output to standard output, as well as statistics on the
+ swarm. A certification from this run has been output if required.
+*/
+void swarm_covreach(tchecker::parsing::system_declaration_t const & sysdecl)
+{
+  tchecker::algorithms::covreach::covering_t covering =
+      (is_certificate_path(certificate) ? tchecker::algorithms::covreach::COVERING_LEAF_NODES
+                                        : tchecker::algorithms::covreach::COVERING_FULL);
+  auto && [stats, state_space] = tchecker::tck_reach::zg_swarm_covreach::run(sysdecl, labels, search_order, covering,
+                                                                            swarm, seed, block_size, table_size);
+
+  // stats
+  std::map<std::string, std::string> m;
+  stats.attributes(m);
+  if (detailed_stats)
+    stats.detailed_attributes(m);
+  for (auto && [key, value] : m)
+    std::cout << key << " " << value << std::endl;
+
+  // certificate
+  if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::zg_covreach::dot_output(*os, state_space->graph(), sysdecl.name());
+  else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::concrete_cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::concrete_counter_example(state_space->graph())};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a concrete counter example");
+    tchecker::tck_reach::zg_covreach::cex::dot_output(*os, *cex, sysdecl.name());
+  }
+  else if ((certificate == CERTIFICATE_SYMBOLIC) && stats.reachable()) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::symbolic_cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::symbolic_counter_example(state_space->graph())};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a symbolic counter example");
+    tchecker::tck_reach::zg_covreach::cex::dot_output(*os, *cex, sysdecl.name());
+  }
+}
+
 /*!
  \brief Perform covering reachability analysis
  \param sysdecl : system declaration
@@ -290,21 +567,43 @@ void concur19(tchecker::parsing::system_declaration_t const & sysdecl)
 */
 void covreach(tchecker::parsing::system_declaration_t const & sysdecl)
 {
+  if (swarm > 0) {
+    swarm_covreach(sysdecl);
+    return;
+  }
+
+  if (threads > 1) {
+    tchecker::algorithms::covreach::stats_t stats =
+        tchecker::tck_reach::zg_parallel_covreach::run(sysdecl, labels, search_order, threads, block_size, table_size);
+
+    std::map<std::string, std::string> m;
+    stats.attributes(m);
+    if (detailed_stats)
+      stats.detailed_attributes(m);
+    for (auto && [key, value] : m)
+      std::cout << key << " " << value << std::endl;
+    return;
+  }
+
   tchecker::algorithms::covreach::covering_t covering =
       (is_certificate_path(certificate) ? tchecker::algorithms::covreach::COVERING_LEAF_NODES
                                         : tchecker::algorithms::covreach::COVERING_FULL);
-  std::cout << "[tck-reach] covreach: invoking zg_covreach::run" << std::endl;
-  auto && [stats, state_space] =
-      tchecker::tck_reach::zg_covreach::run(sysdecl, labels, search_order, covering, block_size, table_size);
-  std::cout << "[tck-reach] covreach: run returned" << std::endl;
+  auto && [stats, state_space] = tchecker::tck_reach::zg_covreach::run(
+      sysdecl, labels, search_order, covering, block_size, table_size, zone_storage, memory_limit, spill_dir,
+      soa_cover_graph);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
+  if (detailed_stats)
+    stats.detailed_attributes(m);
   for (auto && [key, value] : m)
     std::cout << key << " " << value << std::endl;
 
   // certificate
+  if (certificate != CERTIFICATE_NONE)
+    state_space->graph().restore_states();
+
   if (certificate == CERTIFICATE_GRAPH)
     tchecker::tck_reach::zg_covreach::dot_output(*os, state_space->graph(), sysdecl.name());
   else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
@@ -326,25 +625,32 @@ void covreach(tchecker::parsing::system_declaration_t const & sysdecl)
 /*!
  \brief Perform covering reachability analysis with aLU subsumption
  \param sysdecl : system declaration
+ \param diagonals : LU-d subsumption flag
  \post statistics on aLU covering reachability analysis of command-line specified
  labels in the system declared by sysdecl have been output to standard output.
  A certification has been output if required.
 */
-void alu_covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+void alu_covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, bool diagonals)
 {
   tchecker::algorithms::covreach::covering_t covering =
       (is_certificate_path(certificate) ? tchecker::algorithms::covreach::COVERING_LEAF_NODES
                                         : tchecker::algorithms::covreach::COVERING_FULL);
   auto && [stats, state_space] =
-      tchecker::tck_reach::zg_alu_covreach::run(sysdecl, labels, search_order, covering, block_size, table_size);
+      tchecker::tck_reach::zg_alu_covreach::run(sysdecl, labels, search_order, covering, block_size, table_size,
+                                                diagonals, soa_cover_graph);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
+  if (detailed_stats)
+    stats.detailed_attributes(m);
   for (auto && [key, value] : m)
     std::cout << key << " " << value << std::endl;
 
   // certificate
+  if (certificate != CERTIFICATE_NONE)
+    state_space->graph().restore_states();
+
   if (certificate == CERTIFICATE_GRAPH)
     tchecker::tck_reach::zg_alu_covreach::dot_output(*os, state_space->graph(), sysdecl->name());
   else if ((certificate == CERTIFICATE_CONCRETE) && stats.reachable()) {
@@ -369,7 +675,6 @@ void alu_covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const
 int main(int argc, char * argv[])
 {
   try {
-    std::cout << "[tck-reach] main entry" << std::endl;
     int optindex = parse_command_line(argc, argv);
 
     if (argc - optindex > 1) {
@@ -383,19 +688,80 @@ int main(int argc, char * argv[])
       return EXIT_FAILURE;
     }
 
+    if ((threads > 1) && (algorithm != ALGO_COVREACH)) {
+      std::cerr << "Multiple threads are only available for algorithm covreach" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if ((threads > 1) && (certificate != CERTIFICATE_NONE)) {
+      std::cerr << "Certificates are not available with multiple threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if ((zone_storage == tchecker::tck_reach::zg_covreach::ZONE_STORAGE_MINIMAL) &&
+        ((algorithm != ALGO_COVREACH) || (threads > 1))) {
+      std::cerr << "Minimal zone storage is only available for algorithm covreach with a single thread" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if ((memory_limit > 0) && (((algorithm != ALGO_COVREACH) && (algorithm != ALGO_REACH)) || (threads > 1))) {
+      std::cerr << "Memory limit is only available for algorithms reach and covreach with a single thread" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (!spill_dir.empty() && (memory_limit == 0)) {
+      std::cerr << "Spill directory requires a memory limit" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if ((bitstate_size > 0) && ((algorithm != ALGO_REACH) || (certificate != CERTIFICATE_NONE) || (memory_limit > 0))) {
+      std::cerr << "Bit-state hashing is only available for algorithm reach without certificate nor memory limit"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if ((swarm > 0) && ((algorithm != ALGO_COVREACH) || (threads > 1) ||
+                        (zone_storage != tchecker::tck_reach::zg_covreach::ZONE_STORAGE_FULL) || (memory_limit > 0))) {
+      std::cerr << "Swarm is only available for algorithm covreach with a single thread, full zone storage and no "
+                   "memory limit"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if (soa_cover_graph && (((algorithm != ALGO_COVREACH) && (algorithm != ALGO_ALU_COVREACH)) || (threads > 1) ||
+                            (swarm > 0) || (memory_limit > 0))) {
+      std::cerr << "SoA cover graph is only available for algorithms covreach and aLU-covreach with a single thread, "
+                   "no memory limit and no swarm"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
     if (help) {
       usage(argv[0]);
       return EXIT_SUCCESS;
     }
 
+    std::shared_ptr<std::ofstream> trace_os_ptr{nullptr};
+
+    if (trace_file != "") {
+      trace_os_ptr = std::make_shared<std::ofstream>(trace_file);
+      if (!trace_os_ptr->good()) {
+        std::cerr << tchecker::log_error << "cannot open trace file " << trace_file << std::endl;
+        return EXIT_FAILURE;
+      }
+      tchecker::trace::set_sink(*trace_os_ptr);
+    }
+
     std::string input_file = (optindex == argc ? "" : argv[optindex]);
-    std::cout << "[tck-reach] selected input file: " << (input_file.empty() ? "<stdin>" : input_file) << std::endl;
 
     std::shared_ptr<tchecker::parsing::system_declaration_t> sysdecl{load_system_declaration(input_file)};
 
     if (tchecker::log_error_count() > 0)
       return EXIT_FAILURE;
 
+    if (native_file != "")
+      load_native_model(native_file, *sysdecl);
+
     std::shared_ptr<std::ofstream> os_ptr{nullptr};
 
     if (certificate != CERTIFICATE_NONE && output_file != "") {
@@ -411,20 +777,19 @@ int main(int argc, char * argv[])
 
     switch (algorithm) {
     case ALGO_REACH:
-      std::cout << "[tck-reach] running reach" << std::endl;
       reach(*sysdecl);
       break;
     case ALGO_CONCUR19:
-      std::cout << "[tck-reach] running concur19" << std::endl;
       concur19(*sysdecl);
       break;
     case ALGO_COVREACH:
-      std::cout << "[tck-reach] running covreach" << std::endl;
       covreach(*sysdecl);
       break;
     case ALGO_ALU_COVREACH:
-      std::cout << "[tck-reach] running alu-covreach" << std::endl;
-      alu_covreach(sysdecl);
+      alu_covreach(sysdecl, false);
+      break;
+    case ALGO_ALU_D_COVREACH:
+      alu_covreach(sysdecl, true);
       break;
     default:
       throw std::runtime_error("No algorithm specified");
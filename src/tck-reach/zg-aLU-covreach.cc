@@ -5,12 +5,16 @@
  *
  */
 
+#include <algorithm>
+#include <cassert>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
 #include "tchecker/algorithms/search_order.hh"
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/static_analysis.hh"
 #include "tchecker/ta/state.hh"
 #include "tchecker/utils/log.hh"
 #include "zg-aLU-covreach.hh"
@@ -24,12 +28,14 @@ namespace zg_alu_covreach {
 /* node_t */
 
 node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_compact_zg_state_t(s),
+      _hash(tchecker::ta::shared_hash_value(*s))
 {
 }
 
 node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_compact_zg_state_t(s),
+      _hash(tchecker::ta::shared_hash_value(*s))
 {
 }
 
@@ -39,21 +45,76 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_alu_covreach::node_t
 {
   // NB: we hash on the discrete (i.e. ta) part of the state in n to check all nodes
   // with same discrete part for covering
-  return tchecker::ta::shared_hash_value(n.state());
+  return n.hash();
 }
 
 /* node_le_t */
 
-node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t table_size)
-    : _cached_local_lu(local_lu, table_size, std::move(const_vloc_sptr_hash_t{}), std::move(const_vloc_sptr_equal_t{}))
+node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu,
+                     std::shared_ptr<tchecker::clockbounds::local_d_map_t> const & local_d, std::size_t table_size)
+    : _cached_local_lu(local_lu, table_size)
 {
+  if (local_d.get() != nullptr)
+    _cached_local_d.emplace(local_d, table_size);
 }
 
 bool node_le_t::operator()(tchecker::tck_reach::zg_alu_covreach::node_t const & n1,
                            tchecker::tck_reach::zg_alu_covreach::node_t const & n2) const
 {
-  auto lu_maps_references = _cached_local_lu.bounds(n2.state().vloc_ptr());
-  return tchecker::zg::shared_is_alu_le(n1.state(), n2.state(), lu_maps_references.L, lu_maps_references.U);
+  auto lu_maps_references = _cached_local_lu.bounds(n2.state().vloc());
+  if (!_cached_local_d.has_value())
+    return tchecker::zg::shared_is_alu_le(n1.state(), n2.state(), lu_maps_references.L, lu_maps_references.U);
+  return tchecker::zg::shared_is_alu_d_le(n1.state(), n2.state(), lu_maps_references.L, lu_maps_references.U,
+                                          _cached_local_d->diagonals(n2.state().vloc()));
+}
+
+bool node_le_t::comparable(tchecker::tck_reach::zg_alu_covreach::node_t const & n1,
+                           tchecker::tck_reach::zg_alu_covreach::node_t const & n2) const
+{
+  return (n1.vloc_ptr() == n2.vloc_ptr() && n1.intval_ptr() == n2.intval_ptr());
+}
+
+tchecker::clock_id_t node_le_t::dim(tchecker::tck_reach::zg_alu_covreach::node_t const & n) const
+{
+  return static_cast<tchecker::clock_id_t>(n.state().zone().dim());
+}
+
+std::uint64_t node_le_t::signature(tchecker::tck_reach::zg_alu_covreach::node_t const & n) const
+{
+  tchecker::zg::zone_t const & z = n.state().zone();
+  if (_cached_local_d.has_value() || z.is_empty())
+    return 0;
+  auto lu_maps_references = _cached_local_lu.bounds(n.state().vloc());
+  return tchecker::dbm::alu_signature(z.dbm(), static_cast<tchecker::clock_id_t>(z.dim()),
+                                      lu_maps_references.L.ptr(), lu_maps_references.U.ptr());
+}
+
+bool node_le_t::normalize(tchecker::tck_reach::zg_alu_covreach::node_t const & n, tchecker::dbm::db_t * dbm) const
+{
+  tchecker::zg::zone_t const & z = n.state().zone();
+  std::size_t const size = static_cast<std::size_t>(z.dim()) * static_cast<std::size_t>(z.dim());
+  std::copy(z.dbm(), z.dbm() + size, dbm);
+  return !z.is_empty();
+}
+
+void node_le_t::is_le_batch(tchecker::tck_reach::zg_alu_covreach::node_t const & n, tchecker::dbm::db_t const * dbm,
+                            tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count,
+                            tchecker::clock_id_t dim, std::uint64_t * le) const
+{
+  assert(!_cached_local_d.has_value());
+  auto lu_maps_references = _cached_local_lu.bounds(n.state().vloc());
+  tchecker::dbm::is_alu_le_batch(dbm, batch, stride, count, dim, lu_maps_references.L.ptr(),
+                                 lu_maps_references.U.ptr(), le);
+}
+
+void node_le_t::is_ge_batch(tchecker::tck_reach::zg_alu_covreach::node_t const & n, tchecker::dbm::db_t const * dbm,
+                            tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count,
+                            tchecker::clock_id_t dim, std::uint64_t * ge) const
+{
+  assert(!_cached_local_d.has_value());
+  auto lu_maps_references = _cached_local_lu.bounds(n.state().vloc());
+  tchecker::dbm::is_alu_ge_batch(dbm, batch, stride, count, dim, lu_maps_references.L.ptr(),
+                                 lu_maps_references.U.ptr(), ge);
 }
 
 /* edge_t */
@@ -63,15 +124,31 @@ edge_t::edge_t(tchecker::zg::transition_t const & t) : tchecker::graph::edge_ved
 /* graph_t */
 
 graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
-                 std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t block_size,
-                 std::size_t table_size)
-    : tchecker::graph::subsumption::graph_t<
-          tchecker::tck_reach::zg_alu_covreach::node_t, tchecker::tck_reach::zg_alu_covreach::edge_t,
-          tchecker::tck_reach::zg_alu_covreach::node_hash_t, tchecker::tck_reach::zg_alu_covreach::node_le_t>(
-          block_size, table_size, tchecker::tck_reach::zg_alu_covreach::node_hash_t(),
-          tchecker::tck_reach::zg_alu_covreach::node_le_t(local_lu, table_size)),
+                 std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu,
+                 std::shared_ptr<tchecker::clockbounds::local_d_map_t> const & local_d, std::size_t block_size,
+                 std::size_t table_size, bool soa_cover_graph)
+    : base_graph_t(block_size, table_size, tchecker::tck_reach::zg_alu_covreach::node_hash_t(),
+                   tchecker::tck_reach::zg_alu_covreach::node_le_t(local_lu, local_d, table_size)),
       _zg(zg)
 {
+  if (soa_cover_graph && local_d.get() != nullptr)
+    throw std::invalid_argument("Batched covering checks are not available for LU-d subsumption");
+  cover_graph().set_batched(soa_cover_graph);
+}
+
+graph_t::~graph_t() { clear(); }
+
+void graph_t::passed_node(graph_t::base_graph_t::node_sptr_t const & n)
+{
+  // with batched covering checks, the zone of n is only read from its bucket
+  if (cover_graph().batched() && !n->is_compact())
+    n->compact(_compact_pool);
+}
+
+void graph_t::restore_states()
+{
+  for (node_sptr_t const & n : nodes())
+    n->restore(*_zg, _compact_pool);
 }
 
 void graph_t::attributes(tchecker::tck_reach::zg_alu_covreach::node_t const & n, std::map<std::string, std::string> & m) const
@@ -142,9 +219,10 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_alu_covreac
 /* state_space_t */
 
 state_space_t::state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
-                             std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t block_size,
-                             std::size_t table_size)
-    : _ss(zg, zg, local_lu, block_size, table_size)
+                             std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu,
+                             std::shared_ptr<tchecker::clockbounds::local_d_map_t> const & local_d, std::size_t block_size,
+                             std::size_t table_size, bool soa_cover_graph)
+    : _ss(zg, zg, local_lu, local_d, block_size, table_size, soa_cover_graph)
 {
 }
 
@@ -186,21 +264,30 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_alu_covreac
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_alu_covreach::state_space_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
     std::string const & search_order, tchecker::algorithms::covreach::covering_t covering, std::size_t block_size,
-    std::size_t table_size)
+    std::size_t table_size, bool diagonals, bool soa_cover_graph)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
+  if (!diagonals && tchecker::ta::has_diagonal_constraint(*system))
+    throw std::invalid_argument("aLU subsumption is not sound with diagonal clock constraints, use aLU-d-covreach");
+
+  if (diagonals && soa_cover_graph)
+    throw std::invalid_argument("Batched covering checks are not available for LU-d subsumption");
+
   std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
 
+  // LU-d simulation is finite on non-extrapolated zones, and extrapolations are not sound with diagonal constraints
+  enum tchecker::zg::extrapolation_type_t extrapolation =
+      (diagonals ? tchecker::zg::NO_EXTRAPOLATION : tchecker::zg::EXTRA_LU_PLUS_LOCAL);
   std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
-                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, *clock_bounds, block_size,
-                                                               table_size)};
+                                                               extrapolation, *clock_bounds, block_size, table_size)};
 
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t> local_d{diagonals ? clock_bounds->local_d_map() : nullptr};
   std::shared_ptr<tchecker::tck_reach::zg_alu_covreach::state_space_t> state_space =
-      std::make_shared<tchecker::tck_reach::zg_alu_covreach::state_space_t>(zg, clock_bounds->local_lu_map(), block_size,
-                                                                            table_size);
+      std::make_shared<tchecker::tck_reach::zg_alu_covreach::state_space_t>(zg, clock_bounds->local_lu_map(), local_d,
+                                                                            block_size, table_size, soa_cover_graph);
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
@@ -218,6 +305,10 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, st
   else
     throw std::invalid_argument("Unknown covering policy for covreach algorithm");
 
+  stats.signature_checks() = state_space->graph().signature_checks();
+  stats.signature_rejections() = state_space->graph().signature_rejections();
+  stats.signature_misses() = state_space->graph().signature_misses();
+
   return std::make_tuple(stats, state_space);
 }
 
@@ -13,10 +13,13 @@
  \brief Covering reachability algorithm over the zone graph with aLU subsumption
 */
 
+#include <cstdint>
 #include <memory>
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
 #include "tchecker/clockbounds/cache.hh"
+#include <optional>
+
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
@@ -39,10 +42,11 @@ namespace zg_alu_covreach {
 /*!
  \class node_t
  \brief Node of the covering reachability graph of a zone graph
+ \note passed nodes are compacted when covering checks are batched (see tchecker::graph::node_compact_zg_state_t)
  */
 class node_t : public tchecker::waiting::element_t,
                public tchecker::graph::node_flags_t,
-               public tchecker::graph::node_zg_state_t {
+               public tchecker::graph::node_compact_zg_state_t {
 public:
   /*!
    \brief Constructor
@@ -61,6 +65,15 @@ public:
    \post this node keeps a shared pointer to s, and has initial/final node flags as specified
    */
   node_t(tchecker::zg::const_state_sptr_t const & s, bool initial = false, bool final = false);
+
+  /*!
+   \brief Accessor
+   \return hash value of the discrete part of this node (see tchecker::ta::shared_hash_value)
+   */
+  inline std::size_t hash() const { return _hash; }
+
+private:
+  std::size_t _hash; /*!< Hash value of the discrete part */
 };
 
 /*!
@@ -88,28 +101,98 @@ public:
   /*!
    \brief Constructor
    \param local_lu : local LU clock bounds
-   \param table_size : size of clock bounds cache
-   \post this keeps a shared pointer to local_lu
+   \param local_d : local diagonal constraints (nullptr for aLU subsumption)
+   \param table_size : initial capacity of clock bounds cache
+   \post this keeps a shared pointer to local_lu and to local_d
    \throw std::invalid_argument : if local_lu points to nullptr
    */
-  node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t table_size);
+  node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu,
+            std::shared_ptr<tchecker::clockbounds::local_d_map_t> const & local_d, std::size_t table_size);
 
   /*!
   \brief Covering predicate for nodes
   \param n1 : a node
   \param n2 : a node
   \return true if n1 and n2 have same discrete part and the zone of n1 is
-  included in the zone of n2, false otherwise
+  included in the aLU-abstraction of the zone of n2 (LU-d simulation if local
+  diagonal constraints have been provided), false otherwise
   */
   bool operator()(tchecker::tck_reach::zg_alu_covreach::node_t const & n1,
                   tchecker::tck_reach::zg_alu_covreach::node_t const & n2) const;
 
-private:
-  using const_vloc_sptr_hash_t = tchecker::intrusive_shared_ptr_hash_t;
-  using const_vloc_sptr_equal_t = std::equal_to<tchecker::const_vloc_sptr_t>;
+  /*!
+   \brief Comparability of nodes
+   \param n1 : a node
+   \param n2 : a node
+   \return true if n1 and n2 have same discrete part, false otherwise
+   */
+  bool comparable(tchecker::tck_reach::zg_alu_covreach::node_t const & n1,
+                  tchecker::tck_reach::zg_alu_covreach::node_t const & n2) const;
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return dimension of the zone of n
+   */
+  tchecker::clock_id_t dim(tchecker::tck_reach::zg_alu_covreach::node_t const & n) const;
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return signature of the zone of n w.r.t. the LU bounds of the tuple of locations of n (see
+   tchecker::dbm::alu_signature), 0 if the zone of n is empty or for LU-d subsumption
+   \note n1 is covered by n2 only if the signature of n1 is less-than-or-equal-to the signature of n2
+   w.r.t. tchecker::dbm::signature_le
+   */
+  std::uint64_t signature(tchecker::tck_reach::zg_alu_covreach::node_t const & n) const;
+
+  /*!
+   \brief Normalized zone of a node
+   \param n : a node
+   \param dbm : a DBM of dimension dim(n)
+   \post dbm is a copy of the zone of n
+   \return false if the zone of n is empty, true otherwise
+   */
+  bool normalize(tchecker::tck_reach::zg_alu_covreach::node_t const & n, tchecker::dbm::db_t * dbm) const;
+
+  /*!
+   \brief aLU covering predicate for a node w.r.t. a batch of nodes
+   \param n : a node
+   \param dbm : zone of n
+   \param batch : zones of nodes with same discrete part as n (see tchecker::dbm::is_le_batch)
+   \param stride : distance between two consecutive bounds of a zone in batch
+   \param count : number of zones in batch
+   \param dim : dimension of zones
+   \param le : bit set of (count+63)/64 words
+   \pre this predicate is not LU-d subsumption (checked by assertion)
+   \post bit k of le is set iff dbm is included in the aLU-abstraction of the k-th zone of batch, w.r.t. the
+   LU bounds of the tuple of locations of n
+   */
+  void is_le_batch(tchecker::tck_reach::zg_alu_covreach::node_t const & n, tchecker::dbm::db_t const * dbm,
+                   tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count, tchecker::clock_id_t dim,
+                   std::uint64_t * le) const;
 
-  mutable tchecker::clockbounds::bounded_cache_local_lu_map_t<const_vloc_sptr_hash_t, const_vloc_sptr_equal_t>
-      _cached_local_lu; /*!< Cached local LU clock bounds*/
+  /*!
+   \brief aLU covering predicate for a batch of nodes w.r.t. a node
+   \param n : a node
+   \param dbm : zone of n
+   \param batch : zones of nodes with same discrete part as n (see tchecker::dbm::is_le_batch)
+   \param stride : distance between two consecutive bounds of a zone in batch
+   \param count : number of zones in batch
+   \param dim : dimension of zones
+   \param ge : bit set of (count+63)/64 words
+   \pre this predicate is not LU-d subsumption (checked by assertion)
+   \post bit k of ge is set iff the k-th zone of batch is included in the aLU-abstraction of dbm, w.r.t. the
+   LU bounds of the tuple of locations of n
+   */
+  void is_ge_batch(tchecker::tck_reach::zg_alu_covreach::node_t const & n, tchecker::dbm::db_t const * dbm,
+                   tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count, tchecker::clock_id_t dim,
+                   std::uint64_t * ge) const;
+
+private:
+  mutable tchecker::clockbounds::shared_cache_local_lu_map_t _cached_local_lu; /*!< Cached local LU clock bounds*/
+  mutable std::optional<tchecker::clockbounds::shared_cache_local_d_map_t>
+      _cached_local_d; /*!< Cached local diagonal constraints (none for aLU subsumption) */
 };
 
 /*!
@@ -132,23 +215,45 @@ public:
 */
 class graph_t : public tchecker::graph::subsumption::graph_t<
                     tchecker::tck_reach::zg_alu_covreach::node_t, tchecker::tck_reach::zg_alu_covreach::edge_t,
-                    tchecker::tck_reach::zg_alu_covreach::node_hash_t, tchecker::tck_reach::zg_alu_covreach::node_le_t> {
+                    tchecker::tck_reach::zg_alu_covreach::node_hash_t, tchecker::tck_reach::zg_alu_covreach::node_le_t,
+                    tchecker::graph::cover::soa_graph_t> {
 public:
+  using base_graph_t =
+      tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_alu_covreach::node_t,
+                                            tchecker::tck_reach::zg_alu_covreach::edge_t,
+                                            tchecker::tck_reach::zg_alu_covreach::node_hash_t,
+                                            tchecker::tck_reach::zg_alu_covreach::node_le_t,
+                                            tchecker::graph::cover::soa_graph_t>;
+
   /*!
    \brief Constructor
    \param zg : zone graph
    \param local_lu : local LU bounds map for aLU covering
+   \param local_d : local diagonal constraints for LU-d covering (nullptr for aLU covering)
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
-   \note this keeps a pointer on zg and on local_lu
+   \param soa_cover_graph : batched covering checks over the nodes with same discrete part
+   (see tchecker::graph::cover::soa_graph_t)
+   \pre soa_cover_graph requires aLU covering (local_d is nullptr)
+   \throw std::invalid_argument : if the precondition is violated
+   \note passed nodes are compacted when covering checks are batched: their full zone is then only stored in
+   their bucket
+   \note this keeps a pointer on zg, on local_lu and on local_d
    \note this graph keeps pointers to (part of) states and (part of) transitions allocated by zg. Hence, the graph
    must be destroyed *before* zg is destroyed, since all states and transitions allocated by zg are detroyed
    when zg is destroyed. See state_space_t below to store both fzg and this graph and destroy them in the expected
    order.
   */
   graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
-          std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t block_size,
-          std::size_t table_size);
+          std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu,
+          std::shared_ptr<tchecker::clockbounds::local_d_map_t> const & local_d, std::size_t block_size,
+          std::size_t table_size, bool soa_cover_graph = false);
+
+  /*!
+   \brief Destructor
+   \post nodes have been destroyed before the pool of their compact states
+   */
+  virtual ~graph_t();
 
   /*!
    \brief Accessor
@@ -162,9 +267,22 @@ public:
   */
   inline tchecker::zg::zg_t const & zg() const { return *_zg; }
 
-  using tchecker::graph::subsumption::graph_t<
-      tchecker::tck_reach::zg_alu_covreach::node_t, tchecker::tck_reach::zg_alu_covreach::edge_t,
-      tchecker::tck_reach::zg_alu_covreach::node_hash_t, tchecker::tck_reach::zg_alu_covreach::node_le_t>::attributes;
+  /*!
+   \brief Hook for passed nodes
+   \param n : a node
+   \post n has been compacted if covering checks are batched
+   */
+  void passed_node(typename base_graph_t::node_sptr_t const & n);
+
+  /*!
+   \brief Restore the states of compact nodes
+   \post no node in this graph is compact
+   \note this should be called before output of the graph or computation of a
+   counter-example
+   */
+  void restore_states();
+
+  using base_graph_t::attributes;
 
   /*!
    \brief Checks if an edge is an actual edge (not a subsumption edge)
@@ -191,7 +309,8 @@ protected:
   virtual void attributes(tchecker::tck_reach::zg_alu_covreach::edge_t const & e, std::map<std::string, std::string> & m) const;
 
 private:
-  std::shared_ptr<tchecker::zg::zg_t> _zg; /*!< Zone graph */
+  std::shared_ptr<tchecker::zg::zg_t> _zg;             /*!< Zone graph */
+  tchecker::graph::compact_state_pool_t _compact_pool; /*!< Compact states of passed nodes */
 };
 
 /*!
@@ -212,14 +331,17 @@ public:
   /*!
    \brief Constructor
    \param zg : zone graph
-    \param local_lu : local LU bounds map for aLU covering
+   \param local_lu : local LU bounds map for aLU covering
+   \param local_d : local diagonal constraints for LU-d covering (nullptr for aLU covering)
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
+   \param soa_cover_graph : batched covering checks (see tchecker::graph::cover::soa_graph_t)
    \note this keeps a pointer on zg
    */
   state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
-                std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu, std::size_t block_size,
-                std::size_t table_size);
+                std::shared_ptr<tchecker::clockbounds::local_lu_map_t> const & local_lu,
+                std::shared_ptr<tchecker::clockbounds::local_d_map_t> const & local_d, std::size_t block_size,
+                std::size_t table_size, bool soa_cover_graph = false);
   /*!
    \brief Accessor
    \return The zone graph
@@ -312,15 +434,27 @@ public:
  \param covering : covering policy
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param diagonals : LU-d subsumption flag (diagonal constraints)
+ \param soa_cover_graph : batched covering checks (see tchecker::graph::cover::soa_graph_t)
  \pre labels must appear as node attributes in sysdecl
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and a representation of the state-space as a subsumption graph
+ \throw std::invalid_argument : if the system has diagonal clock constraints and diagonals is false (aLU
+ subsumption is not sound for diagonal clock constraints)
+ \throw std::invalid_argument : if both diagonals and soa_cover_graph are true (LU-d subsumption is not
+ checked in batches)
+ \note with LU-d subsumption, zones are not extrapolated: the LU-d simulation is finite, and states are covered
+ w.r.t. LU bounds and diagonal constraints of their tuple of locations (Gastin, Mukherjee and Srivathsan,
+ CONCUR 2018)
+ \note compact nodes in the returned state-space shall be restored (see graph_t::restore_states)
+ before output of the graph or computation of a counter-example
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_alu_covreach::state_space_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
     std::string const & search_order = "bfs",
     tchecker::algorithms::covreach::covering_t covering = tchecker::algorithms::covreach::COVERING_FULL,
-    std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::size_t block_size = 10000, std::size_t table_size = 65536, bool diagonals = false,
+    bool soa_cover_graph = false);
 
 } // namespace zg_alu_covreach
 
@@ -0,0 +1,95 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "zg-bitstate-reach.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_bitstate_reach {
+
+/* node_t */
+
+node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+{
+}
+
+node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+{
+}
+
+/* node_hash_t */
+
+std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_bitstate_reach::node_t const & n) const
+{
+  return tchecker::zg::hash_value(n.state());
+}
+
+/* graph_t */
+
+graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t bits,
+                 unsigned int hashes)
+    : tchecker::graph::bitstate::graph_t<tchecker::tck_reach::zg_bitstate_reach::node_t,
+                                         tchecker::tck_reach::zg_bitstate_reach::node_hash_t>(
+          block_size, bits, hashes, tchecker::tck_reach::zg_bitstate_reach::node_hash_t()),
+      _zg(zg)
+{
+}
+
+/* state_space_t */
+
+state_space_t::state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t bits,
+                             unsigned int hashes)
+    : _ss(zg, zg, block_size, bits, hashes)
+{
+}
+
+tchecker::zg::zg_t & state_space_t::zg() { return _ss.ts(); }
+
+tchecker::tck_reach::zg_bitstate_reach::graph_t & state_space_t::graph() { return _ss.state_space(); }
+
+/* run */
+
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_bitstate_reach::state_space_t>>
+run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels, std::string const & search_order,
+    std::size_t block_size, std::size_t table_size, std::size_t bits, unsigned int hashes)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+
+  std::shared_ptr<tchecker::tck_reach::zg_bitstate_reach::state_space_t> state_space =
+      std::make_shared<tchecker::tck_reach::zg_bitstate_reach::state_space_t>(zg, block_size, bits, hashes);
+
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  tchecker::tck_reach::zg_bitstate_reach::algorithm_t algorithm;
+
+  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+
+  tchecker::algorithms::reach::stats_t stats = algorithm.run(state_space->zg(), state_space->graph(), accepting_labels, policy);
+
+  return std::make_tuple(stats, state_space);
+}
+
+} // end of namespace zg_bitstate_reach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
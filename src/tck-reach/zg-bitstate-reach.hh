@@ -0,0 +1,182 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ZG_BITSTATE_REACH_ALGORITHM_HH
+#define TCHECKER_ZG_BITSTATE_REACH_ALGORITHM_HH
+
+/*!
+ \file zg-bitstate-reach.hh
+ \brief Reachability algorithm over the zone graph with bit-state hashing
+*/
+
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "tchecker/algorithms/reach/algorithm.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/graph/bitstate_graph.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ts/state_space.hh"
+#include "tchecker/waiting/waiting.hh"
+#include "tchecker/zg/state.hh"
+#include "tchecker/zg/zg.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_bitstate_reach {
+
+/*!
+ \class node_t
+ \brief Node of the bit-state exploration of a zone graph
+ */
+class node_t : public tchecker::waiting::element_t,
+               public tchecker::graph::node_flags_t,
+               public tchecker::graph::node_zg_state_t {
+public:
+  /*!
+   \brief Constructor
+   \param s : a zone graph state
+   \param initial : initial node flag
+   \param final : final node flag
+   \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+   */
+  node_t(tchecker::zg::state_sptr_t const & s, bool initial = false, bool final = false);
+
+  /*!
+   \brief Constructor
+   \param s : a zone graph state
+   \param initial : initial node flag
+   \param final : final node flag
+   \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+   */
+  node_t(tchecker::zg::const_state_sptr_t const & s, bool initial = false, bool final = false);
+};
+
+/*!
+\class node_hash_t
+\brief Hash functor for nodes
+*/
+class node_hash_t {
+public:
+  /*!
+  \brief Hash function
+  \param n : a node
+  \return hash value of the state in n (see tchecker::zg::hash_value)
+  \note the hash value depends on the content of the state, not on its sharing, as
+  nodes are released after they have been expanded
+  */
+  std::size_t operator()(tchecker::tck_reach::zg_bitstate_reach::node_t const & n) const;
+};
+
+/*!
+ \class graph_t
+ \brief Bit-state graph over the zone graph
+*/
+class graph_t : public tchecker::graph::bitstate::graph_t<tchecker::tck_reach::zg_bitstate_reach::node_t,
+                                                          tchecker::tck_reach::zg_bitstate_reach::node_hash_t> {
+public:
+  /*!
+   \brief Constructor
+   \param zg : zone graph
+   \param block_size : number of nodes allocated in a block
+   \param bits : number of bits in the bit-state table
+   \param hashes : number of bits per state in the bit-state table
+   \throw std::invalid_argument : if hashes is not in 1..32
+   \note this keeps a pointer on zg
+   \note nodes keep pointers to states allocated by zg. Hence, the graph must be destroyed *before* zg is
+   destroyed. See state_space_t below to store both zg and this graph and destroy them in the expected order
+  */
+  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t bits, unsigned int hashes);
+
+  /*!
+   \brief Accessor
+   \return internal zone graph
+  */
+  inline tchecker::zg::zg_t const & zg() const { return *_zg; }
+
+private:
+  std::shared_ptr<tchecker::zg::zg_t> _zg; /*!< Zone graph */
+};
+
+/*!
+ \class state_space_t
+ \brief State-space representation consisting of a zone graph and a bit-state graph
+ */
+class state_space_t {
+public:
+  /*!
+   \brief Constructor
+   \param zg : zone graph
+   \param block_size : number of nodes allocated in a block
+   \param bits : number of bits in the bit-state table
+   \param hashes : number of bits per state in the bit-state table
+   \note this keeps a pointer on zg
+   */
+  state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t bits,
+                unsigned int hashes);
+
+  /*!
+   \brief Accessor
+   \return The zone graph
+   */
+  tchecker::zg::zg_t & zg();
+
+  /*!
+   \brief Accessor
+   \return The bit-state graph representing the state-space
+   */
+  tchecker::tck_reach::zg_bitstate_reach::graph_t & graph();
+
+private:
+  tchecker::ts::state_space_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_bitstate_reach::graph_t>
+      _ss; /*!< State-space representation */
+};
+
+/*!
+ \class algorithm_t
+ \brief Reachability algorithm over the zone graph with bit-state hashing
+*/
+class algorithm_t : public tchecker::algorithms::reach::algorithm_t<tchecker::zg::zg_t,
+                                                                   tchecker::tck_reach::zg_bitstate_reach::graph_t> {
+public:
+  using tchecker::algorithms::reach::algorithm_t<tchecker::zg::zg_t,
+                                                 tchecker::tck_reach::zg_bitstate_reach::graph_t>::algorithm_t;
+};
+
+/*!
+ \brief Run reachability algorithm with bit-state hashing on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param bits : number of bits in the bit-state table
+ \param hashes : number of bits per state in the bit-state table
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ \return statistics on the run and a representation of the state-space as a bit-state graph
+ \throw std::invalid_argument : if hashes is not in 1..32
+ \note the search is under-approximate: states whose hash values collide with visited states in the bit-state
+ table are not visited. A reachable state is actually reachable, but unreachability is not guaranteed. The
+ bit-state table of the returned state-space estimates the probability of omissions (see tchecker::bitstate_t)
+ */
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_bitstate_reach::state_space_t>>
+run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels = "",
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    std::size_t bits = std::size_t(1) << 30, unsigned int hashes = 3);
+
+} // end of namespace zg_bitstate_reach
+
+} // namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_BITSTATE_REACH_ALGORITHM_HH
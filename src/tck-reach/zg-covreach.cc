@@ -9,6 +9,8 @@
 #include <cassert>
 #include <deque>
 #include <iostream>
+#include <memory>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <sstream>
@@ -25,278 +27,39 @@
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/utils/log.hh"
 #include "tchecker/utils/shared_objects.hh"
+#include "tchecker/utils/trace.hh"
 #include "tchecker/zg/semantics.hh"
+#include "tchecker/zg/static_dispatch.hh"
 #include "zg-covreach.hh"
 
 namespace tchecker {
 
 namespace tck_reach {
 
-// 重写覆盖逻辑，引入 `g_simulation_cache_t` 维护各位置的 G(q) DBM、记录转移并反向传播
 namespace zg_covreach {
 
-// 对每个位置做：把“到达该位置后必须保持的约束”逆推回它的前驱，再逆推前驱的前驱……直到全图稳定
-class g_simulation_cache_t {
-public:
-  explicit g_simulation_cache_t(std::shared_ptr<tchecker::zg::zg_t> const & zg)
-      : _zg(zg), _dim(zg->system().clocks_count(tchecker::VK_FLATTENED) + 1)
-  {
-    assert(_zg != nullptr);
-  }
-
-  // 为每个新出现的 location 初始化 G(q)。
-  void ensure_entry(tchecker::const_vloc_sptr_t const & vloc)
-  {
-    if (vloc.ptr() == nullptr)
-      return;
-    if (_entries.find(vloc) != _entries.end())
-      return;
-
-	    entry e;
-	    e.dbm.resize(static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim));
-	    tchecker::dbm::universal_positive(e.dbm.data(), _dim);
-	    e.seeded = false;
-	    // Do not force x<=0. Start with unconstrained (INF).
-	    _entries.emplace(vloc, std::move(e));
-    std::cout << "[G] ensure_entry new location " << vloc_label(vloc) << std::endl;
-  }
-
-	  void seed_state(tchecker::zg::state_t const & state)
-	  {
-	    tchecker::const_vloc_sptr_t vloc =
-	        tchecker::static_pointer_cast<tchecker::shared_vloc_t const>(state.vloc_ptr());
-	    ensure_entry(vloc);
-	    auto it = _entries.find(vloc);
-	    if (it == _entries.end())
-	      return;
-	    if (it->second.seeded)
-	      return;
-
-	    it->second.dbm.assign(state.zone().dbm(),
-	                          state.zone().dbm() + static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim));
-	    it->second.seeded = true;
-	    std::cout << "[G] seed_state(" << vloc_label(vloc) << ")" << std::endl;
-	    enqueue(vloc);
-	    process_pending();
-	  }
-
-	  bool simulation_leq(tchecker::const_vloc_sptr_t const & vloc, tchecker::zg::zone_t const & lhs,
-	                      tchecker::zg::zone_t const & rhs) const
-	  {
-	    auto it = _entries.find(vloc);
-	    if (it == _entries.end() || !it->second.seeded ||
-	        !tchecker::dbm::is_consistent(it->second.dbm.data(), _dim))
-	      return lhs <= rhs;
-
-    tchecker::dbm::db_t const * lhs_dbm = lhs.dbm();
-    tchecker::dbm::db_t const * rhs_dbm = rhs.dbm();
-    auto const & g_dbm = it->second.dbm;
-
-    // Compute intersection of lhs and G(q)
-    std::vector<tchecker::dbm::db_t> intersection(lhs_dbm, lhs_dbm + _dim * _dim);
-    for (std::size_t i = 0; i < _dim * _dim; ++i) {
-       intersection[i] = tchecker::dbm::min(intersection[i], g_dbm[i]);
-    }
-
-    // Check if intersection is empty
-    if (tchecker::dbm::tighten(intersection.data(), _dim) == tchecker::dbm::EMPTY)
-       return true; // Empty intersection is subset of anything
-
-    // Check if intersection <= rhs
-    for (std::size_t i = 0; i < _dim * _dim; ++i) {
-       if (tchecker::dbm::db_cmp(intersection[i], rhs_dbm[i]) > 0)
-          return false;
-    }
-    return true;
-  }
-
-  // 记录一条从 q → q′ 的转移，并把约束从 q′ 反推出 q。
-  void record_transition(tchecker::zg::state_t const & src_state, tchecker::zg::state_t const & tgt_state,
-                         tchecker::zg::transition_t const & transition)
-  {
-    tchecker::const_vloc_sptr_t const src_vloc =
-        tchecker::static_pointer_cast<tchecker::shared_vloc_t const>(src_state.vloc_ptr());
-    tchecker::const_vloc_sptr_t const tgt_vloc =
-        tchecker::static_pointer_cast<tchecker::shared_vloc_t const>(tgt_state.vloc_ptr());
-
-    ensure_entry(src_vloc);
-    ensure_entry(tgt_vloc);
-    std::cout << "[G] record_transition " << vloc_label(src_vloc) << " -> " << vloc_label(tgt_vloc) << std::endl;
-
-    // 创建一个结构体 g_transition_program_t，收集这条边的所有时钟相关信息
-    g_transition_program_t prog;
-    prog.src_vloc = src_vloc;
-    prog.vedge = transition.vedge_ptr();
-    prog.src_invariant = transition.src_invariant_container();
-    prog.guard = transition.guard_container();
-    prog.reset = transition.reset_container();
-    prog.tgt_invariant = transition.tgt_invariant_container();
-    prog.src_delay_allowed = tchecker::ta::delay_allowed(_zg->system(), *src_vloc);
-    prog.tgt_delay_allowed = tchecker::ta::delay_allowed(_zg->system(), *tgt_vloc);
-
-    // 把这条边放入 _incoming[tgt_vloc] 的桶中
-    // _incoming 记录了每个目标位置 q′ 的所有入边
-    auto & bucket = _incoming[tgt_vloc];
-
-    // 查找有没有同src和vedge的边
-    auto it =
-        std::find_if(bucket.begin(), bucket.end(), [&](g_transition_program_t const & existing) {
-          return (existing.src_vloc == prog.src_vloc) && (existing.vedge == prog.vedge);
-        });
-
-    // 如果没找到（到了最后），是崭新的边，则加入bucket，保证每次转移只记录一份在bucket中
-    // 对该新边再次调用 apply_program，把 G(q′) 反推到 G(q)
-    if (it == bucket.end()) {
-      bucket.push_back(std::move(prog));
-      std::cout << "[G]  new incoming program stored (src=" << vloc_label(src_vloc) << ", tgt=" << vloc_label(tgt_vloc) << ")" << std::endl;
-      if (apply_program(bucket.back(), tgt_vloc))
-        enqueue(bucket.back().src_vloc);
-    }
-    else {
-      std::cout << "[G]  existing program re-applied (src=" << vloc_label(src_vloc) << ", tgt=" << vloc_label(tgt_vloc) << ")" << std::endl;
-      // 如果不是新边，则直接调用 apply_program 更新
-      // G(tgt_vloc) 可能在先前的某次传播中变得更强/更宽松了
-      // 需要把最新的 G(tgt_vloc) 再次通过这条入边向前更新 G(src_vloc)，以继续逼近不动点
-      if (apply_program(*it, tgt_vloc)) 
-        enqueue(it->src_vloc);
-    }
-
-    process_pending();
-  }
-
-private:
-	struct entry {
-	  std::vector<tchecker::dbm::db_t> dbm;
-	  bool seeded = false;
-	};
-
-  struct g_transition_program_t {
-    tchecker::const_vloc_sptr_t src_vloc;
-    tchecker::const_vedge_sptr_t vedge;
-    tchecker::clock_constraint_container_t src_invariant;
-    tchecker::clock_constraint_container_t guard;
-    tchecker::clock_reset_container_t reset;
-    tchecker::clock_constraint_container_t tgt_invariant;
-    bool src_delay_allowed = false;
-    bool tgt_delay_allowed = false;
-  };
-
-  bool apply_program(g_transition_program_t const & prog, tchecker::const_vloc_sptr_t const & tgt_vloc)
-  {
-	    auto tgt_it = _entries.find(tgt_vloc);
-	    if (tgt_it == _entries.end() || !tgt_it->second.seeded ||
-	        !tchecker::dbm::is_consistent(tgt_it->second.dbm.data(), _dim))
-	      return false;
-
-    std::cout << "[G] apply_program src=" << vloc_label(prog.src_vloc) << " tgt=" << vloc_label(tgt_vloc) << std::endl;
-    // 拿到目标位置 q′ 的 G(q′)。复制一份为candidate
-    std::vector<tchecker::dbm::db_t> candidate = tgt_it->second.dbm;
-    // 相当于论文的 pre(prog,G(q′))，应用目标 invariant 和 guard 的逆向 + 撤销 reset + 考虑源 invariant + 把 delay 的逆向效果处理掉
-    // 把目标 q′ 的约束反向传给源 q
-    tchecker::state_status_t status =
-        _semantics.prev(candidate.data(), _dim, prog.src_delay_allowed, prog.src_invariant, prog.guard, prog.reset,
-                        prog.tgt_delay_allowed, prog.tgt_invariant);
-    if (status != tchecker::STATE_OK) {
-      std::cout << "[G]  prev returned status " << status << " (no update)" << std::endl;
-      return false;
-    }
-
-    // 调 tighten() 保证闭包
-    if (tchecker::dbm::tighten(candidate.data(), _dim) == tchecker::dbm::EMPTY) {
-      std::cout << "[G]  tightened candidate is empty" << std::endl;
-      return false;
-    }
-
-    auto src_it = _entries.find(prog.src_vloc);
-    if (src_it == _entries.end())
-      return false;
-
-    // 用 widen(target, candidate) 把源位置 q 的 G(q) 更新
-    return widen(src_it->second.dbm, candidate);
-  }
-
-  bool widen(std::vector<tchecker::dbm::db_t> & target, std::vector<tchecker::dbm::db_t> const & src)
-  {
-    bool changed = false;
-     // Use min() to compute intersection of DBMs (Union of constraints)
-    for (std::size_t idx = 0, size = target.size(); idx < size; ++idx) {
-      tchecker::dbm::db_t bound = tchecker::dbm::min(target[idx], src[idx]);
-      if (bound != target[idx]) {
-        target[idx] = bound;
-        changed = true;
-      }
-    }
-    if (changed) {
-      tchecker::dbm::tighten(target.data(), _dim);
-    }
-    return changed;
-  }
+/* zone_storage_t */
 
-  void enqueue(tchecker::const_vloc_sptr_t const & vloc)
-  {
-    if (_in_queue.insert(vloc).second) {
-      _pending.push_back(vloc);
-      std::cout << "[G] enqueue " << vloc_label(vloc) << ", pending size=" << _pending.size() << std::endl;
-    }
-  }
-
-// 在时间自动机的转移图（每个 location 为节点，edge 为 timed transition）上工作；
-// 从某个位置 q′ 出发，查看所有进入它的边 q→q′
-// 调 apply_program 把 G(q′) 的约束反推到 G(q)；
-// 如果 G(q) 更新（变“紧”或“多”了），就把 q 加入待处理队列；
-// 循环，直到所有位置的 G(q) 都稳定（不再更新）
-// 等效于 5.1 节公式 (4)
-  void process_pending()
-  {
-    while (!_pending.empty()) {
-      tchecker::const_vloc_sptr_t current = _pending.front();
-      _pending.pop_front();
-      _in_queue.erase(current);
-      std::cout << "[G] process_pending pop " << vloc_label(current) << ", remaining=" << _pending.size() << std::endl;
-
-      auto incoming_it = _incoming.find(current);
-      if (incoming_it == _incoming.end())
-        continue;
-
-      for (g_transition_program_t const & prog : incoming_it->second) {
-        if (apply_program(prog, current))
-          enqueue(prog.src_vloc);
-      }
-    }
-  }
-
-  std::shared_ptr<tchecker::zg::zg_t> _zg;
-  tchecker::clock_id_t _dim;
-  tchecker::zg::elapsed_semantics_t _semantics;
-  std::unordered_map<tchecker::const_vloc_sptr_t, entry> _entries;
-  std::unordered_map<tchecker::const_vloc_sptr_t, std::vector<g_transition_program_t>> _incoming;
-  std::deque<tchecker::const_vloc_sptr_t> _pending;
-  std::unordered_set<tchecker::const_vloc_sptr_t> _in_queue;
-
-  std::string vloc_label(tchecker::const_vloc_sptr_t const & vloc) const
-  {
-    if (vloc.ptr() == nullptr)
-      return "<null>";
-    try {
-      return tchecker::to_string(*vloc, _zg->system().as_system_system());
-    }
-    catch (...) {
-      std::ostringstream oss;
-      oss << "vloc@" << vloc.ptr();
-      return oss.str();
-    }
-  }
-};
+enum tchecker::tck_reach::zg_covreach::zone_storage_t parse_zone_storage(std::string const & name)
+{
+  if (name == "full")
+    return tchecker::tck_reach::zg_covreach::ZONE_STORAGE_FULL;
+  if (name == "minimal")
+    return tchecker::tck_reach::zg_covreach::ZONE_STORAGE_MINIMAL;
+  throw std::invalid_argument("Unknown zone storage: " + name);
+}
 
 /* node_t */
 
 node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_compact_zg_state_t(s),
+      _hash(tchecker::ta::shared_hash_value(*s))
 {
 }
 
 node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_compact_zg_state_t(s),
+      _hash(tchecker::ta::shared_hash_value(*s))
 {
 }
 
@@ -309,7 +72,7 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_covreach::node_t con
   // 仅使用时序离散部分进行哈希，保证候选覆盖节点拥有相同的位置与整型取值
   // NB: we hash on the discrete (i.e. ta) part of the state in n to check all nodes
   // with same discrete part for covering
-  return tchecker::ta::shared_hash_value(n.state());
+  return n.hash();
 }
 
 /* node_le_t */
@@ -322,13 +85,80 @@ node_le_t::node_le_t(std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulat
 bool node_le_t::operator()(tchecker::tck_reach::zg_covreach::node_t const & n1,
                            tchecker::tck_reach::zg_covreach::node_t const & n2) const
 {
-  if (!tchecker::ta::shared_equal_to(n1.state(), n2.state()))
+  if (n1.vloc_ptr() != n2.vloc_ptr() || n1.intval_ptr() != n2.intval_ptr())
     return false;
 
+  tchecker::zg::zone_t const & z1 = zone(n1);
+
+  if (n2.is_compact()) {
+    if (_g_cache == nullptr)
+      return (z1 <= n2.minimal_zone());
+    return _g_cache->simulation_leq(n1.vloc_ptr(), z1, n2.minimal_zone());
+  }
+
   if (_g_cache == nullptr)
-    return (n1.state().zone() <= n2.state().zone());
+    return (z1 <= n2.state().zone());
+
+  return _g_cache->simulation_leq(n1.vloc_ptr(), z1, n2.state().zone());
+}
 
-  return _g_cache->simulation_leq(n1.state_ptr()->vloc_ptr(), n1.state().zone(), n2.state().zone());
+bool node_le_t::comparable(tchecker::tck_reach::zg_covreach::node_t const & n1,
+                           tchecker::tck_reach::zg_covreach::node_t const & n2) const
+{
+  return (n1.vloc_ptr() == n2.vloc_ptr() && n1.intval_ptr() == n2.intval_ptr());
+}
+
+tchecker::clock_id_t node_le_t::dim(tchecker::tck_reach::zg_covreach::node_t const & n) const
+{
+  return static_cast<tchecker::clock_id_t>(zone(n).dim());
+}
+
+bool node_le_t::normalize(tchecker::tck_reach::zg_covreach::node_t const & n, tchecker::dbm::db_t * dbm) const
+{
+  tchecker::zg::zone_t const & z = zone(n);
+  if (_g_cache == nullptr) {
+    std::size_t const size = static_cast<std::size_t>(z.dim()) * static_cast<std::size_t>(z.dim());
+    std::copy(z.dbm(), z.dbm() + size, dbm);
+    return !z.is_empty();
+  }
+  return _g_cache->normalize(n.vloc_ptr(), z, dbm);
+}
+
+std::uint64_t node_le_t::signature(tchecker::tck_reach::zg_covreach::node_t const & n) const
+{
+  tchecker::clock_id_t const d = dim(n);
+  _normalized.resize(static_cast<std::size_t>(d) * static_cast<std::size_t>(d));
+  if (!normalize(n, _normalized.data()))
+    return 0;
+  return tchecker::dbm::signature(_normalized.data(), d);
+}
+
+void node_le_t::is_le_batch(tchecker::tck_reach::zg_covreach::node_t const & /*n*/, tchecker::dbm::db_t const * dbm,
+                            tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count,
+                            tchecker::clock_id_t dim, std::uint64_t * le) const
+{
+  tchecker::dbm::is_le_batch(dbm, batch, stride, count, dim, le);
+}
+
+void node_le_t::is_ge_batch(tchecker::tck_reach::zg_covreach::node_t const & /*n*/, tchecker::dbm::db_t const * dbm,
+                            tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count,
+                            tchecker::clock_id_t dim, std::uint64_t * ge) const
+{
+  tchecker::dbm::is_ge_batch(dbm, batch, stride, count, dim, ge);
+}
+
+tchecker::zg::zone_t const & node_le_t::zone(tchecker::tck_reach::zg_covreach::node_t const & n) const
+{
+  if (!n.is_compact())
+    return n.state().zone();
+
+  tchecker::zg::minimal_zone_t const & minimal = n.minimal_zone();
+  if (_scratch == nullptr || _scratch->dim() != minimal.dim()) {
+    tchecker::clock_id_t dim = static_cast<tchecker::clock_id_t>(minimal.dim());
+    _scratch.reset(tchecker::zg::zone_allocate_and_construct(dim, dim), tchecker::zg::zone_destruct_and_deallocate);
+  }
+  minimal.to_zone(*_scratch);
+  return *_scratch;
 }
 
 /* edge_t */
@@ -339,48 +169,83 @@ edge_t::edge_t(tchecker::zg::transition_t const & t) : tchecker::graph::edge_ved
 
 graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
                  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> const & g_cache,
-                 std::size_t block_size, std::size_t table_size)
+                 std::size_t block_size, std::size_t table_size,
+                 enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage, std::size_t memory_limit,
+                 std::string const & spill_dir, bool soa_cover_graph)
     : base_graph_t(block_size, table_size, tchecker::tck_reach::zg_covreach::node_hash_t(),
                    tchecker::tck_reach::zg_covreach::node_le_t(g_cache)),
-      _g_cache(g_cache), _zg(zg)
+      _g_cache(g_cache), _zg(zg), _zone_storage(zone_storage)
+{
+  if (soa_cover_graph && memory_limit > 0)
+    throw std::invalid_argument("Batched covering checks require no memory limit");
+  cover_graph().set_batched(soa_cover_graph);
+  if (memory_limit > 0)
+    _spill_store = std::make_unique<tchecker::graph::spill_store_t<base_graph_t::node_sptr_t>>(_compact_pool, memory_limit,
+                                                                                               1024, spill_dir);
+}
+
+graph_t::~graph_t()
 {
+  _spill_store.reset();
+  clear();
 }
 
 graph_t::base_graph_t::node_sptr_t graph_t::add_node(tchecker::zg::state_sptr_t const & s)
 {
   auto node = base_graph_t::add_node(s);
+  if (_spill_store != nullptr)
+    _spill_store->touch(node->hash()); // node is about to be compared to the nodes in its partition
   return node;
 }
 
 graph_t::base_graph_t::node_sptr_t graph_t::add_node(tchecker::zg::const_state_sptr_t const & s)
 {
   auto node = base_graph_t::add_node(s);
+  if (_spill_store != nullptr)
+    _spill_store->touch(node->hash());
   return node;
 }
 
-graph_t::edge_sptr_t graph_t::add_edge(graph_t::base_graph_t::node_sptr_t const & src,
-                                       graph_t::base_graph_t::node_sptr_t const & tgt,
-                                       enum tchecker::graph::subsumption::edge_type_t edge_type, tchecker::zg::transition_t const & t)
+void graph_t::remove_node(graph_t::base_graph_t::node_sptr_t const & n)
 {
-  auto edge = base_graph_t::add_edge(src, tgt, edge_type, t);
-  if (_g_cache != nullptr)
-    _g_cache->record_transition(src->state(), tgt->state(), t);
-  return edge;
+  if (_spill_store != nullptr)
+    _spill_store->remove(n);
+  base_graph_t::remove_node(n);
 }
 
-void graph_t::record_transition(tchecker::zg::state_t const & src_state, tchecker::zg::state_t const & tgt_state,
-                                tchecker::zg::transition_t const & t)
+void graph_t::passed_node(graph_t::base_graph_t::node_sptr_t const & n)
 {
-  if (_g_cache != nullptr)
-    _g_cache->record_transition(src_state, tgt_state, t);
+  if (n->is_compact())
+    return;
+  // with batched covering checks, the zone of n is only read from its bucket
+  if (_zone_storage == tchecker::tck_reach::zg_covreach::ZONE_STORAGE_MINIMAL || _spill_store != nullptr ||
+      cover_graph().batched())
+    n->compact(_compact_pool);
+  if (_spill_store == nullptr)
+    return;
+  _spill_store->add(n);
+  if (_spill_store->over_limit())
+    _spill_store->spill();
 }
 
-void graph_t::seed_state(tchecker::zg::state_t const & state)
+void graph_t::restore_states()
 {
-  if (_g_cache != nullptr)
-    _g_cache->seed_state(state);
+  for (node_sptr_t const & n : nodes())
+    n->restore(*_zg, _compact_pool);
 }
 
+std::size_t graph_t::storage_bytes() const
+{
+  std::size_t bytes = 0;
+  for (node_sptr_t const & n : nodes())
+    bytes += n->storage_bytes();
+  return bytes;
+}
+
+std::size_t graph_t::spilled_bytes() const { return (_spill_store == nullptr ? 0 : _spill_store->spilled_bytes()); }
+
+unsigned long graph_t::saved_tightens() const { return (_g_cache == nullptr ? 0 : _g_cache->saved_tightens()); }
+
 bool graph_t::is_actual_edge(edge_sptr_t const & e) const { return edge_type(e) == tchecker::graph::subsumption::EDGE_ACTUAL; }
 
 void graph_t::attributes(tchecker::tck_reach::zg_covreach::node_t const & n, std::map<std::string, std::string> & m) const
@@ -448,9 +313,13 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::g
 
 /* state_space_t */
 
-state_space_t::state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size)
-    : _g_cache(std::make_shared<tchecker::tck_reach::zg_covreach::g_simulation_cache_t>(zg)),
-      _ss(zg, zg, _g_cache, block_size, table_size)
+state_space_t::state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
+                             std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> const & g_simulation,
+                             std::size_t block_size, std::size_t table_size,
+                             enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage, std::size_t memory_limit,
+                             std::string const & spill_dir, bool soa_cover_graph)
+    : _g_cache(std::make_shared<tchecker::tck_reach::zg_covreach::g_simulation_cache_t>(g_simulation)),
+      _ss(zg, zg, _g_cache, block_size, table_size, zone_storage, memory_limit, spill_dir, soa_cover_graph)
 {
 }
 
@@ -491,48 +360,56 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::c
 
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t>>
 run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels, std::string const & search_order,
-    tchecker::algorithms::covreach::covering_t covering, std::size_t block_size, std::size_t table_size)
+    tchecker::algorithms::covreach::covering_t covering, std::size_t block_size, std::size_t table_size,
+    enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage, std::size_t memory_limit,
+    std::string const & spill_dir, bool soa_cover_graph)
 {
-  std::cout << "[zg_covreach] run entry" << std::endl;
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
-  std::cout << "[zg_covreach] system constructed" << std::endl;
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
   enum tchecker::zg::extrapolation_type_t extrapolation =
-      (tchecker::ta::has_diagonal_constraint(*system) ? tchecker::zg::NO_EXTRAPOLATION : tchecker::zg::EXTRA_LU_PLUS_LOCAL);
-  std::cout << "[zg_covreach] extrapolation mode "
-            << (extrapolation == tchecker::zg::NO_EXTRAPOLATION ? "NO_EXTRAPOLATION" : "EXTRA_LU_PLUS_LOCAL") << std::endl;
-
-  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
-                                                               extrapolation, block_size, table_size)};
-  std::cout << "[zg_covreach] zone graph factory created" << std::endl;
-
-  std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t> state_space =
-      std::make_shared<tchecker::tck_reach::zg_covreach::state_space_t>(zg, block_size, table_size);
-  std::cout << "[zg_covreach] state space ready" << std::endl;
+      (tchecker::ta::has_diagonal_constraint(*system) ? tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF
+                                                      : tchecker::zg::EXTRA_LU_PLUS_LOCAL);
+  TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_COVREACH,
+                 "extrapolation "
+                     << (extrapolation == tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF ? "local LU+ on diagonal-free clocks"
+                                                                               : "local LU+"));
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
-  std::cout << "[zg_covreach] labels computed" << std::endl;
 
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
-  std::cout << "[zg_covreach] waiting policy ready" << std::endl;
-
-  tchecker::algorithms::covreach::stats_t stats;
-  tchecker::tck_reach::zg_covreach::algorithm_t algorithm;
-  std::cout << "[zg_covreach] starting algorithm.run" << std::endl;
-
-  if (covering == tchecker::algorithms::covreach::COVERING_FULL)
-    stats = algorithm.run<tchecker::algorithms::covreach::COVERING_FULL>(state_space->zg(), state_space->graph(),
-                                                                        accepting_labels, policy);
-  else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
-    stats = algorithm.run<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(state_space->zg(), state_space->graph(),
-                                                                               accepting_labels, policy);
-  else
-    throw std::invalid_argument("Unknown covering policy for covreach algorithm");
-
-  std::cout << "[zg_covreach] algorithm.run finished" << std::endl;
-  return std::make_tuple(stats, state_space);
+
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> g_simulation =
+      std::make_shared<tchecker::tck_reach::zg_covreach::g_simulation_t>(system, block_size, table_size);
+
+  // the algorithm is instantiated on the actual type of the zone graph to avoid virtual calls on each transition
+  return tchecker::zg::static_dispatch::visit(
+      system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS, extrapolation, block_size, table_size,
+      [&](auto const & zg) {
+        std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t> state_space =
+            std::make_shared<tchecker::tck_reach::zg_covreach::state_space_t>(
+                zg, g_simulation, block_size, table_size, zone_storage, memory_limit, spill_dir, soa_cover_graph);
+
+        tchecker::algorithms::covreach::stats_t stats;
+        tchecker::tck_reach::zg_covreach::algorithm_t<typename std::decay_t<decltype(zg)>::element_type> algorithm;
+
+        if (covering == tchecker::algorithms::covreach::COVERING_FULL)
+          stats = algorithm.template run<tchecker::algorithms::covreach::COVERING_FULL>(*zg, state_space->graph(),
+                                                                                       accepting_labels, policy);
+        else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
+          stats = algorithm.template run<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(*zg, state_space->graph(),
+                                                                                             accepting_labels, policy);
+        else
+          throw std::invalid_argument("Unknown covering policy for covreach algorithm");
+        stats.saved_tightens() = state_space->graph().saved_tightens();
+        stats.storage_bytes() = state_space->graph().storage_bytes();
+        stats.spilled_bytes() = state_space->graph().spilled_bytes();
+        stats.signature_checks() = state_space->graph().signature_checks();
+        stats.signature_rejections() = state_space->graph().signature_rejections();
+        stats.signature_misses() = state_space->graph().signature_misses();
+        return std::make_tuple(stats, state_space);
+      });
 }
 
 } // namespace zg_covreach
@@ -13,20 +13,25 @@
  \brief Covering reachability algorithm over the zone graph with zone inclusion
 */
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
+#include "tchecker/graph/spill_store.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/ts/state_space.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
+#include "tchecker/zg/minimal_zone.hh"
 #include "tchecker/zg/path.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
 #include "tchecker/zg/zg.hh"
+#include "zg-g-simulation.hh"
 
 namespace tchecker {
 
@@ -34,15 +39,30 @@ namespace tck_reach {
 
 namespace zg_covreach {
 
-class g_simulation_cache_t;
+/*!
+ \brief Storage of zones in passed nodes
+ */
+enum zone_storage_t {
+  ZONE_STORAGE_FULL,    /*!< Full DBM */
+  ZONE_STORAGE_MINIMAL, /*!< Minimal constraint graph (see tchecker::zg::minimal_zone_t) */
+};
+
+/*!
+ \brief Parse zone storage
+ \param name : name of zone storage (full or minimal)
+ \return zone storage with name
+ \throw std::invalid_argument : if name is not a zone storage
+ */
+enum tchecker::tck_reach::zg_covreach::zone_storage_t parse_zone_storage(std::string const & name);
 
 /*!
  \class node_t
  \brief Node of the covering reachability graph of a zone graph
+ \note passed nodes may be compacted (see tchecker::graph::node_compact_zg_state_t)
  */
 class node_t : public tchecker::waiting::element_t,
                public tchecker::graph::node_flags_t,
-               public tchecker::graph::node_zg_state_t {
+               public tchecker::graph::node_compact_zg_state_t {
 public:
   /*!
    \brief Constructor
@@ -61,6 +81,15 @@ public:
    \post this node keeps a shared pointer to s, and has initial/final node flags as specified
    */
   node_t(tchecker::zg::const_state_sptr_t const & s, bool initial = false, bool final = false);
+
+  /*!
+   \brief Accessor
+   \return hash value of the discrete part of this node (see tchecker::ta::shared_hash_value)
+   */
+  inline std::size_t hash() const { return _hash; }
+
+private:
+  std::size_t _hash; /*!< Hash value of the discrete part */
 };
 
 /*!
@@ -93,12 +122,90 @@ public:
   \param n2 : a node
   \return true if n1 and n2 have same discrete part and the zone of n1 is
   included in the zone of n2, false otherwise
+  \note the zone of n2 is not decompressed if n2 is compact
   */
   bool operator()(tchecker::tck_reach::zg_covreach::node_t const & n1,
                   tchecker::tck_reach::zg_covreach::node_t const & n2) const;
 
+  /*!
+   \brief Comparability of nodes
+   \param n1 : a node
+   \param n2 : a node
+   \return true if n1 and n2 have same discrete part, false otherwise
+   */
+  bool comparable(tchecker::tck_reach::zg_covreach::node_t const & n1,
+                  tchecker::tck_reach::zg_covreach::node_t const & n2) const;
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return dimension of the zone of n
+   */
+  tchecker::clock_id_t dim(tchecker::tck_reach::zg_covreach::node_t const & n) const;
+
+  /*!
+   \brief Normalized zone of a node
+   \param n : a node
+   \param dbm : a DBM of dimension dim(n)
+   \post dbm is the tight intersection of the zone of n and G(q) if G(q) constrains the location q of n, and
+   a copy of the zone of n otherwise
+   \return false if dbm is empty, true otherwise
+   \note n is covered by a node n' with same discrete part iff the normalized zone of n is empty, or it is
+   included in the normalized zone of n', since the intersection of the zone of n and G(q) is included in the
+   zone of n' iff it is included in the intersection of the zone of n' and G(q)
+   */
+  bool normalize(tchecker::tck_reach::zg_covreach::node_t const & n, tchecker::dbm::db_t * dbm) const;
+
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return signature of the normalized zone of n (see normalize and tchecker::dbm::signature), 0 if empty
+   \note n1 is covered by n2 only if the signature of n1 is less-than-or-equal-to the signature of n2
+   w.r.t. tchecker::dbm::signature_le, since normalized zones are included in each other
+   */
+  std::uint64_t signature(tchecker::tck_reach::zg_covreach::node_t const & n) const;
+
+  /*!
+   \brief Covering predicate for a node w.r.t. a batch of nodes
+   \param n : a node
+   \param dbm : normalized zone of n
+   \param batch : normalized zones of nodes with same discrete part as n (see tchecker::dbm::is_le_batch)
+   \param stride : distance between two consecutive bounds of a zone in batch
+   \param count : number of zones in batch
+   \param dim : dimension of zones
+   \param le : bit set of (count+63)/64 words
+   \post bit k of le is set iff dbm is included in the k-th zone of batch
+   */
+  void is_le_batch(tchecker::tck_reach::zg_covreach::node_t const & n, tchecker::dbm::db_t const * dbm,
+                   tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count, tchecker::clock_id_t dim,
+                   std::uint64_t * le) const;
+
+  /*!
+   \brief Covering predicate for a batch of nodes w.r.t. a node
+   \param n : a node
+   \param dbm : normalized zone of n
+   \param batch : normalized zones of nodes with same discrete part as n (see tchecker::dbm::is_le_batch)
+   \param stride : distance between two consecutive bounds of a zone in batch
+   \param count : number of zones in batch
+   \param dim : dimension of zones
+   \param ge : bit set of (count+63)/64 words
+   \post bit k of ge is set iff the k-th zone of batch is included in dbm
+   */
+  void is_ge_batch(tchecker::tck_reach::zg_covreach::node_t const & n, tchecker::dbm::db_t const * dbm,
+                   tchecker::dbm::db_t const * batch, std::size_t stride, std::size_t count, tchecker::clock_id_t dim,
+                   std::uint64_t * ge) const;
+
 private:
+  /*!
+   \brief Accessor
+   \param n : a node
+   \return zone of n, decompressed in a scratch zone if n is compact
+   */
+  tchecker::zg::zone_t const & zone(tchecker::tck_reach::zg_covreach::node_t const & n) const;
+
   std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> _g_cache;
+  mutable std::shared_ptr<tchecker::zg::zone_t> _scratch; /*!< Decompressed zone of compact nodes */
+  mutable std::vector<tchecker::dbm::db_t> _normalized;   /*!< Normalized zone for signatures */
 };
 
 /*!
@@ -121,12 +228,14 @@ public:
 */
 class graph_t : public tchecker::graph::subsumption::graph_t<
                     tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
-                    tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t> {
+                    tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t,
+                    tchecker::graph::cover::soa_graph_t> {
 public:
   using base_graph_t =
       tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
                                             tchecker::tck_reach::zg_covreach::node_hash_t,
-                                            tchecker::tck_reach::zg_covreach::node_le_t>;
+                                            tchecker::tck_reach::zg_covreach::node_le_t,
+                                            tchecker::graph::cover::soa_graph_t>;
 
   /*!
    \brief Constructor
@@ -134,6 +243,17 @@ public:
    \param g_cache : shared G-simulation cache
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
+   \param zone_storage : storage of zones in passed nodes
+   \param memory_limit : maximal number of bytes of zones of passed nodes in main memory (0 for no limit)
+   \param spill_dir : directory of the spill file (see tchecker::spill_file_t)
+   \param soa_cover_graph : batched covering checks over the nodes with same discrete part
+   (see tchecker::graph::cover::soa_graph_t)
+   \pre soa_cover_graph requires no memory limit
+   \throw std::invalid_argument : if the precondition is violated
+   \note passed nodes are compacted when there is a memory limit, and the least recently accessed hash partitions
+   of passed nodes are spilled to disk when the limit is reached (see tchecker::graph::spill_store_t)
+   \note passed nodes are also compacted when covering checks are batched: their full zone is then only
+   stored, normalized, in their bucket
    \note this keeps a pointer on zg
    \note this graph keeps pointers to (part of) states and (part of) transitions allocated by zg. Hence, the graph
    must be destroyed *before* zg is destroyed, since all states and transitions allocated by zg are detroyed
@@ -142,7 +262,16 @@ public:
   */
   graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
           std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> const & g_cache, std::size_t block_size,
-          std::size_t table_size);
+          std::size_t table_size,
+          enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage =
+              tchecker::tck_reach::zg_covreach::ZONE_STORAGE_FULL,
+          std::size_t memory_limit = 0, std::string const & spill_dir = "", bool soa_cover_graph = false);
+
+  /*!
+   \brief Destructor
+   \post nodes have been destroyed before the pool of their compact states
+   */
+  virtual ~graph_t();
 
   /*!
    \brief Accessor
@@ -162,22 +291,54 @@ public:
    */
   inline std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> const & g_cache() const { return _g_cache; }
 
-  using base_graph_t::add_edge;
-
   typename base_graph_t::node_sptr_t add_node(tchecker::zg::state_sptr_t const & s);
   typename base_graph_t::node_sptr_t add_node(tchecker::zg::const_state_sptr_t const & s);
-  void record_transition(tchecker::zg::state_t const & src_state, tchecker::zg::state_t const & tgt_state,
-                         tchecker::zg::transition_t const & t);
-  void seed_state(tchecker::zg::state_t const & state);
 
-  typename base_graph_t::edge_sptr_t add_edge(typename base_graph_t::node_sptr_t const & src,
-                                              typename base_graph_t::node_sptr_t const & tgt,
-                                              enum tchecker::graph::subsumption::edge_type_t edge_type,
-                                              tchecker::zg::transition_t const & t);
+  /*!
+   \brief Remove node
+   \param n : a node
+   \pre n is stored in this graph, and n is disconnected
+   \post n has been removed from this graph
+   */
+  void remove_node(typename base_graph_t::node_sptr_t const & n);
 
-  using tchecker::graph::subsumption::graph_t<
-      tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
-      tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t>::attributes;
+  /*!
+   \brief Hook for passed nodes
+   \param n : a node
+   \post n has been compacted if zones are stored as minimal constraint graphs, if
+   there is a memory limit, or if covering checks are batched. Hash partitions of passed nodes have been spilled to disk
+   if the memory limit has been reached
+   */
+  void passed_node(typename base_graph_t::node_sptr_t const & n);
+
+  /*!
+   \brief Restore the states of compact nodes
+   \post no node in this graph is compact
+   \note this should be called before output of the graph or computation of a
+   counter-example
+   */
+  void restore_states();
+
+  /*!
+   \brief Accessor
+   \return number of bytes used to store the states in the nodes of this graph
+   (see tchecker::tck_reach::zg_covreach::node_t::storage_bytes)
+   */
+  std::size_t storage_bytes() const;
+
+  /*!
+   \brief Accessor
+   \return number of bytes of zones that have been spilled to disk
+   */
+  std::size_t spilled_bytes() const;
+
+  /*!
+   \brief Accessor
+   \return number of full DBM tightenings that have been avoided by the G-simulation cache
+   */
+  unsigned long saved_tightens() const;
+
+  using base_graph_t::attributes;
 
   /*!
    \brief Checks if an edge is an actual edge (not a subsumption edge)
@@ -206,6 +367,10 @@ protected:
 private:
   std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> _g_cache; /*!< G-simulation cache */
   std::shared_ptr<tchecker::zg::zg_t> _zg; /*!< Zone graph */
+  enum tchecker::tck_reach::zg_covreach::zone_storage_t _zone_storage; /*!< Storage of zones in passed nodes */
+  tchecker::graph::compact_state_pool_t _compact_pool; /*!< Compact states of passed nodes */
+  std::unique_ptr<tchecker::graph::spill_store_t<typename base_graph_t::node_sptr_t>>
+      _spill_store; /*!< Spill store (nullptr if no memory limit) */
 };
 
 /*!
@@ -226,11 +391,21 @@ public:
   /*!
    \brief Constructor
    \param zg : zone graph
+   \param g_simulation : G(q) DBMs of the system of zg
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
-   \note this keeps a pointer on zg
+   \param zone_storage : storage of zones in passed nodes
+   \param memory_limit : maximal number of bytes of zones of passed nodes in main memory (0 for no limit)
+   \param spill_dir : directory of the spill file (see tchecker::spill_file_t)
+   \param soa_cover_graph : batched covering checks (see tchecker::graph::cover::soa_graph_t)
+   \note this keeps a pointer on zg and on g_simulation
    */
-  state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size);
+  state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg,
+                std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> const & g_simulation,
+                std::size_t block_size, std::size_t table_size,
+                enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage =
+                    tchecker::tck_reach::zg_covreach::ZONE_STORAGE_FULL,
+                std::size_t memory_limit = 0, std::string const & spill_dir = "", bool soa_cover_graph = false);
 
   /*!
    \brief Accessor
@@ -245,7 +420,7 @@ public:
   tchecker::tck_reach::zg_covreach::graph_t & graph();
 
 private:
-  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> _g_cache; /*!< Shared G-simulation cache */
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> _g_cache; /*!< G-simulation cache */
   tchecker::ts::state_space_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t>
       _ss; /*!< State-space representation */
 };
@@ -309,11 +484,12 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::c
 /*!
  \class algorithm_t
  \brief Covering reachability algorithm over the zone graph
+ \tparam ZG : type of zone graph, tchecker::zg::zg_t or an instance of tchecker::zg::static_dispatch::zg_t
 */
-class algorithm_t
-    : public tchecker::algorithms::covreach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t> {
+template <class ZG = tchecker::zg::zg_t>
+class algorithm_t : public tchecker::algorithms::covreach::algorithm_t<ZG, tchecker::tck_reach::zg_covreach::graph_t> {
 public:
-  using tchecker::algorithms::covreach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_covreach::graph_t>::algorithm_t;
+  using tchecker::algorithms::covreach::algorithm_t<ZG, tchecker::tck_reach::zg_covreach::graph_t>::algorithm_t;
 };
 
 /*!
@@ -324,16 +500,26 @@ public:
  \param covering : covering policy
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param zone_storage : storage of zones in passed nodes
+ \param memory_limit : maximal number of bytes of zones of passed nodes in main memory (0 for no limit)
+ \param spill_dir : directory of the spill file (see tchecker::spill_file_t)
+ \param soa_cover_graph : batched covering checks (see tchecker::graph::cover::soa_graph_t)
  \pre labels must appear as node attributes in sysdecl
  search_order must be either "dfs" or "bfs"
+ soa_cover_graph requires no memory limit
  \return statistics on the run and a representation of the state-space as a subsumption graph
  \throw std::runtime_error : if clock bounds cannot be computed for the system modeled by sysdecl
+ \note compact nodes in the returned state-space shall be restored (see graph_t::restore_states)
+ before output of the graph or computation of a counter-example
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t>>
 run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels = "",
     std::string const & search_order = "bfs",
     tchecker::algorithms::covreach::covering_t covering = tchecker::algorithms::covreach::COVERING_FULL,
-    std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::tck_reach::zg_covreach::zone_storage_t zone_storage =
+        tchecker::tck_reach::zg_covreach::ZONE_STORAGE_FULL,
+    std::size_t memory_limit = 0, std::string const & spill_dir = "", bool soa_cover_graph = false);
 
 } // end of namespace zg_covreach
 
@@ -0,0 +1,496 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/ta/static_analysis.hh"
+#include "tchecker/ta/ta.hh"
+#include "tchecker/utils/trace.hh"
+#include "zg-g-simulation.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_covreach {
+
+/* g_simulation_t */
+
+struct g_simulation_t::edge_programs_t {
+  std::vector<tchecker::clock_constraint_container_t> invariants; /*!< Clock constraints of invariants, by location */
+  std::vector<tchecker::clock_constraint_container_t> guards;     /*!< Clock constraints of guards, by edge */
+  std::vector<tchecker::clock_reset_container_t> resets;          /*!< Clock resets, by edge */
+  boost::dynamic_bitset<> static_resets; /*!< Edges with clock resets that do not depend on integer variables */
+};
+
+g_simulation_t::g_simulation_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::size_t block_size,
+                               std::size_t table_size, std::size_t threads)
+    : _system(system), _dim(static_cast<tchecker::clock_id_t>(system->clocks_count(tchecker::VK_FLATTENED) + 1))
+{
+  assert(_system != nullptr);
+  assert(threads > 0);
+  explore(block_size, table_size);
+  compute_sccs();
+  compute_fixpoint(threads);
+  TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_PHASE, tchecker::trace::CATEGORY_GSIM,
+                 _locations.size() << " location(s), " << _programs.size() << " program(s) (" << _ignored_programs
+                                   << " ignored), " << _sccs_count << " component(s) on " << _levels_count
+                                   << " level(s)");
+}
+
+g_simulation_t::location_t const * g_simulation_t::find(tchecker::const_vloc_sptr_t const & vloc) const
+{
+  auto it = _index.find(vloc);
+  return (it == _index.end() ? nullptr : &_locations[it->second]);
+}
+
+void g_simulation_t::explore(std::size_t block_size, std::size_t table_size)
+{
+  tchecker::ta::system_t const & system = *_system;
+  std::size_t const clock_nb = system.clocks_count(tchecker::VK_FLATTENED);
+
+  // 每条边/每个位置只分析一次：与整型变量无关的时钟约束和重置
+  edge_programs_t edges;
+  edges.invariants.resize(system.locations_count());
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    tchecker::ta::intval_independent_clock_constraints(system.invariant(loc->id()), edges.invariants[loc->id()]);
+  edges.guards.resize(system.edges_count());
+  edges.resets.resize(system.edges_count());
+  edges.static_resets.resize(system.edges_count());
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    tchecker::ta::intval_independent_clock_constraints(system.guard(edge->id()), edges.guards[edge->id()]);
+    edges.static_resets[edge->id()] =
+        tchecker::ta::intval_independent_clock_resets(clock_nb, system.statement(edge->id()), edges.resets[edge->id()]);
+  }
+
+  std::shared_ptr<tchecker::syncprod::system_t const> syncprod_system{_system, &_system->as_syncprod_system()};
+  _syncprod =
+      std::make_unique<tchecker::syncprod::syncprod_t>(syncprod_system, tchecker::ts::SHARING, block_size, table_size);
+
+  std::deque<tchecker::syncprod::const_state_sptr_t> waiting;
+  std::vector<tchecker::syncprod::syncprod_t::sst_t> sst;
+
+  _syncprod->initial(sst);
+  for (auto && [status, s, t] : sst) {
+    std::size_t const count = _locations.size();
+    location(tchecker::const_vloc_sptr_t{s->vloc_ptr()}, edges);
+    if (_locations.size() > count)
+      waiting.push_back(tchecker::syncprod::const_state_sptr_t{s});
+  }
+  sst.clear();
+
+  while (!waiting.empty()) {
+    tchecker::syncprod::const_state_sptr_t s = waiting.front();
+    waiting.pop_front();
+    std::size_t const src = location(tchecker::const_vloc_sptr_t{s->vloc_ptr()}, edges);
+
+    _syncprod->next(s, sst);
+    for (auto && [status, next_s, t] : sst) {
+      std::size_t const count = _locations.size();
+      std::size_t const tgt = location(tchecker::const_vloc_sptr_t{next_s->vloc_ptr()}, edges);
+      if (_locations.size() > count)
+        waiting.push_back(tchecker::syncprod::const_state_sptr_t{next_s});
+      add_program(src, tgt, t->vedge(), edges);
+    }
+    sst.clear();
+  }
+}
+
+std::size_t g_simulation_t::location(tchecker::const_vloc_sptr_t const & vloc, edge_programs_t const & edges)
+{
+  auto [it, inserted] = _index.emplace(vloc, _locations.size());
+  if (inserted) {
+    _locations.emplace_back();
+    location_t & q = _locations.back();
+    q.dbm.resize(static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim));
+    tchecker::dbm::universal_positive(q.dbm.data(), _dim);
+    for (tchecker::loc_id_t id : *vloc)
+      q.invariant.insert(q.invariant.end(), edges.invariants[id].begin(), edges.invariants[id].end());
+    q.delay_allowed = tchecker::ta::delay_allowed(*_system, *vloc);
+    TCHECKER_TRACE(TCHECKER_TRACE_LEVEL_STEP, tchecker::trace::CATEGORY_GSIM, "new location " << vloc_label(*vloc));
+  }
+  return it->second;
+}
+
+void g_simulation_t::add_program(std::size_t src, std::size_t tgt, tchecker::vedge_t const & vedge,
+                                 edge_programs_t const & edges)
+{
+  // 整型变量决定的重置无法静态表示：忽略该转移，G(q) 只会更大（更保守）
+  g_transition_program_t prog;
+  for (tchecker::edge_id_t id : vedge) {
+    if (!edges.static_resets[id]) {
+      ++_ignored_programs;
+      return;
+    }
+    prog.guard.insert(prog.guard.end(), edges.guards[id].begin(), edges.guards[id].end());
+    prog.reset.insert(prog.reset.end(), edges.resets[id].begin(), edges.resets[id].end());
+  }
+
+  for (std::size_t p : _locations[src].outgoing) {
+    g_transition_program_t const & other = _programs[p];
+    if (other.tgt == tgt && other.guard == prog.guard && other.reset == prog.reset)
+      return;
+  }
+
+  prog.src = src;
+  prog.tgt = tgt;
+  _locations[src].outgoing.push_back(_programs.size());
+  _locations[tgt].incoming.push_back(_programs.size());
+  _programs.push_back(std::move(prog));
+}
+
+void g_simulation_t::compute_sccs()
+{
+  std::size_t const n = _locations.size();
+  std::size_t const none = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> index(n, none), lowlink(n, 0);
+  std::vector<char> on_stack(n, 0);
+  std::vector<std::size_t> stack;
+  std::vector<std::pair<std::size_t, std::size_t>> calls; // (location, next outgoing program)
+  std::vector<std::size_t> scc_levels;
+  std::size_t counter = 0;
+
+  for (std::size_t root = 0; root < n; ++root) {
+    if (index[root] != none)
+      continue;
+    index[root] = lowlink[root] = counter++;
+    stack.push_back(root);
+    on_stack[root] = 1;
+    calls.emplace_back(root, 0);
+
+    while (!calls.empty()) {
+      std::size_t const v = calls.back().first;
+      std::size_t const k = calls.back().second;
+      if (k < _locations[v].outgoing.size()) {
+        ++calls.back().second;
+        std::size_t const w = _programs[_locations[v].outgoing[k]].tgt;
+        if (index[w] == none) {
+          index[w] = lowlink[w] = counter++;
+          stack.push_back(w);
+          on_stack[w] = 1;
+          calls.emplace_back(w, 0);
+        }
+        else if (on_stack[w])
+          lowlink[v] = std::min(lowlink[v], index[w]);
+        continue;
+      }
+
+      calls.pop_back();
+      if (!calls.empty())
+        lowlink[calls.back().first] = std::min(lowlink[calls.back().first], lowlink[v]);
+      if (lowlink[v] != index[v])
+        continue;
+
+      // v is the root of a component. Its successors in other components have been assigned a level
+      std::size_t const scc = scc_levels.size();
+      std::size_t level = 0, w;
+      std::vector<std::size_t> members;
+      do {
+        w = stack.back();
+        stack.pop_back();
+        on_stack[w] = 0;
+        _locations[w].scc = scc;
+        members.push_back(w);
+      } while (w != v);
+      for (std::size_t m : members)
+        for (std::size_t p : _locations[m].outgoing) {
+          std::size_t const tgt_scc = _locations[_programs[p].tgt].scc;
+          if (tgt_scc != scc)
+            level = std::max(level, scc_levels[tgt_scc] + 1);
+        }
+      scc_levels.push_back(level);
+      if (_levels.size() <= level)
+        _levels.resize(level + 1);
+      _levels[level].push_back(std::move(members));
+    }
+  }
+
+  _sccs_count = scc_levels.size();
+  _levels_count = _levels.size();
+}
+
+void g_simulation_t::compute_fixpoint(std::size_t threads)
+{
+  std::size_t const size = static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim);
+  _in_queue.assign(_locations.size(), 0);
+
+  std::size_t width = 0;
+  for (std::vector<std::vector<std::size_t>> const & level : _levels)
+    width = std::max(width, level.size());
+
+  // Scratch data of each thread, the calling thread being the first one
+  struct worker_t {
+    tchecker::zg::elapsed_semantics_t semantics;
+    std::vector<tchecker::dbm::db_t> candidate;
+    unsigned long saved = 0;
+  };
+  std::vector<worker_t> workers(std::max<std::size_t>(1, std::min(threads, width)));
+  for (worker_t & w : workers)
+    w.candidate.resize(size);
+
+  std::mutex mutex;
+  std::condition_variable start, done;
+  std::vector<std::vector<std::size_t>> const * level = nullptr; // current level
+  std::atomic<std::size_t> next{0};                              // next component in the current level
+  std::size_t generation = 0;                                    // number of levels handed to the pool
+  std::size_t running = 0;                                       // threads of the pool working on the current level
+  bool stop = false;
+  std::exception_ptr error;
+
+  auto stabilize_level = [&](worker_t & w) {
+    try {
+      for (std::size_t k = next++; k < level->size(); k = next++)
+        w.saved += stabilize((*level)[k], w.semantics, w.candidate);
+    }
+    catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (error == nullptr)
+        error = std::current_exception();
+    }
+  };
+
+  // 线程只创建一次，各层之间复用
+  std::vector<std::thread> pool;
+  for (std::size_t i = 1; i < workers.size(); ++i)
+    pool.emplace_back([&, i]() {
+      std::size_t seen = 0;
+      while (true) {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          start.wait(lock, [&]() { return stop || generation != seen; });
+          if (stop)
+            return;
+          seen = generation;
+        }
+        stabilize_level(workers[i]);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0)
+          done.notify_one();
+      }
+    });
+
+  for (std::vector<std::vector<std::size_t>> const & l : _levels) {
+    if (pool.empty() || l.size() == 1) {
+      level = &l;
+      next = 0;
+      stabilize_level(workers[0]);
+    }
+    else {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        level = &l;
+        next = 0;
+        running = pool.size();
+        ++generation;
+      }
+      start.notify_all();
+      stabilize_level(workers[0]);
+      std::unique_lock<std::mutex> lock(mutex);
+      done.wait(lock, [&]() { return running == 0; });
+    }
+    if (error != nullptr)
+      break;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  start.notify_all();
+  for (std::thread & t : pool)
+    t.join();
+
+  if (error != nullptr)
+    std::rethrow_exception(error);
+
+  for (worker_t const & w : workers)
+    _saved_tightens += w.saved;
+  _levels.clear();
+  _in_queue.clear();
+}
+
+unsigned long g_simulation_t::stabilize(std::vector<std::size_t> const & scc, tchecker::zg::elapsed_semantics_t & semantics,
+                                        std::vector<tchecker::dbm::db_t> & candidate)
+{
+  unsigned long saved = 0;
+  std::deque<std::size_t> pending(scc.begin(), scc.end());
+  for (std::size_t q : scc)
+    _in_queue[q] = 1;
+
+  // 从 q 的每条出边 q → q′ 把 G(q′) 反推到 G(q)；G(q) 更新后，同一分量内的前驱需重新计算
+  while (!pending.empty()) {
+    std::size_t const q = pending.front();
+    pending.pop_front();
+    _in_queue[q] = 0;
+
+    bool changed = false;
+    for (std::size_t p : _locations[q].outgoing)
+      changed |= apply_program(_programs[p], semantics, candidate, saved);
+    if (!changed)
+      continue;
+
+    for (std::size_t p : _locations[q].incoming) {
+      std::size_t const src = _programs[p].src;
+      if (_locations[src].scc == _locations[q].scc && !_in_queue[src]) {
+        _in_queue[src] = 1;
+        pending.push_back(src);
+      }
+    }
+  }
+  return saved;
+}
+
+bool g_simulation_t::apply_program(g_transition_program_t const & prog, tchecker::zg::elapsed_semantics_t & semantics,
+                                   std::vector<tchecker::dbm::db_t> & candidate, unsigned long & saved)
+{
+  location_t const & src = _locations[prog.src];
+  location_t const & tgt = _locations[prog.tgt];
+  if (!tgt.consistent)
+    return false;
+
+  // 相当于论文的 pre(prog,G(q′))，应用目标 invariant 和 guard 的逆向 + 撤销 reset + 考虑源 invariant + 把 delay 的逆向效果处理掉
+  candidate = tgt.dbm;
+  tchecker::state_status_t status = semantics.prev(candidate.data(), _dim, src.delay_allowed, src.invariant, prog.guard,
+                                                   prog.reset, tgt.delay_allowed, tgt.invariant);
+  if (status != tchecker::STATE_OK)
+    return false;
+
+  // prev() preserves tightness of G(q′): no need to tighten candidate
+  assert(tchecker::dbm::is_tight(candidate.data(), _dim));
+
+  // 用 widen(target, candidate) 把源位置 q 的 G(q) 更新
+  return widen(_locations[prog.src], candidate, saved);
+}
+
+bool g_simulation_t::widen(location_t & q, std::vector<tchecker::dbm::db_t> const & src, unsigned long & saved)
+{
+  if (!q.consistent)
+    return false; // already empty
+  std::vector<tchecker::dbm::db_t> & target = q.dbm;
+  bool changed = false;
+  for (std::size_t idx = 0, size = target.size(); idx < size && !changed; ++idx)
+    changed = (src[idx] < target[idx]);
+  if (!changed)
+    return false;
+  // Intersection of DBMs (union of constraints). Both are tight, hence only clocks in
+  // strengthened bounds need to be tightened
+  tchecker::clock_id_t pivots;
+  q.consistent =
+      (tchecker::dbm::intersection(target.data(), target.data(), src.data(), _dim, pivots) != tchecker::dbm::EMPTY);
+  q.universal = false;
+  if (pivots < _dim)
+    ++saved;
+  return true;
+}
+
+std::string g_simulation_t::vloc_label(tchecker::vloc_t const & vloc) const
+{
+  try {
+    return tchecker::to_string(vloc, _system->as_system_system());
+  }
+  catch (...) {
+    std::ostringstream oss;
+    oss << "vloc@" << &vloc;
+    return oss.str();
+  }
+}
+
+/* g_simulation_cache_t */
+
+g_simulation_cache_t::g_simulation_cache_t(std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> const & g)
+    : _g(g), _dim(g->dim())
+{
+  assert(_g != nullptr);
+  std::size_t const size = static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim);
+  _meet.dbm.resize(size);
+  _meet.lhs.resize(size);
+}
+
+bool g_simulation_cache_t::normalize(tchecker::const_vloc_sptr_t const & vloc, tchecker::zg::zone_t const & lhs,
+                                     tchecker::dbm::db_t * dbm) const
+{
+  std::size_t const size = static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim);
+  location_t const * g = find(vloc);
+  if (g == nullptr || g->universal || !g->consistent) {
+    std::copy(lhs.dbm(), lhs.dbm() + size, dbm);
+    return !lhs.is_empty();
+  }
+
+  tchecker::dbm::db_t const * meet = intersection(*g, lhs);
+  if (meet == nullptr)
+    return false;
+  std::copy(meet, meet + size, dbm);
+  return true;
+}
+
+unsigned long g_simulation_cache_t::saved_tightens() const { return _g->saved_tightens() + _saved_tightens; }
+
+g_simulation_cache_t::location_t const * g_simulation_cache_t::find(tchecker::const_vloc_sptr_t const & vloc) const
+{
+  location_t const * const * resolved = _resolved.find(*vloc);
+  if (resolved != nullptr)
+    return *resolved;
+  location_t const * q = _g->find(vloc);
+  if (vloc->id() != tchecker::NO_VLOC_ID)
+    _resolved.insert(*vloc, q);
+  return q;
+}
+
+tchecker::dbm::db_t const * g_simulation_cache_t::intersection(location_t const & g, tchecker::zg::zone_t const & lhs) const
+{
+  std::size_t const size = static_cast<std::size_t>(_dim) * static_cast<std::size_t>(_dim);
+  tchecker::dbm::db_t const * lhs_dbm = lhs.dbm();
+
+  if (_meet.g == &g && std::equal(lhs_dbm, lhs_dbm + size, _meet.lhs.begin())) {
+    ++_saved_tightens;
+    return (_meet.empty ? nullptr : _meet.dbm.data());
+  }
+
+  _meet.g = &g;
+  std::copy(lhs_dbm, lhs_dbm + size, _meet.lhs.begin());
+
+  tchecker::clock_id_t pivots;
+  enum tchecker::dbm::status_t status = tchecker::dbm::intersection(_meet.dbm.data(), lhs_dbm, g.dbm.data(), _dim, pivots);
+  if (pivots < _dim)
+    ++_saved_tightens;
+
+  _meet.empty = (status == tchecker::dbm::EMPTY);
+  return (_meet.empty ? nullptr : _meet.dbm.data());
+}
+
+bool g_simulation_cache_t::is_le(tchecker::dbm::db_t const * dbm, tchecker::zg::zone_t const & zone) const
+{
+  tchecker::dbm::db_t const * zone_dbm = zone.dbm();
+  for (std::size_t i = 0; i < _dim * _dim; ++i) {
+    if (tchecker::dbm::db_cmp(dbm[i], zone_dbm[i]) > 0)
+      return false;
+  }
+  return true;
+}
+
+bool g_simulation_cache_t::is_le(tchecker::dbm::db_t const * dbm, tchecker::zg::minimal_zone_t const & zone) const
+{
+  return zone.contains(dbm, _dim);
+}
+
+} // namespace zg_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
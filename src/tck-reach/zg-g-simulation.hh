@@ -0,0 +1,378 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TCK_REACH_ZG_G_SIMULATION_HH
+#define TCHECKER_TCK_REACH_ZG_G_SIMULATION_HH
+
+/*!
+ \file zg-g-simulation.hh
+ \brief G-simulation over the zone graph, for covering reachability algorithms
+*/
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/dbm/db.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/zg/minimal_zone.hh"
+#include "tchecker/zg/semantics.hh"
+#include "tchecker/zg/zone.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_covreach {
+
+/*!
+ \class g_simulation_t
+ \brief G(q) DBMs of the tuples of locations of a system, for G-simulation checks
+ \note G(q) is computed once and for all before exploration, as the fixpoint of the backward
+ propagation of guards, resets and invariants over the graph of tuples of locations of the system
+ (i.e. tchecker::syncprod::syncprod_t, integer variables are ignored). Clock constraints that read
+ integer variables are ignored, as well as the transitions with clock resets that depend on integer
+ variables (see tchecker::ta::intval_independent_clock_constraints and
+ tchecker::ta::intval_independent_clock_resets). G(q) is not modified afterwards, hence it can be
+ shared by threads
+ */
+class g_simulation_t {
+public:
+  /*!
+   \brief Location of the system, and its G(q)
+   */
+  struct location_t {
+    std::vector<tchecker::dbm::db_t> dbm;              /*!< G(q) */
+    bool consistent = true;                            /*!< Whether G(q) is not empty */
+    bool universal = true;                             /*!< Whether G(q) has no constraint */
+    tchecker::clock_constraint_container_t invariant; /*!< Invariant of q */
+    bool delay_allowed = false;                        /*!< Whether delay is allowed in q */
+    std::vector<std::size_t> outgoing;                 /*!< Programs from q */
+    std::vector<std::size_t> incoming;                 /*!< Programs to q */
+    std::size_t scc = 0;                               /*!< Strongly connected component of q */
+  };
+
+  /*!
+   \brief Constructor
+   \param system : a system of timed automata
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash tables
+   \param threads : number of threads for the fixpoint computation
+   \pre threads > 0
+   \post G(q) has been computed for every tuple of locations q reachable in the synchronized product
+   of the processes of system
+   \note the fixpoint is computed on the strongly connected components of the graph of locations,
+   from the bottom ones. Components that do not depend on each other are handled by up to threads
+   threads, which are created once for all the components
+   */
+  g_simulation_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::size_t block_size,
+                 std::size_t table_size, std::size_t threads = 1);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  g_simulation_t(tchecker::tck_reach::zg_covreach::g_simulation_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  g_simulation_t(tchecker::tck_reach::zg_covreach::g_simulation_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~g_simulation_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::tck_reach::zg_covreach::g_simulation_t & operator=(tchecker::tck_reach::zg_covreach::g_simulation_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::tck_reach::zg_covreach::g_simulation_t & operator=(tchecker::tck_reach::zg_covreach::g_simulation_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return location of vloc, nullptr if vloc is not a reachable tuple of locations of the system
+   \note locations are retrieved by value
+   */
+  location_t const * find(tchecker::const_vloc_sptr_t const & vloc) const;
+
+  /*!
+   \brief Accessor
+   \return dimension of G(q) DBMs
+   */
+  inline tchecker::clock_id_t dim() const { return _dim; }
+
+  /*!
+   \brief Accessor
+   \return number of intersections of G(q) that have been tightened w.r.t. less than all clocks
+   during the fixpoint computation
+   */
+  inline unsigned long saved_tightens() const { return _saved_tightens; }
+
+private:
+  /*!
+   \brief Clock constraints and resets of a transition from a tuple of locations to another one
+   */
+  struct g_transition_program_t {
+    std::size_t src = 0;                          /*!< Source location */
+    std::size_t tgt = 0;                          /*!< Target location */
+    tchecker::clock_constraint_container_t guard; /*!< Guards of the edges */
+    tchecker::clock_reset_container_t reset;      /*!< Resets of the edges */
+  };
+
+  /*!
+   \brief Clock constraints and resets of the edges of the system
+   */
+  struct edge_programs_t;
+
+  /*!
+   \brief Build the graph of locations
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash tables
+   \post _locations and _programs contain the tuples of locations and the transitions reachable in
+   the synchronized product of the processes from its initial states. G(q) is universal for every
+   location q
+   */
+  void explore(std::size_t block_size, std::size_t table_size);
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \param edges : clock constraints and resets of the edges of the system
+   \return index of vloc in _locations
+   \post a location with universal G(q) has been added for vloc if there was none
+   */
+  std::size_t location(tchecker::const_vloc_sptr_t const & vloc, edge_programs_t const & edges);
+
+  /*!
+   \brief Add a program
+   \param src : source location
+   \param tgt : target location
+   \param vedge : a tuple of edges from src to tgt
+   \param edges : clock constraints and resets of the edges of the system
+   \post a program for vedge has been added to _programs, unless some edge in vedge has clock resets
+   that depend on integer variables, or there is already one with the same target, guard and reset
+   */
+  void add_program(std::size_t src, std::size_t tgt, tchecker::vedge_t const & vedge, edge_programs_t const & edges);
+
+  /*!
+   \brief Compute strongly connected components of the graph of locations (Tarjan's algorithm)
+   \post every location has been assigned a component, and a level such that the successors of a
+   component in other components have smaller levels. Bottom components have level 0
+   */
+  void compute_sccs();
+
+  /*!
+   \brief Compute G(q) for all locations q
+   \param threads : number of threads
+   \pre threads > 0
+   \post G(q) is the fixpoint of the backward propagation of G over all programs. Components are
+   stabilized level after level, and the components in a level are shared among at most threads
+   threads
+   */
+  void compute_fixpoint(std::size_t threads);
+
+  /*!
+   \brief Stabilize G(q) in a strongly connected component
+   \param scc : locations in the component
+   \param semantics : zone semantics
+   \param candidate : scratch DBM of dimension _dim
+   \pre G(q) is stable for every location q in a successor component of scc
+   \post G(q) is stable for every location q in scc
+   \return number of avoided full tightenings
+   \note only accesses the locations in scc and in its successor components
+   */
+  unsigned long stabilize(std::vector<std::size_t> const & scc, tchecker::zg::elapsed_semantics_t & semantics,
+                          std::vector<tchecker::dbm::db_t> & candidate);
+
+  /*!
+   \brief Propagate G(q′) to G(q) through a program from q to q′
+   \param prog : a program
+   \param semantics : zone semantics
+   \param candidate : scratch DBM of dimension _dim
+   \param saved : number of avoided full tightenings
+   \return true if G(q) has been strengthened, false otherwise
+   */
+  bool apply_program(g_transition_program_t const & prog, tchecker::zg::elapsed_semantics_t & semantics,
+                     std::vector<tchecker::dbm::db_t> & candidate, unsigned long & saved);
+
+  /*!
+   \brief Strengthen G(q)
+   \param q : a location
+   \param src : a tight DBM of dimension _dim
+   \param saved : number of avoided full tightenings
+   \post G(q) has been intersected with src
+   \return true if G(q) has changed, false otherwise
+   */
+  bool widen(location_t & q, std::vector<tchecker::dbm::db_t> const & src, unsigned long & saved);
+
+  /*!
+   \brief Label of a tuple of locations for traces
+   \param vloc : tuple of locations
+   \return the names of the locations in vloc
+   */
+  std::string vloc_label(tchecker::vloc_t const & vloc) const;
+
+  std::shared_ptr<tchecker::ta::system_t const> _system;      /*!< System of timed automata */
+  tchecker::clock_id_t _dim;                                  /*!< Dimension of G(q) */
+  std::unique_ptr<tchecker::syncprod::syncprod_t> _syncprod; /*!< Owns the tuples of locations in _index */
+  std::vector<location_t> _locations;                         /*!< Locations */
+  std::vector<g_transition_program_t> _programs;              /*!< Programs between locations */
+  std::unordered_map<tchecker::const_vloc_sptr_t, std::size_t, tchecker::intrusive_shared_ptr_delegate_hash_t,
+                     tchecker::intrusive_shared_ptr_delegate_equal_to_t>
+      _index;                                                   /*!< Location of a tuple of locations (by value) */
+  std::vector<std::vector<std::vector<std::size_t>>> _levels; /*!< Components by level (fixpoint computation only) */
+  std::vector<char> _in_queue;                                /*!< Pending locations (fixpoint computation only) */
+  std::size_t _ignored_programs = 0;                          /*!< Number of transitions without program */
+  std::size_t _sccs_count = 0;                                /*!< Number of components */
+  std::size_t _levels_count = 0;                              /*!< Number of levels of components */
+  unsigned long _saved_tightens = 0;                          /*!< Avoided full tightenings in fixpoint */
+};
+
+/*!
+ \class g_simulation_cache_t
+ \brief G-simulation checks w.r.t. shared G(q) DBMs
+ \note a cache memoizes the G(q) of the tuples of locations of a zone graph, and the last
+ intersection of a zone and G(q). It shall not be used by several threads, while several caches
+ can share the same tchecker::tck_reach::zg_covreach::g_simulation_t
+ */
+class g_simulation_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param g : G(q) DBMs
+   \pre g is not nullptr
+   */
+  explicit g_simulation_cache_t(std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> const & g);
+
+  /*!
+   \brief G-simulation check
+   \param vloc : tuple of locations
+   \param lhs : a zone
+   \param rhs : a zone, either a tchecker::zg::zone_t or a tchecker::zg::minimal_zone_t
+   \return true if the intersection of lhs and G(vloc) is included in rhs, false otherwise
+   \note a minimal rhs is checked without decompression
+   \note does not allocate memory once vloc has been resolved. The intersection of lhs and G(vloc)
+   is only computed if lhs is not included in rhs, and it is kept until the next check with another
+   lhs or another G(vloc)
+   */
+  template <class ZONE>
+  bool simulation_leq(tchecker::const_vloc_sptr_t const & vloc, tchecker::zg::zone_t const & lhs,
+                      ZONE const & rhs) const
+  {
+    location_t const * g = find(vloc);
+    if (g == nullptr || g->universal || !g->consistent)
+      return lhs <= rhs;
+
+    // The intersection of lhs and G(q) is included in lhs: no need to compute it
+    if (is_le(lhs.dbm(), rhs)) {
+      ++_saved_tightens;
+      return true;
+    }
+
+    tchecker::dbm::db_t const * meet = intersection(*g, lhs);
+    if (meet == nullptr)
+      return true; // Empty intersection is subset of anything
+
+    return is_le(meet, rhs);
+  }
+
+  /*!
+   \brief Normalized zone for G-simulation
+   \param vloc : tuple of locations
+   \param lhs : a zone
+   \param dbm : a DBM of the same dimension as lhs
+   \post dbm is the tight intersection of lhs and G(vloc) if G(vloc) is consistent and not universal,
+   and a copy of lhs otherwise
+   \return false if dbm is empty, true otherwise
+   \note for zones lhs and rhs, simulation_leq(vloc, lhs, rhs) holds iff the normalized zone of lhs
+   is empty, or the normalized zone of rhs is not empty and it contains the normalized zone of lhs
+   */
+  bool normalize(tchecker::const_vloc_sptr_t const & vloc, tchecker::zg::zone_t const & lhs,
+                 tchecker::dbm::db_t * dbm) const;
+
+  /*!
+   \brief Accessor
+   \return number of full DBM tightenings that have been avoided: intersections with G(q)
+   that have been skipped or reused, and intersections tightened w.r.t. less than all clocks,
+   including those of the computation of G(q)
+   */
+  unsigned long saved_tightens() const;
+
+private:
+  using location_t = tchecker::tck_reach::zg_covreach::g_simulation_t::location_t;
+
+  /*!
+   \brief Last intersection of a zone and G(q)
+   */
+  struct meet_t {
+    location_t const * g = nullptr;       /*!< Location of G(q) (nullptr if none) */
+    std::vector<tchecker::dbm::db_t> lhs; /*!< Zone */
+    std::vector<tchecker::dbm::db_t> dbm; /*!< Intersection of lhs and G(q) */
+    bool empty = false;                   /*!< Emptiness of the intersection */
+  };
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return location of vloc, nullptr if vloc is not a reachable tuple of locations of the system
+   \note the result is memoized on the identifier of vloc when it has been shared by the zone graph
+   */
+  location_t const * find(tchecker::const_vloc_sptr_t const & vloc) const;
+
+  /*!
+   \brief Intersection of a zone and G(q)
+   \param g : location of G(q)
+   \param lhs : a zone
+   \pre G(q) is consistent
+   \return a pointer to the tight intersection of lhs and G(q), nullptr if the intersection is empty
+   \note the intersection is stored in _meet, and it is recomputed only if lhs or G(q) has changed
+   since the last call. As both lhs and G(q) are tight, only the clocks in the bounds that one DBM
+   strengthens in the other one need to be tightened
+   */
+  tchecker::dbm::db_t const * intersection(location_t const & g, tchecker::zg::zone_t const & lhs) const;
+
+  /*!
+   \brief Inclusion check
+   \param dbm : a tight DBM of dimension _dim
+   \param zone : a zone
+   \return true if dbm is included in zone, false otherwise
+   */
+  bool is_le(tchecker::dbm::db_t const * dbm, tchecker::zg::zone_t const & zone) const;
+
+  /*!
+   \brief Inclusion check without decompression
+   \param dbm : a tight DBM of dimension _dim
+   \param zone : a minimal zone
+   \return true if dbm is included in zone, false otherwise
+   */
+  bool is_le(tchecker::dbm::db_t const * dbm, tchecker::zg::minimal_zone_t const & zone) const;
+
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> _g; /*!< G(q) DBMs */
+  tchecker::clock_id_t _dim;                                                   /*!< Dimension of G(q) */
+  mutable tchecker::vloc_table_t<location_t const *> _resolved; /*!< Location by identifier of zone graph vloc */
+  mutable meet_t _meet;                                        /*!< Last intersection */
+  mutable unsigned long _saved_tightens = 0;                   /*!< Avoided full tightenings */
+};
+
+} // namespace zg_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TCK_REACH_ZG_G_SIMULATION_HH
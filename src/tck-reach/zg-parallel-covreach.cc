@@ -0,0 +1,586 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/graph/allocators.hh"
+#include "tchecker/graph/cover_graph.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/static_analysis.hh"
+#include "tchecker/ta/state.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/waiting/work_stealing.hh"
+#include "tchecker/zg/zg.hh"
+#include "zg-g-simulation.hh"
+#include "zg-parallel-covreach.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_parallel_covreach {
+
+namespace details {
+
+/*!
+ \class node_t
+ \brief Node of the passed/cover store of a partition
+ */
+class node_t : public tchecker::graph::cover::node_t, public tchecker::graph::node_zg_state_t {
+public:
+  /*!
+   \brief Constructor
+   \param s : a zone graph state
+   \post this node keeps a shared pointer to s, and is not covered
+   */
+  explicit node_t(tchecker::zg::const_state_sptr_t const & s)
+      : tchecker::graph::node_zg_state_t(s), _covered(false), _pending_position(0)
+  {
+  }
+
+  /*!
+   \brief Accessor
+   \return true if this node has been covered by a bigger node, false otherwise
+   \note this method can be called from any thread
+   */
+  inline bool covered() const { return _covered.load(std::memory_order_acquire); }
+
+  /*!
+   \brief Mark this node as covered
+   \post covered() returns true
+   */
+  inline void set_covered() { _covered.store(true, std::memory_order_release); }
+
+  /*!
+   \brief Accessor
+   \return position of this node in the nodes with a pending task of the worker that owns it
+   \note this method shall only be called by the worker that owns this node
+   */
+  inline std::size_t pending_position() const { return _pending_position; }
+
+  /*!
+   \brief Setter
+   \param position : a position
+   \post pending_position() returns position
+   \note this method shall only be called by the worker that owns this node
+   */
+  inline void set_pending_position(std::size_t position) { _pending_position = position; }
+
+private:
+  std::atomic<bool> _covered;    /*!< Covered flag */
+  std::size_t _pending_position; /*!< Position in the nodes with a pending task of the owner */
+};
+
+} // namespace details
+
+} // namespace zg_parallel_covreach
+
+} // end of namespace tck_reach
+
+/*!
+ \class allocation_size_t
+ \brief Specialisation of class allocation_size_t for nodes of parallel covering reachability
+ */
+template <> class allocation_size_t<tchecker::tck_reach::zg_parallel_covreach::details::node_t> {
+public:
+  /*!
+   \brief Allocation size
+   \param args : parameters needed to determine the allocation size
+   */
+  template <class... ARGS> static std::size_t alloc_size(ARGS &&... args)
+  {
+    return sizeof(tchecker::tck_reach::zg_parallel_covreach::details::node_t);
+  }
+};
+
+namespace tck_reach {
+
+namespace zg_parallel_covreach {
+
+namespace details {
+
+/*!
+ \brief Type of shared nodes
+ */
+using shared_node_t = tchecker::make_shared_t<tchecker::tck_reach::zg_parallel_covreach::details::node_t>;
+
+/*!
+ \brief Type of pointer to shared nodes
+ */
+using node_sptr_t = tchecker::intrusive_shared_ptr_t<tchecker::tck_reach::zg_parallel_covreach::details::shared_node_t>;
+
+/*!
+ \class node_sptr_hash_t
+ \brief Hash functor for nodes in a partition
+ \note states in a partition are shared by the zone graph of the partition, hence hashing
+ on the pointers to the discrete part is sound
+ */
+class node_sptr_hash_t {
+public:
+  std::size_t operator()(tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t const & n) const
+  {
+    return tchecker::ta::shared_hash_value(n->state());
+  }
+};
+
+/*!
+ \class node_sptr_le_t
+ \brief Covering predicate for nodes in a partition: same discrete part and G-simulation
+ (see tchecker::tck_reach::zg_covreach::g_simulation_cache_t)
+ */
+class node_sptr_le_t {
+public:
+  /*!
+   \brief Constructor
+   \param g_cache : G-simulation cache of the worker that owns the partition
+   */
+  explicit node_sptr_le_t(std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> const & g_cache)
+      : _g_cache(g_cache)
+  {
+  }
+
+  bool operator()(tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t const & n1,
+                  tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t const & n2) const
+  {
+    return tchecker::ta::shared_equal_to(n1->state(), n2->state()) &&
+           _g_cache->simulation_leq(n1->state().vloc_ptr(), n1->state().zone(), n2->state().zone());
+  }
+
+private:
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_cache_t> _g_cache; /*!< G-simulation cache */
+};
+
+/*!
+ \class packet_t
+ \brief Plain copy of a zone graph state, that can be transferred between zone graphs of
+ distinct threads
+ */
+class packet_t {
+public:
+  /*!
+   \brief Constructor
+   \post this packet is empty
+   */
+  packet_t() = default;
+
+  /*!
+   \brief Constructor
+   \param s : a state
+   \post this packet contains a copy of the tuple of locations, the valuation of bounded
+   integer variables and the DBM in s
+   */
+  explicit packet_t(tchecker::zg::state_t const & s)
+  {
+    tchecker::vloc_t const & vloc = s.vloc();
+    _vloc.resize(vloc.capacity());
+    for (tchecker::process_id_t pid = 0; pid < vloc.capacity(); ++pid)
+      _vloc[pid] = vloc[pid];
+
+    tchecker::intval_t const & intval = s.intval();
+    _intval.resize(intval.capacity());
+    for (tchecker::intvar_id_t id = 0; id < intval.capacity(); ++id)
+      _intval[id] = intval[id];
+
+    tchecker::zg::zone_t const & zone = s.zone();
+    _dim = zone.dim();
+    _dbm.assign(zone.dbm(), zone.dbm() + _dim * _dim);
+
+    _hash = tchecker::ta::hash_value(s);
+  }
+
+  /*!
+   \brief Build a state from this packet
+   \param zg : a zone graph
+   \return a state in zg with same tuple of locations, valuation of bounded integer variables
+   and DBM as this packet
+   */
+  tchecker::zg::state_sptr_t state(tchecker::zg::zg_t & zg) const
+  {
+    return zg.build(_vloc.data(), _intval.data(), _dbm.data(), _dim);
+  }
+
+  /*!
+   \brief Accessor
+   \return hash value of the discrete part of the state in this packet
+   \note the hash value only depends on the content of the state, hence it is the same in all threads
+   */
+  inline std::size_t hash() const { return _hash; }
+
+private:
+  std::vector<tchecker::loc_id_t> _vloc;     /*!< Tuple of locations */
+  std::vector<tchecker::integer_t> _intval;  /*!< Valuation of bounded integer variables */
+  std::vector<tchecker::dbm::db_t> _dbm;     /*!< DBM */
+  tchecker::clock_id_t _dim{0};              /*!< Dimension of DBM */
+  std::size_t _hash{0};                      /*!< Hash value of discrete part */
+};
+
+/*!
+ \class task_t
+ \brief Expansion task: a state to expand, along with the node that stores it
+ \note the node is kept alive by the worker that owns it until the task has been processed
+ */
+class task_t {
+public:
+  tchecker::tck_reach::zg_parallel_covreach::details::packet_t packet; /*!< State to expand */
+  tchecker::tck_reach::zg_parallel_covreach::details::node_t const * node{nullptr}; /*!< Node storing the state */
+  std::size_t owner{0}; /*!< Identifier of the worker that owns node */
+};
+
+/*!
+ \class shared_t
+ \brief Data shared by all workers
+ */
+class shared_t {
+public:
+  /*!
+   \brief Constructor
+   \param threads : number of workers
+   \param policy : waiting policy
+   \param labels : accepting labels
+   */
+  shared_t(std::size_t threads, enum tchecker::waiting::policy_t policy, boost::dynamic_bitset<> const & labels)
+      : tasks(threads, policy), pending(0), stop(false), labels(labels)
+  {
+  }
+
+  tchecker::waiting::work_stealing_t<tchecker::tck_reach::zg_parallel_covreach::details::task_t> tasks; /*!< Expansion tasks */
+  std::atomic<std::size_t> pending;      /*!< Number of packets and tasks not processed yet */
+  std::atomic<bool> stop;                /*!< Stop flag, set when an accepting state has been found */
+  boost::dynamic_bitset<> const labels;  /*!< Accepting labels */
+};
+
+/*!
+ \class worker_t
+ \brief Worker of the parallel covering reachability algorithm, owns a partition of the
+ state-space
+ */
+class worker_t {
+public:
+  /*!
+   \brief Constructor
+   \param id : worker identifier
+   \param sysdecl : system declaration
+   \param block_size : number of elements allocated in one block
+   \param table_size : size of hash tables
+   \param g_simulation : G(q) DBMs of the system declared by sysdecl
+   \note each worker has its own system (hence its own virtual machine), zone graph and G-simulation
+   cache, while g_simulation is shared by all workers
+   */
+  worker_t(std::size_t id, tchecker::parsing::system_declaration_t const & sysdecl, std::size_t block_size,
+           std::size_t table_size,
+           std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> const & g_simulation)
+      : _id(id), _system(new tchecker::ta::system_t{sysdecl}),
+        _zg(tchecker::zg::factory(_system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
+                                  tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)),
+        _node_pool(block_size),
+        _store(table_size, node_sptr_hash_t{},
+               node_sptr_le_t{std::make_shared<tchecker::tck_reach::zg_covreach::g_simulation_cache_t>(g_simulation)})
+  {
+  }
+
+  /*!
+   \brief Destructor
+   */
+  ~worker_t()
+  {
+    _sst.clear();
+    _covered.clear();
+    _pending.clear();
+    _store.clear();
+    _node_pool.destruct_all();
+  }
+
+  /*!
+   \brief Accessor
+   \return system of this worker
+   */
+  inline tchecker::ta::system_t const & system() const { return *_system; }
+
+  /*!
+   \brief Accessor
+   \return zone graph of this worker
+   */
+  inline tchecker::zg::zg_t & zg() { return *_zg; }
+
+  /*!
+   \brief Send a state to this worker
+   \param packet : a state
+   \param shared : shared data
+   \post packet has been added to the inbox of this worker
+   \note this method can be called from any thread
+   */
+  void send(tchecker::tck_reach::zg_parallel_covreach::details::packet_t && packet,
+            tchecker::tck_reach::zg_parallel_covreach::details::shared_t & shared)
+  {
+    shared.pending.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(_inbox_mutex);
+    _inbox.push_back(std::move(packet));
+  }
+
+  /*!
+   \brief Release a node
+   \param node : a node owned by this worker
+   \post node has been added to the released nodes of this worker, which will drop its
+   reference to node
+   \note this method can be called from any thread
+   */
+  void release(tchecker::tck_reach::zg_parallel_covreach::details::node_t const * node)
+  {
+    std::lock_guard<std::mutex> lock(_inbox_mutex);
+    _released.push_back(node);
+  }
+
+  /*!
+   \brief Main loop
+   \param workers : all workers
+   \param shared : shared data
+   \post this worker has processed packets and tasks until the state-space is entirely
+   explored, or until an accepting state has been found
+   */
+  void run(std::vector<std::unique_ptr<tchecker::tck_reach::zg_parallel_covreach::details::worker_t>> & workers,
+           tchecker::tck_reach::zg_parallel_covreach::details::shared_t & shared)
+  {
+    std::vector<tchecker::tck_reach::zg_parallel_covreach::details::packet_t> inbox;
+    std::vector<tchecker::tck_reach::zg_parallel_covreach::details::node_t const *> released;
+    tchecker::tck_reach::zg_parallel_covreach::details::task_t task;
+
+    while (!shared.stop.load(std::memory_order_relaxed)) {
+      {
+        std::lock_guard<std::mutex> lock(_inbox_mutex);
+        inbox.swap(_inbox);
+        released.swap(_released);
+      }
+      for (tchecker::tck_reach::zg_parallel_covreach::details::node_t const * node : released)
+        remove_pending(node);
+      released.clear();
+
+      for (tchecker::tck_reach::zg_parallel_covreach::details::packet_t const & packet : inbox)
+        insert(packet, shared);
+      bool const inserted = !inbox.empty();
+      inbox.clear();
+
+      if (shared.tasks.take(_id, task))
+        expand(task, workers, shared);
+      else if (!inserted) {
+        if (shared.pending.load(std::memory_order_acquire) == 0)
+          break;
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \param stats : statistics
+   \post statistics of this worker have been added to stats
+   */
+  void add_stats(tchecker::algorithms::covreach::stats_t & stats) const
+  {
+    stats.visited_states() += _visited_states;
+    stats.visited_transitions() += _visited_transitions;
+    stats.covered_states() += _covered_states;
+    stats.stored_states() += _store.size();
+  }
+
+private:
+  /*!
+   \brief Insert a state in the partition of this worker
+   \param packet : a state
+   \param shared : shared data
+   \post a node for the state in packet has been added to the store if it is not covered.
+   Then, all the nodes covered by this new node have been removed from the store, and an
+   expansion task has been created for the new node
+   */
+  void insert(tchecker::tck_reach::zg_parallel_covreach::details::packet_t const & packet,
+              tchecker::tck_reach::zg_parallel_covreach::details::shared_t & shared)
+  {
+    tchecker::zg::state_sptr_t s = packet.state(*_zg);
+    _zg->share(s);
+
+    tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t n =
+        _node_pool.construct(tchecker::zg::const_state_sptr_t{s});
+    tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t covering_node;
+
+    _store.add_node(n);
+    if (_store.is_covered(n, covering_node)) {
+      _store.remove_node(n);
+      ++_covered_states;
+    }
+    else {
+      _covered.clear();
+      auto covered_inserter = std::back_inserter(_covered);
+      _store.covered_nodes(n, covered_inserter);
+      for (tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t const & covered_node : _covered) {
+        _store.remove_node(covered_node);
+        covered_node->set_covered();
+        ++_covered_states;
+      }
+      _covered.clear();
+      n->set_pending_position(_pending.size());
+      _pending.push_back(n);
+
+      tchecker::tck_reach::zg_parallel_covreach::details::task_t task;
+      task.packet = packet;
+      task.node = n.ptr();
+      task.owner = _id;
+      shared.pending.fetch_add(1, std::memory_order_relaxed);
+      shared.tasks.insert(_id, std::move(task));
+    }
+
+    shared.pending.fetch_sub(1, std::memory_order_release);
+  }
+
+  /*!
+   \brief Drop the reference to a node with a pending task
+   \param node : a node
+   \pre node has a pending task, owned by this worker (checked by assertion)
+   \post this worker does not keep node alive anymore (node is still kept alive if it is stored in
+   the passed/cover store)
+   */
+  void remove_pending(tchecker::tck_reach::zg_parallel_covreach::details::node_t const * node)
+  {
+    std::size_t const k = node->pending_position();
+    assert(k < _pending.size() && _pending[k].ptr() == node);
+    _pending[k] = _pending.back();
+    _pending[k]->set_pending_position(k);
+    _pending.pop_back();
+  }
+
+  /*!
+   \brief Expand a state
+   \param task : a task
+   \param workers : all workers
+   \param shared : shared data
+   \post if the node in task has not been covered, the state in task has been checked for
+   acceptance, and all its successors have been sent to the workers that own them. The node
+   in task has been released to the worker that owns it
+   */
+  void expand(tchecker::tck_reach::zg_parallel_covreach::details::task_t const & task,
+              std::vector<std::unique_ptr<tchecker::tck_reach::zg_parallel_covreach::details::worker_t>> & workers,
+              tchecker::tck_reach::zg_parallel_covreach::details::shared_t & shared)
+  {
+    if (!task.node->covered()) {
+      ++_visited_states;
+
+      tchecker::zg::const_state_sptr_t s{task.packet.state(*_zg)};
+
+      if (!shared.labels.none() && shared.labels.is_subset_of(_zg->labels(s)) && _zg->is_valid_final(s))
+        shared.stop.store(true, std::memory_order_relaxed);
+      else {
+        _sst.clear();
+        _zg->next(s, _sst);
+        for (auto && [status, nexts, nextt] : _sst) {
+          ++_visited_transitions;
+          tchecker::tck_reach::zg_parallel_covreach::details::packet_t packet{*nexts};
+          std::size_t const owner = packet.hash() % workers.size();
+          workers[owner]->send(std::move(packet), shared);
+        }
+        _sst.clear();
+      }
+    }
+
+    workers[task.owner]->release(task.node);
+    shared.pending.fetch_sub(1, std::memory_order_release);
+  }
+
+  std::size_t _id;                                            /*!< Identifier */
+  std::shared_ptr<tchecker::ta::system_t const> _system;      /*!< System of timed processes */
+  std::shared_ptr<tchecker::zg::zg_t> _zg;                    /*!< Zone graph */
+  tchecker::graph::node_pool_allocator_t<tchecker::tck_reach::zg_parallel_covreach::details::shared_node_t>
+      _node_pool; /*!< Pool of nodes */
+  tchecker::graph::cover::graph_t<tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t,
+                                  tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_hash_t,
+                                  tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_le_t>
+      _store; /*!< Passed/cover store of the partition */
+  std::vector<tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t>
+      _pending; /*!< Nodes with a pending task, kept alive until their task has been processed */
+  std::vector<tchecker::tck_reach::zg_parallel_covreach::details::node_sptr_t> _covered; /*!< Covered nodes */
+  std::vector<tchecker::zg::zg_t::sst_t> _sst;                /*!< Successors */
+  std::mutex _inbox_mutex;                                    /*!< Lock on inbox */
+  std::vector<tchecker::tck_reach::zg_parallel_covreach::details::packet_t> _inbox; /*!< States sent to this worker */
+  std::vector<tchecker::tck_reach::zg_parallel_covreach::details::node_t const *>
+      _released; /*!< Nodes whose task has been processed */
+  unsigned long _visited_states{0};                           /*!< Number of visited states */
+  unsigned long _visited_transitions{0};                      /*!< Number of visited transitions */
+  unsigned long _covered_states{0};                           /*!< Number of covered states */
+};
+
+} // namespace details
+
+/* run */
+
+tchecker::algorithms::covreach::stats_t run(tchecker::parsing::system_declaration_t const & sysdecl,
+                                            std::string const & labels, std::string const & search_order,
+                                            std::size_t threads, std::size_t block_size, std::size_t table_size)
+{
+  if (threads == 0)
+    throw std::invalid_argument("Parallel covering reachability requires at least one thread");
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
+  if (tchecker::ta::has_diagonal_constraint(*system))
+    throw std::invalid_argument("Parallel covering reachability does not support diagonal clock constraints");
+  if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  // G(q) is read-only once computed: all workers share it
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> g_simulation =
+      std::make_shared<tchecker::tck_reach::zg_covreach::g_simulation_t>(system, block_size, table_size, threads);
+
+  std::vector<std::unique_ptr<tchecker::tck_reach::zg_parallel_covreach::details::worker_t>> workers;
+  for (std::size_t id = 0; id < threads; ++id)
+    workers.push_back(std::make_unique<tchecker::tck_reach::zg_parallel_covreach::details::worker_t>(
+        id, sysdecl, block_size, table_size, g_simulation));
+
+  tchecker::tck_reach::zg_parallel_covreach::details::shared_t shared{
+      threads, tchecker::algorithms::waiting_policy(search_order), system->as_syncprod_system().labels(labels)};
+
+  tchecker::algorithms::covreach::stats_t stats;
+  stats.set_start_time();
+
+  std::vector<tchecker::zg::zg_t::sst_t> sst;
+  workers[0]->zg().initial(sst);
+  for (auto && [status, s, t] : sst) {
+    tchecker::tck_reach::zg_parallel_covreach::details::packet_t packet{*s};
+    std::size_t const owner = packet.hash() % threads;
+    workers[owner]->send(std::move(packet), shared);
+  }
+  sst.clear();
+
+  std::vector<std::thread> pool;
+  for (std::size_t id = 0; id < threads; ++id)
+    pool.emplace_back(&tchecker::tck_reach::zg_parallel_covreach::details::worker_t::run, workers[id].get(),
+                      std::ref(workers), std::ref(shared));
+  for (std::thread & t : pool)
+    t.join();
+
+  stats.set_end_time();
+
+  for (auto const & worker : workers)
+    worker->add_stats(stats);
+  stats.reachable() = shared.stop.load();
+
+  return stats;
+}
+
+} // namespace zg_parallel_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
@@ -0,0 +1,59 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ZG_PARALLEL_COVREACH_ALGORITHM_HH
+#define TCHECKER_ZG_PARALLEL_COVREACH_ALGORITHM_HH
+
+/*!
+ \file zg-parallel-covreach.hh
+ \brief Parallel covering reachability algorithm over the zone graph with zone inclusion
+*/
+
+#include <string>
+
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/parsing/declaration.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_parallel_covreach {
+
+/*!
+ \brief Run parallel covering reachability algorithm on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param threads : number of worker threads
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs" or "bfs"
+ \return statistics on the run
+ \throw std::invalid_argument : if threads is 0, if search_order is not "dfs" nor "bfs",
+ or if the system has diagonal clock constraints
+ \note the state-space is partitioned among threads w.r.t. the hash value of the discrete
+ part of states. Each thread owns a zone graph and the passed/cover store of its partition,
+ and successor states are transferred to the thread that owns their discrete part. The
+ verdict is the same as for tchecker::tck_reach::zg_covreach::run, but statistics depend on
+ the interleaving of threads
+ \note zones are extrapolated w.r.t. local LU clock bounds and compared w.r.t. G-simulation. G(q) is
+ computed by threads threads before exploration, and shared by all threads (see
+ tchecker::tck_reach::zg_covreach::g_simulation_t)
+*/
+tchecker::algorithms::covreach::stats_t run(tchecker::parsing::system_declaration_t const & sysdecl,
+                                            std::string const & labels, std::string const & search_order,
+                                            std::size_t threads, std::size_t block_size, std::size_t table_size);
+
+} // namespace zg_parallel_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_PARALLEL_COVREACH_ALGORITHM_HH
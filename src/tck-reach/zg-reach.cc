@@ -5,15 +5,24 @@
  *
  */
 
+#include <algorithm>
 #include <ranges>
+#include <type_traits>
 
 #include <boost/dynamic_bitset.hpp>
+#if BOOST_VERSION <= 106600
+#include <boost/functional/hash.hpp>
+#else
+#include <boost/container_hash/hash.hpp>
+#endif
 
 #include "counter_example.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/dbm/dbm.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/zg/static_dispatch.hh"
 #include "zg-reach.hh"
 
 namespace tchecker {
@@ -24,29 +33,48 @@ namespace zg_reach {
 
 /* node_t */
 
-node_t::node_t(tchecker::zg::state_sptr_t const & s, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+node_t::node_t(tchecker::zg::state_sptr_t const & s, std::size_t hash, bool initial, bool final)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_compact_zg_state_t(s), _hash(hash)
 {
 }
 
-node_t::node_t(tchecker::zg::const_state_sptr_t const & s, bool initial, bool final)
-    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_zg_state_t(s)
+node_t::node_t(tchecker::zg::const_state_sptr_t const & s, std::size_t hash, bool initial, bool final)
+    : tchecker::graph::node_flags_t(initial, final), tchecker::graph::node_compact_zg_state_t(s), _hash(hash)
 {
 }
 
 /* node_hash_t */
 
-std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_reach::node_t const & n) const
-{
-  return tchecker::zg::shared_hash_value(n.state());
-}
+std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_reach::node_t const & n) const { return n.hash(); }
 
 /* node_equal_to_t */
 
 bool node_equal_to_t::operator()(tchecker::tck_reach::zg_reach::node_t const & n1,
                                  tchecker::tck_reach::zg_reach::node_t const & n2) const
 {
-  return tchecker::zg::shared_equal_to(n1.state(), n2.state());
+  if (n1.vloc_ptr() != n2.vloc_ptr() || n1.intval_ptr() != n2.intval_ptr())
+    return false;
+
+  if (!n1.is_compact() && !n2.is_compact())
+    return n1.state().zone_ptr() == n2.state().zone_ptr();
+
+  if (n1.is_compact() && n2.is_compact()) {
+    // minimal constraint graphs of equal zones are identical
+    tchecker::zg::minimal_zone_t const & z1 = n1.minimal_zone();
+    tchecker::zg::minimal_zone_t const & z2 = n2.minimal_zone();
+    return z1.dim() == z2.dim() && z1.is_empty() == z2.is_empty() && z1.size() == z2.size() &&
+           std::equal(z1.begin(), z1.end(), z2.begin(), [](auto const & e1, auto const & e2) {
+             return e1.x == e2.x && e1.y == e2.y && e1.db == e2.db;
+           });
+  }
+
+  tchecker::zg::zone_t const & zone = (n1.is_compact() ? n2 : n1).state().zone();
+  tchecker::zg::minimal_zone_t const & minimal = (n1.is_compact() ? n1 : n2).minimal_zone();
+  if (zone.dim() != minimal.dim())
+    return false;
+  _scratch.resize(minimal.dim() * minimal.dim());
+  minimal.to_dbm(_scratch.data());
+  return tchecker::dbm::is_equal(zone.dbm(), _scratch.data(), static_cast<tchecker::clock_id_t>(zone.dim()));
 }
 
 /* edge_t */
@@ -55,16 +83,65 @@ edge_t::edge_t(tchecker::zg::transition_t const & t) : tchecker::graph::edge_ved
 
 /* graph_t */
 
-graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size)
+graph_t::graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size,
+                 std::size_t memory_limit, std::string const & spill_dir)
     : tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::edge_t,
                                              tchecker::tck_reach::zg_reach::node_hash_t,
                                              tchecker::tck_reach::zg_reach::node_equal_to_t>(
           block_size, table_size, tchecker::tck_reach::zg_reach::node_hash_t(),
           tchecker::tck_reach::zg_reach::node_equal_to_t()),
-      _zg(zg)
+      _zg(zg), _hash_zone_ptr(memory_limit == 0 && zg->sharing_type() == tchecker::ts::SHARING)
+{
+  if (memory_limit > 0)
+    _spill_store =
+        std::make_unique<tchecker::graph::spill_store_t<node_sptr_t>>(_compact_pool, memory_limit, 1024, spill_dir);
+}
+
+graph_t::~graph_t()
+{
+  _spill_store.reset();
+  clear();
+}
+
+std::tuple<bool, graph_t::node_sptr_t> graph_t::add_node(tchecker::zg::state_sptr_t const & s)
+{
+  std::size_t const hash = hash_value(*s);
+  if (_spill_store != nullptr)
+    _spill_store->touch(hash); // s is about to be looked up
+  return tchecker::graph::reachability::graph_t<
+      tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::edge_t, tchecker::tck_reach::zg_reach::node_hash_t,
+      tchecker::tck_reach::zg_reach::node_equal_to_t>::add_node(s, hash);
+}
+
+std::size_t graph_t::hash_value(tchecker::zg::state_t const & s) const
 {
+  if (_hash_zone_ptr)
+    return tchecker::zg::shared_hash_value(s);
+  // Compact nodes do not keep their zone alive, and zones are not shared without sharing: equal
+  // zones may be stored at different addresses
+  std::size_t h = tchecker::ta::shared_hash_value(s);
+  boost::hash_combine(h, s.zone());
+  return h;
 }
 
+void graph_t::passed_node(graph_t::node_sptr_t const & n)
+{
+  if (_spill_store == nullptr || n->is_compact())
+    return;
+  n->compact(_compact_pool);
+  _spill_store->add(n);
+  if (_spill_store->over_limit())
+    _spill_store->spill();
+}
+
+void graph_t::restore_states()
+{
+  for (node_sptr_t const & n : nodes())
+    n->restore(*_zg, _compact_pool);
+}
+
+std::size_t graph_t::spilled_bytes() const { return (_spill_store == nullptr ? 0 : _spill_store->spilled_bytes()); }
+
 void graph_t::attributes(tchecker::tck_reach::zg_reach::node_t const & n, std::map<std::string, std::string> & m) const
 {
   _zg->attributes(n.state_ptr(), m);
@@ -130,8 +207,9 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::grap
 
 /* state_space_t */
 
-state_space_t::state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size)
-    : _ss(zg, zg, block_size, table_size)
+state_space_t::state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size,
+                             std::size_t memory_limit, std::string const & spill_dir)
+    : _ss(zg, zg, block_size, table_size, memory_limit, spill_dir)
 {
 }
 
@@ -170,27 +248,31 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex:
 
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::state_space_t>>
 run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels, std::string const & search_order,
-    std::size_t block_size, std::size_t table_size)
+    std::size_t block_size, std::size_t table_size, std::size_t memory_limit, std::string const & spill_dir)
 {
   std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
-  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS,
-                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
-
-  std::shared_ptr<tchecker::tck_reach::zg_reach::state_space_t> state_space =
-      std::make_shared<tchecker::tck_reach::zg_reach::state_space_t>(zg, block_size, table_size);
-
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_reach::algorithm_t algorithm;
-
   enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
 
-  tchecker::algorithms::reach::stats_t stats = algorithm.run(state_space->zg(), state_space->graph(), accepting_labels, policy);
+  // the algorithm is instantiated on the actual type of the zone graph to avoid virtual calls on each transition
+  return tchecker::zg::static_dispatch::visit(
+      system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size,
+      table_size, [&](auto const & zg) {
+        std::shared_ptr<tchecker::tck_reach::zg_reach::state_space_t> state_space =
+            std::make_shared<tchecker::tck_reach::zg_reach::state_space_t>(zg, block_size, table_size, memory_limit,
+                                                                           spill_dir);
+
+        tchecker::tck_reach::zg_reach::algorithm_t<typename std::decay_t<decltype(zg)>::element_type> algorithm;
+
+        tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, state_space->graph(), accepting_labels, policy);
+        stats.spilled_bytes() = state_space->graph().spilled_bytes();
 
-  return std::make_tuple(stats, state_space);
+        return std::make_tuple(stats, state_space);
+      });
 }
 
 } // namespace zg_reach
@@ -12,12 +12,14 @@
 #include <ostream>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/algorithms/reach/stats.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
+#include "tchecker/graph/spill_store.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/ts/state_space.hh"
@@ -37,28 +39,40 @@ namespace zg_reach {
 /*!
  \class node_t
  \brief Node of the reachability graph of a zone graph
+ \note passed nodes may be compacted (see tchecker::graph::node_compact_zg_state_t)
  */
 class node_t : public tchecker::waiting::element_t,
                public tchecker::graph::node_flags_t,
-               public tchecker::graph::node_zg_state_t {
+               public tchecker::graph::node_compact_zg_state_t {
 public:
   /*!
   \brief Constructor
   \param s : a zone graph state
+  \param hash : hash value of s (see tchecker::tck_reach::zg_reach::graph_t::hash_value)
   \param initial : initial node flag
   \param final : final node flag
-  \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+  \post this node keeps a shared pointer to s, and has hash value hash and initial/final node flags as specified
   */
-  node_t(tchecker::zg::state_sptr_t const & s, bool initial = false, bool final = false);
+  node_t(tchecker::zg::state_sptr_t const & s, std::size_t hash, bool initial = false, bool final = false);
 
   /*!
    \brief Constructor
    \param s : a zone graph state
+   \param hash : hash value of s (see tchecker::tck_reach::zg_reach::graph_t::hash_value)
    \param initial : initial node flag
    \param final : final node flag
-   \post this node keeps a shared pointer to s, and has initial/final node flags as specified
+   \post this node keeps a shared pointer to s, and has hash value hash and initial/final node flags as specified
    */
-  node_t(tchecker::zg::const_state_sptr_t const & s, bool initial = false, bool final = false);
+  node_t(tchecker::zg::const_state_sptr_t const & s, std::size_t hash, bool initial = false, bool final = false);
+
+  /*!
+   \brief Accessor
+   \return hash value of the state in this node
+   */
+  inline std::size_t hash() const { return _hash; }
+
+private:
+  std::size_t _hash; /*!< Hash value of the state */
 };
 
 /*!
@@ -86,8 +100,12 @@ public:
   \param n1 : a node
   \param n2 : a node
   \return true if n1 and n2 are equal (i.e. have same zone graph state), false otherwise
+  \note compact nodes are compared on their minimal zones, which are canonical
   */
   bool operator()(tchecker::tck_reach::zg_reach::node_t const & n1, tchecker::tck_reach::zg_reach::node_t const & n2) const;
+
+private:
+  mutable std::vector<tchecker::dbm::db_t> _scratch; /*!< Decompressed zone of compact nodes */
 };
 
 /*!
@@ -117,13 +135,24 @@ public:
    \param zg : zone graph
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
+   \param memory_limit : maximal number of bytes of zones of passed nodes in main memory (0 for no limit)
+   \param spill_dir : directory of the spill file (see tchecker::spill_file_t)
+   \note passed nodes are compacted when there is a memory limit, and the least recently accessed hash partitions
+   of passed nodes are spilled to disk when the limit is reached (see tchecker::graph::spill_store_t)
    \note this keeps a pointer on zg
    \note this graph keeps pointers to (part of) states and (part of) transitions allocated by zg. Hence, the graph
    must be destroyed *before* zg is destroyed, since all states and transitions allocated by zg are detroyed
    when zg is destroyed. See state_space_t below to store both fzg and this graph and destroy them in the expected
    order.
   */
-  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size);
+  graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size,
+          std::size_t memory_limit = 0, std::string const & spill_dir = "");
+
+  /*!
+   \brief Destructor
+   \post nodes have been destroyed before the pool of their compact states
+   */
+  virtual ~graph_t();
 
   /*!
    \brief Accessor
@@ -137,6 +166,45 @@ public:
   */
   inline tchecker::zg::zg_t const & zg() const { return *_zg; }
 
+  /*!
+   \brief Add a node
+   \param s : a zone graph state
+   \return see tchecker::graph::reachability::graph_t::add_node
+   \note the partition of s is paged in if it has been spilled
+   */
+  std::tuple<bool, node_sptr_t> add_node(tchecker::zg::state_sptr_t const & s);
+
+  /*!
+   \brief Hash function
+   \param s : a zone graph state
+   \return hash value of s in this graph
+   \note zones are hashed on their address when they are shared and passed nodes keep
+   their zone (i.e. with sharing and no memory limit), and on their content otherwise
+   */
+  std::size_t hash_value(tchecker::zg::state_t const & s) const;
+
+  /*!
+   \brief Hook for passed nodes
+   \param n : a node
+   \post n has been compacted if there is a memory limit. Hash partitions of passed
+   nodes have been spilled to disk if the memory limit has been reached
+   */
+  void passed_node(node_sptr_t const & n);
+
+  /*!
+   \brief Restore the states of compact nodes
+   \post no node in this graph is compact
+   \note this should be called before output of the graph or computation of a
+   counter-example
+   */
+  void restore_states();
+
+  /*!
+   \brief Accessor
+   \return number of bytes of zones that have been spilled to disk
+   */
+  std::size_t spilled_bytes() const;
+
   using tchecker::graph::reachability::graph_t<tchecker::tck_reach::zg_reach::node_t, tchecker::tck_reach::zg_reach::edge_t,
                                                tchecker::tck_reach::zg_reach::node_hash_t,
                                                tchecker::tck_reach::zg_reach::node_equal_to_t>::attributes;
@@ -165,7 +233,10 @@ protected:
   virtual void attributes(tchecker::tck_reach::zg_reach::edge_t const & e, std::map<std::string, std::string> & m) const;
 
 private:
-  std::shared_ptr<tchecker::zg::zg_t> _zg; /*!< Zone graph */
+  std::shared_ptr<tchecker::zg::zg_t> _zg;                      /*!< Zone graph */
+  tchecker::graph::compact_state_pool_t _compact_pool;          /*!< Compact states of passed nodes */
+  std::unique_ptr<tchecker::graph::spill_store_t<node_sptr_t>> _spill_store; /*!< Spill store (nullptr if no memory limit) */
+  bool _hash_zone_ptr;                                          /*!< Zones are hashed on their address */
 };
 
 /*!
@@ -188,9 +259,12 @@ public:
    \param zg : zone graph
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash table
+   \param memory_limit : maximal number of bytes of zones of passed nodes in main memory (0 for no limit)
+   \param spill_dir : directory of the spill file (see tchecker::spill_file_t)
    \note this keeps a pointer on zg
    */
-  state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size);
+  state_space_t(std::shared_ptr<tchecker::zg::zg_t> const & zg, std::size_t block_size, std::size_t table_size,
+                std::size_t memory_limit = 0, std::string const & spill_dir = "");
 
   /*!
    \brief Accessor
@@ -265,11 +339,12 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex:
 /*!
  \class algorithm_t
  \brief Reachability algorithm over the zone graph
+ \tparam ZG : type of zone graph, tchecker::zg::zg_t or an instance of tchecker::zg::static_dispatch::zg_t
 */
-class algorithm_t
-    : public tchecker::algorithms::reach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::graph_t> {
+template <class ZG = tchecker::zg::zg_t>
+class algorithm_t : public tchecker::algorithms::reach::algorithm_t<ZG, tchecker::tck_reach::zg_reach::graph_t> {
 public:
-  using tchecker::algorithms::reach::algorithm_t<tchecker::zg::zg_t, tchecker::tck_reach::zg_reach::graph_t>::algorithm_t;
+  using tchecker::algorithms::reach::algorithm_t<ZG, tchecker::tck_reach::zg_reach::graph_t>::algorithm_t;
 };
 
 /*!
@@ -279,14 +354,19 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param memory_limit : maximal number of bytes of zones of passed nodes in main memory (0 for no limit)
+ \param spill_dir : directory of the spill file (see tchecker::spill_file_t)
  \pre labels must appear as node attributes in sysdecl
  search_order must be either "dfs" or "bfs"
  \return statistics on the run and a representation of the state-space as a reachability graph
  \throw std::runtime_error : if clock bounds cannot be computed for the system modeled by sysdecls
+ \note compact nodes in the returned state-space shall be restored (see graph_t::restore_states)
+ before output of the graph or computation of a counter-example
  */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::state_space_t>>
 run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    std::size_t memory_limit = 0, std::string const & spill_dir = "");
 
 } // end of namespace zg_reach
 
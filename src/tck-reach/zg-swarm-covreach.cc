@@ -0,0 +1,291 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/algorithms/search_order.hh"
+#include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/zg/zg.hh"
+#include "zg-swarm-covreach.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_swarm_covreach {
+
+/* stats_t */
+
+stats_t::stats_t() : _runs(0), _winner(0), _winner_search_order(""), _winner_seed(0), _swarm_visited_states(0) {}
+
+std::size_t & stats_t::runs() { return _runs; }
+
+std::size_t stats_t::runs() const { return _runs; }
+
+std::size_t & stats_t::winner() { return _winner; }
+
+std::size_t stats_t::winner() const { return _winner; }
+
+std::string & stats_t::winner_search_order() { return _winner_search_order; }
+
+std::string const & stats_t::winner_search_order() const { return _winner_search_order; }
+
+std::uint64_t & stats_t::winner_seed() { return _winner_seed; }
+
+std::uint64_t stats_t::winner_seed() const { return _winner_seed; }
+
+unsigned long & stats_t::swarm_visited_states() { return _swarm_visited_states; }
+
+unsigned long stats_t::swarm_visited_states() const { return _swarm_visited_states; }
+
+void stats_t::attributes(std::map<std::string, std::string> & m) const
+{
+  tchecker::algorithms::covreach::stats_t::attributes(m);
+
+  std::stringstream sstream;
+
+  sstream << _runs;
+  m["SWARM_RUNS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _winner;
+  m["SWARM_WINNER"] = sstream.str();
+
+  m["SWARM_WINNER_SEARCH_ORDER"] = _winner_search_order;
+
+  sstream.str("");
+  sstream << _winner_seed;
+  m["SWARM_WINNER_SEED"] = sstream.str();
+
+  sstream.str("");
+  sstream << _swarm_visited_states;
+  m["SWARM_VISITED_STATES"] = sstream.str();
+}
+
+namespace details {
+
+/*!
+ \class swarm_run_t
+ \brief One run of the swarm
+ */
+class swarm_run_t {
+public:
+  /*!
+   \brief Constructor
+   \param sysdecl : system declaration
+   \param search_order : search order
+   \param randomized : whether the run is randomized
+   \param seed : seed of the run (ignored if not randomized)
+   \param block_size : number of elements allocated in one block
+   \param table_size : size of hash tables
+   \param g_simulation : G(q) DBMs of the system declared by sysdecl
+   \post this run owns a system, a zone graph and a state-space built from sysdecl. It shares g_simulation
+   with the other runs
+   */
+  swarm_run_t(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & search_order, bool randomized,
+              std::uint64_t seed, std::size_t block_size, std::size_t table_size,
+              std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> const & g_simulation)
+      : _system(new tchecker::ta::system_t{sysdecl}), _search_order(search_order), _randomized(randomized),
+        _seed(randomized ? seed : 0)
+  {
+    enum tchecker::zg::extrapolation_type_t extrapolation =
+        (tchecker::ta::has_diagonal_constraint(*_system) ? tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF
+                                                         : tchecker::zg::EXTRA_LU_PLUS_LOCAL);
+    std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(_system, tchecker::ts::SHARING,
+                                                                 tchecker::zg::ELAPSED_SEMANTICS, extrapolation,
+                                                                 block_size, table_size)};
+    _state_space =
+        std::make_shared<tchecker::tck_reach::zg_covreach::state_space_t>(zg, g_simulation, block_size, table_size);
+  }
+
+  /*!
+   \brief Run
+   \param labels : comma-separated string of labels
+   \param covering : covering policy
+   \param cancel : cancel flag shared by all the runs of the swarm
+   \post the covering reachability algorithm has been run until it terminates or cancel is set.
+   Any exception has been caught and stored
+   */
+  void run(std::string const & labels, tchecker::algorithms::covreach::covering_t covering,
+           std::atomic<bool> const & cancel)
+  {
+    try {
+      boost::dynamic_bitset<> accepting_labels = _system->as_syncprod_system().labels(labels);
+      enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(_search_order);
+
+      tchecker::tck_reach::zg_covreach::algorithm_t<> algorithm;
+      if (_randomized)
+        algorithm.randomize(_seed);
+      algorithm.cancel_on(cancel);
+
+      if (covering == tchecker::algorithms::covreach::COVERING_FULL)
+        _stats = algorithm.run<tchecker::algorithms::covreach::COVERING_FULL>(_state_space->zg(), _state_space->graph(),
+                                                                             accepting_labels, policy);
+      else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
+        _stats = algorithm.run<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(
+            _state_space->zg(), _state_space->graph(), accepting_labels, policy);
+      else
+        throw std::invalid_argument("Unknown covering policy for covreach algorithm");
+      _stats.saved_tightens() = _state_space->graph().saved_tightens();
+      _stats.storage_bytes() = _state_space->graph().storage_bytes();
+      _stats.spilled_bytes() = _state_space->graph().spilled_bytes();
+      _stats.signature_checks() = _state_space->graph().signature_checks();
+      _stats.signature_rejections() = _state_space->graph().signature_rejections();
+      _stats.signature_misses() = _state_space->graph().signature_misses();
+      _cancelled = algorithm.cancelled();
+    }
+    catch (...) {
+      _exception = std::current_exception();
+      _cancelled = true;
+    }
+  }
+
+  /*!
+   \brief Accessor
+   \return system of this run
+   */
+  inline tchecker::ta::system_t const & system() const { return *_system; }
+
+  /*!
+   \brief Accessor
+   \return state-space of this run
+   */
+  inline std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t> const & state_space() const
+  {
+    return _state_space;
+  }
+
+  /*!
+   \brief Accessor
+   \return statistics of this run
+   */
+  inline tchecker::algorithms::covreach::stats_t const & stats() const { return _stats; }
+
+  /*!
+   \brief Accessor
+   \return search order of this run
+   */
+  inline std::string const & search_order() const { return _search_order; }
+
+  /*!
+   \brief Accessor
+   \return seed of this run (0 if not randomized)
+   */
+  inline std::uint64_t seed() const { return _seed; }
+
+  /*!
+   \brief Accessor
+   \return true if this run has been cancelled or has failed, false if it has terminated
+   */
+  inline bool cancelled() const { return _cancelled; }
+
+  /*!
+   \brief Accessor
+   \return exception raised by this run, nullptr if none
+   */
+  inline std::exception_ptr const & exception() const { return _exception; }
+
+private:
+  std::shared_ptr<tchecker::ta::system_t const> _system;                         /*!< System of timed processes */
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t> _state_space; /*!< State-space */
+  std::string _search_order;                                                     /*!< Search order */
+  bool _randomized;                                                              /*!< Randomized run flag */
+  std::uint64_t _seed;                                                           /*!< Seed */
+  tchecker::algorithms::covreach::stats_t _stats;                                /*!< Statistics */
+  bool _cancelled{true};                                                         /*!< Cancelled flag */
+  std::exception_ptr _exception{nullptr};                                        /*!< Raised exception */
+};
+
+} // namespace details
+
+/* run */
+
+std::tuple<tchecker::tck_reach::zg_swarm_covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t>>
+run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels, std::string const & search_order,
+    tchecker::algorithms::covreach::covering_t covering, std::size_t runs, std::uint64_t seed, std::size_t block_size,
+    std::size_t table_size)
+{
+  if (runs == 0)
+    throw std::invalid_argument("Swarm verification requires at least one run");
+
+  static std::string const search_orders[] = {"dfs", "random", "bfs"};
+
+  // G(q) is computed once for all the runs
+  std::shared_ptr<tchecker::tck_reach::zg_covreach::g_simulation_t const> g_simulation =
+      std::make_shared<tchecker::tck_reach::zg_covreach::g_simulation_t>(
+          std::make_shared<tchecker::ta::system_t const>(sysdecl), block_size, table_size);
+
+  // Runs are built sequentially as building a system is not thread-safe
+  std::vector<std::unique_ptr<tchecker::tck_reach::zg_swarm_covreach::details::swarm_run_t>> swarm;
+  for (std::size_t i = 0; i < runs; ++i) {
+    if (i == 0)
+      swarm.push_back(std::make_unique<tchecker::tck_reach::zg_swarm_covreach::details::swarm_run_t>(
+          sysdecl, search_order, false, 0, block_size, table_size, g_simulation));
+    else
+      swarm.push_back(std::make_unique<tchecker::tck_reach::zg_swarm_covreach::details::swarm_run_t>(
+          sysdecl, search_orders[(i - 1) % 3], true, seed + i, block_size, table_size, g_simulation));
+  }
+
+  if (!tchecker::system::every_process_has_initial_location(swarm[0]->system().as_system_system()))
+    std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
+
+  std::size_t const none = std::numeric_limits<std::size_t>::max();
+  std::atomic<bool> cancel{false};
+  std::atomic<std::size_t> winner{none};
+
+  std::vector<std::thread> pool;
+  for (std::size_t i = 0; i < runs; ++i)
+    pool.emplace_back([&, i]() {
+      swarm[i]->run(labels, covering, cancel);
+      if (swarm[i]->exception() != nullptr) {
+        cancel.store(true, std::memory_order_relaxed);
+        return;
+      }
+      std::size_t expected = none;
+      if (!swarm[i]->cancelled() && winner.compare_exchange_strong(expected, i))
+        cancel.store(true, std::memory_order_relaxed);
+    });
+  for (std::thread & t : pool)
+    t.join();
+
+  for (auto const & r : swarm)
+    if (r->exception() != nullptr)
+      std::rethrow_exception(r->exception());
+
+  std::size_t const w = winner.load();
+  if (w == none)
+    throw std::runtime_error("No run of the swarm has terminated");
+
+  tchecker::tck_reach::zg_swarm_covreach::stats_t stats;
+  static_cast<tchecker::algorithms::covreach::stats_t &>(stats) = swarm[w]->stats();
+  stats.runs() = runs;
+  stats.winner() = w;
+  stats.winner_search_order() = swarm[w]->search_order();
+  stats.winner_seed() = swarm[w]->seed();
+  for (auto const & r : swarm)
+    stats.swarm_visited_states() += r->stats().visited_states();
+
+  return std::make_tuple(stats, swarm[w]->state_space());
+}
+
+} // end of namespace zg_swarm_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
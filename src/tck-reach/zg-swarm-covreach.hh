@@ -0,0 +1,153 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ZG_SWARM_COVREACH_ALGORITHM_HH
+#define TCHECKER_ZG_SWARM_COVREACH_ALGORITHM_HH
+
+/*!
+ \file zg-swarm-covreach.hh
+ \brief Swarm of covering reachability algorithms over the zone graph with diversified search orders
+*/
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "zg-covreach.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+namespace zg_swarm_covreach {
+
+/*!
+ \class stats_t
+ \brief Statistics for a swarm of covering reachability algorithms
+ \note statistics inherited from tchecker::algorithms::covreach::stats_t are the ones of the winning run
+ */
+class stats_t : public tchecker::algorithms::covreach::stats_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  stats_t();
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of runs in the swarm
+   */
+  std::size_t & runs();
+
+  /*!
+   \brief Accessor
+   \return The number of runs in the swarm
+   */
+  std::size_t runs() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the index of the winning run
+   */
+  std::size_t & winner();
+
+  /*!
+   \brief Accessor
+   \return The index of the winning run
+   */
+  std::size_t winner() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the search order of the winning run
+   */
+  std::string & winner_search_order();
+
+  /*!
+   \brief Accessor
+   \return The search order of the winning run
+   */
+  std::string const & winner_search_order() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the seed of the winning run (0 if the winning run is not randomized)
+   */
+  std::uint64_t & winner_seed();
+
+  /*!
+   \brief Accessor
+   \return The seed of the winning run (0 if the winning run is not randomized)
+   */
+  std::uint64_t winner_seed() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of states visited by all the runs
+   */
+  unsigned long & swarm_visited_states();
+
+  /*!
+   \brief Accessor
+   \return The number of states visited by all the runs
+   */
+  unsigned long swarm_visited_states() const;
+
+  /*!
+   \brief Extract statistics as attributes (key, value)
+   \param m : attributes map
+   \post every statistics of the winning run, and every statistics of the swarm, has been added to m
+  */
+  void attributes(std::map<std::string, std::string> & m) const;
+
+private:
+  std::size_t _runs;                   /*!< Number of runs */
+  std::size_t _winner;                 /*!< Index of winning run */
+  std::string _winner_search_order;    /*!< Search order of the winning run */
+  std::uint64_t _winner_seed;          /*!< Seed of the winning run */
+  unsigned long _swarm_visited_states; /*!< Number of states visited by all the runs */
+};
+
+/*!
+ \brief Run a swarm of covering reachability algorithms on the zone graph of a system
+ \param sysdecl : system declaration
+ \param labels : comma-separated string of labels
+ \param search_order : search order of the first run
+ \param covering : covering policy
+ \param runs : number of runs
+ \param seed : seed of the randomized runs
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \pre labels must appear as node attributes in sysdecl
+ search_order must be either "dfs", "bfs" or "random"
+ \return statistics on the winning run and on the swarm, and the state-space of the winning run
+ \throw std::invalid_argument : if runs is 0
+ \throw std::runtime_error : if clock bounds cannot be computed for the system modeled by sysdecl
+ \note runs are independent explorations, each on its own thread with its own zone graph and subsumption
+ graph. The first run follows search_order as tchecker::tck_reach::zg_covreach::run does. Run i > 0 is
+ randomized with seed + i (see tchecker::algorithms::covreach::algorithm_t::randomize), and uses search
+ orders dfs, random and bfs in turn. The first run that terminates, either on an accepting state or by
+ exhausting the state-space, cancels the other ones: its verdict is the verdict of the swarm
+ \note the memory used by the swarm grows with the number of runs
+ */
+std::tuple<tchecker::tck_reach::zg_swarm_covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::state_space_t>>
+run(tchecker::parsing::system_declaration_t const & sysdecl, std::string const & labels, std::string const & search_order,
+    tchecker::algorithms::covreach::covering_t covering, std::size_t runs, std::uint64_t seed, std::size_t block_size,
+    std::size_t table_size);
+
+} // end of namespace zg_swarm_covreach
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_SWARM_COVREACH_ALGORITHM_HH
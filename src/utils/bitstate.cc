@@ -0,0 +1,122 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "tchecker/utils/bitstate.hh"
+
+namespace tchecker {
+
+/*!
+ \brief Mix of bits
+ \param x : a value
+ \return x with bits mixed (finalizer of splitmix64)
+ \note hash values are combined with boost::hash_combine, which leaves low
+ entropy in high bits. Mixing spreads it over all the bits
+ */
+static inline std::uint64_t mix(std::uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+bitstate_t::bitstate_t(std::size_t bits, unsigned int hashes)
+    : _mask(0), _hashes(hashes), _set_bits(0), _stored(0), _expected_omissions(0.0)
+{
+  if (hashes == 0 || hashes > 32)
+    throw std::invalid_argument("Number of bits per state in bit-state table should be in 1..32");
+  std::size_t size = 64;
+  while (size <= bits / 2)
+    size *= 2;
+  _mask = size - 1;
+  _table.resize(size / 64, 0);
+}
+
+bool bitstate_t::insert(std::size_t hash)
+{
+  std::uint64_t const h1 = tchecker::mix(hash);
+  std::uint64_t const h2 = tchecker::mix(h1 ^ 0x9e3779b97f4a7c15ULL) | 1;
+  // Collision probability of a new value w.r.t. the table before insertion
+  double const ratio = static_cast<double>(_set_bits) / static_cast<double>(bits());
+  unsigned int set = 0;
+  for (unsigned int i = 0; i < _hashes; ++i) {
+    std::size_t const p = position(h1, h2, i);
+    std::uint64_t const bit = std::uint64_t(1) << (p % 64);
+    if ((_table[p / 64] & bit) == 0) {
+      _table[p / 64] |= bit;
+      ++set;
+    }
+  }
+  if (set == 0)
+    return false;
+  _set_bits += set;
+  ++_stored;
+  _expected_omissions += std::pow(ratio, _hashes);
+  return true;
+}
+
+bool bitstate_t::contains(std::size_t hash) const
+{
+  std::uint64_t const h1 = tchecker::mix(hash);
+  std::uint64_t const h2 = tchecker::mix(h1 ^ 0x9e3779b97f4a7c15ULL) | 1;
+  for (unsigned int i = 0; i < _hashes; ++i) {
+    std::size_t const p = position(h1, h2, i);
+    if ((_table[p / 64] & (std::uint64_t(1) << (p % 64))) == 0)
+      return false;
+  }
+  return true;
+}
+
+void bitstate_t::clear()
+{
+  std::fill(_table.begin(), _table.end(), 0);
+  _set_bits = 0;
+  _stored = 0;
+  _expected_omissions = 0.0;
+}
+
+double bitstate_t::hash_factor() const
+{
+  return (_stored == 0 ? static_cast<double>(bits()) : static_cast<double>(bits()) / static_cast<double>(_stored));
+}
+
+double bitstate_t::expected_omissions() const { return _expected_omissions; }
+
+double bitstate_t::omission_probability() const { return -std::expm1(-_expected_omissions); }
+
+void bitstate_t::attributes(std::map<std::string, std::string> & m) const
+{
+  std::stringstream sstream;
+
+  sstream << bits();
+  m["BITSTATE_BITS"] = sstream.str();
+
+  sstream.str("");
+  sstream << _hashes;
+  m["BITSTATE_HASH_FUNCTIONS"] = sstream.str();
+
+  sstream.str("");
+  sstream << hash_factor();
+  m["BITSTATE_HASH_FACTOR"] = sstream.str();
+
+  sstream.str("");
+  sstream << expected_omissions();
+  m["BITSTATE_EXPECTED_OMISSIONS"] = sstream.str();
+
+  sstream.str("");
+  sstream << omission_probability();
+  m["BITSTATE_OMISSION_PROBABILITY"] = sstream.str();
+}
+
+} // end of namespace tchecker
@@ -0,0 +1,244 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tchecker/utils/spill_file.hh"
+
+namespace tchecker {
+
+/*!
+ \brief Round up to a multiple
+ \param size : a size
+ \param unit : a unit
+ \return smallest multiple of unit that is greater than or equal to size
+ */
+static std::size_t round_up(std::size_t size, std::size_t unit) { return ((size + unit - 1) / unit) * unit; }
+
+/*!
+ \brief Round down to a multiple
+ \param size : a size
+ \param unit : a unit
+ \return greatest multiple of unit that is less than or equal to size
+ */
+static std::size_t round_down(std::size_t size, std::size_t unit) { return (size / unit) * unit; }
+
+/*!
+ \brief System error
+ \param what : description of the failed operation
+ \param error : error number
+ \return runtime error describing what has failed and why
+ */
+static std::runtime_error system_error(std::string const & what, int error)
+{
+  return std::runtime_error("Spill file: " + what + " failed (" + std::strerror(error) + ")");
+}
+
+/*!
+ \brief Reserve disk space
+ \param fd : file descriptor
+ \param offset : offset in the file
+ \param length : length of the reserved region
+ \post the file has size at least offset + length, and disk space for bytes offset to offset + length - 1 has been
+ allocated if the system supports it
+ \return 0 on success, an error number otherwise
+ \note macOS has no posix_fallocate: disk space is preallocated with F_PREALLOCATE (best effort), then the file is
+ extended with ftruncate
+ */
+static int reserve(int fd, off_t offset, off_t length)
+{
+#if defined(__APPLE__)
+  struct stat st;
+  if (fstat(fd, &st) == -1)
+    return errno;
+  if (offset + length <= st.st_size)
+    return 0; // regions inside the file keep their disk space: holes are never punched on macOS
+  fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, offset + length - st.st_size, 0};
+  fcntl(fd, F_PREALLOCATE, &store);
+  if (ftruncate(fd, offset + length) == -1)
+    return errno;
+  return 0;
+#else
+  return posix_fallocate(fd, offset, length);
+#endif
+}
+
+spill_file_t::spill_file_t(std::string const & directory, std::size_t segment_size)
+    : _fd(-1), _page_size(static_cast<std::size_t>(sysconf(_SC_PAGESIZE))), _segment_size(0), _file_size(0), _size(0)
+{
+  _segment_size = tchecker::round_up(std::max(segment_size, _page_size), _page_size);
+
+  std::string dir = directory;
+  if (dir.empty()) {
+    char const * tmpdir = std::getenv("TMPDIR");
+    dir = (tmpdir != nullptr && *tmpdir != '\0' ? tmpdir : "/tmp");
+  }
+  std::string path = dir + "/tchecker-spill-XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back('\0');
+
+  _fd = mkstemp(name.data());
+  if (_fd == -1)
+    throw tchecker::system_error("creation of " + path, errno);
+  unlink(name.data()); // the file vanishes when closed
+}
+
+spill_file_t::~spill_file_t()
+{
+  for (segment_t const & s : _segments)
+    munmap(s.ptr, s.size);
+  close(_fd);
+}
+
+void * spill_file_t::allocate(std::size_t size)
+{
+  size = tchecker::round_up(std::max(size, std::size_t(1)), alignof(std::max_align_t));
+
+  char * ptr = reuse(size);
+  if (ptr == nullptr) {
+    if (_segments.empty() || _segments.back().used + size > _segments.back().size) {
+      std::size_t segment_size = std::max(tchecker::round_up(size, _page_size), _segment_size);
+      int error = tchecker::reserve(_fd, static_cast<off_t>(_file_size), static_cast<off_t>(segment_size));
+      if (error != 0)
+        throw tchecker::system_error("extension", error);
+      void * p = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, static_cast<off_t>(_file_size));
+      if (p == MAP_FAILED)
+        throw tchecker::system_error("mapping", errno);
+      // the end of the last segment is left for reuse
+      if (!_segments.empty() && _segments.back().used < _segments.back().size) {
+        segment_t & last = _segments.back();
+        release(last.ptr + last.used, last.size - last.used);
+        last.used = last.size;
+      }
+      _segments.push_back({static_cast<char *>(p), _file_size, segment_size, 0});
+      _file_size += segment_size;
+    }
+
+    segment_t & s = _segments.back();
+    ptr = s.ptr + s.used;
+    s.used += size;
+  }
+  _size += size;
+  return ptr;
+}
+
+void spill_file_t::deallocate(void const * ptr, std::size_t size)
+{
+  size = tchecker::round_up(std::max(size, std::size_t(1)), alignof(std::max_align_t));
+  assert(_size >= size);
+  _size -= size;
+  release(const_cast<char *>(static_cast<char const *>(ptr)), size);
+}
+
+void spill_file_t::page_out(void const * ptr, std::size_t size)
+{
+  auto && [begin, offset, length] = pages(ptr, size);
+  if (msync(begin, length, MS_SYNC) == -1)
+    throw tchecker::system_error("write", errno);
+  // Data is on disk: drop it from the address space and from the page cache
+  madvise(begin, length, MADV_DONTNEED);
+#if defined(POSIX_FADV_DONTNEED)
+  posix_fadvise(_fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_DONTNEED);
+#else
+  (void)offset;
+#endif
+}
+
+void spill_file_t::page_in(void const * ptr, std::size_t size)
+{
+  auto && [begin, offset, length] = pages(ptr, size);
+  (void)offset;
+  madvise(begin, length, MADV_WILLNEED);
+}
+
+std::tuple<char *, std::size_t, std::size_t> spill_file_t::pages(void const * ptr, std::size_t size) const
+{
+  segment_t const & s = segment(ptr);
+  std::size_t const begin = static_cast<std::size_t>(static_cast<char const *>(ptr) - s.ptr);
+  std::size_t const first = tchecker::round_down(begin, _page_size); // segments are page-aligned
+  std::size_t const last = std::min(tchecker::round_up(begin + size, _page_size), s.size);
+  return std::make_tuple(s.ptr + first, s.offset + first, last - first);
+}
+
+char * spill_file_t::reuse(std::size_t size)
+{
+  // first fit: allocations are made by whole spilled partitions, hence they are few
+  for (auto it = _free.begin(); it != _free.end(); ++it) {
+    if (it->second < size)
+      continue;
+    auto && [begin, offset, length] = pages(it->first, size);
+    (void)begin;
+    int error = tchecker::reserve(_fd, static_cast<off_t>(offset), static_cast<off_t>(length));
+    if (error != 0)
+      throw tchecker::system_error("extension", error);
+    char * ptr = it->first;
+    std::size_t const remaining = it->second - size;
+    _free.erase(it);
+    if (remaining > 0)
+      _free.emplace(ptr + size, remaining);
+    return ptr;
+  }
+  return nullptr;
+}
+
+void spill_file_t::release(char * ptr, std::size_t size)
+{
+  segment_t const & s = segment(ptr);
+  char * begin = ptr;
+  char * end = ptr + size;
+
+  // Coalesce with neighbour free regions in the same segment
+  auto next = _free.lower_bound(begin);
+  if (next != _free.end() && next->first == end && end < s.ptr + s.size) {
+    end += next->second;
+    next = _free.erase(next);
+  }
+  if (next != _free.begin() && begin > s.ptr) {
+    auto prev = std::prev(next);
+    if (prev->first >= s.ptr && prev->first + prev->second == begin) {
+      begin = prev->first;
+      _free.erase(prev);
+    }
+  }
+  _free.emplace(begin, static_cast<std::size_t>(end - begin));
+
+  // Release the pages that only contain free regions
+  std::size_t const first = tchecker::round_up(static_cast<std::size_t>(begin - s.ptr), _page_size);
+  std::size_t const last = tchecker::round_down(static_cast<std::size_t>(end - s.ptr), _page_size);
+  if (first < last) {
+    madvise(s.ptr + first, last - first, MADV_DONTNEED);
+#if defined(FALLOC_FL_PUNCH_HOLE)
+    // best effort: the file system may not support holes
+    fallocate(_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(s.offset + first),
+              static_cast<off_t>(last - first));
+#endif
+  }
+}
+
+spill_file_t::segment_t const & spill_file_t::segment(void const * ptr) const
+{
+  char const * p = static_cast<char const *>(ptr);
+  for (auto it = _segments.rbegin(); it != _segments.rend(); ++it)
+    if (it->ptr <= p && p < it->ptr + it->size)
+      return *it;
+  assert(false);
+  throw std::invalid_argument("Spill file: pointer out of the file");
+}
+
+} // end of namespace tchecker
@@ -0,0 +1,77 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <mutex>
+#include <stdexcept>
+
+#include "tchecker/utils/string.hh"
+#include "tchecker/utils/trace.hh"
+
+namespace tchecker {
+
+namespace trace {
+
+namespace details {
+
+std::atomic<tchecker::trace::mask_t> mask{tchecker::trace::CATEGORY_NONE};
+
+static std::ostream * sink = &std::cerr; /*!< Trace sink */
+static std::mutex sink_mutex;            /*!< Mutex on sink */
+
+} // end of namespace details
+
+void enable(tchecker::trace::mask_t mask) { tchecker::trace::details::mask.store(mask, std::memory_order_relaxed); }
+
+tchecker::trace::mask_t parse_categories(std::string const & categories)
+{
+  tchecker::trace::mask_t mask = tchecker::trace::CATEGORY_NONE;
+  for (std::string const & c : tchecker::split(categories, ',')) {
+    if (c == "tool")
+      mask |= tchecker::trace::CATEGORY_TOOL;
+    else if (c == "covreach")
+      mask |= tchecker::trace::CATEGORY_COVREACH;
+    else if (c == "gsim")
+      mask |= tchecker::trace::CATEGORY_GSIM;
+    else if (c == "all")
+      mask |= tchecker::trace::CATEGORY_ALL;
+    else if (c == "none" || c.empty())
+      continue;
+    else
+      throw std::invalid_argument("Unknown trace category: " + c);
+  }
+  return mask;
+}
+
+void set_sink(std::ostream & os)
+{
+  std::lock_guard<std::mutex> lock(tchecker::trace::details::sink_mutex);
+  tchecker::trace::details::sink = &os;
+}
+
+void output(enum tchecker::trace::category_t category, std::string const & msg)
+{
+  std::lock_guard<std::mutex> lock(tchecker::trace::details::sink_mutex);
+  *tchecker::trace::details::sink << "[" << tchecker::trace::name(category) << "] " << msg << '\n';
+}
+
+char const * name(enum tchecker::trace::category_t category)
+{
+  switch (category) {
+  case tchecker::trace::CATEGORY_TOOL:
+    return "tool";
+  case tchecker::trace::CATEGORY_COVREACH:
+    return "covreach";
+  case tchecker::trace::CATEGORY_GSIM:
+    return "gsim";
+  default:
+    return "trace";
+  }
+}
+
+} // end of namespace trace
+
+} // end of namespace tchecker
@@ -0,0 +1,101 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+
+#include "tchecker/vm/memoized_bytecode.hh"
+
+namespace tchecker {
+
+memoized_bytecode_t::memoized_bytecode_t(tchecker::bytecode_t const * bytecode, tchecker::vm_t & vm)
+    : _bytecode(bytecode), _threaded(bytecode), _native(nullptr), _kind(INTERPRETED)
+{
+  assert(_bytecode != nullptr);
+
+  if (!tchecker::read_intvars(_bytecode, _intvars) || _intvars.size() > MAX_CACHED_INTVARS) {
+    _intvars.clear();
+    return;
+  }
+
+  if (!_intvars.empty()) {
+    _kind = CACHED;
+    _keys.resize(CACHE_SIZE * _intvars.size());
+    _entries.resize(CACHE_SIZE);
+    _valid.resize(CACHE_SIZE, false);
+    return;
+  }
+
+  // The bytecode does not access integer variables: any valuation can be used
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(0, 0);
+  try {
+    tchecker::clock_constraint_container_t clkconstr;
+    tchecker::clock_reset_container_t clkreset;
+    record(vm, *intval, clkconstr, clkreset, _result);
+    _kind = INTVAL_INDEPENDENT;
+  }
+  catch (...) {
+    // the bytecode fails whatever the valuation, let run() fail
+  }
+  tchecker::intval_destruct_and_deallocate(intval);
+}
+
+tchecker::integer_t memoized_bytecode_t::run(tchecker::vm_t & vm, tchecker::intval_t & intval,
+                                             tchecker::clock_constraint_container_t & clkconstr,
+                                             tchecker::clock_reset_container_t & clkreset)
+{
+  if (_kind == INTVAL_INDEPENDENT)
+    return replay(_result, clkconstr, clkreset);
+
+  if (_kind == INTERPRETED)
+    return interpret(vm, intval, clkconstr, clkreset);
+
+  // cached bytecode: look for the values of read variables in the entry they map to
+  std::size_t const n = _intvars.size();
+  std::size_t hash = 0;
+  for (tchecker::intvar_id_t id : _intvars) {
+    assert(id < intval.size());
+    hash = hash * 31 + static_cast<std::size_t>(intval[id]);
+  }
+  std::size_t const slot = hash % CACHE_SIZE;
+  tchecker::integer_t * key = &_keys[slot * n];
+
+  if (_valid[slot]) {
+    std::size_t i = 0;
+    while (i < n && key[i] == intval[_intvars[i]])
+      ++i;
+    if (i == n)
+      return replay(_entries[slot], clkconstr, clkreset);
+  }
+
+  _valid[slot] = false;
+  tchecker::integer_t const value = record(vm, intval, clkconstr, clkreset, _entries[slot]);
+  for (std::size_t i = 0; i < n; ++i)
+    key[i] = intval[_intvars[i]];
+  _valid[slot] = true;
+  return value;
+}
+
+tchecker::integer_t memoized_bytecode_t::record(tchecker::vm_t & vm, tchecker::intval_t & intval,
+                                                tchecker::clock_constraint_container_t & clkconstr,
+                                                tchecker::clock_reset_container_t & clkreset, result_t & result)
+{
+  std::size_t const clkconstr_size = clkconstr.size(), clkreset_size = clkreset.size();
+  result.value = interpret(vm, intval, clkconstr, clkreset);
+  result.clkconstr.assign(clkconstr.begin() + clkconstr_size, clkconstr.end());
+  result.clkreset.assign(clkreset.begin() + clkreset_size, clkreset.end());
+  return result.value;
+}
+
+tchecker::integer_t memoized_bytecode_t::replay(result_t const & result, tchecker::clock_constraint_container_t & clkconstr,
+                                                tchecker::clock_reset_container_t & clkreset)
+{
+  clkconstr.insert(clkconstr.end(), result.clkconstr.begin(), result.clkconstr.end());
+  clkreset.insert(clkreset.end(), result.clkreset.begin(), result.clkreset.end());
+  return result.value;
+}
+
+} // end of namespace tchecker
@@ -0,0 +1,317 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/vm/native.hh"
+
+namespace tchecker {
+
+namespace details {
+
+/*!
+ \brief Decoded instruction
+ */
+struct native_decoded_t {
+  tchecker::bytecode_t const * address; /*!< Address in bytecode */
+  tchecker::bytecode_t instruction;     /*!< Instruction */
+  tchecker::bytecode_t param1;          /*!< First parameter (0 if none) */
+  tchecker::bytecode_t param2;          /*!< Second parameter (0 if none) */
+  tchecker::bytecode_t const * target;  /*!< Jump target (nullptr if not a jump) */
+};
+
+/*!
+ \brief Decode bytecode
+ \param bytecode : bytecode
+ \pre bytecode is null-terminated (i.e. VM_RET) and well-formed
+ \return the instructions in bytecode, up to the first VM_RET after all jump targets
+ */
+static std::vector<native_decoded_t> native_decode(tchecker::bytecode_t const * bytecode)
+{
+  std::vector<native_decoded_t> decoded;
+  tchecker::bytecode_t const * last_target = bytecode;
+  for (tchecker::bytecode_t const * p = bytecode;; p += tchecker::instruction_size(p)) {
+    std::size_t const size = tchecker::instruction_size(p);
+    bool const jump = (*p == VM_JMP || *p == VM_JMPZ);
+    decoded.push_back({p, *p, (size > 1 ? p[1] : 0), (size > 2 ? p[2] : 0), (jump ? p + 2 + p[1] : nullptr)});
+    if (jump)
+      last_target = std::max(last_target, decoded.back().target); // jumps are relative to the next instruction
+    if (*p == VM_RET && p >= last_target)
+      break;
+  }
+  return decoded;
+}
+
+/*!
+ \brief Check that a bytecode constant is a tchecker::integer_t
+ \param v : constant
+ \return true if v can be represented by tchecker::integer_t, false otherwise
+ */
+static inline bool native_fits(tchecker::bytecode_t v)
+{
+  return (v >= std::numeric_limits<tchecker::integer_t>::min()) && (v <= std::numeric_limits<tchecker::integer_t>::max());
+}
+
+/*!
+ \brief C++ literal
+ \param v : constant
+ \pre v can be represented by tchecker::integer_t
+ \return a C++ expression of value v
+ */
+static std::string native_literal(tchecker::bytecode_t v)
+{
+  if (v == std::numeric_limits<tchecker::integer_t>::min())
+    return "std::numeric_limits<tchecker::integer_t>::min()";
+  return std::to_string(v);
+}
+
+/*!
+ \brief C++ operator of a binary instruction
+ \param instruction : instruction
+ \return the C++ operator computing instruction, nullptr if instruction is not a binary operator
+ */
+static char const * native_binary_operator(tchecker::bytecode_t instruction)
+{
+  switch (instruction) {
+  case VM_LAND:
+    return "&&";
+  case VM_MINUS:
+    return "-";
+  case VM_DIV:
+    return "/";
+  case VM_EQ:
+    return "==";
+  case VM_GE:
+    return ">=";
+  case VM_GT:
+    return ">";
+  case VM_LT:
+    return "<";
+  case VM_LE:
+    return "<=";
+  case VM_MUL:
+    return "*";
+  case VM_MOD:
+    return "%";
+  case VM_NE:
+    return "!=";
+  case VM_SUM:
+    return "+";
+  default:
+    return nullptr;
+  }
+}
+
+} // end of namespace details
+
+std::uint64_t fingerprint(tchecker::bytecode_t const * bytecode, std::uint64_t seed)
+{
+  std::uint64_t hash = seed;
+  for (details::native_decoded_t const & d : details::native_decode(bytecode))
+    for (tchecker::bytecode_t const * p = d.address; p != d.address + tchecker::instruction_size(d.address); ++p) {
+      std::uint64_t word = static_cast<std::uint64_t>(*p);
+      for (unsigned int byte = 0; byte < sizeof(word); ++byte, word >>= 8) {
+        hash ^= (word & 0xff);
+        hash *= 1099511628211ULL; // FNV-1a 64-bit prime
+      }
+    }
+  return hash;
+}
+
+bool compile_native(std::ostream & os, std::string const & name, tchecker::bytecode_t const * bytecode)
+{
+  assert(bytecode != nullptr);
+
+  std::vector<details::native_decoded_t> const decoded = details::native_decode(bytecode);
+  std::size_t const n = decoded.size();
+
+  std::unordered_map<tchecker::bytecode_t const *, std::size_t> index; // address in bytecode -> instruction
+  for (std::size_t i = 0; i < n; ++i) {
+    switch (decoded[i].instruction) {
+    case VM_PUSH_FRAME:
+    case VM_POP_FRAME:
+    case VM_VALUEAT_FRAME:
+    case VM_ASSIGN_FRAME:
+    case VM_INIT_FRAME:
+      return false; // local variables are left to tchecker::vm_t
+    case VM_PUSH:
+      if (!details::native_fits(decoded[i].param1))
+        return false;
+      break;
+    case VM_FAILNOTIN:
+      if (!details::native_fits(decoded[i].param1) || !details::native_fits(decoded[i].param2))
+        return false;
+      break;
+    default:
+      break;
+    }
+    index[decoded[i].address] = i;
+  }
+
+  // Stack effect (pops, pushes) of each instruction
+  auto effect = [](tchecker::bytecode_t instruction) -> std::pair<long, long> {
+    switch (instruction) {
+    case VM_RET:
+    case VM_JMPZ:
+      return {1, 0};
+    case VM_JMP:
+    case VM_NOP:
+      return {0, 0};
+    case VM_PUSH:
+      return {0, 1};
+    case VM_ASSIGN:
+      return {2, 0};
+    case VM_CLKCONSTR:
+    case VM_CLKRESET:
+      return {3, 0};
+    case VM_RETZ:
+    case VM_FAILNOTIN:
+    case VM_VALUEAT:
+    case VM_NEG:
+    case VM_LNOT:
+      return {1, 1};
+    default:
+      return {2, 1}; // binary operators
+    }
+  };
+
+  // Depth of the operand stack before each instruction (-1 for unreachable instructions): each slot of the stack is
+  // a variable of the generated function, so the depth at an instruction must not depend on the path to it
+  std::vector<long> depth(n, -1);
+  std::vector<std::size_t> targets(n, n); // jump target of each instruction (n if not a jump)
+  std::vector<bool> is_target(n, false);  // instructions that are targets of reachable jumps
+  long max_depth = 0;
+  std::vector<std::size_t> waiting{0};
+  depth[0] = 0;
+  while (!waiting.empty()) {
+    std::size_t const i = waiting.back();
+    waiting.pop_back();
+    details::native_decoded_t const & d = decoded[i];
+    auto const [pops, pushes] = effect(d.instruction);
+    if (depth[i] < pops)
+      return false;
+    long const next_depth = depth[i] - pops + pushes;
+    max_depth = std::max(max_depth, next_depth);
+
+    std::vector<std::size_t> successors;
+    if (d.instruction != VM_RET && d.instruction != VM_JMP)
+      successors.push_back(i + 1);
+    if (d.target != nullptr) {
+      auto it = index.find(d.target);
+      if (it == index.end())
+        return false;
+      targets[i] = it->second;
+      is_target[it->second] = true;
+      successors.push_back(it->second);
+    }
+
+    for (std::size_t s : successors) {
+      if (s >= n)
+        return false;
+      if (depth[s] == -1) {
+        depth[s] = next_depth;
+        waiting.push_back(s);
+      }
+      else if (depth[s] != next_depth)
+        return false;
+    }
+  }
+
+  auto slot = [](long k) { return "s" + std::to_string(k); };
+  auto label = [](std::size_t i) { return "L" + std::to_string(i); };
+
+  std::stringstream body;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (depth[i] == -1)
+      continue; // unreachable
+    details::native_decoded_t const & d = decoded[i];
+    long const k = depth[i]; // top of stack is slot k-1
+
+    if (is_target[i])
+      body << label(i) << ":\n";
+    body << "  ";
+    switch (d.instruction) {
+    case VM_RET:
+      body << "return " << slot(k - 1) << ";";
+      break;
+    case VM_RETZ:
+      body << "if (" << slot(k - 1) << " == 0) return 0;";
+      break;
+    case VM_FAILNOTIN:
+      body << "tchecker::native::failnotin(" << slot(k - 1) << ", " << details::native_literal(d.param1) << ", "
+           << details::native_literal(d.param2) << ");";
+      break;
+    case VM_JMP:
+      body << "goto " << label(targets[i]) << ";";
+      break;
+    case VM_JMPZ:
+      body << "if (" << slot(k - 1) << " == 0) goto " << label(targets[i]) << ";";
+      break;
+    case VM_PUSH:
+      body << slot(k) << " = " << details::native_literal(d.param1) << ";";
+      break;
+    case VM_VALUEAT:
+      body << slot(k - 1) << " = intval[tchecker::native::address(" << slot(k - 1) << ")];";
+      break;
+    case VM_ASSIGN:
+      body << "intval[tchecker::native::address(" << slot(k - 2) << ")] = " << slot(k - 1) << ";";
+      break;
+    case VM_NEG:
+      body << slot(k - 1) << " = static_cast<tchecker::integer_t>(-" << slot(k - 1) << ");";
+      break;
+    case VM_LNOT:
+      body << slot(k - 1) << " = static_cast<tchecker::integer_t>(!" << slot(k - 1) << ");";
+      break;
+    case VM_CLKCONSTR:
+      body << "clkconstr.emplace_back(tchecker::native::clock(" << slot(k - 3) << "), tchecker::native::clock("
+           << slot(k - 2) << "), " << (d.param1 == 0 ? "tchecker::LT" : "tchecker::LE") << ", " << slot(k - 1)
+           << ");";
+      break;
+    case VM_CLKRESET:
+      body << "clkreset.emplace_back(tchecker::native::clock(" << slot(k - 3) << "), tchecker::native::clock("
+           << slot(k - 2) << "), " << slot(k - 1) << ");";
+      break;
+    case VM_NOP:
+      body << ";";
+      break;
+    default: {
+      char const * op = details::native_binary_operator(d.instruction);
+      if (op == nullptr)
+        return false;
+      body << slot(k - 2) << " = static_cast<tchecker::integer_t>(" << slot(k - 2) << " " << op << " " << slot(k - 1)
+           << ");";
+      break;
+    }
+    }
+    std::stringstream comment;
+    tchecker::output_instruction(comment, d.address);
+    std::string text = comment.str();
+    text.erase(text.find_last_not_of('\n') + 1);
+    body << " // " << text << "\n";
+  }
+
+  os << "static tchecker::integer_t " << name << "([[maybe_unused]] tchecker::intval_t & intval,\n"
+     << "    [[maybe_unused]] tchecker::clock_constraint_container_t & clkconstr,\n"
+     << "    [[maybe_unused]] tchecker::clock_reset_container_t & clkreset)\n";
+  os << "{\n";
+  if (max_depth > 0) {
+    os << "  tchecker::integer_t ";
+    for (long k = 0; k < max_depth; ++k)
+      os << (k == 0 ? "" : ", ") << slot(k) << " = 0";
+    os << ";\n";
+  }
+  os << body.str();
+  os << "}\n";
+  return true;
+}
+
+} // end of namespace tchecker
@@ -0,0 +1,580 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include "tchecker/vm/threaded_bytecode.hh"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TCHECKER_VM_COMPUTED_GOTO
+#endif
+
+namespace tchecker {
+
+namespace details {
+
+/*!
+ \brief Check integer type compatibility
+ \tparam T : expected integer type
+ \param v : value
+ \return true if v can be represented by type T, false otherwise
+ \note same check as tchecker::vm_t on values popped from the stack
+ */
+template <class T, class V> static inline bool fits(V v)
+{
+  static_assert(std::is_integral<T>::value, "T should be an integral type");
+  static_assert(std::is_integral<V>::value, "V should be an integral type");
+  if constexpr (std::is_signed<V>::value) {
+    if constexpr (std::is_signed<T>::value)
+      return (v >= std::numeric_limits<T>::min()) && (v <= std::numeric_limits<T>::max());
+    else
+      return (v >= 0) && (static_cast<std::uintmax_t>(v) <= std::numeric_limits<T>::max());
+  }
+  else
+    return static_cast<std::uintmax_t>(v) <= static_cast<std::uintmax_t>(std::numeric_limits<T>::max());
+}
+
+/*!
+ \brief Raise an exception for a value that cannot be represented by its expected type
+ \throw std::runtime_error
+ */
+[[noreturn]] static void value_out_of_bounds()
+{
+  throw std::runtime_error("threaded_bytecode_t::execute, value out-of-bounds");
+}
+
+/*!
+ \brief Raise an exception for a value out of an interval
+ \param value : value
+ \param l : lower bound
+ \param h : upper bound
+ \throw std::out_of_range : same exception as tchecker::vm_t for instruction VM_FAILNOTIN
+ */
+[[noreturn]] static void failnotin(tchecker::integer_t value, tchecker::integer_t l, tchecker::integer_t h)
+{
+  std::stringstream ss;
+  ss << value << " out of [" << l << ", " << h << "]";
+  throw std::out_of_range("out-of-bounds value: " + ss.str());
+}
+
+} // end of namespace details
+
+/* threaded_bytecode_t */
+
+threaded_bytecode_t::threaded_bytecode_t(tchecker::bytecode_t const * bytecode) : _bytecode(bytecode)
+{
+  assert(_bytecode != nullptr);
+  translate();
+}
+
+void threaded_bytecode_t::translate()
+{
+  using capacity_t = tchecker::intval_t::capacity_t;
+
+  // Decoding: instructions of _bytecode with their parameters and jump targets
+  struct decoded_t {
+    tchecker::bytecode_t const * address;
+    tchecker::bytecode_t instruction;
+    tchecker::bytecode_t param1;
+    tchecker::bytecode_t param2;
+    tchecker::bytecode_t const * target; // jump target (nullptr if not a jump)
+  };
+
+  std::vector<decoded_t> decoded;
+  std::vector<tchecker::bytecode_t const *> jump_targets;
+  tchecker::bytecode_t const * last_target = _bytecode; // decoding stops at the first VM_RET after all jump targets
+  for (tchecker::bytecode_t const * p = _bytecode;; p += tchecker::instruction_size(p)) {
+    switch (*p) {
+    case VM_PUSH_FRAME:
+    case VM_POP_FRAME:
+    case VM_VALUEAT_FRAME:
+    case VM_ASSIGN_FRAME:
+    case VM_INIT_FRAME:
+      return; // local variables are left to tchecker::vm_t
+    case VM_PUSH:
+      if (!details::fits<tchecker::integer_t>(p[1]))
+        return;
+      break;
+    case VM_FAILNOTIN:
+      if (!details::fits<tchecker::integer_t>(p[1]) || !details::fits<tchecker::integer_t>(p[2]))
+        return;
+      break;
+    default:
+      break;
+    }
+    std::size_t const size = tchecker::instruction_size(p);
+    bool const jump = (*p == VM_JMP || *p == VM_JMPZ);
+    decoded.push_back({p, *p, (size > 1 ? p[1] : 0), (size > 2 ? p[2] : 0), (jump ? p + 2 + p[1] : nullptr)});
+    if (jump) {
+      jump_targets.push_back(decoded.back().target); // jumps are relative to the next instruction
+      last_target = std::max(last_target, decoded.back().target);
+    }
+    if (*p == VM_RET && p >= last_target)
+      break;
+  }
+
+  auto is_target = [&](tchecker::bytecode_t const * address) {
+    return std::find(jump_targets.begin(), jump_targets.end(), address) != jump_targets.end();
+  };
+
+  // Constant folding: PUSH c; NEG is PUSH -c, and PUSH c; JMPZ is either a JMP (c == 0) or nothing (c != 0)
+  // (e.g. the value of a clock constraint in a conjunction). Removed instructions are not jump targets
+  std::vector<decoded_t> folded;
+  for (decoded_t const & d : decoded) {
+    if (!folded.empty() && folded.back().instruction == VM_PUSH && !is_target(d.address)) {
+      decoded_t & push = folded.back();
+      if (d.instruction == VM_NEG && details::fits<tchecker::integer_t>(-push.param1)) {
+        push.param1 = -push.param1;
+        continue;
+      }
+      if (d.instruction == VM_JMPZ && push.param1 == 0) {
+        push.instruction = VM_JMP;
+        push.target = d.target;
+        continue;
+      }
+      if (d.instruction == VM_JMPZ && !is_target(push.address)) {
+        folded.pop_back();
+        continue;
+      }
+    }
+    folded.push_back(d);
+  }
+
+  // matches folded[i..] against a sequence of instructions that are not jump targets (except the first one)
+  auto matches = [&](std::size_t i, std::initializer_list<tchecker::bytecode_t> sequence) {
+    if (i + sequence.size() > folded.size())
+      return false;
+    std::size_t k = i;
+    for (tchecker::bytecode_t instruction : sequence) {
+      if (folded[k].instruction != instruction || (k != i && is_target(folded[k].address)))
+        return false;
+      ++k;
+    }
+    return true;
+  };
+
+  auto load_cmp_opcode = [](tchecker::bytecode_t instruction) {
+    switch (instruction) {
+    case VM_EQ:
+      return OP_LOAD_EQ_CONST;
+    case VM_NE:
+      return OP_LOAD_NE_CONST;
+    case VM_LT:
+      return OP_LOAD_LT_CONST;
+    case VM_LE:
+      return OP_LOAD_LE_CONST;
+    case VM_GT:
+      return OP_LOAD_GT_CONST;
+    case VM_GE:
+      return OP_LOAD_GE_CONST;
+    default:
+      return OP_COUNT;
+    }
+  };
+
+  auto constant = [](decoded_t const & d) { return static_cast<tchecker::integer_t>(d.param1); };
+
+  // Translation: superinstructions are only built from constants that tchecker::vm_t accepts, other constants are
+  // left to instructions that check them at runtime
+  std::vector<instruction_t> instructions;
+  std::vector<tchecker::bytecode_t const *> targets;                   // jump target of each instruction
+  std::unordered_map<tchecker::bytecode_t const *, std::size_t> index; // address in _bytecode -> instruction
+  std::size_t i = 0;
+  while (i < folded.size()) {
+    decoded_t const & d = folded[i];
+    index[d.address] = instructions.size();
+    targets.push_back(d.target);
+
+    // PUSH a; VALUEAT (; PUSH b; cmp)
+    if (matches(i, {VM_PUSH, VM_VALUEAT}) && details::fits<capacity_t>(d.param1)) {
+      if (i + 3 < folded.size() && matches(i, {VM_PUSH, VM_VALUEAT, VM_PUSH, folded[i + 3].instruction}) &&
+          load_cmp_opcode(folded[i + 3].instruction) != OP_COUNT) {
+        instructions.push_back({load_cmp_opcode(folded[i + 3].instruction), 0, constant(d), constant(folded[i + 2]), 0});
+        i += 4;
+      }
+      else {
+        instructions.push_back({OP_LOAD, 0, constant(d), 0, 0});
+        i += 2;
+      }
+      continue;
+    }
+
+    // PUSH a; PUSH b; FAILNOTIN l h; ASSIGN
+    if (matches(i, {VM_PUSH, VM_PUSH, VM_FAILNOTIN, VM_ASSIGN}) && details::fits<capacity_t>(d.param1) &&
+        folded[i + 2].param1 <= folded[i + 1].param1 && folded[i + 1].param1 <= folded[i + 2].param2) {
+      instructions.push_back({OP_ASSIGN_CONST, 0, constant(d), constant(folded[i + 1]), 0});
+      i += 4;
+      continue;
+    }
+
+    // PUSH a; PUSH b; PUSH c; CLKCONSTR / CLKRESET
+    if ((matches(i, {VM_PUSH, VM_PUSH, VM_PUSH, VM_CLKCONSTR}) || matches(i, {VM_PUSH, VM_PUSH, VM_PUSH, VM_CLKRESET})) &&
+        details::fits<tchecker::clock_id_t>(d.param1) && details::fits<tchecker::clock_id_t>(folded[i + 1].param1)) {
+      bool const constr = (folded[i + 3].instruction == VM_CLKCONSTR);
+      instructions.push_back({(constr ? OP_CLKCONSTR_CONST : OP_CLKRESET_CONST), (constr && folded[i + 3].param1 != 0 ? 1u : 0u),
+                              constant(d), constant(folded[i + 1]), constant(folded[i + 2])});
+      i += 4;
+      continue;
+    }
+
+    // other instructions are translated one-to-one (frame instructions have been excluded)
+    instruction_t instruction{(d.instruction == VM_NOP ? OP_NOP : static_cast<enum opcode_t>(d.instruction)), 0, 0, 0, 0};
+    switch (d.instruction) {
+    case VM_PUSH:
+      instruction.a = constant(d);
+      break;
+    case VM_FAILNOTIN:
+      instruction.a = static_cast<tchecker::integer_t>(d.param1);
+      instruction.b = static_cast<tchecker::integer_t>(d.param2);
+      break;
+    case VM_CLKCONSTR:
+      instruction.flag = (d.param1 != 0 ? 1 : 0);
+      break;
+    default:
+      break;
+    }
+    instructions.push_back(instruction);
+    ++i;
+  }
+
+  // Jump targets resolution, and jumps to OP_RET replaced by OP_RET
+  for (std::size_t k = 0; k < instructions.size(); ++k) {
+    if (instructions[k].op != OP_JMP && instructions[k].op != OP_JMPZ)
+      continue;
+    auto it = index.find(targets[k]);
+    if (it == index.end() || !details::fits<tchecker::integer_t>(it->second))
+      return;
+    instructions[k].a = static_cast<tchecker::integer_t>(it->second);
+    if (instructions[k].op == OP_JMP && instructions[it->second].op == OP_RET)
+      instructions[k].op = OP_RET;
+  }
+
+  // Operand stack size: the code produced by tchecker::compile() is structured (conditionals and loops), hence
+  // the depth of the stack along the sequence of instructions is an upper bound of its depth at runtime
+  static_assert(static_cast<int>(OP_CLKRESET) == static_cast<int>(VM_CLKRESET), "opcodes should extend tchecker::instruction_t");
+  std::ptrdiff_t depth = 0, max_depth = 0;
+  for (instruction_t const & instruction : instructions) {
+    std::ptrdiff_t pop = 0, push = 0;
+    switch (instruction.op) {
+    case OP_PUSH:
+    case OP_LOAD:
+    case OP_LOAD_EQ_CONST:
+    case OP_LOAD_NE_CONST:
+    case OP_LOAD_LT_CONST:
+    case OP_LOAD_LE_CONST:
+    case OP_LOAD_GT_CONST:
+    case OP_LOAD_GE_CONST:
+      push = 1;
+      break;
+    case OP_RET:
+    case OP_RETZ:
+    case OP_FAILNOTIN:
+    case OP_VALUEAT:
+    case OP_NEG:
+    case OP_LNOT:
+      pop = push = 1;
+      break;
+    case OP_JMPZ:
+      pop = 1;
+      break;
+    case OP_LAND:
+    case OP_MINUS:
+    case OP_DIV:
+    case OP_EQ:
+    case OP_GE:
+    case OP_GT:
+    case OP_LT:
+    case OP_LE:
+    case OP_MUL:
+    case OP_MOD:
+    case OP_NE:
+    case OP_SUM:
+      pop = 2;
+      push = 1;
+      break;
+    case OP_ASSIGN:
+      pop = 2;
+      break;
+    case OP_CLKCONSTR:
+    case OP_CLKRESET:
+      pop = 3;
+      break;
+    default:
+      break;
+    }
+    if (depth < pop)
+      return;
+    depth += push - pop;
+    max_depth = std::max(max_depth, depth);
+  }
+
+  _instructions = std::move(instructions);
+  _stack.resize(static_cast<std::size_t>(max_depth) + 1);
+}
+
+tchecker::integer_t threaded_bytecode_t::execute(tchecker::intval_t & intval,
+                                                 tchecker::clock_constraint_container_t & clkconstr,
+                                                 tchecker::clock_reset_container_t & clkreset)
+{
+  using capacity_t = tchecker::intval_t::capacity_t;
+
+  instruction_t const * const code = _instructions.data();
+  instruction_t const * ip = code;
+  tchecker::integer_t * sp = _stack.data(); // top value is sp[-1]
+
+#if defined(TCHECKER_VM_COMPUTED_GOTO)
+  static void * const dispatch_table[] = {
+      &&L_OP_RET,           &&L_OP_RETZ,           &&L_OP_FAILNOTIN,      &&L_OP_JMP,          &&L_OP_JMPZ,
+      &&L_OP_PUSH,          &&L_OP_VALUEAT,        &&L_OP_ASSIGN,         &&L_OP_LAND,         &&L_OP_MINUS,
+      &&L_OP_DIV,           &&L_OP_EQ,             &&L_OP_GE,             &&L_OP_GT,           &&L_OP_LT,
+      &&L_OP_LE,            &&L_OP_MUL,            &&L_OP_MOD,            &&L_OP_NE,           &&L_OP_SUM,
+      &&L_OP_NEG,           &&L_OP_LNOT,           &&L_OP_CLKCONSTR,      &&L_OP_CLKRESET,     &&L_OP_NOP,
+      &&L_OP_LOAD,          &&L_OP_LOAD_EQ_CONST,  &&L_OP_LOAD_NE_CONST,  &&L_OP_LOAD_LT_CONST, &&L_OP_LOAD_LE_CONST,
+      &&L_OP_LOAD_GT_CONST, &&L_OP_LOAD_GE_CONST,  &&L_OP_ASSIGN_CONST,   &&L_OP_CLKCONSTR_CONST, &&L_OP_CLKRESET_CONST,
+  };
+  static_assert(sizeof(dispatch_table) / sizeof(*dispatch_table) == OP_COUNT, "missing opcodes in dispatch table");
+
+#define TCK_INSTRUCTION(opcode) L_##opcode:
+#define TCK_DISPATCH() goto * dispatch_table[ip->op]
+#else
+#define TCK_INSTRUCTION(opcode) case opcode:
+#define TCK_DISPATCH() goto dispatch
+#endif
+#define TCK_NEXT()                                                                                                           \
+  do {                                                                                                                       \
+    ++ip;                                                                                                                    \
+    TCK_DISPATCH();                                                                                                          \
+  } while (0)
+#define TCK_BINARY(opcode, op)                                                                                               \
+  TCK_INSTRUCTION(opcode)                                                                                                    \
+  {                                                                                                                          \
+    tchecker::integer_t const right = *--sp;                                                                                 \
+    sp[-1] = static_cast<tchecker::integer_t>(sp[-1] op right);                                                              \
+    TCK_NEXT();                                                                                                              \
+  }
+#define TCK_LOAD_CMP(opcode, op)                                                                                             \
+  TCK_INSTRUCTION(opcode)                                                                                                    \
+  {                                                                                                                          \
+    assert(static_cast<capacity_t>(ip->a) < intval.size());                                                                  \
+    *sp++ = (intval[static_cast<capacity_t>(ip->a)] op ip->b);                                                               \
+    TCK_NEXT();                                                                                                              \
+  }
+
+#if defined(TCHECKER_VM_COMPUTED_GOTO)
+  TCK_DISPATCH();
+#else
+dispatch:
+  switch (ip->op) {
+#endif
+
+  TCK_INSTRUCTION(OP_RET) { return sp[-1]; }
+
+  TCK_INSTRUCTION(OP_RETZ)
+  {
+    if (sp[-1] == 0)
+      return 0;
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_FAILNOTIN)
+  {
+    if (sp[-1] < ip->a || sp[-1] > ip->b)
+      details::failnotin(sp[-1], ip->a, ip->b);
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_JMP)
+  {
+    ip = code + ip->a;
+    TCK_DISPATCH();
+  }
+
+  TCK_INSTRUCTION(OP_JMPZ)
+  {
+    if (*--sp == 0) {
+      ip = code + ip->a;
+      TCK_DISPATCH();
+    }
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_PUSH)
+  {
+    *sp++ = ip->a;
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_VALUEAT)
+  {
+    if (!details::fits<capacity_t>(sp[-1]))
+      details::value_out_of_bounds();
+    assert(static_cast<capacity_t>(sp[-1]) < intval.size());
+    sp[-1] = intval[static_cast<capacity_t>(sp[-1])];
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_ASSIGN)
+  {
+    tchecker::integer_t const value = *--sp;
+    tchecker::integer_t const id = *--sp;
+    if (!details::fits<capacity_t>(id))
+      details::value_out_of_bounds();
+    assert(static_cast<capacity_t>(id) < intval.size());
+    intval[static_cast<capacity_t>(id)] = value;
+    TCK_NEXT();
+  }
+
+  TCK_BINARY(OP_LAND, &&)
+  TCK_BINARY(OP_MINUS, -)
+  TCK_BINARY(OP_DIV, /)
+  TCK_BINARY(OP_EQ, ==)
+  TCK_BINARY(OP_GE, >=)
+  TCK_BINARY(OP_GT, >)
+  TCK_BINARY(OP_LT, <)
+  TCK_BINARY(OP_LE, <=)
+  TCK_BINARY(OP_MUL, *)
+  TCK_BINARY(OP_MOD, %)
+  TCK_BINARY(OP_NE, !=)
+  TCK_BINARY(OP_SUM, +)
+
+  TCK_INSTRUCTION(OP_NEG)
+  {
+    sp[-1] = static_cast<tchecker::integer_t>(-sp[-1]);
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_LNOT)
+  {
+    sp[-1] = !sp[-1];
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_CLKCONSTR)
+  {
+    sp -= 3;
+    if (!details::fits<tchecker::clock_id_t>(sp[0]) || !details::fits<tchecker::clock_id_t>(sp[1]))
+      details::value_out_of_bounds();
+    clkconstr.emplace_back(static_cast<tchecker::clock_id_t>(sp[0]), static_cast<tchecker::clock_id_t>(sp[1]),
+                           (ip->flag == 0 ? tchecker::LT : tchecker::LE), sp[2]);
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_CLKRESET)
+  {
+    sp -= 3;
+    if (!details::fits<tchecker::clock_id_t>(sp[0]) || !details::fits<tchecker::clock_id_t>(sp[1]))
+      details::value_out_of_bounds();
+    clkreset.emplace_back(static_cast<tchecker::clock_id_t>(sp[0]), static_cast<tchecker::clock_id_t>(sp[1]), sp[2]);
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_NOP) { TCK_NEXT(); }
+
+  TCK_INSTRUCTION(OP_LOAD)
+  {
+    assert(static_cast<capacity_t>(ip->a) < intval.size());
+    *sp++ = intval[static_cast<capacity_t>(ip->a)];
+    TCK_NEXT();
+  }
+
+  TCK_LOAD_CMP(OP_LOAD_EQ_CONST, ==)
+  TCK_LOAD_CMP(OP_LOAD_NE_CONST, !=)
+  TCK_LOAD_CMP(OP_LOAD_LT_CONST, <)
+  TCK_LOAD_CMP(OP_LOAD_LE_CONST, <=)
+  TCK_LOAD_CMP(OP_LOAD_GT_CONST, >)
+  TCK_LOAD_CMP(OP_LOAD_GE_CONST, >=)
+
+  TCK_INSTRUCTION(OP_ASSIGN_CONST)
+  {
+    assert(static_cast<capacity_t>(ip->a) < intval.size());
+    intval[static_cast<capacity_t>(ip->a)] = ip->b;
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_CLKCONSTR_CONST)
+  {
+    clkconstr.emplace_back(static_cast<tchecker::clock_id_t>(ip->a), static_cast<tchecker::clock_id_t>(ip->b),
+                           (ip->flag == 0 ? tchecker::LT : tchecker::LE), ip->c);
+    TCK_NEXT();
+  }
+
+  TCK_INSTRUCTION(OP_CLKRESET_CONST)
+  {
+    clkreset.emplace_back(static_cast<tchecker::clock_id_t>(ip->a), static_cast<tchecker::clock_id_t>(ip->b), ip->c);
+    TCK_NEXT();
+  }
+
+#if !defined(TCHECKER_VM_COMPUTED_GOTO)
+  TCK_INSTRUCTION(OP_COUNT) { break; }
+  }
+#endif
+
+#undef TCK_LOAD_CMP
+#undef TCK_BINARY
+#undef TCK_NEXT
+#undef TCK_DISPATCH
+#undef TCK_INSTRUCTION
+
+  // should never be reached
+  throw std::runtime_error("threaded_bytecode_t::execute, invalid opcode");
+}
+
+std::ostream & threaded_bytecode_t::output(std::ostream & os) const
+{
+  static char const * const names[] = {
+      "RET",        "RETZ",         "FAILNOTIN",    "JMP",          "JMPZ",         "PUSH",         "VALUEAT",
+      "ASSIGN",     "LAND",         "MINUS",        "DIV",          "EQ",           "GE",           "GT",
+      "LT",         "LE",           "MUL",          "MOD",          "NE",           "SUM",          "NEG",
+      "LNOT",       "CLKCONSTR",    "CLKRESET",     "NOP",          "LOAD",         "LOAD_EQ_CONST", "LOAD_NE_CONST",
+      "LOAD_LT_CONST", "LOAD_LE_CONST", "LOAD_GT_CONST", "LOAD_GE_CONST", "ASSIGN_CONST", "CLKCONSTR_CONST", "CLKRESET_CONST",
+  };
+  static_assert(sizeof(names) / sizeof(*names) == OP_COUNT, "missing opcodes in names");
+
+  for (instruction_t const & instruction : _instructions) {
+    os << names[instruction.op];
+    switch (instruction.op) {
+    case OP_PUSH:
+    case OP_JMP:
+    case OP_JMPZ:
+    case OP_LOAD:
+      os << " " << instruction.a;
+      break;
+    case OP_CLKCONSTR:
+      os << " " << instruction.flag;
+      break;
+    case OP_FAILNOTIN:
+    case OP_LOAD_EQ_CONST:
+    case OP_LOAD_NE_CONST:
+    case OP_LOAD_LT_CONST:
+    case OP_LOAD_LE_CONST:
+    case OP_LOAD_GT_CONST:
+    case OP_LOAD_GE_CONST:
+    case OP_ASSIGN_CONST:
+      os << " " << instruction.a << " " << instruction.b;
+      break;
+    case OP_CLKCONSTR_CONST:
+      os << " " << instruction.a << " " << instruction.b << " " << instruction.c << " " << instruction.flag;
+      break;
+    case OP_CLKRESET_CONST:
+      os << " " << instruction.a << " " << instruction.b << " " << instruction.c;
+      break;
+    default:
+      break;
+    }
+    os << std::endl;
+  }
+  return os;
+}
+
+} // end of namespace tchecker
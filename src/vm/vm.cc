@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -162,4 +163,82 @@ size_t output_instruction(std::ostream & os, tchecker::bytecode_t const * byteco
   return res;
 }
 
+std::size_t instruction_size(tchecker::bytecode_t const * bytecode)
+{
+  switch (*bytecode) {
+  case VM_FAILNOTIN:
+    return 3;
+  case VM_JMP:
+  case VM_JMPZ:
+  case VM_PUSH:
+  case VM_CLKCONSTR:
+    return 2;
+  case VM_RET:
+  case VM_RETZ:
+  case VM_VALUEAT:
+  case VM_ASSIGN:
+  case VM_LAND:
+  case VM_MINUS:
+  case VM_DIV:
+  case VM_EQ:
+  case VM_GE:
+  case VM_GT:
+  case VM_LT:
+  case VM_LE:
+  case VM_MUL:
+  case VM_MOD:
+  case VM_NE:
+  case VM_SUM:
+  case VM_NEG:
+  case VM_LNOT:
+  case VM_CLKRESET:
+  case VM_NOP:
+  case VM_PUSH_FRAME:
+  case VM_POP_FRAME:
+  case VM_VALUEAT_FRAME:
+  case VM_INIT_FRAME:
+  case VM_ASSIGN_FRAME:
+    return 1;
+  default:
+    throw std::runtime_error("incomplete switch statement");
+  }
+}
+
+bool read_intvars(tchecker::bytecode_t const * bytecode, std::vector<tchecker::intvar_id_t> & intvars)
+{
+  intvars.clear();
+  std::vector<tchecker::bytecode_t const *> reads, jump_targets;
+  tchecker::bytecode_t const * previous = nullptr;
+  while (*bytecode != VM_RET) {
+    if (*bytecode == VM_ASSIGN)
+      return false;
+    if (*bytecode == VM_VALUEAT) {
+      // the address must have been pushed by the previous instruction
+      if (previous == nullptr || *previous != VM_PUSH)
+        return false;
+      intvars.push_back(static_cast<tchecker::intvar_id_t>(previous[1]));
+      reads.push_back(bytecode);
+    }
+    else if (*bytecode == VM_JMP || *bytecode == VM_JMPZ)
+      jump_targets.push_back(bytecode + 2 + bytecode[1]); // jumps are relative to the next instruction
+    previous = bytecode;
+    bytecode += tchecker::instruction_size(bytecode);
+  }
+
+  // the previous instruction is not the one that pushed the address if some jump lands on VM_VALUEAT
+  for (tchecker::bytecode_t const * target : jump_targets)
+    if (std::find(reads.begin(), reads.end(), target) != reads.end())
+      return false;
+
+  std::sort(intvars.begin(), intvars.end());
+  intvars.erase(std::unique(intvars.begin(), intvars.end()), intvars.end());
+  return true;
+}
+
+bool intval_independent(tchecker::bytecode_t const * bytecode)
+{
+  std::vector<tchecker::intvar_id_t> intvars;
+  return tchecker::read_intvars(bytecode, intvars) && intvars.empty();
+}
+
 } // end of namespace tchecker
@@ -6,6 +6,7 @@
  */
 
 #include <iostream>
+#include <stdexcept>
 
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/ta/static_analysis.hh"
@@ -37,7 +38,7 @@ global_lu_extrapolation_t::global_lu_extrapolation_t(
 void global_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  tchecker::dbm::extra_lu(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
+  _kernels->extra_lu(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
 }
 
 /* global_extra_lu_plus_t */
@@ -45,7 +46,7 @@ void global_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_i
 void global_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  tchecker::dbm::extra_lu_plus(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
+  _kernels->extra_lu_plus(dbm, dim, _clock_bounds->L().ptr(), _clock_bounds->U().ptr());
 }
 
 /* local_lu_extrapolation_t */
@@ -61,14 +62,14 @@ local_lu_extrapolation_t::local_lu_extrapolation_t(
 }
 
 local_lu_extrapolation_t::local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e)
-    : _clock_bounds(e._clock_bounds)
+    : tchecker::zg::extrapolation_t(e), _clock_bounds(e._clock_bounds)
 {
   _l = tchecker::clockbounds::clone_map(*e._l);
   _u = tchecker::clockbounds::clone_map(*e._u);
 }
 
 local_lu_extrapolation_t::local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e)
-    : _l(std::move(e._l)), _u(std::move(e._u)), _clock_bounds(std::move(e._clock_bounds))
+    : tchecker::zg::extrapolation_t(e), _l(std::move(e._l)), _u(std::move(e._u)), _clock_bounds(std::move(e._clock_bounds))
 {
   e._l = nullptr;
   e._u = nullptr;
@@ -84,6 +85,7 @@ tchecker::zg::details::local_lu_extrapolation_t &
 local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolation_t const & e)
 {
   if (this != &e) {
+    tchecker::zg::extrapolation_t::operator=(e);
     _clock_bounds = e._clock_bounds;
     tchecker::clockbounds::deallocate_map(_l);
     _l = tchecker::clockbounds::clone_map(*e._l);
@@ -97,6 +99,7 @@ tchecker::zg::details::local_lu_extrapolation_t &
 local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolation_t && e)
 {
   if (this != &e) {
+    tchecker::zg::extrapolation_t::operator=(e);
     _clock_bounds = std::move(e._clock_bounds);
     _l = std::move(e._l);
     _u = std::move(e._u);
@@ -114,7 +117,7 @@ void local_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id
 {
   assert(dim == _clock_bounds->clock_number() + 1);
   _clock_bounds->bounds(vloc, *_l, *_u);
-  tchecker::dbm::extra_lu(dbm, dim, _l->ptr(), _u->ptr());
+  _kernels->extra_lu(dbm, dim, _l->ptr(), _u->ptr());
 }
 
 /* local_extra_lu_plus_t */
@@ -123,7 +126,25 @@ void local_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clo
 {
   assert(dim == _clock_bounds->clock_number() + 1);
   _clock_bounds->bounds(vloc, *_l, *_u);
-  tchecker::dbm::extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr());
+  _kernels->extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr());
+}
+
+/* local_extra_lu_plus_df_t */
+
+local_extra_lu_plus_df_t::local_extra_lu_plus_df_t(
+    std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds,
+    boost::dynamic_bitset<> const & diagonal_clocks)
+    : tchecker::zg::details::local_lu_extrapolation_t(clock_bounds), _diagonal_clocks(diagonal_clocks)
+{
+  if (_diagonal_clocks.size() != _clock_bounds->clock_number())
+    throw std::invalid_argument("local_extra_lu_plus_df_t: diagonal clocks do not match clock bounds");
+}
+
+void local_extra_lu_plus_df_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
+{
+  assert(dim == _clock_bounds->clock_number() + 1);
+  _clock_bounds->bounds(vloc, *_l, *_u);
+  tchecker::dbm::extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr(), _diagonal_clocks);
 }
 
 /* global_m_extrapolation_t */
@@ -143,7 +164,7 @@ global_m_extrapolation_t::global_m_extrapolation_t(
 void global_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  tchecker::dbm::extra_m(dbm, dim, _clock_bounds->M().ptr());
+  _kernels->extra_m(dbm, dim, _clock_bounds->M().ptr());
 }
 
 /* global_extra_m_plus_t */
@@ -151,7 +172,7 @@ void global_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id
 void global_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  tchecker::dbm::extra_m_plus(dbm, dim, _clock_bounds->M().ptr());
+  _kernels->extra_m_plus(dbm, dim, _clock_bounds->M().ptr());
 }
 
 /* local_m_extrapolation_t */
@@ -166,13 +187,13 @@ local_m_extrapolation_t::local_m_extrapolation_t(
 }
 
 local_m_extrapolation_t::local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e)
-    : _m(nullptr), _clock_bounds(e._clock_bounds)
+    : tchecker::zg::extrapolation_t(e), _m(nullptr), _clock_bounds(e._clock_bounds)
 {
   _m = tchecker::clockbounds::clone_map(*e._m);
 }
 
 local_m_extrapolation_t::local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e)
-    : _m(std::move(e._m)), _clock_bounds(std::move(e._clock_bounds))
+    : tchecker::zg::extrapolation_t(e), _m(std::move(e._m)), _clock_bounds(std::move(e._clock_bounds))
 {
   e._m = nullptr;
 }
@@ -183,6 +204,7 @@ tchecker::zg::details::local_m_extrapolation_t &
 local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_t const & e)
 {
   if (this != &e) {
+    tchecker::zg::extrapolation_t::operator=(e);
     tchecker::clockbounds::deallocate_map(_m);
     _m = tchecker::clockbounds::clone_map(*e._m);
     _clock_bounds = e._clock_bounds;
@@ -194,6 +216,7 @@ tchecker::zg::details::local_m_extrapolation_t &
 local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_t && e)
 {
   if (this != &e) {
+    tchecker::zg::extrapolation_t::operator=(e);
     _m = std::move(e._m);
     e._m = nullptr;
     _clock_bounds = std::move(e._clock_bounds);
@@ -209,7 +232,7 @@ void local_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_
 {
   assert(dim == _clock_bounds->clock_number() + 1);
   _clock_bounds->bounds(vloc, *_m);
-  tchecker::dbm::extra_m(dbm, dim, _m->ptr());
+  _kernels->extra_m(dbm, dim, _m->ptr());
 }
 
 /* local_extra_m_plus_t */
@@ -218,7 +241,7 @@ void local_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::cloc
 {
   assert(dim == _clock_bounds->clock_number() + 1);
   _clock_bounds->bounds(vloc, *_m);
-  tchecker::dbm::extra_m_plus(dbm, dim, _m->ptr());
+  _kernels->extra_m_plus(dbm, dim, _m->ptr());
 }
 
 /* factories */
@@ -229,16 +252,35 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
   if (extrapolation_type == tchecker::zg::NO_EXTRAPOLATION)
     return new tchecker::zg::no_extrapolation_t;
 
-    // 检测 diagonal 约束，打印 warning 并改用 `no_extrapolation_t`
-  if (tchecker::ta::has_diagonal_constraint(system)) {
+  // 检测 diagonal 约束：LU+ 局部外推只作用于 diagonal-free 时钟，其它外推打印 warning 并改用 `no_extrapolation_t`
+  bool const diagonal = tchecker::ta::has_diagonal_constraint(system);
+  if (diagonal && (extrapolation_type != tchecker::zg::EXTRA_LU_PLUS_LOCAL) &&
+      (extrapolation_type != tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF)) {
     std::cerr << tchecker::log_warning << "diagonal clock constraints detected: forcing NO_EXTRAPOLATION" << std::endl;
     return new tchecker::zg::no_extrapolation_t;
   }
+  if (diagonal && (extrapolation_type == tchecker::zg::EXTRA_LU_PLUS_LOCAL))
+    std::cerr << tchecker::log_warning << "diagonal clock constraints detected: only diagonal-free clocks are extrapolated"
+              << std::endl;
+
+  if (diagonal) {
+    std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds;
+    try {
+      clock_bounds.reset(tchecker::clockbounds::compute_clockbounds(system));
+    }
+    catch (std::runtime_error const & e) {
+      std::cerr << tchecker::log_warning << e.what() << ": forcing NO_EXTRAPOLATION" << std::endl;
+      return new tchecker::zg::no_extrapolation_t;
+    }
+    return new tchecker::zg::local_extra_lu_plus_df_t{clock_bounds->local_lu_map(), tchecker::ta::diagonal_clocks(system)};
+  }
 
   std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(system)};
   if (clock_bounds.get() == nullptr)
     return nullptr;
 
+  if (extrapolation_type == tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF)
+    return tchecker::zg::extrapolation_factory(tchecker::zg::EXTRA_LU_PLUS_LOCAL, *clock_bounds);
   return tchecker::zg::extrapolation_factory(extrapolation_type, *clock_bounds);
 }
 
@@ -264,6 +306,8 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
     return new tchecker::zg::global_extra_m_plus_t{clock_bounds.global_m_map()};
   case tchecker::zg::EXTRA_M_PLUS_LOCAL:
     return new tchecker::zg::local_extra_m_plus_t{clock_bounds.local_m_map()};
+  case tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF:
+    throw std::invalid_argument("ExtraLU+ on diagonal-free clocks requires a system");
   default:
     throw std::invalid_argument("Unknown zone extrapolation");
   }
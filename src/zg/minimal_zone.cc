@@ -0,0 +1,159 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/minimal_zone.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+#define DBM(i, j) dbm[(i)*dim + (j)]
+
+/* minimal_zone_t */
+
+bool minimal_zone_t::contains(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim) const
+{
+  assert(dim == _dim);
+  if (tchecker::dbm::is_empty_0(dbm, dim))
+    return true;
+  if (_empty)
+    return false;
+  // dbm is tight, so it satisfies a constraint iff its bound is at least as strong
+  for (tchecker::zg::minimal_edge_t const & e : *this)
+    if (e.db < DBM(e.x, e.y))
+      return false;
+  return true;
+}
+
+bool minimal_zone_t::contains(tchecker::zg::zone_t const & zone) const
+{
+  if (zone.is_empty())
+    return true;
+  return contains(zone.dbm(), static_cast<tchecker::clock_id_t>(zone.dim()));
+}
+
+void minimal_zone_t::to_dbm(tchecker::dbm::db_t * dbm) const
+{
+  tchecker::clock_id_t const dim = _dim;
+  if (_empty) {
+    tchecker::dbm::empty(dbm, dim);
+    return;
+  }
+  tchecker::dbm::universal(dbm, dim);
+  for (tchecker::zg::minimal_edge_t const & e : *this)
+    DBM(e.x, e.y) = e.db;
+  enum tchecker::dbm::status_t status = tchecker::dbm::tighten(dbm, dim);
+  assert(status == tchecker::dbm::NON_EMPTY);
+  (void)status;
+}
+
+void minimal_zone_t::to_zone(tchecker::zg::zone_t & zone) const
+{
+  if (zone.dim() != _dim)
+    throw std::invalid_argument("Zone dimension mismatch");
+  to_dbm(zone.dbm());
+}
+
+void minimal_zone_t::construct(void * ptr, tchecker::clock_id_t dim, bool empty,
+                               tchecker::zg::minimal_edge_t const * edges, std::size_t size)
+{
+  tchecker::zg::minimal_zone_t * zone = new (ptr) tchecker::zg::minimal_zone_t(dim, empty, size);
+  if (size > 0)
+    std::memcpy(static_cast<void *>(zone + 1), edges, size * sizeof(tchecker::zg::minimal_edge_t));
+}
+
+minimal_zone_t::minimal_zone_t(tchecker::clock_id_t dim, bool empty, std::size_t size)
+    : _dim(dim), _size(static_cast<std::uint32_t>(size)), _empty(empty)
+{
+}
+
+/* minimal constraint graph */
+
+void minimal_graph(tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim,
+                   std::vector<tchecker::zg::minimal_edge_t> & edges)
+{
+  assert(dim >= 1);
+  assert(dim - 1 <= std::numeric_limits<std::uint16_t>::max());
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  assert(!tchecker::dbm::is_empty_0(dbm, dim));
+
+  edges.clear();
+
+  // Zero-cycle classes: x and y are in the same class iff x-y<=c and y-x<=-c.
+  // Each class is represented by its smallest clock and kept as a single cycle
+  std::vector<tchecker::clock_id_t> representative(dim);
+  for (tchecker::clock_id_t i = 0; i < dim; ++i)
+    representative[i] = i;
+
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if (representative[i] != i)
+      continue;
+    tchecker::clock_id_t last = i;
+    for (tchecker::clock_id_t j = i + 1; j < dim; ++j) {
+      if (representative[j] != j || tchecker::dbm::sum(DBM(i, j), DBM(j, i)) != tchecker::dbm::LE_ZERO)
+        continue;
+      representative[j] = i;
+      edges.push_back({static_cast<std::uint16_t>(last), static_cast<std::uint16_t>(j), DBM(last, j)});
+      last = j;
+    }
+    if (last != i)
+      edges.push_back({static_cast<std::uint16_t>(last), static_cast<std::uint16_t>(i), DBM(last, i)});
+  }
+
+  // Between classes: keep constraints that are not implied by a path through
+  // another class. The graph of classes has no zero cycle, hence all redundant
+  // edges can be removed at once
+  for (tchecker::clock_id_t i = 0; i < dim; ++i) {
+    if (representative[i] != i)
+      continue;
+    for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+      if (j == i || representative[j] != j || DBM(i, j) == tchecker::dbm::LT_INFINITY)
+        continue;
+      bool redundant = false;
+      for (tchecker::clock_id_t k = 0; k < dim && !redundant; ++k)
+        redundant = (k != i && k != j && representative[k] == k &&
+                     tchecker::dbm::sum(DBM(i, k), DBM(k, j)) == DBM(i, j));
+      if (!redundant)
+        edges.push_back({static_cast<std::uint16_t>(i), static_cast<std::uint16_t>(j), DBM(i, j)});
+    }
+  }
+}
+
+/* allocation and deallocation */
+
+tchecker::zg::minimal_zone_t * minimal_zone_allocate_and_construct(tchecker::zg::zone_t const & zone)
+{
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone.dim());
+  if (dim - 1 > std::numeric_limits<std::uint16_t>::max())
+    throw std::invalid_argument("Zone dimension is too large for a minimal constraint graph");
+
+  std::vector<tchecker::zg::minimal_edge_t> edges;
+  bool empty = zone.is_empty();
+  if (!empty)
+    tchecker::zg::minimal_graph(zone.dbm(), dim, edges);
+
+  void * ptr = new char[tchecker::allocation_size_t<tchecker::zg::minimal_zone_t>::alloc_size(edges.size())];
+  tchecker::zg::minimal_zone_t::construct(ptr, dim, empty, edges.data(), edges.size());
+  return reinterpret_cast<tchecker::zg::minimal_zone_t *>(ptr);
+}
+
+void minimal_zone_destruct_and_deallocate(tchecker::zg::minimal_zone_t * zone)
+{
+  tchecker::zg::minimal_zone_t::destruct(zone);
+  delete[] reinterpret_cast<char *>(zone);
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
@@ -19,7 +19,7 @@ tchecker::state_status_t standard_semantics_t::initial(tchecker::dbm::db_t * dbm
 {
   tchecker::dbm::zero(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
@@ -30,7 +30,7 @@ tchecker::state_status_t standard_semantics_t::final(tchecker::dbm::db_t * dbm,
 {
   tchecker::dbm::universal_positive(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
@@ -42,22 +42,22 @@ tchecker::state_status_t standard_semantics_t::next(tchecker::dbm::db_t * dbm, t
                                                     tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                                     tchecker::clock_constraint_container_t const & tgt_invariant)
 {
-  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   if (src_delay_allowed) {
-    tchecker::dbm::open_up(dbm, dim);
+    _kernels->open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+    if (_kernels->constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED; // should never occur
   }
 
-  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
-  tchecker::dbm::reset(dbm, dim, clkreset);
+  _kernels->reset(dbm, dim, clkreset);
 
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
@@ -71,26 +71,26 @@ tchecker::state_status_t standard_semantics_t::prev(tchecker::dbm::db_t * dbm, t
 {
   // prev(dbm) = free_clocks(dbm & tgt_invariant & constraints(clkreset), left_clocks(clkreset)) & guard & src_invariant
   // finally, if src_delay_allowed: opened down and intersected with src_invariant again
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   tchecker::clock_constraint_container_t resets_as_constraints;
   tchecker::clock_resets_to_constraints(clkreset, resets_as_constraints);
-  if (tchecker::dbm::constrain(dbm, dim, resets_as_constraints) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, resets_as_constraints) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_RESET_FAILED;
 
-  tchecker::dbm::free_clock(dbm, dim, clkreset);
+  _kernels->free_clock(dbm, dim, clkreset);
 
-  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
-  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   if (src_delay_allowed) {
-    tchecker::dbm::open_down(dbm, dim);
+    _kernels->open_down(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+    if (_kernels->constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
   }
 
@@ -104,13 +104,13 @@ tchecker::state_status_t elapsed_semantics_t::initial(tchecker::dbm::db_t * dbm,
 {
   tchecker::dbm::zero(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   if (delay_allowed) {
-    tchecker::dbm::open_up(dbm, dim);
+    _kernels->open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+    if (_kernels->constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
   }
 
@@ -122,7 +122,7 @@ tchecker::state_status_t elapsed_semantics_t::final(tchecker::dbm::db_t * dbm, t
 {
   tchecker::dbm::universal_positive(dbm, dim);
 
-  if (tchecker::dbm::constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
@@ -134,21 +134,21 @@ tchecker::state_status_t elapsed_semantics_t::next(tchecker::dbm::db_t * dbm, tc
                                                    tchecker::clock_reset_container_t const & clkreset, bool tgt_delay_allowed,
                                                    tchecker::clock_constraint_container_t const & tgt_invariant)
 {
-  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
-  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
-  tchecker::dbm::reset(dbm, dim, clkreset);
+  _kernels->reset(dbm, dim, clkreset);
 
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   if (tgt_delay_allowed) {
-    tchecker::dbm::open_up(dbm, dim);
+    _kernels->open_up(dbm, dim);
 
-    if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+    if (_kernels->constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
   }
 
@@ -163,33 +163,33 @@ tchecker::state_status_t elapsed_semantics_t::prev(tchecker::dbm::db_t * dbm, tc
                                                    tchecker::clock_constraint_container_t const & tgt_invariant)
 {
   // 目标不变式：到达 q′ 时必须在其不变式内
-  if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
 
   // 若 q′ 允许延时，
   if (tgt_delay_allowed) {
     // 允许把时间“倒回”，是 open_up 时间延迟的逆向
-    tchecker::dbm::open_down(dbm, dim);
+    _kernels->open_down(dbm, dim);
     // 倒回的这段时间里仍必须满足 q′ 的不变式
-    if (tchecker::dbm::constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
+    if (_kernels->constrain(dbm, dim, tgt_invariant) == tchecker::dbm::EMPTY)
       return tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
   }
 
   // 将reset转成后态约束并相交，计算所有可能的前态集合
   tchecker::clock_constraint_container_t resets_as_constraints;
   tchecker::clock_resets_to_constraints(clkreset, resets_as_constraints);
-  if (tchecker::dbm::constrain(dbm, dim, resets_as_constraints) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, resets_as_constraints) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_RESET_FAILED;
 
   // 释放被重置的时钟（free_clock）
-  tchecker::dbm::free_clock(dbm, dim, clkreset);
+  _kernels->free_clock(dbm, dim, clkreset);
 
   // 源态必须满足 guard
-  if (tchecker::dbm::constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, guard) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_GUARD_VIOLATED;
 
   // 源态必须满足 src invariant 
-  if (tchecker::dbm::constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
+  if (_kernels->constrain(dbm, dim, src_invariant) == tchecker::dbm::EMPTY)
     return tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED;
 
   return tchecker::STATE_OK;
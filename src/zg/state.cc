@@ -72,6 +72,20 @@ bool shared_is_alu_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t co
   return tchecker::ta::shared_equal_to(s1, s2) && (s1.zone_ptr() == s2.zone_ptr() || s1.zone().is_alu_le(s2.zone(), l, u));
 }
 
+bool is_alu_d_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2, tchecker::clockbounds::map_t const & l,
+                 tchecker::clockbounds::map_t const & u, tchecker::clock_constraint_container_t const & diagonals)
+{
+  return tchecker::ta::operator==(s1, s2) && s1.zone().is_alu_d_le(s2.zone(), l, u, diagonals);
+}
+
+bool shared_is_alu_d_le(tchecker::zg::state_t const & s1, tchecker::zg::state_t const & s2,
+                        tchecker::clockbounds::map_t const & l, tchecker::clockbounds::map_t const & u,
+                        tchecker::clock_constraint_container_t const & diagonals)
+{
+  return tchecker::ta::shared_equal_to(s1, s2) &&
+         (s1.zone_ptr() == s2.zone_ptr() || s1.zone().is_alu_d_le(s2.zone(), l, u, diagonals));
+}
+
 std::size_t hash_value(tchecker::zg::state_t const & s)
 {
   std::size_t h = tchecker::ta::hash_value(s);
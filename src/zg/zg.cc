@@ -5,9 +5,11 @@
  *
  */
 
+#include <cassert>
 #include <queue>
 
 #include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/kernels.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/zg/zg.hh"
 
@@ -15,112 +17,6 @@ namespace tchecker {
 
 namespace zg {
 
-/* Semantics functions */
-
-tchecker::state_status_t initial(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
-                                 tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
-                                 tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
-                                 tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
-                                 tchecker::zg::extrapolation_t & extrapolation,
-                                 tchecker::zg::initial_value_t const & initial_range)
-{
-  tchecker::state_status_t status = tchecker::ta::initial(system, vloc, intval, vedge, sync_id, invariant, initial_range);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  tchecker::dbm::db_t * dbm = zone->dbm();
-  tchecker::clock_id_t dim = zone->dim();
-  bool delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
-
-  status = semantics.initial(dbm, dim, delay_allowed, invariant);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  extrapolation.extrapolate(dbm, dim, *vloc);
-
-  return tchecker::STATE_OK;
-}
-
-tchecker::state_status_t final(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
-                               tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
-                               tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
-                               tchecker::clock_constraint_container_t & invariant, tchecker::zg::semantics_t & semantics,
-                               tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::final_value_t const & final_range)
-{
-  tchecker::state_status_t status = tchecker::ta::final(system, vloc, intval, vedge, sync_id, invariant, final_range);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  tchecker::dbm::db_t * dbm = zone->dbm();
-  tchecker::clock_id_t dim = zone->dim();
-  bool delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
-
-  status = semantics.final(dbm, dim, delay_allowed, invariant);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  extrapolation.extrapolate(dbm, dim, *vloc);
-
-  return tchecker::STATE_OK;
-}
-
-tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
-                              tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
-                              tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
-                              tchecker::clock_constraint_container_t & src_invariant,
-                              tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
-                              tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
-                              tchecker::zg::extrapolation_t & extrapolation,
-                              tchecker::zg::outgoing_edges_value_t const & sync_edges)
-{
-  bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
-
-  tchecker::state_status_t status =
-      tchecker::ta::next(system, vloc, intval, vedge, sync_id, src_invariant, guard, reset, tgt_invariant, sync_edges);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  tchecker::dbm::db_t * dbm = zone->dbm();
-  tchecker::clock_id_t dim = zone->dim();
-  bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
-
-  status = semantics.next(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  extrapolation.extrapolate(dbm, dim, *vloc);
-
-  return tchecker::STATE_OK;
-}
-
-tchecker::state_status_t prev(tchecker::ta::system_t const & system, tchecker::vloc_sptr_t const & vloc,
-                              tchecker::intval_sptr_t const & intval, tchecker::zg::zone_sptr_t const & zone,
-                              tchecker::vedge_sptr_t const & vedge, tchecker::sync_id_t & sync_id,
-                              tchecker::clock_constraint_container_t & src_invariant,
-                              tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
-                              tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
-                              tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::incoming_edges_value_t const & v)
-{
-  bool tgt_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
-
-  tchecker::state_status_t status =
-      tchecker::ta::prev(system, vloc, intval, vedge, sync_id, src_invariant, guard, reset, tgt_invariant, v);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  tchecker::dbm::db_t * dbm = zone->dbm();
-  tchecker::clock_id_t dim = zone->dim();
-  bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
-
-  status = semantics.prev(dbm, dim, src_delay_allowed, src_invariant, guard, reset, tgt_delay_allowed, tgt_invariant);
-  if (status != tchecker::STATE_OK)
-    return status;
-
-  extrapolation.extrapolate(dbm, dim, *vloc);
-
-  return tchecker::STATE_OK;
-}
-
 /* labels */
 
 boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::zg::state_t const & s)
@@ -207,25 +103,26 @@ zg_t::zg_t(std::shared_ptr<tchecker::ta::system_t const> const & system, enum tc
                        _system->clocks_count(tchecker::VK_FLATTENED) + 1, table_size),
       _transition_allocator(block_size, block_size, _system->processes_count(), table_size)
 {
+  // DBM operations are selected once from the dimension of zones instead of on each call
+  tchecker::dbm::kernels_t const & kernels = tchecker::dbm::kernels(_system->clocks_count(tchecker::VK_FLATTENED) + 1);
+  _semantics->set_kernels(kernels);
+  _extrapolation->set_kernels(kernels);
 }
 
 initial_range_t zg_t::initial_edges() { return tchecker::zg::initial_edges(*_system); }
 
 void zg_t::initial(tchecker::zg::initial_value_t const & init_edge, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::zg::state_sptr_t s = _state_allocator.construct();
-  tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::initial(*_system, *s, *t, *_semantics, *_extrapolation, init_edge);
-  if (status & mask) {
-    if (_sharing_type == tchecker::ts::SHARING) {
-      share(s);
-      share(t);
-    }
-    v.push_back(std::make_tuple(status, s, t));
-  }
+  initial(init_edge, v, mask, *_semantics, *_extrapolation);
 }
 
-void zg_t::initial(std::vector<sst_t> & v, tchecker::state_status_t mask) { tchecker::ts::initial(*this, v, mask); }
+void zg_t::initial(std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  // same as tchecker::ts::initial, without virtual calls since zg_t can be derived
+  tchecker::zg::initial_range_t init_edges = tchecker::zg::initial_edges(*_system);
+  for (tchecker::zg::initial_value_t && init_edge : init_edges)
+    initial(init_edge, v, mask, *_semantics, *_extrapolation);
+}
 
 tchecker::zg::outgoing_edges_range_t zg_t::outgoing_edges(tchecker::zg::const_state_sptr_t const & s)
 {
@@ -235,21 +132,14 @@ tchecker::zg::outgoing_edges_range_t zg_t::outgoing_edges(tchecker::zg::const_st
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::outgoing_edges_value_t const & out_edge,
                 std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
-  tchecker::zg::transition_sptr_t nextt = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::next(*_system, *nexts, *nextt, *_semantics, *_extrapolation, out_edge);
-  if (status & mask) {
-    if (_sharing_type == tchecker::ts::SHARING) {
-      share(nexts);
-      share(nextt);
-    }
-    v.push_back(std::make_tuple(status, nexts, nextt));
-  }
+  next(s, out_edge, v, mask, *_semantics, *_extrapolation);
 }
 
 void zg_t::next(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::next(*this, s, v, mask);
+  tchecker::zg::outgoing_edges_range_t out_edges = tchecker::zg::outgoing_edges(*_system, s->vloc_ptr());
+  for (tchecker::zg::outgoing_edges_value_t && out_edge : out_edges)
+    next(s, out_edge, v, mask, *_semantics, *_extrapolation);
 }
 
 // Backward
@@ -258,21 +148,14 @@ final_range_t zg_t::final_edges(boost::dynamic_bitset<> const & labels) { return
 
 void zg_t::final(final_value_t const & final_edge, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::zg::state_sptr_t s = _state_allocator.construct();
-  tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::final(*_system, *s, *t, *_semantics, *_extrapolation, final_edge);
-  if (status & mask) {
-    if (_sharing_type == tchecker::ts::SHARING) {
-      share(s);
-      share(t);
-    }
-    v.push_back(std::make_tuple(status, s, t));
-  }
+  final(final_edge, v, mask, *_semantics, *_extrapolation);
 }
 
 void zg_t::final(boost::dynamic_bitset<> const & labels, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::final(*this, labels, v, mask);
+  tchecker::zg::final_range_t final_edges = tchecker::zg::final_edges(*_system, labels);
+  for (tchecker::zg::final_value_t && final_edge : final_edges)
+    final(final_edge, v, mask, *_semantics, *_extrapolation);
 }
 
 incoming_edges_range_t zg_t::incoming_edges(tchecker::zg::const_state_sptr_t const & s)
@@ -283,21 +166,14 @@ incoming_edges_range_t zg_t::incoming_edges(tchecker::zg::const_state_sptr_t con
 void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, incoming_edges_value_t const & in_edge, std::vector<sst_t> & v,
                 tchecker::state_status_t mask)
 {
-  tchecker::zg::state_sptr_t prevs = _state_allocator.clone(*s);
-  tchecker::zg::transition_sptr_t prevt = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::prev(*_system, *prevs, *prevt, *_semantics, *_extrapolation, in_edge);
-  if (status & mask) {
-    if (_sharing_type == tchecker::ts::SHARING) {
-      share(prevs);
-      share(prevt);
-    }
-    v.push_back(std::make_tuple(status, prevs, prevt));
-  }
+  prev(s, in_edge, v, mask, *_semantics, *_extrapolation);
 }
 
 void zg_t::prev(tchecker::zg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
 {
-  tchecker::ts::prev(*this, s, v, mask);
+  tchecker::zg::incoming_edges_range_t in_edges = tchecker::zg::incoming_edges(*_system, s->vloc_ptr());
+  for (tchecker::zg::incoming_edges_value_t && in_edge : in_edges)
+    prev(s, in_edge, v, mask, *_semantics, *_extrapolation);
 }
 
 // Builder
@@ -316,6 +192,21 @@ void zg_t::build(std::map<std::string, std::string> const & attributes, std::vec
   }
 }
 
+tchecker::zg::state_sptr_t zg_t::build(tchecker::loc_id_t const * vloc, tchecker::integer_t const * intval,
+                                       tchecker::dbm::db_t const * dbm, tchecker::clock_id_t dim)
+{
+  tchecker::zg::state_sptr_t s = _state_allocator.construct();
+  assert(s->vloc().capacity() == _system->processes_count());
+  assert(s->intval().capacity() == _system->intvars_count(tchecker::VK_FLATTENED));
+  assert(s->zone().dim() == dim);
+  for (tchecker::process_id_t pid = 0; pid < s->vloc().capacity(); ++pid)
+    (*s->vloc_ptr())[pid] = vloc[pid];
+  for (tchecker::intvar_id_t id = 0; id < s->intval().capacity(); ++id)
+    (*s->intval_ptr())[id] = intval[id];
+  tchecker::dbm::copy(s->zone_ptr()->dbm(), dbm, dim);
+  return s;
+}
+
 // Split
 
 void zg_t::split(tchecker::zg::const_state_sptr_t const & s, tchecker::clock_constraint_t const & c,
@@ -77,6 +77,17 @@ bool zone_t::is_alu_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds:
   return tchecker::dbm::is_alu_le(dbm_ptr(), zone.dbm_ptr(), _dim, l.ptr(), u.ptr());
 }
 
+bool zone_t::is_alu_d_le(tchecker::zg::zone_t const & zone, tchecker::clockbounds::map_t const & l,
+                         tchecker::clockbounds::map_t const & u,
+                         tchecker::clock_constraint_container_t const & diagonals) const
+{
+  if (this->is_empty())
+    return true;
+  if (zone.is_empty())
+    return false;
+  return tchecker::dbm::is_alu_d_le(dbm_ptr(), zone.dbm_ptr(), _dim, l.ptr(), u.ptr(), diagonals);
+}
+
 int zone_t::lexical_cmp(tchecker::zg::zone_t const & zone) const
 {
   return tchecker::dbm::lexical_cmp(dbm_ptr(), _dim, zone.dbm_ptr(), zone._dim);
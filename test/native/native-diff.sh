@@ -0,0 +1,51 @@
+#!/usr/bin/env bash
+
+# This file is a part of the TChecker project.
+#
+# See files AUTHORS and LICENSE for copyright details.
+
+# Differential test of native models: a model generated by an example script
+# is compiled by tck-compile, then analysed by tck-reach with and without the
+# native model. Statistics (except running time and memory usage) and state
+# space graphs should be the same.
+#
+# usage: native-diff.sh tck-compile tck-reach generator [arguments]
+
+if test $# -lt 3;
+then
+    echo 1>&2 "usage: $0 tck-compile tck-reach generator [arguments]"
+    exit 1
+fi
+
+TCK_COMPILE="$1"
+TCK_REACH="$2"
+GENERATOR="$3"
+shift 3
+
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "${TMPDIR}"' EXIT
+
+MODEL="${TMPDIR}/model.tck"
+NATIVE="${TMPDIR}/model.so"
+
+bash "${GENERATOR}" "$@" > "${MODEL}" || exit 1
+"${TCK_COMPILE}" -s "${NATIVE}" "${MODEL}" || exit 1
+
+STATUS=0
+for algorithm in reach covreach;
+do
+    for so in bfs dfs;
+    do
+        "${TCK_REACH}" -a ${algorithm} -s ${so} -C graph "${MODEL}" | \
+            grep -v -e RUNNING_TIME_SECONDS -e MEMORY_MAX_RSS > "${TMPDIR}/interpreted.out"
+        "${TCK_REACH}" -a ${algorithm} -s ${so} -C graph --native "${NATIVE}" "${MODEL}" | \
+            grep -v -e RUNNING_TIME_SECONDS -e MEMORY_MAX_RSS > "${TMPDIR}/native.out"
+        if ! diff -q "${TMPDIR}/interpreted.out" "${TMPDIR}/native.out" > /dev/null;
+        then
+            echo 1>&2 "native model differs from interpreted model: -a ${algorithm} -s ${so}"
+            STATUS=1
+        fi
+    done
+done
+
+exit ${STATUS}
@@ -0,0 +1,88 @@
+#!/usr/bin/env bash
+
+# This script checks that tck-reach gives the same verdict with a single thread
+# and with several threads. As tck-reach.sh, it looks for a line
+# # labels=l1:l2:... in the input file and invokes tck-reach with the option
+# -l l1,l2,... It runs tck-reach with the given options, first with -j 1, then
+# with -j ${THREADS} (default: 4), and compares the REACHABLE lines of both
+# runs. When no state is reachable, both runs explore the whole state-space
+# and it also checks that the STORED_STATES lines differ by at most
+# ${TOLERANCE} percent (default: 50): both runs use the same G(q), but the
+# covering decisions depend on the interleaving of threads. Nothing is output
+# if the verdicts are the same and the numbers of stored states are close
+# enough. Other statistics are not compared.
+#
+
+if ! test -n "${TCK_REACH}";
+then
+    echo 1>&2 "missing variable TCK_REACH"
+    exit 1
+fi
+
+if ! test -n "${THREADS}";
+then
+    THREADS=4
+fi
+
+if ! test -n "${TOLERANCE}";
+then
+    TOLERANCE=50
+fi
+
+COMMAND="${TCK_REACH}"
+while test $# != 1;
+do
+    COMMAND="${COMMAND} \"$1\""
+    shift
+done
+
+INPUTFILE="$1"
+if test -f ${INPUTFILE};
+then
+    LABELS=$(grep -e "^# *labels *= *\([a-zA-Z0-9_:]*\) *\$" ${INPUTFILE} | sed -e 's/^# *labels *= *//g' | tr : ,)
+    if test -n "${LABELS}";
+    then
+        COMMAND="${COMMAND} -l \"${LABELS}\""
+    fi
+else
+    echo 1>&2 "missing input file '${INPUTFILE}'"
+    exit 1
+fi
+
+SEQUENTIAL_STATS=$(eval ${COMMAND} -j 1 \"${INPUTFILE}\")
+PARALLEL_STATS=$(eval ${COMMAND} -j ${THREADS} \"${INPUTFILE}\")
+
+SEQUENTIAL=$(echo "${SEQUENTIAL_STATS}" | grep -e "^REACHABLE ")
+PARALLEL=$(echo "${PARALLEL_STATS}" | grep -e "^REACHABLE ")
+
+if test -z "${SEQUENTIAL}" || test "${SEQUENTIAL}" != "${PARALLEL}";
+then
+    echo 1>&2 "verdicts differ: '${SEQUENTIAL}' with 1 thread, '${PARALLEL}' with ${THREADS} threads"
+    exit 1
+fi
+
+if test "${SEQUENTIAL}" != "REACHABLE false";
+then
+    exit 0
+fi
+
+SEQUENTIAL_STORED=$(echo "${SEQUENTIAL_STATS}" | grep -e "^STORED_STATES " | sed -e 's/^STORED_STATES *//g')
+PARALLEL_STORED=$(echo "${PARALLEL_STATS}" | grep -e "^STORED_STATES " | sed -e 's/^STORED_STATES *//g')
+
+if test -z "${SEQUENTIAL_STORED}" || test -z "${PARALLEL_STORED}";
+then
+    echo 1>&2 "missing stored states: '${SEQUENTIAL_STORED}' with 1 thread, '${PARALLEL_STORED}' with ${THREADS} threads"
+    exit 1
+fi
+
+DIFFERENCE=$((PARALLEL_STORED - SEQUENTIAL_STORED))
+if test ${DIFFERENCE} -lt 0;
+then
+    DIFFERENCE=$((-DIFFERENCE))
+fi
+
+if test $((DIFFERENCE * 100)) -gt $((SEQUENTIAL_STORED * TOLERANCE));
+then
+    echo 1>&2 "stored states differ by more than ${TOLERANCE}%: ${SEQUENTIAL_STORED} with 1 thread, ${PARALLEL_STORED} with ${THREADS} threads"
+    exit 1
+fi
@@ -0,0 +1,64 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <stdexcept>
+
+#include "tchecker/utils/bitstate.hh"
+
+TEST_CASE("bit-state table", "[bitstate]")
+{
+  SECTION("size is rounded down to a power of 2")
+  {
+    REQUIRE(tchecker::bitstate_t(1000).bits() == 512);
+    REQUIRE(tchecker::bitstate_t(1024).bits() == 1024);
+    REQUIRE(tchecker::bitstate_t(1).bits() == 64);
+  }
+
+  SECTION("invalid number of hash functions")
+  {
+    REQUIRE_THROWS_AS(tchecker::bitstate_t(1024, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::bitstate_t(1024, 33), std::invalid_argument);
+  }
+
+  SECTION("inserted values are stored")
+  {
+    tchecker::bitstate_t table(1 << 20, 3);
+    for (std::size_t h = 0; h < 1000; ++h)
+      REQUIRE(table.insert(h * 7919));
+    for (std::size_t h = 0; h < 1000; ++h) {
+      REQUIRE(table.contains(h * 7919));
+      REQUIRE_FALSE(table.insert(h * 7919));
+    }
+    REQUIRE(table.stored() == 1000);
+    REQUIRE(table.set_bits() <= 3000);
+    REQUIRE(table.omission_probability() < 0.01);
+  }
+
+  SECTION("collisions in a full table")
+  {
+    tchecker::bitstate_t table(64, 1);
+    std::size_t stored = 0;
+    for (std::size_t h = 0; h < 1000; ++h)
+      if (table.insert(h))
+        ++stored;
+    REQUIRE(stored == table.stored());
+    REQUIRE(stored <= 64);
+    REQUIRE(table.set_bits() == stored);
+    REQUIRE(table.omission_probability() > 0.99);
+  }
+
+  SECTION("clear")
+  {
+    tchecker::bitstate_t table(1024, 2);
+    table.insert(42);
+    table.clear();
+    REQUIRE_FALSE(table.contains(42));
+    REQUIRE(table.set_bits() == 0);
+    REQUIRE(table.stored() == 0);
+    REQUIRE(table.expected_omissions() == 0.0);
+  }
+}
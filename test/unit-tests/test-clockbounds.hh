@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <memory>
 
 #include "tchecker/clockbounds/clockbounds.hh"
@@ -1864,3 +1865,152 @@ TEST_CASE("system with 1 process and non-const clock updates in a while", "[cloc
 
   REQUIRE_THROWS_AS(tchecker::clockbounds::compute_clockbounds(system), std::runtime_error);
 }
+
+namespace {
+
+/*!
+ \brief Check a diagonal clock constraint
+ \param D : diagonal clock constraints
+ \param x : clock ID
+ \param y : clock ID
+ \param cmp : comparator
+ \param c : bound
+ \return true if x - y cmp c is in D, false otherwise
+ */
+bool clockbounds_has_diagonal(tchecker::clock_constraint_container_t const & D, tchecker::clock_id_t x, tchecker::clock_id_t y,
+                              tchecker::ineq_cmp_t cmp, tchecker::integer_t c)
+{
+  return std::find(D.begin(), D.end(), tchecker::clock_constraint_t{x, y, cmp, c}) != D.end();
+}
+
+} // namespace
+
+TEST_CASE("system with 1 process, diagonal constraints on a loop with resets", "[clockbounds]")
+{
+  std::string model = "system:one_process_diagonal_loop \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  clock:1:z \n\
+  event:e \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: true} \n\
+  location:P:l1 \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:e{do: z=0} \n\
+  edge:P:l1:l0:e{provided: x-y<2 : do: x=1+z} \n\
+  edge:P:l2:l1:e{do: y=0} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  tchecker::ta::system_t system{*sysdecl};
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> clockbounds{tchecker::clockbounds::compute_clockbounds(system)};
+  REQUIRE(clockbounds.get() != nullptr);
+
+  tchecker::process_id_t const P = system.process_id("P");
+  tchecker::loc_id_t const l0 = system.location(P, "l0")->id();
+  tchecker::loc_id_t const l1 = system.location(P, "l1")->id();
+  tchecker::loc_id_t const l2 = system.location(P, "l2")->id();
+
+  tchecker::clock_id_t const x = system.clock_id("x");
+  tchecker::clock_id_t const y = system.clock_id("y");
+  tchecker::clock_id_t const z = system.clock_id("z");
+
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t const> d_map = clockbounds->local_d_map();
+
+  SECTION("Local diagonal constraints")
+  {
+    // l1: guard x-y<2, and (1+z)-y<2 from l0 over x:=1+z
+    REQUIRE(d_map->D(l1).size() == 2);
+    REQUIRE(clockbounds_has_diagonal(d_map->D(l1), x, y, tchecker::LT, 2));
+    REQUIRE(clockbounds_has_diagonal(d_map->D(l1), z, y, tchecker::LT, 1));
+
+    // l0: x-y<2 from l1 over z:=0 (z-y<1 becomes -y<1, which is not a constraint)
+    REQUIRE(d_map->D(l0).size() == 1);
+    REQUIRE(clockbounds_has_diagonal(d_map->D(l0), x, y, tchecker::LT, 2));
+
+    // l2: y:=0 turns diagonal constraints in l1 into upper bounds
+    REQUIRE(d_map->D(l2).empty());
+  }
+
+  SECTION("Upper bounds from diagonal constraints over resets")
+  {
+    tchecker::clockbounds::map_t * L = tchecker::clockbounds::allocate_map(system.clocks_count(tchecker::VK_FLATTENED));
+    tchecker::clockbounds::map_t * U = tchecker::clockbounds::allocate_map(system.clocks_count(tchecker::VK_FLATTENED));
+
+    clockbounds->local_lu(l2, *L, *U);
+    REQUIRE((*U)[x] == 2);
+    REQUIRE((*U)[z] == 1);
+
+    tchecker::clockbounds::deallocate_map(L);
+    tchecker::clockbounds::deallocate_map(U);
+  }
+}
+
+TEST_CASE("system with 2 processes, diagonal constraints on shared clocks", "[clockbounds]")
+{
+  std::string model = "system:two_processes_shared_diagonal \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  clock:1:z \n\
+  event:e \n\
+  \n\
+  process:P \n\
+  location:P:p0{initial: true} \n\
+  location:P:p1 \n\
+  edge:P:p0:p1:e{provided: x-y==1} \n\
+  \n\
+  process:Q \n\
+  location:Q:q0{initial: true} \n\
+  location:Q:q1 \n\
+  edge:Q:q0:q1:e{do: x=z} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  tchecker::ta::system_t system{*sysdecl};
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> clockbounds{tchecker::clockbounds::compute_clockbounds(system)};
+  REQUIRE(clockbounds.get() != nullptr);
+
+  tchecker::process_id_t const P = system.process_id("P");
+  tchecker::loc_id_t const p0 = system.location(P, "p0")->id();
+  tchecker::loc_id_t const p1 = system.location(P, "p1")->id();
+  tchecker::process_id_t const Q = system.process_id("Q");
+  tchecker::loc_id_t const q0 = system.location(Q, "q0")->id();
+  tchecker::loc_id_t const q1 = system.location(Q, "q1")->id();
+
+  tchecker::clock_id_t const x = system.clock_id("x");
+  tchecker::clock_id_t const y = system.clock_id("y");
+  tchecker::clock_id_t const z = system.clock_id("z");
+
+  std::shared_ptr<tchecker::clockbounds::local_d_map_t const> d_map = clockbounds->local_d_map();
+
+  // p0: x-y==1 is x-y<=1 and y-x<=-1
+  REQUIRE(d_map->D(p0).size() == 2);
+  REQUIRE(clockbounds_has_diagonal(d_map->D(p0), x, y, tchecker::LE, 1));
+  REQUIRE(clockbounds_has_diagonal(d_map->D(p0), y, x, tchecker::LE, -1));
+  REQUIRE(d_map->D(p1).empty());
+
+  // q0: constraints in p0 over x:=z in Q, constraints over clocks that are not updated are not propagated
+  REQUIRE(d_map->D(q0).size() == 2);
+  REQUIRE(clockbounds_has_diagonal(d_map->D(q0), z, y, tchecker::LE, 1));
+  REQUIRE(clockbounds_has_diagonal(d_map->D(q0), y, z, tchecker::LE, -1));
+  REQUIRE(d_map->D(q1).empty());
+}
+
+TEST_CASE("system with 1 process, diagonal constraints shifted on a loop", "[clockbounds]")
+{
+  std::string model = "system:one_process_diagonal_diverge \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  event:e \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: true} \n\
+  edge:P:l0:l0:e{provided: x-y<1 : do: x=1+x} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  tchecker::ta::system_t system{*sysdecl};
+
+  // x-y<1 yields x-y<0, x-y<-1, ... in l0 over x:=1+x
+  REQUIRE_THROWS_AS(tchecker::clockbounds::compute_clockbounds(system), std::runtime_error);
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "tchecker/graph/concurrent_cover_graph.hh"
+
+// Node for testing concurrent cover graph: n1 <= n2 iff same key and n1 value <= n2 value
+class ccg_node_t : public tchecker::graph::cover::node_t {
+public:
+  ccg_node_t(int key, int value) : _key(key), _value(value) {}
+  int key() const { return _key; }
+  int value() const { return _value; }
+
+private:
+  int _key;
+  int _value;
+};
+
+using ccg_node_sptr_t = std::shared_ptr<ccg_node_t>;
+
+class ccg_node_hash_t {
+public:
+  std::size_t operator()(ccg_node_sptr_t const & n) const { return static_cast<std::size_t>(n->key()); }
+};
+
+class ccg_node_le_t {
+public:
+  bool operator()(ccg_node_sptr_t const & n1, ccg_node_sptr_t const & n2) const
+  {
+    return (n1->key() == n2->key()) && (n1->value() <= n2->value());
+  }
+};
+
+using ccg_graph_t = tchecker::graph::cover::concurrent_graph_t<ccg_node_sptr_t, ccg_node_hash_t, ccg_node_le_t>;
+
+TEST_CASE("concurrent cover graph, sequential operations", "[concurrent_cover_graph]")
+{
+  ccg_graph_t g{64, 3, ccg_node_hash_t{}, ccg_node_le_t{}};
+  REQUIRE(g.shards() == 4);
+
+  ccg_node_sptr_t n1 = std::make_shared<ccg_node_t>(1, 5);
+  ccg_node_sptr_t n2 = std::make_shared<ccg_node_t>(1, 3);
+  ccg_node_sptr_t n3 = std::make_shared<ccg_node_t>(1, 8);
+  ccg_node_sptr_t n4 = std::make_shared<ccg_node_t>(2, 1);
+  ccg_node_sptr_t covering{nullptr};
+  std::vector<ccg_node_sptr_t> covered;
+  auto ins = std::back_inserter(covered);
+
+  SECTION("add, cover and remove")
+  {
+    g.add_node(n1);
+    REQUIRE(g.size() == 1);
+    REQUIRE(g.is_covered(n2, covering));
+    REQUIRE(covering == n1);
+    REQUIRE_FALSE(g.is_covered(n1, covering));
+    REQUIRE_FALSE(g.is_covered(n4, covering));
+    g.covered_nodes(n3, ins);
+    REQUIRE(covered == std::vector<ccg_node_sptr_t>{n1});
+    g.remove_node(n1);
+    REQUIRE(g.size() == 0);
+  }
+
+  SECTION("add if not covered")
+  {
+    REQUIRE(g.add_if_not_covered(n1, covering, ins));
+    REQUIRE(covered.empty());
+    REQUIRE_FALSE(g.add_if_not_covered(n2, covering, ins));
+    REQUIRE(covering == n1);
+    REQUIRE(g.add_if_not_covered(n4, covering, ins));
+    REQUIRE(g.add_if_not_covered(n3, covering, ins));
+    REQUIRE(covered == std::vector<ccg_node_sptr_t>{n1});
+    REQUIRE(g.size() == 2);
+
+    std::vector<ccg_node_sptr_t> nodes;
+    auto nodes_ins = std::back_inserter(nodes);
+    g.nodes(nodes_ins);
+    REQUIRE(nodes.size() == 2);
+    REQUIRE(std::find(nodes.begin(), nodes.end(), n3) != nodes.end());
+    REQUIRE(std::find(nodes.begin(), nodes.end(), n4) != nodes.end());
+  }
+}
+
+TEST_CASE("concurrent cover graph, concurrent insertions", "[concurrent_cover_graph]")
+{
+  int const keys = 16, values = 500, threads = 4;
+  ccg_graph_t g{128, 8, ccg_node_hash_t{}, ccg_node_le_t{}};
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+    workers.emplace_back([&g, t]() {
+      ccg_node_sptr_t covering{nullptr};
+      std::vector<ccg_node_sptr_t> covered;
+      auto ins = std::back_inserter(covered);
+      for (int v = 0; v < values; ++v)
+        for (int k = 0; k < keys; ++k) {
+          int value = (t % 2 == 0 ? v : values - 1 - v);
+          g.add_if_not_covered(std::make_shared<ccg_node_t>(k, value), covering, ins);
+        }
+    });
+  for (std::thread & w : workers)
+    w.join();
+
+  REQUIRE(g.size() == keys);
+
+  std::vector<ccg_node_sptr_t> nodes;
+  auto ins = std::back_inserter(nodes);
+  g.nodes(ins);
+  REQUIRE(nodes.size() == keys);
+  for (ccg_node_sptr_t const & n : nodes)
+    REQUIRE(n->value() == values - 1);
+}
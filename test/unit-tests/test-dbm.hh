@@ -5,7 +5,18 @@
  *
  */
 
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "tchecker/dbm/details/simd_kernels.hh"
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/fixed_dim.hh"
+#include "tchecker/dbm/kernels.hh"
+#include "tchecker/dbm/simd.hh"
 
 #define DBM(i, j)  dbm[(i)*dim + (j)]
 #define DBM1(i, j) dbm1[(i)*dim + (j)]
@@ -1971,6 +1982,48 @@ TEST_CASE("Zone inclusion w.r.t. abstraction aLU from LICS12", "[dbm]")
   }
 }
 
+TEST_CASE("Zone inclusion w.r.t. LU-d simulation", "[dbm]")
+{
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x = 1;
+  tchecker::clock_id_t const y = 2;
+
+  // x <= y
+  tchecker::dbm::db_t dbm[dim * dim];
+  tchecker::dbm::universal_positive(dbm, dim);
+  DBM(x, y) = tchecker::dbm::LE_ZERO;
+  tchecker::dbm::tighten(dbm, dim);
+
+  tchecker::dbm::db_t dbm_positive[dim * dim];
+  tchecker::dbm::universal_positive(dbm_positive, dim);
+
+  // no LU bounds: only diagonal constraints distinguish valuations
+  tchecker::integer_t l[dim - 1] = {-tchecker::dbm::INF_VALUE, -tchecker::dbm::INF_VALUE};
+  tchecker::integer_t u[dim - 1] = {-tchecker::dbm::INF_VALUE, -tchecker::dbm::INF_VALUE};
+
+  SECTION("No diagonal constraint: same as aLU")
+  {
+    tchecker::clock_constraint_container_t diagonals;
+    REQUIRE(tchecker::dbm::is_alu_d_le(dbm_positive, dbm, dim, l, u, diagonals));
+    REQUIRE(tchecker::dbm::is_alu_d_le(dbm, dbm_positive, dim, l, u, diagonals));
+  }
+
+  SECTION("Diagonal constraint satisfied by both zones")
+  {
+    // x - y <= 0: valuations in dbm_positive that satisfy it are in dbm
+    tchecker::clock_constraint_container_t diagonals{tchecker::clock_constraint_t{x - 1, y - 1, tchecker::LE, 0}};
+    REQUIRE(tchecker::dbm::is_alu_d_le(dbm_positive, dbm, dim, l, u, diagonals));
+  }
+
+  SECTION("Diagonal constraint not satisfiable in the bigger zone")
+  {
+    // y - x < 0: satisfied by some valuations in dbm_positive, but by no valuation in dbm
+    tchecker::clock_constraint_container_t diagonals{tchecker::clock_constraint_t{y - 1, x - 1, tchecker::LT, 0}};
+    REQUIRE_FALSE(tchecker::dbm::is_alu_d_le(dbm_positive, dbm, dim, l, u, diagonals));
+    REQUIRE(tchecker::dbm::is_alu_d_le(dbm, dbm_positive, dim, l, u, diagonals));
+  }
+}
+
 TEST_CASE("scale_up, structural tests", "[dbm]")
 {
   tchecker::clock_id_t const dim = 3;
@@ -2686,3 +2739,523 @@ TEST_CASE("Clock position", "[dbm]")
     REQUIRE(tchecker::dbm::clock_position(dbm, dim, x4, x4) == tchecker::dbm::CLK_SYNCHRONIZED);
   }
 }
+
+namespace {
+
+// Random tight positive DBM obtained from universal positive zone by random
+// constraints, resets and delays
+void random_zone(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(-20, 20);
+  std::uniform_int_distribution<int> op(0, 9);
+  std::vector<tchecker::dbm::db_t> copy(dim * dim);
+
+  tchecker::dbm::universal_positive(dbm, dim);
+  for (int step = 0; step < 4 * static_cast<int>(dim); ++step) {
+    tchecker::dbm::copy(copy.data(), dbm, dim);
+    int o = op(gen);
+    if (o < 7) {
+      tchecker::clock_id_t x = clock(gen), y = clock(gen);
+      if (x != y && tchecker::dbm::constrain(dbm, dim, x, y, (o % 2 == 0 ? tchecker::LE : tchecker::LT), value(gen)) ==
+                        tchecker::dbm::EMPTY)
+        tchecker::dbm::copy(dbm, copy.data(), dim);
+    }
+    else if (o < 9) {
+      tchecker::clock_id_t x = clock(gen);
+      if (x != 0)
+        tchecker::dbm::reset_to_value(dbm, dim, x, 0);
+    }
+    else
+      tchecker::dbm::open_up(dbm, dim);
+  }
+}
+
+// Random clock bounds in [-inf,15]
+void random_bounds(tchecker::integer_t * bounds, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::integer_t> value(-3, 15);
+  for (tchecker::clock_id_t x = 0; x + 1 < dim; ++x) {
+    tchecker::integer_t v = value(gen);
+    bounds[x] = (v < 0 ? -tchecker::dbm::INF_VALUE : v);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Vectorized DBM kernels agree with scalar implementation", "[dbm]")
+{
+  std::vector<tchecker::dbm::simd::isa_t> isas;
+  for (tchecker::dbm::simd::isa_t isa : {tchecker::dbm::simd::ISA_SSE42, tchecker::dbm::simd::ISA_AVX2})
+    if (tchecker::dbm::simd::is_supported(isa))
+      isas.push_back(isa);
+
+  tchecker::dbm::simd::isa_t const initial_isa = tchecker::dbm::simd::selected_isa();
+  std::mt19937 gen(20240613);
+
+  for (tchecker::dbm::simd::isa_t isa : isas) {
+    for (tchecker::clock_id_t dim = 1; dim <= 20; ++dim) {
+      std::size_t const size = dim * dim;
+      std::vector<tchecker::dbm::db_t> dbm1(size), dbm2(size), scalar(size), vectorized(size);
+      std::vector<tchecker::integer_t> l(dim), u(dim);
+
+      for (int round = 0; round < 20; ++round) {
+        tchecker::dbm::simd::select(tchecker::dbm::simd::ISA_SCALAR);
+        random_zone(dbm1.data(), dim, gen);
+        random_zone(dbm2.data(), dim, gen);
+        random_bounds(l.data(), dim, gen);
+        random_bounds(u.data(), dim, gen);
+
+        // tighten on a random non-tight matrix
+        std::uniform_int_distribution<int> entry(-40, 40);
+        for (tchecker::clock_id_t i = 0; i < dim; ++i)
+          for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+            int e = entry(gen);
+            if (i == j)
+              scalar[i * dim + j] = tchecker::dbm::LE_ZERO;
+            else if (e > 30)
+              scalar[i * dim + j] = tchecker::dbm::LT_INFINITY;
+            else
+              scalar[i * dim + j] = tchecker::dbm::db((e % 2 == 0 ? tchecker::LE : tchecker::LT), e);
+          }
+        vectorized = scalar;
+        tchecker::dbm::status_t scalar_status = tchecker::dbm::tighten(scalar.data(), dim);
+        tchecker::dbm::simd::select(isa);
+        tchecker::dbm::status_t vectorized_status = tchecker::dbm::tighten(vectorized.data(), dim);
+        REQUIRE(scalar_status == vectorized_status);
+        if (scalar_status != tchecker::dbm::EMPTY)
+          REQUIRE(scalar == vectorized);
+
+        // inclusion and equality
+        std::vector<tchecker::dbm::db_t> dbm1_copy = dbm1;
+        for (auto const & [d1, d2] :
+             {std::make_pair(&dbm1, &dbm2), std::make_pair(&dbm2, &dbm1), std::make_pair(&dbm1, &dbm1_copy)}) {
+          tchecker::dbm::simd::select(tchecker::dbm::simd::ISA_SCALAR);
+          bool const le = tchecker::dbm::is_le(d1->data(), d2->data(), dim);
+          bool const eq = tchecker::dbm::is_equal(d1->data(), d2->data(), dim);
+          bool const alu_le = tchecker::dbm::is_alu_le(d1->data(), d2->data(), dim, l.data(), u.data());
+          tchecker::dbm::simd::select(isa);
+          REQUIRE(le == tchecker::dbm::is_le(d1->data(), d2->data(), dim));
+          REQUIRE(eq == tchecker::dbm::is_equal(d1->data(), d2->data(), dim));
+          REQUIRE(alu_le == tchecker::dbm::is_alu_le(d1->data(), d2->data(), dim, l.data(), u.data()));
+        }
+
+        // extrapolations
+        tchecker::dbm::simd::select(tchecker::dbm::simd::ISA_SCALAR);
+        scalar = dbm1;
+        tchecker::dbm::extra_lu(scalar.data(), dim, l.data(), u.data());
+        tchecker::dbm::simd::select(isa);
+        vectorized = dbm1;
+        tchecker::dbm::extra_lu(vectorized.data(), dim, l.data(), u.data());
+        REQUIRE(scalar == vectorized);
+
+        tchecker::dbm::simd::select(tchecker::dbm::simd::ISA_SCALAR);
+        scalar = dbm2;
+        tchecker::dbm::extra_m(scalar.data(), dim, u.data());
+        tchecker::dbm::simd::select(isa);
+        vectorized = dbm2;
+        tchecker::dbm::extra_m(vectorized.data(), dim, u.data());
+        REQUIRE(scalar == vectorized);
+      }
+    }
+  }
+
+  tchecker::dbm::simd::select(initial_isa);
+}
+
+TEST_CASE("tighten w.r.t. a set of clocks agrees with full tighten", "[dbm]")
+{
+  std::mt19937 gen(7);
+
+  for (tchecker::clock_id_t dim = 1; dim <= 12; ++dim) {
+    std::vector<tchecker::dbm::db_t> dbm1(dim * dim), dbm2(dim * dim), full(dim * dim), incremental(dim * dim);
+    std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+    std::uniform_int_distribution<tchecker::integer_t> value(-10, 10);
+
+    for (int round = 0; round < 50; ++round) {
+      random_zone(dbm1.data(), dim, gen);
+      random_zone(dbm2.data(), dim, gen);
+
+      // strengthen a few bounds
+      std::vector<tchecker::clock_id_t> clocks;
+      std::vector<bool> in_clocks(dim, false);
+      incremental = dbm1;
+      for (int k = 0; k < 3; ++k) {
+        tchecker::clock_id_t x = clock(gen), y = clock(gen);
+        if (x == y)
+          continue;
+        tchecker::dbm::db_t db = tchecker::dbm::db(tchecker::LE, value(gen));
+        if (db < incremental[x * dim + y])
+          incremental[x * dim + y] = db;
+        for (tchecker::clock_id_t z : {x, y})
+          if (!in_clocks[z]) {
+            in_clocks[z] = true;
+            clocks.push_back(z);
+          }
+      }
+      full = incremental;
+      tchecker::dbm::status_t full_status = tchecker::dbm::tighten(full.data(), dim);
+      tchecker::dbm::status_t incremental_status = tchecker::dbm::tighten_clocks(
+          incremental.data(), dim, clocks.data(), static_cast<tchecker::clock_id_t>(clocks.size()));
+      REQUIRE(full_status == incremental_status);
+      if (full_status == tchecker::dbm::NON_EMPTY)
+        REQUIRE(full == incremental);
+      else
+        REQUIRE(tchecker::dbm::is_empty_0(incremental.data(), dim));
+
+      // intersection
+      for (tchecker::clock_id_t i = 0; i < dim; ++i)
+        for (tchecker::clock_id_t j = 0; j < dim; ++j)
+          full[i * dim + j] = tchecker::dbm::min(dbm1[i * dim + j], dbm2[i * dim + j]);
+      full_status = tchecker::dbm::tighten(full.data(), dim);
+      incremental_status = tchecker::dbm::intersection(incremental.data(), dbm1.data(), dbm2.data(), dim);
+      REQUIRE(full_status == incremental_status);
+      if (full_status == tchecker::dbm::NON_EMPTY)
+        REQUIRE(full == incremental);
+    }
+  }
+}
+
+TEST_CASE("ExtraLU+ restricted to a set of clocks", "[dbm]")
+{
+  std::mt19937 gen(15);
+
+  for (tchecker::clock_id_t dim = 1; dim <= 10; ++dim) {
+    std::vector<tchecker::dbm::db_t> dbm(dim * dim), partial(dim * dim), expected(dim * dim);
+    std::vector<tchecker::integer_t> l(dim), u(dim), l_exact(dim), u_exact(dim);
+    boost::dynamic_bitset<> exact(dim - 1);
+    std::bernoulli_distribution flip(0.5);
+
+    for (int round = 0; round < 50; ++round) {
+      random_zone(dbm.data(), dim, gen);
+      random_bounds(l.data(), dim, gen);
+      random_bounds(u.data(), dim, gen);
+
+      // no exact clock: same as ExtraLU+
+      exact.reset();
+      partial = dbm;
+      tchecker::dbm::extra_lu_plus(partial.data(), dim, l.data(), u.data(), exact);
+      expected = dbm;
+      tchecker::dbm::extra_lu_plus(expected.data(), dim, l.data(), u.data());
+      REQUIRE(partial == expected);
+
+      // all clocks exact: identity
+      exact.set();
+      partial = dbm;
+      tchecker::dbm::extra_lu_plus(partial.data(), dim, l.data(), u.data(), exact);
+      REQUIRE(partial == dbm);
+
+      // some clocks exact: same as ExtraLU+ with bounds above every constant in dbm on exact clocks
+      for (tchecker::clock_id_t x = 0; x + 1 < dim; ++x) {
+        exact[x] = flip(gen);
+        l_exact[x] = (exact[x] ? 1000 : l[x]);
+        u_exact[x] = (exact[x] ? 1000 : u[x]);
+      }
+      partial = dbm;
+      tchecker::dbm::extra_lu_plus(partial.data(), dim, l.data(), u.data(), exact);
+      expected = dbm;
+      tchecker::dbm::extra_lu_plus(expected.data(), dim, l_exact.data(), u_exact.data());
+      REQUIRE(partial == expected);
+    }
+  }
+}
+
+TEST_CASE("Batched inclusion agrees with pairwise inclusion", "[dbm]")
+{
+  std::vector<tchecker::dbm::simd::isa_t> isas{tchecker::dbm::simd::ISA_SCALAR};
+  for (tchecker::dbm::simd::isa_t isa : {tchecker::dbm::simd::ISA_SSE42, tchecker::dbm::simd::ISA_AVX2})
+    if (tchecker::dbm::simd::is_supported(isa))
+      isas.push_back(isa);
+
+  tchecker::dbm::simd::isa_t const initial_isa = tchecker::dbm::simd::selected_isa();
+  std::mt19937 gen(16);
+
+  for (tchecker::clock_id_t dim = 1; dim <= 6; ++dim) {
+    std::size_t const size = dim * dim;
+    std::vector<tchecker::integer_t> l(dim), u(dim);
+    std::vector<tchecker::dbm::db_t> dbm(size), zone(size);
+
+    for (std::size_t count : {0, 1, 7, 8, 13, 64, 70}) {
+      std::size_t const stride = count + 3;
+      std::vector<tchecker::dbm::db_t> batch(size * stride);
+      std::vector<std::vector<tchecker::dbm::db_t>> zones(count, std::vector<tchecker::dbm::db_t>(size));
+      random_zone(dbm.data(), dim, gen);
+      random_bounds(l.data(), dim, gen);
+      random_bounds(u.data(), dim, gen);
+      for (std::size_t k = 0; k < count; ++k) {
+        // copies of dbm make some inclusions hold
+        if (k % 5 == 0)
+          zones[k] = dbm;
+        else
+          random_zone(zones[k].data(), dim, gen);
+        for (std::size_t i = 0; i < size; ++i)
+          batch[i * stride + k] = zones[k][i];
+      }
+
+      for (tchecker::dbm::simd::isa_t isa : isas) {
+        tchecker::dbm::simd::select(isa);
+        std::vector<std::uint64_t> le((count + 63) / 64 + 1, ~static_cast<std::uint64_t>(0)),
+            ge((count + 63) / 64 + 1, ~static_cast<std::uint64_t>(0)), alu_le((count + 63) / 64 + 1, 0),
+            alu_ge((count + 63) / 64 + 1, 0);
+        tchecker::dbm::is_le_batch(dbm.data(), batch.data(), stride, count, dim, le.data());
+        tchecker::dbm::is_ge_batch(dbm.data(), batch.data(), stride, count, dim, ge.data());
+        tchecker::dbm::is_alu_le_batch(dbm.data(), batch.data(), stride, count, dim, l.data(), u.data(), alu_le.data());
+        tchecker::dbm::is_alu_ge_batch(dbm.data(), batch.data(), stride, count, dim, l.data(), u.data(), alu_ge.data());
+
+        tchecker::dbm::simd::select(tchecker::dbm::simd::ISA_SCALAR);
+        for (std::size_t k = 0; k < count; ++k) {
+          auto bit = [k](std::vector<std::uint64_t> const & bits) { return ((bits[k / 64] >> (k % 64)) & 1) == 1; };
+          REQUIRE(bit(le) == tchecker::dbm::is_le(dbm.data(), zones[k].data(), dim));
+          REQUIRE(bit(ge) == tchecker::dbm::is_le(zones[k].data(), dbm.data(), dim));
+          REQUIRE(bit(alu_le) == tchecker::dbm::is_alu_le(dbm.data(), zones[k].data(), dim, l.data(), u.data()));
+          REQUIRE(bit(alu_ge) == tchecker::dbm::is_alu_le(zones[k].data(), dbm.data(), dim, l.data(), u.data()));
+        }
+      }
+    }
+  }
+
+  tchecker::dbm::simd::select(initial_isa);
+}
+
+TEST_CASE("Signatures of DBMs are compatible with inclusion", "[dbm]")
+{
+  std::mt19937 gen(17);
+  unsigned long rejected = 0;
+
+  for (tchecker::clock_id_t dim = 1; dim <= 7; ++dim) {
+    std::size_t const size = dim * dim;
+    std::vector<tchecker::integer_t> l(dim), u(dim);
+    std::vector<tchecker::dbm::db_t> dbm1(size), dbm2(size);
+
+    for (int k = 0; k < 2000; ++k) {
+      random_zone(dbm1.data(), dim, gen);
+      if (k % 3 == 0) {
+        // dbm1 is included in dbm2
+        tchecker::dbm::copy(dbm2.data(), dbm1.data(), dim);
+        tchecker::dbm::open_up(dbm2.data(), dim);
+      }
+      else
+        random_zone(dbm2.data(), dim, gen);
+      if (k % 2 == 0) {
+        // large constants
+        tchecker::dbm::scale_up(dbm1.data(), dim, 37);
+        tchecker::dbm::scale_up(dbm2.data(), dim, 37);
+      }
+      random_bounds(l.data(), dim, gen);
+      random_bounds(u.data(), dim, gen);
+
+      bool const sig_le = tchecker::dbm::signature_le(tchecker::dbm::signature(dbm1.data(), dim),
+                                                      tchecker::dbm::signature(dbm2.data(), dim));
+      if (tchecker::dbm::is_le(dbm1.data(), dbm2.data(), dim))
+        REQUIRE(sig_le);
+      else if (!sig_le)
+        ++rejected;
+
+      if (tchecker::dbm::is_alu_le(dbm1.data(), dbm2.data(), dim, l.data(), u.data()))
+        REQUIRE(tchecker::dbm::signature_le(tchecker::dbm::alu_signature(dbm1.data(), dim, l.data(), u.data()),
+                                            tchecker::dbm::alu_signature(dbm2.data(), dim, l.data(), u.data())));
+    }
+  }
+
+  REQUIRE(rejected > 0);
+}
+
+namespace {
+
+// Random clock constraints and resets on the dim-1 clocks of a DBM (ids as in a system)
+void random_constraints_and_resets(tchecker::clock_constraint_container_t & constraints,
+                                   tchecker::clock_reset_container_t & resets, tchecker::clock_id_t dim,
+                                   std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(-20, 20);
+  auto system_id = [](tchecker::clock_id_t x) { return (x == 0 ? tchecker::REFCLOCK_ID : x - 1); };
+
+  constraints.clear();
+  resets.clear();
+  if (dim == 1)
+    return;
+  for (int k = 0; k < 3; ++k) {
+    tchecker::clock_id_t x = clock(gen), y = clock(gen);
+    if (x == y)
+      continue;
+    constraints.emplace_back(system_id(x), system_id(y), (k % 2 == 0 ? tchecker::LE : tchecker::LT), value(gen));
+  }
+  for (int k = 0; k < 2; ++k) {
+    tchecker::clock_id_t x = 1 + clock(gen) % (dim - 1), y = clock(gen);
+    resets.emplace_back(system_id(x), system_id(y), std::abs(value(gen)) % 4);
+  }
+}
+
+} // namespace
+
+TEST_CASE("DBM operations specialized for a dimension agree with generic operations", "[dbm]")
+{
+  tchecker::dbm::simd::isa_t const initial_isa = tchecker::dbm::simd::selected_isa();
+  std::mt19937 gen(20241018);
+
+  for (tchecker::dbm::simd::isa_t isa : {tchecker::dbm::simd::ISA_SCALAR, initial_isa}) {
+    tchecker::dbm::simd::select(isa);
+    tchecker::dbm::kernels_t const & generic = tchecker::dbm::generic_kernels();
+
+    for (tchecker::clock_id_t dim = 1; dim <= tchecker::dbm::fixed_dim::MAX_DIM + 1; ++dim) {
+      tchecker::dbm::kernels_t const & k = tchecker::dbm::kernels(dim);
+      if (dim > tchecker::dbm::fixed_dim::MAX_DIM || !tchecker::dbm::simd::details::has_packed_encoding())
+        REQUIRE(k.dim == 0);
+      else
+        REQUIRE(k.dim == dim);
+
+      std::size_t const size = dim * dim;
+      std::vector<tchecker::dbm::db_t> dbm1(size), dbm2(size), expected(size), actual(size);
+      std::vector<tchecker::integer_t> l(dim), u(dim);
+      tchecker::clock_constraint_container_t constraints;
+      tchecker::clock_reset_container_t resets;
+
+      for (int round = 0; round < 20; ++round) {
+        random_zone(dbm1.data(), dim, gen);
+        random_zone(dbm2.data(), dim, gen);
+        random_bounds(l.data(), dim, gen);
+        random_bounds(u.data(), dim, gen);
+        random_constraints_and_resets(constraints, resets, dim, gen);
+
+        // tighten on a random non-tight matrix
+        std::uniform_int_distribution<int> entry(-40, 40);
+        for (tchecker::clock_id_t i = 0; i < dim; ++i)
+          for (tchecker::clock_id_t j = 0; j < dim; ++j) {
+            int e = entry(gen);
+            if (i == j)
+              expected[i * dim + j] = tchecker::dbm::LE_ZERO;
+            else if (e > 30)
+              expected[i * dim + j] = tchecker::dbm::LT_INFINITY;
+            else
+              expected[i * dim + j] = tchecker::dbm::db((e % 2 == 0 ? tchecker::LE : tchecker::LT), e);
+          }
+        actual = expected;
+        tchecker::dbm::status_t const status = generic.tighten(expected.data(), dim);
+        REQUIRE(k.tighten(actual.data(), dim) == status);
+        if (status != tchecker::dbm::EMPTY)
+          REQUIRE(expected == actual);
+
+        // constrain
+        expected = dbm1;
+        actual = dbm1;
+        tchecker::dbm::status_t const constrain_status = generic.constrain(expected.data(), dim, constraints);
+        REQUIRE(k.constrain(actual.data(), dim, constraints) == constrain_status);
+        if (constrain_status != tchecker::dbm::EMPTY)
+          REQUIRE(expected == actual);
+
+        // inclusion and equality
+        std::vector<tchecker::dbm::db_t> dbm1_copy = dbm1;
+        for (auto const & [d1, d2] :
+             {std::make_pair(&dbm1, &dbm2), std::make_pair(&dbm2, &dbm1), std::make_pair(&dbm1, &dbm1_copy)}) {
+          REQUIRE(k.is_le(d1->data(), d2->data(), dim) == generic.is_le(d1->data(), d2->data(), dim));
+          REQUIRE(k.is_equal(d1->data(), d2->data(), dim) == generic.is_equal(d1->data(), d2->data(), dim));
+          REQUIRE(k.is_alu_le(d1->data(), d2->data(), dim, l.data(), u.data()) ==
+                  generic.is_alu_le(d1->data(), d2->data(), dim, l.data(), u.data()));
+        }
+
+        // reset, free clock, delays
+        expected = dbm1;
+        actual = dbm1;
+        generic.reset(expected.data(), dim, resets);
+        k.reset(actual.data(), dim, resets);
+        REQUIRE(expected == actual);
+
+        generic.free_clock(expected.data(), dim, resets);
+        k.free_clock(actual.data(), dim, resets);
+        REQUIRE(expected == actual);
+
+        generic.open_up(expected.data(), dim);
+        k.open_up(actual.data(), dim);
+        REQUIRE(expected == actual);
+
+        expected = dbm2;
+        actual = dbm2;
+        generic.open_down(expected.data(), dim);
+        k.open_down(actual.data(), dim);
+        REQUIRE(expected == actual);
+
+        // extrapolations
+        for (auto const & [generic_op, op] : {std::make_pair(generic.extra_lu, k.extra_lu),
+                                              std::make_pair(generic.extra_lu_plus, k.extra_lu_plus)}) {
+          expected = dbm1;
+          actual = dbm1;
+          generic_op(expected.data(), dim, l.data(), u.data());
+          op(actual.data(), dim, l.data(), u.data());
+          REQUIRE(expected == actual);
+        }
+
+        for (auto const & [generic_op, op] :
+             {std::make_pair(generic.extra_m, k.extra_m), std::make_pair(generic.extra_m_plus, k.extra_m_plus)}) {
+          expected = dbm2;
+          actual = dbm2;
+          generic_op(expected.data(), dim, u.data());
+          op(actual.data(), dim, u.data());
+          REQUIRE(expected == actual);
+        }
+      }
+    }
+  }
+
+  tchecker::dbm::simd::select(initial_isa);
+}
+
+TEST_CASE("Specialized DBM operations microbenchmark", "[.][dbm-benchmark]")
+{
+  tchecker::dbm::simd::isa_t const initial_isa = tchecker::dbm::simd::selected_isa();
+  // Generic operations are compared to the operations specialized for each dimension. Vectorized kernels are
+  // disabled as the specialized table leaves them in place when they are selected
+  tchecker::dbm::simd::select(tchecker::dbm::simd::ISA_SCALAR);
+  std::mt19937 gen(1);
+
+  for (tchecker::clock_id_t dim : {2, 3, 4, 5, 6, 8, 12, 16}) {
+    std::size_t const size = dim * dim;
+    std::vector<tchecker::dbm::db_t> dbm1(size), dbm2(size), dbm(size);
+    std::vector<tchecker::integer_t> l(dim), u(dim);
+    tchecker::clock_constraint_container_t constraints;
+    tchecker::clock_reset_container_t resets;
+    random_zone(dbm1.data(), dim, gen);
+    random_zone(dbm2.data(), dim, gen);
+    random_bounds(l.data(), dim, gen);
+    random_bounds(u.data(), dim, gen);
+    random_constraints_and_resets(constraints, resets, dim, gen);
+
+    for (tchecker::dbm::kernels_t const * k : {&tchecker::dbm::generic_kernels(), &tchecker::dbm::kernels(dim)}) {
+      std::string const suffix = (k->dim == 0 ? " generic, dim " : " specialized, dim ") + std::to_string(dim);
+
+      BENCHMARK("tighten" + suffix)
+      {
+        tchecker::dbm::copy(dbm.data(), dbm1.data(), dim);
+        dbm[dim] = tchecker::dbm::LT_INFINITY;
+        return k->tighten(dbm.data(), dim);
+      };
+
+      BENCHMARK("constrain" + suffix)
+      {
+        tchecker::dbm::copy(dbm.data(), dbm1.data(), dim);
+        return k->constrain(dbm.data(), dim, constraints);
+      };
+
+      BENCHMARK("is_le" + suffix)
+      {
+        return k->is_le(dbm1.data(), dbm2.data(), dim) || k->is_le(dbm1.data(), dbm1.data(), dim);
+      };
+
+      BENCHMARK("reset" + suffix)
+      {
+        tchecker::dbm::copy(dbm.data(), dbm1.data(), dim);
+        k->reset(dbm.data(), dim, resets);
+        return dbm[0];
+      };
+
+      BENCHMARK("extra_lu_plus" + suffix)
+      {
+        tchecker::dbm::copy(dbm.data(), dbm1.data(), dim);
+        k->extra_lu_plus(dbm.data(), dim, l.data(), u.data());
+        return dbm[0];
+      };
+    }
+  }
+
+  tchecker::dbm::simd::select(initial_isa);
+}
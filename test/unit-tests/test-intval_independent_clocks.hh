@@ -0,0 +1,85 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("clock constraints and resets that do not depend on integer variables", "[intval_independent_clocks]")
+{
+  std::string model = "system:intval_independent_clocks \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  int:1:0:5:0:i \n\
+  event:a \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=5 && i<3} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x<=3 && i==1 && y>2 : do: x=0; i=i+1} \n\
+  edge:P:l0:l1:a{provided: x<=i : do: x=i} \n\
+  edge:P:l0:l1:a{do: x=y; y=0} \n\
+  edge:P:l0:l1:a{do: x=2+y} \n\
+  ";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  std::size_t const clock_nb = system.clocks_count(tchecker::VK_FLATTENED);
+
+  tchecker::clock_id_t const x = system.clock_variables().id("x");
+  tchecker::clock_id_t const y = system.clock_variables().id("y");
+  tchecker::loc_id_t const l0 = system.location(system.process_id("P"), "l0")->id();
+
+  SECTION("Conjuncts that read integer variables are ignored")
+  {
+    tchecker::clock_constraint_container_t c;
+    tchecker::ta::intval_independent_clock_constraints(system.guard(0), c);
+    REQUIRE(c.size() == 2);
+    REQUIRE(c[0] == tchecker::clock_constraint_t{x, tchecker::REFCLOCK_ID, tchecker::LE, 3});
+    REQUIRE(c[1] == tchecker::clock_constraint_t{tchecker::REFCLOCK_ID, y, tchecker::LT, -2});
+
+    tchecker::clock_constraint_container_t inv;
+    tchecker::ta::intval_independent_clock_constraints(system.invariant(l0), inv);
+    REQUIRE(inv.size() == 1);
+    REQUIRE(inv[0] == tchecker::clock_constraint_t{x, tchecker::REFCLOCK_ID, tchecker::LE, 5});
+
+    tchecker::clock_constraint_container_t none;
+    tchecker::ta::intval_independent_clock_constraints(system.guard(1), none);
+    REQUIRE(none.empty());
+  }
+
+  SECTION("Resets to constants and to unmodified clocks are computed")
+  {
+    tchecker::clock_reset_container_t r;
+    REQUIRE(tchecker::ta::intval_independent_clock_resets(clock_nb, system.statement(0), r));
+    REQUIRE(r.size() == 1);
+    REQUIRE(r[0] == tchecker::clock_reset_t{x, tchecker::REFCLOCK_ID, 0});
+
+    r.clear();
+    REQUIRE(tchecker::ta::intval_independent_clock_resets(clock_nb, system.statement(3), r));
+    REQUIRE(r.size() == 1);
+    REQUIRE(r[0] == tchecker::clock_reset_t{x, y, 2});
+  }
+
+  SECTION("Resets that depend on integer variables or on modified clocks are rejected")
+  {
+    tchecker::clock_reset_container_t r;
+    REQUIRE_FALSE(tchecker::ta::intval_independent_clock_resets(clock_nb, system.statement(1), r));
+    REQUIRE(r.empty());
+    REQUIRE_FALSE(tchecker::ta::intval_independent_clock_resets(clock_nb, system.statement(2), r));
+    REQUIRE(r.empty());
+  }
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/memoized_bytecode.hh"
+
+#include "utils.hh"
+
+TEST_CASE("memoized guards, statements and invariants", "[memoized_bytecode]")
+{
+  std::string model = "system:memoized \n\
+  event:a \n\
+  \n\
+  int:1:0:5:0:i \n\
+  int:3:0:2:0:t \n\
+  clock:1:x \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=3} \n\
+  location:P:l1{invariant: x<=i} \n\
+  edge:P:l0:l1:a{provided: x>=1 : do: x=0} \n\
+  edge:P:l1:l0:a{provided: i>0 && x>i : do: i=i+1} \n\
+  edge:P:l1:l1:a{provided: t[i]>0} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  unsigned short const flatvars_count = static_cast<unsigned short>(system.intvars_count(tchecker::VK_FLATTENED));
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(flatvars_count, flatvars_count);
+  tchecker::vm_t & vm = system.vm();
+
+  SECTION("Guards, statements and invariants that do not access integer variables are precomputed")
+  {
+    REQUIRE(system.memoized_invariant(0).intval_independent());
+    REQUIRE(system.memoized_guard(0).intval_independent());
+    REQUIRE(system.memoized_statement(0).intval_independent());
+  }
+
+  SECTION("Guards and invariants that read integer variables at static addresses are cached")
+  {
+    REQUIRE(system.memoized_invariant(1).cached());
+    REQUIRE(system.memoized_guard(1).cached());
+  }
+
+  SECTION("Statements that write integer variables and dynamic array accesses are interpreted")
+  {
+    REQUIRE_FALSE(system.memoized_statement(1).intval_independent());
+    REQUIRE_FALSE(system.memoized_statement(1).cached());
+    REQUIRE_FALSE(system.memoized_guard(2).intval_independent());
+    REQUIRE_FALSE(system.memoized_guard(2).cached());
+  }
+
+  SECTION("Memoized interpretation agrees with the virtual machine")
+  {
+    for (tchecker::integer_t value : {0, 1, 2, 0, 3, 1, 4, 5, 2, 0}) {
+      (*intval)[0] = value;
+
+      tchecker::clock_constraint_container_t memo_clkconstr, vm_clkconstr;
+      tchecker::clock_reset_container_t memo_clkreset, vm_clkreset;
+
+      REQUIRE(system.memoized_guard(1).run(vm, *intval, memo_clkconstr, memo_clkreset) ==
+              vm.run(system.guard_bytecode(1), *intval, vm_clkconstr, vm_clkreset));
+      REQUIRE(system.memoized_invariant(1).run(vm, *intval, memo_clkconstr, memo_clkreset) ==
+              vm.run(system.invariant_bytecode(1), *intval, vm_clkconstr, vm_clkreset));
+      REQUIRE(system.memoized_invariant(0).run(vm, *intval, memo_clkconstr, memo_clkreset) ==
+              vm.run(system.invariant_bytecode(0), *intval, vm_clkconstr, vm_clkreset));
+      REQUIRE(system.memoized_statement(0).run(vm, *intval, memo_clkconstr, memo_clkreset) ==
+              vm.run(system.statement_bytecode(0), *intval, vm_clkconstr, vm_clkreset));
+
+      REQUIRE(memo_clkconstr == vm_clkconstr);
+      REQUIRE(memo_clkreset == vm_clkreset);
+    }
+  }
+
+  tchecker::intval_destruct_and_deallocate(intval);
+}
@@ -0,0 +1,119 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <random>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/zg/minimal_zone.hh"
+#include "tchecker/zg/zone.hh"
+
+namespace {
+
+// Random non-empty tight zone with zero-weight cycles (resets and equalities)
+void random_minimal_test_zone(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(-10, 10);
+  std::uniform_int_distribution<int> op(0, 9);
+  std::vector<tchecker::dbm::db_t> copy(dim * dim);
+
+  tchecker::dbm::universal_positive(dbm, dim);
+  for (int step = 0; step < 3 * static_cast<int>(dim); ++step) {
+    tchecker::dbm::copy(copy.data(), dbm, dim);
+    tchecker::clock_id_t x = clock(gen), y = clock(gen);
+    tchecker::integer_t c = value(gen);
+    int o = op(gen);
+    if (x == y)
+      continue;
+    if (o < 5) {
+      enum tchecker::ineq_cmp_t cmp = (o % 2 == 0 ? tchecker::LE : tchecker::LT);
+      if (tchecker::dbm::constrain(dbm, dim, x, y, cmp, c) == tchecker::dbm::EMPTY)
+        tchecker::dbm::copy(dbm, copy.data(), dim);
+    }
+    else if (o < 7) {
+      if (tchecker::dbm::constrain(dbm, dim, x, y, tchecker::LE, c) == tchecker::dbm::EMPTY ||
+          tchecker::dbm::constrain(dbm, dim, y, x, tchecker::LE, -c) == tchecker::dbm::EMPTY)
+        tchecker::dbm::copy(dbm, copy.data(), dim);
+    }
+    else if (o < 9) {
+      if (x != 0)
+        tchecker::dbm::reset_to_value(dbm, dim, x, 0);
+    }
+    else
+      tchecker::dbm::open_up(dbm, dim);
+  }
+}
+
+} // namespace
+
+TEST_CASE("Minimal zones represent the same zone", "[minimal_zone]")
+{
+  std::mt19937 gen(1997);
+
+  for (tchecker::clock_id_t dim = 1; dim <= 12; ++dim) {
+    tchecker::zg::zone_t * zone = tchecker::zg::zone_allocate_and_construct(dim, dim);
+    tchecker::zg::zone_t * other = tchecker::zg::zone_allocate_and_construct(dim, dim);
+    std::vector<tchecker::dbm::db_t> decompressed(dim * dim);
+
+    for (int round = 0; round < 50; ++round) {
+      random_minimal_test_zone(zone->dbm(), dim, gen);
+      random_minimal_test_zone(other->dbm(), dim, gen);
+
+      tchecker::zg::minimal_zone_uptr_t minimal{tchecker::zg::minimal_zone_allocate_and_construct(*zone)};
+      REQUIRE(minimal->dim() == dim);
+      REQUIRE_FALSE(minimal->is_empty());
+      REQUIRE(minimal->size() <= dim * (dim - 1));
+
+      minimal->to_dbm(decompressed.data());
+      REQUIRE(tchecker::dbm::is_equal(decompressed.data(), zone->dbm(), dim));
+
+      // inclusion without decompression agrees with DBM inclusion
+      REQUIRE(minimal->contains(*zone));
+      REQUIRE((*other <= *minimal) == tchecker::dbm::is_le(other->dbm(), zone->dbm(), dim));
+    }
+
+    tchecker::zg::zone_destruct_and_deallocate(zone);
+    tchecker::zg::zone_destruct_and_deallocate(other);
+  }
+}
+
+TEST_CASE("Minimal constraint graph of simple zones", "[minimal_zone]")
+{
+  tchecker::clock_id_t const dim = 4;
+  std::vector<tchecker::dbm::db_t> dbm(dim * dim);
+  std::vector<tchecker::zg::minimal_edge_t> edges;
+
+  SECTION("Zero zone is a single zero cycle")
+  {
+    tchecker::dbm::zero(dbm.data(), dim);
+    tchecker::zg::minimal_graph(dbm.data(), dim, edges);
+    REQUIRE(edges.size() == dim);
+  }
+
+  SECTION("Universal positive zone only keeps x>=0")
+  {
+    tchecker::dbm::universal_positive(dbm.data(), dim);
+    tchecker::zg::minimal_graph(dbm.data(), dim, edges);
+    REQUIRE(edges.size() == dim - 1);
+    for (tchecker::zg::minimal_edge_t const & e : edges) {
+      REQUIRE(e.x == 0);
+      REQUIRE(e.db == tchecker::dbm::LE_ZERO);
+    }
+  }
+
+  SECTION("Empty zone")
+  {
+    tchecker::zg::zone_t * zone = tchecker::zg::zone_allocate_and_construct(dim, dim);
+    tchecker::dbm::empty(zone->dbm(), dim);
+    tchecker::zg::minimal_zone_uptr_t minimal{tchecker::zg::minimal_zone_allocate_and_construct(*zone)};
+    REQUIRE(minimal->is_empty());
+    REQUIRE(minimal->size() == 0);
+    REQUIRE(minimal->contains(*zone));
+    tchecker::zg::zone_destruct_and_deallocate(zone);
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/native.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/native.hh"
+
+#include "utils.hh"
+
+namespace {
+
+/*!
+ \brief Native bytecode that returns 7 and outputs a clock reset
+ */
+tchecker::integer_t native_seven(tchecker::intval_t &, tchecker::clock_constraint_container_t &,
+                                 tchecker::clock_reset_container_t & clkreset)
+{
+  clkreset.emplace_back(1, 0, 0);
+  return 7;
+}
+
+/*!
+ \brief Native model of a system where all guards, statements and invariants are native_seven
+ */
+struct test_native_model_t {
+  test_native_model_t(tchecker::ta::system_t const & system)
+      : invariants(system.locations_count(), &native_seven), guards(system.edges_count(), &native_seven),
+        statements(system.edges_count(), &native_seven)
+  {
+    model = {tchecker::ta::NATIVE_MODEL_VERSION,
+             "test",
+             tchecker::ta::fingerprint(system),
+             system.processes_count(),
+             system.clocks_count(tchecker::VK_FLATTENED),
+             system.intvars_count(tchecker::VK_FLATTENED),
+             system.locations_count(),
+             system.edges_count(),
+             invariants.data(),
+             guards.data(),
+             statements.data()};
+  }
+
+  std::vector<tchecker::native_bytecode_t> invariants, guards, statements;
+  tchecker::ta::native_model_t model;
+};
+
+std::string const native_model_declaration = "system:native \n\
+  event:a \n\
+  \n\
+  int:1:0:5:0:i \n\
+  int:3:0:2:0:t \n\
+  clock:1:x \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=3} \n\
+  location:P:l1{invariant: x<=i} \n\
+  edge:P:l0:l1:a{provided: x>=1 : do: x=0} \n\
+  edge:P:l1:l0:a{provided: i>0 && x>i : do: i=i+1} \n\
+  edge:P:l1:l1:a{provided: t[i]>0 : do: t[i]=-i} \n";
+
+} // end of anonymous namespace
+
+TEST_CASE("native compilation of bytecode", "[native]")
+{
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{
+      tchecker::test::parse(native_model_declaration)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+
+  SECTION("Guards, statements and invariants without local variables are compiled")
+  {
+    for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id) {
+      std::stringstream ss;
+      REQUIRE(tchecker::compile_native(ss, "f", system.invariant_bytecode(id)));
+      REQUIRE(ss.str().find("static tchecker::integer_t f(") == 0);
+    }
+    for (tchecker::edge_id_t id = 0; id < system.edges_count(); ++id) {
+      std::stringstream ss;
+      REQUIRE(tchecker::compile_native(ss, "f", system.guard_bytecode(id)));
+      REQUIRE(tchecker::compile_native(ss, "g", system.statement_bytecode(id)));
+    }
+  }
+
+  SECTION("Bytecode with local variables is not compiled")
+  {
+    tchecker::bytecode_t const bytecode[] = {tchecker::VM_PUSH_FRAME, tchecker::VM_POP_FRAME, tchecker::VM_PUSH, 1,
+                                             tchecker::VM_RET};
+    std::stringstream ss;
+    REQUIRE_FALSE(tchecker::compile_native(ss, "f", bytecode));
+    REQUIRE(ss.str().empty());
+  }
+
+  SECTION("Generated source defines a native model of the system")
+  {
+    std::stringstream ss;
+    tchecker::ta::compile_native(ss, system);
+    std::string const source = ss.str();
+    REQUIRE(source.find("#include \"tchecker/ta/native.hh\"") != std::string::npos);
+    REQUIRE(source.find("extern \"C\" tchecker::ta::native_model_t const * tchecker_native_model()") !=
+            std::string::npos);
+    REQUIRE(source.find(std::to_string(tchecker::ta::fingerprint(system)) + "ULL") != std::string::npos);
+  }
+}
+
+TEST_CASE("native models are installed in compatible systems", "[native]")
+{
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{
+      tchecker::test::parse(native_model_declaration)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t const reference{*sysdecl};
+  test_native_model_t native{reference};
+  unsigned short const flatvars_count = static_cast<unsigned short>(reference.intvars_count(tchecker::VK_FLATTENED));
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(flatvars_count, flatvars_count);
+
+  SECTION("Compatible system")
+  {
+    REQUIRE(tchecker::ta::native_compatible(reference, native.model));
+
+    tchecker::ta::set_native_model(&native.model);
+    tchecker::ta::system_t system{*sysdecl};
+    tchecker::ta::set_native_model(nullptr);
+
+    // memoized_guard(0) is independent from intvars: its value is precomputed before the native model is installed
+    REQUIRE(system.memoized_guard(1).native());
+    REQUIRE(system.memoized_statement(2).native());
+    REQUIRE(system.memoized_invariant(1).native());
+
+    tchecker::clock_constraint_container_t clkconstr;
+    tchecker::clock_reset_container_t clkreset;
+    REQUIRE(system.memoized_statement(2).run(system.vm(), *intval, clkconstr, clkreset) == 7);
+    REQUIRE(clkreset.size() == 1);
+    REQUIRE(clkconstr.empty());
+  }
+
+  SECTION("Incompatible system")
+  {
+    ++native.model.fingerprint;
+    REQUIRE_FALSE(tchecker::ta::native_compatible(reference, native.model));
+
+    tchecker::ta::set_native_model(&native.model);
+    tchecker::ta::system_t system{*sysdecl};
+    tchecker::ta::set_native_model(nullptr);
+
+    REQUIRE_FALSE(system.memoized_guard(1).native());
+    REQUIRE_FALSE(system.memoized_statement(2).native());
+    REQUIRE_FALSE(system.memoized_invariant(1).native());
+  }
+
+  SECTION("Systems with different bytecode have different fingerprints")
+  {
+    std::string declaration = native_model_declaration;
+    declaration.replace(declaration.find("x<=3"), 4, "x<=4");
+    std::shared_ptr<tchecker::parsing::system_declaration_t const> other_sysdecl{tchecker::test::parse(declaration)};
+    REQUIRE(other_sysdecl != nullptr);
+
+    tchecker::ta::system_t const other{*other_sysdecl};
+    REQUIRE(tchecker::ta::fingerprint(other) != tchecker::ta::fingerprint(reference));
+    REQUIRE_FALSE(tchecker::ta::native_compatible(other, native.model));
+  }
+
+  tchecker::intval_destruct_and_deallocate(intval);
+}
@@ -0,0 +1,196 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "tchecker/dbm/db.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/graph/soa_cover_graph.hh"
+
+// Node for testing SoA cover graph: zone 0<=x<=a && 0<=y<=b (empty if a < 0), n1 <= n2 iff same key and
+// zone of n1 included in zone of n2
+class soa_node_t : public tchecker::graph::cover::soa_node_t {
+public:
+  soa_node_t(int key, int a, int b) : _key(key), _a(a), _b(b) {}
+  int key() const { return _key; }
+  int a() const { return _a; }
+  int b() const { return _b; }
+
+private:
+  int _key;
+  int _a;
+  int _b;
+};
+
+using soa_node_sptr_t = std::shared_ptr<soa_node_t>;
+
+class soa_node_hash_t {
+public:
+  std::size_t operator()(soa_node_sptr_t const & n) const { return static_cast<std::size_t>(n->key() % 4); }
+};
+
+class soa_node_le_t {
+public:
+  bool operator()(soa_node_sptr_t const & n1, soa_node_sptr_t const & n2) const
+  {
+    return comparable(n1, n2) && (n1->a() < 0 || (n2->a() >= 0 && n1->a() <= n2->a() && n1->b() <= n2->b()));
+  }
+
+  bool comparable(soa_node_sptr_t const & n1, soa_node_sptr_t const & n2) const { return n1->key() == n2->key(); }
+
+  tchecker::clock_id_t dim(soa_node_sptr_t const & /*n*/) const { return 3; }
+
+  bool normalize(soa_node_sptr_t const & n, tchecker::dbm::db_t * dbm) const
+  {
+    if (n->a() < 0)
+      return false;
+    tchecker::dbm::universal_positive(dbm, 3);
+    tchecker::dbm::constrain(dbm, 3, 1, 0, tchecker::LE, n->a());
+    tchecker::dbm::constrain(dbm, 3, 2, 0, tchecker::LE, n->b());
+    return true;
+  }
+
+  void is_le_batch(soa_node_sptr_t const & /*n*/, tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch,
+                   std::size_t stride, std::size_t count, tchecker::clock_id_t dim, std::uint64_t * le) const
+  {
+    tchecker::dbm::is_le_batch(dbm, batch, stride, count, dim, le);
+  }
+
+  void is_ge_batch(soa_node_sptr_t const & /*n*/, tchecker::dbm::db_t const * dbm, tchecker::dbm::db_t const * batch,
+                   std::size_t stride, std::size_t count, tchecker::clock_id_t dim, std::uint64_t * ge) const
+  {
+    tchecker::dbm::is_ge_batch(dbm, batch, stride, count, dim, ge);
+  }
+};
+
+using soa_graph_t = tchecker::graph::cover::soa_graph_t<soa_node_sptr_t, soa_node_hash_t, soa_node_le_t>;
+
+TEST_CASE("SoA cover graph, batched covering checks", "[soa_cover_graph]")
+{
+  soa_graph_t g{16, soa_node_hash_t{}, soa_node_le_t{}};
+  g.set_batched(true);
+
+  soa_node_sptr_t n1 = std::make_shared<soa_node_t>(1, 5, 5);
+  soa_node_sptr_t n2 = std::make_shared<soa_node_t>(1, 3, 4);
+  soa_node_sptr_t n3 = std::make_shared<soa_node_t>(1, 8, 5);
+  soa_node_sptr_t n4 = std::make_shared<soa_node_t>(5, 1, 1);
+  soa_node_sptr_t n5 = std::make_shared<soa_node_t>(1, -1, 0);
+  soa_node_sptr_t covering{nullptr};
+  std::vector<soa_node_sptr_t> covered;
+  auto ins = std::back_inserter(covered);
+
+  SECTION("add, cover and remove")
+  {
+    g.add_node(n1);
+    REQUIRE(g.size() == 1);
+    REQUIRE_THROWS_AS(g.set_batched(false), std::invalid_argument);
+    REQUIRE(g.is_covered(n2, covering));
+    REQUIRE(covering == n1);
+    REQUIRE_FALSE(g.is_covered(n1, covering));
+    REQUIRE(covering == nullptr);
+    REQUIRE_FALSE(g.is_covered(n4, covering)); // same hash value, other key
+    REQUIRE_FALSE(g.is_covered(std::make_shared<soa_node_t>(1, 3, 6), covering));
+    g.covered_nodes(n3, ins);
+    REQUIRE(covered == std::vector<soa_node_sptr_t>{n1});
+    g.remove_node(n1);
+    REQUIRE(g.size() == 0);
+    REQUIRE_FALSE(g.is_covered(n2, covering));
+  }
+
+  SECTION("empty zones")
+  {
+    g.add_node(n5);
+    REQUIRE_FALSE(g.is_covered(n5, covering));
+    REQUIRE(g.is_covered(std::make_shared<soa_node_t>(1, -2, 0), covering));
+    REQUIRE(covering == n5);
+    g.add_node(n2);
+    REQUIRE(g.is_covered(n5, covering));
+    REQUIRE(covering == n2);
+    REQUIRE_FALSE(g.is_covered(n2, covering));
+    g.covered_nodes(n2, ins);
+    REQUIRE(covered == std::vector<soa_node_sptr_t>{n5});
+    g.remove_node(n5);
+    g.remove_node(n2);
+    REQUIRE(g.size() == 0);
+  }
+}
+
+TEST_CASE("SoA cover graph agrees with cover graph", "[soa_cover_graph]")
+{
+  // Nodes can only be stored in one graph: each node in soa has a copy in list
+  tchecker::graph::cover::graph_t<soa_node_sptr_t, soa_node_hash_t, soa_node_le_t> list{16, soa_node_hash_t{},
+                                                                                        soa_node_le_t{}};
+  soa_graph_t soa{16, soa_node_hash_t{}, soa_node_le_t{}};
+  soa.set_batched(true);
+
+  std::mt19937 gen(7);
+  // Zones are mostly incomparable to get large buckets
+  std::uniform_int_distribution<int> key(0, 5), a(-1, 1000), noise(0, 20);
+  std::vector<soa_node_sptr_t> list_nodes, soa_nodes;
+  soa_node_sptr_t covering_list{nullptr}, covering_soa{nullptr};
+  auto values = [](std::vector<soa_node_sptr_t> const & v) {
+    std::vector<std::pair<int, int>> values;
+    for (soa_node_sptr_t const & n : v)
+      values.emplace_back(n->key(), n->a() * 10000 + n->b());
+    std::sort(values.begin(), values.end());
+    return values;
+  };
+
+  for (int step = 0; step < 3000; ++step) {
+    if (!soa_nodes.empty() && gen() % 3 == 0) {
+      std::size_t k = gen() % soa_nodes.size();
+      list.remove_node(list_nodes[k]);
+      soa.remove_node(soa_nodes[k]);
+      list_nodes[k] = list_nodes.back();
+      list_nodes.pop_back();
+      soa_nodes[k] = soa_nodes.back();
+      soa_nodes.pop_back();
+
+      // positions of nodes in buckets are updated by removals
+      if (!soa_nodes.empty()) {
+        k = gen() % soa_nodes.size();
+        REQUIRE(list.is_covered(list_nodes[k], covering_list) == soa.is_covered(soa_nodes[k], covering_soa));
+        REQUIRE(covering_soa != soa_nodes[k]);
+      }
+      continue;
+    }
+
+    int const k = key(gen), va = a(gen), vb = 1000 - va + noise(gen);
+    soa_node_sptr_t n_list = std::make_shared<soa_node_t>(k, va, vb);
+    soa_node_sptr_t n_soa = std::make_shared<soa_node_t>(k, va, vb);
+    bool const covered_list = list.is_covered(n_list, covering_list);
+    bool const covered_soa = soa.is_covered(n_soa, covering_soa);
+    REQUIRE(covered_list == covered_soa);
+    if (covered_soa) {
+      REQUIRE(soa_node_le_t{}(n_soa, covering_soa));
+      continue;
+    }
+
+    std::vector<soa_node_sptr_t> covered_by_list, covered_by_soa;
+    auto ins_list = std::back_inserter(covered_by_list);
+    auto ins_soa = std::back_inserter(covered_by_soa);
+    list.covered_nodes(n_list, ins_list);
+    soa.covered_nodes(n_soa, ins_soa);
+    REQUIRE(values(covered_by_list) == values(covered_by_soa));
+
+    list.add_node(n_list);
+    list_nodes.push_back(n_list);
+    soa.add_node(n_soa);
+    soa_nodes.push_back(n_soa);
+  }
+
+  REQUIRE(list.size() == soa.size());
+  REQUIRE(soa.size() > 256);
+  soa.clear();
+  REQUIRE(soa.size() == 0);
+}
@@ -0,0 +1,273 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/graph/allocators.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/graph/spill_store.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/shared_objects.hh"
+#include "tchecker/utils/spill_file.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "utils.hh"
+
+namespace {
+
+/*!
+ \brief Model with several clocks, a loop and resets
+ */
+std::string const spill_store_model = "system:spill \n"
+                                      "event:a \n event:b \n"
+                                      "int:1:0:3:0:i \n"
+                                      "process:P \n"
+                                      "clock:1:x \n clock:1:y \n clock:1:z \n"
+                                      "location:P:l0{initial: : invariant:x<=4} \n"
+                                      "location:P:l1{invariant:y<=6} \n"
+                                      "edge:P:l0:l1:a{provided:x>=1 : do:y=0} \n"
+                                      "edge:P:l1:l0:b{provided:y>=2&&i<3 : do:x=0;i=i+1} \n"
+                                      "edge:P:l1:l1:a{provided:z<=5 : do:z=0} \n";
+
+/*!
+ \class spill_store_node_t
+ \brief Node that can be spilled, with a given hash value
+ */
+class spill_store_node_t : public tchecker::graph::node_compact_zg_state_t {
+public:
+  spill_store_node_t(tchecker::zg::state_sptr_t const & s, std::size_t hash)
+      : tchecker::graph::node_compact_zg_state_t(s), _hash(hash)
+  {
+  }
+
+  inline std::size_t hash() const { return _hash; }
+
+private:
+  std::size_t _hash;
+};
+
+using spill_store_shared_node_t = tchecker::make_shared_t<spill_store_node_t>;
+using spill_store_node_sptr_t = tchecker::intrusive_shared_ptr_t<spill_store_shared_node_t>;
+
+/*!
+ \brief Check that the zone of a compact node is a given zone
+ \param n : a compact node
+ \param dbm : a DBM
+ \return true if the minimal zone of n is the zone of dbm, false otherwise
+ */
+bool spill_store_same_zone(spill_store_node_t const & n, std::vector<tchecker::dbm::db_t> const & dbm)
+{
+  tchecker::zg::minimal_zone_t const & zone = n.minimal_zone();
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone.dim());
+  if (static_cast<std::size_t>(dim) * dim != dbm.size())
+    return false;
+  std::vector<tchecker::dbm::db_t> unpacked(dbm.size());
+  zone.to_dbm(unpacked.data());
+  return tchecker::dbm::is_equal(unpacked.data(), dbm.data(), dim);
+}
+
+} // namespace
+
+namespace tchecker {
+template <> class allocation_size_t<spill_store_node_t> {
+public:
+  template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... /*args*/)
+  {
+    return sizeof(spill_store_node_t);
+  }
+};
+} // namespace tchecker
+
+TEST_CASE("spill file", "[spill_store]")
+{
+  // small segments to allocate regions across several segments
+  tchecker::spill_file_t file{"", 4096};
+
+  SECTION("Data is read back after being paged out")
+  {
+    std::vector<unsigned char *> regions;
+    for (std::size_t i = 0; i < 5; ++i) {
+      unsigned char * r = static_cast<unsigned char *>(file.allocate(3000));
+      REQUIRE(reinterpret_cast<std::uintptr_t>(r) % alignof(std::max_align_t) == 0);
+      for (std::size_t j = 0; j < 3000; ++j)
+        r[j] = static_cast<unsigned char>(i + j);
+      regions.push_back(r);
+    }
+    REQUIRE(file.size() >= 5 * 3000);
+
+    for (unsigned char * r : regions)
+      file.page_out(r, 3000);
+    file.page_in(regions[2], 3000);
+
+    bool same = true;
+    for (std::size_t i = 0; i < regions.size(); ++i)
+      for (std::size_t j = 0; j < 3000; ++j)
+        same = same && (regions[i][j] == static_cast<unsigned char>(i + j));
+    REQUIRE(same);
+  }
+
+  SECTION("Regions larger than segments")
+  {
+    char * r = static_cast<char *>(file.allocate(3 * 4096 + 1));
+    std::memset(r, 'x', 3 * 4096 + 1);
+    file.page_out(r, 3 * 4096 + 1);
+    REQUIRE(r[0] == 'x');
+    REQUIRE(r[3 * 4096] == 'x');
+  }
+
+  SECTION("Deallocated regions are reused")
+  {
+    void * r1 = file.allocate(1024);
+    void * r2 = file.allocate(1024);
+    std::size_t const size = file.size();
+
+    file.deallocate(r1, 1024);
+    REQUIRE(file.size() < size);
+    REQUIRE(file.allocate(1024) == r1);
+    REQUIRE(file.size() == size);
+
+    // neighbour free regions are coalesced
+    file.deallocate(r1, 1024);
+    file.deallocate(r2, 1024);
+    REQUIRE(file.allocate(2048) == r1);
+  }
+
+  SECTION("Reused regions are backed by the file")
+  {
+    char * r = static_cast<char *>(file.allocate(4096));
+    std::memset(r, 'y', 4096);
+    file.deallocate(r, 4096);
+    char * s = static_cast<char *>(file.allocate(4096));
+    REQUIRE(s == r);
+    std::memset(s, 'z', 4096);
+    file.page_out(s, 4096);
+    REQUIRE(s[0] == 'z');
+    REQUIRE(s[4095] == 'z');
+  }
+}
+
+TEST_CASE("spill store", "[spill_store]")
+{
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(spill_store_model)};
+  REQUIRE(sysdecl != nullptr);
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  std::shared_ptr<tchecker::zg::zg_t> zg{tchecker::zg::factory(system, tchecker::ts::SHARING,
+                                                               tchecker::zg::ELAPSED_SEMANTICS,
+                                                               tchecker::zg::EXTRA_LU_PLUS_LOCAL, 64, 128)};
+
+  // First states of the zone graph (breadth-first, not checked for duplicates)
+  std::size_t const states_nb = 64;
+  std::vector<tchecker::zg::state_sptr_t> states;
+  std::deque<tchecker::zg::const_state_sptr_t> waiting;
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+  zg->initial(v);
+  while (states.size() < states_nb) {
+    for (auto && [status, s, t] : v)
+      if (states.size() < states_nb) {
+        states.push_back(s);
+        waiting.push_back(tchecker::zg::const_state_sptr_t{s});
+      }
+    v.clear();
+    if (waiting.empty())
+      break;
+    zg->next(waiting.front(), v);
+    waiting.pop_front();
+  }
+  waiting.clear();
+  REQUIRE(states.size() == states_nb);
+
+  // the pool of compact states outlives nodes, which outlive the spill store
+  tchecker::graph::compact_state_pool_t compact_pool;
+  tchecker::graph::node_pool_allocator_t<spill_store_shared_node_t> node_pool{states_nb};
+  std::vector<spill_store_node_sptr_t> nodes;
+  std::vector<std::vector<tchecker::dbm::db_t>> dbms;
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    tchecker::zg::zone_t const & zone = states[i]->zone();
+    dbms.emplace_back(zone.dbm(), zone.dbm() + zone.dim() * zone.dim());
+    nodes.push_back(node_pool.construct(states[i], i));
+  }
+  states.clear();
+
+  {
+    // a single partition, and a limit that is reached by the first node
+    tchecker::graph::spill_store_t<spill_store_node_sptr_t> store{compact_pool, 1, 1};
+
+    std::size_t bytes = 0;
+    for (spill_store_node_sptr_t const & n : nodes) {
+      n->compact(compact_pool);
+      store.add(n);
+      bytes += n->spill_size();
+    }
+    REQUIRE(store.over_limit());
+    REQUIRE(store.spilled_bytes() == 0);
+
+    store.spill();
+    REQUIRE_FALSE(store.over_limit());
+    REQUIRE(store.spilled_bytes() >= bytes);
+
+    bool spilled = true, same = true;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      spilled = spilled && nodes[i]->is_spilled();
+      same = same && spill_store_same_zone(*nodes[i], dbms[i]);
+    }
+    REQUIRE(spilled);
+    REQUIRE(same);
+
+    SECTION("Touched partitions are counted in main memory until they are spilled again")
+    {
+      store.touch(0);
+      REQUIRE(store.over_limit());
+      std::size_t const size = store.spilled_bytes();
+      store.spill();
+      REQUIRE_FALSE(store.over_limit());
+      REQUIRE(store.spilled_bytes() == size);
+    }
+
+    SECTION("Regions of removed nodes are reclaimed")
+    {
+      std::size_t const size = store.spilled_bytes();
+      std::size_t kept_bytes = 0;
+      for (std::size_t i = 0; i < nodes.size(); ++i)
+        if (i % 4 == 0)
+          kept_bytes += nodes[i]->spill_size();
+        else
+          nodes[i].reset(); // removed from the graph
+      store.touch(0);
+      store.spill();
+      REQUIRE(store.spilled_bytes() < size);
+      REQUIRE(store.spilled_bytes() >= kept_bytes);
+
+      bool kept = true;
+      for (std::size_t i = 0; i < nodes.size(); i += 4)
+        kept = kept && nodes[i]->is_spilled() && spill_store_same_zone(*nodes[i], dbms[i]);
+      REQUIRE(kept);
+    }
+
+    SECTION("States of spilled nodes are restored")
+    {
+      bool restored = true;
+      for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i]->restore(*zg, compact_pool);
+        tchecker::zg::zone_t const & zone = nodes[i]->state().zone();
+        restored = restored && !nodes[i]->is_compact() &&
+                   tchecker::dbm::is_equal(zone.dbm(), dbms[i].data(), static_cast<tchecker::clock_id_t>(zone.dim()));
+      }
+      REQUIRE(restored);
+    }
+  }
+
+  nodes.clear();
+  node_pool.destruct_all();
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ts/sharing.hh"
+#include "tchecker/zg/extrapolation.hh"
+#include "tchecker/zg/semantics.hh"
+#include "tchecker/zg/static_dispatch.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "utils.hh"
+
+namespace {
+
+// Explores zg and ref in lockstep (at most max_states states) and checks that they compute the same transitions
+template <class ZG> void check_same_transitions(ZG & zg, tchecker::zg::zg_t & ref, std::size_t max_states)
+{
+  std::vector<typename ZG::sst_t> v, ref_v;
+  std::deque<std::tuple<tchecker::zg::const_state_sptr_t, tchecker::zg::const_state_sptr_t>> waiting;
+
+  auto compare = [&]() {
+    REQUIRE(v.size() == ref_v.size());
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      REQUIRE(zg.status(v[i]) == ref.status(ref_v[i]));
+      REQUIRE(*zg.state(v[i]) == *ref.state(ref_v[i]));
+      REQUIRE(zg.transition(v[i])->vedge() == ref.transition(ref_v[i])->vedge());
+      waiting.emplace_back(zg.state(v[i]), ref.state(ref_v[i]));
+    }
+    v.clear();
+    ref_v.clear();
+  };
+
+  zg.initial(v);
+  ref.initial(ref_v);
+  REQUIRE(!v.empty());
+  compare();
+
+  for (std::size_t count = 0; count < max_states && !waiting.empty(); ++count) {
+    auto [s, ref_s] = waiting.front();
+    waiting.pop_front();
+    zg.next(s, v);
+    ref.next(ref_s, ref_v);
+    compare();
+  }
+}
+
+} // namespace
+
+TEST_CASE("statically dispatched zone graph", "[static_dispatch]")
+{
+  std::string model = "system:static_dispatch \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  int:1:0:2:0:i \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=2} \n\
+  location:P:l1{invariant: y<=3} \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:a{provided: x>=1 : do: y=0} \n\
+  edge:P:l1:l0:b{provided: y>=2 && i<2 : do: x=0; i=i+1} \n\
+  edge:P:l1:l2:a{provided: i==2} \n\
+  \n\
+  process:Q \n\
+  location:Q:q0{initial:} \n\
+  location:Q:q1 \n\
+  edge:Q:q0:q1:b{provided: y>5} \n\
+  edge:Q:q1:q0:a{do: y=0} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::size_t const block_size = 64;
+  std::size_t const table_size = 128;
+
+  SECTION("Elapsed semantics with local ExtraLU+ is statically dispatched and agrees with tchecker::zg::zg_t")
+  {
+    std::shared_ptr<tchecker::zg::zg_t> ref{tchecker::zg::factory(system, tchecker::ts::SHARING,
+                                                                  tchecker::zg::ELAPSED_SEMANTICS,
+                                                                  tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+
+    bool is_static = tchecker::zg::static_dispatch::visit(
+        system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size,
+        table_size, [&](auto const & zg) {
+          check_same_transitions(*zg, *ref, 200);
+          return std::is_same_v<typename std::decay_t<decltype(zg)>::element_type,
+                                tchecker::zg::static_dispatch::zg_t<tchecker::zg::elapsed_semantics_t,
+                                                                    tchecker::zg::local_extra_lu_plus_t>>;
+        });
+    REQUIRE(is_static);
+  }
+
+  SECTION("Elapsed semantics without extrapolation is statically dispatched and agrees with tchecker::zg::zg_t")
+  {
+    std::shared_ptr<tchecker::zg::zg_t> ref{tchecker::zg::factory(system, tchecker::ts::NO_SHARING,
+                                                                  tchecker::zg::ELAPSED_SEMANTICS,
+                                                                  tchecker::zg::NO_EXTRAPOLATION, block_size, table_size)};
+
+    bool is_static = tchecker::zg::static_dispatch::visit(
+        system, tchecker::ts::NO_SHARING, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, block_size,
+        table_size, [&](auto const & zg) {
+          check_same_transitions(*zg, *ref, 200);
+          return std::is_same_v<
+              typename std::decay_t<decltype(zg)>::element_type,
+              tchecker::zg::static_dispatch::zg_t<tchecker::zg::elapsed_semantics_t, tchecker::zg::no_extrapolation_t>>;
+        });
+    REQUIRE(is_static);
+  }
+
+  SECTION("Other semantics and extrapolations fall back to tchecker::zg::zg_t")
+  {
+    std::shared_ptr<tchecker::zg::zg_t> ref{tchecker::zg::factory(system, tchecker::ts::SHARING,
+                                                                  tchecker::zg::STANDARD_SEMANTICS,
+                                                                  tchecker::zg::EXTRA_M_GLOBAL, block_size, table_size)};
+
+    bool is_dynamic = tchecker::zg::static_dispatch::visit(
+        system, tchecker::ts::SHARING, tchecker::zg::STANDARD_SEMANTICS, tchecker::zg::EXTRA_M_GLOBAL, block_size,
+        table_size, [&](auto const & zg) {
+          check_same_transitions(*zg, *ref, 200);
+          return std::is_same_v<typename std::decay_t<decltype(zg)>::element_type, tchecker::zg::zg_t>;
+        });
+    REQUIRE(is_dynamic);
+  }
+}
+
+TEST_CASE("statically dispatched zone graph with diagonal constraints", "[static_dispatch]")
+{
+  std::string model = "system:static_dispatch_diagonal \n\
+  event:a \n\
+  \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  clock:1:z \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x<=4} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x-y<=1 && z>=2 : do: x=0} \n\
+  edge:P:l1:l0:a{provided: x>=1 : do: y=0; z=0} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::size_t const block_size = 64;
+  std::size_t const table_size = 128;
+
+  std::shared_ptr<tchecker::zg::zg_t> ref{tchecker::zg::factory(system, tchecker::ts::SHARING,
+                                                                tchecker::zg::ELAPSED_SEMANTICS,
+                                                                tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF, block_size, table_size)};
+
+  bool is_static = tchecker::zg::static_dispatch::visit(
+      system, tchecker::ts::SHARING, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL_DF, block_size,
+      table_size, [&](auto const & zg) {
+        check_same_transitions(*zg, *ref, 200);
+        return std::is_same_v<typename std::decay_t<decltype(zg)>::element_type,
+                              tchecker::zg::static_dispatch::zg_t<tchecker::zg::elapsed_semantics_t,
+                                                                  tchecker::zg::local_extra_lu_plus_df_t>>;
+      });
+  REQUIRE(is_static);
+}
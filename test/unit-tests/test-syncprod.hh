@@ -0,0 +1,195 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/edges_iterators.hh"
+#include "tchecker/syncprod/syncprod.hh"
+#include "tchecker/ta/system.hh"
+
+#include "utils.hh"
+
+namespace {
+
+/*!
+ \brief Model with strong and weak synchronizations, asynchronous edges and a committed location
+ */
+std::string const syncprod_model = "system:sync_index \n\
+  event:a \n event:b \n event:c \n event:d \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{committed:} \n\
+  location:P1:l2 \n\
+  edge:P1:l0:l1:a \n\
+  edge:P1:l0:l2:b \n\
+  edge:P1:l1:l2:c \n\
+  edge:P1:l2:l0:d \n\
+  \n\
+  process:P2 \n\
+  location:P2:m0{initial:} \n\
+  location:P2:m1 \n\
+  edge:P2:m0:m1:a \n\
+  edge:P2:m1:m0:b \n\
+  edge:P2:m1:m1:c \n\
+  edge:P2:m0:m0:d \n\
+  \n\
+  process:P3 \n\
+  location:P3:n0{initial:} \n\
+  location:P3:n1 \n\
+  edge:P3:n0:n1:b \n\
+  edge:P3:n1:n0:c \n\
+  edge:P3:n1:n1:d \n\
+  \n\
+  sync:P1@a:P2@a \n\
+  sync:P1@b:P2@b?:P3@b \n\
+  sync:P1@c:P3@c? \n\
+  sync:P2@c:P3@c \n\
+  sync:P2@d?:P3@d? \n";
+
+/*!
+ \brief Synchronizations from a tuple of locations, by scanning all synchronizations
+ \param system : a system
+ \param vloc : tuple of locations
+ \param loc_edges_maps : maps location ID -> edges/events
+ \param committed : committed processes, none to keep all synchronizations
+ \return identifiers of synchronizations such that every strongly synchronized process has an edge from vloc, some
+ process has an edge from vloc, and some committed process has an edge from vloc if committed has any process, by
+ increasing identifiers
+ */
+std::vector<tchecker::sync_id_t> syncprod_scanned_synchronizations(tchecker::syncprod::system_t const & system,
+                                                                   tchecker::vloc_t const & vloc,
+                                                                   tchecker::system::loc_edges_maps_t const & loc_edges_maps,
+                                                                   boost::dynamic_bitset<> const & committed)
+{
+  std::vector<tchecker::sync_id_t> ids;
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations()) {
+    bool enabled = true, instance = false, involves_committed = false;
+    for (tchecker::system::sync_constraint_t const & constr : sync.synchronization_constraints()) {
+      bool const has_edge = loc_edges_maps.event(vloc[constr.pid()], constr.event_id());
+      enabled = enabled && (has_edge || constr.strength() == tchecker::SYNC_WEAK);
+      instance = instance || has_edge;
+      involves_committed = involves_committed || (has_edge && committed[constr.pid()]);
+    }
+    if (enabled && instance && (committed.none() || involves_committed))
+      ids.push_back(sync.id());
+  }
+  return ids;
+}
+
+/*!
+ \brief Type of outgoing edges: synchronization identifier and edge identifiers
+ */
+using syncprod_edges_t = std::vector<std::tuple<tchecker::sync_id_t, std::vector<tchecker::edge_id_t>>>;
+
+/*!
+ \brief Reachable tuples of locations
+ \param syncprod : synchronized product
+ \return reachable tuples of locations in syncprod, and their outgoing edges in enumeration order
+ \post every state has been checked against syncprod_scanned_synchronizations (see REQUIRE)
+ */
+std::map<std::vector<tchecker::loc_id_t>, syncprod_edges_t> syncprod_explore(tchecker::syncprod::syncprod_t & syncprod)
+{
+  tchecker::syncprod::system_t const & system = syncprod.system();
+  std::map<std::vector<tchecker::loc_id_t>, syncprod_edges_t> vlocs;
+  std::deque<tchecker::syncprod::const_state_sptr_t> waiting;
+  std::vector<tchecker::syncprod::syncprod_t::sst_t> v;
+
+  syncprod.initial(v);
+  while (true) {
+    for (auto && [status, s, t] : v) {
+      std::vector<tchecker::loc_id_t> const key(s->vloc().begin(), s->vloc().end());
+      if (vlocs.find(key) != vlocs.end())
+        continue;
+
+      tchecker::const_vloc_sptr_t const vloc{s->vloc_ptr()};
+      syncprod_edges_t & edges = vlocs[key];
+      for (auto && sync_edges : tchecker::syncprod::outgoing_edges(system, vloc)) {
+        std::vector<tchecker::edge_id_t> ids;
+        for (tchecker::system::edge_const_shared_ptr_t const & edge : sync_edges.edges)
+          ids.push_back(edge->id());
+        edges.emplace_back(sync_edges.sync_id, ids);
+      }
+
+      // synchronized edges are instances of the enabled synchronizations
+      std::vector<tchecker::sync_id_t> const expected = syncprod_scanned_synchronizations(
+          system, *vloc, *system.outgoing_edges_maps(), tchecker::syncprod::committed_processes(system, vloc));
+      std::vector<tchecker::sync_id_t> sync_ids;
+      for (auto && [sync_id, ids] : edges)
+        if (sync_id != tchecker::NO_SYNC && (sync_ids.empty() || sync_ids.back() != sync_id))
+          sync_ids.push_back(sync_id);
+      REQUIRE(sync_ids == expected);
+
+      // incoming synchronized edges are instances of the synchronizations enabled w.r.t. incoming edges
+      std::vector<tchecker::sync_id_t> const expected_incoming = syncprod_scanned_synchronizations(
+          system, *vloc, *system.incoming_edges_maps(), boost::dynamic_bitset<>(system.processes_count()));
+      std::vector<tchecker::sync_id_t> incoming_ids;
+      for (auto && sync_edges : tchecker::syncprod::incoming_synchronized_edges(system, vloc))
+        if (incoming_ids.empty() || incoming_ids.back() != sync_edges.sync_id)
+          incoming_ids.push_back(sync_edges.sync_id);
+      REQUIRE(incoming_ids == expected_incoming);
+      REQUIRE(tchecker::syncprod::incoming_synchronizations(system, *vloc) == expected_incoming);
+
+      // enabled synchronizations are computed from the index of locations
+      REQUIRE(tchecker::syncprod::compute_enabled_synchronizations(system, vloc).synchronizations == expected);
+      if (vloc->id() == tchecker::NO_VLOC_ID)
+        REQUIRE_THROWS_AS(tchecker::syncprod::enabled_synchronizations(system, vloc), std::invalid_argument);
+      else {
+        tchecker::syncprod::enabled_synchronizations_t const & enabled =
+            tchecker::syncprod::enabled_synchronizations(system, vloc);
+        REQUIRE(enabled.synchronizations == expected);
+        REQUIRE(&tchecker::syncprod::enabled_synchronizations(system, vloc) == &enabled);
+      }
+
+      waiting.push_back(tchecker::syncprod::const_state_sptr_t{s});
+    }
+    v.clear();
+    if (waiting.empty())
+      break;
+    syncprod.next(waiting.front(), v);
+    waiting.pop_front();
+  }
+  return vlocs;
+}
+
+} // namespace
+
+TEST_CASE("enabled synchronizations", "[syncprod]")
+{
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(syncprod_model)};
+  REQUIRE(sysdecl != nullptr);
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  std::shared_ptr<tchecker::syncprod::system_t const> syncprod_system{system, &system->as_syncprod_system()};
+
+  tchecker::syncprod::syncprod_t shared{syncprod_system, tchecker::ts::SHARING, 64, 128};
+  tchecker::syncprod::syncprod_t not_shared{syncprod_system, tchecker::ts::NO_SHARING, 64, 128};
+
+  // synchronizations are memoized in shared tuples of locations, and checked on the fly otherwise
+  std::map<std::vector<tchecker::loc_id_t>, syncprod_edges_t> const shared_vlocs = syncprod_explore(shared);
+  std::map<std::vector<tchecker::loc_id_t>, syncprod_edges_t> const vlocs = syncprod_explore(not_shared);
+
+  REQUIRE(vlocs.size() > 4);
+  REQUIRE(shared_vlocs == vlocs);
+
+  // from <l1,m1,n0>, P1 is committed: only P1@c:P3@c? is enabled, and P3 has no c-edge
+  tchecker::loc_id_t const l1 = system->location(system->process_id("P1"), "l1")->id();
+  tchecker::loc_id_t const m1 = system->location(system->process_id("P2"), "m1")->id();
+  tchecker::loc_id_t const n0 = system->location(system->process_id("P3"), "n0")->id();
+  auto it = vlocs.find(std::vector<tchecker::loc_id_t>{l1, m1, n0});
+  REQUIRE(it != vlocs.end());
+  REQUIRE(it->second.size() == 1);
+  REQUIRE(std::get<0>(it->second[0]) == 2);
+  REQUIRE(std::get<1>(it->second[0]).size() == 1);
+}
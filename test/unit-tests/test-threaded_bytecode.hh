@@ -0,0 +1,300 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/clocks.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/vm/threaded_bytecode.hh"
+#include "tchecker/vm/vm.hh"
+
+#include "utils.hh"
+
+namespace {
+
+/*!
+ \brief Example models: generator scripts in directory examples/ with their arguments
+ */
+std::vector<std::string> const threaded_bytecode_examples = {
+    "ad94.sh",
+    "corsso.sh 2 2 10 1 2",
+    "critical-region.sh 2 10",
+    "critical-region-async.sh 2 10",
+    "csmacd.sh 3",
+    "dining-philosophers.sh 3 3 10 0",
+    "fddi.sh 3",
+    "fire-alarm.sh 2",
+    "fischer.sh 3 10",
+    "fischer-async.sh 3 10",
+    "fischer-async-concurrent.sh 3 10",
+    "gps-mc.sh 2 2 2 10",
+    "job-shop.sh 2 2 3 10 1",
+    "leader-election.sh 3 10",
+    "leader-election-async.sh 3 10",
+    "parallel.sh 3",
+    "parallel-b.sh 3",
+    "parallel-c.sh 3",
+    "train_gate.sh 3",
+};
+
+/*!
+ \brief Generate an example model
+ \param example : generator script in TCK_EXAMPLES_DIR with its arguments
+ \return the model output by the generator
+ */
+std::string generate_example(std::string const & example)
+{
+  std::string const command = "bash " TCK_EXAMPLES_DIR "/" + example;
+  std::FILE * f = ::popen(command.c_str(), "r");
+  if (f == nullptr)
+    throw std::runtime_error("cannot run " + command);
+  std::string model;
+  char buffer[4096];
+  std::size_t n;
+  while ((n = std::fread(buffer, 1, sizeof(buffer), f)) > 0)
+    model.append(buffer, n);
+  ::pclose(f);
+  return model;
+}
+
+/*!
+ \brief Outcome of the interpretation of a bytecode
+ */
+struct outcome_t {
+  std::string exception;                            /*!< Exception type ("" if none) */
+  tchecker::integer_t value;                        /*!< Computed value */
+  std::vector<tchecker::integer_t> intval;          /*!< Valuation after interpretation */
+  tchecker::clock_constraint_container_t clkconstr; /*!< Output clock constraints */
+  tchecker::clock_reset_container_t clkreset;       /*!< Output clock resets */
+
+  bool operator==(outcome_t const & o) const
+  {
+    return exception == o.exception && (!exception.empty() || value == o.value) && intval == o.intval &&
+           clkconstr == o.clkconstr && clkreset == o.clkreset;
+  }
+};
+
+/*!
+ \brief Interpret a bytecode
+ \param run : interpreter
+ \param values : valuation of integer variables
+ \return outcome of run on a copy of values
+ */
+template <class RUN> outcome_t interpret(RUN && run, std::vector<tchecker::integer_t> const & values)
+{
+  unsigned short const size = static_cast<unsigned short>(values.size());
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(size, size);
+  for (unsigned short i = 0; i < size; ++i)
+    (*intval)[i] = values[i];
+
+  outcome_t outcome;
+  outcome.value = 0;
+  try {
+    outcome.value = run(*intval, outcome.clkconstr, outcome.clkreset);
+  }
+  catch (std::out_of_range const &) {
+    outcome.exception = "std::out_of_range";
+  }
+  catch (std::runtime_error const &) {
+    outcome.exception = "std::runtime_error";
+  }
+  for (unsigned short i = 0; i < size; ++i)
+    outcome.intval.push_back((*intval)[i]);
+
+  tchecker::intval_destruct_and_deallocate(intval);
+  return outcome;
+}
+
+/*!
+ \brief Valuations of integer variables of a system
+ \param system : a system
+ \param count : number of random valuations
+ \return the initial valuation and count valuations drawn in the domains of the variables of system, as well as
+ just outside of them (to exercise out-of-bounds accesses)
+ */
+std::vector<std::vector<tchecker::integer_t>> valuations(tchecker::ta::system_t const & system, std::size_t count)
+{
+  auto const & flattened = system.integer_variables().flattened();
+  std::size_t const size = system.intvars_count(tchecker::VK_FLATTENED);
+  std::mt19937 generator(2024);
+
+  std::vector<std::vector<tchecker::integer_t>> valuations;
+  std::vector<tchecker::integer_t> initial;
+  for (tchecker::intvar_id_t id = 0; id < size; ++id)
+    initial.push_back(flattened.info(id).initial_value());
+  valuations.push_back(initial);
+
+  for (std::size_t k = 0; k < count; ++k) {
+    std::vector<tchecker::integer_t> values;
+    for (tchecker::intvar_id_t id = 0; id < size; ++id) {
+      auto const & info = flattened.info(id);
+      std::uniform_int_distribution<long long> distribution(static_cast<long long>(info.min()) - (k % 4 == 3 ? 1 : 0),
+                                                            static_cast<long long>(info.max()));
+      values.push_back(static_cast<tchecker::integer_t>(distribution(generator)));
+    }
+    valuations.push_back(values);
+  }
+  return valuations;
+}
+
+/*!
+ \brief Check that threaded bytecode and tchecker::vm_t agree
+ \param bytecode : bytecode
+ \param valuations : valuations of integer variables
+ \return number of valuations where threaded bytecode and tchecker::vm_t disagree
+ */
+std::size_t disagreements(tchecker::bytecode_t const * bytecode, std::vector<std::vector<tchecker::integer_t>> const & valuations)
+{
+  tchecker::vm_t vm;
+  tchecker::threaded_bytecode_t threaded(bytecode);
+  std::size_t count = 0;
+  for (auto const & values : valuations) {
+    outcome_t const reference = interpret(
+        [&](tchecker::intval_t & intval, tchecker::clock_constraint_container_t & clkconstr,
+            tchecker::clock_reset_container_t & clkreset) { return vm.run(bytecode, intval, clkconstr, clkreset); },
+        values);
+    outcome_t const outcome = interpret(
+        [&](tchecker::intval_t & intval, tchecker::clock_constraint_container_t & clkconstr,
+            tchecker::clock_reset_container_t & clkreset) { return threaded.run(vm, intval, clkconstr, clkreset); },
+        values);
+    if (!(reference == outcome))
+      ++count;
+  }
+  return count;
+}
+
+} // end of anonymous namespace
+
+TEST_CASE("threaded bytecode agrees with the virtual machine on example models", "[threaded_bytecode]")
+{
+  for (std::string const & example : threaded_bytecode_examples) {
+    SECTION(example)
+    {
+      std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(generate_example(example))};
+      REQUIRE(sysdecl != nullptr);
+
+      tchecker::ta::system_t system{*sysdecl};
+      auto const vals = valuations(system, 64);
+
+      std::size_t threaded = 0, total = 0;
+      for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id) {
+        REQUIRE(disagreements(system.invariant_bytecode(id), vals) == 0);
+        threaded += tchecker::threaded_bytecode_t(system.invariant_bytecode(id)).threaded() ? 1 : 0;
+        ++total;
+      }
+      for (tchecker::edge_id_t id = 0; id < system.edges_count(); ++id) {
+        REQUIRE(disagreements(system.guard_bytecode(id), vals) == 0);
+        REQUIRE(disagreements(system.statement_bytecode(id), vals) == 0);
+        threaded += tchecker::threaded_bytecode_t(system.guard_bytecode(id)).threaded() ? 1 : 0;
+        threaded += tchecker::threaded_bytecode_t(system.statement_bytecode(id)).threaded() ? 1 : 0;
+        total += 2;
+      }
+      REQUIRE(threaded == total); // example models do not declare local variables
+    }
+  }
+}
+
+TEST_CASE("threaded bytecode with jumps, local variables and failures", "[threaded_bytecode]")
+{
+  std::string model = "system:threaded \n\
+  event:a \n\
+  \n\
+  int:1:0:5:0:i \n\
+  int:1:-3:3:0:j \n\
+  int:3:0:2:0:t \n\
+  clock:2:x \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial: : invariant: x[0]<=3 && x[1]<=i} \n\
+  location:P:l1{invariant: x[0]-x[1]<i+1} \n\
+  edge:P:l0:l1:a{provided: x[0]>=1 && (i==2 || j<0) : do: x[0]=0; x[1]=x[0]; if (j<0) then i=1 else i=i+1 end} \n\
+  edge:P:l1:l0:a{provided: t[i]>0 && j!=i : do: t[j]=i; j=-j} \n\
+  edge:P:l1:l1:a{provided: x[1]==j && !(i<=1) : do: while (i < 5) do i=i+1; j=i/2 end; if (t[0] == 1) then t[1]=2 else t[2]=1 end} \n\
+  edge:P:l0:l0:a{do: local k = i; local l = k + 1; i = l % 3} \n";
+
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  auto const vals = valuations(system, 256);
+
+  for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id)
+    REQUIRE(disagreements(system.invariant_bytecode(id), vals) == 0);
+  for (tchecker::edge_id_t id = 0; id < system.edges_count(); ++id) {
+    REQUIRE(disagreements(system.guard_bytecode(id), vals) == 0);
+    REQUIRE(disagreements(system.statement_bytecode(id), vals) == 0);
+  }
+
+  REQUIRE(tchecker::threaded_bytecode_t(system.statement_bytecode(2)).threaded());
+  REQUIRE_FALSE(tchecker::threaded_bytecode_t(system.statement_bytecode(3)).threaded());
+}
+
+TEST_CASE("virtual machine microbenchmark", "[.][vm-benchmark]")
+{
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> sysdecl{
+      tchecker::test::parse(generate_example("fischer.sh 10 10"))};
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  auto const vals = valuations(system, 16);
+  std::size_t const size = system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::intval_t * intval = tchecker::intval_allocate_and_construct(static_cast<unsigned short>(size),
+                                                                         static_cast<unsigned short>(size));
+
+  std::vector<tchecker::bytecode_t const *> bytecodes;
+  for (tchecker::edge_id_t id = 0; id < system.edges_count(); ++id) {
+    bytecodes.push_back(system.guard_bytecode(id));
+    bytecodes.push_back(system.statement_bytecode(id));
+  }
+  for (tchecker::loc_id_t id = 0; id < system.locations_count(); ++id)
+    bytecodes.push_back(system.invariant_bytecode(id));
+
+  std::vector<tchecker::threaded_bytecode_t> threaded(bytecodes.begin(), bytecodes.end());
+  tchecker::vm_t vm;
+  tchecker::clock_constraint_container_t clkconstr;
+  tchecker::clock_reset_container_t clkreset;
+
+  auto load = [&](std::size_t k) {
+    for (std::size_t i = 0; i < size; ++i)
+      (*intval)[static_cast<unsigned short>(i)] = vals[k % vals.size()][i];
+    clkconstr.clear();
+    clkreset.clear();
+  };
+
+  BENCHMARK("tchecker::vm_t")
+  {
+    tchecker::integer_t sum = 0;
+    for (std::size_t k = 0; k < vals.size(); ++k) {
+      load(k);
+      for (tchecker::bytecode_t const * bytecode : bytecodes)
+        sum += vm.run(bytecode, *intval, clkconstr, clkreset);
+    }
+    return sum;
+  };
+
+  BENCHMARK("tchecker::threaded_bytecode_t")
+  {
+    tchecker::integer_t sum = 0;
+    for (std::size_t k = 0; k < vals.size(); ++k) {
+      load(k);
+      for (tchecker::threaded_bytecode_t & t : threaded)
+        sum += t.run(vm, *intval, clkconstr, clkreset);
+    }
+    return sum;
+  };
+
+  tchecker::intval_destruct_and_deallocate(intval);
+}
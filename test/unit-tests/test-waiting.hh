@@ -5,12 +5,15 @@
  *
  */
 
+#include <algorithm>
 #include <vector>
 
 #include "tchecker/waiting/pqueue.hh"
 #include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/random.hh"
 #include "tchecker/waiting/stack.hh"
 #include "tchecker/waiting/waiting.hh"
+#include "tchecker/waiting/work_stealing.hh"
 
 /*!
  \class int_element_t
@@ -914,3 +917,152 @@ TEST_CASE("fast remove waiting priority queue", "[waiting]")
     REQUIRE(non_empty_queue.empty());
   }
 }
+
+TEST_CASE("waiting random container", "[waiting]")
+{
+  tchecker::waiting::random_t<int> empty_random, non_empty_random{17};
+  for (int i = 0; i < 100; ++i)
+    non_empty_random.insert(i);
+
+  SECTION("empty")
+  {
+    REQUIRE(empty_random.empty());
+    REQUIRE_FALSE(non_empty_random.empty());
+  }
+
+  SECTION("first element is stable until it is removed")
+  {
+    int x = non_empty_random.first();
+    non_empty_random.insert(100);
+    REQUIRE(non_empty_random.first() == x);
+    non_empty_random.remove_first();
+    non_empty_random.remove(x);
+    REQUIRE_FALSE(non_empty_random.empty());
+  }
+
+  SECTION("every element is removed exactly once")
+  {
+    std::vector<int> removed;
+    while (!non_empty_random.empty()) {
+      removed.push_back(non_empty_random.first());
+      non_empty_random.remove_first();
+    }
+    REQUIRE(removed.size() == 100);
+    REQUIRE_FALSE(std::is_sorted(removed.begin(), removed.end()));
+    std::sort(removed.begin(), removed.end());
+    for (int i = 0; i < 100; ++i)
+      REQUIRE(removed[i] == i);
+  }
+
+  SECTION("same seed, same order")
+  {
+    tchecker::waiting::random_t<int> other{17};
+    for (int i = 0; i < 100; ++i)
+      other.insert(i);
+    while (!non_empty_random.empty()) {
+      REQUIRE(non_empty_random.first() == other.first());
+      non_empty_random.remove_first();
+      other.remove_first();
+    }
+    REQUIRE(other.empty());
+  }
+
+  SECTION("remove element")
+  {
+    for (int i = 0; i < 100; i += 2)
+      non_empty_random.remove(i);
+    std::size_t count = 0;
+    while (!non_empty_random.empty()) {
+      REQUIRE(non_empty_random.first() % 2 == 1);
+      non_empty_random.remove_first();
+      ++count;
+    }
+    REQUIRE(count == 50);
+  }
+
+  SECTION("clear")
+  {
+    non_empty_random.clear();
+    REQUIRE(non_empty_random.empty());
+  }
+}
+
+TEST_CASE("fast remove waiting random container", "[waiting]")
+{
+  using int_sptr_t = std::shared_ptr<int_element_t>;
+
+  std::vector<int_sptr_t> v;
+  for (int i = 0; i < 10; ++i)
+    v.emplace_back(new int_element_t{i});
+
+  tchecker::waiting::fast_remove_random_t<int_sptr_t> non_empty_random{3};
+  for (int_sptr_t const & p : v)
+    non_empty_random.insert(p);
+
+  SECTION("removed elements are not returned")
+  {
+    non_empty_random.remove(v[2]);
+    non_empty_random.remove(v[7]);
+    std::size_t count = 0;
+    while (!non_empty_random.empty()) {
+      REQUIRE(non_empty_random.first()->x() != 2);
+      REQUIRE(non_empty_random.first()->x() != 7);
+      non_empty_random.remove_first();
+      ++count;
+    }
+    REQUIRE(count == 8);
+  }
+}
+
+TEST_CASE("work-stealing waiting containers", "[waiting]")
+{
+  SECTION("queue policy")
+  {
+    tchecker::waiting::work_stealing_t<int> ws{2, tchecker::waiting::QUEUE};
+    ws.insert(0, 1);
+    ws.insert(0, 2);
+    int x = 0;
+    REQUIRE(ws.take(0, x));
+    REQUIRE(x == 1);
+    REQUIRE(ws.take(0, x));
+    REQUIRE(x == 2);
+    REQUIRE_FALSE(ws.take(0, x));
+  }
+
+  SECTION("stack policy")
+  {
+    tchecker::waiting::work_stealing_t<int> ws{2, tchecker::waiting::STACK};
+    ws.insert(0, 1);
+    ws.insert(0, 2);
+    int x = 0;
+    REQUIRE(ws.take(0, x));
+    REQUIRE(x == 2);
+    REQUIRE(ws.take(0, x));
+    REQUIRE(x == 1);
+    REQUIRE_FALSE(ws.take(0, x));
+  }
+
+  SECTION("stealing takes the oldest element")
+  {
+    tchecker::waiting::work_stealing_t<int> ws{3, tchecker::waiting::STACK};
+    ws.insert(1, 1);
+    ws.insert(1, 2);
+    ws.insert(1, 3);
+    int x = 0;
+    REQUIRE(ws.take(0, x));
+    REQUIRE(x == 1);
+    REQUIRE(ws.take(1, x));
+    REQUIRE(x == 3);
+    REQUIRE(ws.take(2, x));
+    REQUIRE(x == 2);
+    REQUIRE_FALSE(ws.take(0, x));
+    REQUIRE_FALSE(ws.take(1, x));
+    REQUIRE_FALSE(ws.take(2, x));
+  }
+
+  SECTION("unsupported parameters")
+  {
+    REQUIRE_THROWS_AS((tchecker::waiting::work_stealing_t<int>{0, tchecker::waiting::QUEUE}), std::invalid_argument);
+    REQUIRE_THROWS_AS((tchecker::waiting::work_stealing_t<int>{2, tchecker::waiting::PQUEUE}), std::invalid_argument);
+  }
+}
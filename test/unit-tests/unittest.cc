@@ -8,10 +8,12 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
+#include "test-bitstate.hh"
 #include "test-cache.hh"
 #include "test-clock_updates.hh"
 #include "test-clockbounds.hh"
 #include "test-clocks.hh"
+#include "test-concurrent_cover_graph.hh"
 #include "test-db.hh"
 #include "test-dbm.hh"
 #include "test-delay_allowed.hh"
@@ -21,11 +23,20 @@
 #include "test-from_string.hh"
 #include "test-guard_weak_sync.hh"
 #include "test-hashtable.hh"
+#include "test-intval_independent_clocks.hh"
 #include "test-labels.hh"
+#include "test-memoized_bytecode.hh"
+#include "test-minimal_zone.hh"
+#include "test-native.hh"
 #include "test-ordering.hh"
 #include "test-refdbm.hh"
 #include "test-reference_clock_variables.hh"
 #include "test-refzg-semantics.hh"
+#include "test-soa_cover_graph.hh"
+#include "test-spill_store.hh"
+#include "test-static_dispatch.hh"
+#include "test-syncprod.hh"
+#include "test-threaded_bytecode.hh"
 #include "test-variables-access.hh"
 #include "test-waiting.hh"
 #include "test-zg-semantics.hh"